@@ -1,5 +1,7 @@
 #include "bits.h"
+#include "bitstream.h"
 #include "error.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 using namespace std;
@@ -54,66 +56,21 @@ namespace {
         }
     }
 
-    /* Utility types for reading/writing individual bits. Inspired by a
-     * similar implementation by Julie Zelenski.
-     */
-    class BitWriter {
-    public:
-        explicit BitWriter(ostream& o) : _out(o) {}
-        ~BitWriter() {
-            if (_bitIndex != 0) flush();
-        }
-
-        void put(Bit b) {
-            if (b != 0) {
-                _bitBuffer |= (1U << _bitIndex);
-            }
-
-            _bitIndex++;
-            if (_bitIndex == 8) {
-                flush();
-            }
-        }
-
-    private:
-        void flush() {
-            _out.put(_bitBuffer);
-            _bitBuffer = 0;
-            _bitIndex = 0;
-        }
-
-        ostream& _out;
-        uint8_t _bitBuffer = 0;
-        uint8_t _bitIndex  = 0;
-    };
-
-    class BitReader {
-    public:
-        explicit BitReader(istream& i) : _in(i) {}
-
-        Bit get() {
-            if (_bitIndex == 8) readMore();
-
-            Bit result = !!(_bitBuffer & (1U << _bitIndex));
-            _bitIndex++;
-            return result;
+    /* Moves bits between a Queue<Bit> and a bit stream up to 64 at a time. */
+    void writeBits(Queue<Bit>& bits, BitWriter& writer) {
+        while (!bits.isEmpty()) {
+            int count = min(bits.size(), 64);
+            writer.writeBits(bits.dequeueBits(count), count);
         }
+    }
 
-    private:
-        istream& _in;
-        uint8_t _bitBuffer = 0;
-        uint8_t _bitIndex  = 8;
-
-        void readMore() {
-            char read;
-            if (!_in.get(read)) {
-                error("Unexpected end of file when reading bits.");
-            }
-
-            _bitBuffer = read;
-            _bitIndex = 0;
+    void readBits(BitReader& reader, uint64_t count, Queue<Bit>& bits) {
+        while (count > 0) {
+            int chunk = int(min<uint64_t>(count, 64));
+            bits.enqueueBits(reader.readBits(chunk), chunk);
+            count -= chunk;
         }
-    };
+    }
 
     /* "CS106B A7" */
     const uint32_t kFileHeader = 0xC5106BA7;
@@ -152,8 +109,9 @@ void writeData(EncodedData& data, ostream& out) {
 
     /* Bits themselves. */
     BitWriter writer(out);
-    while (!data.treeShape.isEmpty()) writer.put(data.treeShape.dequeue());
-    while (!data.messageBits.isEmpty()) writer.put(data.messageBits.dequeue());
+    writeBits(data.treeShape, writer);
+    writeBits(data.messageBits, writer);
+    writer.flush();
 }
 
 /**
@@ -219,16 +177,14 @@ EncodedData readData(istream& in) {
 
     /* Read in the tree shape bits. */
     BitReader reader(in);
-    for (int i = 0; i < 2 * charCount - 1; i++) {
-        data.treeShape.enqueue(reader.get());
-        bitsToRead--;
+    if (bitsToRead < uint64_t(2 * charCount - 1)) {
+        error("Unexpected end of file when reading bits.");
     }
+    readBits(reader, 2 * charCount - 1, data.treeShape);
+    bitsToRead -= 2 * charCount - 1;
 
     /* Read in the message bits. */
-    while (bitsToRead > 0) {
-        data.messageBits.enqueue(reader.get());
-        bitsToRead--;
-    }
+    readBits(reader, bitsToRead, data.messageBits);
 
     return data;
 }
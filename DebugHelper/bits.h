@@ -1,5 +1,6 @@
 #pragma once
 #include <ostream>
+#include "bitqueue.h"
 #include "queue.h"
 
 /**
@@ -27,6 +28,25 @@ private:
     bool _value;
 };
 
+/*
+ * A Queue<Bit> stores its bits packed 64 to a word instead of one per
+ * element, so the queues in an EncodedData stay small for large inputs.
+ * It supports every Queue operation, plus enqueueBits/dequeueBits for
+ * moving up to 64 bits at once; see bitqueue.h.
+ */
+template <>
+class Queue<Bit> : public stanfordcpplib::collections::PackedBitQueue<Bit> {
+public:
+    using PackedBitQueue::PackedBitQueue;
+};
+
+inline std::ostream& operator<< (std::ostream& out, const Queue<Bit>& queue) {
+    return out << queue.bits();
+}
+
+inline int hashCode(const Queue<Bit>& queue) {
+    return hashCode(queue.bits());
+}
 
 
 /*
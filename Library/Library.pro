@@ -40,9 +40,9 @@ QT                  +=  core gui widgets network multimedia
 #       Build settings                                                        #
 ###############################################################################
 
-# MinGW compiler lags, be conservative and use C++11 on all platforms
+# Library headers use C++17 (string_view, from_chars), so use it on all platforms
 # rather than special case
-CONFIG              +=  c++11
+CONFIG              +=  c++17
 
 # Set develop_mode to enable warnings, deprecated, nit-picks, all of it.
 # Pay attention and fix! Library should compile cleanly.
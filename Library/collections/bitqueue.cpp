@@ -0,0 +1,165 @@
+/*
+ * File: bitqueue.cpp
+ * ------------------
+ * This file implements the bitqueue.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "bitqueue.h"
+#include <algorithm>
+#include "hashcode.h"
+
+namespace {
+/*
+ * The number of consumed words that must build up in front of the head
+ * before grow() moves the rest of the queue down; 64 words is 4096 bits.
+ */
+const size_t kMinReleaseWords = 64;
+}
+
+BitQueue::BitQueue()
+        : _head(0),
+          _tail(0) {
+    // empty
+}
+
+BitQueue::BitQueue(std::initializer_list<bool> list)
+        : _head(0),
+          _tail(0) {
+    for (bool value : list) {
+        enqueue(value);
+    }
+}
+
+void BitQueue::clear() {
+    _words.clear();
+    _head = 0;
+    _tail = 0;
+}
+
+bool BitQueue::equals(const BitQueue& queue2) const {
+    return *this == queue2;
+}
+
+bool BitQueue::peek() const {
+    if (_head == _tail) {
+        error("BitQueue::peek: Attempting to peek at an empty queue");
+    }
+    return (_words[_head >> 6] >> (_head & 63)) & 1;
+}
+
+uint64_t BitQueue::peekBits(int count) const {
+    checkCount(count, "peekBits");
+    return count == 0 ? 0 : bitsAt(_head, count);
+}
+
+void BitQueue::checkCount(int count, const char* prefix) const {
+    if (count < 0 || count > 64) {
+        error(std::string("BitQueue::") + prefix + ": count must be between 0 and 64");
+    } else if ((size_t) count > _tail - _head) {
+        error(std::string("BitQueue::") + prefix + ": Attempting to read " + std::to_string(count)
+              + " bits from a queue of " + std::to_string(_tail - _head));
+    }
+}
+
+/*
+ * Implementation notes: grow
+ * --------------------------
+ * A queue that is filled and then drained, as in the Huffman encoder,
+ * never moves its bits: dequeueing only advances _head, and the storage
+ * is reused from the start once the queue empties.  A queue that is fed and drained at
+ * the same time would otherwise grow without bound, so when it needs more
+ * room and at least half of its words are behind the head, those words
+ * are erased instead, which moves each remaining word at most once per
+ * doubling of the storage.
+ */
+void BitQueue::grow() {
+    size_t consumed = _head >> 6;
+    size_t needed = (_tail >> 6) + 3;
+    if (consumed >= kMinReleaseWords && consumed * 2 >= needed) {
+        _words.erase(_words.begin(), _words.begin() + consumed);
+        _head -= consumed * 64;
+        _tail -= consumed * 64;
+        needed -= consumed;
+    }
+    if (_words.size() < needed) {
+        _words.resize(std::max(needed, 2 * _words.size()));
+    }
+}
+
+std::string BitQueue::toString() const {
+    std::string str = "{";
+    str.reserve(3 * size() + 2);
+    for (size_t i = _head; i < _tail; i++) {
+        if (i > _head) {
+            str += ", ";
+        }
+        str += ((_words[i >> 6] >> (i & 63)) & 1) ? '1' : '0';
+    }
+    str += '}';
+    return str;
+}
+
+/*
+ * Implementation notes: compareTo
+ * -------------------------------
+ * The queues are compared 64 bits at a time.  Within a block the first
+ * differing bit is the lowest set bit of the XOR, and the queue that has
+ * a 1 there is the larger one.
+ */
+int BitQueue::compareTo(const BitQueue& queue2) const {
+    size_t n1 = _tail - _head;
+    size_t n2 = queue2._tail - queue2._head;
+    size_t common = n1 < n2 ? n1 : n2;
+    for (size_t i = 0; i < common; i += 64) {
+        int count = (int) (common - i < 64 ? common - i : 64);
+        uint64_t a = bitsAt(_head + i, count);
+        uint64_t b = queue2.bitsAt(queue2._head + i, count);
+        if (a != b) {
+            uint64_t diff = a ^ b;
+            return (a & diff & (~diff + 1)) ? 1 : -1;
+        }
+    }
+    return n1 == n2 ? 0 : (n1 < n2 ? -1 : 1);
+}
+
+bool BitQueue::operator ==(const BitQueue& queue2) const {
+    return size() == queue2.size() && compareTo(queue2) == 0;
+}
+
+bool BitQueue::operator !=(const BitQueue& queue2) const {
+    return !(*this == queue2);
+}
+
+bool BitQueue::operator <(const BitQueue& queue2) const {
+    return compareTo(queue2) < 0;
+}
+
+bool BitQueue::operator <=(const BitQueue& queue2) const {
+    return compareTo(queue2) <= 0;
+}
+
+bool BitQueue::operator >(const BitQueue& queue2) const {
+    return compareTo(queue2) > 0;
+}
+
+bool BitQueue::operator >=(const BitQueue& queue2) const {
+    return compareTo(queue2) >= 0;
+}
+
+std::ostream& operator <<(std::ostream& out, const BitQueue& queue) {
+    return out << queue.toString();
+}
+
+int hashCode(const BitQueue& queue) {
+    unsigned int code = (unsigned int) hashSeed();
+    for (size_t i = queue._head; i < queue._tail; i += 64) {
+        int count = (int) (queue._tail - i < 64 ? queue._tail - i : 64);
+        uint64_t word = queue.bitsAt(i, count);
+        code = code * (unsigned int) hashMultiplier() + (unsigned int) hashCode((unsigned int) word);
+        code = code * (unsigned int) hashMultiplier() + (unsigned int) hashCode((unsigned int) (word >> 32));
+    }
+    return (int) ((code + (unsigned int) queue.size()) & (unsigned int) hashMask());
+}
@@ -0,0 +1,449 @@
+/*
+ * File: bitqueue.h
+ * ----------------
+ * This file exports the <code>BitQueue</code> class, a first-in/first-out
+ * queue of bits stored 64 to a machine word, along with the adapter that
+ * lets a Queue of a one-bit value type use it as storage.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#ifndef _bitqueue_h
+#define _bitqueue_h
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "error.h"
+
+/*
+ * Class: BitQueue
+ * ---------------
+ * This class is a queue of bits.  It behaves like a Queue&lt;bool&gt;, but
+ * packs the bits into 64-bit words, so a queue holding the encoding of a
+ * 100 MB file occupies about as much memory as the encoding itself, and
+ * up to 64 bits can be enqueued or dequeued in a single operation with
+ * <code>enqueueBits</code> and <code>dequeueBits</code>.
+ *
+ * In the multi-bit operations, the lowest bit of the value is the one
+ * closest to the front of the queue; <code>enqueueBits(0b110, 3)</code>
+ * enqueues 0, then 1, then 1.
+ */
+class BitQueue {
+public:
+    /*
+     * Constructor: BitQueue
+     * Usage: BitQueue queue;
+     * ----------------------
+     * Initializes a new empty queue.
+     */
+    BitQueue();
+
+    /*
+     * Constructor: BitQueue
+     * Usage: BitQueue queue {1, 0, 1};
+     * --------------------------------
+     * Initializes a new queue that stores the given bits from front-back.
+     */
+    BitQueue(std::initializer_list<bool> list);
+
+    /*
+     * Method: clear
+     * Usage: queue.clear();
+     * ---------------------
+     * Removes all bits from the queue.
+     */
+    void clear();
+
+    /*
+     * Method: dequeue
+     * Usage: bool first = queue.dequeue();
+     * ------------------------------------
+     * Removes and returns the first bit in the queue.
+     * Signals an error if the queue is empty.
+     */
+    bool dequeue();
+
+    /*
+     * Method: dequeueBits
+     * Usage: uint64_t value = queue.dequeueBits(count);
+     * -------------------------------------------------
+     * Removes the first <code>count</code> bits from the queue and returns
+     * them, with the first of them as the lowest bit of the result.
+     * The count may be 0 through 64.
+     * Signals an error if the queue holds fewer than <code>count</code> bits.
+     */
+    uint64_t dequeueBits(int count);
+
+    /*
+     * Method: enqueue
+     * Usage: queue.enqueue(value);
+     * ----------------------------
+     * Adds a bit to the end of the queue.
+     */
+    void enqueue(bool value);
+
+    /*
+     * Method: enqueueBits
+     * Usage: queue.enqueueBits(value, count);
+     * ---------------------------------------
+     * Adds the lowest <code>count</code> bits of the given value to the end
+     * of the queue, lowest bit first.  The count may be 0 through 64.
+     */
+    void enqueueBits(uint64_t value, int count);
+
+    /*
+     * Method: equals
+     * Usage: if (queue.equals(queue2)) ...
+     * ------------------------------------
+     * Returns <code>true</code> if the two queues contain the same bits
+     * in the same order.  Identical in behavior to the == operator.
+     */
+    bool equals(const BitQueue& queue2) const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (queue.isEmpty()) ...
+     * -------------------------------
+     * Returns <code>true</code> if the queue contains no bits.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: peek
+     * Usage: bool first = queue.peek();
+     * ---------------------------------
+     * Returns the first bit in the queue, without removing it.
+     * Signals an error if the queue is empty.
+     */
+    bool peek() const;
+
+    /*
+     * Method: peekBits
+     * Usage: uint64_t value = queue.peekBits(count);
+     * ----------------------------------------------
+     * Returns the first <code>count</code> bits in the queue, in the same
+     * form as <code>dequeueBits</code>, without removing them.
+     */
+    uint64_t peekBits(int count) const;
+
+    /*
+     * Method: size
+     * Usage: int n = queue.size();
+     * ----------------------------
+     * Returns the number of bits in the queue.
+     */
+    int size() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = queue.toString();
+     * -------------------------------------
+     * Converts the queue to a printable string such as "{1, 0, 1}",
+     * the same form used by Queue.
+     */
+    std::string toString() const;
+
+    /*
+     * Operators: ==, !=
+     * Usage: if (queue1 == queue2) ...
+     * --------------------------------
+     * Compares two bit queues for equality.
+     */
+    bool operator ==(const BitQueue& queue2) const;
+    bool operator !=(const BitQueue& queue2) const;
+
+    /*
+     * Operators: <, >, <=, >=
+     * Usage: if (queue1 < queue2) ...
+     * -------------------------------
+     * Compares two bit queues lexicographically from front to back,
+     * with 0 ordered before 1.
+     */
+    bool operator <(const BitQueue& queue2) const;
+    bool operator <=(const BitQueue& queue2) const;
+    bool operator >(const BitQueue& queue2) const;
+    bool operator >=(const BitQueue& queue2) const;
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    /*
+     * Returns the count bits that start at the given absolute position,
+     * which must be within the queue.
+     */
+    uint64_t bitsAt(size_t position, int count) const;
+
+    /*
+     * Signals the error for a count that is out of range or larger than
+     * the size of the queue.
+     */
+    void checkCount(int count, const char* prefix) const;
+
+    /*
+     * Returns -1, 0, or +1 as this queue is less than, equal to, or
+     * greater than the other one.
+     */
+    int compareTo(const BitQueue& queue2) const;
+
+    /*
+     * Makes room for at least two words past the one holding _tail, either
+     * by dropping the words in front of the head or by enlarging the
+     * storage.
+     */
+    void grow();
+
+    /*
+     * Instance variables
+     * ------------------
+     * The queue holds absolute bit positions _head through _tail - 1,
+     * where position i is bit (i % 64) of _words[i / 64].  Bits at and
+     * after _tail are always 0, so enqueueing can OR bits into place, and
+     * unless the queue is empty there is at least one word after the one
+     * that holds _tail.
+     */
+    std::vector<uint64_t> _words;
+    size_t _head;
+    size_t _tail;
+
+    friend int hashCode(const BitQueue& queue);
+};
+
+/*
+ * Implementation notes: enqueue, dequeue and their multi-bit forms
+ * ----------------------------------------------------------------
+ * These are defined here in the header so that loops that move one bit
+ * or one short code at a time compile to a few shifts and masks.  The
+ * storage always has a zeroed word past the one holding _tail, so a
+ * code can be split across two words without testing whether it spans
+ * the boundary; the (x << 1) << (63 - offset) form yields 0 rather than
+ * an undefined shift when the offset is 0.
+ */
+inline uint64_t BitQueue::bitsAt(size_t position, int count) const {
+    size_t offset = position & 63;
+    const uint64_t* word = _words.data() + (position >> 6);
+    uint64_t result = (word[0] >> offset) | ((word[1] << 1) << (63 - offset));
+    return count == 64 ? result : result & ((1ULL << count) - 1);
+}
+
+inline bool BitQueue::dequeue() {
+    if (_head == _tail) {
+        error("BitQueue::dequeue: Attempting to dequeue an empty queue");
+    }
+    bool value = (_words[_head >> 6] >> (_head & 63)) & 1;
+    if (++_head == _tail) {
+        clear();
+    }
+    return value;
+}
+
+inline uint64_t BitQueue::dequeueBits(int count) {
+    if (count < 0 || count > 64 || (size_t) count > _tail - _head) {
+        checkCount(count, "dequeueBits");
+    }
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t value = bitsAt(_head, count);
+    _head += count;
+    if (_head == _tail) {
+        clear();
+    }
+    return value;
+}
+
+inline void BitQueue::enqueue(bool value) {
+    if (_words.size() < (_tail >> 6) + 3) {
+        grow();
+    }
+    _words[_tail >> 6] |= (uint64_t) value << (_tail & 63);
+    _tail++;
+}
+
+inline void BitQueue::enqueueBits(uint64_t value, int count) {
+    if (count <= 0 || count > 64) {
+        if (count != 0) {
+            error("BitQueue::enqueueBits: count must be between 0 and 64");
+        }
+        return;
+    }
+    if (_words.size() < (_tail >> 6) + 3) {
+        grow();
+    }
+    if (count < 64) {
+        value &= (1ULL << count) - 1;
+    }
+    size_t tail = _tail;
+    _tail = tail + count;
+    uint64_t* word = _words.data() + (tail >> 6);
+    word[0] |= value << (tail & 63);
+    word[1] |= (value >> 1) >> (63 - (tail & 63));
+}
+
+inline bool BitQueue::isEmpty() const {
+    return _head == _tail;
+}
+
+inline int BitQueue::size() const {
+    return (int) (_tail - _head);
+}
+
+/*
+ * Operator: <<
+ * Usage: out << queue;
+ * --------------------
+ * Writes the bit queue to the given stream in the form "{1, 0, 1}".
+ */
+std::ostream& operator <<(std::ostream& out, const BitQueue& queue);
+
+/*
+ * Function: hashCode
+ * Usage: int hash = hashCode(queue);
+ * ----------------------------------
+ * Returns a hash code for the given bit queue.
+ */
+int hashCode(const BitQueue& queue);
+
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * Queue storage for a one-bit value type such as the Bit class used in the
+ * Huffman assignment.  It has the same members as Queue, but keeps the
+ * values packed in a BitQueue instead of one per Deque element, and adds
+ * the multi-bit operations from BitQueue.  A library or assignment header
+ * that defines such a type opts in by specializing Queue for it:
+ *
+ *    template <>
+ *    class Queue<Bit> : public stanfordcpplib::collections::PackedBitQueue<Bit> {
+ *    public:
+ *        using PackedBitQueue::PackedBitQueue;
+ *    };
+ *
+ * BitType must be constructible from the ints 0 and 1 and comparable with
+ * ==.  Because the values are not stored individually, peek returns a
+ * copy rather than a reference.
+ *
+ * This is not meant to be used directly by students.
+ */
+template <typename BitType>
+class PackedBitQueue {
+public:
+    PackedBitQueue() = default;
+
+    PackedBitQueue(std::initializer_list<BitType> list) {
+        for (const BitType& value : list) {
+            enqueue(value);
+        }
+    }
+
+    virtual ~PackedBitQueue() = default;
+
+    void clear() {
+        _bits.clear();
+    }
+
+    BitType dequeue() {
+        if (isEmpty()) {
+            error("Queue::dequeue: Attempting to dequeue an empty queue");
+        }
+        return toBit(_bits.dequeue());
+    }
+
+    uint64_t dequeueBits(int count) {
+        return _bits.dequeueBits(count);
+    }
+
+    void enqueue(const BitType& value) {
+        _bits.enqueue(value == one());
+    }
+
+    void enqueueBits(uint64_t value, int count) {
+        _bits.enqueueBits(value, count);
+    }
+
+    bool equals(const PackedBitQueue& queue2) const {
+        return _bits == queue2._bits;
+    }
+
+    bool isEmpty() const {
+        return _bits.isEmpty();
+    }
+
+    BitType peek() const {
+        if (isEmpty()) {
+            error("Queue::peek: Attempting to peek at an empty queue");
+        }
+        return toBit(_bits.peek());
+    }
+
+    uint64_t peekBits(int count) const {
+        return _bits.peekBits(count);
+    }
+
+    int size() const {
+        return _bits.size();
+    }
+
+    std::string toString() const {
+        return _bits.toString();
+    }
+
+    bool operator ==(const PackedBitQueue& queue2) const {
+        return _bits == queue2._bits;
+    }
+
+    bool operator !=(const PackedBitQueue& queue2) const {
+        return _bits != queue2._bits;
+    }
+
+    bool operator <(const PackedBitQueue& queue2) const {
+        return _bits < queue2._bits;
+    }
+
+    bool operator <=(const PackedBitQueue& queue2) const {
+        return _bits <= queue2._bits;
+    }
+
+    bool operator >(const PackedBitQueue& queue2) const {
+        return _bits > queue2._bits;
+    }
+
+    bool operator >=(const PackedBitQueue& queue2) const {
+        return _bits >= queue2._bits;
+    }
+
+    /*
+     * Returns the underlying packed queue, for hashing and printing.
+     */
+    const BitQueue& bits() const {
+        return _bits;
+    }
+
+private:
+    static const BitType& one() {
+        static const BitType value(1);
+        return value;
+    }
+
+    static BitType toBit(bool value) {
+        return BitType(value ? 1 : 0);
+    }
+
+    BitQueue _bits;
+};
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+#endif // _bitqueue_h
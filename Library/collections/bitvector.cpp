@@ -0,0 +1,120 @@
+/*
+ * File: bitvector.cpp
+ * -------------------
+ * This file implements the bitvector.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "bitvector.h"
+#include <bitset>
+#include <sstream>
+#include "hashcode.h"
+
+BitVector::BitVector()
+        : _size(0) {
+    // empty
+}
+
+BitVector::BitVector(int n, bool value)
+        : _size(0) {
+    if (n < 0) {
+        error("BitVector::constructor: size cannot be negative");
+    }
+    _words.assign((n + 63) / 64, value ? ~0ULL : 0);
+    _size = n;
+    if (value && (n & 63) != 0) {
+        _words.back() = (1ULL << (n & 63)) - 1;
+    }
+}
+
+BitVector::BitVector(std::initializer_list<bool> list)
+        : _size(0) {
+    for (bool value : list) {
+        add(value);
+    }
+}
+
+void BitVector::clear() {
+    _words.clear();
+    _size = 0;
+}
+
+int BitVector::count() const {
+    int ones = 0;
+    for (uint64_t word : _words) {
+        ones += (int) std::bitset<64>(word).count();
+    }
+    return ones;
+}
+
+bool BitVector::equals(const BitVector& v2) const {
+    return *this == v2;
+}
+
+bool BitVector::isEmpty() const {
+    return _size == 0;
+}
+
+void BitVector::set(int index, bool value) {
+    checkRange(index, 1, "set");
+    uint64_t mask = 1ULL << (index & 63);
+    if (value) {
+        _words[index >> 6] |= mask;
+    } else {
+        _words[index >> 6] &= ~mask;
+    }
+}
+
+int BitVector::size() const {
+    return _size;
+}
+
+std::string BitVector::toString() const {
+    std::ostringstream out;
+    out << *this;
+    return out.str();
+}
+
+bool BitVector::operator [](int index) const {
+    return get(index);
+}
+
+bool BitVector::operator ==(const BitVector& v2) const {
+    return _size == v2._size && _words == v2._words;
+}
+
+bool BitVector::operator !=(const BitVector& v2) const {
+    return !(*this == v2);
+}
+
+BitVector::const_iterator BitVector::begin() const {
+    return const_iterator(this, 0);
+}
+
+BitVector::const_iterator BitVector::end() const {
+    return const_iterator(this, _size);
+}
+
+std::ostream& operator <<(std::ostream& out, const BitVector& bits) {
+    std::string str = "{";
+    str.reserve(3 * bits.size() + 2);
+    for (int i = 0; i < bits.size(); i++) {
+        if (i > 0) {
+            str += ", ";
+        }
+        str += bits.get(i) ? '1' : '0';
+    }
+    str += '}';
+    return out << str;
+}
+
+int hashCode(const BitVector& bits) {
+    unsigned int code = (unsigned int) hashSeed();
+    for (uint64_t word : bits._words) {
+        code = code * (unsigned int) hashMultiplier() + (unsigned int) hashCode((unsigned int) word);
+        code = code * (unsigned int) hashMultiplier() + (unsigned int) hashCode((unsigned int) (word >> 32));
+    }
+    return (int) ((code + (unsigned int) bits._size) & (unsigned int) hashMask());
+}
@@ -0,0 +1,325 @@
+/*
+ * File: bitvector.h
+ * -----------------
+ * This file exports the <code>BitVector</code> class, an indexed sequence
+ * of bits stored 64 to a machine word.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#ifndef _bitvector_h
+#define _bitvector_h
+
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "error.h"
+
+/*
+ * Class: BitVector
+ * ----------------
+ * This class stores an ordered list of bits, like a Vector&lt;bool&gt;,
+ * but packs them 64 to a word so that a million bits take 125 KB rather
+ * than megabytes, and so that up to 64 bits can be added or read in a
+ * single operation with <code>addBits</code> and <code>getBits</code>.
+ *
+ * In the multi-bit operations, the lowest bit of the value is the one at
+ * the lowest index; <code>addBits(0b110, 3)</code> adds 0, then 1, then 1.
+ */
+class BitVector {
+public:
+    /*
+     * Constructor: BitVector
+     * Usage: BitVector bits;
+     *        BitVector bits(n, value);
+     * --------------------------------
+     * Initializes a new bit vector.  The default constructor creates an
+     * empty vector; the second form creates one with n copies of the given
+     * value (false if omitted).
+     */
+    BitVector();
+    BitVector(int n, bool value = false);
+
+    /*
+     * Constructor: BitVector
+     * Usage: BitVector bits {1, 0, 1};
+     * --------------------------------
+     * Initializes a new bit vector that stores the given bits.
+     */
+    BitVector(std::initializer_list<bool> list);
+
+    /*
+     * Method: add
+     * Usage: bits.add(value);
+     * -----------------------
+     * Adds a bit to the end of the vector.
+     */
+    void add(bool value);
+
+    /*
+     * Method: addBits
+     * Usage: bits.addBits(value, count);
+     * ----------------------------------
+     * Adds the lowest <code>count</code> bits of the given value to the end
+     * of the vector, lowest bit first.  The count may be 0 through 64.
+     */
+    void addBits(uint64_t value, int count);
+
+    /*
+     * Method: clear
+     * Usage: bits.clear();
+     * --------------------
+     * Removes all bits from the vector.
+     */
+    void clear();
+
+    /*
+     * Method: count
+     * Usage: int ones = bits.count();
+     * -------------------------------
+     * Returns the number of bits that are set to 1.
+     */
+    int count() const;
+
+    /*
+     * Method: equals
+     * Usage: if (bits.equals(bits2)) ...
+     * ----------------------------------
+     * Returns <code>true</code> if the two vectors contain the same bits
+     * in the same order.  Identical in behavior to the == operator.
+     */
+    bool equals(const BitVector& v2) const;
+
+    /*
+     * Method: get
+     * Usage: bool bit = bits.get(index);
+     * ----------------------------------
+     * Returns the bit at the given index.
+     * Signals an error if the index is out of range.
+     */
+    bool get(int index) const;
+
+    /*
+     * Method: getBits
+     * Usage: uint64_t value = bits.getBits(index, count);
+     * ---------------------------------------------------
+     * Returns the <code>count</code> bits starting at the given index, with
+     * the bit at that index as the lowest bit of the result.
+     * Signals an error if the bits are not all in range.
+     */
+    uint64_t getBits(int index, int count) const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (bits.isEmpty()) ...
+     * ------------------------------
+     * Returns <code>true</code> if the vector contains no bits.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: set
+     * Usage: bits.set(index, value);
+     * ------------------------------
+     * Replaces the bit at the given index with the given value.
+     * Signals an error if the index is out of range.
+     */
+    void set(int index, bool value);
+
+    /*
+     * Method: size
+     * Usage: int n = bits.size();
+     * ---------------------------
+     * Returns the number of bits in the vector.
+     */
+    int size() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = bits.toString();
+     * ------------------------------------
+     * Converts the vector to a printable string such as "{1, 0, 1}",
+     * the same form used by Vector.
+     */
+    std::string toString() const;
+
+    /*
+     * Operator: []
+     * Usage: bool bit = bits[index];
+     * ------------------------------
+     * Returns the bit at the given index, like <code>get</code>.
+     * Unlike Vector, the result is a copy, so it cannot be assigned to;
+     * use <code>set</code> to change a bit.
+     */
+    bool operator [](int index) const;
+
+    /*
+     * Operators: ==, !=
+     * Usage: if (bits1 == bits2) ...
+     * ------------------------------
+     * Compares two bit vectors for equality.
+     */
+    bool operator ==(const BitVector& v2) const;
+    bool operator !=(const BitVector& v2) const;
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    /*
+     * Signals an error if the given range of bits is not within the vector.
+     */
+    void checkRange(int index, int count, const char* prefix) const;
+
+    /*
+     * Instance variables
+     * ------------------
+     * Bit i is bit (i % 64) of _words[i / 64].  Bits past the end of the
+     * last word are always 0, so that == and hashCode can compare words.
+     */
+    std::vector<uint64_t> _words;
+    int _size;
+
+public:
+    /*
+     * Iterator support
+     * ----------------
+     * Iteration visits each bit as a bool, in index order.  Since the
+     * bits are read-only through an iterator, begin and end always return
+     * const iterators.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const bool*;
+        using reference = bool;
+
+        const_iterator() : _bits(nullptr), _index(0) {}
+        const_iterator(const BitVector* bits, int index) : _bits(bits), _index(index) {}
+
+        bool operator *() const {
+            return (_bits->_words[_index >> 6] >> (_index & 63)) & 1;
+        }
+
+        const_iterator& operator ++() {
+            _index++;
+            return *this;
+        }
+
+        const_iterator operator ++(int) {
+            const_iterator copy(*this);
+            _index++;
+            return copy;
+        }
+
+        bool operator ==(const const_iterator& rhs) const {
+            return _bits == rhs._bits && _index == rhs._index;
+        }
+
+        bool operator !=(const const_iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        const BitVector* _bits;
+        int _index;
+    };
+
+    using iterator = const_iterator;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    friend int hashCode(const BitVector& bits);
+};
+
+/*
+ * Implementation notes: add, addBits, get, getBits
+ * ------------------------------------------------
+ * These are defined here in the header so that the compiler can inline
+ * them into loops that add or read one bit or one small code at a time.
+ */
+inline void BitVector::add(bool value) {
+    if ((_size & 63) == 0) {
+        _words.push_back(0);
+    }
+    _words.back() |= (uint64_t) value << (_size & 63);
+    _size++;
+}
+
+inline void BitVector::addBits(uint64_t value, int count) {
+    if (count <= 0 || count > 64) {
+        if (count != 0) {
+            error("BitVector::addBits: count must be between 0 and 64");
+        }
+        return;
+    }
+    if (count < 64) {
+        value &= (1ULL << count) - 1;
+    }
+    int offset = _size & 63;
+    if (offset == 0) {
+        _words.push_back(value);
+    } else {
+        _words.back() |= value << offset;
+        if (offset + count > 64) {
+            _words.push_back(value >> (64 - offset));
+        }
+    }
+    _size += count;
+}
+
+inline bool BitVector::get(int index) const {
+    checkRange(index, 1, "get");
+    return (_words[index >> 6] >> (index & 63)) & 1;
+}
+
+inline uint64_t BitVector::getBits(int index, int count) const {
+    checkRange(index, count, "getBits");
+    if (count == 0) {
+        return 0;
+    }
+    int offset = index & 63;
+    uint64_t result = _words[index >> 6] >> offset;
+    if (offset + count > 64) {
+        result |= _words[(index >> 6) + 1] << (64 - offset);
+    }
+    return count == 64 ? result : result & ((1ULL << count) - 1);
+}
+
+inline void BitVector::checkRange(int index, int count, const char* prefix) const {
+    if (index < 0 || count < 0 || count > 64 || index > _size - count) {
+        error(std::string("BitVector::") + prefix + ": bits " + std::to_string(index)
+              + " through " + std::to_string(index + count - 1)
+              + " are outside of valid range [0.." + std::to_string(_size - 1) + "]");
+    }
+}
+
+/*
+ * Operator: <<
+ * Usage: out << bits;
+ * -------------------
+ * Writes the bit vector to the given stream in the form "{1, 0, 1}".
+ */
+std::ostream& operator <<(std::ostream& out, const BitVector& bits);
+
+/*
+ * Function: hashCode
+ * Usage: int hash = hashCode(bits);
+ * ---------------------------------
+ * Returns a hash code for the given bit vector.
+ */
+int hashCode(const BitVector& bits);
+
+#endif // _bitvector_h
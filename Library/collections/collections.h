@@ -13,8 +13,10 @@
 
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <type_traits>
+#include <utility>
 
 #include "error.h"
 #include "gmath.h"
@@ -985,6 +987,228 @@ private:
     Iterator _iter;
 };
 
+/*
+ * A pair of iterators that can be used in a range-based for loop.
+ * Returned by the range methods of Map and Set.
+ */
+template <typename Iterator> class IteratorRange {
+public:
+    IteratorRange(Iterator begin, Iterator end) : _begin(begin), _end(end) {
+        // Empty
+    }
+
+    Iterator begin() const {
+        return _begin;
+    }
+
+    Iterator end() const {
+        return _end;
+    }
+
+private:
+    Iterator _begin;
+    Iterator _end;
+};
+
+/*
+ * Helpers that let the merge algorithms below work on both a std::map,
+ * whose entries are key/value pairs, and a std::set, whose entries are
+ * just keys.  The values of two set entries always count as equal.
+ */
+template <typename K, typename V>
+const K& entryKey(const std::pair<const K, V>& entry) {
+    return entry.first;
+}
+template <typename K>
+const K& entryKey(const K& key) {
+    return key;
+}
+
+template <typename K, typename V>
+bool entryValuesEqual(const std::pair<const K, V>& entry1, const std::pair<const K, V>& entry2) {
+    return entry1.second == entry2.second;
+}
+template <typename K>
+bool entryValuesEqual(const K&, const K&) {
+    return true;
+}
+
+template <typename K, typename V>
+void copyEntryValue(std::pair<const K, V>& to, const std::pair<const K, V>& from) {
+    to.second = from.second;
+}
+template <typename K>
+void copyEntryValue(const K&, const K&) {
+    // Empty
+}
+
+/*
+ * Returns true if the two less-than functions are known to order keys the
+ * same way, which is what makes it valid to merge two sorted containers
+ * that use them.  This is so if both are the default std::less or the same
+ * function pointer.  Other function objects such as lambdas may capture
+ * different state, so they are never considered the same.
+ */
+template <typename KeyType>
+bool sameOrdering(const std::function<bool (const KeyType&, const KeyType&)>& less1,
+                  const std::function<bool (const KeyType&, const KeyType&)>& less2) {
+    using RefFunction = bool (*)(const KeyType&, const KeyType&);
+    using ValueFunction = bool (*)(KeyType, KeyType);
+    if (less1.target_type() != less2.target_type()) {
+        return false;
+    } else if (less1.template target<std::less<KeyType>>()) {
+        return true;
+    } else if (less1.template target<RefFunction>()) {
+        return *less1.template target<RefFunction>() == *less2.template target<RefFunction>();
+    } else if (less1.template target<ValueFunction>()) {
+        return *less1.template target<ValueFunction>() == *less2.template target<ValueFunction>();
+    } else {
+        return false;
+    }
+}
+
+/*
+ * Returns true if walking a sorted sequence of 'searched' entries alongside
+ * one of 'probes' entries should be faster than looking each probe up in a
+ * tree of 'searched' entries.  Lookups win only when there are far fewer
+ * probes than searched entries.
+ */
+inline bool preferMerge(int probes, int searched) {
+    long long lookupCost = 1;
+    for (int n = searched; n > 1; n /= 2) {
+        lookupCost++;
+    }
+    lookupCost *= probes;
+    return static_cast<long long>(probes) + searched <= 2 * lookupCost;
+}
+
+/*
+ * Merge-based set algebra on two sorted standard containers (std::map or
+ * std::set) that use the same ordering; see sameOrdering.  Each runs in
+ * O(N + M) time, one step per entry, instead of doing a separate O(log N)
+ * tree search for every entry.  The functions that change c1 return true
+ * if they changed it.
+ *
+ * mergeAddAll adds c2's entries to c1; for equal keys, c2's value wins.
+ * mergeRemoveAll removes c1's entries whose key and value are both in c2.
+ * mergeRetainAll removes c1's entries whose key and value are not in c2.
+ * mergeIncludes returns true if every entry of c2 is also in c1.
+ * mergeEquals returns true if c1 and c2 hold the same entries.
+ */
+template <typename SortedContainer>
+bool mergeAddAll(SortedContainer& c1, const SortedContainer& c2) {
+    auto less = c1.key_comp();
+    bool changed = false;
+    auto itr1 = c1.begin();
+    for (auto itr2 = c2.begin(); itr2 != c2.end(); ++itr2) {
+        while (itr1 != c1.end() && less(entryKey(*itr1), entryKey(*itr2))) {
+            ++itr1;
+        }
+        if (itr1 != c1.end() && !less(entryKey(*itr2), entryKey(*itr1))) {
+            copyEntryValue(*itr1, *itr2);
+            ++itr1;
+        } else {
+            // the hint is the element just after the new one,
+            // so the insertion takes amortized constant time
+            c1.insert(itr1, *itr2);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+template <typename SortedContainer>
+bool mergeEquals(const SortedContainer& c1, const SortedContainer& c2) {
+    if (c1.size() != c2.size()) {
+        return false;
+    }
+    auto less = c1.key_comp();
+    for (auto itr1 = c1.begin(), itr2 = c2.begin(); itr1 != c1.end(); ++itr1, ++itr2) {
+        if (less(entryKey(*itr1), entryKey(*itr2))
+                || less(entryKey(*itr2), entryKey(*itr1))
+                || !entryValuesEqual(*itr1, *itr2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename SortedContainer>
+bool mergeIncludes(const SortedContainer& c1, const SortedContainer& c2) {
+    if (c2.size() > c1.size()) {
+        return false;
+    }
+    auto less = c1.key_comp();
+    auto itr1 = c1.begin();
+    for (auto itr2 = c2.begin(); itr2 != c2.end(); ++itr2) {
+        while (itr1 != c1.end() && less(entryKey(*itr1), entryKey(*itr2))) {
+            ++itr1;
+        }
+        if (itr1 == c1.end()
+                || less(entryKey(*itr2), entryKey(*itr1))
+                || !entryValuesEqual(*itr1, *itr2)) {
+            return false;
+        }
+        ++itr1;
+    }
+    return true;
+}
+
+template <typename SortedContainer>
+bool mergeRemoveAll(SortedContainer& c1, const SortedContainer& c2) {
+    if (&c1 == &c2) {
+        bool changed = !c1.empty();
+        c1.clear();
+        return changed;
+    }
+    auto less = c1.key_comp();
+    bool changed = false;
+    auto itr1 = c1.begin();
+    auto itr2 = c2.begin();
+    while (itr1 != c1.end() && itr2 != c2.end()) {
+        if (less(entryKey(*itr1), entryKey(*itr2))) {
+            ++itr1;
+        } else if (less(entryKey(*itr2), entryKey(*itr1))) {
+            ++itr2;
+        } else {
+            if (entryValuesEqual(*itr1, *itr2)) {
+                itr1 = c1.erase(itr1);
+                changed = true;
+            } else {
+                ++itr1;
+            }
+            ++itr2;
+        }
+    }
+    return changed;
+}
+
+template <typename SortedContainer>
+bool mergeRetainAll(SortedContainer& c1, const SortedContainer& c2) {
+    auto less = c1.key_comp();
+    bool changed = false;
+    auto itr1 = c1.begin();
+    auto itr2 = c2.begin();
+    while (itr1 != c1.end()) {
+        while (itr2 != c2.end() && less(entryKey(*itr2), entryKey(*itr1))) {
+            ++itr2;
+        }
+        if (itr2 != c2.end()
+                && !less(entryKey(*itr1), entryKey(*itr2))
+                && entryValuesEqual(*itr1, *itr2)) {
+            ++itr1;
+            ++itr2;
+        } else {
+            itr1 = c1.erase(itr1);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/* Storage for Set; see set.h. */
+template <typename T> class SortedKeySet;
+
 /**
  * Class: GenericSet<SetTraits>
  * ----------------------------
@@ -992,7 +1216,9 @@ private:
  * a type containing the following:
  *
  *     typename ValueType:          whatever is stored in the map
- *     typename MapType:            should be a Map<ValueType, bool>
+ *     typename MapType:            should be a Map<ValueType, bool> or a type
+ *                                  with the same members, such as
+ *                                  SortedKeySet<ValueType>
  *     static std::string name():   should return the name of the type.
  *
  * There's one more requirement: you need to define a function
@@ -1067,6 +1293,21 @@ public:
      */
     void add(const value_type& value);
 
+    /**
+     * Method: ceiling
+     * Usage: ValueType value = set.ceiling(value);
+     * --------------------------------------------
+     * Returns the least element of this set that is greater than or equal
+     * to the given value, in the order established by the
+     * <code>for-each</code> loop.
+     * If there is no such element, generates an error; one exists if the set
+     * is not empty and <code>value</code> is not greater than
+     * <code>set.last()</code>.
+     * Not available for HashSet.
+     */
+    template <typename MapType = typename SetTraits::MapType>
+    value_type ceiling(const value_type& value) const;
+
     /**
      * Method: clear
      * Usage: set.clear();
@@ -1119,6 +1360,21 @@ public:
      */
     value_type first() const;
 
+    /**
+     * Method: floor
+     * Usage: ValueType value = set.floor(value);
+     * ------------------------------------------
+     * Returns the greatest element of this set that is less than or equal
+     * to the given value, in the order established by the
+     * <code>for-each</code> loop.
+     * If there is no such element, generates an error; one exists if the set
+     * is not empty and <code>value</code> is not less than
+     * <code>set.first()</code>.
+     * Not available for HashSet.
+     */
+    template <typename MapType = typename SetTraits::MapType>
+    value_type floor(const value_type& value) const;
+
     /**
      * Method: intersect
      * Usage: set.intersect(set2);
@@ -1187,6 +1443,34 @@ public:
      */
     void mapAll(std::function<void (const value_type&)> fn) const;
 
+    /**
+     * Method: range
+     * Usage: for (ValueType value : set.range(lo, hi)) ...
+     * ----------------------------------------------------
+     * Returns the elements of this set that are at least <code>lo</code> and
+     * less than <code>hi</code>, in ascending order, for use in a
+     * <code>for-each</code> loop.  The elements are not copied; as with any
+     * loop over the set, the set must not be modified during the loop.
+     * Generates an error if <code>hi</code> is less than <code>lo</code>.
+     * Not available for HashSet.
+     */
+    template <typename MapType = typename SetTraits::MapType>
+    IteratorRange<typename MapType::const_iterator>
+    range(const value_type& lo, const value_type& hi) const;
+
+    /**
+     * Method: rank
+     * Usage: int index = set.rank(value);
+     * -----------------------------------
+     * Returns the number of elements of this set that are less than the given
+     * value, which is the index <code>value</code> has or would have in the
+     * order established by the <code>for-each</code> loop.
+     * Takes time proportional to the answer.
+     * Not available for HashSet.
+     */
+    template <typename MapType = typename SetTraits::MapType>
+    int rank(const value_type& value) const;
+
     /**
      * Method: remove
      * Usage: set.remove(value);
@@ -1384,6 +1668,25 @@ private:
     typename SetTraits::MapType _map = SetTraits::construct();  /* Map used to store the elements    */
     bool _removeFlag = false;                                   /* Flag to differentiate += and -=   */
 
+    /*
+     * (ceiling, floor, range, and rank above are templates only so that they
+     * are not instantiated for HashSet, whose storage does not support them.)
+     */
+
+    /*
+     * addAll adds all of map2's keys to map, and containsAll returns true if
+     * map has all of subset's keys.  A sorted set's storage does these by
+     * merging; any other map looks up one key at a time.
+     */
+    template <typename T>
+    static void addAll(SortedKeySet<T>& map, const SortedKeySet<T>& map2);
+    template <typename MapType>
+    static void addAll(MapType& map, const MapType& map2);
+    template <typename T>
+    static bool containsAll(const SortedKeySet<T>& map, const SortedKeySet<T>& subset);
+    template <typename MapType>
+    static bool containsAll(const MapType& map, const MapType& subset);
+
 public:
     /*
      * Hidden features
@@ -1456,6 +1759,27 @@ void GenericSet<SetTraits>::add(const value_type& value) {
     _map.put(value, true);
 }
 
+template <typename SetTraits>
+template <typename T>
+void GenericSet<SetTraits>::addAll(SortedKeySet<T>& map, const SortedKeySet<T>& map2) {
+    map.putAll(map2);
+}
+
+template <typename SetTraits>
+template <typename MapType>
+void GenericSet<SetTraits>::addAll(MapType& map, const MapType& map2) {
+    for (const auto& value : map2) {
+        map.put(value, true);
+    }
+}
+
+template <typename SetTraits>
+template <typename MapType>
+typename GenericSet<SetTraits>::value_type
+GenericSet<SetTraits>::ceiling(const value_type& value) const {
+    return _map.ceilingKey(value);
+}
+
 template <typename SetTraits>
 typename GenericSet<SetTraits>::value_type
 GenericSet<SetTraits>::last() const {
@@ -1475,6 +1799,26 @@ bool GenericSet<SetTraits>::contains(const value_type& value) const {
     return _map.containsKey(value);
 }
 
+template <typename SetTraits>
+template <typename T>
+bool GenericSet<SetTraits>::containsAll(const SortedKeySet<T>& map, const SortedKeySet<T>& subset) {
+    return map.containsAll(subset);
+}
+
+template <typename SetTraits>
+template <typename MapType>
+bool GenericSet<SetTraits>::containsAll(const MapType& map, const MapType& subset) {
+    if (subset.size() > map.size()) {
+        return false;
+    }
+    for (const auto& value : subset) {
+        if (!map.containsKey(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template <typename SetTraits>
 GenericSet<SetTraits>& GenericSet<SetTraits>::difference(const GenericSet<SetTraits>& set2) {
     _map.removeAll(set2._map);
@@ -1506,6 +1850,13 @@ GenericSet<SetTraits>::first() const {
     return _map.firstKey();
 }
 
+template <typename SetTraits>
+template <typename MapType>
+typename GenericSet<SetTraits>::value_type
+GenericSet<SetTraits>::floor(const value_type& value) const {
+    return _map.floorKey(value);
+}
+
 template <typename SetTraits>
 GenericSet<SetTraits>& GenericSet<SetTraits>::intersect(const GenericSet<SetTraits>& set2) {
     _map.retainAll(set2._map);
@@ -1519,22 +1870,12 @@ bool GenericSet<SetTraits>::isEmpty() const {
 
 template <typename SetTraits>
 bool GenericSet<SetTraits>::isSubsetOf(const GenericSet& set2) const {
-    for (const auto& elem: *this) {
-        if (!set2.contains(elem)) {
-            return false;
-        }
-    }
-    return true;
+    return containsAll(set2._map, _map);
 }
 
 template <typename SetTraits>
 bool GenericSet<SetTraits>::isSupersetOf(const GenericSet& set2) const {
-    for (const auto& value: set2) {
-        if (!contains(value)) {
-            return false;
-        }
-    }
-    return true;
+    return containsAll(_map, set2._map);
 }
 
 template <typename SetTraits>
@@ -1544,6 +1885,19 @@ void GenericSet<SetTraits>::mapAll(std::function<void (const value_type &)> fn)
     });
 }
 
+template <typename SetTraits>
+template <typename MapType>
+IteratorRange<typename MapType::const_iterator>
+GenericSet<SetTraits>::range(const value_type& lo, const value_type& hi) const {
+    return _map.range(lo, hi);
+}
+
+template <typename SetTraits>
+template <typename MapType>
+int GenericSet<SetTraits>::rank(const value_type& value) const {
+    return _map.rank(value);
+}
+
 template <typename SetTraits>
 void GenericSet<SetTraits>::remove(const value_type& value) {
     _map.remove(value);
@@ -1563,9 +1917,7 @@ std::string GenericSet<SetTraits>::toString() const {
 
 template <typename SetTraits>
 GenericSet<SetTraits>& GenericSet<SetTraits>::unionWith(const GenericSet<SetTraits>& set2) {
-    for (const auto& value : set2) {
-        add(value);
-    }
+    addAll(_map, set2._map);
     return *this;
 }
 
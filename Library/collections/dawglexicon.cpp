@@ -217,9 +217,9 @@ void DawgLexicon::readBinaryFile(const std::string& filename) {
         error(partial + " (invalid start index format)");
     }
 
-    int totalFileSize = fileSize(filename);
-    int numBytesRemaining = totalFileSize - (int)input.tellg();
-    if (_edgeCount*sizeof(Edge) != numBytesRemaining) {
+    int64_t totalFileSize = fileSize(filename);
+    int64_t numBytesRemaining = totalFileSize - (int64_t) input.tellg();
+    if (_edgeCount < 0 || (int64_t) _edgeCount * (int64_t) sizeof(Edge) != numBytesRemaining) {
         error(partial + " (invalid file size)");
     }
     if ( _startIndex >= _edgeCount) {
@@ -228,8 +228,8 @@ void DawgLexicon::readBinaryFile(const std::string& filename) {
 
     _edges = new Edge[_edgeCount];
     input.read((char*) _edges, _edgeCount*sizeof(Edge));
-    int numRead = input.gcount();
-    if ((input.fail() && !input.eof()) || (numRead != _edgeCount*sizeof(Edge))) {
+    std::streamsize numRead = input.gcount();
+    if ((input.fail() && !input.eof()) || (numRead != (std::streamsize) (_edgeCount * sizeof(Edge)))) {
         error(partial + " (invalid edges)");
     }
 
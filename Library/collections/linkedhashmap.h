@@ -0,0 +1,1107 @@
+/*
+ * File: linkedhashmap.h
+ * ---------------------
+ * This file exports the <code>LinkedHashMap</code> class, which stores
+ * a set of <i>key</i>-<i>value</i> pairs.
+ * Identical to a HashMap except that upon iteration using a for-each loop
+ * or << / toString call, it will emit its key/value pairs in the order they
+ * were originally inserted.
+ *
+ * @version 2026/10/19
+ * - initial version, built on a flat hash table threaded with a linked
+ *   list so that remove and reordering take constant time
+ */
+
+#ifndef _linkedhashmap_h
+#define _linkedhashmap_h
+
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "collections.h"
+#include "error.h"
+#include "hashcode.h"
+#include "vector.h"
+
+/*
+ * Class: LinkedHashMap<KeyType,ValueType>
+ * ---------------------------------------
+ * This class implements an efficient association between
+ * <b><i>keys</i></b> and <b><i>values</i></b>, like
+ * <a href="HashMap-class.html"><code>HashMap</code></a>, but its iterator
+ * returns the keys in a predictable order: the order in which they were
+ * first added, as changed by <code>moveToBack</code> and
+ * <code>moveToFront</code>.  All of the single-key operations take
+ * constant time on average.
+ *
+ * Because the keys can be reordered and the oldest one removed in constant
+ * time, a LinkedHashMap also works as a least-recently-used cache:
+ *
+ *<pre>
+ *    if (cache.moveToBack(key)) {        // hit: now the most recent entry
+ *        return cache[key];
+ *    }
+ *    cache.put(key, compute(key));       // miss: add as the most recent entry
+ *    cache.trimToSize(capacity);         // evict the least recent entries
+ *</pre>
+ */
+template <typename KeyType, typename ValueType>
+class LinkedHashMap {
+public:
+    /*
+     * Constructor: LinkedHashMap
+     * Usage: LinkedHashMap<KeyType,ValueType> map;
+     * --------------------------------------------
+     * Initializes a new empty map that associates keys and values of
+     * the specified types.  The type used for the key must define
+     * the <code>==</code> operator, and there must be a free function
+     * with the following signature:
+     *
+     *<pre>
+     *    int hashCode(KeyType key);
+     *</pre>
+     *
+     * that returns a positive integer determined by the key.  This interface
+     * exports <code>hashCode</code> functions for <code>string</code> and
+     * the C++ primitive types.
+     */
+    LinkedHashMap() = default;
+
+    /*
+     * Constructor: LinkedHashMap
+     * Usage: LinkedHashMap<KeyType,ValueType> map {{"a", 1}, {"b", 2}, {"c", 3}};
+     * ---------------------------------------------------------------------------
+     * Initializes a new map that stores the given pairs, in the order in
+     * which they are written in the initializer list.
+     */
+    LinkedHashMap(std::initializer_list<std::pair<const KeyType, ValueType>> list);
+
+    /*
+     * Destructor: ~LinkedHashMap
+     * --------------------------
+     * Frees any heap storage associated with this map.
+     */
+    virtual ~LinkedHashMap() = default;
+
+    /*
+     * Method: add
+     * Usage: map.add(key, value);
+     * ---------------------------
+     * Associates <code>key</code> with <code>value</code> in this map.
+     * A synonym for the put method.
+     */
+    void add(const KeyType& key, const ValueType& value);
+
+    /*
+     * Method: addAll
+     * Usage: map.addAll(map2);
+     * ------------------------
+     * Adds all key/value pairs from the given map to this map.
+     * A synonym for the putAll method.
+     * Returns a reference to this map.
+     */
+    LinkedHashMap& addAll(const LinkedHashMap& map2);
+
+    /*
+     * Method: clear
+     * Usage: map.clear();
+     * -------------------
+     * Removes all entries from this map.
+     */
+    void clear();
+
+    /*
+     * Method: containsKey
+     * Usage: if (map.containsKey(key)) ...
+     * ------------------------------------
+     * Returns <code>true</code> if there is an entry for <code>key</code>
+     * in this map.
+     */
+    bool containsKey(const KeyType& key) const;
+
+    /*
+     * Method: equals
+     * Usage: if (map.equals(map2)) ...
+     * --------------------------------
+     * Returns <code>true</code> if the two maps contain exactly the same
+     * key/value pairs, and <code>false</code> otherwise.
+     * The order of the keys is not considered.
+     */
+    bool equals(const LinkedHashMap& map2) const;
+
+    /*
+     * Method: firstKey
+     * Usage: KeyType key = map.firstKey();
+     * ------------------------------------
+     * Returns the first key in the map in the order established by the
+     * <code>for-each</code> loop; this is the least recently added or moved key.
+     * If the map is empty, generates an error.
+     */
+    KeyType firstKey() const;
+
+    /*
+     * Method: get
+     * Usage: ValueType value = map.get(key);
+     * --------------------------------------
+     * Returns the value associated with <code>key</code> in this map.
+     * If <code>key</code> is not found, <code>get</code> returns the
+     * default value for <code>ValueType</code>.
+     */
+    ValueType get(const KeyType& key) const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (map.isEmpty()) ...
+     * -----------------------------
+     * Returns <code>true</code> if this map contains no entries.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: keys
+     * Usage: Vector<KeyType> keys = map.keys();
+     * -----------------------------------------
+     * Returns a collection containing all keys in this map, in order.
+     * Note that this implementation makes a deep copy of the keys,
+     * so it is inefficient to call on large maps.
+     */
+    Vector<KeyType> keys() const;
+
+    /*
+     * Method: lastKey
+     * Usage: KeyType key = map.lastKey();
+     * -----------------------------------
+     * Returns the last key in the map in the order established by the
+     * <code>for-each</code> loop; this is the most recently added or moved key.
+     * If the map is empty, generates an error.
+     */
+    KeyType lastKey() const;
+
+    /*
+     * Method: mapAll
+     * Usage: map.mapAll(fn);
+     * ----------------------
+     * Iterates through the map entries and calls <code>fn(key, value)</code>
+     * for each one, in order.
+     */
+    void mapAll(std::function<void(const KeyType&, const ValueType&)> fn) const;
+
+    /*
+     * Method: moveToBack
+     * Usage: if (map.moveToBack(key)) ...
+     * -----------------------------------
+     * Moves the entry for <code>key</code> to the end of the iteration order,
+     * as if it had just been added, and returns <code>true</code>.
+     * If the given key is not found, has no effect and returns <code>false</code>.
+     */
+    bool moveToBack(const KeyType& key);
+
+    /*
+     * Method: moveToFront
+     * Usage: if (map.moveToFront(key)) ...
+     * ------------------------------------
+     * Moves the entry for <code>key</code> to the start of the iteration
+     * order and returns <code>true</code>.
+     * If the given key is not found, has no effect and returns <code>false</code>.
+     */
+    bool moveToFront(const KeyType& key);
+
+    /*
+     * Method: put
+     * Usage: map.put(key, value);
+     * ---------------------------
+     * Associates <code>key</code> with <code>value</code> in this map.
+     * Any previous value associated with <code>key</code> is replaced
+     * by the new value, and the key keeps its place in the order;
+     * a new key is added at the end.
+     */
+    void put(const KeyType& key, const ValueType& value);
+
+    /*
+     * Method: putAll
+     * Usage: map.putAll(map2);
+     * ------------------------
+     * Adds all key/value pairs from the given map to this map, in the
+     * order of the given map.
+     * If both maps contain a pair for the same key, the one from map2 will
+     * replace the one from this map.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     * Returns a reference to this map.
+     */
+    LinkedHashMap& putAll(const LinkedHashMap& map2);
+
+    /*
+     * Method: remove
+     * Usage: map.remove(key);
+     * -----------------------
+     * Removes any entry for <code>key</code> from this map.
+     * If the given key is not found, has no effect.
+     */
+    void remove(const KeyType& key);
+
+    /*
+     * Method: removeAll
+     * Usage: map.removeAll(map2);
+     * ---------------------------
+     * Removes all key/value pairs from this map that are contained in the given map.
+     * If both maps contain the same key but it maps to different values, that
+     * mapping will not be removed.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     * Returns a reference to this map.
+     */
+    LinkedHashMap& removeAll(const LinkedHashMap& map2);
+
+    /*
+     * Method: removeFirst
+     * Usage: KeyType key = map.removeFirst();
+     * ---------------------------------------
+     * Removes the first entry in the order, which is the least recently
+     * added or moved one, and returns its key.
+     * If the map is empty, generates an error.
+     */
+    KeyType removeFirst();
+
+    /*
+     * Method: removeLast
+     * Usage: KeyType key = map.removeLast();
+     * --------------------------------------
+     * Removes the last entry in the order and returns its key.
+     * If the map is empty, generates an error.
+     */
+    KeyType removeLast();
+
+    /*
+     * Method: retainAll
+     * Usage: map.retainAll(map2);
+     * ---------------------------
+     * Removes all key/value pairs from this map that are not contained in the given map.
+     * If both maps contain the same key but it maps to different values, that
+     * mapping will be removed.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     * Returns a reference to this map.
+     */
+    LinkedHashMap& retainAll(const LinkedHashMap& map2);
+
+    /*
+     * Method: size
+     * Usage: int nEntries = map.size();
+     * ---------------------------------
+     * Returns the number of entries in this map.
+     */
+    int size() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = map.toString();
+     * -----------------------------------
+     * Converts the map to a printable string representation.
+     */
+    std::string toString() const;
+
+    /*
+     * Method: trimToSize
+     * Usage: map.trimToSize(maxSize);
+     * -------------------------------
+     * Removes entries from the front of the order until the map holds at
+     * most <code>maxSize</code> entries; this is the eviction step of a
+     * least-recently-used cache.
+     * Generates an error if <code>maxSize</code> is negative.
+     */
+    void trimToSize(int maxSize);
+
+    /*
+     * Method: values
+     * Usage: Vector<ValueType> values = map.values();
+     * -----------------------------------------------
+     * Returns a collection containing all values in this map, in the
+     * order of their keys.
+     * Note that this implementation makes a deep copy of the values,
+     * so it is inefficient to call on large maps.
+     */
+    Vector<ValueType> values() const;
+
+    /*
+     * Operator: []
+     * Usage: map[key]
+     * ---------------
+     * Selects the value associated with <code>key</code>.  If
+     * <code>key</code> is already present in the map, this function returns
+     * a reference to its associated value, without changing the order.  If
+     * key is not present in the map, a new entry is created at the end whose
+     * value is set to the default for the value type.
+     */
+    ValueType& operator [](const KeyType& key);
+    const ValueType& operator [](const KeyType& key) const;
+
+    /*
+     * Operator: +
+     * Usage: map1 + map2
+     * ------------------
+     * Returns the union of the two maps, equivalent to a copy of the first map
+     * with putAll called on it passing the second map as a parameter.
+     * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
+     */
+    LinkedHashMap operator +(const LinkedHashMap& map2) const;
+
+    /*
+     * Operator: +=
+     * Usage: map1 += map2;
+     * --------------------
+     * Adds all key/value pairs from the given map to this map.
+     * Equivalent to calling putAll(map2).
+     */
+    LinkedHashMap& operator +=(const LinkedHashMap& map2);
+
+    /*
+     * Operator: -
+     * Usage: map1 - map2
+     * ------------------
+     * Returns the difference of the two maps, equivalent to a copy of the first map
+     * with removeAll called on it passing the second map as a parameter.
+     */
+    LinkedHashMap operator -(const LinkedHashMap& map2) const;
+
+    /*
+     * Operator: -=
+     * Usage: map1 -= map2;
+     * --------------------
+     * Removes all key/value pairs from the given map to this map.
+     * Equivalent to calling removeAll(map2).
+     */
+    LinkedHashMap& operator -=(const LinkedHashMap& map2);
+
+    /*
+     * Operator: *
+     * Usage: map1 * map2
+     * ------------------
+     * Returns the intersection of the two maps, equivalent to a copy of the first map
+     * with retainAll called on it passing the second map as a parameter.
+     */
+    LinkedHashMap operator *(const LinkedHashMap& map2) const;
+
+    /*
+     * Operator: *=
+     * Usage: map1 *= map2;
+     * ---------------------
+     * Removes all key/value pairs that are not found in the given map from this map.
+     * Equivalent to calling retainAll(map2).
+     */
+    LinkedHashMap& operator *=(const LinkedHashMap& map2);
+
+    /*
+     * Operators: ==, !=
+     * Usage: if (map1 == map2) ...
+     * ----------------------------
+     * Compares two maps for equality, ignoring the order of their keys.
+     */
+    bool operator ==(const LinkedHashMap& map2) const;
+    bool operator !=(const LinkedHashMap& map2) const;
+
+    /*
+     * Operators: <, <=, >, >=
+     * Usage: if (map1 < map2) ...
+     * ---------------------------
+     * Relational operators to compare two maps.  Maps that are equal, in
+     * any order, compare as equal; otherwise the key/value pairs are
+     * compared pairwise in iteration order.
+     * The key and value types must both have a < operator.
+     */
+    bool operator <(const LinkedHashMap& map2) const;
+    bool operator <=(const LinkedHashMap& map2) const;
+    bool operator >(const LinkedHashMap& map2) const;
+    bool operator >=(const LinkedHashMap& map2) const;
+
+    /*
+     * Additional LinkedHashMap operations
+     * -----------------------------------
+     * In addition to the methods listed in this interface, the LinkedHashMap
+     * class supports the following operations:
+     *
+     *   - Stream I/O using the << and >> operators
+     *   - Deep copying for the copy constructor and assignment operator
+     *   - Iteration using the range-based for statement and STL iterators
+     *
+     * During iteration, the LinkedHashMap class returns its keys in order.
+     */
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+
+private:
+    static_assert(stanfordcpplib::collections::IsHashable<KeyType>::value,
+                  "Oops! You tried using a type as a key in our LinkedHashMap without making it hashable. Click this error for more details.");
+    /*
+     * Hello CS106 students! If you got directed to this line of code in a compiler error,
+     * your key type needs a hashCode function and an == operator, just as it would for
+     * a HashMap.  See the longer note in hashmap.h for how to write them.
+     */
+
+    /*
+     * Implementation notes: representation
+     * -------------------------------------
+     * The entries live in _nodes, a deque so that references to values stay
+     * valid as the map grows, and are chained in order by the prev/next
+     * indexes of a doubly-linked list from _head to _tail.  Removed nodes are
+     * chained through next into a free list starting at _free and reused.
+     *
+     * _slots is an open-addressed hash table with linear probing whose size
+     * is 0 or a power of two.  Each slot holds a node index, or kEmpty, along
+     * with a copy of the node's mixed hash so that probes rarely have to
+     * compare keys.  Removal uses backward-shift deletion, so the table
+     * never contains tombstones.
+     */
+    static const int kEmpty = -1;
+
+    struct Node {
+        KeyType key;
+        ValueType value;
+        int prev;
+        int next;
+        unsigned int hash;
+    };
+
+    struct Slot {
+        int node;
+        unsigned int hash;
+    };
+
+    std::deque<Node> _nodes;
+    std::vector<Slot> _slots;
+    int _head = kEmpty;
+    int _tail = kEmpty;
+    int _free = kEmpty;
+    int _size = 0;
+    stanfordcpplib::collections::VersionTracker _version;
+
+    /* Private methods */
+    void eraseSlot(int slot);
+    int findSlot(const KeyType& key, unsigned int hash) const;
+    static unsigned int hashOf(const KeyType& key);
+    int insert(const KeyType& key, const ValueType& value, unsigned int hash);
+    void linkAfter(int node, int prev);
+    void rehash(size_t capacity);
+    void removeNode(int node);
+    void unlink(int node);
+
+public:
+    /*
+     * Hidden features
+     * ---------------
+     * The remainder of this file consists of the code required to
+     * support deep copying and iteration.  Including these methods
+     * in the public interface would make that interface more
+     * difficult to understand for the average client.
+     */
+
+    /*
+     * Iterator support
+     * ----------------
+     * A LinkIterator walks the linked list of nodes; the public iterator
+     * wraps it in a CheckedIterator, which reports an error if the map is
+     * changed during iteration.
+     */
+    class LinkIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = KeyType;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const KeyType*;
+        using reference         = const KeyType&;
+
+        LinkIterator() = default;
+        LinkIterator(const LinkedHashMap* map, int node) : _map(map), _node(node) {}
+
+        reference operator *() const {
+            return _map->_nodes[_node].key;
+        }
+        pointer operator ->() const {
+            return &**this;
+        }
+        LinkIterator& operator ++() {
+            _node = _map->_nodes[_node].next;
+            return *this;
+        }
+        LinkIterator operator ++(int) {
+            LinkIterator result = *this;
+            ++*this;
+            return result;
+        }
+        LinkIterator& operator --() {
+            _node = _node == kEmpty ? _map->_tail : _map->_nodes[_node].prev;
+            return *this;
+        }
+        LinkIterator operator --(int) {
+            LinkIterator result = *this;
+            --*this;
+            return result;
+        }
+        bool operator ==(const LinkIterator& rhs) const {
+            return _map == rhs._map && _node == rhs._node;
+        }
+        bool operator !=(const LinkIterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        const LinkedHashMap* _map = nullptr;
+        int _node = kEmpty;
+    };
+
+    using const_iterator = stanfordcpplib::collections::CheckedIterator<LinkIterator>;
+    using iterator = const_iterator;
+
+    iterator begin() const;
+    iterator end() const;
+
+    template <typename K, typename V>
+    friend int hashCode(const LinkedHashMap<K, V>& map);
+
+private:
+    /* The list bounds that CheckedIterator checks its LinkIterator against. */
+    struct Links {
+        const LinkedHashMap* map;
+        LinkIterator begin() const {
+            return LinkIterator(map, map->_head);
+        }
+        LinkIterator end() const {
+            return LinkIterator(map, kEmpty);
+        }
+    };
+};
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>::LinkedHashMap(std::initializer_list<std::pair<const KeyType, ValueType>> list) {
+    for (const auto& entry : list) {
+        put(entry.first, entry.second);
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::add(const KeyType& key, const ValueType& value) {
+    put(key, value);
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::addAll(const LinkedHashMap& map2) {
+    return putAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::clear() {
+    _nodes.clear();
+    _slots.clear();
+    _head = _tail = _free = kEmpty;
+    _size = 0;
+    _version.update();
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
+    return findSlot(key, hashOf(key)) != kEmpty;
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::equals(const LinkedHashMap& map2) const {
+    return stanfordcpplib::collections::equalsMap(*this, map2);
+}
+
+template <typename KeyType, typename ValueType>
+KeyType LinkedHashMap<KeyType, ValueType>::firstKey() const {
+    if (isEmpty()) {
+        error("LinkedHashMap::firstKey: map is empty");
+    }
+    return _nodes[_head].key;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType LinkedHashMap<KeyType, ValueType>::get(const KeyType& key) const {
+    int slot = findSlot(key, hashOf(key));
+    return slot == kEmpty ? ValueType() : _nodes[_slots[slot].node].value;
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::isEmpty() const {
+    return _size == 0;
+}
+
+template <typename KeyType, typename ValueType>
+Vector<KeyType> LinkedHashMap<KeyType, ValueType>::keys() const {
+    Vector<KeyType> keyset;
+    for (int node = _head; node != kEmpty; node = _nodes[node].next) {
+        keyset.add(_nodes[node].key);
+    }
+    return keyset;
+}
+
+template <typename KeyType, typename ValueType>
+KeyType LinkedHashMap<KeyType, ValueType>::lastKey() const {
+    if (isEmpty()) {
+        error("LinkedHashMap::lastKey: map is empty");
+    }
+    return _nodes[_tail].key;
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::mapAll(std::function<void (const KeyType&, const ValueType&)> fn) const {
+    for (int node = _head; node != kEmpty; node = _nodes[node].next) {
+        fn(_nodes[node].key, _nodes[node].value);
+    }
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::moveToBack(const KeyType& key) {
+    int slot = findSlot(key, hashOf(key));
+    if (slot == kEmpty) {
+        return false;
+    }
+    int node = _slots[slot].node;
+    if (node != _tail) {
+        unlink(node);
+        linkAfter(node, _tail);
+        _version.update();
+    }
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::moveToFront(const KeyType& key) {
+    int slot = findSlot(key, hashOf(key));
+    if (slot == kEmpty) {
+        return false;
+    }
+    int node = _slots[slot].node;
+    if (node != _head) {
+        unlink(node);
+        linkAfter(node, kEmpty);
+        _version.update();
+    }
+    return true;
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::put(const KeyType& key, const ValueType& value) {
+    unsigned int hash = hashOf(key);
+    int slot = findSlot(key, hash);
+    if (slot == kEmpty) {
+        insert(key, value, hash);
+    } else {
+        _nodes[_slots[slot].node].value = value;
+    }
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::putAll(const LinkedHashMap& map2) {
+    if (this != &map2) {
+        for (int node = map2._head; node != kEmpty; node = map2._nodes[node].next) {
+            put(map2._nodes[node].key, map2._nodes[node].value);
+        }
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::remove(const KeyType& key) {
+    int slot = findSlot(key, hashOf(key));
+    if (slot != kEmpty) {
+        int node = _slots[slot].node;
+        eraseSlot(slot);
+        removeNode(node);
+    }
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::removeAll(const LinkedHashMap& map2) {
+    if (this == &map2) {
+        clear();
+        return *this;
+    }
+    for (int node = map2._head; node != kEmpty; node = map2._nodes[node].next) {
+        const Node& entry = map2._nodes[node];
+        int slot = findSlot(entry.key, entry.hash);
+        if (slot != kEmpty && _nodes[_slots[slot].node].value == entry.value) {
+            int mine = _slots[slot].node;
+            eraseSlot(slot);
+            removeNode(mine);
+        }
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+KeyType LinkedHashMap<KeyType, ValueType>::removeFirst() {
+    if (isEmpty()) {
+        error("LinkedHashMap::removeFirst: map is empty");
+    }
+    KeyType key = _nodes[_head].key;
+    remove(key);
+    return key;
+}
+
+template <typename KeyType, typename ValueType>
+KeyType LinkedHashMap<KeyType, ValueType>::removeLast() {
+    if (isEmpty()) {
+        error("LinkedHashMap::removeLast: map is empty");
+    }
+    KeyType key = _nodes[_tail].key;
+    remove(key);
+    return key;
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::retainAll(const LinkedHashMap& map2) {
+    int node = _head;
+    while (node != kEmpty) {
+        int next = _nodes[node].next;
+        const Node& entry = _nodes[node];
+        int slot = map2.findSlot(entry.key, entry.hash);
+        if (slot == kEmpty || !(map2._nodes[map2._slots[slot].node].value == entry.value)) {
+            eraseSlot(findSlot(entry.key, entry.hash));
+            removeNode(node);
+        }
+        node = next;
+    }
+    return *this;
+}
+
+template <typename KeyType, typename ValueType>
+int LinkedHashMap<KeyType, ValueType>::size() const {
+    return _size;
+}
+
+template <typename KeyType, typename ValueType>
+std::string LinkedHashMap<KeyType, ValueType>::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::trimToSize(int maxSize) {
+    if (maxSize < 0) {
+        error("LinkedHashMap::trimToSize: size cannot be negative");
+    }
+    while (_size > maxSize) {
+        int slot = findSlot(_nodes[_head].key, _nodes[_head].hash);
+        int node = _head;
+        eraseSlot(slot);
+        removeNode(node);
+    }
+}
+
+template <typename KeyType, typename ValueType>
+Vector<ValueType> LinkedHashMap<KeyType, ValueType>::values() const {
+    Vector<ValueType> values;
+    for (int node = _head; node != kEmpty; node = _nodes[node].next) {
+        values.add(_nodes[node].value);
+    }
+    return values;
+}
+
+template <typename KeyType, typename ValueType>
+ValueType& LinkedHashMap<KeyType, ValueType>::operator [](const KeyType& key) {
+    unsigned int hash = hashOf(key);
+    int slot = findSlot(key, hash);
+    int node = slot == kEmpty ? insert(key, ValueType(), hash) : _slots[slot].node;
+    return _nodes[node].value;
+}
+
+template <typename KeyType, typename ValueType>
+const ValueType& LinkedHashMap<KeyType, ValueType>::operator [](const KeyType& key) const {
+    int slot = findSlot(key, hashOf(key));
+    if (slot != kEmpty) {
+        return _nodes[_slots[slot].node].value;
+    }
+    /* As in HashMap, a missing key reads as a shared default value. */
+    static const ValueType singleton{};
+    return singleton;
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType> LinkedHashMap<KeyType, ValueType>::operator +(const LinkedHashMap& map2) const {
+    LinkedHashMap<KeyType, ValueType> result = *this;
+    return result.putAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::operator +=(const LinkedHashMap& map2) {
+    return putAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType> LinkedHashMap<KeyType, ValueType>::operator -(const LinkedHashMap& map2) const {
+    LinkedHashMap<KeyType, ValueType> result = *this;
+    return result.removeAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::operator -=(const LinkedHashMap& map2) {
+    return removeAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType> LinkedHashMap<KeyType, ValueType>::operator *(const LinkedHashMap& map2) const {
+    LinkedHashMap<KeyType, ValueType> result = *this;
+    return result.retainAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+LinkedHashMap<KeyType, ValueType>& LinkedHashMap<KeyType, ValueType>::operator *=(const LinkedHashMap& map2) {
+    return retainAll(map2);
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::operator ==(const LinkedHashMap& map2) const {
+    return equals(map2);
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::operator !=(const LinkedHashMap& map2) const {
+    return !equals(map2);
+}
+
+/*
+ * Implementation notes: <, <=, >, >=
+ * ----------------------------------
+ * Because == ignores the order of the keys, maps with the same pairs in a
+ * different order must not compare as less or greater, so the ordering
+ * operators check for equality before comparing the pairs in order.
+ */
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::operator <(const LinkedHashMap& map2) const {
+    return !equals(map2) && stanfordcpplib::collections::compareMaps(*this, map2) < 0;
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::operator <=(const LinkedHashMap& map2) const {
+    return equals(map2) || stanfordcpplib::collections::compareMaps(*this, map2) <= 0;
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::operator >(const LinkedHashMap& map2) const {
+    return !equals(map2) && stanfordcpplib::collections::compareMaps(*this, map2) > 0;
+}
+
+template <typename KeyType, typename ValueType>
+bool LinkedHashMap<KeyType, ValueType>::operator >=(const LinkedHashMap& map2) const {
+    return equals(map2) || stanfordcpplib::collections::compareMaps(*this, map2) >= 0;
+}
+
+template <typename KeyType, typename ValueType>
+typename LinkedHashMap<KeyType, ValueType>::iterator LinkedHashMap<KeyType, ValueType>::begin() const {
+    Links links {this};
+    return iterator(&_version, links.begin(), links);
+}
+
+template <typename KeyType, typename ValueType>
+typename LinkedHashMap<KeyType, ValueType>::iterator LinkedHashMap<KeyType, ValueType>::end() const {
+    Links links {this};
+    return iterator(&_version, links.end(), links);
+}
+
+/*
+ * Implementation notes: eraseSlot
+ * -------------------------------
+ * With linear probing, emptying a slot would cut off any later entry in
+ * the same run whose probe started at or before it.  Backward-shift
+ * deletion walks the rest of the run and moves each such entry into the
+ * hole, leaving the table exactly as if the erased key had never been added.
+ */
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::eraseSlot(int slot) {
+    size_t mask = _slots.size() - 1;
+    size_t hole = slot;
+    size_t next = hole;
+    while (true) {
+        next = (next + 1) & mask;
+        if (_slots[next].node == kEmpty) {
+            break;
+        }
+        size_t home = _slots[next].hash & mask;
+        /* The entry can move to the hole unless its home lies in (hole, next]. */
+        bool stays = hole <= next ? (hole < home && home <= next)
+                                  : (hole < home || home <= next);
+        if (!stays) {
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+    }
+    _slots[hole].node = kEmpty;
+}
+
+template <typename KeyType, typename ValueType>
+int LinkedHashMap<KeyType, ValueType>::findSlot(const KeyType& key, unsigned int hash) const {
+    if (_slots.empty()) {
+        return kEmpty;
+    }
+    size_t mask = _slots.size() - 1;
+    for (size_t i = hash & mask; _slots[i].node != kEmpty; i = (i + 1) & mask) {
+        if (_slots[i].hash == hash && _nodes[_slots[i].node].key == key) {
+            return (int) i;
+        }
+    }
+    return kEmpty;
+}
+
+/*
+ * Implementation notes: hashOf
+ * ----------------------------
+ * Many hashCode functions return nearby values for nearby keys; hashCode
+ * of an int is the int itself.  Multiplying by a large odd constant and
+ * folding the high bits down spreads such keys across the table so that
+ * linear probing does not build long runs.
+ */
+template <typename KeyType, typename ValueType>
+unsigned int LinkedHashMap<KeyType, ValueType>::hashOf(const KeyType& key) {
+    unsigned int hash = (unsigned int) hashCode(key) * 0x9e3779b1u;
+    return hash ^ (hash >> 15);
+}
+
+template <typename KeyType, typename ValueType>
+int LinkedHashMap<KeyType, ValueType>::insert(const KeyType& key, const ValueType& value, unsigned int hash) {
+    /* Keep the load factor at or below 3/4. */
+    if ((size_t) (_size + 1) * 4 > _slots.size() * 3) {
+        rehash(_slots.empty() ? 8 : _slots.size() * 2);
+    }
+    int node;
+    if (_free != kEmpty) {
+        node = _free;
+        _free = _nodes[node].next;
+        _nodes[node].key = key;
+        _nodes[node].value = value;
+        _nodes[node].hash = hash;
+    } else {
+        node = (int) _nodes.size();
+        _nodes.push_back(Node {key, value, kEmpty, kEmpty, hash});
+    }
+    linkAfter(node, _tail);
+
+    size_t mask = _slots.size() - 1;
+    size_t i = hash & mask;
+    while (_slots[i].node != kEmpty) {
+        i = (i + 1) & mask;
+    }
+    _slots[i] = Slot {node, hash};
+    _size++;
+    _version.update();
+    return node;
+}
+
+/*
+ * Links the given node into the list after prev, or at the front if prev
+ * is kEmpty.
+ */
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::linkAfter(int node, int prev) {
+    int next = prev == kEmpty ? _head : _nodes[prev].next;
+    _nodes[node].prev = prev;
+    _nodes[node].next = next;
+    if (prev == kEmpty) {
+        _head = node;
+    } else {
+        _nodes[prev].next = node;
+    }
+    if (next == kEmpty) {
+        _tail = node;
+    } else {
+        _nodes[next].prev = node;
+    }
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::rehash(size_t capacity) {
+    _slots.assign(capacity, Slot {kEmpty, 0});
+    size_t mask = capacity - 1;
+    for (int node = _head; node != kEmpty; node = _nodes[node].next) {
+        size_t i = _nodes[node].hash & mask;
+        while (_slots[i].node != kEmpty) {
+            i = (i + 1) & mask;
+        }
+        _slots[i] = Slot {node, _nodes[node].hash};
+    }
+}
+
+/*
+ * Unlinks a node whose slot has already been erased and puts it on the
+ * free list, resetting its key and value so that they release any storage.
+ */
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::removeNode(int node) {
+    unlink(node);
+    _nodes[node].key = KeyType();
+    _nodes[node].value = ValueType();
+    _nodes[node].next = _free;
+    _free = node;
+    _size--;
+    _version.update();
+}
+
+template <typename KeyType, typename ValueType>
+void LinkedHashMap<KeyType, ValueType>::unlink(int node) {
+    int prev = _nodes[node].prev;
+    int next = _nodes[node].next;
+    if (prev == kEmpty) {
+        _head = next;
+    } else {
+        _nodes[prev].next = next;
+    }
+    if (next == kEmpty) {
+        _tail = prev;
+    } else {
+        _nodes[next].prev = prev;
+    }
+}
+
+/*
+ * Template hash function for linked hash maps.
+ * Requires the key and value types in the LinkedHashMap to have a hashCode function.
+ * The order of the keys is not considered, to agree with ==.
+ */
+template <typename K, typename V>
+int hashCode(const LinkedHashMap<K, V>& map) {
+    return stanfordcpplib::collections::hashCodeMap(map, /* orderMatters */ false);
+}
+
+/*
+ * Implementation notes: << and >>
+ * -------------------------------
+ * The insertion and extraction operators use the template facilities in
+ * strlib.h to read and write generic values in a way that treats strings
+ * specially.
+ */
+template <typename KeyType, typename ValueType>
+std::ostream& operator <<(std::ostream& os,
+                          const LinkedHashMap<KeyType, ValueType>& map) {
+    return stanfordcpplib::collections::writeMap(os, map);
+}
+
+template <typename KeyType, typename ValueType>
+std::istream& operator >>(std::istream& is,
+                          LinkedHashMap<KeyType, ValueType>& map) {
+    KeyType key;
+    ValueType value;
+    return stanfordcpplib::collections::readPairedCollection(is, map, key, value, /* descriptor */ std::string("LinkedHashMap::operator >>"));
+}
+
+/*
+ * Function: randomKey
+ * Usage: element = randomKey(map);
+ * --------------------------------
+ * Returns a randomly chosen key of the given map.
+ * Throws an error if the map is empty.
+ */
+template <typename K, typename V>
+const K& randomKey(const LinkedHashMap<K, V>& map) {
+    return stanfordcpplib::collections::randomElement(map);
+}
+
+#endif // _linkedhashmap_h
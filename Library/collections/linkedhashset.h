@@ -0,0 +1,90 @@
+/*
+ * File: linkedhashset.h
+ * ---------------------
+ * This file exports the <code>LinkedHashSet</code> class, which
+ * implements an efficient abstraction for storing sets of values
+ * that remembers the order in which they were added.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#ifndef _linkedhashset_h
+#define _linkedhashset_h
+
+#include <initializer_list>
+#include <iostream>
+
+#include "collections.h"
+#include "linkedhashmap.h"
+
+/* Traits type for the LinkedHashSet, which wraps an underlying LinkedHashMap. */
+namespace stanfordcpplib {
+    namespace collections {
+        template <typename T> struct LinkedHashSetTraits {
+            using ValueType = T;
+            using MapType   = LinkedHashMap<T, bool>;
+            static std::string name() {
+                return "LinkedHashSet";
+            }
+            /* You can default-construct a LinkedHashSet. */
+            static MapType construct() {
+                return {};
+            }
+
+            /* However, you can't pass in any other arguments. */
+            template <typename... Args>
+            static void construct(Args&&...) {
+                static_assert(Fail<Args...>::value, "Oops! Seems like you tried to initialize a LinkedHashSet incorrectly. Click here for details.");
+
+                /*
+                 * Hello student! If you are reading this message, it means that you tried to
+                 * initialize a LinkedHashSet improperly. For example, you might have tried to
+                 * write something like this:
+                 *
+                 *     LinkedHashSet<int> mySet = 137; // Oops!
+                 *
+                 * Here, for example, you're trying to assign an int to a LinkedHashSet<int>.
+                 *
+                 * or perhaps you had a function like this one:
+                 *
+                 *     void myFunction(LinkedHashSet<int>& mySet);
+                 *
+                 * and you called it by writing
+                 *
+                 *     myFunction(someSet + someOtherSet); // Oops!
+                 *     myFunction({ });                    // Oops!
+                 *
+                 * In these cases, you're trying to pass a value into a function that takes
+                 * its argument by (non-const) reference. C++ doesn't allow you to do this.
+                 *
+                 * To see where the actual error comes from, look in the list of error messages
+                 * in Qt Creator. You should see a line that says "required from here" that
+                 * points somewhere in your code. That's the actual line you wrote that caused
+                 * the problem, so double-click on that error message and see where it takes
+                 * you. Now you know where to look!
+                 *
+                 * Hope this helps!
+                 */
+                error("static_assert succeeded?");
+            }
+        };
+    }
+}
+
+/*
+ * A set of elements that remembers their insertion order during iteration.
+ * Elements can only be stored here if they support a function
+ *
+ *     int hashCode(ValueType);
+ *
+ * that returns a nonnegative integer, along with equality comparison using ==.
+ *
+ * Adding an element that is already present leaves it in its place; removing
+ * it and adding it again moves it to the end.  Both take constant time, as
+ * does removing any element, so first() is always the oldest element.
+ */
+template <typename ValueType>
+    using LinkedHashSet = stanfordcpplib::collections::GenericSet<stanfordcpplib::collections::LinkedHashSetTraits<ValueType>>;
+
+#endif // _linkedhashset_h
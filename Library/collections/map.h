@@ -3,6 +3,10 @@
  * -----------
  * This file exports the template class <code>Map</code>, which
  * maintains a collection of <i>key</i>-<i>value</i> pairs.
+ *
+ * @version 2026/10/19
+ * - merge-based equals, putAll, removeAll, and retainAll
+ * - added ceilingKey, floorKey, range, and rank
  */
 
 #ifndef _map_h
@@ -83,6 +87,18 @@ public:
      */
     virtual ~Map() = default;
 
+    /*
+     * Method: ceilingKey
+     * Usage: KeyType key2 = map.ceilingKey(key);
+     * ------------------------------------------
+     * Returns the least key in this map that is greater than or equal to
+     * the given key, in the order established by the <code>for-each</code>
+     * loop.  If there is no such key, generates an error; one exists if the
+     * map is not empty and <code>key</code> is not greater than
+     * <code>map.lastKey()</code>.
+     */
+    KeyType ceilingKey(const KeyType& key) const;
+
     /*
      * Method: clear
      * Usage: map.clear();
@@ -118,6 +134,18 @@ public:
      */
     KeyType firstKey() const;
 
+    /*
+     * Method: floorKey
+     * Usage: KeyType key2 = map.floorKey(key);
+     * ----------------------------------------
+     * Returns the greatest key in this map that is less than or equal to
+     * the given key, in the order established by the <code>for-each</code>
+     * loop.  If there is no such key, generates an error; one exists if the
+     * map is not empty and <code>key</code> is not less than
+     * <code>map.firstKey()</code>.
+     */
+    KeyType floorKey(const KeyType& key) const;
+
     /*
      * Method: get
      * Usage: ValueType value = map.get(key);
@@ -184,9 +212,22 @@ public:
      * replace the one from this map.
      * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
      * Returns a reference to this map.
+     * If both maps order their keys the same way (see "Set operations" below),
+     * this takes O(N + M) time rather than O(M log N).
      */
     Map& putAll(const Map& map2);
 
+    /*
+     * Method: rank
+     * Usage: int index = map.rank(key);
+     * ---------------------------------
+     * Returns the number of keys in this map that are less than the given
+     * key, which is the index <code>key</code> has or would have in the
+     * order established by the <code>for-each</code> loop.
+     * Takes time proportional to the answer.
+     */
+    int rank(const KeyType& key) const;
+
     /*
      * Method: remove
      * Usage: map.remove(key);
@@ -204,6 +245,8 @@ public:
      * mapping will not be removed.
      * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
      * Returns a reference to this map.
+     * If both maps order their keys the same way (see "Set operations" below),
+     * this takes O(N + M) time rather than O(M log N).
      */
     Map& removeAll(const Map& map2);
 
@@ -216,6 +259,8 @@ public:
      * mapping will be removed.
      * You can also pass an initializer list of pairs such as {{"a", 1}, {"b", 2}, {"c", 3}}.
      * Returns a reference to this map.
+     * If both maps order their keys the same way (see "Set operations" below),
+     * this takes O(N + M) time rather than O(N log M).
      */
     Map& retainAll(const Map& map2);
 
@@ -365,6 +410,17 @@ public:
      * matches the order of the key type.
      */
 
+    /*
+     * Set operations
+     * --------------
+     * equals, putAll, removeAll, and retainAll (and the operators based on
+     * them) walk the two maps' sorted keys side by side, like the merge step
+     * of merge sort, when both maps are known to order their keys the same
+     * way: both use the default < ordering, or the same comparison function
+     * pointer.  Otherwise, or when one map is much smaller than the other,
+     * they look up one key at a time.
+     */
+
     /* Private section */
 
     /**********************************************************************/
@@ -377,6 +433,8 @@ private:
     MapType _elements;
     stanfordcpplib::collections::VersionTracker _version;
 
+    bool sameOrdering(const Map& map2) const;
+
 public:
     /*
      * Hidden features
@@ -392,6 +450,18 @@ public:
 
     const_iterator begin() const;
     const_iterator end() const;
+
+    /*
+     * Method: range
+     * Usage: for (KeyType key : map.range(lo, hi)) ...
+     * ------------------------------------------------
+     * Returns the keys of this map that are at least <code>lo</code> and
+     * less than <code>hi</code>, in ascending order, for use in a
+     * <code>for-each</code> loop.  The keys are not copied; as with any loop
+     * over the map, the map must not be modified during the loop.
+     * Generates an error if <code>hi</code> is less than <code>lo</code>.
+     */
+    stanfordcpplib::collections::IteratorRange<const_iterator> range(const KeyType& lo, const KeyType& hi) const;
 };
 
 template <typename KeyType, typename ValueType>
@@ -424,6 +494,15 @@ KeyType Map<KeyType, ValueType>::lastKey() const {
     return _elements.rbegin()->first;
 }
 
+template <typename KeyType, typename ValueType>
+KeyType Map<KeyType, ValueType>::ceilingKey(const KeyType& key) const {
+    auto itr = _elements.lower_bound(key);
+    if (itr == _elements.end()) {
+        error("Map::ceilingKey: no key is greater than or equal to the given key");
+    }
+    return itr->first;
+}
+
 template <typename KeyType, typename ValueType>
 void Map<KeyType, ValueType>::clear() {
     _elements.clear();
@@ -437,6 +516,9 @@ bool Map<KeyType, ValueType>::containsKey(const KeyType& key) const {
 
 template <typename KeyType, typename ValueType>
 bool Map<KeyType, ValueType>::equals(const Map<KeyType, ValueType>& map2) const {
+    if (sameOrdering(map2)) {
+        return stanfordcpplib::collections::mergeEquals(_elements, map2._elements);
+    }
     return stanfordcpplib::collections::equalsMap(*this, map2);
 }
 
@@ -448,6 +530,15 @@ KeyType Map<KeyType, ValueType>::firstKey() const {
     return _elements.begin()->first;
 }
 
+template <typename KeyType, typename ValueType>
+KeyType Map<KeyType, ValueType>::floorKey(const KeyType& key) const {
+    auto itr = _elements.upper_bound(key);
+    if (itr == _elements.begin()) {
+        error("Map::floorKey: no key is less than or equal to the given key");
+    }
+    return (--itr)->first;
+}
+
 template <typename KeyType, typename ValueType>
 ValueType Map<KeyType, ValueType>::get(const KeyType& key) const {
     auto itr = _elements.find(key);
@@ -485,12 +576,34 @@ void Map<KeyType, ValueType>::put(const KeyType& key,
 
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>& Map<KeyType, ValueType>::putAll(const Map& map2) {
-    for (const KeyType& key : map2) {
-        put(key, map2.get(key));
+    if (sameOrdering(map2) && stanfordcpplib::collections::preferMerge(map2.size(), size())) {
+        if (stanfordcpplib::collections::mergeAddAll(_elements, map2._elements)) {
+            _version.update();
+        }
+    } else {
+        for (const auto& entry : map2._elements) {
+            put(entry.first, entry.second);
+        }
     }
     return *this;
 }
 
+template <typename KeyType, typename ValueType>
+stanfordcpplib::collections::IteratorRange<typename Map<KeyType, ValueType>::const_iterator>
+Map<KeyType, ValueType>::range(const KeyType& lo, const KeyType& hi) const {
+    if (_elements.key_comp()(hi, lo)) {
+        error("Map::range: hi cannot be less than lo");
+    }
+    return stanfordcpplib::collections::IteratorRange<const_iterator>(
+            const_iterator({ &_version, _elements.lower_bound(lo), _elements }),
+            const_iterator({ &_version, _elements.lower_bound(hi), _elements }));
+}
+
+template <typename KeyType, typename ValueType>
+int Map<KeyType, ValueType>::rank(const KeyType& key) const {
+    return static_cast<int>(std::distance(_elements.begin(), _elements.lower_bound(key)));
+}
+
 template <typename KeyType, typename ValueType>
 void Map<KeyType, ValueType>::remove(const KeyType& key) {
     _elements.erase(key);
@@ -499,6 +612,12 @@ void Map<KeyType, ValueType>::remove(const KeyType& key) {
 
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>& Map<KeyType, ValueType>::removeAll(const Map& map2) {
+    if (sameOrdering(map2) && stanfordcpplib::collections::preferMerge(map2.size(), size())) {
+        if (stanfordcpplib::collections::mergeRemoveAll(_elements, map2._elements)) {
+            _version.update();
+        }
+        return *this;
+    }
     for (const KeyType& key : map2) {
         if (containsKey(key) && get(key) == map2.get(key)) {
             remove(key);
@@ -509,6 +628,12 @@ Map<KeyType, ValueType>& Map<KeyType, ValueType>::removeAll(const Map& map2) {
 
 template <typename KeyType, typename ValueType>
 Map<KeyType, ValueType>& Map<KeyType, ValueType>::retainAll(const Map& map2) {
+    if (sameOrdering(map2) && stanfordcpplib::collections::preferMerge(size(), map2.size())) {
+        if (stanfordcpplib::collections::mergeRetainAll(_elements, map2._elements)) {
+            _version.update();
+        }
+        return *this;
+    }
     Vector<KeyType> toRemove;
     for (const KeyType& key : *this) {
         if (!map2.containsKey(key) || get(key) != map2.get(key)) {
@@ -521,6 +646,11 @@ Map<KeyType, ValueType>& Map<KeyType, ValueType>::retainAll(const Map& map2) {
     return *this;
 }
 
+template <typename KeyType, typename ValueType>
+bool Map<KeyType, ValueType>::sameOrdering(const Map& map2) const {
+    return stanfordcpplib::collections::sameOrdering<KeyType>(_elements.key_comp(), map2._elements.key_comp());
+}
+
 template <typename KeyType, typename ValueType>
 int Map<KeyType, ValueType>::size() const {
     return _elements.size();
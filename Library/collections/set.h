@@ -3,6 +3,11 @@
  * -----------
  * This file exports the <code>Set</code> class, which implements a
  * collection for storing a set of distinct elements.
+ *
+ * @version 2026/10/19
+ * - store elements in a SortedKeySet instead of a Map<T, bool>
+ * - merge-based union, intersection, difference, and subset tests
+ * - added ceiling, floor, range, and rank
  */
 
 #ifndef _set_h
@@ -17,12 +22,217 @@
 #include "collections.h"
 #include "map.h"
 
-/* Traits type for the Set, which wraps an underlying Map. */
+namespace stanfordcpplib {
+namespace collections {
+
+/*
+ * Sorted storage for Set.  It keeps the elements in a std::set rather than
+ * mapping each one to an unused bool in a Map<T, bool>, and it has the
+ * members of Map<T, bool> that GenericSet uses, plus the ordered queries
+ * that Set exposes; see map.h for what each member does.
+ *
+ * This is not meant to be used directly by students.
+ */
+template <typename T>
+class SortedKeySet {
+public:
+    SortedKeySet() : _elements(checkedLess<T>()) {
+        // Handled in initializer
+    }
+
+    SortedKeySet(std::function<bool (const T&, const T&)> lessFunc) : _elements(lessFunc) {
+        // Handled in initializer
+    }
+
+    T ceilingKey(const T& key) const {
+        auto itr = _elements.lower_bound(key);
+        if (itr == _elements.end()) {
+            error("Set::ceiling: no element is greater than or equal to the given value");
+        }
+        return *itr;
+    }
+
+    void clear() {
+        _elements.clear();
+        _version.update();
+    }
+
+    /* Returns true if every element of subset is also in this set. */
+    bool containsAll(const SortedKeySet& subset) const {
+        if (sameOrdering(subset) && preferMerge(subset.size(), size())) {
+            return mergeIncludes(_elements, subset._elements);
+        }
+        if (subset.size() > size()) {
+            return false;
+        }
+        for (const T& key : subset._elements) {
+            if (!containsKey(key)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool containsKey(const T& key) const {
+        return _elements.find(key) != _elements.end();
+    }
+
+    T firstKey() const {
+        return *_elements.begin();
+    }
+
+    T floorKey(const T& key) const {
+        auto itr = _elements.upper_bound(key);
+        if (itr == _elements.begin()) {
+            error("Set::floor: no element is less than or equal to the given value");
+        }
+        return *--itr;
+    }
+
+    bool isEmpty() const {
+        return _elements.empty();
+    }
+
+    T lastKey() const {
+        return *_elements.rbegin();
+    }
+
+    void mapAll(std::function<void (const T&, bool)> fn) const {
+        for (const T& key : _elements) {
+            fn(key, true);
+        }
+    }
+
+    void put(const T& key, bool /* value */) {
+        if (_elements.insert(key).second) {
+            _version.update();
+        }
+    }
+
+    SortedKeySet& putAll(const SortedKeySet& set2) {
+        if (sameOrdering(set2) && preferMerge(set2.size(), size())) {
+            if (mergeAddAll(_elements, set2._elements)) {
+                _version.update();
+            }
+        } else {
+            for (const T& key : set2._elements) {
+                put(key, true);
+            }
+        }
+        return *this;
+    }
+
+    IteratorRange<CheckedIterator<typename std::set<T, std::function<bool (const T&, const T&)>>::const_iterator>>
+    range(const T& lo, const T& hi) const {
+        if (_elements.key_comp()(hi, lo)) {
+            error("Set::range: hi cannot be less than lo");
+        }
+        return { const_iterator(&_version, _elements.lower_bound(lo), _elements),
+                 const_iterator(&_version, _elements.lower_bound(hi), _elements) };
+    }
+
+    int rank(const T& key) const {
+        return static_cast<int>(std::distance(_elements.begin(), _elements.lower_bound(key)));
+    }
+
+    void remove(const T& key) {
+        if (_elements.erase(key) != 0) {
+            _version.update();
+        }
+    }
+
+    SortedKeySet& removeAll(const SortedKeySet& set2) {
+        if (sameOrdering(set2) && preferMerge(set2.size(), size())) {
+            if (mergeRemoveAll(_elements, set2._elements)) {
+                _version.update();
+            }
+        } else if (this == &set2) {
+            clear();
+        } else {
+            for (const T& key : set2._elements) {
+                remove(key);
+            }
+        }
+        return *this;
+    }
+
+    SortedKeySet& retainAll(const SortedKeySet& set2) {
+        if (sameOrdering(set2) && preferMerge(size(), set2.size())) {
+            if (mergeRetainAll(_elements, set2._elements)) {
+                _version.update();
+            }
+        } else {
+            bool changed = false;
+            for (auto itr = _elements.begin(); itr != _elements.end(); ) {
+                if (set2.containsKey(*itr)) {
+                    ++itr;
+                } else {
+                    itr = _elements.erase(itr);
+                    changed = true;
+                }
+            }
+            if (changed) {
+                _version.update();
+            }
+        }
+        return *this;
+    }
+
+    int size() const {
+        return static_cast<int>(_elements.size());
+    }
+
+    bool operator <(const SortedKeySet& set2) const {
+        return compare(*this, set2) < 0;
+    }
+
+    bool operator <=(const SortedKeySet& set2) const {
+        return compare(*this, set2) <= 0;
+    }
+
+    bool operator >(const SortedKeySet& set2) const {
+        return compare(*this, set2) > 0;
+    }
+
+    bool operator >=(const SortedKeySet& set2) const {
+        return compare(*this, set2) >= 0;
+    }
+
+private:
+    using SetType = std::set<T, std::function<bool (const T&, const T&)>>;
+    SetType _elements;
+    VersionTracker _version;
+
+    bool sameOrdering(const SortedKeySet& set2) const {
+        return stanfordcpplib::collections::sameOrdering<T>(_elements.key_comp(), set2._elements.key_comp());
+    }
+
+public:
+    using const_iterator = CheckedIterator<typename SetType::const_iterator>;
+    using iterator = const_iterator;
+
+    const_iterator begin() const {
+        return const_iterator(&_version, _elements.begin(), _elements);
+    }
+
+    const_iterator end() const {
+        return const_iterator(&_version, _elements.end(), _elements);
+    }
+
+    friend int hashCode(const SortedKeySet& set) {
+        return hashCodeCollection(set);
+    }
+};
+
+} // namespace collections
+} // namespace stanfordcpplib
+
+/* Traits type for the Set, which wraps an underlying SortedKeySet. */
 namespace stanfordcpplib {
     namespace collections {
         template <typename T> struct SetTraits {
             using ValueType = T;
-            using MapType   = Map<T, bool>;
+            using MapType   = SortedKeySet<T>;
             static std::string name() {
                 return "Set";
             }
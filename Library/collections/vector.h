@@ -665,5 +665,24 @@ const T& randomElement(const Vector<T>& vec) {
     return stanfordcpplib::collections::randomElementIndexed(vec);
 }
 
+/*
+ * Function: shuffle
+ * Usage: shuffle(v);
+ * ------------------
+ * Rearranges the elements of the given vector into a random order, with
+ * every ordering equally likely.  Uses the calling thread's random generator,
+ * so the result is repeatable after a call to setRandomSeed.
+ */
+template <typename T>
+void shuffle(Vector<T>& vec) {
+    RandomGenerator& generator = RandomGenerator::forThisThread();
+    for (int i = vec.size() - 1; i > 0; i--) {
+        int j = generator.nextInteger(0, i);
+        if (i != j) {
+            std::swap(vec[i], vec[j]);
+        }
+    }
+}
+
 
 #endif // _vector_h
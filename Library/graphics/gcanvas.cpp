@@ -3,6 +3,17 @@
  * -----------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - bulk pixel access (getPixels, setPixels, fromGrid, toGrid, fillRegion,
+ *   countDiffPixels) now works on whole scanlines through PixelView
+ * - countDiffPixels and diff use the multithreaded diffImages engine
+ * - paint events clip to the dirty region so off-screen objects are skipped;
+ *   added setSpatialIndexEnabled
+ * - added batched drawing; shapes and pixels drawn between beginBatch and
+ *   endBatch are recorded by value and painted with one QPainter in a
+ *   single GUI-thread trip
+ * - added beginFrame/endFrame; changes made during a frame are recorded as
+ *   dirty regions and repainted together when the frame ends
  * @version 2019/05/01
  * - added createArgbPixel
  * - bug fixes related to save / setPixels with alpha transparency
@@ -26,13 +37,18 @@
  */
 
 #include "gcanvas.h"
+#include <algorithm>
+#include <cmath>
+#include <QRegion>
 #include "gcolor.h"
+#include "gimagediff.h"
 #include "gthread.h"
 #include "error.h"
 #include "filelib.h"
 #include "require.h"
 
 const int GCanvas::WIDTH_HEIGHT_MAX = 65535;
+const int GCanvas::BATCH_MAX_COMMANDS = 100000;
 
 int GCanvas::createArgbPixel(int alpha, int red, int green, int blue) {
     if (alpha < 0 || alpha > 255 || red < 0 || red > 255 || green < 0 || green > 255 || blue < 0 || blue > 255) {
@@ -177,6 +193,28 @@ void GCanvas::add(GObject& gobj, double x, double y) {
     });
 }
 
+void GCanvas::addToBatch(const ShapeCommand& shape, const GRectangle& bounds) {
+    _batch.push_back(shape);
+    _batchBounds = _batchBounds.unionWith(bounds);
+    if (static_cast<int>(_batch.size()) >= BATCH_MAX_COMMANDS) {
+        flushBatch();
+    }
+}
+
+void GCanvas::beginFrame() {
+    if (_inFrame) {
+        error("GCanvas::beginFrame: a frame is already in progress");
+    }
+    _inFrame = true;
+    GThread::runOnQtGuiThread([this]() {
+        lockForWrite();
+        _frameAutoRepaint = _gcompound.isAutoRepaint();
+        _gcompound.setAutoRepaint(false);
+        _gcompound.setDirtyTracking(true);
+        unlock();
+    });
+}
+
 void GCanvas::clear() {
     clearObjects();
     clearPixels();   // calls conditionalRepaint
@@ -191,6 +229,7 @@ void GCanvas::clearObjects() {
 }
 
 void GCanvas::clearPixels() {
+    flushBatch();
     GThread::runOnQtGuiThread([this]() {
         lockForWrite();
         if (_backgroundImage) {
@@ -210,6 +249,30 @@ void GCanvas::clearPixels() {
     conditionalRepaint();
 }
 
+void GCanvas::conditionalRepaint() {
+    if (_inFrame) {
+        _gcompound.markDirty();
+    } else {
+        GDrawingSurface::conditionalRepaint();
+    }
+}
+
+void GCanvas::conditionalRepaintRegion(int x, int y, int width, int height) {
+    if (_inFrame) {
+        _gcompound.addDirtyRegion(GRectangle(x, y, width, height));
+    } else {
+        GDrawingSurface::conditionalRepaintRegion(x, y, width, height);
+    }
+}
+
+void GCanvas::conditionalRepaintRegion(const GRectangle& bounds) {
+    if (_inFrame) {
+        _gcompound.addDirtyRegion(bounds);
+    } else {
+        GDrawingSurface::conditionalRepaintRegion(bounds);
+    }
+}
+
 bool GCanvas::contains(double x, double y) const {
     lockForReadConst();
     bool result = _gcompound.contains(x, y);
@@ -218,52 +281,26 @@ bool GCanvas::contains(double x, double y) const {
 }
 
 int GCanvas::countDiffPixels(const GCanvas& image) const {
+    ensureBackgroundImageConstHack();
+    image.ensureBackgroundImageConstHack();
     lockForReadConst();
-    int w1 = static_cast<int>(getWidth());
-    int h1 = static_cast<int>(getHeight());
-    int w2 = static_cast<int>(image.getWidth());
-    int h2 = static_cast<int>(image.getHeight());
-
-    int wmin = std::min(w1, w2);
-    int hmin = std::min(h1, h2);
-
-    int overlap = std::min(w1, w2) * std::min(h1, h2);
-    int diffPxCount = (w1 * h1 - overlap) + (w2 * h2 - overlap);
-
-    for (int y = 0; y < hmin; y++) {
-        for (int x = 0; x < wmin; x++) {
-            int px1 = _backgroundImage->pixel(static_cast<int>(x), static_cast<int>(y)) & 0x00ffffff;
-            int px2 = image._backgroundImage->pixel(static_cast<int>(x), static_cast<int>(y)) & 0x00ffffff;
-            if (px1 != px2) {
-                diffPxCount++;
-            }
-        }
-    }
-
+    ImageDiffResult result = diffImages(getBackgroundPixelView(), image.getBackgroundPixelView());
     unlockConst();
-    return diffPxCount;
+    return result.diffCount;
 }
 
 int GCanvas::countDiffPixels(const GCanvas& image, int xmin, int ymin, int xmax, int ymax) const {
+    ensureBackgroundImageConstHack();
+    image.ensureBackgroundImageConstHack();
+    ImageDiffOptions options;
+    options.regionX = xmin;
+    options.regionY = ymin;
+    options.regionWidth = std::max(0, xmax - xmin);
+    options.regionHeight = std::max(0, ymax - ymin);
     lockForReadConst();
-    int w1 = static_cast<int>(getWidth());
-    int h1 = static_cast<int>(getHeight());
-    int w2 = static_cast<int>(image.getWidth());
-    int h2 = static_cast<int>(image.getHeight());
-    int diffPxCount = 0;
-
-    for (int y = ymin; y < ymax; y++) {
-        for (int x = xmin; x < xmax; x++) {
-            int px1 = x < w1 && y < h1 ? (_backgroundImage->pixel(static_cast<int>(x), static_cast<int>(y)) & 0x00ffffff) : -1;
-            int px2 = x < w2 && y < h2 ? (image._backgroundImage->pixel(static_cast<int>(x), static_cast<int>(y)) & 0x00ffffff) : -1;
-            if (px1 != px2) {
-                diffPxCount++;
-            }
-        }
-    }
-
+    ImageDiffResult result = diffImages(getBackgroundPixelView(), image.getBackgroundPixelView(), options);
     unlockConst();
-    return diffPxCount;
+    return result.diffCount;
 }
 
 int GCanvas::countDiffPixels(const GCanvas* image) const {
@@ -277,36 +314,29 @@ int GCanvas::countDiffPixels(const GCanvas* image, int xmin, int ymin, int xmax,
 }
 
 GCanvas* GCanvas::diff(const GCanvas& image, int diffPixelColor) const {
+    ensureBackgroundImageConstHack();
+    image.ensureBackgroundImageConstHack();
     lockForReadConst();
-    int w1 = static_cast<int>(getWidth());
-    int h1 = static_cast<int>(getHeight());
-    int w2 = static_cast<int>(image.getWidth());
-    int h2 = static_cast<int>(image.getHeight());
-    int wmin = std::min(w1, w2);
-    int hmin = std::min(h1, h2);
-    int wmax = std::max(w1, w2);
-    int hmax = std::max(h1, h2);
-
-    Grid<int> resultGrid;
-    resultGrid.resize(hmax, wmax);
-    resultGrid.fill(diffPixelColor);
-    for (int r = 0; r < h1; r++) {
-        for (int c = 0; c < w1; c++) {
-            resultGrid[r][c] = _backgroundColorInt;
-        }
-    }
-    for (int y = 0; y < hmin; y++) {
-        for (int x = 0; x < wmin; x++) {
-            int px1 = _backgroundImage->pixel(static_cast<int>(x), static_cast<int>(y)) & 0x00ffffff;
-            int px2 = image._backgroundImage->pixel(static_cast<int>(x), static_cast<int>(y)) & 0x00ffffff;
-            if (px1 != px2) {
-                resultGrid[y][x] = diffPixelColor;
-            }
-        }
-    }
+    PixelView pixels1 = getBackgroundPixelView();
+    PixelView pixels2 = image.getBackgroundPixelView();
+    int w1 = pixels1.getWidth();
+    int h1 = pixels1.getHeight();
+    int wmax = std::max(w1, pixels2.getWidth());
+    int hmax = std::max(h1, pixels2.getHeight());
+
+    Grid<int> resultGrid(hmax, wmax, diffPixelColor);
+    PixelView resultPixels(resultGrid);
+    resultPixels.subview(0, 0, w1, h1).fill(static_cast<unsigned int>(_backgroundColorInt));
+
+    // only the overlapping area is marked; the rest keeps the colors above
+    ImageDiffOptions options;
+    options.regionWidth = std::min(w1, pixels2.getWidth());
+    options.regionHeight = std::min(h1, pixels2.getHeight());
+    diffImages(pixels1, pixels2, options, &resultPixels, static_cast<unsigned int>(diffPixelColor));
+    unlockConst();
+
     GCanvas* result = new GCanvas(wmax, hmax);
     result->fromGrid(resultGrid);
-    unlockConst();
     return result;
 }
 
@@ -319,6 +349,9 @@ void GCanvas::draw(QPainter* painter) {
     if (!painter) {
         return;
     }
+    // The canvas lock is not taken here: code on the GUI thread repaints
+    // while holding it for writing (e.g. add), and a read lock would then
+    // deadlock.  The compound's spatial index locks itself instead.
     // lockForRead();
     if (_backgroundImage) {
         painter->drawImage(/* x */ 0, /* y */ 0, *_backgroundImage);
@@ -329,6 +362,7 @@ void GCanvas::draw(QPainter* painter) {
 
 void GCanvas::draw(GObject* gobj) {
     require::nonNull(gobj, "GCanvas::draw");
+    flushBatch();   // keep the order of drawing if a batch is open
     ensureBackgroundImage();
     if (_backgroundImage && _backgroundImage->paintEngine()) {
         GThread::runOnQtGuiThread([this, gobj]() {
@@ -346,6 +380,62 @@ void GCanvas::draw(GObject* gobj) {
     }
 }
 
+void GCanvas::editPixels(std::function<void(PixelView& pixels)> func) {
+    flushBatch();
+    ensureBackgroundImage();
+    GThread::runOnQtGuiThread([this, &func]() {
+        lockForWrite();
+        PixelView pixels = getBackgroundPixelView();
+        try {
+            func(pixels);
+        } catch (...) {
+            unlock();
+            throw;
+        }
+        unlock();
+    });
+    conditionalRepaint();
+}
+
+/*
+ * Implementation notes: endFrame
+ * ------------------------------
+ * The dirty regions are handed to QWidget::update rather than repaint, so
+ * Qt merges them into one paint event that runs when the GUI thread next
+ * returns to its event loop.  Regions are rounded outward to whole pixels
+ * so that antialiased edges are not left behind.
+ */
+void GCanvas::endFrame() {
+    if (!_inFrame) {
+        error("GCanvas::endFrame: no frame is in progress");
+    }
+    GThread::runOnQtGuiThread([this]() {
+        lockForWrite();
+        std::vector<GRectangle> dirty;
+        bool dirtyAll = _gcompound.takeDirtyRegions(dirty);
+        _gcompound.setDirtyTracking(false);
+        _gcompound.setAutoRepaint(_frameAutoRepaint);
+        unlock();
+        if (!_frameAutoRepaint || !_iqcanvas) {
+            return;
+        }
+        if (dirtyAll) {
+            _iqcanvas->update();
+        } else if (!dirty.empty()) {
+            QRegion region;
+            for (const GRectangle& rect : dirty) {
+                int x1 = static_cast<int>(std::floor(rect.x));
+                int y1 = static_cast<int>(std::floor(rect.y));
+                int x2 = static_cast<int>(std::ceil(rect.x + rect.width));
+                int y2 = static_cast<int>(std::ceil(rect.y + rect.height));
+                region += QRect(x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+            }
+            _iqcanvas->update(region);
+        }
+    });
+    _inFrame = false;
+}
+
 void GCanvas::ensureBackgroundImage() {
     if (!_backgroundImage) {
         GThread::runOnQtGuiThread([this]() {
@@ -400,16 +490,19 @@ void GCanvas::fillRegion(double x, double y, double width, double height, int rg
     checkBounds("GCanvas::fillRegion", x, y, getWidth(), getHeight());
     checkBounds("GCanvas::fillRegion", x + width - 1, y + height - 1, getWidth(), getHeight());
     checkColor("GCanvas::fillRegion", rgb);
+    flushBatch();
     bool wasAutoRepaint = isAutoRepaint();
     setAutoRepaint(false);
     GThread::runOnQtGuiThread([this, x, y, width, height, rgb]() {
         ensureBackgroundImage();
         lockForWrite();
-        int argb = rgb | 0xff000000;
-        for (int yy = static_cast<int>(y); yy < y + height; yy++) {
-            for (int xx = static_cast<int>(x); xx < x + width; xx++) {
-                _backgroundImage->setPixel(xx, yy, static_cast<unsigned int>(argb));
-            }
+        PixelView pixels = getBackgroundPixelView();
+        int x1 = static_cast<int>(x);
+        int y1 = static_cast<int>(y);
+        int x2 = std::min(pixels.getWidth(), static_cast<int>(x + width));
+        int y2 = std::min(pixels.getHeight(), static_cast<int>(y + height));
+        if (x1 < x2 && y1 < y2) {
+            pixels.subview(x1, y1, x2 - x1, y2 - y1).fill(static_cast<unsigned int>(rgb) | 0xff000000);
         }
         unlock();
     });
@@ -422,6 +515,7 @@ void GCanvas::fillRegion(double x, double y, double width, double height, const
 }
 
 void GCanvas::flatten() {
+    flushBatch();
     GThread::runOnQtGuiThread([this]() {
         ensureBackgroundImage();
         lockForWrite();
@@ -435,8 +529,46 @@ void GCanvas::flatten() {
     });
 }
 
+/*
+ * Implementation notes: flushBatch
+ * --------------------------------
+ * The recorded shapes are swapped out of _batch first so that the buffer
+ * is empty again even if drawing fails.  All of them are drawn with a single
+ * painter in one call to runOnQtGuiThread, which is where the time goes when
+ * drawing shapes one at a time.  Finally the union of the dirty regions is
+ * repainted once.
+ */
+void GCanvas::flushBatch() {
+    if (_batch.empty()) {
+        return;
+    }
+    std::vector<ShapeCommand> batch;
+    batch.swap(_batch);
+    GRectangle dirty = _batchBounds;
+    _batchBounds = GRectangle();
+
+    ensureBackgroundImage();
+    if (_backgroundImage && _backgroundImage->paintEngine()) {
+        GThread::runOnQtGuiThread([this, &batch]() {
+            lockForWrite();
+            QPainter painter(_backgroundImage);
+            painter.setRenderHint(QPainter::TextAntialiasing, GObject::isAntiAliasing());
+            for (const ShapeCommand& shape : batch) {
+                paintShape(painter, shape);
+            }
+            painter.end();
+            unlock();
+        });
+    }
+
+    if (!dirty.isEmpty()) {
+        conditionalRepaintRegion(dirty);
+    }
+}
+
 void GCanvas::fromGrid(const Grid<int>& grid) {
     checkSize("GCanvas::fromGrid", grid.numCols(), grid.numRows());
+    flushBatch();
     setSize(grid.numCols(), grid.numRows());
 
     bool wasAutoRepaint = isAutoRepaint();
@@ -445,12 +577,7 @@ void GCanvas::fromGrid(const Grid<int>& grid) {
     GThread::runOnQtGuiThread([this, &grid]() {
         ensureBackgroundImage();
         lockForWrite();
-        for (int row = 0, width = grid.numCols(), height = grid.numRows(); row < height; row++) {
-            for (int col = 0; col < width; col++) {
-                int argb = GColor::fixAlpha(grid[row][col]);
-                _backgroundImage->setPixel(col, row, static_cast<unsigned int>(argb));
-            }
-        }
+        getBackgroundPixelView().fromGrid(grid, PixelView::ALPHA_FIX);
         unlock();
     });
 
@@ -497,6 +624,23 @@ std::string GCanvas::getFont() const {
     return GDrawingSurface::getFont();
 }
 
+/*
+ * Implementation notes: getBackgroundPixelView
+ * --------------------------------------------
+ * The background image is always kept in QImage::Format_ARGB32 (see load),
+ * whose scanlines are arrays of 0xAARRGGBB values, so the view can point
+ * straight at the image's own memory.
+ */
+PixelView GCanvas::getBackgroundPixelView() const {
+    if (!_backgroundImage || _backgroundImage->isNull()) {
+        return PixelView();
+    }
+    return PixelView(reinterpret_cast<unsigned int*>(_backgroundImage->bits()),
+                     _backgroundImage->width(),
+                     _backgroundImage->height(),
+                     static_cast<int>(_backgroundImage->bytesPerLine() / sizeof(unsigned int)));
+}
+
 _Internal_QWidget* GCanvas::getInternalWidget() const {
     return _iqcanvas;
 }
@@ -522,14 +666,8 @@ int GCanvas::getPixelARGB(double x, double y) const {
 Grid<int> GCanvas::getPixels() const {
     ensureBackgroundImageConstHack();
     lockForReadConst();
-    int w = static_cast<int>(getWidth());
-    int h = static_cast<int>(getHeight());
-    Grid<int> grid(h, w);
-    for (int y = 0; y < h; y++) {
-        for (int x = 0; x < w; x++) {
-            grid[y][x] = _backgroundImage->pixel(x, y) & 0x00ffffff;
-        }
-    }
+    Grid<int> grid;
+    getBackgroundPixelView().toGrid(grid, /* mask */ 0x00ffffff);
     unlockConst();
     return grid;
 }
@@ -537,12 +675,8 @@ Grid<int> GCanvas::getPixels() const {
 Grid<int> GCanvas::getPixelsARGB() const {
     ensureBackgroundImageConstHack();
     lockForReadConst();
-    Grid<int> grid(static_cast<int>(getHeight()), static_cast<int>(getWidth()));
-    for (int y = 0; y < static_cast<int>(getHeight()); y++) {
-        for (int x = 0; x < static_cast<int>(getWidth()); x++) {
-            grid[y][x] = static_cast<int>(_backgroundImage->pixel(x, y));
-        }
-    }
+    Grid<int> grid;
+    getBackgroundPixelView().toGrid(grid);
     unlockConst();
     return grid;
 }
@@ -559,6 +693,17 @@ bool GCanvas::isAutoRepaint() const {
     return _gcompound.isAutoRepaint();
 }
 
+bool GCanvas::isInFrame() const {
+    return _inFrame;
+}
+
+bool GCanvas::isSpatialIndexEnabled() const {
+    lockForReadConst();
+    bool result = _gcompound.isSpatialIndexEnabled();
+    unlockConst();
+    return result;
+}
+
 void GCanvas::load(const std::string& filename) {
     // for efficiency, let's at least check whether the file exists
     // and throw error immediately rather than contacting the back-end
@@ -566,6 +711,7 @@ void GCanvas::load(const std::string& filename) {
         error("GCanvas::load: file not found: " + filename);
     }
 
+    flushBatch();
     bool hasError = false;
     GThread::runOnQtGuiThread([this, filename, &hasError]() {
         ensureBackgroundImage();
@@ -576,6 +722,9 @@ void GCanvas::load(const std::string& filename) {
             return;
         }
 
+        if (_backgroundImage->format() != QImage::Format_ARGB32) {
+            *_backgroundImage = _backgroundImage->convertToFormat(QImage::Format_ARGB32);
+        }
         _filename = filename;
         GInteractor::setSize(_backgroundImage->width(), _backgroundImage->height());
         // setSize(_qimage->width(), _qimage->height());
@@ -594,6 +743,7 @@ bool GCanvas::loadFromStream(std::istream& input) {
     byteStream << input.rdbuf();
     std::string bytes = byteStream.str();
 
+    flushBatch();
     bool hasError = false;
     GThread::runOnQtGuiThread([&, this]() {
         ensureBackgroundImage();
@@ -604,6 +754,9 @@ bool GCanvas::loadFromStream(std::istream& input) {
             return;
         }
 
+        if (_backgroundImage->format() != QImage::Format_ARGB32) {
+            *_backgroundImage = _backgroundImage->convertToFormat(QImage::Format_ARGB32);
+        }
         GInteractor::setSize(_backgroundImage->width(), _backgroundImage->height());
         // setSize(_qimage->width(), _qimage->height());
         unlock();
@@ -643,6 +796,88 @@ void GCanvas::notifyOfResize(double width, double height) {
     }
 }
 
+/*
+ * Implementation notes: paintShape
+ * --------------------------------
+ * Sets up the pen and brush as GObject::initializeBrushAndPen does for an
+ * untransformed, opaque object and makes the same painter call as that
+ * shape's draw method, so batched and unbatched drawing match exactly.
+ * Pixels are written with the Source composition mode so that they replace
+ * the old value exactly as QImage::setPixel would.
+ */
+void GCanvas::paintShape(QPainter& painter, const ShapeCommand& shape) {
+    static const int QT_ANGLE_SCALE_FACTOR = 16;   // as in GArc::draw
+    painter.resetTransform();
+    painter.setOpacity(1.0);
+    if (shape.kind == ShapeCommand::PIXEL) {
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(static_cast<int>(shape.x), static_cast<int>(shape.y),
+                         /* width */ 1, /* height */ 1, QColor::fromRgba(shape.penARGB));
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        return;
+    }
+
+    QPen pen(QColor::fromRgba(shape.penARGB));
+    pen.setJoinStyle(Qt::MiterJoin);
+    pen.setMiterLimit(99.0);
+    pen.setCapStyle(Qt::FlatCap);
+    pen.setWidth(shape.lineWidth);
+    pen.setStyle(GObject::toQtPenStyle(shape.lineStyle));
+    painter.setPen(pen);
+    if (shape.filled) {
+        painter.setBrush(QBrush(QColor::fromRgba(shape.fillARGB)));
+    } else {
+        painter.setBrush(Qt::NoBrush);
+    }
+    painter.setRenderHint(QPainter::Antialiasing,
+                          GObject::isAntiAliasing() && shape.kind != ShapeCommand::RECT);
+
+    int x = static_cast<int>(shape.x);
+    int y = static_cast<int>(shape.y);
+    switch (shape.kind) {
+    case ShapeCommand::ARC:
+        painter.drawChord(x, y, static_cast<int>(shape.width), static_cast<int>(shape.height),
+                          static_cast<int>(shape.start * QT_ANGLE_SCALE_FACTOR),
+                          static_cast<int>(shape.sweep * QT_ANGLE_SCALE_FACTOR));
+        break;
+    case ShapeCommand::LINE:
+        painter.drawLine(x, y, static_cast<int>(shape.x + shape.width),
+                         static_cast<int>(shape.y + shape.height));
+        break;
+    case ShapeCommand::OVAL:
+        painter.drawEllipse(x, y, static_cast<int>(shape.width), static_cast<int>(shape.height));
+        break;
+    case ShapeCommand::RECT:
+        painter.drawRect(x, y, static_cast<int>(shape.width), static_cast<int>(shape.height));
+        break;
+    case ShapeCommand::PIXEL:
+        break;
+    }
+}
+
+void GCanvas::readPixels(std::function<void(const PixelView& pixels)> func) const {
+    ensureBackgroundImageConstHack();
+    lockForReadConst();
+    try {
+        func(getBackgroundPixelView());
+    } catch (...) {
+        unlockConst();
+        throw;
+    }
+    unlockConst();
+}
+
+void GCanvas::recordShape(const ShapeCommand& shape) {
+    if (!isBatching()) {
+        GDrawingSurface::recordShape(shape);
+        return;
+    }
+    double x = std::min(shape.x, shape.x + shape.width);
+    double y = std::min(shape.y, shape.y + shape.height);
+    GRectangle bounds(x, y, std::fabs(shape.width), std::fabs(shape.height));
+    addToBatch(shape, bounds.enlargedBy((shape.lineWidth + 1) / 2.0));
+}
+
 void GCanvas::remove(GObject* gobj) {
     GThread::runOnQtGuiThread([this, gobj]() {
         lockForWrite();
@@ -694,6 +929,7 @@ void GCanvas::resize(double width, double height, bool /* retain */) {
 }
 
 void GCanvas::save(const std::string& filename) {
+    flushBatch();
     GThread::runOnQtGuiThread([this, filename]() {
         ensureBackgroundImage();
         lockForRead();
@@ -733,6 +969,7 @@ void GCanvas::setAutoRepaint(bool autoRepaint) {
 }
 
 void GCanvas::setBackground(int color) {
+    flushBatch();
     GDrawingSurface::setBackground(color);
     GInteractor::setBackground(color);
     if (_backgroundImage) {
@@ -799,6 +1036,17 @@ void GCanvas::setKeyListener(GEventListenerVoid func) {
 void GCanvas::setPixel(double x, double y, int rgb) {
     require::inRange2D(x, y, getWidth(), getHeight(), "GCanvas::setPixel", "x", "y");
     checkColor("GCanvas::setPixel", rgb);
+    if (isBatching()) {
+        int ix = static_cast<int>(x);
+        int iy = static_cast<int>(y);
+        ShapeCommand pixel {};
+        pixel.kind = ShapeCommand::PIXEL;
+        pixel.x = ix;
+        pixel.y = iy;
+        pixel.penARGB = static_cast<unsigned int>(GColor::fixAlpha(rgb));
+        addToBatch(pixel, GRectangle(ix, iy, /* width */ 1, /* height */ 1));
+        return;
+    }
     GThread::runOnQtGuiThread([this, x, y, rgb]() {
         ensureBackgroundImage();
         lockForWrite();
@@ -825,6 +1073,17 @@ void GCanvas::setPixel(double x, double y, int r, int g, int b) {
 void GCanvas::setPixelARGB(double x, double y, int argb) {
     require::inRange2D(x, y, getWidth(), getHeight(), "GCanvas::setPixelARGB", "x", "y");
     checkColor("GCanvas::setPixel", argb);
+    if (isBatching()) {
+        int ix = static_cast<int>(x);
+        int iy = static_cast<int>(y);
+        ShapeCommand pixel {};
+        pixel.kind = ShapeCommand::PIXEL;
+        pixel.x = ix;
+        pixel.y = iy;
+        pixel.penARGB = static_cast<unsigned int>(argb);
+        addToBatch(pixel, GRectangle(ix, iy, /* width */ 1, /* height */ 1));
+        return;
+    }
     GThread::runOnQtGuiThread([this, x, y, argb]() {
         ensureBackgroundImage();
         lockForWrite();
@@ -846,14 +1105,10 @@ void GCanvas::setPixels(const Grid<int>& pixels) {
         // resize(pixels.width(), pixels.height());
         error("GCanvas::setPixels: wrong size");
     }
+    flushBatch();
     GThread::runOnQtGuiThread([this, &pixels]() {
         lockForWrite();
-        for (int y = 0, w = pixels.numCols(), h = pixels.numRows(); y < h; y++) {
-            for (int x = 0; x < w; x++) {
-                int argb = pixels[y][x] | 0xff000000;
-                _backgroundImage->setPixel(x, y, static_cast<unsigned int>(argb));
-            }
-        }
+        getBackgroundPixelView().fromGrid(pixels, PixelView::ALPHA_OPAQUE);
         unlock();
         conditionalRepaint();
     });
@@ -867,18 +1122,23 @@ void GCanvas::setPixelsARGB(const Grid<int>& pixels) {
         error("GCanvas::setPixels: wrong size");
     }
 
+    flushBatch();
     GThread::runOnQtGuiThread([this, &pixels]() {
         lockForWrite();
-        for (int y = 0; y < pixels.numRows(); y++) {
-            for (int x = 0; x < pixels.numCols(); x++) {
-                _backgroundImage->setPixel(x, y, pixels[y][x]);
-            }
-        }
+        getBackgroundPixelView().fromGrid(pixels, PixelView::ALPHA_KEEP);
         unlock();
         conditionalRepaint();
     });
 }
 
+void GCanvas::setSpatialIndexEnabled(bool enabled) {
+    GThread::runOnQtGuiThread([this, enabled]() {
+        lockForWrite();
+        _gcompound.setSpatialIndexEnabled(enabled);
+        unlock();
+    });
+}
+
 GImage* GCanvas::toGImage() const {
     ensureBackgroundImageConstHack();
     lockForReadConst();
@@ -910,13 +1170,9 @@ Grid<int> GCanvas::toGrid() const {
 }
 
 void GCanvas::toGrid(Grid<int>& grid) const {
-    grid.resize(getHeight(), getWidth());
+    ensureBackgroundImageConstHack();
     lockForReadConst();
-    for (int row = 0, width = (int) getWidth(), height = (int) getHeight(); row < height; row++) {
-        for (int col = 0; col < width; col++) {
-            grid[row][col] = _backgroundImage->pixel(col, row);
-        }
-    }
+    getBackgroundPixelView().toGrid(grid);
     unlockConst();
 }
 
@@ -1044,6 +1300,9 @@ void _Internal_QCanvas::paintEvent(QPaintEvent* event) {
     // g.setRenderHints(QPainter::HighQualityAntialiasing);
     painter.setRenderHint(QPainter::Antialiasing, GObject::isAntiAliasing());
     painter.setRenderHint(QPainter::TextAntialiasing, GObject::isAntiAliasing());
+    // make the dirty region visible to the painter so that the compound
+    // can skip objects that lie outside of it
+    painter.setClipRegion(event->region());
     _gcanvas->draw(&painter);
     painter.end();
 }
@@ -3,6 +3,11 @@
  * ---------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added readPixels/editPixels for direct scanline access through PixelView
+ * - added batched drawing (beginBatch/endBatch) with a command buffer
+ * - added isSpatialIndexEnabled/setSpatialIndexEnabled
+ * - added beginFrame/endFrame for repainting all changes made in a frame at once
  * @version 2019/05/01
  * - added createArgbPixel
  * - bug fixes related to save / setPixels with alpha transparency
@@ -22,7 +27,9 @@
 #ifndef _gcanvas_h
 #define _gcanvas_h
 
+#include <functional>
 #include <string>
+#include <vector>
 #include <QtEvents>
 #include <QPainter>
 
@@ -30,6 +37,7 @@
 #include "gevent.h"
 #include "ginteractor.h"
 #include "gobjects.h"
+#include "gpixelview.h"
 
 // default color used to highlight pixels that do not match between two images
 #define GCANVAS_DEFAULT_DIFF_PIXEL_COLOR 0xdd00dd
@@ -183,6 +191,23 @@ public:
      */
     virtual void add(GObject& gobj, double x, double y);
 
+    /**
+     * Starts a frame of animation.
+     * Until the matching call to endFrame, changes to the canvas and to the
+     * objects in it do not repaint anything on the screen; instead the canvas
+     * remembers which areas changed, including the old locations of objects
+     * that moved.  endFrame then repaints all of those areas in a single pass.
+     * This avoids both the cost of repainting after every small change and the
+     * flicker of showing a frame that is only partly updated.
+     *
+     * If auto-repaint is off when the frame starts, endFrame does not repaint
+     * anything, leaving that to the client as usual.
+     * Most clients will use GWindow::runAnimation rather than calling this
+     * method directly.
+     * @throw ErrorException if a frame is already in progress
+     */
+    virtual void beginFrame();
+
     /**
      * Removes all graphical objects from the canvas foreground layer
      * and wipes the background layer to show the current background color.
@@ -210,6 +235,27 @@ public:
      */
     virtual void clearPixels();
 
+    /**
+     * Repaints the canvas if auto-repaint is on.
+     * During a frame (see beginFrame), instead marks the entire canvas
+     * to be repainted when the frame ends.
+     */
+    void conditionalRepaint() override;
+
+    /**
+     * Repaints the given region of the canvas if auto-repaint is on.
+     * During a frame (see beginFrame), instead adds the region to the area
+     * to be repainted when the frame ends.
+     */
+    void conditionalRepaintRegion(int x, int y, int width, int height) override;
+
+    /**
+     * Repaints the given region of the canvas if auto-repaint is on.
+     * During a frame (see beginFrame), instead adds the region to the area
+     * to be repainted when the frame ends.
+     */
+    void conditionalRepaintRegion(const GRectangle& bounds) override;
+
     /**
      * Returns true if any of the graphical objects in the foreground layer of
      * the canvas touch the given x/y pixel.
@@ -276,6 +322,8 @@ public:
      * will not be reflected immediately on this canvas.
      * If you do want such changes to be reflected, instead add the shape to
      * the foreground layer using add().
+     * If a batch is in progress (see beginBatch), the shapes recorded so far
+     * are drawn first, then the object.
      * @throw ErrorException if the object passed is null
      */
     void draw(GObject* gobj) override;
@@ -286,6 +334,25 @@ public:
      */
     void draw(QPainter* painter) override;
 
+    /**
+     * Calls the given function with a PixelView of the background layer of
+     * the canvas, through which it may read and modify pixels directly.
+     * The canvas is locked for writing during the call, and repainted after.
+     * This is the fastest way to make changes to many pixels at once;
+     * see gpixelview.h for an example.
+     * The view must not be used after the function returns.
+     */
+    virtual void editPixels(std::function<void(PixelView& pixels)> func);
+
+    /**
+     * Ends a frame of animation started by beginFrame, and repaints every
+     * area of the canvas that changed during the frame.
+     * The repaint is scheduled with the Qt GUI thread rather than done
+     * immediately, so it happens as soon as that thread is free.
+     * @throw ErrorException if no frame is in progress
+     */
+    virtual void endFrame();
+
     /**
      * Returns true if the two given canvases contain exactly the same pixel data.
      */
@@ -437,6 +504,26 @@ public:
     /* @inherit */
     bool isAutoRepaint() const override;
 
+    /**
+     * Returns true if a frame started by beginFrame is in progress.
+     */
+    virtual bool isInFrame() const;
+
+    /**
+     * Returns whether the canvas keeps a spatial index of the graphical
+     * objects in its foreground layer.
+     * See setSpatialIndexEnabled.
+     */
+    virtual bool isSpatialIndexEnabled() const;
+
+    /**
+     * Calls the given function with a read-only PixelView of the background
+     * layer of the canvas.
+     * The canvas is locked for reading during the call.
+     * The view must not be used after the function returns.
+     */
+    virtual void readPixels(std::function<void(const PixelView& pixels)> func) const;
+
     /**
      * Reads the canvas's pixel contents from the given image file.
      * @throw ErrorException if the given file does not exist or cannot be read
@@ -621,6 +708,15 @@ public:
      */
     void setPixelsARGB(const Grid<int>& pixelsARGB) override;
 
+    /**
+     * Sets whether the canvas keeps a spatial index of the graphical objects
+     * in its foreground layer, which makes getElementAt and repainting small
+     * regions much faster when the canvas holds many thousands of objects.
+     * See GCompound::setSpatialIndexEnabled for details.
+     * Initially the index is disabled.
+     */
+    virtual void setSpatialIndexEnabled(bool enabled);
+
     /**
      * Converts the pixels of the canvas into a GImage object.
      */
@@ -646,20 +742,41 @@ public:
      */
     virtual void toGrid(Grid<int>& grid) const;
 
+protected:
+    /* @inherit */
+    void flushBatch() override;
+
+    /* @inherit */
+    void recordShape(const ShapeCommand& shape) override;
+
 private:
     Q_DISABLE_COPY(GCanvas)
 
+    static const int BATCH_MAX_COMMANDS;   // flush automatically at this size
+
     _Internal_QCanvas* _iqcanvas;
     GCompound _gcompound;
     QImage* _backgroundImage;
     std::string _filename;   // file canvas was loaded from; "" if not loaded from a file
+    std::vector<ShapeCommand> _batch;   // shapes recorded during a batch
+    GRectangle _batchBounds;            // union of the areas _batch touches
+    bool _inFrame = false;              // between beginFrame and endFrame
+    bool _frameAutoRepaint = true;      // auto-repaint setting before the frame
 
     friend class _Internal_QCanvas;
 
+    void addToBatch(const ShapeCommand& shape, const GRectangle& bounds);
+
     void ensureBackgroundImage();
 
     void ensureBackgroundImageConstHack() const;
 
+    /*
+     * Returns a view of the background image's pixels.
+     * The caller must hold the canvas lock.
+     */
+    PixelView getBackgroundPixelView() const;
+
     void init(double width, double height, int rgbBackground, QWidget* parent);
 
     /**
@@ -669,6 +786,12 @@ private:
     virtual bool loadFromStream(std::istream& input);
 
     void notifyOfResize(double width, double height);
+
+    /*
+     * Paints a recorded shape the way the matching GObject's draw method
+     * would.  Called on the Qt GUI thread.
+     */
+    static void paintShape(QPainter& painter, const ShapeCommand& shape);
 };
 
 // Parameter has new type >= Qt 6
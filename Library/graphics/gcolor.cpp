@@ -3,6 +3,11 @@
  * ----------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - named colors are found through a perfect hash of a constant table, and
+ *   hex strings are parsed and formatted by hand, so that converting a
+ *   color does not allocate memory except for the returned string
+ * - added interned color handles
  * @version 2019/05/05
  * - added getLuminance
  * @version 2018/09/16
@@ -14,83 +19,231 @@
  */
 
 #include "gcolor.h"
-#include <iomanip>
-#include <iostream>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 #include "error.h"
-#include "strlib.h"
 
-Map<std::string, int> GColor::_colorTable;
-Map<std::string, std::string> GColor::_colorNameTable;
+namespace {
 
-GColor::GColor() {
-    // empty
+/*
+ * The predefined color names, in canonical form (see canonicalName).
+ * When two names share a value, convertRGBToColor returns the later one.
+ */
+struct NamedColor {
+    const char* name;
+    int length;
+    int rgb;
+};
+
+constexpr NamedColor NAMED_COLORS[] = {
+    {"black",     5, 0x000000},
+    {"blue",      4, 0x0000FF},
+    {"brown",     5, 0x926239},
+    {"cyan",      4, 0x00FFFF},
+    {"darkgray",  8, 0x595959},
+    {"gray",      4, 0x999999},
+    {"green",     5, 0x00FF00},
+    {"lightgray", 9, 0xBFBFBF},
+    {"magenta",   7, 0xFF00FF},
+    {"orange",    6, 0xFFC800},
+    {"pink",      4, 0xFFAFAF},
+    {"purple",    6, 0xFF00FF},
+    {"red",       3, 0xFF0000},
+    {"white",     5, 0xFFFFFF},
+    {"yellow",    6, 0xFFFF00}
+};
+
+constexpr int NAMED_COLOR_COUNT = static_cast<int>(sizeof(NAMED_COLORS) / sizeof(NAMED_COLORS[0]));
+constexpr int NAME_MAX_LENGTH = 9;
+constexpr int NAME_HASH_SLOTS = 32;
+
+/*
+ * Hashes a canonical color name from its length and its first and last
+ * letters.  The multipliers were chosen so that no two predefined names land
+ * in the same slot; nameHashIsPerfect checks this when the file compiles.
+ */
+constexpr int nameHash(const char* name, int length) {
+    return (name[0] * 7 + name[length - 1] + length) & (NAME_HASH_SLOTS - 1);
+}
+
+constexpr std::array<int, NAME_HASH_SLOTS> buildNameSlots() {
+    std::array<int, NAME_HASH_SLOTS> slots {};
+    for (int i = 0; i < NAME_HASH_SLOTS; i++) {
+        slots[i] = -1;
+    }
+    for (int i = 0; i < NAMED_COLOR_COUNT; i++) {
+        slots[nameHash(NAMED_COLORS[i].name, NAMED_COLORS[i].length)] = i;
+    }
+    return slots;
+}
+
+constexpr std::array<int, NAME_HASH_SLOTS> NAME_SLOTS = buildNameSlots();
+
+constexpr bool nameHashIsPerfect() {
+    for (int i = 0; i < NAMED_COLOR_COUNT; i++) {
+        if (NAME_SLOTS[nameHash(NAMED_COLORS[i].name, NAMED_COLORS[i].length)] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(nameHashIsPerfect(), "two color names share a hash slot; change nameHash");
+
+/*
+ * Copies the given color name into buffer in canonical form, lowercase
+ * with spaces and underscores removed; e.g. "Dark Gray" => "darkgray".
+ * Returns the canonical length, or -1 if it is too long to be a color name.
+ */
+int canonicalName(const std::string& str, char* buffer) {
+    int length = 0;
+    for (char ch : str) {
+        unsigned char uch = static_cast<unsigned char>(ch);
+        if (std::isspace(uch) || ch == '_') {
+            continue;
+        }
+        if (length == NAME_MAX_LENGTH) {
+            return -1;
+        }
+        buffer[length++] = static_cast<char>(std::tolower(uch));
+    }
+    return length;
+}
+
+/*
+ * Returns the RGB value of the given predefined color name, or -1 if the
+ * name is not one of them.
+ */
+int findNamedColor(const std::string& str) {
+    char name[NAME_MAX_LENGTH];
+    int length = canonicalName(str, name);
+    if (length <= 0) {
+        return -1;
+    }
+    int index = NAME_SLOTS[nameHash(name, length)];
+    if (index < 0 || NAMED_COLORS[index].length != length
+            || std::memcmp(NAMED_COLORS[index].name, name, static_cast<size_t>(length)) != 0) {
+        return -1;
+    }
+    return NAMED_COLORS[index].rgb;
+}
+
+/*
+ * Returns the name of the predefined color with the given RGB value,
+ * or null if there is none.
+ */
+const char* findColorName(int rgb) {
+    rgb &= 0x00ffffff;
+    for (int i = NAMED_COLOR_COUNT - 1; i >= 0; i--) {
+        if (NAMED_COLORS[i].rgb == rgb) {
+            return NAMED_COLORS[i].name;
+        }
+    }
+    return nullptr;
 }
 
-/*static*/ std::string GColor::canonicalColorName(const std::string& str) {
-    std::string result = "";
-    int nChars = static_cast<int>(str.length());
-    for (int i = 0; i < nChars; i++) {
+/*
+ * Parses the hex digits that follow the '#' in a color string.
+ * Returns false unless there are 1 to 8 digits and nothing else.
+ */
+bool parseHexColor(const std::string& str, unsigned int& value) {
+    int digits = static_cast<int>(str.length()) - 1;
+    if (digits < 1 || digits > 8) {
+        return false;
+    }
+    value = 0;
+    for (int i = 1; i <= digits; i++) {
         char ch = str[i];
-        if (!isspace(ch) && ch != '_') result += tolower(ch);
-    }
-    return result;
-}
-
-/*static*/ const Map<std::string, int>& GColor::colorTable() {
-    if (_colorTable.isEmpty()) {
-        _colorTable["black"] = 0x000000;
-        _colorTable["blue"] = 0x0000FF;
-        _colorTable["brown"] = 0x926239;
-        _colorTable["cyan"] = 0x00FFFF;
-        _colorTable["darkgray"] = 0x595959;
-        _colorTable["gray"] = 0x999999;
-        _colorTable["green"] = 0x00FF00;
-        _colorTable["lightgray"] = 0xBFBFBF;
-        _colorTable["magenta"] = 0xFF00FF;
-        _colorTable["orange"] = 0xFFC800;
-        _colorTable["pink"] = 0xFFAFAF;
-        _colorTable["purple"] = 0xFF00FF;
-        _colorTable["red"] = 0xFF0000;
-        _colorTable["white"] = 0xFFFFFF;
-        _colorTable["yellow"] = 0xFFFF00;
-    }
-    return _colorTable;
-}
-
-/*static*/ const Map<std::string, std::string>& GColor::colorNameTable() {
-    if (_colorNameTable.isEmpty()) {
-        _colorNameTable["#000000"] = "black";
-        _colorNameTable["#ff000000"] = "black";
-        _colorNameTable["#0000ff"] = "blue";
-        _colorNameTable["#ff0000ff"] = "blue";
-        _colorNameTable["#926239"] = "brown";
-        _colorNameTable["#ff926239"] = "brown";
-        _colorNameTable["#00ffff"] = "cyan";
-        _colorNameTable["#ff00ffff"] = "cyan";
-        _colorNameTable["#595959"] = "darkgray";
-        _colorNameTable["#ff595959"] = "darkgray";
-        _colorNameTable["#999999"] = "gray";
-        _colorNameTable["#ff999999"] = "gray";
-        _colorNameTable["#00ff00"] = "green";
-        _colorNameTable["#ff00ff00"] = "green";
-        _colorNameTable["#bfbfbf"] = "lightgray";
-        _colorNameTable["#ffbfbfbf"] = "lightgray";
-        _colorNameTable["#ff00ff"] = "magenta";
-        _colorNameTable["#ffff00ff"] = "magenta";
-        _colorNameTable["#ffc800"] = "orange";
-        _colorNameTable["#ffffc800"] = "orange";
-        _colorNameTable["#ffafaf"] = "pink";
-        _colorNameTable["#ffffafaf"] = "pink";
-        _colorNameTable["#ff00ff"] = "purple";
-        _colorNameTable["#ffff00ff"] = "purple";
-        _colorNameTable["#ff0000"] = "red";
-        _colorNameTable["#ffff0000"] = "red";
-        _colorNameTable["#ffffff"] = "white";
-        _colorNameTable["#ffffffff"] = "white";
-        _colorNameTable["#ffff00"] = "yellow";
-        _colorNameTable["#ffffff00"] = "yellow";
-    }
-    return _colorNameTable;
+        unsigned int digit;
+        if (ch >= '0' && ch <= '9') {
+            digit = static_cast<unsigned int>(ch - '0');
+        } else if (ch >= 'a' && ch <= 'f') {
+            digit = static_cast<unsigned int>(ch - 'a' + 10);
+        } else if (ch >= 'A' && ch <= 'F') {
+            digit = static_cast<unsigned int>(ch - 'A' + 10);
+        } else {
+            return false;
+        }
+        value = (value << 4) | digit;
+    }
+    return true;
+}
+
+/*
+ * Formats the low digits hex digits of value as "#..." in uppercase.
+ */
+std::string formatHexColor(unsigned int value, int digits) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    char buffer[9];
+    buffer[0] = '#';
+    for (int i = digits; i >= 1; i--) {
+        buffer[i] = HEX_DIGITS[value & 0xF];
+        value >>= 4;
+    }
+    return std::string(buffer, static_cast<size_t>(digits + 1));
+}
+
+} // namespace
+
+/*
+ * An interned color.  Entries are created once, under the intern mutex, and
+ * never changed or freed afterward, so handles can read them without locking.
+ */
+struct GColor::Handle::Entry {
+    int argb;
+    std::string name;
+    QColor qcolor;
+};
+
+GColor::Handle::Handle()
+        : _entry(nullptr) {
+    // empty
+}
+
+GColor::Handle::Handle(const Entry* entry)
+        : _entry(entry) {
+    // empty
+}
+
+int GColor::Handle::getARGB() const {
+    return _entry ? _entry->argb : 0;
+}
+
+int GColor::Handle::getRGB() const {
+    return _entry ? (_entry->argb & 0x00ffffff) : 0;
+}
+
+bool GColor::Handle::hasAlpha() const {
+    return _entry && (static_cast<unsigned int>(_entry->argb) >> 24) != 0xff;
+}
+
+bool GColor::Handle::isNull() const {
+    return _entry == nullptr;
+}
+
+const QColor& GColor::Handle::toQColor() const {
+    static const QColor NO_COLOR;
+    return _entry ? _entry->qcolor : NO_COLOR;
+}
+
+const std::string& GColor::Handle::toString() const {
+    static const std::string NO_COLOR;
+    return _entry ? _entry->name : NO_COLOR;
+}
+
+bool GColor::Handle::operator ==(const Handle& other) const {
+    return _entry == other._entry;
+}
+
+bool GColor::Handle::operator !=(const Handle& other) const {
+    return _entry != other._entry;
+}
+
+GColor::GColor() {
+    // empty
 }
 
 /*static*/ int GColor::convertARGBToARGB(int a, int r, int g, int b) {
@@ -101,19 +254,11 @@ GColor::GColor() {
     if (a < 0 || a > 255 || r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) {
         error("GColor::convertARGBToColor: invalid ARGB value (must be 0-255)");
     }
-    std::ostringstream os;
-    os << std::hex << std::setfill('0') << std::uppercase << "#";
-    os << std::setw(2) << (a & 0xFF);
-    os << std::setw(2) << (r & 0xFF);
-    os << std::setw(2) << (g & 0xFF);
-    os << std::setw(2) << (b & 0xFF);
-    return os.str();
+    return formatHexColor(static_cast<unsigned int>(convertARGBToARGB(a, r, g, b)), 8);
 }
 
 /*static*/ std::string GColor::convertARGBToColor(int argb) {
-    int a, r, g, b;
-    splitARGB(argb, a, r, g, b);
-    return convertARGBToColor(a, r, g, b);
+    return formatHexColor(static_cast<unsigned int>(argb), 8);
 }
 
 /*static*/ int GColor::convertColorToARGB(const std::string& colorName) {
@@ -121,22 +266,19 @@ GColor::GColor() {
 }
 
 /*static*/ int GColor::convertColorToRGB(const std::string& colorName) {
-    if (colorName == "") return -1;
+    if (colorName.empty()) return -1;
     if (colorName[0] == '#') {
-        std::istringstream is(colorName.substr(1) + "@");
         unsigned int rgb;
-        char terminator = '\0';
-        is >> std::hex >> rgb >> terminator;
-        if (terminator != '@') {
+        if (!parseHexColor(colorName, rgb)) {
             error("GColor::convertColorToRGB: Illegal color - \"" + colorName + "\"");
         }
-        return static_cast<int>(rgb & 0xffffffff);
+        return static_cast<int>(rgb);
     }
-    std::string name = canonicalColorName(colorName);
-    if (!colorTable().containsKey(name)) {
+    int rgb = findNamedColor(colorName);
+    if (rgb < 0) {
         error("GColor::convertColorToRGB: Undefined color - \"" + colorName + "\"");
     }
-    return colorTable()[name];
+    return rgb;
 }
 
 /*static*/ std::string GColor::convertQColorToColor(const QColor& color) {
@@ -148,34 +290,18 @@ GColor::GColor() {
 }
 
 /*static*/ std::string GColor::convertRGBToColor(int rgb) {
-    std::ostringstream os;
-    os << std::hex << std::setfill('0') << std::uppercase << "#";
-    os << std::setw(2) << (rgb >> 16 & 0xFF);
-    os << std::setw(2) << (rgb >> 8 & 0xFF);
-    os << std::setw(2) << (rgb & 0xFF);
-    std::string color = os.str();
-    if (colorNameTable().containsKey(toLowerCase(color))) {
-        return colorNameTable()[toLowerCase(color)];
-    } else {
-        return color;
+    const char* name = findColorName(rgb);
+    if (name) {
+        return name;
     }
+    return formatHexColor(static_cast<unsigned int>(rgb) & 0x00ffffff, 6);
 }
 
 /*static*/ std::string GColor::convertRGBToColor(int r, int g, int b) {
     if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) {
         error("GColor::convertRGBToColor: invalid RGB value (must be 0-255)");
     }
-    std::ostringstream os;
-    os << std::hex << std::setfill('0') << std::uppercase << "#";
-    os << std::setw(2) << (r & 0xFF);
-    os << std::setw(2) << (g & 0xFF);
-    os << std::setw(2) << (b & 0xFF);
-    std::string color = os.str();
-    if (colorNameTable().containsKey(toLowerCase(color))) {
-        return colorNameTable()[toLowerCase(color)];
-    } else {
-        return color;
-    }
+    return convertRGBToColor(convertRGBToRGB(r, g, b));
 }
 
 /*static*/ int GColor::convertRGBToRGB(int r, int g, int b) {
@@ -206,6 +332,46 @@ GColor::GColor() {
             && color[0] == '#';
 }
 
+/*static*/ GColor::Handle GColor::intern(const std::string& color) {
+    if (color.empty()) {
+        return Handle();
+    } else if (hasAlpha(color)) {
+        return internARGB(convertColorToARGB(color));
+    } else {
+        return intern(convertColorToRGB(color));
+    }
+}
+
+/*static*/ GColor::Handle GColor::intern(int rgb) {
+    return internARGB(static_cast<int>(static_cast<unsigned int>(rgb) | 0xff000000));
+}
+
+/*
+ * Implementation notes: internARGB
+ * --------------------------------
+ * The table is keyed by ARGB value, so every spelling of a color shares one
+ * entry.  It is allocated on first use and never destroyed, so handles held
+ * by static objects stay valid while the program exits, and since
+ * unordered_map never moves its elements, handles stay valid as it grows.
+ */
+/*static*/ GColor::Handle GColor::internARGB(int argb) {
+    static std::mutex* internMutex = new std::mutex();
+    static std::unordered_map<unsigned int, Handle::Entry>* entries =
+            new std::unordered_map<unsigned int, Handle::Entry>();
+
+    unsigned int key = static_cast<unsigned int>(argb);
+    std::lock_guard<std::mutex> lock(*internMutex);
+    auto itr = entries->find(key);
+    if (itr == entries->end()) {
+        Handle::Entry entry;
+        entry.argb = argb;
+        entry.name = (key >> 24) == 0xff ? convertRGBToColor(argb) : convertARGBToColor(argb);
+        entry.qcolor = toQColorARGB(argb);
+        itr = entries->emplace(key, entry).first;
+    }
+    return Handle(&itr->second);
+}
+
 /*static*/ void GColor::splitARGB(int argb, int& a, int& r, int& g, int& b) {
     a = ((static_cast<unsigned int>(argb) & 0xff000000) >> 24) & 0x000000ff;
     r = (argb & 0x00ff0000) >> 16;
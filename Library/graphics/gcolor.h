@@ -3,6 +3,9 @@
  * --------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - color names and hex strings are converted without streams or maps
+ * - added interned color handles (GColor::Handle, GColor::intern)
  * @version 2019/05/05
  * - added getLuminance
  * @version 2018/09/16
@@ -22,8 +25,6 @@
 #include <string>
 #include <QColor>
 
-#include "map.h"
-
 /**
  * This class provides static methods for dealing with colors.
  *
@@ -65,6 +66,11 @@
  * red, green, and blue components of the color, respectively.
  * You can also include an alpha (opacity) channel by writing the hex string
  * in ARGB form as <code>"#aarrggbb"</code>.
+ *
+ * Code that sets the same few colors over and over, such as an animation
+ * that recolors thousands of shapes per frame, can convert each color once
+ * with GColor::intern and pass the resulting Handle around instead of a
+ * string, skipping the conversion entirely.
  */
 class GColor {
 public:
@@ -89,6 +95,77 @@ public:
         YELLOW = 0xFFFF00
     } Color;
 
+    /**
+     * A Handle is a small value that stands for one color, obtained by
+     * calling GColor::intern.  Its RGB value, string form, and Qt color are
+     * worked out once when the color is first interned, so reading them
+     * later costs nothing, and copying a Handle is as cheap as copying a
+     * pointer.  Interning the same color twice, even when it is spelled
+     * differently (such as "red" and "#ff0000"), gives equal handles.
+     *
+     * A default-constructed Handle stands for no color; its string form is
+     * empty and its color values are 0.
+     */
+    class Handle {
+    public:
+        /**
+         * Creates a handle that stands for no color.
+         */
+        Handle();
+
+        /**
+         * Returns the color as an ARGB integer.
+         * Colors interned without an alpha channel are fully opaque.
+         */
+        int getARGB() const;
+
+        /**
+         * Returns the color as an RGB integer, without its alpha channel.
+         */
+        int getRGB() const;
+
+        /**
+         * Returns true if the color is not fully opaque, meaning that its
+         * string form is of the <code>"#aarrggbb"</code> variety.
+         */
+        bool hasAlpha() const;
+
+        /**
+         * Returns true if this handle stands for no color.
+         */
+        bool isNull() const;
+
+        /**
+         * Returns the color as a Qt color object, including its alpha channel.
+         */
+        const QColor& toQColor() const;
+
+        /**
+         * Returns the color as a string, in the same form that
+         * convertRGBToColor or convertARGBToColor would produce.
+         */
+        const std::string& toString() const;
+
+        /**
+         * Returns true if the two handles stand for the same color.
+         */
+        bool operator ==(const Handle& other) const;
+
+        /**
+         * Returns true if the two handles stand for different colors.
+         */
+        bool operator !=(const Handle& other) const;
+
+    private:
+        struct Entry;   // the interned color; defined in gcolor.cpp
+
+        explicit Handle(const Entry* entry);
+
+        const Entry* _entry;   // never freed; null for no color
+
+        friend class GColor;
+    };
+
     /**
      * Converts four integer RGB values from 0-255 into a color name in the
      * form <code>"#aarrggbb"</code>.  Each of the <code>aa</code>, <code>rr</code>,
@@ -190,6 +267,29 @@ public:
      */
     static bool hasAlpha(const std::string& color);
 
+    /**
+     * Returns a handle for the given color, which may be given in any of the
+     * forms described at the top of this file.
+     * Interned colors are kept for the rest of the program, so this is meant
+     * for a program's palette of colors rather than for every color of a
+     * gradient.  It is safe to call from any thread.
+     * An empty string gives a handle that stands for no color.
+     * @throw ErrorException if the color string is not valid
+     */
+    static Handle intern(const std::string& color);
+
+    /**
+     * Returns a handle for the given RGB integer, such as 0x7700ff.
+     * The alpha bits are ignored, so the color is fully opaque.
+     */
+    static Handle intern(int rgb);
+
+    /**
+     * Returns a handle for the given ARGB integer, such as 0x807700ff.
+     * As with setPixelARGB, an alpha of 0 means fully transparent.
+     */
+    static Handle internARGB(int argb);
+
     /**
      * Splits the given ARGB integer into four integer RGB values from 0-255.
      * Each of the <code>aa</code>, <code>rr</code>,
@@ -220,27 +320,6 @@ public:
 
 private:
     GColor();   // forbid construction
-
-    /**
-     * Strips casing and punctuation; e.g. "Dark Gray" => "darkgray"
-     */
-    static std::string canonicalColorName(const std::string& str);
-
-    /**
-     * Returns a reference to the table of common colors,
-     * mapping from names to RGB integers.
-     */
-    static const Map<std::string, int>& colorTable();
-
-    /**
-     * Returns a reference to the table of common colors,
-     * mapping from names to color strings.
-     */
-    static const Map<std::string, std::string>& colorNameTable();
-
-    // internal color tables
-    static Map<std::string, int> _colorTable;
-    static Map<std::string, std::string> _colorNameTable;
 };
 
 #endif // _gcolor_h
@@ -0,0 +1,1060 @@
+/*
+ * File: gdatatable.cpp
+ * --------------------
+ * This file implements the gdatatable.h interface.
+ * See that file for documentation of each member.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "gdatatable.h"
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <QBrush>
+#include <QColor>
+#include <QHeaderView>
+#include "gcolor.h"
+#include "gevent.h"
+#include "gfont.h"
+#include "gthread.h"
+#include "require.h"
+
+namespace {
+/* Number of rows measured by autofitColumnWidths. */
+const int AUTOFIT_SAMPLE_ROWS = 1000;
+
+/* Key of a single cell in the model's table of cell styles. */
+long long cellKey(int row, int column) {
+    return (static_cast<long long>(row) << 32) | static_cast<unsigned int>(column);
+}
+}
+
+GDataTable::GDataTable(int rows, int columns, double width, double height, QWidget* parent)
+        : _iqtableview(nullptr),
+          _model(nullptr) {
+    require::nonNegative2D(rows, columns, "GDataTable::constructor", "rows", "columns");
+    require::nonNegative2D(width, height, "GDataTable::constructor", "width", "height");
+    GThread::runOnQtGuiThread([this, rows, columns, parent]() {
+        _model = new _Internal_QDataTableModel();
+        _model->resize(rows, columns);
+        _iqtableview = new _Internal_QDataTableView(this, _model, getInternalParent(parent));
+        _model->setParent(_iqtableview);
+        _model->setBaseFont(_iqtableview->font());
+    });
+    if (width > 0 && height > 0) {
+        setPreferredSize(width, height);
+    }
+    setVisible(false);   // all widgets are not shown until added to a window
+}
+
+GDataTable::GDataTable(const Grid<std::string>& data, double width, double height, QWidget* parent)
+        : GDataTable(0, 0, width, height, parent) {
+    setData(data);
+}
+
+/*
+ * Implementation notes: destructor
+ * --------------------------------
+ * The view must be deleted on the Qt GUI thread, which may be painting it
+ * at this moment.  It is detached first so that any event it sends in the
+ * meantime is dropped.  The model is a child of the view and goes with it.
+ */
+GDataTable::~GDataTable() {
+    _iqtableview->detach();
+    _Internal_QDataTableView* view = _iqtableview;
+    _iqtableview = nullptr;
+    _model = nullptr;
+    GThread::runOnQtGuiThread([view]() {
+        delete view;
+    });
+}
+
+void GDataTable::autofitColumnWidths() {
+    GThread::runOnQtGuiThread([this]() {
+        _iqtableview->horizontalHeader()->setResizeContentsPrecision(AUTOFIT_SAMPLE_ROWS);
+        _iqtableview->resizeColumnsToContents();
+    });
+}
+
+/*
+ * Implementation notes: check functions
+ * -------------------------------------
+ * These read the model directly rather than calling numRows, numCols, or
+ * hasDataSource, each of which is a separate trip to the Qt GUI thread.
+ * So they must be called on the Qt GUI thread, inside the same function as
+ * the change they guard; runOnQtGuiThread rethrows their errors in the
+ * caller.  This also means the table cannot be resized between the check
+ * and the change.
+ */
+void GDataTable::checkColumn(const std::string& member, int column) const {
+    require::inRange(column, 0, _model->columnCount() - 1, "GDataTable::" + member, "column");
+}
+
+void GDataTable::checkIndex(const std::string& member, int row, int column) const {
+    require::inRange2D(row, column, 0, 0, _model->rowCount() - 1, _model->columnCount() - 1,
+                       "GDataTable::" + member, "row", "column");
+}
+
+void GDataTable::checkRange(const std::string& member, int row, int column, int rows, int columns) const {
+    require::nonNegative2D(rows, columns, "GDataTable::" + member, "rows", "columns");
+    require::inRange2D(row, column, 0, 0, _model->rowCount() - rows, _model->columnCount() - columns,
+                       "GDataTable::" + member, "row", "column");
+}
+
+void GDataTable::checkRow(const std::string& member, int row) const {
+    require::inRange(row, 0, _model->rowCount() - 1, "GDataTable::" + member, "row");
+}
+
+void GDataTable::checkWritable(const std::string& member) const {
+    if (_model->hasDataSource()) {
+        error("GDataTable::" + member + ": table has a read-only data source");
+    }
+}
+
+void GDataTable::clear() {
+    GThread::runOnQtGuiThread([this]() {
+        _model->setGrid(Grid<std::string>(_model->rowCount(), _model->columnCount()));
+    });
+}
+
+void GDataTable::clearFormatting() {
+    GThread::runOnQtGuiThread([this]() {
+        _model->clearStyles();
+    });
+}
+
+void GDataTable::clearSelection() {
+    GThread::runOnQtGuiThread([this]() {
+        _iqtableview->clearSelection();
+    });
+}
+
+void GDataTable::fill(const std::string& text) {
+    GThread::runOnQtGuiThread([this, text]() {
+        checkWritable("fill");
+        _model->fill(text);
+    });
+}
+
+std::string GDataTable::get(int row, int column) const {
+    std::string text;
+    GThread::runOnQtGuiThread([this, row, column, &text]() {
+        checkIndex("get", row, column);
+        text = _model->get(row, column);
+    });
+    return text;
+}
+
+Grid<std::string> GDataTable::getData() const {
+    Grid<std::string> data;
+    GThread::runOnQtGuiThread([this, &data]() {
+        data = _model->getGrid();
+    });
+    return data;
+}
+
+_Internal_QWidget* GDataTable::getInternalWidget() const {
+    return _iqtableview;
+}
+
+GridLocation GDataTable::getSelectedCell() const {
+    GridLocation loc(-1, -1);
+    GThread::runOnQtGuiThread([this, &loc]() {
+        QModelIndexList list = _iqtableview->selectionModel()->selectedIndexes();
+        if (!list.empty()) {
+            QModelIndex index = list.at(0);
+            loc = GridLocation(index.row(), index.column());
+        }
+    });
+    return loc;
+}
+
+int GDataTable::getSelectedColumn() const {
+    return getSelectedCell().col;
+}
+
+int GDataTable::getSelectedRow() const {
+    return getSelectedCell().row;
+}
+
+std::string GDataTable::getType() const {
+    return "GDataTable";
+}
+
+QWidget* GDataTable::getWidget() const {
+    return static_cast<QWidget*>(_iqtableview);
+}
+
+bool GDataTable::hasDataSource() const {
+    bool result = false;
+    GThread::runOnQtGuiThread([this, &result]() {
+        result = _model->hasDataSource();
+    });
+    return result;
+}
+
+bool GDataTable::hasSelectedCell() const {
+    GridLocation loc = getSelectedCell();
+    return loc.row >= 0 && loc.col >= 0;
+}
+
+bool GDataTable::inTableBounds(int row, int column) const {
+    bool result = false;
+    GThread::runOnQtGuiThread([this, row, column, &result]() {
+        result = 0 <= row && row < _model->rowCount()
+                && 0 <= column && column < _model->columnCount();
+    });
+    return result;
+}
+
+bool GDataTable::isEditable() const {
+    bool result = false;
+    GThread::runOnQtGuiThread([this, &result]() {
+        result = _model->isEditable();
+    });
+    return result;
+}
+
+int GDataTable::numCols() const {
+    int result = 0;
+    GThread::runOnQtGuiThread([this, &result]() {
+        result = _model->columnCount();
+    });
+    return result;
+}
+
+int GDataTable::numRows() const {
+    int result = 0;
+    GThread::runOnQtGuiThread([this, &result]() {
+        result = _model->rowCount();
+    });
+    return result;
+}
+
+void GDataTable::removeTableListener() {
+    removeEventListeners({"table",
+                          "tableupdate",
+                          "tableselect"});
+}
+
+void GDataTable::resize(int newNumRows, int newNumCols) {
+    require::nonNegative2D(newNumRows, newNumCols, "GDataTable::resize", "rows", "columns");
+    GThread::runOnQtGuiThread([this, newNumRows, newNumCols]() {
+        checkWritable("resize");
+        _model->resize(newNumRows, newNumCols);
+    });
+}
+
+void GDataTable::select(int row, int column) {
+    GThread::runOnQtGuiThread([this, row, column]() {
+        checkIndex("select", row, column);
+        QModelIndex index = _model->index(row, column);
+        _iqtableview->selectionModel()->select(index, QItemSelectionModel::ClearAndSelect);
+        _iqtableview->scrollTo(index);
+    });
+}
+
+void GDataTable::set(int row, int column, const std::string& text) {
+    GThread::runOnQtGuiThread([this, row, column, text]() {
+        checkIndex("set", row, column);
+        checkWritable("set");
+        _model->setCell(row, column, text);
+    });
+}
+
+void GDataTable::setBackground(int rgb) {
+    GThread::runOnQtGuiThread([this, rgb]() {
+        _Internal_QDataTableModel::CellStyle style;
+        style.background = rgb;
+        _model->addStyle(0, 0, INT_MAX, INT_MAX, style);
+    });
+}
+
+void GDataTable::setBackground(const std::string& color) {
+    setBackground(GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setCellAlignment(int row, int column, HorizontalAlignment alignment) {
+    GThread::runOnQtGuiThread([this, row, column, alignment]() {
+        checkIndex("setCellAlignment", row, column);
+        _Internal_QDataTableModel::CellStyle style;
+        style.alignment = alignment;
+        _model->addStyle(row, column, 1, 1, style);
+    });
+}
+
+void GDataTable::setCellBackground(int row, int column, int rgb) {
+    GThread::runOnQtGuiThread([this, row, column, rgb]() {
+        checkIndex("setCellBackground", row, column);
+        _Internal_QDataTableModel::CellStyle style;
+        style.background = rgb;
+        _model->addStyle(row, column, 1, 1, style);
+    });
+}
+
+void GDataTable::setCellBackground(int row, int column, const std::string& color) {
+    setCellBackground(row, column, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setCellFont(int row, int column, const std::string& font) {
+    GThread::runOnQtGuiThread([this, row, column, font]() {
+        checkIndex("setCellFont", row, column);
+        _Internal_QDataTableModel::CellStyle style;
+        style.font = font;
+        _model->addStyle(row, column, 1, 1, style);
+    });
+}
+
+void GDataTable::setCellForeground(int row, int column, int rgb) {
+    GThread::runOnQtGuiThread([this, row, column, rgb]() {
+        checkIndex("setCellForeground", row, column);
+        _Internal_QDataTableModel::CellStyle style;
+        style.foreground = rgb;
+        _model->addStyle(row, column, 1, 1, style);
+    });
+}
+
+void GDataTable::setCellForeground(int row, int column, const std::string& color) {
+    setCellForeground(row, column, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setColor(int rgb) {
+    setForeground(rgb);
+}
+
+void GDataTable::setColor(const std::string& color) {
+    setForeground(color);
+}
+
+void GDataTable::setColumnBackground(int column, int rgb) {
+    GThread::runOnQtGuiThread([this, column, rgb]() {
+        checkColumn("setColumnBackground", column);
+        _Internal_QDataTableModel::CellStyle style;
+        style.background = rgb;
+        _model->addStyle(0, column, INT_MAX, 1, style);
+    });
+}
+
+void GDataTable::setColumnBackground(int column, const std::string& color) {
+    setColumnBackground(column, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setColumnForeground(int column, int rgb) {
+    GThread::runOnQtGuiThread([this, column, rgb]() {
+        checkColumn("setColumnForeground", column);
+        _Internal_QDataTableModel::CellStyle style;
+        style.foreground = rgb;
+        _model->addStyle(0, column, INT_MAX, 1, style);
+    });
+}
+
+void GDataTable::setColumnForeground(int column, const std::string& color) {
+    setColumnForeground(column, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setColumnHeaders(const Vector<std::string>& headers) {
+    GThread::runOnQtGuiThread([this, headers]() {
+        _model->setColumnHeaders(headers);
+    });
+}
+
+void GDataTable::setColumnWidth(int column, double width) {
+    if (width < 0) {
+        error("GDataTable::setColumnWidth: width cannot be negative");
+    }
+    GThread::runOnQtGuiThread([this, column, width]() {
+        checkColumn("setColumnWidth", column);
+        _iqtableview->setColumnWidth(column, (int) width);
+    });
+}
+
+void GDataTable::setData(const Grid<std::string>& data) {
+    GThread::runOnQtGuiThread([this, &data]() {
+        _model->setGrid(data);
+    });
+}
+
+void GDataTable::setDataSource(int rows, int columns, DataSource source) {
+    require::nonNegative2D(rows, columns, "GDataTable::setDataSource", "rows", "columns");
+    if (!source) {
+        error("GDataTable::setDataSource: data source function cannot be null");
+    }
+    GThread::runOnQtGuiThread([this, rows, columns, source]() {
+        _model->setDataSource(rows, columns, source);
+    });
+}
+
+void GDataTable::setEditable(bool editable) {
+    GThread::runOnQtGuiThread([this, editable]() {
+        _model->setEditable(editable);
+        if (editable) {
+            _iqtableview->setEditTriggers(
+                        QAbstractItemView::DoubleClicked
+                        | QAbstractItemView::EditKeyPressed
+                        | QAbstractItemView::AnyKeyPressed);
+        } else {
+            _iqtableview->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        }
+    });
+}
+
+void GDataTable::setFont(const QFont& font) {
+    setFont(GFont::toFontString(font));
+}
+
+void GDataTable::setFont(const std::string& font) {
+    GThread::runOnQtGuiThread([this, font]() {
+        _Internal_QDataTableModel::CellStyle style;
+        style.font = font;
+        _model->addStyle(0, 0, INT_MAX, INT_MAX, style);
+    });
+}
+
+void GDataTable::setForeground(int rgb) {
+    GThread::runOnQtGuiThread([this, rgb]() {
+        _Internal_QDataTableModel::CellStyle style;
+        style.foreground = rgb;
+        _model->addStyle(0, 0, INT_MAX, INT_MAX, style);
+    });
+}
+
+void GDataTable::setForeground(const std::string& color) {
+    setForeground(GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setHorizontalAlignment(HorizontalAlignment alignment) {
+    GThread::runOnQtGuiThread([this, alignment]() {
+        _Internal_QDataTableModel::CellStyle style;
+        style.alignment = alignment;
+        _model->addStyle(0, 0, INT_MAX, INT_MAX, style);
+    });
+}
+
+void GDataTable::setRange(int row, int column, const Grid<std::string>& values) {
+    GThread::runOnQtGuiThread([this, row, column, &values]() {
+        checkIndex("setRange", row, column);
+        checkWritable("setRange");
+        _model->setRange(row, column, values);
+    });
+}
+
+void GDataTable::setRangeAlignment(int row, int column, int rows, int columns,
+                                   HorizontalAlignment alignment) {
+    GThread::runOnQtGuiThread([this, row, column, rows, columns, alignment]() {
+        checkRange("setRangeAlignment", row, column, rows, columns);
+        _Internal_QDataTableModel::CellStyle style;
+        style.alignment = alignment;
+        _model->addStyle(row, column, rows, columns, style);
+    });
+}
+
+void GDataTable::setRangeBackground(int row, int column, int rows, int columns, int rgb) {
+    GThread::runOnQtGuiThread([this, row, column, rows, columns, rgb]() {
+        checkRange("setRangeBackground", row, column, rows, columns);
+        _Internal_QDataTableModel::CellStyle style;
+        style.background = rgb;
+        _model->addStyle(row, column, rows, columns, style);
+    });
+}
+
+void GDataTable::setRangeBackground(int row, int column, int rows, int columns,
+                                    const std::string& color) {
+    setRangeBackground(row, column, rows, columns, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setRangeFont(int row, int column, int rows, int columns,
+                              const std::string& font) {
+    GThread::runOnQtGuiThread([this, row, column, rows, columns, font]() {
+        checkRange("setRangeFont", row, column, rows, columns);
+        _Internal_QDataTableModel::CellStyle style;
+        style.font = font;
+        _model->addStyle(row, column, rows, columns, style);
+    });
+}
+
+void GDataTable::setRangeForeground(int row, int column, int rows, int columns, int rgb) {
+    GThread::runOnQtGuiThread([this, row, column, rows, columns, rgb]() {
+        checkRange("setRangeForeground", row, column, rows, columns);
+        _Internal_QDataTableModel::CellStyle style;
+        style.foreground = rgb;
+        _model->addStyle(row, column, rows, columns, style);
+    });
+}
+
+void GDataTable::setRangeForeground(int row, int column, int rows, int columns,
+                                    const std::string& color) {
+    setRangeForeground(row, column, rows, columns, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setRow(int row, const Vector<std::string>& values) {
+    GThread::runOnQtGuiThread([this, row, &values]() {
+        checkRow("setRow", row);
+        checkWritable("setRow");
+        _model->setRow(row, values);
+    });
+}
+
+void GDataTable::setRowBackground(int row, int rgb) {
+    GThread::runOnQtGuiThread([this, row, rgb]() {
+        checkRow("setRowBackground", row);
+        _Internal_QDataTableModel::CellStyle style;
+        style.background = rgb;
+        _model->addStyle(row, 0, 1, INT_MAX, style);
+    });
+}
+
+void GDataTable::setRowBackground(int row, const std::string& color) {
+    setRowBackground(row, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setRowColumnHeadersVisible(bool visible) {
+    GThread::runOnQtGuiThread([this, visible]() {
+        _iqtableview->horizontalHeader()->setVisible(visible);
+        _iqtableview->verticalHeader()->setVisible(visible);
+    });
+}
+
+void GDataTable::setRowForeground(int row, int rgb) {
+    GThread::runOnQtGuiThread([this, row, rgb]() {
+        checkRow("setRowForeground", row);
+        _Internal_QDataTableModel::CellStyle style;
+        style.foreground = rgb;
+        _model->addStyle(row, 0, 1, INT_MAX, style);
+    });
+}
+
+void GDataTable::setRowForeground(int row, const std::string& color) {
+    setRowForeground(row, GColor::convertColorToRGB(color));
+}
+
+void GDataTable::setTableListener(GEventListener func) {
+    setEventListeners({"table",
+                       "tableupdate",
+                       "tableselect"}, func);
+}
+
+void GDataTable::setTableListener(GEventListenerVoid func) {
+    setEventListeners({"table",
+                       "tableupdate",
+                       "tableselect"}, func);
+}
+
+
+_Internal_QDataTableModel::_Internal_QDataTableModel(QObject* parent)
+        : QAbstractTableModel(parent),
+          _rows(0),
+          _columns(0),
+          _editable(false),
+          _styleCount(0),
+          _resolvedRow(-1),
+          _resolvedColumn(-1) {
+    // empty
+}
+
+/*
+ * Implementation notes: addStyle
+ * ------------------------------
+ * Styles are filed by what they cover: the whole table, a whole row or
+ * column, a single cell, or else a rectangle of cells.
+ * Finding a cell's style then looks only at the few entries that can cover
+ * it, and restyling the same cell, row, or column updates its entry in
+ * place rather than adding one.  Each setting carries a stamp that counts
+ * up with every call, so the most recent setting wins no matter where it
+ * is filed.  The rows and columns extents are clamped to INT_MAX so that a
+ * row or column style covers cells added later.
+ */
+void _Internal_QDataTableModel::addStyle(int row, int column, int rows, int columns, const CellStyle& style) {
+    int row2 = static_cast<int>(std::min<long long>(INT_MAX, static_cast<long long>(row) + rows - 1));
+    int col2 = static_cast<int>(std::min<long long>(INT_MAX, static_cast<long long>(column) + columns - 1));
+    if (row2 < row || col2 < column) {
+        return;
+    }
+
+    long long stamp = ++_styleCount;
+    bool allRows = row == 0 && row2 == INT_MAX;
+    bool allColumns = column == 0 && col2 == INT_MAX;
+    if (allRows && allColumns) {
+        applyStyle(_tableStyle, style, stamp);
+    } else if (allColumns && row == row2) {
+        applyStyle(_rowStyles[row], style, stamp);
+    } else if (allRows && column == col2) {
+        applyStyle(_columnStyles[column], style, stamp);
+    } else if (row == row2 && column == col2) {
+        applyStyle(_cellStyles[cellKey(row, column)], style, stamp);
+    } else {
+        addRangeStyle(row, column, row2, col2, style, stamp);
+    }
+    _resolvedRow = -1;
+
+    emitCellsChanged(row, column, row2, col2,
+                     {Qt::BackgroundRole, Qt::ForegroundRole, Qt::FontRole, Qt::TextAlignmentRole});
+}
+
+/*
+ * Implementation notes: addRangeStyle
+ * -----------------------------------
+ * Each range is stored once, as a rectangle, under the stamp of the call
+ * that made it.  To find the ranges that cover a row, _rangeRows splits the
+ * rows into bands at the top and bottom edge of every range and lists the
+ * ranges that cover each band, oldest first.  Every range starts at a band.
+ * Adding a range splits at most two bands and adds it to the bands between,
+ * so the cost depends on how many ranges there are, not on how many rows
+ * the new one spans.
+ *
+ * A range with the same extent as an existing one is merged into it.  Any
+ * older range that lies inside the new one and whose settings are all
+ * replaced by it is dropped, so that restyling a moving range (for example,
+ * a highlight that follows the selection) does not grow the lists.
+ */
+void _Internal_QDataTableModel::addRangeStyle(int row1, int col1, int row2, int col2,
+                                              const CellStyle& style, long long stamp) {
+    auto first = _rangeRows.lower_bound(row1);
+    auto last = _rangeRows.upper_bound(row2);
+    if (first != last && first->first == row1) {
+        for (long long id : first->second) {
+            StyleRect& rect = _rangeStyles.find(id)->second;
+            if (rect.row1 == row1 && rect.col1 == col1 && rect.row2 == row2 && rect.col2 == col2) {
+                applyStyle(rect.layer, style, stamp);
+                return;
+            }
+        }
+    }
+
+    auto replaced = [row1, col1, row2, col2, &style](const StyleRect& old) {
+        return old.row1 >= row1 && old.row2 <= row2 && old.col1 >= col1 && old.col2 <= col2
+                && (old.layer.backgroundStamp == 0 || style.background >= 0)
+                && (old.layer.foregroundStamp == 0 || style.foreground >= 0)
+                && (old.layer.alignmentStamp == 0 || style.alignment >= 0)
+                && (old.layer.fontStamp == 0 || !style.font.empty());
+    };
+    std::vector<long long> dropped;
+    for (auto band = first; band != last; ++band) {
+        for (long long id : band->second) {
+            // look at each range only in the band where it starts
+            const StyleRect& old = _rangeStyles.find(id)->second;
+            if (old.row1 == band->first && replaced(old)) {
+                dropped.push_back(id);
+            }
+        }
+    }
+    for (long long id : dropped) {
+        removeRangeStyle(id);
+    }
+
+    StyleRect rect;
+    rect.row1 = row1;
+    rect.col1 = col1;
+    rect.row2 = row2;
+    rect.col2 = col2;
+    applyStyle(rect.layer, style, stamp);
+    _rangeStyles[stamp] = rect;
+    splitRangeRows(row1);
+    if (row2 < INT_MAX) {
+        splitRangeRows(row2 + 1);
+    }
+    last = _rangeRows.upper_bound(row2);
+    for (auto band = _rangeRows.find(row1); band != last; ++band) {
+        band->second.push_back(stamp);
+    }
+}
+
+/*
+ * Copies the settings made in the given style into the given layer,
+ * marking each with the given stamp.
+ */
+void _Internal_QDataTableModel::applyStyle(StyleLayer& layer, const CellStyle& style, long long stamp) {
+    if (style.background >= 0) {
+        layer.style.background = style.background;
+        layer.backgroundStamp = stamp;
+    }
+    if (style.foreground >= 0) {
+        layer.style.foreground = style.foreground;
+        layer.foregroundStamp = stamp;
+    }
+    if (style.alignment >= 0) {
+        layer.style.alignment = style.alignment;
+        layer.alignmentStamp = stamp;
+    }
+    if (!style.font.empty()) {
+        layer.style.font = style.font;
+        layer.fontStamp = stamp;
+    }
+}
+
+void _Internal_QDataTableModel::clearStyles() {
+    _tableStyle = StyleLayer();
+    _rowStyles.clear();
+    _columnStyles.clear();
+    _cellStyles.clear();
+    _rangeStyles.clear();
+    _rangeRows.clear();
+    _resolvedRow = -1;
+    emitCellsChanged(0, 0, INT_MAX, INT_MAX,
+                     {Qt::BackgroundRole, Qt::ForegroundRole, Qt::FontRole, Qt::TextAlignmentRole});
+}
+
+int _Internal_QDataTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : _columns;
+}
+
+/*
+ * Implementation notes: data
+ * --------------------------
+ * The view calls this only for the cells it is about to draw, once per
+ * role.  Text is converted to a QString and styles are resolved here,
+ * lazily, rather than when they are set.
+ */
+QVariant _Internal_QDataTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) {
+        return QVariant();
+    }
+    int row = index.row();
+    int column = index.column();
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return QVariant(QString::fromStdString(get(row, column)));
+    case Qt::BackgroundRole: {
+        int rgb = resolveStyle(row, column).background;
+        return rgb < 0 ? QVariant() : QVariant(QBrush(QColor(rgb)));
+    }
+    case Qt::ForegroundRole: {
+        int rgb = resolveStyle(row, column).foreground;
+        return rgb < 0 ? QVariant() : QVariant(QBrush(QColor(rgb)));
+    }
+    case Qt::FontRole: {
+        const std::string& font = resolveStyle(row, column).font;
+        return font.empty() ? QVariant() : QVariant(toFont(font));
+    }
+    case Qt::TextAlignmentRole: {
+        int alignment = resolveStyle(row, column).alignment;
+        if (alignment < 0) {
+            return QVariant();
+        }
+        Qt::Alignment align = Qt::AlignVCenter | toQtAlignment(static_cast<HorizontalAlignment>(alignment));
+        return QVariant(align);
+    }
+    default:
+        return QVariant();
+    }
+}
+
+void _Internal_QDataTableModel::emitCellsChanged(int row1, int col1, int row2, int col2,
+                                                 const QVector<int>& roles) {
+    row2 = std::min(row2, _rows - 1);
+    col2 = std::min(col2, _columns - 1);
+    if (row1 <= row2 && col1 <= col2) {
+        emit dataChanged(index(row1, col1), index(row2, col2), roles);
+    }
+}
+
+void _Internal_QDataTableModel::fill(const std::string& text) {
+    _cells.fill(text);
+    emitCellsChanged(0, 0, _rows - 1, _columns - 1, {Qt::DisplayRole, Qt::EditRole});
+}
+
+Qt::ItemFlags _Internal_QDataTableModel::flags(const QModelIndex& index) const {
+    Qt::ItemFlags flags = QAbstractTableModel::flags(index);
+    if (_editable && !_source) {
+        flags |= Qt::ItemIsEditable;
+    }
+    return flags;
+}
+
+std::string _Internal_QDataTableModel::get(int row, int column) const {
+    return _source ? _source(row, column) : _cells.get(row, column);
+}
+
+Grid<std::string> _Internal_QDataTableModel::getGrid() const {
+    if (!_source) {
+        return _cells;
+    }
+    Grid<std::string> result(_rows, _columns);
+    for (int row = 0; row < _rows; row++) {
+        for (int column = 0; column < _columns; column++) {
+            result.set(row, column, _source(row, column));
+        }
+    }
+    return result;
+}
+
+bool _Internal_QDataTableModel::hasDataSource() const {
+    return static_cast<bool>(_source);
+}
+
+QVariant _Internal_QDataTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    if (orientation == Qt::Horizontal && section < _columnHeaders.size()) {
+        return QVariant(QString::fromStdString(_columnHeaders[section]));
+    }
+    return QVariant(section + 1);
+}
+
+bool _Internal_QDataTableModel::isEditable() const {
+    return _editable && !_source;
+}
+
+/*
+ * Removes the band of _rangeRows that starts at the given row, if it is
+ * covered by the same ranges as the rows just above it.  No range starts
+ * at such a band.
+ */
+void _Internal_QDataTableModel::joinRangeRows(int row) {
+    auto band = _rangeRows.find(row);
+    if (band == _rangeRows.end()) {
+        return;
+    }
+    if (band == _rangeRows.begin() ? band->second.empty()
+                                   : std::prev(band)->second == band->second) {
+        _rangeRows.erase(band);
+    }
+}
+
+/*
+ * Takes each setting of the given layer that is more recent than the one
+ * in the result.
+ */
+void _Internal_QDataTableModel::mergeStyle(StyleLayer& result, const StyleLayer& layer) {
+    if (layer.backgroundStamp > result.backgroundStamp) {
+        result.style.background = layer.style.background;
+        result.backgroundStamp = layer.backgroundStamp;
+    }
+    if (layer.foregroundStamp > result.foregroundStamp) {
+        result.style.foreground = layer.style.foreground;
+        result.foregroundStamp = layer.foregroundStamp;
+    }
+    if (layer.alignmentStamp > result.alignmentStamp) {
+        result.style.alignment = layer.style.alignment;
+        result.alignmentStamp = layer.alignmentStamp;
+    }
+    if (layer.fontStamp > result.fontStamp) {
+        result.style.font = layer.style.font;
+        result.fontStamp = layer.fontStamp;
+    }
+}
+
+/*
+ * Removes the range with the given id from _rangeStyles and from the bands
+ * of _rangeRows that it covers, then joins the bands at its edges to their
+ * neighbors if they are no longer needed.
+ */
+void _Internal_QDataTableModel::removeRangeStyle(long long id) {
+    auto itr = _rangeStyles.find(id);
+    int row1 = itr->second.row1;
+    int row2 = itr->second.row2;
+    _rangeStyles.erase(itr);
+    auto last = _rangeRows.upper_bound(row2);
+    for (auto band = _rangeRows.find(row1); band != last; ++band) {
+        std::vector<long long>& ids = band->second;
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+    }
+    if (row2 < INT_MAX) {
+        joinRangeRows(row2 + 1);
+    }
+    joinRangeRows(row1);
+}
+
+void _Internal_QDataTableModel::resize(int rows, int columns) {
+    beginResetModel();
+    _cells.resize(rows, columns, /* retain */ true);
+    _rows = rows;
+    _columns = columns;
+    _resolvedRow = -1;
+    endResetModel();
+}
+
+/*
+ * Returns the style of the given cell, taking each setting from the most
+ * recent of the table, row, column, cell, and range styles that cover it.
+ */
+const _Internal_QDataTableModel::CellStyle& _Internal_QDataTableModel::resolveStyle(int row, int column) const {
+    if (row == _resolvedRow && column == _resolvedColumn) {
+        return _resolvedStyle;
+    }
+    StyleLayer result = _tableStyle;
+    auto rowItr = _rowStyles.find(row);
+    if (rowItr != _rowStyles.end()) {
+        mergeStyle(result, rowItr->second);
+    }
+    auto columnItr = _columnStyles.find(column);
+    if (columnItr != _columnStyles.end()) {
+        mergeStyle(result, columnItr->second);
+    }
+    auto cellItr = _cellStyles.find(cellKey(row, column));
+    if (cellItr != _cellStyles.end()) {
+        mergeStyle(result, cellItr->second);
+    }
+    auto band = _rangeRows.upper_bound(row);
+    if (band != _rangeRows.begin()) {
+        for (long long id : std::prev(band)->second) {
+            const StyleRect& rect = _rangeStyles.find(id)->second;
+            if (rect.col1 <= column && column <= rect.col2) {
+                mergeStyle(result, rect.layer);
+            }
+        }
+    }
+    _resolvedRow = row;
+    _resolvedColumn = column;
+    _resolvedStyle = result.style;
+    return _resolvedStyle;
+}
+
+int _Internal_QDataTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : _rows;
+}
+
+void _Internal_QDataTableModel::setBaseFont(const QFont& font) {
+    _baseFont = font;
+    _fontCache.clear();
+}
+
+void _Internal_QDataTableModel::setCell(int row, int column, const std::string& text) {
+    _cells.set(row, column, text);
+    emitCellsChanged(row, column, row, column, {Qt::DisplayRole, Qt::EditRole});
+}
+
+void _Internal_QDataTableModel::setColumnHeaders(const Vector<std::string>& headers) {
+    _columnHeaders = headers;
+    if (_columns > 0) {
+        emit headerDataChanged(Qt::Horizontal, 0, _columns - 1);
+    }
+}
+
+bool _Internal_QDataTableModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (!index.isValid() || role != Qt::EditRole || !isEditable()) {
+        return false;
+    }
+    setCell(index.row(), index.column(), value.toString().toStdString());
+    emit cellEdited(index.row(), index.column());
+    return true;
+}
+
+void _Internal_QDataTableModel::setDataSource(int rows, int columns, GDataTable::DataSource source) {
+    beginResetModel();
+    _cells.resize(0, 0);
+    _source = source;
+    _rows = rows;
+    _columns = columns;
+    _resolvedRow = -1;
+    endResetModel();
+}
+
+void _Internal_QDataTableModel::setEditable(bool editable) {
+    _editable = editable;
+}
+
+void _Internal_QDataTableModel::setGrid(const Grid<std::string>& data) {
+    beginResetModel();
+    _source = nullptr;
+    _cells = data;
+    _rows = data.numRows();
+    _columns = data.numCols();
+    _resolvedRow = -1;
+    endResetModel();
+}
+
+void _Internal_QDataTableModel::setRange(int row, int column, const Grid<std::string>& values) {
+    int rowEnd = std::min(_rows, row + values.numRows());
+    int colEnd = std::min(_columns, column + values.numCols());
+    for (int r = row; r < rowEnd; r++) {
+        for (int c = column; c < colEnd; c++) {
+            _cells.set(r, c, values.get(r - row, c - column));
+        }
+    }
+    emitCellsChanged(row, column, rowEnd - 1, colEnd - 1, {Qt::DisplayRole, Qt::EditRole});
+}
+
+void _Internal_QDataTableModel::setRow(int row, const Vector<std::string>& values) {
+    int colEnd = std::min(_columns, values.size());
+    for (int c = 0; c < colEnd; c++) {
+        _cells.set(row, c, values[c]);
+    }
+    emitCellsChanged(row, 0, row, colEnd - 1, {Qt::DisplayRole, Qt::EditRole});
+}
+
+/*
+ * Makes a band of _rangeRows start at the given row, covered by the same
+ * ranges as the rows just above it.
+ */
+void _Internal_QDataTableModel::splitRangeRows(int row) {
+    auto next = _rangeRows.upper_bound(row);
+    if (next == _rangeRows.begin()) {
+        _rangeRows.emplace_hint(next, row, std::vector<long long>());
+    } else if (std::prev(next)->first != row) {
+        std::vector<long long> ids = std::prev(next)->second;
+        _rangeRows.emplace_hint(next, row, ids);
+    }
+}
+
+QFont _Internal_QDataTableModel::toFont(const std::string& font) const {
+    auto itr = _fontCache.find(font);
+    if (itr == _fontCache.end()) {
+        itr = _fontCache.emplace(font, GFont::toQFont(_baseFont, font)).first;
+    }
+    return itr->second;
+}
+
+
+_Internal_QDataTableView::_Internal_QDataTableView(GDataTable* gtable, _Internal_QDataTableModel* model, QWidget* parent)
+        : QTableView(parent),
+          _gtable(gtable) {
+    require::nonNull(gtable, "_Internal_QDataTableView::constructor");
+    require::nonNull(model, "_Internal_QDataTableView::constructor", "model");
+    setObjectName(QString::fromStdString("_Internal_QDataTableView_" + std::to_string(gtable->getID())));
+    setModel(model);
+    setSelectionMode(QAbstractItemView::SingleSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    horizontalHeader()->setStretchLastSection(true);
+
+    // rows all have the same height, so the view never has to measure them
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    connect(model, SIGNAL(cellEdited(int, int)), this, SLOT(handleCellEdit(int, int)));
+    connect(this->selectionModel(), SIGNAL(selectionChanged(const QItemSelection&, const QItemSelection&)), this, SLOT(handleSelectionChange(const QItemSelection&, const QItemSelection&)));
+}
+
+void _Internal_QDataTableView::detach() {
+    _gtable = nullptr;
+}
+
+void _Internal_QDataTableView::fireTableEvent(EventType eventType, const std::string& eventName, int row, int col) {
+    if (!_gtable) {
+        return;
+    }
+    GEvent tableEvent(
+                /* class  */ TABLE_EVENT,
+                /* type   */ eventType,
+                /* name   */ eventName,
+                /* source */ _gtable);
+    tableEvent.setRowAndColumn(row, col);
+    tableEvent.setActionCommand(_gtable->getActionCommand());
+    _gtable->fireEvent(tableEvent);
+}
+
+void _Internal_QDataTableView::handleCellEdit(int row, int column) {
+    if (!_gtable) {
+        return;
+    }
+    fireTableEvent(TABLE_UPDATED, "tableupdate", row, column);
+}
+
+void _Internal_QDataTableView::handleSelectionChange(const QItemSelection& selected, const QItemSelection& /*deselected*/) {
+    if (!_gtable) {
+        return;
+    }
+    if (!selected.empty()) {
+        QModelIndex index = selected.at(0).topLeft();
+        fireTableEvent(TABLE_SELECTED, "tableselect", index.row(), index.column());
+    }
+}
+
+QSize _Internal_QDataTableView::sizeHint() const {
+    if (hasPreferredSize()) {
+        return getPreferredSize();
+    } else {
+        return QTableView::sizeHint();
+    }
+}
@@ -0,0 +1,616 @@
+/*
+ * File: gdatatable.h
+ * ------------------
+ * This file exports the GDataTable class, a graphical 2D table that displays
+ * large amounts of data by keeping it in a model rather than in one widget
+ * item per cell.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+
+#ifndef _gdatatable_h
+#define _gdatatable_h
+
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QAbstractTableModel>
+#include <QFont>
+#include <QItemSelection>
+#include <QTableView>
+
+#include "grid.h"
+#include "vector.h"
+#include "ginteractor.h"
+#include "gtypes.h"
+
+class _Internal_QDataTableModel;
+class _Internal_QDataTableView;
+
+/**
+ * A GDataTable displays a 2D table of text, like GTable, but is meant for
+ * tables with many thousands or millions of cells, such as the results of
+ * a query or the contents of a large data file.
+ *
+ * A GTable creates a separate widget item for every cell, and each call to
+ * set or to a formatting method is a separate trip to the Qt GUI thread.
+ * A GDataTable instead stores its text in a single Grid that the on-screen
+ * view reads from as it draws, so only the cells that are actually visible
+ * are ever looked at.
+ * Its batch methods (setData, setRange, setRow, fill, and the setRange...
+ * formatting methods) change any number of cells with one trip to the GUI
+ * thread and one repaint.
+ *
+ * Alternatively, a table can be given a data source function with
+ * setDataSource; the function is called to produce the text of each cell
+ * only when that cell is displayed, so the table need not store its data
+ * at all.  Such a table is read-only.
+ *
+ * Formatting (colors, fonts, alignment) can be applied to single cells,
+ * rows, columns, rectangular ranges, or the whole table, and is stored by
+ * cell, row, or column rather than for every cell.  A cell's formatting is
+ * worked out only when the cell is drawn.  When several calls format the
+ * same cell, the most recent call wins.
+ *
+ * A GDataTable sends the same table events as a GTable when the user
+ * selects or edits a cell; see setTableListener.
+ *
+ * All row/column indexes in this class are 0-based.
+ */
+class GDataTable : public GInteractor {
+public:
+    /**
+     * The type of a function that produces the text of the cell at the
+     * given row and column.  See setDataSource.
+     */
+    typedef std::function<std::string(int row, int column)> DataSource;
+
+    /**
+     * Constructs a new table with the given dimensions and (optionally) size.
+     * Every cell is initially empty.
+     * @throw ErrorException if the number of rows, columns, width, or height is negative.
+     */
+    GDataTable(int rows = 0, int columns = 0, double width = 0, double height = 0,
+               QWidget* parent = nullptr);
+
+    /**
+     * Constructs a new table holding a copy of the given data.
+     */
+    GDataTable(const Grid<std::string>& data, double width = 0, double height = 0,
+               QWidget* parent = nullptr);
+
+    ~GDataTable() override;
+
+    /**
+     * Changes widths of all columns to fit their contents.
+     * For large tables, only a sample of the rows is measured.
+     */
+    virtual void autofitColumnWidths();
+
+    /**
+     * Sets every cell in the table to the empty string.
+     * If the table has a data source, it is removed and the table keeps
+     * its dimensions.
+     */
+    virtual void clear();
+
+    /**
+     * Removes all formatting from every cell, returning them to the table's
+     * default colors, font, and alignment.
+     */
+    virtual void clearFormatting();
+
+    /**
+     * Deselects any currently selected cell.
+     */
+    virtual void clearSelection();
+
+    /**
+     * Sets every cell in the table to store the given text.
+     * @throw ErrorException if the table has a data source
+     */
+    virtual void fill(const std::string& text);
+
+    /**
+     * Returns the text stored in the given cell.
+     * If the table has a data source, the data source is called to get it.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual std::string get(int row, int column) const;
+
+    /**
+     * Returns a copy of the text of every cell in the table.
+     * If the table has a data source, the data source is called once per cell.
+     */
+    virtual Grid<std::string> getData() const;
+
+    /* @inherit */
+    _Internal_QWidget* getInternalWidget() const override;
+
+    /**
+     * Returns the row and column of the currently selected cell,
+     * or (-1, -1) if no cell is selected.
+     */
+    virtual GridLocation getSelectedCell() const;
+
+    /**
+     * Returns the column of the currently selected cell, or -1 if none.
+     */
+    virtual int getSelectedColumn() const;
+
+    /**
+     * Returns the row of the currently selected cell, or -1 if none.
+     */
+    virtual int getSelectedRow() const;
+
+    /* @inherit */
+    std::string getType() const override;
+
+    /* @inherit */
+    QWidget* getWidget() const override;
+
+    /**
+     * Returns true if the table's cells come from a data source function
+     * rather than from stored text.
+     */
+    virtual bool hasDataSource() const;
+
+    /**
+     * Returns true if a cell is currently selected.
+     */
+    virtual bool hasSelectedCell() const;
+
+    /**
+     * Returns true if the given 0-based row/column index is within the
+     * bounds of the table.
+     */
+    virtual bool inTableBounds(int row, int column) const;
+
+    /**
+     * Returns true if the user can edit cells by typing into them.
+     * Initially false.
+     */
+    virtual bool isEditable() const;
+
+    /**
+     * Returns the number of columns in the table.
+     */
+    virtual int numCols() const;
+
+    /**
+     * Returns the number of rows in the table.
+     */
+    virtual int numRows() const;
+
+    /**
+     * Removes the table listener from this table so that it will no longer
+     * call it when events occur.
+     */
+    virtual void removeTableListener();
+
+    /**
+     * Modifies the table to have the given number of rows and columns.
+     * Existing text is kept where it still fits, and new cells are empty.
+     * Row, column, and whole-table formatting applies to the new cells.
+     * @throw ErrorException if the number of rows or columns is negative,
+     *        or if the table has a data source
+     */
+    virtual void resize(int numRows, int numCols);
+
+    /**
+     * Sets the given cell to become currently selected,
+     * replacing any previous selection, and scrolls it into view.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual void select(int row, int column);
+
+    /**
+     * Modifies the text in the given cell.
+     * To change many cells, setRange, setRow, or setData is much faster
+     * than calling this method once per cell.
+     * @throw ErrorException if the given row or column are out of bounds,
+     *        or if the table has a data source
+     */
+    virtual void set(int row, int column, const std::string& text);
+
+    /* @inherit */
+    void setBackground(int rgb) override;
+
+    /* @inherit */
+    void setBackground(const std::string& color) override;
+
+    /**
+     * Sets the horizontal alignment of the text in the given cell.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual void setCellAlignment(int row, int column, HorizontalAlignment alignment);
+
+    /**
+     * Sets the background color of the given cell.
+     * See gcolor.h for more detail about colors.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual void setCellBackground(int row, int column, int rgb);
+
+    /**
+     * Sets the background color of the given cell.
+     * See gcolor.h for more detail about colors.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual void setCellBackground(int row, int column, const std::string& color);
+
+    /**
+     * Sets the font of the text in the given cell.
+     * See gfont.h for more detail about fonts.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual void setCellFont(int row, int column, const std::string& font);
+
+    /**
+     * Sets the text color of the given cell.
+     * See gcolor.h for more detail about colors.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual void setCellForeground(int row, int column, int rgb);
+
+    /**
+     * Sets the text color of the given cell.
+     * See gcolor.h for more detail about colors.
+     * @throw ErrorException if the given row or column are out of bounds
+     */
+    virtual void setCellForeground(int row, int column, const std::string& color);
+
+    /* @inherit */
+    void setColor(int rgb) override;
+
+    /* @inherit */
+    void setColor(const std::string& color) override;
+
+    /**
+     * Sets the background color of every cell in the given column,
+     * including cells added to it later.
+     * @throw ErrorException if the given column is out of bounds
+     */
+    virtual void setColumnBackground(int column, int rgb);
+
+    /**
+     * Sets the background color of every cell in the given column,
+     * including cells added to it later.
+     * @throw ErrorException if the given column is out of bounds
+     */
+    virtual void setColumnBackground(int column, const std::string& color);
+
+    /**
+     * Sets the text color of every cell in the given column,
+     * including cells added to it later.
+     * @throw ErrorException if the given column is out of bounds
+     */
+    virtual void setColumnForeground(int column, int rgb);
+
+    /**
+     * Sets the text color of every cell in the given column,
+     * including cells added to it later.
+     * @throw ErrorException if the given column is out of bounds
+     */
+    virtual void setColumnForeground(int column, const std::string& color);
+
+    /**
+     * Sets the labels shown above each column.
+     * Columns past the end of the given list are labeled with their
+     * 1-based column number.
+     * Passing an empty list returns all columns to numbered labels.
+     */
+    virtual void setColumnHeaders(const Vector<std::string>& headers);
+
+    /**
+     * Sets the width of the given column, in pixels.
+     * @throw ErrorException if the given column is out of bounds
+     *        or the width is negative
+     */
+    virtual void setColumnWidth(int column, double width);
+
+    /**
+     * Replaces the table's dimensions and the text of every cell with the
+     * given grid, in a single update.
+     * Any data source is removed.
+     * Formatting is kept.
+     */
+    virtual void setData(const Grid<std::string>& data);
+
+    /**
+     * Makes the table get the text of its cells from the given function,
+     * which is called with a cell's row and column whenever that cell is
+     * displayed or passed to get.
+     * The function is always called on the Qt GUI thread, and it should be
+     * fast since it is called during painting.
+     * The table becomes read-only.
+     * Call clear or setData to go back to storing text in the table.
+     * @throw ErrorException if the number of rows or columns is negative
+     */
+    virtual void setDataSource(int rows, int columns, DataSource source);
+
+    /**
+     * Sets whether the user can edit cells by typing into them.
+     * Tables with a data source are never editable.
+     */
+    virtual void setEditable(bool editable);
+
+    /* @inherit */
+    void setFont(const QFont& font) override;
+
+    /* @inherit */
+    void setFont(const std::string& font) override;
+
+    /* @inherit */
+    void setForeground(int rgb) override;
+
+    /* @inherit */
+    void setForeground(const std::string& color) override;
+
+    /**
+     * Sets the horizontal alignment of the text in every cell.
+     */
+    virtual void setHorizontalAlignment(HorizontalAlignment alignment);
+
+    /**
+     * Copies the given grid of text into the rectangle of cells whose
+     * top-left corner is at the given row and column, in a single update.
+     * Parts of the grid that fall outside the table are ignored.
+     * @throw ErrorException if the given row or column are out of bounds,
+     *        or if the table has a data source
+     */
+    virtual void setRange(int row, int column, const Grid<std::string>& values);
+
+    /**
+     * Sets the horizontal alignment of the text in every cell in the
+     * rectangle with the given top-left cell and number of rows and columns.
+     * @throw ErrorException if the range does not fit in the table
+     */
+    virtual void setRangeAlignment(int row, int column, int rows, int columns,
+                                   HorizontalAlignment alignment);
+
+    /**
+     * Sets the background color of every cell in the rectangle with the given
+     * top-left cell and number of rows and columns.
+     * @throw ErrorException if the range does not fit in the table
+     */
+    virtual void setRangeBackground(int row, int column, int rows, int columns, int rgb);
+
+    /**
+     * Sets the background color of every cell in the rectangle with the given
+     * top-left cell and number of rows and columns.
+     * @throw ErrorException if the range does not fit in the table
+     */
+    virtual void setRangeBackground(int row, int column, int rows, int columns,
+                                    const std::string& color);
+
+    /**
+     * Sets the font of every cell in the rectangle with the given
+     * top-left cell and number of rows and columns.
+     * @throw ErrorException if the range does not fit in the table
+     */
+    virtual void setRangeFont(int row, int column, int rows, int columns,
+                              const std::string& font);
+
+    /**
+     * Sets the text color of every cell in the rectangle with the given
+     * top-left cell and number of rows and columns.
+     * @throw ErrorException if the range does not fit in the table
+     */
+    virtual void setRangeForeground(int row, int column, int rows, int columns, int rgb);
+
+    /**
+     * Sets the text color of every cell in the rectangle with the given
+     * top-left cell and number of rows and columns.
+     * @throw ErrorException if the range does not fit in the table
+     */
+    virtual void setRangeForeground(int row, int column, int rows, int columns,
+                                    const std::string& color);
+
+    /**
+     * Copies the given values into the cells of the given row, starting at
+     * column 0, in a single update.
+     * Values past the last column are ignored.
+     * @throw ErrorException if the given row is out of bounds,
+     *        or if the table has a data source
+     */
+    virtual void setRow(int row, const Vector<std::string>& values);
+
+    /**
+     * Sets the background color of every cell in the given row,
+     * including cells added to it later.
+     * @throw ErrorException if the given row is out of bounds
+     */
+    virtual void setRowBackground(int row, int rgb);
+
+    /**
+     * Sets the background color of every cell in the given row,
+     * including cells added to it later.
+     * @throw ErrorException if the given row is out of bounds
+     */
+    virtual void setRowBackground(int row, const std::string& color);
+
+    /**
+     * Sets whether the row and column labels are shown.
+     * Initially true.
+     */
+    virtual void setRowColumnHeadersVisible(bool visible);
+
+    /**
+     * Sets the text color of every cell in the given row,
+     * including cells added to it later.
+     * @throw ErrorException if the given row is out of bounds
+     */
+    virtual void setRowForeground(int row, int rgb);
+
+    /**
+     * Sets the text color of every cell in the given row,
+     * including cells added to it later.
+     * @throw ErrorException if the given row is out of bounds
+     */
+    virtual void setRowForeground(int row, const std::string& color);
+
+    /**
+     * Sets a table listener on this table so that it will be called
+     * when the user selects or edits a cell.
+     * Any existing table listener will be replaced.
+     */
+    virtual void setTableListener(GEventListener func);
+
+    /**
+     * Sets a table listener on this table so that it will be called
+     * when the user selects or edits a cell.
+     * Any existing table listener will be replaced.
+     */
+    virtual void setTableListener(GEventListenerVoid func);
+
+private:
+    _Internal_QDataTableView* _iqtableview;
+    _Internal_QDataTableModel* _model;
+
+    void checkColumn(const std::string& member, int column) const;
+    void checkIndex(const std::string& member, int row, int column) const;
+    void checkRange(const std::string& member, int row, int column, int rows, int columns) const;
+    void checkRow(const std::string& member, int row) const;
+    void checkWritable(const std::string& member) const;
+
+    friend class _Internal_QDataTableView;
+};
+
+
+/**
+ * Internal class; not to be used by clients.
+ * Holds a GDataTable's text and formatting and hands them to the view one
+ * cell at a time.  Must only be modified on the Qt GUI thread.
+ * @private
+ */
+class _Internal_QDataTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    /*
+     * Formatting set on a range of cells.  Unset colors and alignments
+     * are -1, and an unset font is "".
+     */
+    struct CellStyle {
+        int background = -1;
+        int foreground = -1;
+        int alignment = -1;
+        std::string font;
+    };
+
+    _Internal_QDataTableModel(QObject* parent = nullptr);
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+    virtual void addStyle(int row, int column, int rows, int columns, const CellStyle& style);
+    virtual void clearStyles();
+    virtual void fill(const std::string& text);
+    virtual std::string get(int row, int column) const;
+    virtual Grid<std::string> getGrid() const;
+    virtual bool hasDataSource() const;
+    virtual bool isEditable() const;
+    virtual void resize(int rows, int columns);
+    virtual void setBaseFont(const QFont& font);
+    virtual void setCell(int row, int column, const std::string& text);
+    virtual void setColumnHeaders(const Vector<std::string>& headers);
+    virtual void setDataSource(int rows, int columns, GDataTable::DataSource source);
+    virtual void setEditable(bool editable);
+    virtual void setGrid(const Grid<std::string>& data);
+    virtual void setRange(int row, int column, const Grid<std::string>& values);
+    virtual void setRow(int row, const Vector<std::string>& values);
+
+signals:
+    /* Emitted when the user (rather than the program) changes a cell. */
+    void cellEdited(int row, int column);
+
+private:
+    /*
+     * The formatting set on one cell, row, column, or range, along with
+     * when each of its settings was made, so that the most recent setting
+     * for a cell can be found among all of the ones that cover it.
+     * A stamp of 0 means the setting was never made.
+     */
+    struct StyleLayer {
+        CellStyle style;
+        long long backgroundStamp = 0;
+        long long foregroundStamp = 0;
+        long long alignmentStamp = 0;
+        long long fontStamp = 0;
+    };
+
+    /* A style applied to the cells [row1, row2] x [col1, col2]. */
+    struct StyleRect {
+        int row1;
+        int col1;
+        int row2;
+        int col2;
+        StyleLayer layer;
+    };
+
+    static void applyStyle(StyleLayer& layer, const CellStyle& style, long long stamp);
+    static void mergeStyle(StyleLayer& result, const StyleLayer& layer);
+    void addRangeStyle(int row1, int col1, int row2, int col2, const CellStyle& style, long long stamp);
+    void emitCellsChanged(int row1, int col1, int row2, int col2, const QVector<int>& roles);
+    void joinRangeRows(int row);
+    void removeRangeStyle(long long id);
+    const CellStyle& resolveStyle(int row, int column) const;
+    void splitRangeRows(int row);
+    QFont toFont(const std::string& font) const;
+
+    Grid<std::string> _cells;
+    GDataTable::DataSource _source;
+    int _rows;
+    int _columns;
+    bool _editable;
+    Vector<std::string> _columnHeaders;
+    long long _styleCount;                                // stamp of the latest style
+    StyleLayer _tableStyle;                               // set on the whole table
+    std::unordered_map<int, StyleLayer> _rowStyles;       // set on whole rows
+    std::unordered_map<int, StyleLayer> _columnStyles;    // set on whole columns
+    std::unordered_map<long long, StyleLayer> _cellStyles;       // set on single cells
+    std::unordered_map<long long, StyleRect> _rangeStyles;       // other ranges, by id
+    std::map<int, std::vector<long long>> _rangeRows;  // ids of ranges covering rows [key, next key)
+    QFont _baseFont;
+    mutable std::unordered_map<std::string, QFont> _fontCache;
+
+    // the view asks for each role of a cell separately, so the most recently
+    // resolved style is remembered
+    mutable int _resolvedRow;
+    mutable int _resolvedColumn;
+    mutable CellStyle _resolvedStyle;
+};
+
+
+/**
+ * Internal class; not to be used by clients.
+ * @private
+ */
+class _Internal_QDataTableView : public QTableView, public _Internal_QWidget {
+    Q_OBJECT
+
+public:
+    _Internal_QDataTableView(GDataTable* gtable, _Internal_QDataTableModel* model, QWidget* parent = nullptr);
+    void detach() override;
+    QSize sizeHint() const override;
+
+public slots:
+    void handleCellEdit(int row, int column);
+    void handleSelectionChange(const QItemSelection& selected, const QItemSelection& deselected);
+
+private:
+    GDataTable* _gtable;
+
+    void fireTableEvent(EventType eventType, const std::string& eventName, int row, int col);
+};
+
+#endif // _gdatatable_h
@@ -3,6 +3,8 @@
  * --------------------
  * 
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - highlighted diffs are computed a scanline at a time by diffImages
  * @version 2019/04/23
  * - can press Escape key to close window
  * @version 2018/10/12
@@ -19,6 +21,7 @@
 #include "gcolor.h"
 #include "gcolorchooser.h"
 #include "gfont.h"
+#include "gimagediff.h"
 #include "gspacer.h"
 #include "gthread.h"
 #include "require.h"
@@ -183,31 +186,26 @@ void GDiffImage::drawImages() {
     if (_highlightDiffsBox->isChecked()) {
         GThread::runOnQtGuiThreadAsync([this]() {
             // draw the highlighted diffs (if so desired)
-            int w1 = _image1->getWidth();
-            int h1 = _image1->getHeight();
-            int w2 = _image2->getWidth();
-            int h2 = _image2->getHeight();
-
-            int wmax = std::max(w1, w2);
-            int hmax = std::max(h1, h2);
+            int wmax = static_cast<int>(std::max(_image1->getWidth(), _image2->getWidth()));
+            int hmax = static_cast<int>(std::max(_image1->getHeight(), _image2->getHeight()));
 
             if (!_imageDiffs) {
                 _imageDiffs = new GImage(wmax, hmax);
             }
-            QImage* imgDiff = _imageDiffs->getQImage();
-
-            // check each pair of pixels
-            // (access raw QImages for speed)
-            int highlightColor = GColor::convertColorToRGB(_highlightColor) | 0xff000000;
-            QImage* img1 = _image1->getQImage();
-            QImage* img2 = _image2->getQImage();
-            for (int y = 0; y < hmax; y++) {
-                for (int x = 0; x < wmax; x++) {
-                    int pixel1 = (x < w1 && y < h1) ? (img1->pixel(x, y) & 0xffffffff) : 0;
-                    int pixel2 = (x < w2 && y < h2) ? (img2->pixel(x, y) & 0xffffffff) : 0;
-                    imgDiff->setPixel(x, y, (pixel1 == pixel2) ? pixel1 : highlightColor);
-                }
-            }
+            // pixels that match show image 1; all others are highlighted
+            unsigned int highlightColor = static_cast<unsigned int>(
+                    GColor::convertColorToRGB(_highlightColor)) | 0xff000000;
+            ImageDiffOptions options;
+            options.compareAlpha = true;
+            _image1->readPixels([this, &options, highlightColor](const PixelView& pixels1) {
+                _image2->readPixels([this, &options, highlightColor, &pixels1](const PixelView& pixels2) {
+                    _imageDiffs->editPixels([&options, highlightColor, &pixels1, &pixels2](PixelView& diffs) {
+                        diffs.fill(0);
+                        diffs.copyFrom(pixels1);
+                        diffImages(pixels1, pixels2, options, &diffs, highlightColor);
+                    });
+                });
+            });
             _window->draw(_imageDiffs);
         });
     } else {
@@ -5,6 +5,12 @@
  * See the .h file for the declarations of each member and comments.
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - downloads are read from the reply as data arrives (readyRead) into a
+ *   bounded buffer, which openStream/readStream expose directly
+ * - waitForDownload blocks on a condition variable instead of polling
+ * - requests go through one shared QNetworkAccessManager
+ * - added downloadAll and the ETag response cache
  * @version 2018/09/23
  * - added macro checks to improve compatibility with old Qt versions
  * @version 2018/09/18
@@ -16,22 +22,132 @@
  */
 
 #include "gdownloader.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <sstream>
 #include <QtGlobal>
 #include <QFile>
+#include <QSaveFile>
 #include <QIODevice>
 #include <QTimer>
 #include "error.h"
+#include "filelib.h"
 #include "gthread.h"
 
 static int _sslSupported = -1;
 
+/*
+ * The state of one call to downloadAll, shared by the handlers of its
+ * replies and freed when the last of them has finished.  The finished
+ * function is what hands each response back to the client's thread;
+ * everything else is used only on the Qt GUI thread.
+ */
+struct GDownloader::Batch {
+    Vector<std::string> urls;
+    Map<std::string, std::string> headers;
+    std::string cacheDirectory;
+    int maxParallel;
+    int maxPerHost;
+    std::deque<int> waiting;                // indexes of the URLs not yet started
+    int active;
+    std::map<std::string, int> activePerHost;
+    std::function<void (int index, Response& response)> finished;
+};
+
+namespace {
+/*
+ * Returns the name of the file in which the response for the given URL is
+ * cached.  The name is a 64-bit FNV-1a hash of the URL; the URL itself is
+ * stored in the file to guard against collisions.
+ */
+std::string cacheFilename(const std::string& directory, const std::string& url) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char ch : url) {
+        hash = (hash ^ ch) * 1099511628211ull;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.cache", static_cast<unsigned long long>(hash));
+    return directory + "/" + name;
+}
+
+/*
+ * Reads the cached ETag and, if body is not null, the cached body for the
+ * given URL.  A cache file holds the URL and the ETag on lines of their
+ * own, followed by the body; only those two lines are read if the body is
+ * not wanted.  Returns false if there is no entry.
+ */
+bool readCacheEntry(const std::string& directory, const std::string& url,
+                    std::string& etag, std::string* body) {
+    std::ifstream input(cacheFilename(directory, url), std::ios::binary);
+    std::string cachedUrl;
+    std::string cachedEtag;
+    if (!std::getline(input, cachedUrl) || cachedUrl != url
+            || !std::getline(input, cachedEtag) || input.eof()) {
+        return false;
+    }
+    etag = cachedEtag;
+    if (body) {
+        std::ostringstream rest;
+        rest << input.rdbuf();
+        *body = rest.str();
+    }
+    return true;
+}
+
+/*
+ * Writes the cache entry for the given URL.  QSaveFile writes a temporary
+ * file and renames it over the old entry only once it is complete, so a
+ * failed write never leaves a truncated entry behind.
+ */
+void writeCacheEntry(const std::string& directory, const std::string& url,
+                     const std::string& etag, const QByteArray& body) {
+    QSaveFile output(QString::fromStdString(cacheFilename(directory, url)));
+    if (!output.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    output.write(QByteArray::fromStdString(url + '\n' + etag + '\n'));
+    output.write(body);
+    output.commit();
+}
+
+std::string hostOf(const std::string& url) {
+    return QUrl(QString::fromStdString(url)).host().toStdString();
+}
+
+/*
+ * Returns true if the URL is an https: URL that cannot be fetched because
+ * there is no SSL support.  Such a download is a lose, so don't even try.
+ */
+bool isUnreachableSecureUrl(const std::string& url) {
+    return !_sslSupported && url.compare(0, 6, "https:") == 0;
+}
+
+std::string noSslMessage(const std::string& url) {
+    return "No ssl support, unable to fetch secure url " + url;
+}
+}
+
+bool GDownloader::Response::hasError() const {
+    return !errorMessage.empty()
+            || (!fromCache && (httpStatusCode < 200 || httpStatusCode > 299));
+}
+
 GDownloader::GDownloader()
         : _manager(nullptr),
           _reply(nullptr),
           _httpStatusCode(0),
-          _downloadComplete(false) {
+          _downloadComplete(false),
+          _networkError(false),
+          _maxPerHost(DEFAULT_MAX_PER_HOST),
+          _streamBuffered(0),
+          _streamCapacity(DEFAULT_STREAM_BUFFER_SIZE),
+          _streamStalled(false),
+          _headersReceived(false),
+          _streamStarted(false) {
             if (_sslSupported == -1) {
                 GThread::runOnQtGuiThreadAsync([]() {
                     _sslSupported = QSslSocket::supportsSsl();
@@ -40,21 +156,120 @@ GDownloader::GDownloader()
 }
 
 GDownloader::~GDownloader() {
-    // TODO: delete
+    // stop any download in progress; this also waits for any pending
+    // readStream refill to run, since it refers to this object
+    if (_streamStarted) {
+        closeStream();
+    }
+    // the manager is shared by all downloaders and is not deleted
     _manager = nullptr;
     _reply = nullptr;
 }
 
+void GDownloader::closeStream() {
+    if (!_streamStarted) {
+        return;
+    }
+    GThread::runOnQtGuiThread([this]() {
+        if (_reply) {
+            QObject::disconnect(_reply, nullptr, _reply, nullptr);
+            _reply->abort();
+            _reply->deleteLater();
+            _reply = nullptr;
+        }
+    });
+    std::lock_guard<std::mutex> guard(_streamLock);
+    _streamChunks.clear();
+    _streamBuffered = 0;
+    _streamStalled = false;
+    _headersReceived = true;
+    _downloadComplete = true;
+    _streamChanged.notify_all();
+}
+
+/*
+ * Copies what the downloads need from this downloader, so that they can
+ * go on after it has been destroyed.
+ */
+std::shared_ptr<GDownloader::Batch> GDownloader::createBatch(
+        const Vector<std::string>& urls, int maxParallel,
+        const std::function<void (int index, Response& response)>& finished) {
+    if (maxParallel <= 0) {
+        error("GDownloader::downloadAll: maxParallel must be positive");
+    }
+    std::shared_ptr<Batch> batch(new Batch());
+    batch->urls = urls;
+    batch->headers = _headers;
+    batch->cacheDirectory = _cacheDirectory;
+    batch->maxParallel = maxParallel;
+    batch->maxPerHost = _maxPerHost;
+    batch->active = 0;
+    batch->finished = finished;
+    for (int i = 0; i < urls.size(); i++) {
+        batch->waiting.push_back(i);
+    }
+    return batch;
+}
+
+std::vector<std::future<GDownloader::Response>> GDownloader::downloadAll(
+        const Vector<std::string>& urls, int maxParallel) {
+    std::shared_ptr<std::vector<std::promise<Response>>> promises(
+                new std::vector<std::promise<Response>>(urls.size()));
+    std::vector<std::future<Response>> futures;
+    for (std::promise<Response>& promise : *promises) {
+        futures.push_back(promise.get_future());
+    }
+    std::shared_ptr<Batch> batch = createBatch(urls, maxParallel,
+            [promises](int index, Response& response) {
+        (*promises)[index].set_value(std::move(response));
+    });
+    GThread::runOnQtGuiThreadAsync([batch]() {
+        startBatchDownloads(batch);
+    });
+    return futures;
+}
+
+void GDownloader::downloadAll(const Vector<std::string>& urls,
+                              const std::function<void (const Response& response)>& callback,
+                              int maxParallel) {
+    // shared with the GUI thread, which may still be notifying after we return
+    struct Finished {
+        std::mutex lock;
+        std::condition_variable changed;
+        std::deque<Response> responses;
+    };
+    std::shared_ptr<Finished> finished(new Finished());
+    std::shared_ptr<Batch> batch = createBatch(urls, maxParallel,
+            [finished](int /*index*/, Response& response) {
+        std::lock_guard<std::mutex> guard(finished->lock);
+        finished->responses.push_back(std::move(response));
+        finished->changed.notify_one();
+    });
+    GThread::runOnQtGuiThreadAsync([batch]() {
+        startBatchDownloads(batch);
+    });
+    for (int i = 0; i < urls.size(); i++) {
+        Response response;
+        {
+            std::unique_lock<std::mutex> lock(finished->lock);
+            finished->changed.wait(lock, [&finished]() {
+                return !finished->responses.empty();
+            });
+            response = std::move(finished->responses.front());
+            finished->responses.pop_front();
+        }
+        callback(response);
+    }
+}
+
 std::string GDownloader::downloadAsString(const std::string& url) {
     _url = url;
     _filename = "";
-    _httpStatusCode = 0;
-    _lastErrorMessage = "";
 
-    // download the file on gui thread and block/wait for it to finish
+    // start the download on gui thread and wait for its headers
     downloadInternal();
 
-    // save download to string
+    // save download to string as it arrives
     saveDownloadedData("downloadAsString");
 
     // return downloaded text as string (saved in member variable)
@@ -64,36 +279,53 @@ std::string GDownloader::downloadAsString(const std::string& url) {
 void GDownloader::downloadToFile(const std::string& url, const std::string& file) {
     _url = url;
     _filename = file;
-    _httpStatusCode = 0;
-    _lastErrorMessage = "";
 
-    // download the file on gui thread and block/wait for it to finish
+    // start the download on gui thread and wait for its headers
     downloadInternal();
 
-    // write to file
+    // write to file as it arrives
     saveDownloadedData("downloadToFile", file);
 }
 
+/*
+ * Starts the request on the Qt GUI thread and waits for its headers.
+ * The reply's signals are handled by lambdas whose context is the reply
+ * itself, so they run on the GUI thread and end when the reply is deleted.
+ */
 void GDownloader::downloadInternal() {
+    closeStream();
+    _httpStatusCode = 0;
+    _lastErrorMessage = "";
+    _networkError = false;
+    _streamChunks.clear();
+    _streamBuffered = 0;
+    _streamStalled = false;
+    _headersReceived = false;
+    _downloadComplete = false;
+    _streamStarted = true;
+
     // Cheezy check
-    // Access https: url if no SSL support present is a lose, so don't even try
-    if (!_sslSupported && _url.compare(0, 6, "https:") == 0) {
+    if (isUnreachableSecureUrl(_url)) {
         reportNoSSL();
         return;
     }
 
     GThread::runOnQtGuiThreadAsync([this]() {
 
-        if (!_manager) {
-            _manager = new QNetworkAccessManager();
-        }
-        QNetworkRequest* request = new QNetworkRequest(QUrl(QString::fromStdString(_url)));
+        _manager = getSharedManager();
+        QNetworkRequest request(QUrl(QString::fromStdString(_url)));
 
         for (std::string headerKey : _headers) {
-            request->setRawHeader(QByteArray(headerKey.c_str()), QByteArray(_headers[headerKey].c_str()));
+            request.setRawHeader(QByteArray(headerKey.c_str()), QByteArray(_headers[headerKey].c_str()));
         }
 
-        _reply = _manager->get(*request);
+        _reply = _manager->get(request);
+
+        // let Qt hold no more than we do, so that a slow reader pauses the connection
+        _reply->setReadBufferSize(static_cast<qint64>(_streamCapacity));
+        connect(_reply, &QNetworkReply::metaDataChanged, _reply, [this]() { recordStatus(); });
+        connect(_reply, &QNetworkReply::readyRead, _reply, [this]() { pullStreamData(); });
+        connect(_reply, &QNetworkReply::finished, _reply, [this]() { pullStreamData(); });
 
         // these do not seem to be called and/or I do not have a test case to trigger them
         // so rather than leave here untested, I am disabling
@@ -101,7 +333,7 @@ void GDownloader::downloadInternal() {
         //connect(_reply, &QNetworkReply::sslErrors, this, &GDownloader::sslErrorsReply);
   });
 
-    // wait for download to finish (in student thread)
+    // wait for the headers to arrive (in student thread)
     waitForDownload();
 }
 
@@ -109,10 +341,24 @@ void GDownloader::fileDownloadError(QNetworkReply::NetworkError nerror) {
     error("file download error: " + std::to_string(nerror));
 }
 
+std::string GDownloader::getCacheDirectory() const {
+    return _cacheDirectory;
+}
+
 std::string GDownloader::getErrorMessage() const {
     return _lastErrorMessage;
 }
 
+/*
+ * One manager for the whole program lets Qt keep connections to each host
+ * open between downloads and reuse them, rather than opening new ones for
+ * every request.  Must be called on the Qt GUI thread, which owns it.
+ */
+QNetworkAccessManager* GDownloader::getSharedManager() {
+    static QNetworkAccessManager* manager = new QNetworkAccessManager();
+    return manager;
+}
+
 int GDownloader::getHttpStatusCode() const {
     // all HTTP status codes are between 1xx and 5xx, inclusive
     return _httpStatusCode >= 100 && _httpStatusCode <= 599 ? _httpStatusCode : 0;
@@ -131,7 +377,9 @@ std::string GDownloader::getUserAgent() const {
 }
 
 bool GDownloader::hasError() const {
-    if (_httpStatusCode != 0) {
+    if (_networkError) {
+        return true;
+    } else if (_httpStatusCode != 0) {
         // values 2xx indicate success
         return _httpStatusCode < 200 || _httpStatusCode > 299;
     } else {
@@ -139,6 +387,114 @@ bool GDownloader::hasError() const {
     }
 }
 
+void GDownloader::openStream(const std::string& url, int bufferSize) {
+    if (bufferSize <= 0) {
+        error("GDownloader::openStream: buffer size must be positive");
+    }
+    _url = url;
+    _filename = "";
+    _streamCapacity = static_cast<size_t>(bufferSize);
+    downloadInternal();
+}
+
+/*
+ * Moves data from the reply into the stream buffer until the buffer is
+ * full, and finishes the download once the reply has ended and all of its
+ * data has been taken.  Runs on the Qt GUI thread.
+ */
+void GDownloader::pullStreamData() {
+    if (!_reply) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_streamLock);
+    while (_streamBuffered < _streamCapacity && _reply->bytesAvailable() > 0) {
+        QByteArray data = _reply->read(static_cast<qint64>(_streamCapacity - _streamBuffered));
+        if (data.isEmpty()) {
+            break;
+        }
+        _streamBuffered += static_cast<size_t>(data.size());
+        _streamChunks.emplace_back(data.constData(), static_cast<size_t>(data.size()));
+    }
+    _streamStalled = _reply->bytesAvailable() > 0;
+    if (_reply->isFinished() && !_streamStalled) {
+        if (!_headersReceived) {
+            QVariant statusCode = _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+            if (statusCode.isValid()) {
+                _httpStatusCode = statusCode.toInt();
+                _lastErrorMessage = _reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString().toStdString();
+            } else {
+                _httpStatusCode = -1;
+                _lastErrorMessage = "Unable to connect to URL";
+            }
+        }
+        QNetworkReply::NetworkError nerror = _reply->error();
+        if (nerror) {
+            // connection failed; log the error message
+            _networkError = true;
+            _lastErrorMessage = qtNetworkErrorToString(nerror);
+        }
+
+        // clean up the connection
+        QObject::disconnect(_reply, nullptr, _reply, nullptr);
+        _reply->deleteLater();
+        _reply = nullptr;
+        _headersReceived = true;
+        _downloadComplete = true;
+    }
+    _streamChanged.notify_all();
+}
+
+/*
+ * Implementation notes: readStream
+ * --------------------------------
+ * If the reply still holds data that did not fit in the buffer, no further
+ * readyRead signal will announce it, so taking a piece out of the buffer
+ * asks the GUI thread to pull more.
+ */
+bool GDownloader::readStream(std::string& data) {
+    data.clear();
+    bool refill = false;
+    {
+        std::unique_lock<std::mutex> lock(_streamLock);
+        _streamChanged.wait(lock, [this]() {
+            return !_streamChunks.empty() || _downloadComplete;
+        });
+        if (_streamChunks.empty()) {
+            return false;
+        }
+        data.swap(_streamChunks.front());
+        _streamChunks.pop_front();
+        _streamBuffered -= data.size();
+        refill = _streamStalled;
+        _streamStalled = false;
+    }
+    if (refill) {
+        GThread::runOnQtGuiThreadAsync([this]() {
+            pullStreamData();
+        });
+    }
+    return true;
+}
+
+/*
+ * Records the HTTP status once the response headers have arrived, which
+ * lets openStream return.  Runs on the Qt GUI thread.
+ */
+void GDownloader::recordStatus() {
+    if (!_reply) {
+        return;
+    }
+    QVariant statusCode = _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+    if (!statusCode.isValid()) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_streamLock);
+    _httpStatusCode = statusCode.toInt();
+    _lastErrorMessage = _reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString().toStdString();
+    _headersReceived = true;
+    _streamChanged.notify_all();
+}
+
 std::string GDownloader::qtNetworkErrorToString(QNetworkReply::NetworkError nerror) {
     // http://doc.qt.io/qt-5/qnetworkreply.html#NetworkError-enum
     switch (nerror) {
@@ -181,30 +537,52 @@ std::string GDownloader::qtNetworkErrorToString(QNetworkReply::NetworkError nerr
     return "";
 }
 
+/*
+ * Reads the rest of the download as it arrives, appending it to _filedata
+ * or writing it to the given file, so that the data is never held twice.
+ */
 void GDownloader::saveDownloadedData(const std::string& member, const std::string& filename) {
-    if (_reply) {
-        QNetworkReply::NetworkError nerror = _reply->error();
-        if (nerror) {
-            // connection failed; log the error message
-            _lastErrorMessage = qtNetworkErrorToString(nerror);
-        } else if (filename.empty()) {
-            // save to a string
-            _filedata = _reply->readAll().toStdString();
-        } else {
-            // save to a file
-            QFile outfile(QString::fromStdString(filename));
-            if (!outfile.open(QIODevice::WriteOnly)) {
-                error("GDownloader::" + member + ": cannot open file " + filename + " for writing");
+    _filedata.clear();
+    if (hasError()) {
+        closeStream();
+        return;
+    }
+    std::string chunk;
+    if (filename.empty()) {
+        // save to a string
+        while (readStream(chunk)) {
+            if (_filedata.empty()) {
+                _filedata.swap(chunk);
+            } else {
+                _filedata += chunk;
             }
-            outfile.write(_reply->readAll());
-            outfile.close();
         }
+    } else {
+        // save to a file
+        QFile outfile(QString::fromStdString(filename));
+        if (!outfile.open(QIODevice::WriteOnly)) {
+            closeStream();
+            error("GDownloader::" + member + ": cannot open file " + filename + " for writing");
+        }
+        while (readStream(chunk)) {
+            outfile.write(chunk.data(), static_cast<qint64>(chunk.size()));
+        }
+        outfile.close();
+    }
+}
 
-        // clean up the connection
-        _reply->deleteLater();
-        _reply = nullptr;
-        _downloadComplete = true;
+void GDownloader::setCacheDirectory(const std::string& directory) {
+    if (!directory.empty()) {
+        createDirectoryPath(directory);
+    }
+    _cacheDirectory = directory;
+}
+
+void GDownloader::setMaxConnectionsPerHost(int limit) {
+    if (limit <= 0) {
+        error("GDownloader::setMaxConnectionsPerHost: limit must be positive");
     }
+    _maxPerHost = limit;
 }
 
 void GDownloader::setHeader(const std::string& name, const std::string& value) {
@@ -215,6 +593,85 @@ void GDownloader::setUserAgent(const std::string& userAgent) {
     setHeader("User-Agent", userAgent);
 }
 
+/*
+ * Implementation notes: startBatchDownloads
+ * -----------------------------------------
+ * Starts waiting downloads, in order, until the batch's limit is reached,
+ * passing over any whose host is already at its own limit.  An https: URL
+ * fails at once if there is no SSL support, as in downloadInternal.  Each
+ * finished download calls this again to fill the slot it freed.  The whole
+ * reply is read at once here, since downloadAll is meant for many small
+ * resources.
+ * Runs on the Qt GUI thread.
+ */
+void GDownloader::startBatchDownloads(std::shared_ptr<Batch> batch) {
+    auto next = batch->waiting.begin();
+    while (batch->active < batch->maxParallel && next != batch->waiting.end()) {
+        int index = *next;
+        const std::string& url = batch->urls[index];
+        if (isUnreachableSecureUrl(url)) {
+            // fails at once, without taking up a slot
+            next = batch->waiting.erase(next);
+            Response response;
+            response.url = url;
+            response.httpStatusCode = -1;
+            response.errorMessage = noSslMessage(url);
+            response.fromCache = false;
+            batch->finished(index, response);
+            continue;
+        }
+        std::string host = hostOf(url);
+        if (batch->activePerHost[host] >= batch->maxPerHost) {
+            ++next;
+            continue;
+        }
+        next = batch->waiting.erase(next);
+        batch->active++;
+        batch->activePerHost[host]++;
+
+        QNetworkRequest request(QUrl(QString::fromStdString(url)));
+        for (std::string headerKey : batch->headers) {
+            request.setRawHeader(QByteArray(headerKey.c_str()), QByteArray(batch->headers[headerKey].c_str()));
+        }
+        std::string etag;
+        if (!batch->cacheDirectory.empty() && readCacheEntry(batch->cacheDirectory, url, etag, nullptr)) {
+            request.setRawHeader("If-None-Match", QByteArray(etag.c_str()));
+        }
+        QNetworkReply* reply = getSharedManager()->get(request);
+        connect(reply, &QNetworkReply::finished, reply, [batch, index, host, reply]() {
+            Response response;
+            response.url = batch->urls[index];
+            response.fromCache = false;
+            QVariant statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+            response.httpStatusCode = statusCode.isValid() ? statusCode.toInt() : -1;
+            std::string etag;
+            if (response.httpStatusCode == 304 && !batch->cacheDirectory.empty()) {
+                response.fromCache = readCacheEntry(batch->cacheDirectory, response.url,
+                                                    etag, &response.body);
+                if (!response.fromCache) {
+                    response.errorMessage = "the server reported no change, but there is no cached copy";
+                }
+            } else if (reply->error()) {
+                response.errorMessage = qtNetworkErrorToString(reply->error());
+            } else if (!statusCode.isValid()) {
+                response.errorMessage = "Unable to connect to URL";
+            } else {
+                QByteArray body = reply->readAll();
+                QByteArray newEtag = reply->rawHeader("ETag");
+                if (!batch->cacheDirectory.empty() && !newEtag.isEmpty()) {
+                    writeCacheEntry(batch->cacheDirectory, response.url, newEtag.toStdString(), body);
+                }
+                response.body.assign(body.constData(), static_cast<size_t>(body.size()));
+            }
+            reply->deleteLater();
+            batch->active--;
+            batch->activePerHost[host]--;
+            batch->finished(index, response);
+            startBatchDownloads(batch);
+        });
+    }
+}
+
 void GDownloader::sslErrorsReply(QList<QSslError>) {
     std::cout << "  DEBUG: sslErrors from NetworkReply" << std::endl;
 }
@@ -224,29 +681,19 @@ void GDownloader::sslErrorsNam(QNetworkReply *, QList<QSslError>) {
 }
 
 void GDownloader::reportNoSSL() {
+    std::lock_guard<std::mutex> guard(_streamLock);
+    _headersReceived = true;
     _downloadComplete = true;
-    _lastErrorMessage = "No ssl support, unable to fetch secure url " + _url;
+    _networkError = true;
+    _lastErrorMessage = noSslMessage(_url);
 }
 
 void GDownloader::waitForDownload() {
-    // wait for download to finish
-    while (!_downloadComplete) {
-        GThread::msleep(10);
-        if (_reply && _reply->isFinished()) {
-            _downloadComplete = true;
-            break;
-        }
-    }
-
-    // grab the HTTP status code
-    QVariant statusCode = _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
-    if (statusCode.isValid()) {
-        _httpStatusCode = statusCode.toInt();
-        _lastErrorMessage = _reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString().toStdString();
-    } else {
-        _httpStatusCode = -1;
-        _lastErrorMessage = "Unable to connect to URL";
-    }
+    // wait until the status is known; the body is read afterward
+    std::unique_lock<std::mutex> lock(_streamLock);
+    _streamChanged.wait(lock, [this]() {
+        return _headersReceived || _downloadComplete;
+    });
 }
 
 
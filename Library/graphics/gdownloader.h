@@ -14,6 +14,15 @@
  * https://wiki.qt.io/Download_Data_from_URL
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added openStream, readStream, and closeStream to read a download
+ *   incrementally with bounded memory
+ * - downloadAsString and downloadToFile take the data as it arrives
+ *   rather than buffering the whole reply first
+ * - all downloaders share one QNetworkAccessManager, so connections to a
+ *   host are kept alive and reused from one download to the next
+ * - added downloadAll for concurrent downloads with per-host limits, and
+ *   an optional on-disk cache revalidated with ETags
  * @version 2018/09/18
  * - working version; had to fix various threading / Qt signal issues
  * @version 2018/09/07
@@ -28,20 +37,76 @@
 #ifndef _gdownloader_h
 #define _gdownloader_h
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 
 #include "map.h"
+#include "vector.h"
 
 /**
  * A GDownloader can download files and data over an internet connection.
  * It can save the data to a file or return the data as a string.
+ *
+ * To fetch many URLs, <code>downloadAll</code> runs several downloads at
+ * once.  All downloaders share a single connection pool, so repeated
+ * requests to the same host reuse an open connection.
+ *
+ *<pre>
+ *    GDownloader downloader;
+ *    downloader.setCacheDirectory("cache");
+ *    downloader.downloadAll(urls, [](const GDownloader::Response& response) {
+ *        if (!response.hasError()) {
+ *            ... response.url, response.body ...
+ *        }
+ *    });
+ *</pre>
  */
 class GDownloader : public QObject {
     Q_OBJECT
 
 public:
+    /**
+     * The result of one of the downloads made by <code>downloadAll</code>.
+     */
+    struct Response {
+        std::string url;
+        std::string body;
+        int httpStatusCode;         // 304 if the body came from the cache after revalidation
+        std::string errorMessage;   // "" if the download succeeded
+        bool fromCache;
+
+        /**
+         * Returns true if the download failed.  A body that was served
+         * from the cache is not an error.
+         */
+        bool hasError() const;
+    };
+
+    /**
+     * The default limit on the number of downloads made at once.
+     */
+    static const int DEFAULT_MAX_PARALLEL = 8;
+
+    /**
+     * The default limit on the number of downloads from one host at once,
+     * which is also the most connections Qt opens to one HTTP host.
+     */
+    static const int DEFAULT_MAX_PER_HOST = 6;
+
+    /**
+     * The default number of bytes of a streamed download that are held in
+     * memory while waiting to be read.
+     */
+    static const int DEFAULT_STREAM_BUFFER_SIZE = 1024 * 1024;
+
     /**
      * Creates a new downloader.
      */
@@ -49,21 +114,58 @@ public:
 
     /**
      * Frees memory allocated internally by the downloader.
+     * Any download that is still in progress is stopped.
      */
     virtual ~GDownloader();
 
+    /**
+     * Stops a download started by <code>openStream</code>, discarding any
+     * data that has not been read.  Does nothing if no download is open.
+     */
+    void closeStream();
+
     /**
      * Downloads the text contents of the given URL, returning them as a string.
      * This method blocks until the data is finished downloading.
      */
     std::string downloadAsString(const std::string& url);
 
+    /**
+     * Starts downloading all of the given URLs and returns at once with one
+     * future per URL, in the same order.  At most <code>maxParallel</code>
+     * downloads run at a time, and at most the number set by
+     * <code>setMaxConnectionsPerHost</code> go to any one host; the others
+     * wait their turn.  Each future's <code>get</code> waits for that
+     * download and returns its response; failures are reported in the
+     * response rather than thrown.  Any headers that have been set are
+     * sent with every request.  The futures remain valid after the
+     * downloader is destroyed.
+     */
+    std::vector<std::future<Response>> downloadAll(const Vector<std::string>& urls,
+                                                   int maxParallel = DEFAULT_MAX_PARALLEL);
+
+    /**
+     * Downloads all of the given URLs as above, calling <code>callback</code>
+     * with each response in the order in which the downloads finish.
+     * The callback runs on the calling thread, and this function returns
+     * once every URL has been handled.
+     */
+    void downloadAll(const Vector<std::string>& urls,
+                     const std::function<void (const Response& response)>& callback,
+                     int maxParallel = DEFAULT_MAX_PARALLEL);
+
     /**
      * Downloads the text contents of the given URL, saving it to the given output file.
      * This method blocks until the data is finished downloading.
      */
     void downloadToFile(const std::string& url, const std::string& file);
 
+    /**
+     * Returns the directory set by <code>setCacheDirectory</code>,
+     * or "" if responses are not being cached.
+     */
+    std::string getCacheDirectory() const;
+
     /**
      * Returns the last HTTP error message that occurred.
      * If no HTTP errors have occurred, returns "".
@@ -107,6 +209,43 @@ public:
      */
     void httpPost(const std::string& url);
 
+    /**
+     * Starts downloading the given URL and returns as soon as the response
+     * headers have arrived, without waiting for the rest of the data, which
+     * can then be read with <code>readStream</code> as it arrives.  If the
+     * download failed, <code>hasError</code> returns true.
+     * At most <code>bufferSize</code> bytes are held by the downloader while
+     * waiting to be read; when that much is waiting, the download pauses
+     * until the reader catches up, so even very large downloads use a
+     * bounded amount of memory.
+     */
+    void openStream(const std::string& url, int bufferSize = DEFAULT_STREAM_BUFFER_SIZE);
+
+    /**
+     * Waits for the next piece of a download started with <code>openStream</code>
+     * and moves it into <code>data</code>, replacing its previous contents.
+     * Returns <code>false</code> and leaves <code>data</code> empty once all of
+     * the data has been read or the download has stopped; at that point,
+     * <code>hasError</code> tells whether the download was complete.
+     */
+    bool readStream(std::string& data);
+
+    /**
+     * Turns on caching of the responses from <code>downloadAll</code> in
+     * the given directory, which is created if needed; "" turns it off.
+     * A response that carries an ETag header is saved, and the next request
+     * for the same URL asks the server whether it has changed.  If not, the
+     * server answers with status 304 and no body, and the saved body is used.
+     */
+    void setCacheDirectory(const std::string& directory);
+
+    /**
+     * Sets the largest number of downloads made by <code>downloadAll</code>
+     * that may go to the same host at once.
+     * @throw ErrorException if the limit is not positive
+     */
+    void setMaxConnectionsPerHost(int limit);
+
     /**
      * Sets the value of the given HTTP header for this URL request.
      * Must be called before open(), and the stream must have been created
@@ -145,15 +284,43 @@ private:
 
     static std::string qtNetworkErrorToString(QNetworkReply::NetworkError nerror);
 
+    struct Batch;
+
+    static QNetworkAccessManager* getSharedManager();
+    static void startBatchDownloads(std::shared_ptr<Batch> batch);
+
+    std::shared_ptr<Batch> createBatch(const Vector<std::string>& urls, int maxParallel,
+                                       const std::function<void (int index, Response& response)>& finished);
+    void pullStreamData();
+    void recordStatus();
+
     QNetworkAccessManager* _manager;
-    QNetworkReply* _reply;
+    QNetworkReply* _reply;                    // used only on the Qt GUI thread
     Map<std::string, std::string> _headers;   // HTTP headers to send (name => value)
     int _httpStatusCode;
     bool _downloadComplete;
+    bool _networkError;                       // the connection failed or broke off
     std::string _url;
     std::string _filename;
     std::string _filedata;
     std::string _lastErrorMessage;
+    std::string _cacheDirectory;
+    int _maxPerHost;
+
+    /*
+     * Data that has arrived but not been read.  The reply is read on the
+     * Qt GUI thread and the data is taken by the thread that called
+     * openStream, so these members and the status members above are
+     * guarded by _streamLock while a download is open.
+     */
+    std::mutex _streamLock;
+    std::condition_variable _streamChanged;
+    std::deque<std::string> _streamChunks;
+    size_t _streamBuffered;                   // total size of _streamChunks
+    size_t _streamCapacity;
+    bool _streamStalled;                      // data is waiting in the reply because we were full
+    bool _headersReceived;
+    bool _streamStarted;
 };
 
 #endif // _gdownloader_h
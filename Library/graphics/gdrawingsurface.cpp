@@ -3,6 +3,9 @@
  * -------------------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added beginBatch/endBatch; while batching, the simple shape methods
+ *   record a ShapeCommand by value instead of drawing a GObject
  * @version 2018/08/23
  * - renamed to gdrawingsurface.cpp to replace Java version
  * @version 2018/07/11
@@ -11,6 +14,7 @@
 
 #include "gdrawingsurface.h"
 #include <QPainter>
+#include "error.h"
 #include "gcolor.h"
 #include "gfont.h"
 #include "require.h"
@@ -26,7 +30,8 @@ GDrawingSurface::GDrawingSurface()
           _fillColorInt(0),
           _lineStyle(GObject::LINE_SOLID),
           _lineWidth(1),
-          _autoRepaint(true) {
+          _autoRepaint(true),
+          _batchDepth(0) {
     // empty
 }
 
@@ -34,6 +39,14 @@ GDrawingSurface::~GDrawingSurface() {
     _forwardTarget = nullptr;
 }
 
+void GDrawingSurface::beginBatch() {
+    if (_forwardTarget) {
+        _forwardTarget->beginBatch();
+    } else {
+        _batchDepth++;
+    }
+}
+
 void GDrawingSurface::checkBounds(const std::string& member, double x, double y, double width, double height) const {
     require::inRange2D(x, y, width - 1, height - 1, member);
 }
@@ -95,6 +108,13 @@ void GDrawingSurface::draw(GObject& gobj, double x, double y) {
 }
 
 void GDrawingSurface::drawArc(double x, double y, double width, double height, double start, double sweep) {
+    if (isBatching()) {
+        ShapeCommand shape = makeShape(ShapeCommand::ARC, x, y, width, height, /* fill */ false);
+        shape.start = start;
+        shape.sweep = sweep;
+        recordShape(shape);
+        return;
+    }
     GArc arc(x, y, width, height, start, sweep);
     initializeGObject(arc);
     draw(arc);
@@ -110,6 +130,10 @@ void GDrawingSurface::drawLine(const GPoint& p0, const GPoint& p1) {
 }
 
 void GDrawingSurface::drawLine(double x0, double y0, double x1, double y1) {
+    if (isBatching()) {
+        recordShape(makeShape(ShapeCommand::LINE, x0, y0, x1 - x0, y1 - y0, /* fill */ false));
+        return;
+    }
     GLine line(x0, y0, x1, y1);
     initializeGObject(line);
     draw(line);
@@ -120,6 +144,10 @@ void GDrawingSurface::drawOval(const GRectangle& bounds) {
 }
 
 void GDrawingSurface::drawOval(double x, double y, double width, double height) {
+    if (isBatching()) {
+        recordShape(makeShape(ShapeCommand::OVAL, x, y, width, height, /* fill */ false));
+        return;
+    }
     GOval oval(x, y, width, height);
     initializeGObject(oval);
     draw(oval);
@@ -165,6 +193,10 @@ void GDrawingSurface::drawRect(const GRectangle& bounds) {
 }
 
 void GDrawingSurface::drawRect(double x, double y, double width, double height) {
+    if (isBatching()) {
+        recordShape(makeShape(ShapeCommand::RECT, x, y, width, height, /* fill */ false));
+        return;
+    }
     GRect rect(x, y, width, height);
     initializeGObject(rect);
     draw(rect);
@@ -176,7 +208,28 @@ void GDrawingSurface::drawString(const std::string& text, double x, double y) {
     draw(str);
 }
 
+void GDrawingSurface::endBatch() {
+    if (_forwardTarget) {
+        _forwardTarget->endBatch();
+        return;
+    }
+    if (_batchDepth <= 0) {
+        error("GDrawingSurface::endBatch: no batch is in progress");
+    }
+    _batchDepth--;
+    if (_batchDepth == 0) {
+        flushBatch();
+    }
+}
+
 void GDrawingSurface::fillArc(double x, double y, double width, double height, double start, double sweep) {
+    if (isBatching()) {
+        ShapeCommand shape = makeShape(ShapeCommand::ARC, x, y, width, height, /* fill */ true);
+        shape.start = start;
+        shape.sweep = sweep;
+        recordShape(shape);
+        return;
+    }
     GArc arc(x, y, width, height, start, sweep);
     initializeGObject(arc, /* filled */ true);
     draw(arc);
@@ -187,6 +240,10 @@ void GDrawingSurface::fillOval(const GRectangle& bounds) {
 }
 
 void GDrawingSurface::fillOval(double x, double y, double width, double height) {
+    if (isBatching()) {
+        recordShape(makeShape(ShapeCommand::OVAL, x, y, width, height, /* fill */ true));
+        return;
+    }
     GOval oval(x, y, width, height);
     initializeGObject(oval, /* filled */ true);
     draw(oval);
@@ -200,7 +257,7 @@ void GDrawingSurface::fillPolygon(std::initializer_list<double> coords) {
 
 void GDrawingSurface::fillPolygon(std::initializer_list<GPoint> points) {
     GPolygon polygon(points);
-    initializeGObject(polygon, /* fllled */ true);
+    initializeGObject(polygon, /* filled */ true);
     draw(polygon);
 }
 
@@ -209,11 +266,21 @@ void GDrawingSurface::fillRect(const GRectangle& bounds) {
 }
 
 void GDrawingSurface::fillRect(double x, double y, double width, double height) {
+    if (isBatching()) {
+        recordShape(makeShape(ShapeCommand::RECT, x, y, width, height, /* fill */ true));
+        return;
+    }
     GRect rect(x, y, width, height);
     initializeGObject(rect, /* filled */ true);
     draw(rect);
 }
 
+void GDrawingSurface::flushBatch() {
+    if (_forwardTarget) {
+        _forwardTarget->flushBatch();
+    }
+}
+
 int GDrawingSurface::getARGB(double x, double y) const {
     return getPixelARGB(x, y);
 }
@@ -336,10 +403,94 @@ bool GDrawingSurface::isAutoRepaint() const {
     }
 }
 
+bool GDrawingSurface::isBatching() const {
+    if (_forwardTarget) {
+        return _forwardTarget->isBatching();
+    } else {
+        return _batchDepth > 0;
+    }
+}
+
 bool GDrawingSurface::isRepaintImmediately() const {
     return isAutoRepaint();
 }
 
+/*
+ * Implementation notes: makeShape
+ * -------------------------------
+ * Mirrors initializeGObject and GObject::initializeBrushAndPen: a color
+ * string without an alpha component is drawn opaque, and an empty fill
+ * color means the shape is not filled.
+ */
+GDrawingSurface::ShapeCommand GDrawingSurface::makeShape(ShapeCommand::Kind kind,
+                                                         double x, double y,
+                                                         double width, double height,
+                                                         bool fill) const {
+    ShapeCommand shape;
+    shape.kind = kind;
+    shape.x = x;
+    shape.y = y;
+    shape.width = width;
+    shape.height = height;
+    shape.start = 0;
+    shape.sweep = 0;
+    int color = getColorInt();
+    shape.penARGB = static_cast<unsigned int>(
+            GColor::hasAlpha(getColor()) ? color : (color | 0xff000000));
+    std::string fillColor = getFillColor();
+    shape.filled = fill && !fillColor.empty();
+    int fillColorInt = getFillColorInt();
+    shape.fillARGB = static_cast<unsigned int>(
+            GColor::hasAlpha(fillColor) ? fillColorInt : (fillColorInt | 0xff000000));
+    shape.lineWidth = static_cast<int>(getLineWidth());
+    shape.lineStyle = getLineStyle();
+    return shape;
+}
+
+/*
+ * Implementation notes: recordShape
+ * ---------------------------------
+ * Only reached while batching on a surface that keeps no buffer, so the
+ * shape is drawn at once.  Drawing it as the matching GObject keeps the
+ * result identical to the unbatched methods.
+ */
+void GDrawingSurface::recordShape(const ShapeCommand& shape) {
+    if (_forwardTarget) {
+        _forwardTarget->recordShape(shape);
+        return;
+    }
+    bool fill = shape.filled;
+    switch (shape.kind) {
+    case ShapeCommand::ARC: {
+        GArc arc(shape.x, shape.y, shape.width, shape.height, shape.start, shape.sweep);
+        initializeGObject(arc, fill);
+        draw(arc);
+        break;
+    }
+    case ShapeCommand::LINE: {
+        GLine line(shape.x, shape.y, shape.x + shape.width, shape.y + shape.height);
+        initializeGObject(line);
+        draw(line);
+        break;
+    }
+    case ShapeCommand::OVAL: {
+        GOval oval(shape.x, shape.y, shape.width, shape.height);
+        initializeGObject(oval, fill);
+        draw(oval);
+        break;
+    }
+    case ShapeCommand::PIXEL:
+        setPixelARGB(shape.x, shape.y, static_cast<int>(shape.penARGB));
+        break;
+    case ShapeCommand::RECT: {
+        GRect rect(shape.x, shape.y, shape.width, shape.height);
+        initializeGObject(rect, fill);
+        draw(rect);
+        break;
+    }
+    }
+}
+
 void GDrawingSurface::repaintRegion(const GRectangle& bounds) {
     repaintRegion((int) bounds.x, (int) bounds.y,
                   (int) bounds.width, (int) bounds.height);
@@ -488,6 +639,11 @@ void GDrawingSurface::setRGB(double x, double y, const std::string& color) {
 }
 
 
+void GForwardDrawingSurface::beginBatch() {
+    ensureForwardTarget();
+    _forwardTarget->beginBatch();
+}
+
 void GForwardDrawingSurface::clear() {
     if (_forwardTarget) {
         _forwardTarget->clear();
@@ -519,6 +675,11 @@ void GForwardDrawingSurface::draw(QPainter* painter) {
     _forwardTarget->draw(painter);
 }
 
+void GForwardDrawingSurface::endBatch() {
+    ensureForwardTarget();
+    _forwardTarget->endBatch();
+}
+
 void GForwardDrawingSurface::ensureForwardTargetConstHack() const {
     if (!_forwardTarget) {
         // Your whole life has been a lie.
@@ -553,6 +714,16 @@ bool GForwardDrawingSurface::isAutoRepaint() const {
     return _forwardTarget->isAutoRepaint();
 }
 
+bool GForwardDrawingSurface::isBatching() const {
+    ensureForwardTargetConstHack();
+    return _forwardTarget->isBatching();
+}
+
+void GForwardDrawingSurface::recordShape(const ShapeCommand& shape) {
+    ensureForwardTarget();
+    GDrawingSurface::recordShape(shape);   // forwards to target
+}
+
 void GForwardDrawingSurface::repaint() {
     if (_forwardTarget) {
         _forwardTarget->repaint();
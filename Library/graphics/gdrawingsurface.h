@@ -3,6 +3,9 @@
  * -----------------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added beginBatch/endBatch for recording many draw calls and replaying
+ *   them in a single pass
  * @version 2018/09/10
  * - added doc comments for new documentation generation
  * @version 2018/08/23
@@ -30,6 +33,25 @@
  */
 class GDrawingSurface {
 public:
+    /**
+     * Starts a batch of drawing operations.
+     * Until the matching call to endBatch, the drawArc, drawLine, drawOval,
+     * drawRect, their fillXxx counterparts, and setPixel do not touch the
+     * background layer immediately; instead each shape is recorded by value
+     * on the calling thread into a command buffer.
+     * When the batch ends, the buffer is replayed onto the background layer
+     * with a single painter in one trip to the Qt GUI thread, and the union
+     * of the affected regions is repainted once.
+     * This is much faster than drawing thousands of shapes one at a time.
+     *
+     * Batches may be nested; only the outermost endBatch flushes the buffer.
+     * Other objects, such as a GObject passed to draw(), are drawn right away
+     * after the shapes recorded before them, so they need not outlive the call.
+     * Pixel values read with getPixel and similar methods during a batch
+     * reflect the state as of the most recent flush.
+     */
+    virtual void beginBatch();
+
     /**
      * Erases any pixel data from the drawing surface.
      */
@@ -199,6 +221,14 @@ public:
      */
     virtual void drawString(const std::string& text, double x, double y);
 
+    /**
+     * Ends a batch of drawing operations started by beginBatch.
+     * If this ends the outermost batch, all recorded operations are drawn
+     * onto the background layer and the affected region is repainted.
+     * @throw ErrorException if no batch is in progress
+     */
+    virtual void endBatch();
+
     /**
      * Draws a filled arc with the given attributes onto the background pixel
      * layer of this interactor in the current color and fill color.
@@ -435,6 +465,12 @@ public:
      */
     virtual bool isAutoRepaint() const;
 
+    /**
+     * Returns true if a batch of drawing operations started by beginBatch
+     * is currently in progress.
+     */
+    virtual bool isBatching() const;
+
     /**
      * Returns true if the interactor should repaint itself automatically whenever
      * any change is made to its graphical data.
@@ -729,6 +765,7 @@ protected:
     GObject::LineStyle _lineStyle;
     double _lineWidth;
     bool _autoRepaint;
+    int _batchDepth;
 
     /**
      * Throws an error if the given x/y values are out of bounds.
@@ -745,6 +782,49 @@ protected:
      */
     void checkSize(const std::string& member, double width, double height) const;
 
+    /**
+     * A simple shape drawn by one of the drawXxx or fillXxx methods, held by
+     * value along with the pen and fill it was drawn with, so that a batching
+     * surface can record it without creating a GObject.
+     * @private
+     */
+    struct ShapeCommand {
+        enum Kind { ARC, LINE, OVAL, PIXEL, RECT };
+        Kind kind;
+        double x;                      // top-left corner; start point of a LINE
+        double y;
+        double width;                  // for a LINE, the end point is (x + width, y + height)
+        double height;
+        double start;                  // ARC only
+        double sweep;
+        unsigned int penARGB;          // for a PIXEL, its new value
+        unsigned int fillARGB;
+        bool filled;
+        int lineWidth;
+        GObject::LineStyle lineStyle;
+    };
+
+    /**
+     * Returns a shape command of the given kind and geometry, with the pen and
+     * fill taken from this surface's current settings the same way that
+     * initializeGObject sets them on an object.
+     */
+    ShapeCommand makeShape(ShapeCommand::Kind kind, double x, double y,
+                           double width, double height, bool fill) const;
+
+    /**
+     * Draws a shape recorded during a batch.  Surfaces that do not buffer
+     * their drawing use this default, which draws the matching GObject
+     * right away.
+     */
+    virtual void recordShape(const ShapeCommand& shape);
+
+    /**
+     * Replays any drawing operations recorded during the current batch.
+     * Surfaces that do not buffer their drawing need not override this.
+     */
+    virtual void flushBatch();
+
     /**
      * Initializes a new graphical object to be drawn.
      * Used as a convenience method to set the color, fill color, outline style,
@@ -778,17 +858,20 @@ protected:
  */
 class GForwardDrawingSurface : public virtual GDrawingSurface {
 public:
+    void beginBatch() override;
     void clear() override;
     void draw(GObject* gobj) override;
     void draw(GObject* gobj, double x, double y) override;
     void draw(GObject& gobj) override;
     void draw(GObject& gobj, double x, double y) override;
     void draw(QPainter* painter) override;
+    void endBatch() override;
     int getPixel(double x, double y) const override;
     int getPixelARGB(double x, double y) const override;
     Grid<int> getPixels() const override;
     Grid<int> getPixelsARGB() const override;
     bool isAutoRepaint() const override;
+    bool isBatching() const override;
     void repaint() override;
     void repaintRegion(int x, int y, int width, int height) override;
     void setAutoRepaint(bool autoRepaint) override;
@@ -812,6 +895,7 @@ public:
 protected:
     virtual void ensureForwardTarget() = 0;
     virtual void ensureForwardTargetConstHack() const;
+    void recordShape(const ShapeCommand& shape) override;
 };
 
 #endif // _gcanvas_h
@@ -3,6 +3,10 @@
  * ---------------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added coalesced updates, keyed by target and property, which can be cancelled
+ * - synchronous calls wait for their own function instead of an empty queue
+ * - eventReady is emitted once per batch of queued functions
  * @version 2019/01/08
  * - bug fix in waitForClick function (was never returning!)
  * @version 2018/08/23
@@ -11,6 +15,8 @@
  * - initial version
  */
 
+#include <future>
+#include <memory>
 #include <QEvent>
 #include "geventqueue.h"
 #include "gtypes.h"
@@ -19,10 +25,42 @@
 GEventQueue* GEventQueue::_instance = nullptr;
 
 GEventQueue::GEventQueue()
-        : _eventMask(0) {
+        : _signalPending(false),
+          _eventMask(0) {
     // empty
 }
 
+/*
+ * Implementation notes: cancelPendingUpdates
+ * ------------------------------------------
+ * Removes the target's updates from _coalescedUpdates, so that the
+ * functions already in the queue for them find nothing to run.  Whatever
+ * count is left in _pendingTargets afterward belongs to an update that has
+ * been taken out of the map and is running right now; returns true if so.
+ * Keys sort by target first, so all of the target's keys are adjacent.
+ */
+bool GEventQueue::cancelPendingUpdates(const void* target) {
+    _functionQueueMutex.lockForWrite();
+    auto itr = _coalescedUpdates.lower_bound(UpdateKey(target, ""));
+    int cancelled = 0;
+    while (itr != _coalescedUpdates.end() && itr->first.first == target) {
+        itr = _coalescedUpdates.erase(itr);
+        cancelled++;
+    }
+    bool running = false;
+    auto count = _pendingTargets.find(target);
+    if (count != _pendingTargets.end()) {
+        count->second -= cancelled;
+        if (count->second <= 0) {
+            _pendingTargets.erase(count);
+        } else {
+            running = true;
+        }
+    }
+    _functionQueueMutex.unlock();
+    return running;
+}
+
 GThunk GEventQueue::dequeue() {
     _functionQueueMutex.lockForWrite();
     GThunk thunk = _functionQueue.dequeue();
@@ -38,6 +76,36 @@ void GEventQueue::enqueueEvent(const GEvent& event) {
     }
 }
 
+/*
+ * Adds a function to the back of the function queue.  The eventReady signal
+ * is emitted only if the Qt GUI thread has not yet been told about earlier
+ * functions, because each signal makes it run every function queued so far;
+ * without this, posting thousands of updates would post thousands of
+ * mostly empty signals.
+ */
+void GEventQueue::enqueueFunction(GThunk thunk) {
+    _functionQueueMutex.lockForWrite();
+    _functionQueue.enqueue(thunk);
+    bool signal = !_signalPending;
+    _signalPending = true;
+    _functionQueueMutex.unlock();
+    if (signal) {
+        emit eventReady();
+    }
+}
+
+/*
+ * Notes that one of the target's coalesced updates has finished running.
+ */
+void GEventQueue::finishCoalescedUpdate(const void* target) {
+    _functionQueueMutex.lockForWrite();
+    auto count = _pendingTargets.find(target);
+    if (count != _pendingTargets.end() && --count->second == 0) {
+        _pendingTargets.erase(count);
+    }
+    _functionQueueMutex.unlock();
+}
+
 int GEventQueue::getEventMask() const {
     return _eventMask;
 }
@@ -74,6 +142,13 @@ GEventQueue* GEventQueue::instance() {
     return _instance;
 }
 
+bool GEventQueue::hasPendingUpdates(const void* target) {
+    _functionQueueMutex.lockForRead();
+    bool pending = _pendingTargets.find(target) != _pendingTargets.end();
+    _functionQueueMutex.unlock();
+    return pending;
+}
+
 bool GEventQueue::isAcceptingEvent(const GEvent& event) const {
     return isAcceptingEvent(event.getEventClass());
 }
@@ -94,35 +169,105 @@ GThunk GEventQueue::peek() {
 }
 
 void GEventQueue::runOnQtGuiThreadAsync(GThunk thunk) {
-    _functionQueueMutex.lockForWrite();
-    _functionQueue.enqueue(thunk);
-    _functionQueueMutex.unlock();
-    emit eventReady();
+    enqueueFunction(thunk);
 }
 
-void GEventQueue::runOnQtGuiThreadSync(GThunk thunk) {
+/*
+ * Implementation notes: runOnQtGuiThreadCoalesced
+ * -----------------------------------------------
+ * Only the first update to a given key puts a function in the queue; later
+ * updates that arrive before it has run just replace the function it will
+ * call.  So the update runs at the queue position of the first write but
+ * with the value of the last one.  The key is removed just before the
+ * update runs, so a write made while it is running is queued anew.
+ * _pendingTargets counts queued updates per target until they have finished
+ * running, which lets getters wait for them; the count is also dropped if
+ * the update throws.  If the key is gone when the queued function runs, the
+ * update was cancelled and there is nothing to do.
+ */
+void GEventQueue::runOnQtGuiThreadCoalesced(const void* target, const std::string& property, GThunk thunk) {
+    UpdateKey key(target, property);
     _functionQueueMutex.lockForWrite();
-    _functionQueue.enqueue(thunk);
-    _functionQueueMutex.unlock();
-    emit eventReady();
+    auto itr = _coalescedUpdates.find(key);
+    if (itr != _coalescedUpdates.end()) {
+        itr->second = thunk;   // last write wins
+        _functionQueueMutex.unlock();
+        return;
+    }
+    _coalescedUpdates[key] = thunk;
+    _pendingTargets[target]++;
 
-    // TODO: "empty" is not quite right condition
-    while (true) {
-        _functionQueueMutex.lockForRead();
-        bool empty = _functionQueue.isEmpty();
+    // queued under the same lock, so that anyone who sees the pending
+    // update can wait for it by queueing a function behind it
+    _functionQueue.enqueue([this, key]() {
+        _functionQueueMutex.lockForWrite();
+        auto itr = _coalescedUpdates.find(key);
+        if (itr == _coalescedUpdates.end()) {
+            _functionQueueMutex.unlock();
+            return;   // cancelled
+        }
+        GThunk latest = itr->second;
+        _coalescedUpdates.erase(itr);
         _functionQueueMutex.unlock();
-        if (empty) {
-            break;
-        } else {
-            GThread::msleep(1);
+
+        try {
+            latest();
+        } catch (...) {
+            finishCoalescedUpdate(key.first);
+            throw;
         }
+        finishCoalescedUpdate(key.first);
+    });
+    bool signal = !_signalPending;
+    _signalPending = true;
+    _functionQueueMutex.unlock();
+    if (signal) {
+        emit eventReady();
     }
 }
 
+/*
+ * Implementation notes: runOnQtGuiThreadSync
+ * ------------------------------------------
+ * The caller waits on a promise that is kept when its own function has run,
+ * rather than sleeping until the whole queue is empty; this wakes the caller
+ * as soon as possible and does not make it wait for functions that other
+ * threads queued after it.  If the function throws, the exception is handed
+ * to the caller through the promise and rethrown there, as GThread::post
+ * does; otherwise the caller would never be woken.
+ */
+void GEventQueue::runOnQtGuiThreadSync(GThunk thunk) {
+    std::shared_ptr<std::promise<void>> done = std::make_shared<std::promise<void>>();
+    std::future<void> finished = done->get_future();
+    enqueueFunction([thunk, done]() {
+        try {
+            thunk();
+        } catch (...) {
+            done->set_exception(std::current_exception());
+            return;
+        }
+        done->set_value();
+    });
+    finished.get();   // rethrows any exception from thunk
+}
+
 void GEventQueue::setEventMask(int mask) {
     _eventMask = mask;
 }
 
+/*
+ * Returns the number of functions now in the queue and notes that the Qt GUI
+ * thread is about to run them, so that functions queued from now on will
+ * emit eventReady again.
+ */
+int GEventQueue::takeFunctionCount() {
+    _functionQueueMutex.lockForWrite();
+    _signalPending = false;
+    int count = _functionQueue.size();
+    _functionQueueMutex.unlock();
+    return count;
+}
+
 GEvent GEventQueue::waitForEvent(int mask) {
     setEventMask(mask);
     while (true) {
@@ -3,6 +3,9 @@
  * -------------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added coalesced updates, keyed by target and property, which can be cancelled
+ * - synchronous calls wait for their own function instead of an empty queue
  * @version 2018/09/07
  * - added doc comments for new documentation generation
  * @version 2018/08/23
@@ -15,7 +18,9 @@
 #ifndef _geventqueue_h
 #define _geventqueue_h
 
+#include <map>
 #include <string>
+#include <utility>
 #include <QObject>
 #include <QReadWriteLock>
 
@@ -98,15 +103,26 @@ private:
      */
     GEventQueue();
 
+    bool cancelPendingUpdates(const void* target);
     GThunk dequeue();
     void enqueueEvent(const GEvent& event);
+    void enqueueFunction(GThunk thunk);
+    void finishCoalescedUpdate(const void* target);
+    bool hasPendingUpdates(const void* target);
     bool isEmpty() const;
     GThunk peek();
     void runOnQtGuiThreadAsync(GThunk thunk);
+    void runOnQtGuiThreadCoalesced(const void* target, const std::string& property, GThunk thunk);
     void runOnQtGuiThreadSync(GThunk thunk);
+    int takeFunctionCount();
+
+    typedef std::pair<const void*, std::string> UpdateKey;
 
     static GEventQueue* _instance;
     Queue<GThunk> _functionQueue;
+    std::map<UpdateKey, GThunk> _coalescedUpdates;   // latest pending update per key
+    std::map<const void*, int> _pendingTargets;      // # queued updates per target
+    bool _signalPending;
     Queue<GEvent> _eventQueue;
     QReadWriteLock _eventQueueMutex;
     QReadWriteLock _functionQueueMutex;
@@ -0,0 +1,144 @@
+/*
+ * File: gimagecache.cpp
+ * ---------------------
+ * This file implements the gimagecache.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "gimagecache.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <QString>
+#include "error.h"
+
+/*static*/ const long long GImageCache::DEFAULT_MAX_BYTES = 64LL * 1024 * 1024;
+/*static*/ GImageCache* GImageCache::_instance = nullptr;
+
+GImageCache::GImageCache()
+        : _bytes(0),
+          _maxBytes(DEFAULT_MAX_BYTES),
+          _hits(0),
+          _misses(0) {
+    // empty
+}
+
+/*static*/ GImageCache* GImageCache::instance() {
+    static std::once_flag created;
+    std::call_once(created, []() {
+        _instance = new GImageCache();
+    });
+    return _instance;
+}
+
+/*static*/ long long GImageCache::bytesOf(const QImage& image) {
+    return static_cast<long long>(image.bytesPerLine()) * image.height();
+}
+
+void GImageCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    evict(0);
+}
+
+/*
+ * Drops least recently used entries until the cache holds at most the given
+ * number of bytes.  The caller must hold the mutex.
+ */
+void GImageCache::evict(long long maxBytes) {
+    while (_bytes > maxBytes && !_entries.empty()) {
+        Entry& oldest = _entries.back();
+        _bytes -= oldest.bytes;
+        _index.erase(oldest.path);
+        _entries.pop_back();
+    }
+}
+
+long long GImageCache::getBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _bytes;
+}
+
+int GImageCache::getHitCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hits;
+}
+
+long long GImageCache::getMaxBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _maxBytes;
+}
+
+int GImageCache::getMissCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _misses;
+}
+
+/*
+ * Implementation notes: load
+ * --------------------------
+ * The file is decoded without holding the mutex, so that several threads
+ * can decode different files at once.  If two threads miss on the same file
+ * at the same time, both decode it and the second result replaces the first.
+ */
+QImage GImageCache::load(const std::string& filename) {
+    QFileInfo info(QString::fromStdString(filename));
+    if (!info.exists() || !info.isFile()) {
+        return QImage();
+    }
+    std::string path = info.absoluteFilePath().toStdString();
+    long long modified = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto itr = _index.find(path);
+        if (itr != _index.end()) {
+            if (itr->second->modified == modified) {
+                _hits++;
+                _entries.splice(_entries.begin(), _entries, itr->second);
+                return itr->second->image;
+            }
+            // file has changed since it was cached
+            _bytes -= itr->second->bytes;
+            _entries.erase(itr->second);
+            _index.erase(itr);
+        }
+        _misses++;
+    }
+
+    QImage image;
+    if (!image.load(info.absoluteFilePath())) {
+        return QImage();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    long long bytes = bytesOf(image);
+    if (bytes > _maxBytes) {
+        return image;   // too big to cache
+    }
+    auto itr = _index.find(path);
+    if (itr != _index.end()) {
+        _bytes -= itr->second->bytes;
+        _entries.erase(itr->second);
+        _index.erase(itr);
+    }
+    _entries.push_front({path, modified, image, bytes});
+    _index[path] = _entries.begin();
+    _bytes += bytes;
+    evict(_maxBytes);
+    return image;
+}
+
+void GImageCache::setMaxBytes(long long maxBytes) {
+    if (maxBytes < 0) {
+        error("GImageCache::setMaxBytes: limit cannot be negative");
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxBytes = maxBytes;
+    evict(_maxBytes);
+}
+
+int GImageCache::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<int>(_entries.size());
+}
@@ -0,0 +1,126 @@
+/*
+ * File: gimagecache.h
+ * -------------------
+ * This file defines the GImageCache class, a process-wide cache of decoded
+ * image files shared by all GImage objects.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+
+#ifndef _gimagecache_h
+#define _gimagecache_h
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <QImage>
+
+/**
+ * A GImageCache remembers the decoded pixels of recently loaded image files,
+ * so that loading the same file again (for example, creating many sprites
+ * from one picture, or calling drawImage with a file name in a loop) does
+ * not read and decode the file again.
+ *
+ * Entries are keyed by the file's absolute path and its last-modified time,
+ * so a file that changes on disk is decoded again.  The total size of the
+ * cached pixels is bounded; when it would be exceeded, the least recently
+ * used images are dropped.
+ * Images handed out by the cache share their pixels with the cached copy
+ * until one of them is modified, so the cache costs no extra memory for
+ * images that are in use.
+ *
+ * All members may be called from any thread.
+ * Decoding happens on the calling thread, never on the Qt GUI thread unless
+ * the caller is the GUI thread.
+ * Clients generally do not need to use this class; GImage uses it
+ * automatically.
+ */
+class GImageCache {
+public:
+    /**
+     * The default limit on the total bytes of cached pixels (64 MB).
+     */
+    static const long long DEFAULT_MAX_BYTES;
+
+    /**
+     * Returns the single instance of the cache.
+     * If no instance yet exists, one is created.
+     */
+    static GImageCache* instance();
+
+    /**
+     * Removes every image from the cache.
+     * Images already loaded from the cache are not affected.
+     */
+    void clear();
+
+    /**
+     * Returns the total number of bytes of pixels currently in the cache.
+     */
+    long long getBytes() const;
+
+    /**
+     * Returns how many times load found its image already in the cache.
+     */
+    int getHitCount() const;
+
+    /**
+     * Returns the limit on the total number of bytes of cached pixels.
+     */
+    long long getMaxBytes() const;
+
+    /**
+     * Returns how many times load had to decode its image from the file.
+     */
+    int getMissCount() const;
+
+    /**
+     * Returns the decoded image stored in the given file, from the cache if
+     * possible and otherwise by reading and decoding the file and adding the
+     * result to the cache.
+     * Returns a null QImage if the file does not exist or cannot be decoded.
+     */
+    QImage load(const std::string& filename);
+
+    /**
+     * Sets the limit on the total number of bytes of cached pixels,
+     * dropping least recently used images as needed to get under it.
+     * A limit of 0 turns the cache off.
+     * @throw ErrorException if the limit is negative
+     */
+    void setMaxBytes(long long maxBytes);
+
+    /**
+     * Returns the number of images currently in the cache.
+     */
+    int size() const;
+
+private:
+    /* One cached image. */
+    struct Entry {
+        std::string path;       // absolute path of the file
+        long long modified;     // file's last-modified time when decoded
+        QImage image;
+        long long bytes;
+    };
+
+    GImageCache();   // forbid construction
+
+    static long long bytesOf(const QImage& image);
+    void evict(long long maxBytes);
+
+    static GImageCache* _instance;
+
+    mutable std::mutex _mutex;
+    std::list<Entry> _entries;   // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+    long long _bytes;
+    long long _maxBytes;
+    int _hits;
+    int _misses;
+};
+
+#endif // _gimagecache_h
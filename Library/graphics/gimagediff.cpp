@@ -0,0 +1,342 @@
+/*
+ * File: gimagediff.cpp
+ * --------------------
+ * This file implements the gimagediff.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "gimagediff.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include <vector>
+#include <QImage>
+#include <QString>
+#include "error.h"
+#include "filelib.h"
+#include "require.h"
+
+namespace {
+
+/* Number of pixels each thread should have to compare, at minimum. */
+const int PIXELS_PER_THREAD = 256 * 1024;
+
+/* A half-open rectangle [x1, x2) x [y1, y2) of pixel coordinates. */
+struct PixelRect {
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+
+    bool isEmpty() const {
+        return x1 >= x2 || y1 >= y2;
+    }
+
+    long long area() const {
+        return isEmpty() ? 0 : static_cast<long long>(x2 - x1) * (y2 - y1);
+    }
+
+    PixelRect intersect(const PixelRect& other) const {
+        return {std::max(x1, other.x1), std::max(y1, other.y1),
+                std::min(x2, other.x2), std::min(y2, other.y2)};
+    }
+};
+
+/* The results of comparing one band of rows. */
+struct DiffPartial {
+    long long count = 0;
+    int minX = INT_MAX;
+    int minY = INT_MAX;
+    int maxX = -1;
+    int maxY = -1;
+    std::vector<int> histogram;
+
+    void addBounds(int x1, int y1, int x2, int y2) {
+        minX = std::min(minX, x1);
+        minY = std::min(minY, y1);
+        maxX = std::max(maxX, x2);
+        maxY = std::max(maxY, y2);
+    }
+};
+
+/*
+ * Returns the largest absolute difference between corresponding 8-bit
+ * channels of the two given pixels, including alpha only if asked.
+ */
+inline unsigned int maxChannelDiff(unsigned int p, unsigned int q, unsigned int alphaMask) {
+    int db = static_cast<int>(p & 0xff) - static_cast<int>(q & 0xff);
+    int dg = static_cast<int>((p >> 8) & 0xff) - static_cast<int>((q >> 8) & 0xff);
+    int dr = static_cast<int>((p >> 16) & 0xff) - static_cast<int>((q >> 16) & 0xff);
+    int da = static_cast<int>((p >> 24) & alphaMask) - static_cast<int>((q >> 24) & alphaMask);
+    int m1 = std::max(db < 0 ? -db : db, dg < 0 ? -dg : dg);
+    int m2 = std::max(dr < 0 ? -dr : dr, da < 0 ? -da : da);
+    return static_cast<unsigned int>(std::max(m1, m2));
+}
+
+/*
+ * Compares rows [yStart, yEnd) of the region [x1, x2) of the two images,
+ * accumulating into the given partial result.
+ *
+ * When an exact match is wanted and no histogram is needed, each row is
+ * compared with a single XOR-and-mask loop.  Otherwise the per-pixel
+ * channel differences are first computed into a row buffer, and counting,
+ * the histogram, and the bounding box are all taken from that buffer.
+ * Both inner loops are free of branches and calls so that they vectorize.
+ */
+void diffRows(const PixelView& image1, const PixelView& image2,
+              int x1, int x2, int yStart, int yEnd,
+              const ImageDiffOptions& options,
+              PixelView* highlight, unsigned int highlightColor,
+              DiffPartial& result) {
+    int width = x2 - x1;
+    bool exact = options.tolerance == 0 && !options.histogram;
+    unsigned int mask = options.compareAlpha ? 0xffffffff : 0x00ffffff;
+    unsigned int alphaMask = options.compareAlpha ? 0xff : 0x00;
+    unsigned int tolerance = static_cast<unsigned int>(options.tolerance);
+    std::vector<unsigned char> diffs(exact ? 0 : width);
+    if (options.histogram) {
+        result.histogram.assign(256, 0);
+    }
+
+    for (int y = yStart; y < yEnd; y++) {
+        const unsigned int* row1 = image1.row(y) + x1;
+        const unsigned int* row2 = image2.row(y) + x1;
+        int rowCount = 0;
+        int first = -1;
+        int last = -1;
+        if (exact) {
+            for (int x = 0; x < width; x++) {
+                rowCount += ((row1[x] ^ row2[x]) & mask) != 0;
+            }
+            if (rowCount > 0) {
+                first = 0;
+                while (((row1[first] ^ row2[first]) & mask) == 0) {
+                    first++;
+                }
+                last = width - 1;
+                while (((row1[last] ^ row2[last]) & mask) == 0) {
+                    last--;
+                }
+            }
+        } else {
+            unsigned char* d = diffs.data();
+            for (int x = 0; x < width; x++) {
+                d[x] = static_cast<unsigned char>(maxChannelDiff(row1[x], row2[x], alphaMask));
+            }
+            for (int x = 0; x < width; x++) {
+                rowCount += d[x] > tolerance;
+            }
+            if (options.histogram) {
+                int* histogram = result.histogram.data();
+                for (int x = 0; x < width; x++) {
+                    histogram[d[x]]++;
+                }
+            }
+            if (rowCount > 0) {
+                first = 0;
+                while (d[first] <= tolerance) {
+                    first++;
+                }
+                last = width - 1;
+                while (d[last] <= tolerance) {
+                    last--;
+                }
+            }
+        }
+
+        if (rowCount > 0) {
+            result.count += rowCount;
+            result.addBounds(x1 + first, y, x1 + last, y);
+            if (highlight && y < highlight->getHeight()) {
+                unsigned int* out = highlight->row(y);
+                int outEnd = std::min(x1 + last + 1, highlight->getWidth());
+                for (int x = x1 + first; x < outEnd; x++) {
+                    bool differs = exact
+                            ? ((row1[x - x1] ^ row2[x - x1]) & mask) != 0
+                            : diffs[x - x1] > tolerance;
+                    if (differs) {
+                        out[x] = highlightColor;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+ImageDiffOptions::ImageDiffOptions()
+        : tolerance(0),
+          compareAlpha(false),
+          histogram(false),
+          regionX(0),
+          regionY(0),
+          regionWidth(-1),
+          regionHeight(-1),
+          threads(0) {
+    // empty
+}
+
+/*
+ * Implementation notes: diffImages
+ * --------------------------------
+ * The pixels inside both images are compared in horizontal bands, one band
+ * per thread, and the per-band counts, bounding boxes, and histograms are
+ * merged at the end.  Pixels inside only one of the two images form at most
+ * two rectangular strips per image; these are counted and highlighted
+ * directly without looking at their contents.
+ */
+ImageDiffResult diffImages(const PixelView& image1,
+                           const PixelView& image2,
+                           const ImageDiffOptions& options,
+                           PixelView* highlight,
+                           unsigned int highlightColor) {
+    require::inRange(options.tolerance, 0, 255, "diffImages", "tolerance");
+    int w1 = image1.getWidth();
+    int h1 = image1.getHeight();
+    int w2 = image2.getWidth();
+    int h2 = image2.getHeight();
+    int wmin = std::min(w1, w2);
+    int hmin = std::min(h1, h2);
+
+    PixelRect region = {
+        options.regionX,
+        options.regionY,
+        options.regionWidth < 0 ? INT_MAX : options.regionX + options.regionWidth,
+        options.regionHeight < 0 ? INT_MAX : options.regionY + options.regionHeight
+    };
+    region = region.intersect({0, 0, std::max(w1, w2), std::max(h1, h2)});
+    PixelRect overlap = region.intersect({0, 0, wmin, hmin});
+
+    // compare the overlapping pixels in bands of rows
+    std::vector<DiffPartial> partials(1);
+    if (!overlap.isEmpty()) {
+        int rows = overlap.y2 - overlap.y1;
+        int threadCount = options.threads > 0
+                ? options.threads
+                : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        threadCount = std::min(threadCount, static_cast<int>(overlap.area() / PIXELS_PER_THREAD) + 1);
+        threadCount = std::max(1, std::min(threadCount, rows));
+        partials.resize(threadCount);
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < threadCount; i++) {
+            int yStart = overlap.y1 + static_cast<int>(static_cast<long long>(rows) * i / threadCount);
+            int yEnd = overlap.y1 + static_cast<int>(static_cast<long long>(rows) * (i + 1) / threadCount);
+            auto work = [&, i, yStart, yEnd]() {
+                diffRows(image1, image2, overlap.x1, overlap.x2, yStart, yEnd,
+                         options, highlight, highlightColor, partials[i]);
+            };
+            if (i == threadCount - 1) {
+                work();   // do the last band on this thread
+            } else {
+                workers.emplace_back(work);
+            }
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // pixels that are in one image but not the other always differ
+    DiffPartial& total = partials[0];
+    PixelRect strips[] = {
+        {wmin, 0, w1, h1}, {0, hmin, wmin, h1},
+        {wmin, 0, w2, h2}, {0, hmin, wmin, h2}
+    };
+    for (const PixelRect& strip : strips) {
+        PixelRect rect = strip.intersect(region);
+        if (rect.isEmpty()) {
+            continue;
+        }
+        total.count += rect.area();
+        total.addBounds(rect.x1, rect.y1, rect.x2 - 1, rect.y2 - 1);
+        if (highlight) {
+            PixelRect visible = rect.intersect({0, 0, highlight->getWidth(), highlight->getHeight()});
+            if (!visible.isEmpty()) {
+                highlight->subview(visible.x1, visible.y1,
+                                   visible.x2 - visible.x1,
+                                   visible.y2 - visible.y1).fill(highlightColor);
+            }
+        }
+    }
+
+    // merge the partial results
+    for (size_t i = 1; i < partials.size(); i++) {
+        total.count += partials[i].count;
+        if (partials[i].maxX >= 0) {
+            total.addBounds(partials[i].minX, partials[i].minY, partials[i].maxX, partials[i].maxY);
+        }
+    }
+
+    ImageDiffResult result;
+    result.diffCount = static_cast<int>(total.count);
+    result.comparedCount = static_cast<int>(overlap.area());
+    if (total.maxX >= 0) {
+        result.bounds = GRectangle(total.minX, total.minY,
+                                   total.maxX - total.minX + 1,
+                                   total.maxY - total.minY + 1);
+    }
+    if (options.histogram) {
+        result.histogram = Vector<int>(256, 0);
+        for (const DiffPartial& partial : partials) {
+            for (int d = 0; d < static_cast<int>(partial.histogram.size()); d++) {
+                result.histogram[d] += partial.histogram[d];
+            }
+        }
+    }
+    return result;
+}
+
+/*
+ * Implementation notes: diffImageFiles
+ * ------------------------------------
+ * QImage needs no QApplication or GUI thread to load and save images,
+ * so this function can run in a test program that never opens a window.
+ */
+ImageDiffResult diffImageFiles(const std::string& filename1,
+                               const std::string& filename2,
+                               const ImageDiffOptions& options,
+                               const std::string& outputFilename,
+                               unsigned int highlightColor) {
+    QImage images[2];
+    const std::string* filenames[2] = {&filename1, &filename2};
+    for (int i = 0; i < 2; i++) {
+        if (!fileExists(*filenames[i])
+                || !images[i].load(QString::fromStdString(*filenames[i]))) {
+            error("diffImageFiles: unable to load image from \"" + *filenames[i] + "\"");
+        }
+        if (images[i].format() != QImage::Format_ARGB32) {
+            images[i] = images[i].convertToFormat(QImage::Format_ARGB32);
+        }
+    }
+
+    PixelView views[2];
+    for (int i = 0; i < 2; i++) {
+        views[i] = PixelView(reinterpret_cast<unsigned int*>(images[i].bits()),
+                             images[i].width(),
+                             images[i].height(),
+                             static_cast<int>(images[i].bytesPerLine() / sizeof(unsigned int)));
+    }
+
+    if (outputFilename.empty()) {
+        return diffImages(views[0], views[1], options);
+    }
+
+    QImage output(std::max(images[0].width(), images[1].width()),
+                  std::max(images[0].height(), images[1].height()),
+                  QImage::Format_ARGB32);
+    PixelView outputView(reinterpret_cast<unsigned int*>(output.bits()),
+                         output.width(),
+                         output.height(),
+                         static_cast<int>(output.bytesPerLine() / sizeof(unsigned int)));
+    outputView.fill(0);
+    outputView.copyFrom(views[0]);
+    ImageDiffResult result = diffImages(views[0], views[1], options, &outputView, highlightColor);
+    if (!output.save(QString::fromStdString(outputFilename))) {
+        error("diffImageFiles: unable to save image to \"" + outputFilename + "\"");
+    }
+    return result;
+}
@@ -0,0 +1,128 @@
+/*
+ * File: gimagediff.h
+ * ------------------
+ * This file declares functions for comparing two images pixel by pixel,
+ * as used by GCanvas::countDiffPixels, GCanvas::diff, and GDiffImage.
+ * The comparison works directly on scanlines and splits large images
+ * across several threads.  It needs no window, so it can also be used to
+ * compare image files in a headless test suite.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+
+#ifndef _gimagediff_h
+#define _gimagediff_h
+
+#include <string>
+
+#include "gpixelview.h"
+#include "gtypes.h"
+#include "vector.h"
+
+/**
+ * Options that control how diffImages compares two images.
+ */
+struct ImageDiffOptions {
+    /**
+     * Largest difference in any single color channel (0-255) for which two
+     * pixels are still considered equal.  The default of 0 requires an
+     * exact match.
+     */
+    int tolerance;
+
+    /**
+     * Whether the alpha channel takes part in the comparison.
+     * Default false.
+     */
+    bool compareAlpha;
+
+    /**
+     * Whether to fill in the histogram of the result.  Default false,
+     * since building the histogram makes the comparison somewhat slower.
+     */
+    bool histogram;
+
+    /**
+     * Region of interest: only pixels in the rectangle with upper-left corner
+     * (regionX, regionY) and size regionWidth x regionHeight are compared.
+     * A negative width or height means "to the right/bottom edge".
+     * By default the whole image is compared.
+     */
+    int regionX;
+    int regionY;
+    int regionWidth;
+    int regionHeight;
+
+    /**
+     * Maximum number of threads to use; 0 (the default) picks a number
+     * based on the image size and the number of processors.
+     */
+    int threads;
+
+    /**
+     * Creates a set of options with the default values described above.
+     */
+    ImageDiffOptions();
+};
+
+/**
+ * The outcome of comparing two images with diffImages.
+ */
+struct ImageDiffResult {
+    /**
+     * Number of pixels in the region of interest that differ.
+     * A pixel that lies inside one image but outside the other counts as
+     * differing.
+     */
+    int diffCount;
+
+    /**
+     * Number of pixels that lie inside both images and were compared.
+     */
+    int comparedCount;
+
+    /**
+     * Smallest rectangle containing every differing pixel; empty if the
+     * images match.
+     */
+    GRectangle bounds;
+
+    /**
+     * If requested in the options, histogram[d] is the number of compared
+     * pixels whose largest difference in any color channel is d,
+     * for d from 0 through 255.  Otherwise empty.
+     */
+    Vector<int> histogram;
+};
+
+/**
+ * Compares the two given images and returns a summary of their differences.
+ * If a highlight view is passed, every differing pixel that lies within it
+ * is set to the given highlight color; other pixels are left unchanged, so
+ * the caller can fill the view beforehand (for example with a copy of one
+ * of the images).
+ * @throw ErrorException if the tolerance is not between 0-255
+ */
+ImageDiffResult diffImages(const PixelView& image1,
+                           const PixelView& image2,
+                           const ImageDiffOptions& options = ImageDiffOptions(),
+                           PixelView* highlight = nullptr,
+                           unsigned int highlightColor = 0xffdd00dd);
+
+/**
+ * Loads the two given image files and compares them with diffImages.
+ * This does not create any windows or widgets.
+ * If an output file name is passed, a copy of the first image with all
+ * differing pixels highlighted in the given color is saved there.
+ * @throw ErrorException if either file cannot be loaded as an image,
+ *        or if the output file cannot be written
+ */
+ImageDiffResult diffImageFiles(const std::string& filename1,
+                               const std::string& filename2,
+                               const ImageDiffOptions& options = ImageDiffOptions(),
+                               const std::string& outputFilename = "",
+                               unsigned int highlightColor = 0xffdd00dd);
+
+#endif // _gimagediff_h
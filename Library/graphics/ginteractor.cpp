@@ -3,6 +3,8 @@
  * ---------------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added is/setAsyncUpdates for setters that do not wait for the GUI thread
  * @version 2019/04/23
  * - added set/removeActionListener
  * - added set/removeClickListener
@@ -33,6 +35,7 @@
 #include "qtgui.h"
 #include "require.h"
 
+std::atomic<bool> GInteractor::_asyncUpdates(false);
 int GInteractor::_interactorCount = 0;
 
 GInteractor::GInteractor()
@@ -50,6 +53,10 @@ GInteractor::~GInteractor() {
     // empty
 }
 
+void GInteractor::cancelPendingUpdates() const {
+    GThread::cancelPendingUpdates(this);
+}
+
 bool GInteractor::eventsEnabled() const {
     return GObservable::eventsEnabled() && getWidget() != nullptr && isVisible();
 }
@@ -196,6 +203,10 @@ bool GInteractor::inBounds(int x, int y) const {
     return 0 <= x && x < (int) getWidth() && 0 <= y && y < (int) getHeight();
 }
 
+/*static*/ bool GInteractor::isAsyncUpdates() {
+    return _asyncUpdates;
+}
+
 bool GInteractor::isEnabled() const {
     return getWidget()->isEnabled();
 }
@@ -267,6 +278,14 @@ void GInteractor::requestFocus() {
     });
 }
 
+void GInteractor::runSetterOnQtGuiThread(const std::string& property, GThunk func) {
+    if (_asyncUpdates) {
+        GThread::postCoalesced(this, property, func);
+    } else {
+        GThread::runOnQtGuiThread(func);
+    }
+}
+
 void GInteractor::setActionCommand(const std::string& actionCommand) {
     _actionCommand = actionCommand;
 }
@@ -283,6 +302,10 @@ void GInteractor::setActionListener(GEventListenerVoid func) {
     setEventListener(getActionEventType(), func);
 }
 
+/*static*/ void GInteractor::setAsyncUpdates(bool value) {
+    _asyncUpdates = value;
+}
+
 void GInteractor::setBackground(int rgb) {
     GThread::runOnQtGuiThread([this, rgb]() {
         QPalette palette(getWidget()->palette());
@@ -575,6 +598,10 @@ void GInteractor::unlockConst() const {
     that->unlock();
 }
 
+void GInteractor::waitForPendingUpdates() const {
+    GThread::waitForPendingUpdates(this);
+}
+
 
 _Internal_QWidget::_Internal_QWidget()
         : _minimumSize(-1, -1),
@@ -3,6 +3,8 @@
  * -------------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added is/setAsyncUpdates for setters that do not wait for the GUI thread
  * @version 2019/04/23
  * - added set/removeActionListener
  * - added set/removeClickListener
@@ -25,6 +27,7 @@
 #ifndef _ginteractor_h
 #define _ginteractor_h
 
+#include <atomic>
 #include <string>
 #include <QReadWriteLock>
 #include <QWidget>
@@ -280,6 +283,13 @@ public:
      */
     virtual bool inBounds(int x, int y) const;
 
+    /**
+     * Returns true if interactors' asynchronous setters return without
+     * waiting for the Qt GUI thread.
+     * @see setAsyncUpdates
+     */
+    static bool isAsyncUpdates();
+
     /**
      * Returns true if this interactor is currently enabled.
      * Most interactors begin as enabled but can be disabled to stop them from
@@ -348,6 +358,23 @@ public:
      */
     virtual void setActionCommand(const std::string& actionCommand);
 
+    /**
+     * Sets whether interactors' asynchronous setters should return without
+     * waiting for the Qt GUI thread to update the widget.
+     * The setters that support this say so in their documentation;
+     * currently these are GLabel::setText and GTable::set.
+     * Initially false, so every setter waits.
+     *
+     * When set to true, such a setter queues its change and returns at once,
+     * and if the same property of the same interactor is set again before
+     * the GUI thread gets to it, only the last value is applied.
+     * This makes updating many interactors from the student thread (e.g.
+     * thousands of labels or table cells) much faster.
+     * Getters for those properties wait for pending changes to be applied,
+     * so reading a value back always gives the one last set.
+     */
+    static void setAsyncUpdates(bool value);
+
     /**
      * Sets an action listener on this interactor so that it will be called
      * when it is interacted with in its primary way.
@@ -684,6 +711,12 @@ protected:
      */
     QReadWriteLock _lock;    // avoid thread race conditions
 
+    /**
+     * Discards any queued updates to this interactor that have not run yet.
+     * @private
+     */
+    virtual void cancelPendingUpdates() const;
+
     /**
      * @private
      */
@@ -724,6 +757,17 @@ protected:
      */
     static std::string normalizeAccelerator(const std::string& accelerator);
 
+    /**
+     * Runs the given function on the Qt GUI thread to update the given
+     * property of this interactor.  If asynchronous updates are on, the
+     * function is queued and coalesced with other updates to the same
+     * property, and the call returns at once; otherwise it waits.
+     * Subclasses that use this must call cancelPendingUpdates in their
+     * destructor and waitForPendingUpdates in getters that read the widget.
+     * @private
+     */
+    virtual void runSetterOnQtGuiThread(const std::string& property, GThunk func);
+
     /**
      * @private
      */
@@ -739,12 +783,19 @@ protected:
      */
     virtual void unlockConst() const;
 
+    /**
+     * Waits until every queued update to this interactor has been applied.
+     * @private
+     */
+    virtual void waitForPendingUpdates() const;
+
     friend class GContainer;
     friend class GDiffGui;
     friend class GWindow;
     friend class _Internal_QWidget;
 
 private:
+    static std::atomic<bool> _asyncUpdates;
     static int _interactorCount;
 };
 
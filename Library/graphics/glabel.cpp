@@ -3,6 +3,8 @@
  * ----------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - setText can update the widget asynchronously (see GInteractor::setAsyncUpdates)
  * @version 2019/04/23
  * - moved some event-handling code to GInteractor superclass
  * @version 2019/04/22
@@ -62,6 +64,7 @@ GLabel::GLabel(const std::string& text, const QPixmap& icon, QWidget* parent)
 }
 
 GLabel::~GLabel() {
+    cancelPendingUpdates();
     // TODO: if (_gtext) { delete _gtext; }
     // TODO: delete _iqlabel;
     _iqlabel->detach();
@@ -87,6 +90,7 @@ std::string GLabel::getLabel() const {
 }
 
 std::string GLabel::getText() const {
+    waitForPendingUpdates();
     return _iqlabel->text().toStdString();
 }
 
@@ -267,7 +271,7 @@ void GLabel::setText(const std::string& text) {
     if (_gtext) {
         _gtext->setText(text);
     }
-    GThread::runOnQtGuiThread([this, text]() {
+    runSetterOnQtGuiThread("text", [this, text]() {
         _iqlabel->setText(QString::fromStdString(text));
         GLayout::forceUpdate(_iqlabel);
     });
@@ -3,6 +3,8 @@
  * --------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - setText can update the widget asynchronously
  * @version 2019/04/23
  * - moved some event-handling code to GInteractor superclass
  * @version 2019/04/22
@@ -153,6 +155,8 @@ public:
     /**
      * Sets the text on the label to be the given text.
      * Equivalent to setLabel.
+     * Does not wait for the label to be updated on the screen if
+     * GInteractor::setAsyncUpdates(true) has been called.
      */
     virtual void setText(const std::string& text);
 
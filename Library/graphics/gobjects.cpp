@@ -4,6 +4,17 @@
  * This file implements the gobjects.h interface.
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added GImage readPixels/editPixels
+ * - added optional GCompound spatial index; GCompound skips drawing objects
+ *   outside the painter's clip region and checks membership with a hash set
+ * - GImage loads files through the shared GImageCache, decoding off the GUI
+ *   thread, and keeps a scaled copy for drawing at a non-native size
+ * - GImage creates its QImage on the calling thread rather than the GUI
+ *   thread, so images can be built and drawn offscreen on any thread
+ * - added GCompound dirty-region tracking; while it is on, changes record
+ *   the old and new areas of each object instead of only repainting
+ * - GObject colors can be set from an interned GColor::Handle
  * @version 2019/08/13
  * - bug fix for loading GImage (hasError -> !hasError) - thanks to Tyler Conklin
  * @version 2019/05/05
@@ -37,6 +48,8 @@
 #include "gmath.h"
 #include "gcolor.h"
 #include "gfont.h"
+#include "gimagecache.h"
+#include "gspatialindex.h"
 #include "gthread.h"
 #include "require.h"
 #include "strlib.h"
@@ -259,6 +272,9 @@ void GObject::move(double dx, double dy) {
 void GObject::repaint() {
     // really instructs the GCompound parent to redraw itself
     GCompound* parent = getParent();
+    if (parent) {
+        parent->notifyOfChange(this);
+    }
     while (parent && parent->getParent()) {
         parent = parent->getParent();
     }
@@ -387,6 +403,12 @@ void GObject::setColor(const std::string& color) {
     }
 }
 
+void GObject::setColor(const GColor::Handle& color) {
+    _color = color.toString();
+    _colorInt = color.hasAlpha() ? color.getARGB() : color.getRGB();
+    repaint();
+}
+
 void GObject::setFillColor(int r, int g, int b) {
     _fillColor = GColor::convertRGBToColor(r, g, b);
     _fillColorInt = GColor::convertRGBToRGB(r, g, b);
@@ -413,6 +435,13 @@ void GObject::setFillColor(const std::string& color) {
     repaint();
 }
 
+void GObject::setFillColor(const GColor::Handle& color) {
+    _fillColor = color.toString();
+    _fillColorInt = color.hasAlpha() ? color.getARGB() : color.getRGB();
+    _fillFlag = !color.isNull();
+    repaint();
+}
+
 void GObject::setFilled(bool flag) {
     _fillFlag = flag;
     repaint();
@@ -702,15 +731,21 @@ GCompound::GCompound()
     // empty
 }
 
+GCompound::~GCompound() {
+    delete _index;
+    _index = nullptr;
+}
+
 void GCompound::add(GObject* gobj) {
     require::nonNull(gobj, "GCompound::add");
-    for (int i = _contents.size() - 1; i >= 0; i--) {   // avoid duplicates
-        if (_contents[i] == gobj) {
-            return;
-        }
+    if (_contentsSet.contains(gobj)) {   // avoid duplicates
+        return;
     }
     _contents.add(gobj);
+    _contentsSet.add(gobj);
     gobj->_parent = this;
+    indexGObject(gobj);
+    trackGObject(gobj);
     if (gobj->isTransformed()) {
         conditionalRepaint();
     } else {
@@ -732,23 +767,68 @@ void GCompound::add(GObject& gobj, double x, double y) {
     add(&gobj, x, y);
 }
 
+/*
+ * Implementation notes: addDirtyRegion
+ * ------------------------------------
+ * Each region is kept separately so that two small objects moving at
+ * opposite corners do not cause the whole area between them to be
+ * repainted.  Past a few dozen regions, the cost of handling them one at a
+ * time outweighs the savings, so they are merged into one bounding box.
+ */
+void GCompound::addDirtyRegion(const GRectangle& bounds) {
+    static const int MAX_DIRTY_REGIONS = 32;
+    if (!_dirtyTracking || _dirtyAll || bounds.isEmpty()) {
+        return;
+    }
+    _dirtyRegions.push_back(bounds);
+    if (static_cast<int>(_dirtyRegions.size()) > MAX_DIRTY_REGIONS) {
+        GRectangle merged;
+        for (const GRectangle& region : _dirtyRegions) {
+            merged = merged.unionWith(region);
+        }
+        _dirtyRegions.clear();
+        _dirtyRegions.push_back(merged);
+    }
+}
+
 void GCompound::clear() {
     removeAll();   // calls conditionalRepaint
 }
 
+/*
+ * Implementation notes: conditionalRepaint
+ * ----------------------------------------
+ * When an object in this compound changes, notifyOfChange has already
+ * recorded exactly which area changed, so that change is not counted again
+ * here.  Any other call, such as a change to an object inside a nested
+ * compound or to the stacking order, marks the whole compound as dirty.
+ */
 void GCompound::conditionalRepaint() {
+    if (_dirtyTracking) {
+        if (_changeRecorded) {
+            _changeRecorded = false;
+        } else {
+            markDirty();
+        }
+    }
     if (_autoRepaint) {
         repaint();
     }
 }
 
 void GCompound::conditionalRepaintRegion(int x, int y, int width, int height) {
+    if (_dirtyTracking) {
+        addDirtyRegion(GRectangle(x, y, width, height));
+    }
     if (_autoRepaint) {
         repaintRegion(x, y, width, height);
     }
 }
 
 void GCompound::conditionalRepaintRegion(const GRectangle& bounds) {
+    if (_dirtyTracking) {
+        addDirtyRegion(bounds);
+    }
     if (_autoRepaint) {
         repaintRegion(bounds);
     }
@@ -759,6 +839,16 @@ bool GCompound::contains(double x, double y) const {
         // TODO
         // return stanfordcpplib::getPlatform()->gobject_contains(this, x, y);
     }
+    if (_index) {
+        std::vector<GObject*> nearby;
+        _index->query(x, y, nearby);
+        for (GObject* gobj : nearby) {
+            if (gobj->contains(x, y)) {
+                return true;
+            }
+        }
+        return false;
+    }
     for (int i = 0, sz = _contents.size(); i < sz; i++) {
         if (_contents[i]->contains(x, y)) {
             return true;
@@ -767,20 +857,57 @@ bool GCompound::contains(double x, double y) const {
     return false;
 }
 
+/*
+ * Implementation notes: draw
+ * --------------------------
+ * When a widget repaints only part of itself, Qt clips the painter to the
+ * dirty region, so anything drawn outside it is wasted work.  Objects whose
+ * bounds miss the clip rectangle are skipped; with a spatial index they are
+ * never even looked at.  Transformed objects and nested compounds do not
+ * report reliable bounds, so they are always drawn.
+ */
 void GCompound::draw(QPainter* painter) {
     if (!painter) {
         return;
     }
     // TODO: uncomment this? need settings to apply to every shape
     // initializeBrushAndPen(painter);   //
-    for (GObject* obj : _contents) {
-        if (obj->isVisible()) {
-            obj->draw(painter);
+    if (!painter->hasClipping()) {
+        for (GObject* obj : _contents) {
+            if (obj->isVisible()) {
+                obj->draw(painter);
+            }
+        }
+        return;
+    }
+
+    QRectF clip = painter->clipBoundingRect();
+    GRectangle dirty(clip.x(), clip.y(), clip.width(), clip.height());
+    if (_index) {
+        std::vector<GObject*> nearby;
+        _index->query(dirty, nearby);
+        for (GObject* obj : nearby) {
+            if (obj->isVisible()) {
+                obj->draw(painter);
+            }
+        }
+    } else {
+        for (GObject* obj : _contents) {
+            if (!obj->isVisible()) {
+                continue;
+            }
+            if (obj->isTransformed() || dynamic_cast<GCompound*>(obj)
+                    || obj->getBounds().enlargedBy(obj->getLineWidth() / 2 + 1).intersects(dirty)) {
+                obj->draw(painter);
+            }
         }
     }
 }
 
 int GCompound::findGObject(GObject* gobj) const {
+    if (!_contentsSet.contains(gobj)) {
+        return -1;
+    }
     int n = _contents.size();
     for (int i = 0; i < n; i++) {
         if (_contents.get(i) == gobj) {
@@ -815,6 +942,16 @@ GObject* GCompound::getElement(int index) const {
 }
 
 GObject* GCompound::getElementAt(double x, double y) const {
+    if (_index) {
+        std::vector<GObject*> nearby;
+        _index->query(x, y, nearby);
+        for (GObject* gobj : nearby) {
+            if (gobj->contains(x, y)) {
+                return gobj;
+            }
+        }
+        return nullptr;
+    }
     for (GObject* gobj : _contents) {
         if (gobj && gobj->contains(x, y)) {
             return gobj;
@@ -839,10 +976,71 @@ bool GCompound::isAutoRepaint() const {
     return _autoRepaint;
 }
 
+bool GCompound::isDirtyTracking() const {
+    return _dirtyTracking;
+}
+
 bool GCompound::isEmpty() const {
     return _contents.size() == 0;
 }
 
+bool GCompound::isSpatialIndexEnabled() const {
+    return _index != nullptr;
+}
+
+/*
+ * Implementation notes: indexGObject
+ * ----------------------------------
+ * Objects are indexed by their bounds enlarged by half their line width,
+ * which is how far their outline extends when drawn, plus the tolerance
+ * that contains() allows around thin lines and arcs.  Objects that change
+ * are only updated, never added, since they may be changing on the
+ * student's thread while the GUI thread removes them.
+ */
+void GCompound::indexGObject(GObject* gobj, bool addIfMissing) {
+    if (!_index) {
+        return;
+    }
+    bool boundsKnown = !gobj->isTransformed() && !dynamic_cast<GCompound*>(gobj);
+    GRectangle bounds = gobj->getBounds().enlargedBy(
+            gobj->getLineWidth() / 2 + STATIC_VARIABLE(ARC_TOLERANCE));
+    if (addIfMissing) {
+        _index->put(gobj, bounds, boundsKnown);
+    } else {
+        _index->update(gobj, bounds, boundsKnown);
+    }
+}
+
+void GCompound::markDirty() {
+    if (_dirtyTracking) {
+        _dirtyAll = true;
+        _dirtyRegions.clear();
+    }
+}
+
+/*
+ * Implementation notes: notifyOfChange
+ * ------------------------------------
+ * By the time this is called the object has already changed, so the area
+ * it used to cover comes from the bounds remembered the last time it was
+ * tracked.  Both that area and its new one need repainting.
+ */
+void GCompound::notifyOfChange(GObject* gobj) {
+    indexGObject(gobj, /* addIfMissing */ false);
+    if (_dirtyTracking) {
+        auto itr = _trackedBounds.find(gobj);
+        if (itr != _trackedBounds.end()) {
+            addDirtyRegion(itr->second);
+        }
+        if (trackGObject(gobj)) {
+            addDirtyRegion(_trackedBounds[gobj]);
+        } else {
+            markDirty();
+        }
+        _changeRecorded = true;
+    }
+}
+
 void GCompound::remove(GObject* gobj) {
     require::nonNull(gobj, "GCompound::remove");
     int index = findGObject(gobj);
@@ -859,10 +1057,15 @@ void GCompound::removeAll() {
     bool wasEmpty = _contents.isEmpty();
     Vector<GObject*> contentsCopy = _contents;
     _contents.clear();
+    _contentsSet.clear();
+    if (_index) {
+        _index->clear();
+    }
     for (GObject* obj : contentsCopy) {
         obj->_parent = nullptr;
         // TODO: delete obj;
     }
+    _trackedBounds.clear();
     if (!wasEmpty) {
         conditionalRepaint();
     }
@@ -871,7 +1074,12 @@ void GCompound::removeAll() {
 void GCompound::removeAt(int index) {
     GObject* gobj = _contents[index];
     _contents.remove(index);
+    _contentsSet.remove(gobj);
+    if (_index) {
+        _index->remove(gobj);
+    }
     gobj->_parent = nullptr;
+    _trackedBounds.erase(gobj);
     if (gobj->isTransformed()) {
         conditionalRepaint();
     } else {
@@ -880,6 +1088,9 @@ void GCompound::removeAt(int index) {
 }
 
 void GCompound::repaint() {
+    if (getParent()) {
+        getParent()->notifyOfChange(this);
+    }
     if (!_widget) {
         return;
     }
@@ -921,6 +1132,9 @@ void GCompound::sendBackward(GObject* gobj) {
         return;
     }
     if (index != 0) {
+        if (_index) {
+            _index->swapOrder(gobj, _contents[index - 1]);
+        }
         _contents.remove(index);
         _contents.insert(index - 1, gobj);
         // stanfordcpplib::getPlatform()->gobject_sendBackward(gobj);
@@ -935,6 +1149,9 @@ void GCompound::sendForward(GObject* gobj) {
         return;
     }
     if (index != _contents.size() - 1) {
+        if (_index) {
+            _index->swapOrder(gobj, _contents[index + 1]);
+        }
         _contents.remove(index);
         _contents.insert(index + 1, gobj);
         // stanfordcpplib::getPlatform()->gobject_sendForward(gobj);
@@ -949,6 +1166,9 @@ void GCompound::sendToBack(GObject* gobj) {
         return;
     }
     if (index != 0) {
+        if (_index) {
+            _index->moveToBack(gobj);
+        }
         _contents.remove(index);
         _contents.insert(0, gobj);
         // stanfordcpplib::getPlatform()->gobject_sendToBack(gobj);
@@ -963,6 +1183,9 @@ void GCompound::sendToFront(GObject* gobj) {
         return;
     }
     if (index != _contents.size() - 1) {
+        if (_index) {
+            _index->moveToFront(gobj);
+        }
         _contents.remove(index);
         _contents.add(gobj);
         conditionalRepaint();
@@ -973,14 +1196,70 @@ void GCompound::setAutoRepaint(bool autoRepaint) {
     _autoRepaint = autoRepaint;
 }
 
+void GCompound::setDirtyTracking(bool tracking) {
+    _dirtyAll = false;
+    _changeRecorded = false;
+    _dirtyRegions.clear();
+    _trackedBounds.clear();
+    _dirtyTracking = tracking;
+    if (tracking) {
+        _trackedBounds.reserve(static_cast<size_t>(_contents.size()));
+        for (GObject* gobj : _contents) {
+            trackGObject(gobj);
+        }
+    }
+}
+
+void GCompound::setSpatialIndexEnabled(bool enabled) {
+    if (enabled == isSpatialIndexEnabled()) {
+        return;
+    }
+    if (enabled) {
+        _index = new GSpatialIndex();
+        for (GObject* gobj : _contents) {
+            indexGObject(gobj);   // back to front, so stacking order matches
+        }
+    } else {
+        delete _index;
+        _index = nullptr;
+    }
+}
+
 void GCompound::setWidget(QWidget* widget) {
     _widget = widget;
 }
 
+bool GCompound::takeDirtyRegions(std::vector<GRectangle>& regions) {
+    bool all = _dirtyAll;
+    regions.clear();
+    regions.swap(_dirtyRegions);
+    _dirtyAll = false;
+    _changeRecorded = false;
+    return all;
+}
+
 std::string GCompound::toString() const {
     return "GCompound(...)";
 }
 
+/*
+ * Remembers the area the given object covers when drawn, so that the area
+ * can be repainted after the object moves away from it.  Returns false for
+ * transformed objects and nested compounds, which do not report reliable
+ * bounds; a change to one of those makes the whole compound dirty.
+ */
+bool GCompound::trackGObject(GObject* gobj) {
+    if (!_dirtyTracking) {
+        return false;
+    }
+    if (gobj->isTransformed() || dynamic_cast<GCompound*>(gobj)) {
+        _trackedBounds.erase(gobj);
+        return false;
+    }
+    _trackedBounds[gobj] = gobj->getBounds().enlargedBy((gobj->getLineWidth() + 1) / 2);
+    return true;
+}
+
 
 GImage::GImage(const std::string& filename, double x, double y)
         : GObject(x, y),
@@ -1004,9 +1283,7 @@ GImage::GImage(double width, double height) {
     require::nonNegative2D(width, height, "GImage::constructor", "width", "height");
     _width = width;
     _height = height;
-    GThread::runOnQtGuiThread([this]() {
-        _qimage = new QImage(static_cast<int>(_width), static_cast<int>(_height), QImage::Format_ARGB32);
-    });
+    _qimage = new QImage(static_cast<int>(_width), static_cast<int>(_height), QImage::Format_ARGB32);
 }
 
 GImage::GImage(QImage* qimage) {
@@ -1021,21 +1298,27 @@ GImage::~GImage() {
     _qimage = nullptr;
 }
 
+/*
+ * Implementation notes: load
+ * --------------------------
+ * The file is decoded (or found in the image cache) on the calling thread,
+ * so a slow decode does not stall the GUI; only the finished image is
+ * handed over to the Qt GUI thread.  The new QImage shares its pixels with
+ * the cached copy until either one is modified.
+ */
 bool GImage::load(const std::string& filename) {
     if (filename.empty() || !fileExists(filename)) {
         return false;
     }
-    bool hasError = false;
-    GThread::runOnQtGuiThread([this, filename, &hasError]() {
-        _qimage = new QImage;
-        if (_qimage->load(QString::fromStdString(_filename))) {
-            _width = _qimage->width();
-            _height = _qimage->height();
-        } else {
-            hasError = true;
-        }
-    });
-    return !hasError;   // *** BUGFIX thanks to Tyler Conklin
+    QImage image = GImageCache::instance()->load(filename);
+    if (image.isNull()) {
+        return false;
+    }
+    _qimage = new QImage(image);
+    discardScaledImage();
+    _width = _qimage->width();
+    _height = _qimage->height();
+    return true;
 }
 
 bool GImage::loadFromStream(std::istream& input) {
@@ -1045,18 +1328,13 @@ bool GImage::loadFromStream(std::istream& input) {
     std::string bytes = byteStream.str();
 
     // load image
-    bool hasError = false;
-    GThread::runOnQtGuiThread([&, this]() {
-        _qimage = new QImage;
-        if (_qimage->loadFromData(reinterpret_cast<const uchar *>(bytes.data()), bytes.size())) {
-            _width = _qimage->width();
-            _height = _qimage->height();
-        } else {
-            hasError = true;
-        }
-    });
-
-    return !hasError;
+    _qimage = new QImage;
+    if (!_qimage->loadFromData(reinterpret_cast<const uchar *>(bytes.data()), bytes.size())) {
+        return false;
+    }
+    _width = _qimage->width();
+    _height = _qimage->height();
+    return true;
 }
 
 void GImage::draw(QPainter* painter) {
@@ -1074,13 +1352,57 @@ void GImage::draw(QPainter* painter) {
     if (floatingPointEqual(myWidth, imgWidth) && floatingPointEqual(myHeight, imgHeight)) {
         // draw unscaled
         painter->drawImage((int) myX, (int) myY, *_qimage);
+    } else if (myWidth >= 1 && myHeight >= 1
+               && floatingPointEqual(myWidth, std::round(myWidth))
+               && floatingPointEqual(myHeight, std::round(myHeight))) {
+        // draw scaled, reusing the scaled copy from the last draw if the
+        // size and scaling quality are unchanged
+        int scaledWidth = (int) std::round(myWidth);
+        int scaledHeight = (int) std::round(myHeight);
+        bool smooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+        QImage scaled;
+        {
+            // setPixel and editPixels discard the copy on the student's thread
+            std::lock_guard<std::mutex> guard(_scaledLock);
+            if (_scaledImage.width() != scaledWidth
+                    || _scaledImage.height() != scaledHeight
+                    || _scaledSmooth != smooth) {
+                _scaledImage = _qimage->scaled(scaledWidth, scaledHeight, Qt::IgnoreAspectRatio,
+                                               smooth ? Qt::SmoothTransformation : Qt::FastTransformation);
+                _scaledSmooth = smooth;
+            }
+            scaled = _scaledImage;   // shares the pixels; cheap
+        }
+        painter->drawImage(QPointF(myX, myY), scaled);
     } else {
-        // draw scaled
+        // draw scaled to a fractional size
         QRectF rect(myX, myY, myWidth, myHeight);
         painter->drawImage(rect, *_qimage);
     }
 }
 
+void GImage::discardScaledImage() {
+    std::lock_guard<std::mutex> guard(_scaledLock);
+    _scaledImage = QImage();
+}
+
+void GImage::editPixels(std::function<void(PixelView& pixels)> func) {
+    if (!_qimage || _qimage->isNull()) {
+        PixelView empty;
+        func(empty);
+        return;
+    }
+    if (_qimage->format() != QImage::Format_ARGB32) {
+        *_qimage = _qimage->convertToFormat(QImage::Format_ARGB32);
+    }
+    PixelView pixels(reinterpret_cast<unsigned int*>(_qimage->bits()),
+                     _qimage->width(),
+                     _qimage->height(),
+                     static_cast<int>(_qimage->bytesPerLine() / sizeof(unsigned int)));
+    func(pixels);
+    discardScaledImage();   // after the edit, so a draw in between cannot cache old pixels
+}
+
 std::string GImage::getFileName() const {
     return _filename;
 }
@@ -1098,8 +1420,32 @@ std::string GImage::getType() const {
     return "GImage";
 }
 
+/*
+ * Implementation notes: readPixels
+ * --------------------------------
+ * Images loaded from files may be stored in any QImage format; if this one
+ * is not 32-bit ARGB, the function is shown a converted copy.
+ */
+void GImage::readPixels(std::function<void(const PixelView& pixels)> func) const {
+    if (!_qimage || _qimage->isNull()) {
+        func(PixelView());
+        return;
+    }
+    QImage converted;
+    const QImage* image = _qimage;
+    if (_qimage->format() != QImage::Format_ARGB32) {
+        converted = _qimage->convertToFormat(QImage::Format_ARGB32);
+        image = &converted;
+    }
+    func(PixelView(reinterpret_cast<unsigned int*>(const_cast<uchar*>(image->constBits())),
+                   image->width(),
+                   image->height(),
+                   static_cast<int>(image->bytesPerLine() / sizeof(unsigned int))));
+}
+
 void GImage::setPixel(int x, int y, int rgb) {
     _qimage->setPixel(x, y, rgb);
+    discardScaledImage();
 }
 
 std::string GImage::toStringExtra() const {
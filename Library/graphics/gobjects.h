@@ -6,6 +6,12 @@
  * <include src="pictures/ClassHierarchies/GObjectHierarchy-h.html">
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added GImage readPixels/editPixels for direct scanline access
+ * - added optional GCompound spatial index and dirty-rectangle culling
+ * - GImage shares decoded files through GImageCache and caches its scaled copy
+ * - added GCompound dirty-region tracking for frame-based repainting
+ * - added GObject setColor/setFillColor overloads taking a GColor::Handle
  * @version 2019/05/05
  * - added predictable GLine point ordering
  * @version 2019/04/23
@@ -27,20 +33,28 @@
 #ifndef _gobjects_h
 #define _gobjects_h
 
+#include <functional>
 #include <initializer_list>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <QFont>
 #include <QImage>
 #include <QPainter>
 #include <QPen>
 #include <QWidget>
 
+#include "gcolor.h"
+#include "gpixelview.h"
 #include "gtypes.h"
+#include "hashset.h"
 #include "vector.h"
 
 class GCanvas;
 class GCompound;
 class GDiffImage;
+class GSpatialIndex;
 
 /**
  * This class is the common superclass of all graphical objects that can
@@ -410,6 +424,12 @@ public:
      */
     virtual void setColor(const std::string& color);
 
+    /**
+     * Sets the color used to display this object to the given interned color.
+     * This is the fastest way to set a color; see GColor::intern.
+     */
+    virtual void setColor(const GColor::Handle& color);
+
     /**
      * Sets the color used to display the filled region of this object, if any.
      * As a side effect, sets this object to be filled (setFilled(true)).
@@ -441,6 +461,14 @@ public:
      */
     virtual void setFillColor(const std::string& color);
 
+    /**
+     * Sets the color used to display the filled region of this object to the
+     * given interned color; see GColor::intern.
+     * As a side effect, sets this object to be filled, unless the handle
+     * stands for no color, in which case it sets filled to false.
+     */
+    virtual void setFillColor(const GColor::Handle& color);
+
     /**
      * Sets the fill status for the object, where <code>false</code> is
      * outlined and <code>true</code> is filled.
@@ -639,6 +667,7 @@ protected:
     virtual std::string toStringExtra() const;
 
     friend class GArc;
+    friend class GCanvas;
     friend class GCompound;
     friend class GImage;
     friend class GInteractor;
@@ -767,6 +796,12 @@ public:
      */
     GCompound();
 
+    /**
+     * Frees memory allocated internally by the compound.
+     * Does not free the graphical objects stored in the compound.
+     */
+    virtual ~GCompound();
+
     /**
      * Adds a new graphical object to the compound, if that object was not
      * already present in the compound.
@@ -797,6 +832,13 @@ public:
      */
     virtual void add(GObject& gobj, double x, double y);
 
+    /**
+     * Records that the given rectangle of the compound needs repainting.
+     * Has no effect unless dirty tracking is on; see setDirtyTracking.
+     * @private
+     */
+    virtual void addDirtyRegion(const GRectangle& bounds);
+
     /**
      * Removes all graphical objects from the compound.
      * Equivalent to removeAll.
@@ -826,6 +868,8 @@ public:
 
     /**
      * Draws all objects stored in this compound using the given painter pen.
+     * If the painter has a clip region, such as the dirty region passed to
+     * a widget's paint event, only objects that touch it are drawn.
      * @private
      */
     void draw(QPainter* painter) override;
@@ -870,11 +914,31 @@ public:
      */
     virtual bool isAutoRepaint() const;
 
+    /**
+     * Returns whether the compound is recording the regions that change.
+     * See setDirtyTracking.
+     * @private
+     */
+    virtual bool isDirtyTracking() const;
+
     /**
      * Returns true if the compound does not contain any graphical objects.
      */
     virtual bool isEmpty() const;
 
+    /**
+     * Returns whether the compound keeps a spatial index of its objects.
+     * See setSpatialIndexEnabled.
+     */
+    virtual bool isSpatialIndexEnabled() const;
+
+    /**
+     * Records that the whole compound needs repainting.
+     * Has no effect unless dirty tracking is on; see setDirtyTracking.
+     * @private
+     */
+    virtual void markDirty();
+
     /**
      * Removes the specified object from the compound.
      * @throw ErrorException if the object is null
@@ -915,6 +979,30 @@ public:
      */
     virtual void setAutoRepaint(bool autoRepaint);
 
+    /**
+     * Sets whether the compound records the regions that change.
+     * While tracking is on, every change that would repaint part of the
+     * compound also adds that part to a list of dirty regions, including
+     * the old location of an object that moves or shrinks.
+     * GCanvas turns tracking on between beginFrame and endFrame, and uses
+     * the list to repaint everything that changed during the frame at once.
+     * Turning tracking on or off discards any regions already recorded.
+     * @private
+     */
+    virtual void setDirtyTracking(bool tracking);
+
+    /**
+     * Sets whether the compound keeps a spatial index of its objects.
+     * The index records which objects lie in each area of the compound, so
+     * that getElementAt, contains, and repainting a small region only need
+     * to look at the objects near that point or region instead of at every
+     * object.  This makes a big difference for compounds holding many
+     * thousands of objects, at the cost of a little work each time an
+     * object is added, removed, moved, or resized.
+     * Initially the index is disabled.
+     */
+    virtual void setSpatialIndexEnabled(bool enabled);
+
     /**
      * Sets the Qt widget associated with this compound, or a null pointer
      * if this compound is not associated with any widget.
@@ -925,6 +1013,15 @@ public:
      */
     virtual void setWidget(QWidget* widget);
 
+    /**
+     * Moves the dirty regions recorded since tracking was turned on, or
+     * since the last call to this method, into the given vector and clears
+     * them.  Returns true if the whole compound is dirty, in which case the
+     * vector is left empty.
+     * @private
+     */
+    virtual bool takeDirtyRegions(std::vector<GRectangle>& regions);
+
     /* @inherit */
     std::string toString() const override;
 
@@ -937,16 +1034,32 @@ private:
     virtual int findGObject(GObject* gobj) const;
     virtual void removeAt(int index);
 
+    // methods to keep the spatial index and dirty regions up to date
+    void indexGObject(GObject* gobj, bool addIfMissing = true);
+    void notifyOfChange(GObject* gobj);
+    bool trackGObject(GObject* gobj);
+
     // instance variables
     Vector<GObject*> _contents;
+    HashSet<GObject*> _contentsSet;   // same objects as _contents, for fast lookup
+    GSpatialIndex* _index = nullptr;  // null if spatial index is disabled
     QWidget* _widget = nullptr;    // widget containing this compound
     bool _autoRepaint;   // automatically repaint on any change; default true
 
+    // dirty-region tracking; see setDirtyTracking
+    bool _dirtyTracking = false;
+    bool _dirtyAll = false;         // whole compound needs repainting
+    bool _changeRecorded = false;   // notifyOfChange already recorded the change
+    std::vector<GRectangle> _dirtyRegions;
+    std::unordered_map<GObject*, GRectangle> _trackedBounds;   // last known painted area
+
     friend class GObject;
 };
 
 /**
  * This graphical object subclass represents an image from a file.
+ * Image files are decoded through the shared GImageCache, so creating many
+ * GImages from the same file reads and decodes it only once.
  */
 class GImage : public GObject {
 public:
@@ -989,6 +1102,14 @@ public:
      */
     void draw(QPainter* painter) override;
 
+    /**
+     * Calls the given function with a PixelView of the image's pixels,
+     * through which it may read and modify them directly.
+     * This is much faster than calling getPixel/setPixel for every pixel.
+     * The view must not be used after the function returns.
+     */
+    virtual void editPixels(std::function<void(PixelView& pixels)> func);
+
     /**
      * Returns the file name used to load the image,
      * as was passed to the constructor.
@@ -1004,6 +1125,13 @@ public:
     /* @inherit */
     std::string getType() const override;
 
+    /**
+     * Calls the given function with a read-only PixelView of the image's
+     * pixels.
+     * The view must not be used after the function returns.
+     */
+    virtual void readPixels(std::function<void(const PixelView& pixels)> func) const;
+
     /**
      * Sets the pixel at the given x/y location to the given color,
      * represented as an RGB integer.
@@ -1027,6 +1155,11 @@ protected:
     QImage* getQImage() const;
 
 private:
+    /**
+     * Throws away the scaled copy of the image after its pixels change.
+     */
+    void discardScaledImage();
+
     /**
      * Reads the image's pixel contents from the given file.
      * @return true if loaded successfully and false if the load failed
@@ -1041,6 +1174,9 @@ private:
 
     std::string _filename;
     QImage* _qimage;
+    QImage _scaledImage;          // _qimage scaled to the display size, or null
+    bool _scaledSmooth = false;   // whether _scaledImage was smoothly scaled
+    std::mutex _scaledLock;       // guards the two above; draw runs on the GUI thread
 
     friend class GCanvas;
     friend class GDiffImage;
@@ -0,0 +1,231 @@
+/*
+ * File: goffscreencanvas.cpp
+ * --------------------------
+ * This file implements the goffscreencanvas.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "goffscreencanvas.h"
+#include <QString>
+#include "error.h"
+#include "gcolor.h"
+#include "require.h"
+
+GOffscreenCanvas::GOffscreenCanvas(double width, double height, int rgbBackground) {
+    init(width, height, rgbBackground);
+}
+
+GOffscreenCanvas::GOffscreenCanvas(double width, double height, const std::string& rgbBackground) {
+    init(width, height, GColor::hasAlpha(rgbBackground)
+                        ? GColor::convertColorToARGB(rgbBackground)
+                        : GColor::convertColorToRGB(rgbBackground));
+}
+
+GOffscreenCanvas::~GOffscreenCanvas() {
+    _contents.removeAll();
+}
+
+void GOffscreenCanvas::add(GObject* gobj) {
+    require::nonNull(gobj, "GOffscreenCanvas::add");
+    _contents.add(gobj);
+}
+
+void GOffscreenCanvas::add(GObject* gobj, double x, double y) {
+    require::nonNull(gobj, "GOffscreenCanvas::add");
+    _contents.add(gobj, x, y);
+}
+
+void GOffscreenCanvas::clear() {
+    clearObjects();
+    clearPixels();
+}
+
+void GOffscreenCanvas::clearObjects() {
+    _contents.removeAll();
+}
+
+void GOffscreenCanvas::clearPixels() {
+    _image.fill(static_cast<unsigned int>(GColor::fixAlpha(_backgroundColorInt)));
+}
+
+/*
+ * Implementation notes: draw
+ * --------------------------
+ * GCanvas draws on its background image from the Qt GUI thread; here the
+ * painter is used directly on the calling thread, which Qt allows for
+ * painting on a QImage.
+ */
+void GOffscreenCanvas::draw(GObject* gobj) {
+    require::nonNull(gobj, "GOffscreenCanvas::draw");
+    if (!gobj->isVisible() || _image.isNull()) {
+        return;
+    }
+    QPainter painter(&_image);
+    painter.setRenderHint(QPainter::Antialiasing, GObject::isAntiAliasing());
+    painter.setRenderHint(QPainter::TextAntialiasing, GObject::isAntiAliasing());
+    gobj->draw(&painter);
+    painter.end();
+}
+
+void GOffscreenCanvas::draw(QPainter* painter) {
+    if (!painter) {
+        return;
+    }
+    painter->drawImage(/* x */ 0, /* y */ 0, _image);
+    _contents.draw(painter);
+}
+
+void GOffscreenCanvas::editPixels(std::function<void(PixelView& pixels)> func) {
+    PixelView pixels = pixelView();
+    func(pixels);
+}
+
+void GOffscreenCanvas::fill(int rgb) {
+    _image.fill(static_cast<unsigned int>(rgb) | 0xff000000);
+}
+
+void GOffscreenCanvas::fill(const std::string& color) {
+    fill(GColor::convertColorToRGB(color));
+}
+
+int GOffscreenCanvas::getElementCount() const {
+    return _contents.getElementCount();
+}
+
+double GOffscreenCanvas::getHeight() const {
+    return _image.height();
+}
+
+int GOffscreenCanvas::getPixel(double x, double y) const {
+    checkBounds("GOffscreenCanvas::getPixel", x, y, getWidth(), getHeight());
+    return static_cast<int>(_image.pixel(static_cast<int>(x), static_cast<int>(y)) & 0x00ffffff);
+}
+
+int GOffscreenCanvas::getPixelARGB(double x, double y) const {
+    checkBounds("GOffscreenCanvas::getPixelARGB", x, y, getWidth(), getHeight());
+    return static_cast<int>(_image.pixel(static_cast<int>(x), static_cast<int>(y)));
+}
+
+Grid<int> GOffscreenCanvas::getPixels() const {
+    Grid<int> grid;
+    pixelView().toGrid(grid, /* mask */ 0x00ffffff);
+    return grid;
+}
+
+Grid<int> GOffscreenCanvas::getPixelsARGB() const {
+    Grid<int> grid;
+    pixelView().toGrid(grid);
+    return grid;
+}
+
+double GOffscreenCanvas::getWidth() const {
+    return _image.width();
+}
+
+void GOffscreenCanvas::init(double width, double height, int rgbBackground) {
+    require::nonNegative2D(width, height, "GOffscreenCanvas::constructor", "width", "height");
+    _image = QImage(static_cast<int>(width), static_cast<int>(height), QImage::Format_ARGB32);
+    _contents.setAutoRepaint(false);
+    GDrawingSurface::setBackground(rgbBackground);
+    clearPixels();
+}
+
+void GOffscreenCanvas::paintObjects(QPainter& painter) const {
+    painter.setRenderHint(QPainter::Antialiasing, GObject::isAntiAliasing());
+    painter.setRenderHint(QPainter::TextAntialiasing, GObject::isAntiAliasing());
+    const_cast<GCompound&>(_contents).draw(&painter);
+}
+
+PixelView GOffscreenCanvas::pixelView() const {
+    if (_image.isNull()) {
+        return PixelView();
+    }
+    // the non-const bits() detaches the image from any copy returned by
+    // toQImage, so changes made through the view never show up in such a copy
+    QImage& image = const_cast<QImage&>(_image);
+    return PixelView(reinterpret_cast<unsigned int*>(image.bits()),
+                     image.width(),
+                     image.height(),
+                     static_cast<int>(image.bytesPerLine() / sizeof(unsigned int)));
+}
+
+void GOffscreenCanvas::readPixels(std::function<void(const PixelView& pixels)> func) const {
+    func(pixelView());
+}
+
+void GOffscreenCanvas::remove(GObject* gobj) {
+    require::nonNull(gobj, "GOffscreenCanvas::remove");
+    _contents.remove(gobj);
+}
+
+void GOffscreenCanvas::repaint() {
+    // empty; nothing is on screen
+}
+
+void GOffscreenCanvas::repaintRegion(int /* x */, int /* y */, int /* width */, int /* height */) {
+    // empty; nothing is on screen
+}
+
+void GOffscreenCanvas::save(const std::string& filename) const {
+    QImage image = toQImage();
+    if (!image.save(QString::fromStdString(filename))) {
+        error("GOffscreenCanvas::save: failed to save to " + filename);
+    }
+}
+
+void GOffscreenCanvas::setBackground(int color) {
+    GDrawingSurface::setBackground(color);
+    clearPixels();
+}
+
+void GOffscreenCanvas::setBackground(const std::string& color) {
+    setBackground(GColor::hasAlpha(color)
+                  ? GColor::convertColorToARGB(color)
+                  : GColor::convertColorToRGB(color));
+}
+
+void GOffscreenCanvas::setPixel(double x, double y, int rgb) {
+    require::inRange2D(x, y, getWidth() - 1, getHeight() - 1, "GOffscreenCanvas::setPixel", "x", "y");
+    _image.setPixel(static_cast<int>(x), static_cast<int>(y),
+                    static_cast<unsigned int>(GColor::fixAlpha(rgb)));
+}
+
+void GOffscreenCanvas::setPixel(double x, double y, int r, int g, int b) {
+    GDrawingSurface::setPixel(x, y, r, g, b);
+}
+
+void GOffscreenCanvas::setPixelARGB(double x, double y, int argb) {
+    require::inRange2D(x, y, getWidth() - 1, getHeight() - 1, "GOffscreenCanvas::setPixelARGB", "x", "y");
+    _image.setPixel(static_cast<int>(x), static_cast<int>(y), static_cast<unsigned int>(argb));
+}
+
+void GOffscreenCanvas::setPixelARGB(double x, double y, int a, int r, int g, int b) {
+    GDrawingSurface::setPixelARGB(x, y, a, r, g, b);
+}
+
+void GOffscreenCanvas::setPixels(const Grid<int>& pixels) {
+    if (pixels.numCols() != (int) getWidth() || pixels.numRows() != (int) getHeight()) {
+        error("GOffscreenCanvas::setPixels: wrong size");
+    }
+    pixelView().fromGrid(pixels, PixelView::ALPHA_OPAQUE);
+}
+
+void GOffscreenCanvas::setPixelsARGB(const Grid<int>& pixelsARGB) {
+    if (pixelsARGB.numCols() != (int) getWidth() || pixelsARGB.numRows() != (int) getHeight()) {
+        error("GOffscreenCanvas::setPixelsARGB: wrong size");
+    }
+    pixelView().fromGrid(pixelsARGB, PixelView::ALPHA_KEEP);
+}
+
+QImage GOffscreenCanvas::toQImage() const {
+    if (_contents.isEmpty()) {
+        return _image;   // shares pixels until one copy is changed
+    }
+    QImage image = _image.copy();
+    QPainter painter(&image);
+    paintObjects(painter);
+    painter.end();
+    return image;
+}
@@ -0,0 +1,230 @@
+/*
+ * File: goffscreencanvas.h
+ * ------------------------
+ * This file defines the GOffscreenCanvas class, a drawing surface that
+ * renders into an image in memory rather than into a window.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+
+#ifndef _goffscreencanvas_h
+#define _goffscreencanvas_h
+
+#include <functional>
+#include <string>
+#include <QImage>
+#include <QPainter>
+
+#include "gdrawingsurface.h"
+#include "gobjects.h"
+#include "gpixelview.h"
+#include "grid.h"
+
+/**
+ * A GOffscreenCanvas is a drawing surface like GCanvas that is not an
+ * interactor and is never shown on the screen.  It is meant for programs
+ * that produce images in bulk, such as thumbnails or charts, possibly on a
+ * server with no display.
+ *
+ * Like a GCanvas, it has a background layer of pixels, which the drawXxx,
+ * fillXxx, and setPixel methods change permanently, and a list of graphical
+ * objects added with add, which are drawn on top of the background whenever
+ * the canvas is saved or converted to an image.
+ *
+ * Unlike a GCanvas, a GOffscreenCanvas does all of its work on the thread
+ * that calls it and never waits for the Qt GUI thread, so several threads
+ * can render at the same time as long as each uses its own canvas and its
+ * own graphical objects.  A single GOffscreenCanvas must not be used by
+ * more than one thread at once.
+ *
+ * Drawing text requires the Qt graphics subsystem to have been started,
+ * which the library does automatically before main runs.  On a machine
+ * with no display, the library uses Qt's offscreen platform instead of
+ * failing to start.
+ */
+class GOffscreenCanvas : public virtual GDrawingSurface {
+public:
+    /**
+     * Creates a new canvas of the given size, filled with the given
+     * background color (white by default).
+     * @throw ErrorException if the width or height is negative
+     */
+    GOffscreenCanvas(double width, double height, int rgbBackground = 0xffffff);
+
+    /**
+     * Creates a new canvas of the given size, filled with the given
+     * background color.
+     * @throw ErrorException if the width or height is negative
+     */
+    GOffscreenCanvas(double width, double height, const std::string& rgbBackground);
+
+    /**
+     * Frees memory allocated internally by the canvas.
+     */
+    ~GOffscreenCanvas() override;
+
+    /**
+     * Adds the given graphical object to the canvas, on top of all others.
+     * The object must stay alive while it is in the canvas; the canvas does
+     * not free it.
+     * @throw ErrorException if the object is null
+     */
+    virtual void add(GObject* gobj);
+
+    /**
+     * Moves the given graphical object to the given location and adds it to
+     * the canvas, on top of all others.
+     * @throw ErrorException if the object is null
+     */
+    virtual void add(GObject* gobj, double x, double y);
+
+    /**
+     * Removes all graphical objects and fills the background layer with
+     * the background color.
+     */
+    void clear() override;
+
+    /**
+     * Removes all graphical objects, leaving the background layer as it is.
+     */
+    virtual void clearObjects();
+
+    /**
+     * Fills the background layer with the background color,
+     * leaving any added graphical objects as they are.
+     */
+    virtual void clearPixels();
+
+    /* @inherit */
+    void draw(GObject* gobj) override;
+
+    /**
+     * Draws the background layer and then every added object onto the
+     * given painter.
+     */
+    void draw(QPainter* painter) override;
+
+    /**
+     * Calls the given function with a PixelView over the background layer
+     * so that it can change the pixels in place.
+     * The view is valid only during the call.
+     */
+    virtual void editPixels(std::function<void(PixelView& pixels)> func);
+
+    /**
+     * Sets every pixel of the background layer to the given RGB color.
+     */
+    virtual void fill(int rgb);
+
+    /**
+     * Sets every pixel of the background layer to the given color.
+     */
+    virtual void fill(const std::string& color);
+
+    /**
+     * Returns the number of graphical objects that have been added.
+     */
+    virtual int getElementCount() const;
+
+    /**
+     * Returns the height of the canvas in pixels.
+     */
+    virtual double getHeight() const;
+
+    /* @inherit */
+    int getPixel(double x, double y) const override;
+
+    /* @inherit */
+    int getPixelARGB(double x, double y) const override;
+
+    /* @inherit */
+    Grid<int> getPixels() const override;
+
+    /* @inherit */
+    Grid<int> getPixelsARGB() const override;
+
+    /**
+     * Returns the width of the canvas in pixels.
+     */
+    virtual double getWidth() const;
+
+    /**
+     * Calls the given function with a read-only PixelView over the
+     * background layer.  The view is valid only during the call.
+     */
+    virtual void readPixels(std::function<void(const PixelView& pixels)> func) const;
+
+    /**
+     * Removes the given graphical object from the canvas.
+     * Has no effect if the object was not added to this canvas.
+     */
+    virtual void remove(GObject* gobj);
+
+    /**
+     * Does nothing, since an offscreen canvas is not displayed.
+     */
+    void repaint() override;
+
+    /**
+     * Does nothing, since an offscreen canvas is not displayed.
+     */
+    void repaintRegion(int x, int y, int width, int height) override;
+
+    /**
+     * Saves the canvas, including its added objects, to the given image file.
+     * The file's extension determines its format.
+     * @throw ErrorException if the file cannot be written
+     */
+    virtual void save(const std::string& filename) const;
+
+    /**
+     * Sets the background color and fills the background layer with it,
+     * erasing anything drawn on it.
+     */
+    void setBackground(int color) override;
+
+    /**
+     * Sets the background color and fills the background layer with it,
+     * erasing anything drawn on it.
+     */
+    void setBackground(const std::string& color) override;
+
+    /* @inherit */
+    void setPixel(double x, double y, int rgb) override;
+
+    /* @inherit */
+    void setPixel(double x, double y, int r, int g, int b) override;
+
+    /* @inherit */
+    void setPixelARGB(double x, double y, int argb) override;
+
+    /* @inherit */
+    void setPixelARGB(double x, double y, int a, int r, int g, int b) override;
+
+    /* @inherit */
+    void setPixels(const Grid<int>& pixels) override;
+
+    /* @inherit */
+    void setPixelsARGB(const Grid<int>& pixelsARGB) override;
+
+    /**
+     * Returns a copy of the canvas as an image, with the added objects
+     * drawn on top of the background layer.
+     */
+    virtual QImage toQImage() const;
+
+private:
+    GOffscreenCanvas(const GOffscreenCanvas&) = delete;
+    GOffscreenCanvas& operator =(const GOffscreenCanvas&) = delete;
+
+    void init(double width, double height, int rgbBackground);
+    void paintObjects(QPainter& painter) const;
+    PixelView pixelView() const;
+
+    QImage _image;       // the background layer
+    GCompound _contents; // objects added with add()
+};
+
+#endif // _goffscreencanvas_h
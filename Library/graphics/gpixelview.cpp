@@ -0,0 +1,197 @@
+/*
+ * File: gpixelview.cpp
+ * --------------------
+ * This file implements the gpixelview.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "gpixelview.h"
+#include <algorithm>
+#include <cstring>
+#include "error.h"
+#include "require.h"
+
+/*
+ * Implementation notes: kernels
+ * -----------------------------
+ * Every bulk operation walks the view one row at a time and does its work
+ * in a plain loop over that row's pixels, with no function calls or
+ * bounds checks inside the loop, so that the compiler can vectorize it.
+ * Where a row of the source and destination have the same layout, the row
+ * is copied with memcpy.
+ */
+
+int PixelView::countDiff(const PixelView& a, const PixelView& b, unsigned int mask) {
+    int width = std::min(a._width, b._width);
+    int height = std::min(a._height, b._height);
+    int count = 0;
+    for (int y = 0; y < height; y++) {
+        const unsigned int* rowA = a._pixels + static_cast<size_t>(y) * a._stride;
+        const unsigned int* rowB = b._pixels + static_cast<size_t>(y) * b._stride;
+        int rowCount = 0;
+        for (int x = 0; x < width; x++) {
+            rowCount += ((rowA[x] ^ rowB[x]) & mask) != 0;
+        }
+        count += rowCount;
+    }
+    return count;
+}
+
+PixelView::PixelView()
+        : _pixels(nullptr),
+          _width(0),
+          _height(0),
+          _stride(0) {
+    // empty
+}
+
+PixelView::PixelView(unsigned int* pixels, int width, int height, int stride)
+        : _pixels(pixels),
+          _width(width),
+          _height(height),
+          _stride(stride) {
+    require::nonNegative2D(width, height, "PixelView::constructor", "width", "height");
+    if (stride < width) {
+        error("PixelView::constructor: stride cannot be less than width");
+    }
+    if (!pixels && width > 0 && height > 0) {
+        error("PixelView::constructor: pixels cannot be null");
+    }
+}
+
+PixelView::PixelView(Grid<int>& grid)
+        : _pixels(nullptr),
+          _width(grid.numCols()),
+          _height(grid.numRows()),
+          _stride(grid.numCols()) {
+    if (!isEmpty()) {
+        _pixels = reinterpret_cast<unsigned int*>(&grid[0][0]);
+    }
+}
+
+/*
+ * Implementation notes: blend
+ * ---------------------------
+ * The red and blue channels are blended together in one 32-bit multiply,
+ * since each 8-bit channel times a weight of at most 256 still fits in the
+ * 16 bits reserved for it; green is blended separately.
+ */
+void PixelView::blend(const PixelView& src, int opacity) {
+    require::inRange(opacity, 0, 255, "PixelView::blend", "opacity");
+    int width = std::min(_width, src._width);
+    int height = std::min(_height, src._height);
+    for (int y = 0; y < height; y++) {
+        unsigned int* dst = _pixels + static_cast<size_t>(y) * _stride;
+        const unsigned int* from = src._pixels + static_cast<size_t>(y) * src._stride;
+        for (int x = 0; x < width; x++) {
+            unsigned int s = from[x];
+            unsigned int d = dst[x];
+            unsigned int a = ((s >> 24) * static_cast<unsigned int>(opacity) + 127) / 255;
+            unsigned int w = a + (a >> 7);   // 0-255 => 0-256
+            unsigned int rb = (((d & 0x00ff00ff) * (256 - w) + (s & 0x00ff00ff) * w) >> 8) & 0x00ff00ff;
+            unsigned int g = (((d & 0x0000ff00) * (256 - w) + (s & 0x0000ff00) * w) >> 8) & 0x0000ff00;
+            unsigned int da = d >> 24;
+            unsigned int outA = a + (da * (255 - a) + 127) / 255;
+            dst[x] = (outA << 24) | rb | g;
+        }
+    }
+}
+
+void PixelView::copyFrom(const PixelView& src) {
+    int width = std::min(_width, src._width);
+    int height = std::min(_height, src._height);
+    if (width <= 0) {
+        return;
+    }
+    for (int y = 0; y < height; y++) {
+        std::memmove(_pixels + static_cast<size_t>(y) * _stride,
+                     src._pixels + static_cast<size_t>(y) * src._stride,
+                     static_cast<size_t>(width) * sizeof(unsigned int));
+    }
+}
+
+void PixelView::fill(unsigned int argb) {
+    for (int y = 0; y < _height; y++) {
+        unsigned int* dst = _pixels + static_cast<size_t>(y) * _stride;
+        std::fill(dst, dst + _width, argb);
+    }
+}
+
+void PixelView::fromGrid(const Grid<int>& grid, AlphaMode mode) {
+    int width = std::min(_width, grid.numCols());
+    int height = std::min(_height, grid.numRows());
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    const unsigned int* src = reinterpret_cast<const unsigned int*>(&grid.get(0, 0));
+    for (int y = 0; y < height; y++) {
+        unsigned int* dst = _pixels + static_cast<size_t>(y) * _stride;
+        const unsigned int* from = src + static_cast<size_t>(y) * grid.numCols();
+        if (mode == ALPHA_KEEP) {
+            std::memcpy(dst, from, static_cast<size_t>(width) * sizeof(unsigned int));
+        } else if (mode == ALPHA_OPAQUE) {
+            for (int x = 0; x < width; x++) {
+                dst[x] = from[x] | 0xff000000;
+            }
+        } else {
+            for (int x = 0; x < width; x++) {
+                unsigned int v = from[x];
+                dst[x] = (v & 0xff000000) ? v : (v | 0xff000000);
+            }
+        }
+    }
+}
+
+unsigned int PixelView::getPixel(int x, int y) const {
+    require::inRange2D(x, y, _width - 1, _height - 1, "PixelView::getPixel", "x", "y");
+    return _pixels[static_cast<size_t>(y) * _stride + x];
+}
+
+unsigned int* PixelView::row(int y) {
+    require::inRange(y, 0, _height - 1, "PixelView::row", "y");
+    return _pixels + static_cast<size_t>(y) * _stride;
+}
+
+const unsigned int* PixelView::row(int y) const {
+    require::inRange(y, 0, _height - 1, "PixelView::row", "y");
+    return _pixels + static_cast<size_t>(y) * _stride;
+}
+
+void PixelView::setPixel(int x, int y, unsigned int argb) {
+    require::inRange2D(x, y, _width - 1, _height - 1, "PixelView::setPixel", "x", "y");
+    _pixels[static_cast<size_t>(y) * _stride + x] = argb;
+}
+
+PixelView PixelView::subview(int x, int y, int width, int height) const {
+    require::nonNegative2D(width, height, "PixelView::subview", "width", "height");
+    if (x < 0 || y < 0 || x + width > _width || y + height > _height) {
+        error("PixelView::subview: region does not fit inside view");
+    }
+    PixelView result;
+    result._pixels = _pixels + static_cast<size_t>(y) * _stride + x;
+    result._width = width;
+    result._height = height;
+    result._stride = _stride;
+    return result;
+}
+
+void PixelView::toGrid(Grid<int>& grid, unsigned int mask) const {
+    grid.resize(_height, _width);
+    if (isEmpty()) {
+        return;
+    }
+    unsigned int* dst = reinterpret_cast<unsigned int*>(&grid[0][0]);
+    for (int y = 0; y < _height; y++) {
+        const unsigned int* from = _pixels + static_cast<size_t>(y) * _stride;
+        unsigned int* to = dst + static_cast<size_t>(y) * _width;
+        if (mask == 0xffffffff) {
+            std::memcpy(to, from, static_cast<size_t>(_width) * sizeof(unsigned int));
+        } else {
+            for (int x = 0; x < _width; x++) {
+                to[x] = from[x] & mask;
+            }
+        }
+    }
+}
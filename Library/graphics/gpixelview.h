@@ -0,0 +1,192 @@
+/*
+ * File: gpixelview.h
+ * ------------------
+ * This file defines the PixelView class, a lightweight view over a
+ * rectangular block of 32-bit ARGB pixels such as the background layer of
+ * a GCanvas or the storage of a Grid<int>.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+
+#ifndef _gpixelview_h
+#define _gpixelview_h
+
+#include "grid.h"
+
+/**
+ * A PixelView gives direct access to a block of 32-bit ARGB pixels laid out
+ * one row (scanline) after another, with a fixed distance called the
+ * <i>stride</i> between the start of each row.
+ * The view does not own its pixels; it simply refers to memory owned by
+ * something else, such as a GCanvas or a Grid.
+ *
+ * You do not normally construct a PixelView over a canvas yourself.
+ * Instead, call GCanvas::readPixels or GCanvas::editPixels, which lock the
+ * canvas and pass you a view that is valid for the duration of the call:
+ *
+ * <pre>
+ *     canvas->editPixels([](PixelView& pixels) {
+ *         for (int y = 0; y < pixels.getHeight(); y++) {
+ *             unsigned int* row = pixels.row(y);
+ *             for (int x = 0; x < pixels.getWidth(); x++) {
+ *                 row[x] ^= 0x00ffffff;   // invert colors
+ *             }
+ *         }
+ *     });
+ * </pre>
+ *
+ * Working a whole row at a time through row() is far faster than calling
+ * getPixel/setPixel once per pixel, because it avoids a bounds check and
+ * a function call for every pixel.
+ * The bulk operations fill, copyFrom, blend, countDiff, toGrid, and
+ * fromGrid are written as simple loops over rows that the compiler can
+ * vectorize.
+ */
+class PixelView {
+public:
+    /**
+     * Ways of treating the alpha channel when copying pixels in from a grid.
+     * ALPHA_KEEP copies values unchanged; ALPHA_OPAQUE makes every pixel fully
+     * opaque; ALPHA_FIX makes only pixels whose alpha is 0 fully opaque, so
+     * that plain RGB values like 0xff00ff are treated as opaque colors.
+     */
+    enum AlphaMode {
+        ALPHA_KEEP,
+        ALPHA_OPAQUE,
+        ALPHA_FIX
+    };
+
+    /**
+     * Returns the number of pixels that differ between the overlapping
+     * portions of the two given views.
+     * Only the bits set in the given mask are compared; by default the
+     * alpha channel is ignored.
+     */
+    static int countDiff(const PixelView& a, const PixelView& b,
+                         unsigned int mask = 0x00ffffff);
+
+    /**
+     * Constructs an empty 0x0 view.
+     */
+    PixelView();
+
+    /**
+     * Constructs a view over the given pixel memory.
+     * The stride is the number of pixels (not bytes) from the start of one
+     * row to the start of the next, and must be at least the width.
+     * @throw ErrorException if the width, height, or stride are invalid
+     */
+    PixelView(unsigned int* pixels, int width, int height, int stride);
+
+    /**
+     * Constructs a view over the elements of the given grid, where rows
+     * represent y values and columns represent x values.
+     * The view is invalidated if the grid is resized.
+     */
+    PixelView(Grid<int>& grid);
+
+    /**
+     * Alpha-blends the overlapping portion of the given source view onto
+     * this view, using each source pixel's alpha multiplied by the given
+     * opacity from 0-255.
+     * If the destination pixels are opaque, this is exactly the usual
+     * "source over" compositing.
+     */
+    void blend(const PixelView& src, int opacity = 255);
+
+    /**
+     * Copies the overlapping portion of the given source view into this view.
+     */
+    void copyFrom(const PixelView& src);
+
+    /**
+     * Sets every pixel in this view to the given ARGB value.
+     */
+    void fill(unsigned int argb);
+
+    /**
+     * Copies pixels from the overlapping portion of the given grid into this
+     * view, treating the alpha channel according to the given mode.
+     */
+    void fromGrid(const Grid<int>& grid, AlphaMode mode = ALPHA_KEEP);
+
+    /**
+     * Returns the number of rows in the view.
+     */
+    int getHeight() const {
+        return _height;
+    }
+
+    /**
+     * Returns the ARGB value of the pixel at the given x/y location.
+     * @throw ErrorException if x/y is out of range
+     */
+    unsigned int getPixel(int x, int y) const;
+
+    /**
+     * Returns the number of pixels between the start of successive rows.
+     */
+    int getStride() const {
+        return _stride;
+    }
+
+    /**
+     * Returns the number of columns in the view.
+     */
+    int getWidth() const {
+        return _width;
+    }
+
+    /**
+     * Returns true if the view contains no pixels.
+     */
+    bool isEmpty() const {
+        return _width <= 0 || _height <= 0;
+    }
+
+    /**
+     * Returns a pointer to the first pixel of the given row.
+     * The row contains getWidth() pixels; no bounds checking is done on
+     * indexes into the row.
+     * @throw ErrorException if y is out of range
+     */
+    unsigned int* row(int y);
+
+    /**
+     * Returns a pointer to the first pixel of the given row.
+     * The row contains getWidth() pixels; no bounds checking is done on
+     * indexes into the row.
+     * @throw ErrorException if y is out of range
+     */
+    const unsigned int* row(int y) const;
+
+    /**
+     * Sets the pixel at the given x/y location to the given ARGB value.
+     * @throw ErrorException if x/y is out of range
+     */
+    void setPixel(int x, int y, unsigned int argb);
+
+    /**
+     * Returns a view of the given rectangular region of this view, sharing
+     * the same pixels.
+     * @throw ErrorException if the region does not fit inside this view
+     */
+    PixelView subview(int x, int y, int width, int height) const;
+
+    /**
+     * Copies the pixels of this view into the given grid, resizing it to
+     * match, and keeping only the bits set in the given mask.
+     * Pass a mask of 0x00ffffff to get plain RGB values.
+     */
+    void toGrid(Grid<int>& grid, unsigned int mask = 0xffffffff) const;
+
+private:
+    unsigned int* _pixels;
+    int _width;
+    int _height;
+    int _stride;
+};
+
+#endif // _gpixelview_h
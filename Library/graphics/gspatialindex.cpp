@@ -0,0 +1,249 @@
+/*
+ * File: gspatialindex.cpp
+ * -----------------------
+ * This file implements the gspatialindex.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "gspatialindex.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+#include "error.h"
+
+/*static*/ const int GSpatialIndex::DEFAULT_CELL_SIZE = 64;
+/*static*/ const int GSpatialIndex::MAX_CELLS_PER_OBJECT = 256;
+
+namespace {
+/* Cell coordinates are clamped to this range so they cannot overflow. */
+const double MAX_CELL_COORD = 1 << 30;
+}
+
+GSpatialIndex::GSpatialIndex(double cellSize)
+        : _cellSize(cellSize),
+          _backOrder(0),
+          _frontOrder(0) {
+    if (!(cellSize > 0)) {
+        error("GSpatialIndex::constructor: cell size must be positive");
+    }
+}
+
+/*static*/ unsigned long long GSpatialIndex::cellKey(int cx, int cy) {
+    return (static_cast<unsigned long long>(static_cast<unsigned int>(cx)) << 32)
+            | static_cast<unsigned int>(cy);
+}
+
+GSpatialIndex::CellRange GSpatialIndex::cellsFor(const GRectangle& rect) const {
+    auto cell = [this](double coord) {
+        double c = std::floor(coord / _cellSize);
+        return static_cast<int>(std::max(-MAX_CELL_COORD, std::min(MAX_CELL_COORD, c)));
+    };
+    return {cell(rect.x), cell(rect.y),
+            cell(rect.x + std::max(0.0, rect.width)),
+            cell(rect.y + std::max(0.0, rect.height))};
+}
+
+void GSpatialIndex::clear() {
+    std::lock_guard<std::mutex> guard(_lock);
+    _cells.clear();
+    _entries.clear();
+    _unbounded.clear();
+    _backOrder = 0;
+    _frontOrder = 0;
+}
+
+bool GSpatialIndex::contains(GObject* gobj) const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _entries.count(gobj) != 0;
+}
+
+double GSpatialIndex::getCellSize() const {
+    return _cellSize;
+}
+
+void GSpatialIndex::insertIntoCells(GObject* gobj, const Entry& entry) {
+    if (entry.unbounded) {
+        _unbounded.push_back(gobj);
+        return;
+    }
+    for (int cy = entry.cells.y1; cy <= entry.cells.y2; cy++) {
+        for (int cx = entry.cells.x1; cx <= entry.cells.x2; cx++) {
+            _cells[cellKey(cx, cy)].push_back(gobj);
+        }
+    }
+}
+
+void GSpatialIndex::moveToBack(GObject* gobj) {
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(gobj);
+    if (itr != _entries.end()) {
+        itr->second.order = --_backOrder;
+    }
+}
+
+void GSpatialIndex::moveToFront(GObject* gobj) {
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(gobj);
+    if (itr != _entries.end()) {
+        itr->second.order = ++_frontOrder;
+    }
+}
+
+void GSpatialIndex::put(GObject* gobj, const GRectangle& bounds, bool boundsKnown) {
+    putEntry(gobj, bounds, boundsKnown, /* addIfMissing */ true);
+}
+
+/*
+ * Implementation notes: putEntry
+ * ------------------------------
+ * Most updates come from an object moving by a few pixels, which usually
+ * leaves it in the same cells; that case is detected up front and costs
+ * only a hash lookup.
+ */
+void GSpatialIndex::putEntry(GObject* gobj, const GRectangle& bounds,
+                             bool boundsKnown, bool addIfMissing) {
+    Entry entry;
+    entry.cells = cellsFor(bounds);
+    entry.unbounded = !boundsKnown
+            || static_cast<long long>(entry.cells.x2 - entry.cells.x1 + 1)
+               * (entry.cells.y2 - entry.cells.y1 + 1) > MAX_CELLS_PER_OBJECT;
+
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(gobj);
+    if (itr != _entries.end()) {
+        Entry& old = itr->second;
+        if (old.unbounded == entry.unbounded
+                && (entry.unbounded || old.cells == entry.cells)) {
+            return;   // still in the same cells
+        }
+        removeFromCells(gobj, old);
+        entry.order = old.order;
+        old = entry;
+    } else if (!addIfMissing) {
+        return;
+    } else {
+        entry.order = ++_frontOrder;
+        _entries[gobj] = entry;
+    }
+    insertIntoCells(gobj, entry);
+}
+
+/*
+ * Implementation notes: query
+ * ---------------------------
+ * An object that spans several cells is found once per cell, so the objects
+ * already reported are kept in a set local to the query; nothing in the
+ * index itself changes, so a query never races with another.  If the query
+ * rectangle covers more cells than are stored, it is cheaper to walk the
+ * stored cells instead.  The results are sorted by stacking order at the
+ * end, which is cheap since queries for a small dirty rectangle or a single
+ * point return only a handful of objects.
+ */
+void GSpatialIndex::query(const GRectangle& rect, std::vector<GObject*>& result) const {
+    result.clear();
+    std::lock_guard<std::mutex> guard(_lock);
+    std::unordered_set<GObject*> seen;
+    for (GObject* gobj : _unbounded) {
+        seen.insert(gobj);
+        result.push_back(gobj);
+    }
+
+    auto report = [&seen, &result](const std::vector<GObject*>& cell) {
+        for (GObject* gobj : cell) {
+            if (seen.insert(gobj).second) {
+                result.push_back(gobj);
+            }
+        }
+    };
+
+    CellRange range = cellsFor(rect);
+    long long cellCount = static_cast<long long>(range.x2 - range.x1 + 1)
+            * (range.y2 - range.y1 + 1);
+    if (cellCount > static_cast<long long>(_cells.size())) {
+        for (const auto& pair : _cells) {
+            int cx = static_cast<int>(static_cast<unsigned int>(pair.first >> 32));
+            int cy = static_cast<int>(static_cast<unsigned int>(pair.first));
+            if (cx >= range.x1 && cx <= range.x2 && cy >= range.y1 && cy <= range.y2) {
+                report(pair.second);
+            }
+        }
+    } else {
+        for (int cy = range.y1; cy <= range.y2; cy++) {
+            for (int cx = range.x1; cx <= range.x2; cx++) {
+                auto itr = _cells.find(cellKey(cx, cy));
+                if (itr != _cells.end()) {
+                    report(itr->second);
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<long long, GObject*>> ordered;
+    ordered.reserve(result.size());
+    for (GObject* gobj : result) {
+        ordered.emplace_back(_entries.at(gobj).order, gobj);
+    }
+    std::sort(ordered.begin(), ordered.end());
+    for (size_t i = 0; i < ordered.size(); i++) {
+        result[i] = ordered[i].second;
+    }
+}
+
+void GSpatialIndex::query(double x, double y, std::vector<GObject*>& result) const {
+    query(GRectangle(x, y, 0, 0), result);
+}
+
+void GSpatialIndex::remove(GObject* gobj) {
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(gobj);
+    if (itr == _entries.end()) {
+        return;
+    }
+    removeFromCells(gobj, itr->second);
+    _entries.erase(itr);
+}
+
+void GSpatialIndex::removeFromCells(GObject* gobj, const Entry& entry) {
+    auto removeFrom = [gobj](std::vector<GObject*>& list) {
+        auto pos = std::find(list.begin(), list.end(), gobj);
+        if (pos != list.end()) {
+            *pos = list.back();
+            list.pop_back();
+        }
+    };
+    if (entry.unbounded) {
+        removeFrom(_unbounded);
+        return;
+    }
+    for (int cy = entry.cells.y1; cy <= entry.cells.y2; cy++) {
+        for (int cx = entry.cells.x1; cx <= entry.cells.x2; cx++) {
+            auto itr = _cells.find(cellKey(cx, cy));
+            if (itr != _cells.end()) {
+                removeFrom(itr->second);
+                if (itr->second.empty()) {
+                    _cells.erase(itr);
+                }
+            }
+        }
+    }
+}
+
+int GSpatialIndex::size() const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return static_cast<int>(_entries.size());
+}
+
+void GSpatialIndex::swapOrder(GObject* gobj1, GObject* gobj2) {
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr1 = _entries.find(gobj1);
+    auto itr2 = _entries.find(gobj2);
+    if (itr1 != _entries.end() && itr2 != _entries.end()) {
+        std::swap(itr1->second.order, itr2->second.order);
+    }
+}
+
+void GSpatialIndex::update(GObject* gobj, const GRectangle& bounds, bool boundsKnown) {
+    putEntry(gobj, bounds, boundsKnown, /* addIfMissing */ false);
+}
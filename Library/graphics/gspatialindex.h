@@ -0,0 +1,172 @@
+/*
+ * File: gspatialindex.h
+ * ---------------------
+ * This file defines the GSpatialIndex class, which a GCompound uses to find
+ * the children that lie near a point or inside a rectangle without looking
+ * at every child.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+
+#ifndef _gspatialindex_h
+#define _gspatialindex_h
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "gtypes.h"
+
+class GObject;
+
+/**
+ * A GSpatialIndex is a uniform grid of square cells laid over the plane.
+ * Each object is recorded in every cell its bounding rectangle touches, so
+ * a query only has to look at the objects in the cells that the query
+ * rectangle touches.
+ * Only the cells that actually hold objects are stored.
+ *
+ * Objects whose bounds would cover a very large number of cells, and
+ * objects whose bounds are not known, are kept in a separate list that is
+ * included in the results of every query.
+ *
+ * The index also keeps the objects in a back-to-front stacking order, so
+ * that query results can be drawn or hit-tested in the same order as the
+ * owner's list of objects.  Newly added objects go in front.
+ *
+ * The index does not watch its objects for changes; its owner must call
+ * put again whenever an object's bounds change.
+ * All operations lock the index, since objects are usually moved on the
+ * student's thread while the Qt GUI thread queries the index to repaint.
+ * Clients generally do not need to use this class directly; call
+ * GCompound::setSpatialIndexEnabled instead.
+ * @private
+ */
+class GSpatialIndex {
+public:
+    /**
+     * The default width and height of each cell, in pixels.
+     */
+    static const int DEFAULT_CELL_SIZE;
+
+    /**
+     * Constructs an empty index whose cells have the given size.
+     * @throw ErrorException if the cell size is not positive
+     */
+    GSpatialIndex(double cellSize = DEFAULT_CELL_SIZE);
+
+    /**
+     * Removes all objects from the index.
+     */
+    void clear();
+
+    /**
+     * Returns true if the given object is in the index.
+     */
+    bool contains(GObject* gobj) const;
+
+    /**
+     * Returns the width and height of each cell.
+     */
+    double getCellSize() const;
+
+    /**
+     * Moves the given object behind all others in the stacking order.
+     * Has no effect if the object is not in the index.
+     */
+    void moveToBack(GObject* gobj);
+
+    /**
+     * Moves the given object in front of all others in the stacking order.
+     * Has no effect if the object is not in the index.
+     */
+    void moveToFront(GObject* gobj);
+
+    /**
+     * Adds the given object to the index in front of all others, with the
+     * given bounds, or updates its bounds if it is already present.
+     * If the bounds are unknown (boundsKnown is false), the object is
+     * returned by every query.
+     */
+    void put(GObject* gobj, const GRectangle& bounds, bool boundsKnown = true);
+
+    /**
+     * Sets the given vector to hold every object whose bounds might intersect
+     * the given rectangle, each exactly once, in back-to-front order.
+     * The result may include a few objects that do not actually intersect
+     * the rectangle, but never omits one that does.
+     */
+    void query(const GRectangle& rect, std::vector<GObject*>& result) const;
+
+    /**
+     * Sets the given vector to hold every object whose bounds might contain
+     * the given point, each exactly once, in back-to-front order.
+     */
+    void query(double x, double y, std::vector<GObject*>& result) const;
+
+    /**
+     * Removes the given object from the index.
+     * Has no effect if the object is not in the index.
+     */
+    void remove(GObject* gobj);
+
+    /**
+     * Returns the number of objects in the index.
+     */
+    int size() const;
+
+    /**
+     * Exchanges the positions of the two given objects in the stacking order.
+     * Has no effect if either object is not in the index.
+     */
+    void swapOrder(GObject* gobj1, GObject* gobj2);
+
+    /**
+     * Updates the bounds of the given object, as put does, but has no effect
+     * if the object is not in the index.
+     * Unlike a call to contains followed by put, this cannot add back an
+     * object that another thread removed in between.
+     */
+    void update(GObject* gobj, const GRectangle& bounds, bool boundsKnown = true);
+
+private:
+    /* Objects that cover more cells than this go in the unbounded list. */
+    static const int MAX_CELLS_PER_OBJECT;
+
+    /* The range of cells [x1, x2] x [y1, y2] covered by one object. */
+    struct CellRange {
+        int x1;
+        int y1;
+        int x2;
+        int y2;
+
+        bool operator ==(const CellRange& other) const {
+            return x1 == other.x1 && y1 == other.y1 && x2 == other.x2 && y2 == other.y2;
+        }
+    };
+
+    /* What the index knows about one object. */
+    struct Entry {
+        CellRange cells;
+        long long order;                 // position in back-to-front order
+        bool unbounded;                  // in _unbounded rather than in cells
+    };
+
+    static unsigned long long cellKey(int cx, int cy);
+    CellRange cellsFor(const GRectangle& rect) const;
+    void insertIntoCells(GObject* gobj, const Entry& entry);
+    void putEntry(GObject* gobj, const GRectangle& bounds, bool boundsKnown, bool addIfMissing);
+    void removeFromCells(GObject* gobj, const Entry& entry);
+
+    double _cellSize;
+    std::unordered_map<unsigned long long, std::vector<GObject*>> _cells;
+    std::unordered_map<GObject*, Entry> _entries;
+    std::vector<GObject*> _unbounded;
+    long long _backOrder;     // order of the backmost object, or less
+    long long _frontOrder;    // order of the frontmost object, or more
+    mutable std::mutex _lock; // guards all of the above
+};
+
+#endif // _gspatialindex_h
@@ -5,6 +5,8 @@
  * See that file for documentation of each member.
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - set can update the cell asynchronously (see GInteractor::setAsyncUpdates)
  * @version 2019/02/02
  * - destructor now stops event processing
  * @version 2018/09/06
@@ -51,6 +53,7 @@ GTable::GTable(int rows, int columns, double width, double height, QWidget* pare
 }
 
 GTable::~GTable() {
+    cancelPendingUpdates();
     // TODO: delete _iqtableview;
     _iqtableview->detach();
     _iqtableview = nullptr;
@@ -175,6 +178,7 @@ void GTable::fill(const std::string& text) {
 
 std::string GTable::get(int row, int column) const {
     checkIndex("get", row, column);
+    waitForPendingUpdates();
     return _iqtableview->model()->data(_iqtableview->model()->index(row, column)).toString().toStdString();
 }
 
@@ -341,7 +345,8 @@ void GTable::select(int row, int column) {
 
 void GTable::set(int row, int column, const std::string& text) {
     checkIndex("set", row, column);
-    GThread::runOnQtGuiThread([this, row, column, text]() {
+    runSetterOnQtGuiThread("cell " + std::to_string(row) + " " + std::to_string(column),
+                           [this, row, column, text]() {
         QModelIndex index = _iqtableview->model()->index(row, column);
         _iqtableview->model()->setData(index, QVariant(text.c_str()));
     });
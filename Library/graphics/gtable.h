@@ -4,6 +4,8 @@
  * This file exports the GTable class for a graphical editable 2D table.
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - set can update the cell asynchronously
  * @version 2018/08/23
  * - renamed to gtable.h to replace Java version
  * @version 2018/07/17
@@ -247,6 +249,8 @@ public:
 
     /**
      * Modifies the value in the given cell to store the given text.
+     * Does not wait for the cell to be updated on the screen if
+     * GInteractor::setAsyncUpdates(true) has been called.
      * @throw ErrorException if the given row or column are out of bounds
      */
     virtual void set(int row, int column, const std::string& text);
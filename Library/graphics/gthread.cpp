@@ -4,6 +4,8 @@
  *
  * This file implements the members declared in gthread.h.
  *
+ * @version 2026/10/19
+ * - added postCoalesced, cancelPendingUpdates, and waitForPendingUpdates
  * @version 2019/04/13
  * - reimplement GThread to wrap either QThread or std::thread
  * - add GThread abstract base class for thread abstractions
@@ -90,6 +92,22 @@ GThread::GThread() {
     // empty
 }
 
+/*
+ * Implementation notes: cancelPendingUpdates
+ * ------------------------------------------
+ * An update that is already running cannot be stopped; as in
+ * waitForPendingUpdates, an empty synchronous function queued behind it
+ * waits for it.  On the Qt GUI thread nothing else can be running.
+ */
+/*static*/ void GThread::cancelPendingUpdates(const void* target) {
+    if (qtGuiThreadExists() && GEventQueue::instance()->cancelPendingUpdates(target)
+            && !iAmRunningOnTheQtGuiThread()) {
+        GEventQueue::instance()->runOnQtGuiThreadSync([]() {
+            // empty
+        });
+    }
+}
+
 /*static*/ void GThread::ensureThatThisIsTheQtGuiThread(const std::string& message) {
     if (!iAmRunningOnTheQtGuiThread()) {
         error((message.empty() ? "" : (message + ": "))
@@ -106,6 +124,19 @@ GThread::GThread() {
     QThread::msleep(static_cast<unsigned long>(ms));
 }
 
+/*static*/ void GThread::postCoalesced(const void* target, const std::string& property, GThunk func) {
+    if (iAmRunningOnTheQtGuiThread()) {
+        // already on Qt GUI thread; just run the function!
+        func();
+    } else if (qtGuiThreadExists()) {
+        GEventQueue::instance()->runOnQtGuiThreadCoalesced(target, property, func);
+    } else {
+        error("GThread::postCoalesced: Qt GUI thread has not been initialized properly. \n"
+              "Make sure that the file containing your main() function #includes at least \n"
+              "one .h header from the Stanford C++ library.");
+    }
+}
+
 /*static*/ bool GThread::qtGuiThreadExists() {
     return _qtGuiThread != nullptr;
 }
@@ -182,6 +213,21 @@ GThread::GThread() {
     return thread->isRunning();
 }
 
+/*
+ * Implementation notes: waitForPendingUpdates
+ * -------------------------------------------
+ * The pending updates are ahead of any function this thread queues now, so
+ * running an empty function synchronously is enough to wait for them.
+ */
+/*static*/ void GThread::waitForPendingUpdates(const void* target) {
+    if (!iAmRunningOnTheQtGuiThread() && qtGuiThreadExists()
+            && GEventQueue::instance()->hasPendingUpdates(target)) {
+        GEventQueue::instance()->runOnQtGuiThreadSync([]() {
+            // empty
+        });
+    }
+}
+
 /*static*/ void GThread::yield() {
     QThread::yieldCurrentThread();
 }
@@ -9,6 +9,9 @@
  * You can also run code in a new thread using the static method
  * GThread::runInNewThread or GThread::runInNewThreadAsync.
  *
+ * @version 2026/10/19
+ * - added post, which returns a future for the result
+ * - added postCoalesced, cancelPendingUpdates, and waitForPendingUpdates
  * @version 2019/04/13
  * - reimplement GThread to wrap either QThread or std::thread
  * - add GThread abstract base class for thread abstractions
@@ -30,6 +33,9 @@
 
 #include <QThread>
 #include <atomic>
+#include <future>
+#include <memory>
+#include <string>
 #include <thread>
 
 #include "gtypes.h"
@@ -140,6 +146,16 @@ public:
     // TODO: methods to set a top-level exception handler
 
 
+    /**
+     * Discards every update posted with <code>postCoalesced</code> for the
+     * given target that has not started running yet.
+     * If one of them is running on the Qt GUI thread right now, and the
+     * caller is on another thread, this waits for it to finish.
+     * Call this before destroying a target that may have pending updates,
+     * since they would otherwise run after it is gone.
+     */
+    static void cancelPendingUpdates(const void* target);
+
     /**
      * Generates an error if the caller is not running on the Qt GUI thread.
      * An optional error detail message can be passed.
@@ -163,6 +179,49 @@ public:
      */
     static void msleep(double ms);
 
+    /**
+     * Runs the given function on the Qt GUI thread in the background and
+     * returns a future for its result; the current thread does not block
+     * until it calls <code>get</code> or <code>wait</code> on the future.
+     * This lets a thread start several GUI operations and wait for them
+     * all at once rather than waiting for each in turn:
+     *
+     * <pre>
+     * std::future<std::string> text = GThread::post([&]() {
+     *     return label->getText();
+     * });
+     * ...
+     * std::cout << text.get() << std::endl;
+     * </pre>
+     *
+     * Functions posted by one thread run in the order they were posted,
+     * and before any function that thread later runs with
+     * <code>runOnQtGuiThread</code>.
+     * If called on the Qt GUI thread, the function runs right away.
+     *
+     * Unlike <code>runOnQtGuiThread</code>, an exception thrown by the
+     * function does not crash the program; it is stored in the future and
+     * rethrown by <code>get</code>.
+     */
+    template <typename Func>
+    static auto post(Func func) -> std::future<decltype(func())>;
+
+    /**
+     * Runs the given void function on the Qt GUI thread in the background,
+     * as an update to the given property of the given target object
+     * (usually an interactor).
+     * If an update to the same target and property is still waiting to run,
+     * the given function replaces it instead of being queued, so that only
+     * the last of several quick updates is done (last write wins).
+     * Updates to different properties are not combined.
+     *
+     * The target must stay alive until its updates have run or have been
+     * cancelled; see <code>waitForPendingUpdates</code> and
+     * <code>cancelPendingUpdates</code>.
+     * If called on the Qt GUI thread, the function runs right away.
+     */
+    static void postCoalesced(const void* target, const std::string& property, GThunk func);
+
     /**
      * Runs the given void function in its own new thread,
      * blocking the current thread to wait until it is done.
@@ -200,8 +259,8 @@ public:
      * interactors of the library, because all Qt GUI operations are required
      * to be done on the application's main thread.
      *
-     * Any uncaught exceptions or errors in the Qt GUI thread will crash the
-     * program and cannot be caught by the calling thread.
+     * If the function throws an exception or error, it is rethrown in the
+     * calling thread once the function has stopped.
      *
      * If you want the new thread to run in the background,
      * use the <code>runOnQtGuiThreadAsync</code> function instead.
@@ -237,6 +296,13 @@ public:
      */
     static bool wait(GThread* thread, long ms);
 
+    /**
+     * Blocks the current thread until every update posted with
+     * <code>postCoalesced</code> for the given target has run.
+     * Returns right away if there are none, or if called on the Qt GUI thread.
+     */
+    static void waitForPendingUpdates(const void* target);
+
     /**
      * Indicates that the current thread is willing to yield execution to any
      * other threads that want to run.
@@ -322,6 +388,19 @@ private:
     QThread* _qThread;   // underlying real Qt thread
 };
 
+template <typename Func>
+auto GThread::post(Func func) -> std::future<decltype(func())> {
+    typedef decltype(func()) Result;
+    // GThunk must be copyable and packaged_task is not, so share it
+    std::shared_ptr<std::packaged_task<Result()>> task
+            = std::make_shared<std::packaged_task<Result()>>(func);
+    std::future<Result> result = task->get_future();
+    runOnQtGuiThreadAsync([task]() {
+        (*task)();
+    });
+    return result;
+}
+
 // Platform-specific way to set the name of current thread for display in debugger
 void native_set_thread_name(const char *name);
 
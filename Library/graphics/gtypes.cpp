@@ -3,6 +3,8 @@
  * ----------------
  * This file implements the classes in the gtypes.h interface.
  *
+ * @version 2026/10/19
+ * - added GRectangle unionWith
  * @version 2019/05/16
  * - added GRectangle contains(GRectangle), intersects
  * @version 2018/07/14
@@ -10,6 +12,7 @@
  */
 
 #include "gtypes.h"
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <string>
@@ -280,6 +283,19 @@ std::string GRectangle::toString() const {
     return out.str();
 }
 
+GRectangle GRectangle::unionWith(const GRectangle& other) const {
+    if (isEmpty()) {
+        return other;
+    } else if (other.isEmpty()) {
+        return *this;
+    }
+    double x1 = std::min(x, other.x);
+    double y1 = std::min(y, other.y);
+    double x2 = std::max(x + width, other.x + other.width);
+    double y2 = std::max(y + height, other.y + other.height);
+    return GRectangle(x1, y1, x2 - x1, y2 - y1);
+}
+
 std::ostream& operator <<(std::ostream& os, const GRectangle& rect) {
     return os << "(" << rect.x << ", " << rect.y << ", "
               << rect.width << ", " << rect.height << ")";
@@ -4,6 +4,8 @@
  * This file defines classes for representing points, dimensions, and
  * rectangles.
  *
+ * @version 2026/10/19
+ * - added GRectangle unionWith
  * @version 2018/09/09
  * - added doc comments for new documentation generation
  * @version 2018/07/14
@@ -371,6 +373,14 @@ public:
      */
     std::string toString() const;
 
+    /**
+     * Returns the smallest rectangle that contains both this rectangle and
+     * the given other rectangle.
+     * An empty rectangle contributes nothing, so the union of an empty
+     * rectangle with r is r itself.
+     */
+    GRectangle unionWith(const GRectangle& other) const;
+
     /* coordinates and dimension - may be directly accessed or modified */
     double x;        /* The x-coordinate of the rectangle */
     double y;        /* The y-coordinate of the rectangle */
@@ -3,6 +3,10 @@
  * -----------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added runAnimation, driven by a precise single-shot timer on the GUI thread
+ * - added beginFrame/endFrame with frame timing statistics
+ * - window timers use Qt::PreciseTimer so that GTimer can pace animation frames
  * @version 2019/05/05
  * - added static method for isDarkMode checking support
  * - added static methods to ask for system default widget bg/fg color
@@ -40,6 +44,13 @@
  */
 
 #include "gwindow.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <QEventLoop>
 #include <QIcon>
 #include <QMenu>
 #include <QMenuBar>
@@ -65,6 +76,14 @@ _Internal_QMainWindow* GWindow::_lastWindow = nullptr;
 /*static*/ const int GWindow::STANDARD_SCREEN_DPI = 96;
 /*static*/ const std::string GWindow::DEFAULT_ICON_FILENAME = "splicon-large.png";
 
+// number of recent frames kept for the frame-time percentile
+static const int FRAME_HISTORY = 4096;
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+}
+
 GWindow::GWindow(bool visible)
         : _iqmainwindow(nullptr),
           _contentPane(nullptr),
@@ -516,6 +535,33 @@ QAction* GWindow::addToolbarSeparator() {
     return action;
 }
 
+/*
+ * Implementation notes: beginFrame
+ * --------------------------------
+ * The time between the starts of consecutive frames is what the user sees
+ * as the frame rate, so that is what is recorded.  A gap of about two frame
+ * times means one frame was dropped, about three means two, and so on.
+ */
+void GWindow::beginFrame() {
+    ensureForwardTarget();
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    _canvas->beginFrame();
+    if (_frameCount > 0) {
+        double interval = std::chrono::duration<double, std::milli>(now - _frameStart).count();
+        if (static_cast<int>(_frameIntervals.size()) < FRAME_HISTORY) {
+            _frameIntervals.push_back(interval);
+        } else {
+            _frameIntervals[_frameIntervalCount % FRAME_HISTORY] = interval;
+        }
+        _frameIntervalCount++;
+        _frameIntervalTotal += interval;
+        if (interval > 1.5 * _targetFrameMs) {
+            _droppedFrames += static_cast<int>(std::lround(interval / _targetFrameMs)) - 1;
+        }
+    }
+    _frameStart = now;
+}
+
 void GWindow::clear() {
     // TODO: reimplement to clear out widgets rather than just canvas
     clearCanvas();
@@ -624,6 +670,13 @@ void GWindow::ensureForwardTarget() {
 //    }
 }
 
+void GWindow::endFrame() {
+    ensureForwardTarget();
+    _canvas->endFrame();
+    _frameWorkTotal += millisecondsSince(_frameStart);
+    _frameCount++;
+}
+
 bool GWindow::eventsEnabled() const {
     return getWidget() != nullptr && isVisible();
 }
@@ -682,6 +735,26 @@ GWindow::CloseOperation GWindow::getCloseOperation() const {
     return previousFg;
 }
 
+GFrameStats GWindow::getFrameStats() const {
+    GFrameStats stats;
+    stats.frames = _frameCount;
+    stats.droppedFrames = _droppedFrames;
+    stats.targetFrameMs = _targetFrameMs;
+    stats.meanFrameMs = 0;
+    stats.p99FrameMs = 0;
+    stats.maxFrameMs = 0;
+    stats.meanWorkMs = _frameCount == 0 ? 0 : _frameWorkTotal / _frameCount;
+    if (_frameIntervalCount > 0) {
+        stats.meanFrameMs = _frameIntervalTotal / _frameIntervalCount;
+        std::vector<double> sorted = _frameIntervals;
+        size_t index = static_cast<size_t>(std::ceil(0.99 * sorted.size())) - 1;
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<long>(index), sorted.end());
+        stats.p99FrameMs = sorted[index];
+        stats.maxFrameMs = *std::max_element(sorted.begin() + static_cast<long>(index), sorted.end());
+    }
+    return stats;
+}
+
 GObject* GWindow::getGObject(int index) const {
     if (_canvas) {
         return _canvas->getElement(index);
@@ -991,12 +1064,135 @@ void GWindow::requestFocus() {
     });
 }
 
+void GWindow::resetFrameStats(double fps) {
+    require::positive(fps, "GWindow::resetFrameStats", "fps");
+    _frameIntervals.clear();
+    _frameIntervalCount = 0;
+    _frameCount = 0;
+    _droppedFrames = 0;
+    _frameIntervalTotal = 0;
+    _frameWorkTotal = 0;
+    _targetFrameMs = 1000.0 / fps;
+}
+
 void GWindow::restore() {
     GThread::runOnQtGuiThread([this]() {
         _iqmainwindow->setWindowState(Qt::WindowActive);
     });
 }
 
+/*
+ * Implementation notes: runAnimation
+ * ----------------------------------
+ * A repeating timer fires at fixed intervals after it was last serviced, so
+ * any delay in handling one tick pushes back all the later ones.  Instead,
+ * a single-shot timer is restarted after each frame to fire at the next
+ * multiple of the frame time since the animation began; frames whose time
+ * has already passed are skipped.  Qt::PreciseTimer keeps the error within
+ * a millisecond, where the default coarse timers may be 5% off.
+ *
+ * Everything about the animation that the timer needs is kept in a shared
+ * struct, so that it stays alive until the timer is deleted.  If the caller
+ * is the GUI thread, it runs a nested event loop until the animation ends;
+ * otherwise it simply waits to be told that the animation is over.
+ * The timer is a child of the window, so closing and deleting the window
+ * deletes it without another tick; its destroyed signal also ends the
+ * animation so that the caller is not left waiting.
+ */
+GFrameStats GWindow::runAnimation(double fps, std::function<bool(double elapsedMs)> func) {
+    require::positive(fps, "GWindow::runAnimation", "fps");
+    if (!func) {
+        error("GWindow::runAnimation: function must not be null");
+    }
+    ensureForwardTarget();
+    resetFrameStats(fps);
+
+    struct Animation {
+        QTimer* timer = nullptr;
+        QEventLoop* loop = nullptr;   // only if run from the GUI thread
+        std::chrono::steady_clock::time_point start;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done = false;
+    };
+    std::shared_ptr<Animation> animation = std::make_shared<Animation>();
+    double frameMs = 1000.0 / fps;
+
+    std::function<void()> finish = [animation]() {
+        if (animation->timer) {
+            animation->timer->stop();
+            animation->timer->deleteLater();
+            animation->timer = nullptr;
+        }
+        if (animation->loop) {
+            animation->loop->quit();
+            animation->loop = nullptr;
+        }
+        std::lock_guard<std::mutex> lock(animation->mutex);
+        animation->done = true;
+        animation->finished.notify_all();
+    };
+
+    std::function<void()> frame = [this, animation, func, frameMs, finish]() {
+        bool keepGoing = false;
+        if (_iqmainwindow && _iqmainwindow->isVisible()) {
+            double elapsed = millisecondsSince(animation->start);
+            try {
+                beginFrame();
+                try {
+                    keepGoing = func(elapsed);
+                } catch (...) {
+                    endFrame();
+                    throw;
+                }
+                endFrame();
+            } catch (...) {
+                animation->error = std::current_exception();
+                keepGoing = false;
+            }
+        }
+        if (!keepGoing || !animation->timer) {   // no timer if the window went away
+            finish();
+            return;
+        }
+        double now = millisecondsSince(animation->start);
+        double next = (std::floor(now / frameMs) + 1) * frameMs;
+        animation->timer->start(static_cast<int>(std::lround(next - now)));
+    };
+
+    std::unique_ptr<QEventLoop> loop;
+    if (GThread::iAmRunningOnTheQtGuiThread()) {
+        loop.reset(new QEventLoop());
+        animation->loop = loop.get();
+    }
+    GThread::runOnQtGuiThread([this, animation, frame, finish]() {
+        animation->timer = new QTimer(_iqmainwindow);
+        animation->timer->setTimerType(Qt::PreciseTimer);
+        animation->timer->setSingleShot(true);
+        QObject::connect(animation->timer, &QTimer::timeout, animation->timer, frame);
+        QObject::connect(animation->timer, &QObject::destroyed, [animation, finish]() {
+            animation->timer = nullptr;   // already being deleted
+            finish();
+        });
+        animation->start = std::chrono::steady_clock::now();
+        animation->timer->start(0);
+    });
+
+    if (loop) {
+        loop->exec();
+    } else {
+        std::unique_lock<std::mutex> lock(animation->mutex);
+        animation->finished.wait(lock, [&animation]() {
+            return animation->done;
+        });
+    }
+    if (animation->error) {
+        std::rethrow_exception(animation->error);
+    }
+    return getFrameStats();
+}
+
 void GWindow::saveCanvasPixels(const std::string& filename) {
     ensureForwardTarget();
     _canvas->save(filename);   // runs on Qt GUI thread
@@ -1443,7 +1639,7 @@ bool _Internal_QMainWindow::timerExists(int id) {
 
 int _Internal_QMainWindow::timerStart(double ms) {
     require::nonNegative(ms, "_Internal_QMainWindow::timerStart", "delay (ms)");
-    int timerID = startTimer(static_cast<int>(ms));
+    int timerID = startTimer(static_cast<int>(ms), Qt::PreciseTimer);
     _timerIDs.add(timerID);
     return timerID;
 }
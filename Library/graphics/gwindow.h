@@ -3,6 +3,8 @@
  * ---------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added runAnimation, beginFrame/endFrame and frame timing statistics
  * @version 2019/05/05
  * - added static method for isDarkMode checking support
  * - added static methods to ask for system default widget bg/fg color
@@ -26,7 +28,10 @@
 #ifndef _gwindow_h
 #define _gwindow_h
 
+#include <chrono>
+#include <functional>
 #include <string>
+#include <vector>
 #include <QCloseEvent>
 #include <QEvent>
 #include <QLayout>
@@ -45,6 +50,21 @@
 
 class _Internal_QMainWindow;
 
+/**
+ * Timing statistics for the frames of an animation drawn by
+ * GWindow::runAnimation, or by calling GWindow::beginFrame and endFrame.
+ * All times are in milliseconds.
+ */
+struct GFrameStats {
+    int frames;            // number of frames drawn
+    int droppedFrames;     // frames skipped because an earlier one ran late
+    double targetFrameMs;  // intended time between frames (1000 / fps)
+    double meanFrameMs;    // average time between the starts of two frames
+    double p99FrameMs;     // 99th percentile of the time between frames
+    double maxFrameMs;     // longest time between frames
+    double meanWorkMs;     // average time spent between beginFrame and endFrame
+};
+
 /**
  * This class represents a graphics window that supports simple graphics.
  * A GWindow is a first-class citizen in our GUI subsystem; all graphical
@@ -384,6 +404,32 @@ public:
      */
     virtual QAction* addToolbarSeparator();
 
+    /**
+     * Starts a frame of animation on the window's canvas.
+     * Until the matching call to endFrame, changes to the canvas and its
+     * objects are not shown; endFrame then repaints every area that changed
+     * in one pass.  Each frame is also timed; see getFrameStats.
+     * See GCanvas::beginFrame for details.
+     *
+     * runAnimation calls this method for you.  To drive frames from your own
+     * loop instead, pair a GTimer with waitForEvent:
+     *
+     * <pre>
+     * GTimer timer(1000.0 / 60);
+     * timer.start();
+     * window.resetFrameStats(60);
+     * while (running) {
+     *     waitForEvent(TIMER_EVENT);
+     *     window.beginFrame();
+     *     ... move objects ...
+     *     window.endFrame();
+     * }
+     * </pre>
+     *
+     * @throw ErrorException if a frame is already in progress
+     */
+    virtual void beginFrame();
+
     /**
      * Removes all interactors from all regionss of the window.
      */
@@ -504,6 +550,13 @@ public:
      */
     virtual CloseOperation getCloseOperation() const;
 
+    /**
+     * Ends a frame of animation started by beginFrame, and repaints every
+     * area of the canvas that changed during the frame.
+     * @throw ErrorException if no frame is in progress
+     */
+    virtual void endFrame();
+
     /**
      * Returns the default color for backgrounds of interactors as a string.
      * This is normally a light-grayish color, depending on the user's
@@ -536,6 +589,13 @@ public:
      */
     static int getDefaultInteractorTextColorInt();
 
+    /**
+     * Returns timing statistics for the frames drawn since the last call to
+     * resetFrameStats or runAnimation.
+     * The percentile and maximum cover the most recent few thousand frames.
+     */
+    virtual GFrameStats getFrameStats() const;
+
     /**
      * Returns the graphical object at the given 0-based index in the window's
      * graphical canvas.
@@ -886,11 +946,51 @@ public:
      */
     virtual void requestFocus();
 
+    /**
+     * Clears the frame timing statistics and sets the frame rate that
+     * frames are expected to run at, which is used to count dropped frames.
+     * @throw ErrorException if fps is not positive
+     */
+    virtual void resetFrameStats(double fps = 60);
+
     /**
      * Puts the window in a normal state, neither minimized or maximized.
      */
     virtual void restore();
 
+    /**
+     * Runs an animation on the window's canvas at the given number of frames
+     * per second, and returns the animation's frame statistics when it ends.
+     *
+     * The given function is called once per frame with the number of
+     * milliseconds since the animation started, and should move the objects
+     * in the window to where they belong at that time.  It returns true to
+     * keep the animation going or false to stop it.  The animation also stops
+     * if the window is closed or hidden.
+     *
+     * Frames are started by a precise timer on the Qt GUI thread, scheduled
+     * against the animation's start time so that small delays do not add up.
+     * If a frame runs so long that the next one is already due, the missed
+     * frames are skipped rather than run back to back, and counted as dropped.
+     * The function runs on the GUI thread between beginFrame and endFrame, so
+     * each frame is shown all at once; this method waits until the animation
+     * is over.
+     *
+     * <pre>
+     * GOval ball(0, 100, 20, 20);
+     * window.add(ball);
+     * window.runAnimation(60, [&](double ms) {
+     *     ball.setX(ms / 10);
+     *     return ball.getX() < window.getCanvasWidth();
+     * });
+     * </pre>
+     *
+     * Any exception thrown by the function stops the animation and is
+     * rethrown from this method.
+     * @throw ErrorException if fps is not positive
+     */
+    virtual GFrameStats runAnimation(double fps, std::function<bool(double elapsedMs)> func);
+
     /**
      * Writes the contents of the window's graphical canvas to the given output
      * filename.  This will write all shapes from the foreground layer as well
@@ -1212,6 +1312,16 @@ private:
     Map<std::string, QAction*> _menuActionMap;
     QToolBar* _toolbar;
 
+    // frame timing; see beginFrame and getFrameStats
+    std::chrono::steady_clock::time_point _frameStart;   // start of latest frame
+    std::vector<double> _frameIntervals;   // recent times between frames, ring buffer
+    int _frameIntervalCount = 0;           // total times recorded, including overwritten
+    int _frameCount = 0;
+    int _droppedFrames = 0;
+    double _frameIntervalTotal = 0;
+    double _frameWorkTotal = 0;
+    double _targetFrameMs = 1000.0 / 60;
+
     friend class GInteractor;
     friend class _Internal_QMainWindow;
 };
@@ -3,6 +3,9 @@
  * ---------------
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - use Qt's offscreen platform when no display is available
+ * - run every queued function per eventReady signal, not just one
  * @version 2018/08/23
  * - renamed to qtgui.cpp
  * @version 2018/07/03
@@ -49,6 +52,18 @@ void QtGui::createInstance(int argc, char **argv) {
     }
     GThread::ensureThatThisIsTheQtGuiThread("Qt GUI must be created on the main thread.");
     _instance = new QtGui(argc, argv);
+
+#if defined(__linux__) || defined(__FreeBSD__)
+    // with no X11/Wayland display (e.g. a batch job on a server), Qt would
+    // abort while starting up; render offscreen instead so that
+    // GOffscreenCanvas, GCanvas::save, and text measurement still work
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")
+            && qEnvironmentVariableIsEmpty("DISPLAY")
+            && qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+#endif // __linux__
+
     _app = new QSPLApplication(_instance->_argc, _instance->_argv);
     _app->setQuitOnLastWindowClosed(false);
 }
@@ -91,11 +106,19 @@ QtGui* QtGui::instance() {
     return _instance;
 }
 
+/*
+ * Runs the functions that were queued before this call, but not ones queued
+ * while they run, so that a thread posting updates nonstop cannot keep the
+ * Qt GUI thread from painting and handling input.  Each function is removed
+ * before it runs, so a nested event loop inside one (e.g. a modal dialog)
+ * will not run it a second time; such a nested loop may also empty the
+ * queue before the count runs out.
+ */
 void QtGui::processEventFromQueue() {
-    if (!GEventQueue::instance()->isEmpty()) {
-        GThunk thunk = GEventQueue::instance()->peek();
+    GEventQueue* queue = GEventQueue::instance();
+    for (int count = queue->takeFunctionCount(); count > 0 && !queue->isEmpty(); count--) {
+        GThunk thunk = queue->dequeue();
         thunk();
-        GEventQueue::instance()->dequeue();
     }
 }
 
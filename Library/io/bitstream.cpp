@@ -0,0 +1,153 @@
+/*
+ * File: bitstream.cpp
+ * -------------------
+ * This file implements the bitstream.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "bitstream.h"
+
+namespace {
+/*
+ * Size of the byte buffer between each reader or writer and its stream.
+ * It is a multiple of 8 so that the writer's buffer holds whole words.
+ */
+const size_t kBufferSize = 1 << 16;
+}
+
+BitWriter::BitWriter(std::ostream& out)
+        : _out(out),
+          _bits(0),
+          _bitCount(0),
+          _buffer(kBufferSize),
+          _bufferUsed(0) {
+    // empty
+}
+
+BitWriter::~BitWriter() {
+    flush();
+}
+
+void BitWriter::flush() {
+    for (int i = 0; i < _bitCount; i += 8) {
+        if (_bufferUsed == _buffer.size()) {
+            writeBuffer();
+        }
+        _buffer[_bufferUsed++] = (char) (_bits >> i);
+    }
+    _bits = 0;
+    _bitCount = 0;
+    writeBuffer();
+    _out.flush();
+}
+
+/*
+ * Implementation notes: flushWord
+ * -------------------------------
+ * The word is stored a byte at a time, lowest byte first, so that the
+ * output is the same on every platform; compilers turn the loop into a
+ * single store on little-endian machines.
+ */
+void BitWriter::flushWord() {
+    if (_bufferUsed + 8 > _buffer.size()) {
+        writeBuffer();
+    }
+    char* dest = _buffer.data() + _bufferUsed;
+    for (int i = 0; i < 8; i++) {
+        dest[i] = (char) (_bits >> (8 * i));
+    }
+    _bufferUsed += 8;
+}
+
+void BitWriter::writeBuffer() {
+    if (_bufferUsed > 0) {
+        _out.write(_buffer.data(), (std::streamsize) _bufferUsed);
+        _bufferUsed = 0;
+    }
+}
+
+BitReader::BitReader(std::istream& in)
+        : _in(in),
+          _bits(0),
+          _bitCount(0),
+          _buffer(kBufferSize),
+          _bufferPos(0),
+          _bufferEnd(0) {
+    // empty
+}
+
+/*
+ * Implementation notes: fill
+ * --------------------------
+ * When at least 8 bytes are buffered, fill loads them as one word and
+ * keeps as many whole bytes as fit above the bits already in _bits.
+ * Near the end of the buffer it falls back to a byte at a time, reading
+ * the next block from the stream when the buffer runs out.
+ */
+void BitReader::fill() {
+    if (_bitCount <= 56 && _bufferEnd - _bufferPos >= 8) {
+        const unsigned char* src = (const unsigned char*) _buffer.data() + _bufferPos;
+        uint64_t word = 0;
+        for (int i = 0; i < 8; i++) {
+            word |= (uint64_t) src[i] << (8 * i);
+        }
+        int bytes = (64 - _bitCount) >> 3;
+        if (bytes < 8) {
+            word &= (1ULL << (8 * bytes)) - 1;
+        }
+        _bits |= word << _bitCount;
+        _bitCount += 8 * bytes;
+        _bufferPos += bytes;
+        return;
+    }
+    while (_bitCount <= 56) {
+        if (_bufferPos == _bufferEnd) {
+            _in.read(_buffer.data(), (std::streamsize) _buffer.size());
+            _bufferPos = 0;
+            _bufferEnd = (size_t) _in.gcount();
+            if (_bufferEnd == 0) {
+                return;
+            }
+        }
+        _bits |= (uint64_t) (unsigned char) _buffer[_bufferPos++] << _bitCount;
+        _bitCount += 8;
+    }
+}
+
+bool BitReader::hasMoreBits() {
+    if (_bitCount == 0) {
+        fill();
+    }
+    return _bitCount > 0;
+}
+
+/*
+ * Implementation notes: readBitsSlow
+ * ----------------------------------
+ * Since fill stops once more than 56 bits are ready, a read of 57 to 64
+ * bits may straddle two fills, and any read near the end of the stream
+ * may come up short.  This takes every bit that is ready, fills again,
+ * and takes the rest from the new bits.
+ */
+uint64_t BitReader::readBitsSlow(int count) {
+    int low = _bitCount;
+    uint64_t value = _bits;
+    _bits = 0;
+    _bitCount = 0;
+    fill();
+    int high = count - low;
+    if (high > _bitCount) {
+        error("BitReader::readBits: unexpected end of input");
+    }
+    if (high == 64) {
+        value = _bits;
+        _bits = 0;
+    } else {
+        value |= (_bits & ((1ULL << high) - 1)) << low;
+        _bits >>= high;
+    }
+    _bitCount -= high;
+    return value;
+}
@@ -0,0 +1,220 @@
+/*
+ * File: bitstream.h
+ * -----------------
+ * This file exports the <code>BitWriter</code> and <code>BitReader</code>
+ * classes, which write and read a stream of bits through an ordinary
+ * byte stream such as an ofstream, ifstream, or stringstream.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#ifndef _bitstream_h
+#define _bitstream_h
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "error.h"
+
+/**
+ * A <code>BitWriter</code> packs bits into bytes and writes them to an
+ * output stream.  Bits fill each byte starting from its lowest bit, and
+ * in <code>writeBits</code> the lowest bit of the value is written first,
+ * so <code>writeBits(value, 8)</code> writes the byte <code>value</code>.
+ *
+ * The writer collects bits in a 64-bit word and whole words in a buffer,
+ * and only passes the buffer to the stream when it fills or when
+ * <code>flush</code> is called, so writing a bit or a short code costs a
+ * few shifts rather than a stream call.  The destructor calls
+ * <code>flush</code>, so the last partial byte is not lost if the writer
+ * goes out of scope first.
+ */
+class BitWriter {
+public:
+    /**
+     * Initializes a writer that sends its bits to the given stream, which
+     * must stay open for the life of the writer.
+     */
+    explicit BitWriter(std::ostream& out);
+
+    /**
+     * Writes any buffered bits to the stream.
+     */
+    virtual ~BitWriter();
+
+    /**
+     * Writes all buffered bits to the stream, padding the last byte with
+     * 0 bits if needed, and then flushes the stream itself.  Bits written
+     * after a flush start in a new byte.
+     */
+    void flush();
+
+    /**
+     * Writes a single bit, which is 1 if the value is true.
+     */
+    void writeBit(bool value);
+
+    /**
+     * Writes the lowest <code>count</code> bits of the given value, lowest
+     * bit first.  The count may be 0 through 64.
+     */
+    void writeBits(uint64_t value, int count);
+
+private:
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator =(const BitWriter&) = delete;
+
+    /*
+     * Moves the 64 bits in _bits to the buffer, writing the buffer to the
+     * stream first if it is full.
+     */
+    void flushWord();
+
+    /*
+     * Writes the buffered bytes to the stream.
+     */
+    void writeBuffer();
+
+    std::ostream& _out;
+    uint64_t _bits;         // pending bits, first bit lowest
+    int _bitCount;          // number of pending bits, always below 64
+    std::vector<char> _buffer;
+    size_t _bufferUsed;
+};
+
+/**
+ * A <code>BitReader</code> reads the bits written by a BitWriter, or the
+ * bits of any byte stream, lowest bit of each byte first.
+ *
+ * The reader pulls large blocks from the stream into a buffer and keeps up
+ * to 64 bits ready in a word, so <code>readBits</code> can return a whole
+ * code with one shift and mask.  Because it reads ahead, the position of
+ * the underlying stream is unspecified while a reader is using it.
+ */
+class BitReader {
+public:
+    /**
+     * Initializes a reader that takes its bits from the given stream, which
+     * must stay open for the life of the reader.
+     */
+    explicit BitReader(std::istream& in);
+
+    virtual ~BitReader() = default;
+
+    /**
+     * Returns <code>true</code> if at least one more bit can be read.
+     */
+    bool hasMoreBits();
+
+    /**
+     * Reads a single bit and returns it as 0 or 1, or returns -1 if there
+     * are no more bits in the stream.
+     */
+    int readBit();
+
+    /**
+     * Reads the next <code>count</code> bits and returns them with the
+     * first one as the lowest bit of the result.  The count may be 0
+     * through 64.  Signals an error if the stream ends first.
+     */
+    uint64_t readBits(int count);
+
+private:
+    BitReader(const BitReader&) = delete;
+    BitReader& operator =(const BitReader&) = delete;
+
+    /*
+     * Tops up _bits from the buffer, refilling the buffer from the stream
+     * as needed, until it holds more than 56 bits or the stream has ended.
+     */
+    void fill();
+
+    /*
+     * Handles a readBits call that needs more bits than _bits holds.
+     */
+    uint64_t readBitsSlow(int count);
+
+    std::istream& _in;
+    uint64_t _bits;         // bits read ahead, next bit lowest
+    int _bitCount;          // number of bits in _bits
+    std::vector<char> _buffer;
+    size_t _bufferPos;
+    size_t _bufferEnd;
+};
+
+/*
+ * Implementation notes: writeBit, writeBits, readBit, readBits
+ * ------------------------------------------------------------
+ * These are defined here in the header so that an encoding or decoding
+ * loop can inline them; the stream is only touched from flushWord and
+ * fill, which are out of line.
+ */
+inline void BitWriter::writeBit(bool value) {
+    _bits |= (uint64_t) value << _bitCount;
+    if (++_bitCount == 64) {
+        flushWord();
+        _bits = 0;
+        _bitCount = 0;
+    }
+}
+
+inline void BitWriter::writeBits(uint64_t value, int count) {
+    if (count <= 0 || count > 64) {
+        if (count != 0) {
+            error("BitWriter::writeBits: count must be between 0 and 64");
+        }
+        return;
+    }
+    if (count < 64) {
+        value &= (1ULL << count) - 1;
+    }
+    _bits |= value << _bitCount;
+    int total = _bitCount + count;
+    if (total < 64) {
+        _bitCount = total;
+    } else {
+        flushWord();
+        _bitCount = total - 64;
+        _bits = _bitCount == 0 ? 0 : value >> (count - _bitCount);
+    }
+}
+
+inline int BitReader::readBit() {
+    if (_bitCount == 0) {
+        fill();
+        if (_bitCount == 0) {
+            return -1;
+        }
+    }
+    int value = (int) (_bits & 1);
+    _bits >>= 1;
+    _bitCount--;
+    return value;
+}
+
+inline uint64_t BitReader::readBits(int count) {
+    if (count < 0 || count > 64) {
+        error("BitReader::readBits: count must be between 0 and 64");
+    }
+    if (count > _bitCount) {
+        fill();
+        if (count > _bitCount) {
+            return readBitsSlow(count);
+        }
+    }
+    if (count == 64) {
+        uint64_t value = _bits;
+        _bits = 0;
+        _bitCount = 0;
+        return value;
+    }
+    uint64_t value = _bits & ((1ULL << count) - 1);
+    _bits >>= count;
+    _bitCount -= count;
+    return value;
+}
+
+#endif // _bitstream_h
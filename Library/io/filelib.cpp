@@ -5,6 +5,13 @@
  * Platform-dependent functions are handled through filelib_* functions
  * defined in filelibunix.cpp and filelibwindows.cpp.
  * 
+ * @version 2026/10/19
+ * - added readEntireFile, MappedFile, LineRange, splitLineChunks,
+ *   and forEachLineChunk
+ * - fileSize uses stat and returns a 64-bit size
+ * - readEntire reads the stream in blocks rather than one character at a time
+ * - readLines reuses one line buffer
+ * - added walkDirectory
  * @version 2016/11/20
  * - small bug fix in readEntireStream method (failed for non-text files)
  * @version 2016/11/12
@@ -28,6 +35,13 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdio>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "private/filelibunix.cpp"
 #include "private/filelibwindows.cpp"
 #include "gfilechooser.h"
@@ -37,6 +51,11 @@
 static void splitPath(const std::string& path, Vector<std::string> list);
 static bool recursiveMatch(const std::string& str, int sx, const std::string& pattern, int px);
 
+/* Constants */
+
+/* Size of the blocks in which readEntire reads a stream. */
+static const int READ_BLOCK_SIZE = 64 * 1024;
+
 /* Implementations */
 
 void createDirectory(const std::string& path) {
@@ -91,14 +110,49 @@ bool fileExists(const std::string& filename) {
     return platform::filelib_fileExists(filename);
 }
 
-int fileSize(const std::string& filename) {
-    std::ifstream input;
-    input.open(filename.c_str(), std::ifstream::binary);
-    if (input.fail()) {
-        return -1;
-    } else {
-        input.seekg(0, std::ifstream::end);
-        return (int) input.tellg();
+int64_t fileSize(const std::string& filename) {
+    return platform::filelib_fileSize(expandPathname(filename));
+}
+
+/*
+ * Implementation notes: forEachLineChunk
+ * --------------------------------------
+ * The last chunk is processed on the calling thread.  Each thread catches
+ * its own exception, since one escaping a std::thread would terminate the
+ * program, and the first one by chunk index is rethrown after the join.
+ */
+void forEachLineChunk(std::string_view text,
+                      const std::function<void (int index, std::string_view chunk)>& fn,
+                      int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    Vector<std::string_view> chunks = splitLineChunks(text, threadCount);
+    int count = chunks.size();
+    std::vector<std::exception_ptr> failures(count);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < count; i++) {
+        std::string_view chunk = chunks[i];
+        auto work = [&fn, &failures, i, chunk]() {
+            try {
+                fn(i, chunk);
+            } catch (...) {
+                failures[i] = std::current_exception();
+            }
+        };
+        if (i == count - 1) {
+            work();
+        } else {
+            workers.emplace_back(work);
+        }
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
     }
 }
 
@@ -230,23 +284,70 @@ std::string findOnPath(const std::string& path,
 }
 
 std::string readEntire(std::istream& input) {
-    std::ostringstream output;
-    while (true) {
-        int ch = input.get();
-        if (input.fail()) {
-            break;
+    std::string text;
+    char buffer[READ_BLOCK_SIZE];
+    while (input.read(buffer, READ_BLOCK_SIZE) || input.gcount() > 0) {
+        text.append(buffer, static_cast<size_t>(input.gcount()));
+    }
+    return text;
+}
+
+std::string readEntireFile(const std::string& filename) {
+    std::string text;
+    if (!readEntireFile(filename, text)) {
+        error("readEntireFile: Can't read \"" + filename + "\"");
+    }
+    return text;
+}
+
+/*
+ * Implementation notes: readEntireFile
+ * ------------------------------------
+ * The string is sized from the file's length and filled by one fread.  The
+ * loop afterward picks up anything past that length, which covers files
+ * that grow while being read and special files that report a size of 0.
+ */
+bool readEntireFile(const std::string& filename, std::string& text) {
+    text.clear();
+    std::string expanded = expandPathname(filename);
+    FILE* file = fopen(expanded.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    int64_t size = platform::filelib_fileSize(expanded);
+    size_t length = 0;
+    if (size > 0) {
+        text.resize(static_cast<size_t>(size));
+        length = fread(&text[0], 1, text.size(), file);
+    }
+    if (length == text.size()) {
+        char buffer[READ_BLOCK_SIZE];
+        size_t count;
+        while ((count = fread(buffer, 1, READ_BLOCK_SIZE, file)) > 0) {
+            text.append(buffer, count);
+            length += count;
         }
-        output.put(ch);
     }
-    return output.str();
+    bool ok = !ferror(file);
+    fclose(file);
+    if (!ok) {
+        text.clear();
+        return false;
+    }
+    text.resize(length);
+    return true;
 }
 
+/*
+ * Implementation notes: readLines
+ * -------------------------------
+ * The line buffer is declared outside the loop so that getline reuses its
+ * storage instead of allocating a new string for every line.
+ */
 Vector<std::string> readLines(std::istream& input) {
     Vector<std::string> lines;
-    while (true) {
-        std::string line;
-        getline(input, line);
-        if (input.fail()) break;
+    std::string line;
+    while (getline(input, line)) {
         lines.add(line);
     }
     return lines;
@@ -267,6 +368,204 @@ void setCurrentDirectory(const std::string& path) {
     return platform::filelib_setCurrentDirectory(path);
 }
 
+/*
+ * Implementation notes: splitLineChunks
+ * -------------------------------------
+ * Each boundary is placed at an equal share of the text and then moved
+ * forward to just past the next newline.  A boundary that lands inside
+ * the previous chunk's last line is absorbed, so a text with few long
+ * lines produces fewer chunks.
+ */
+Vector<std::string_view> splitLineChunks(std::string_view text, int count) {
+    if (count <= 0) {
+        error("splitLineChunks: count must be positive");
+    }
+    Vector<std::string_view> chunks;
+    size_t start = 0;
+    for (int i = 1; i <= count && start < text.size(); i++) {
+        size_t target = static_cast<size_t>(static_cast<double>(text.size()) * i / count);
+        size_t finish = text.size();
+        if (i < count && target > start) {
+            finish = text.find('\n', target - 1);
+            finish = (finish == std::string_view::npos) ? text.size() : finish + 1;
+        } else if (i < count) {
+            continue;
+        }
+        chunks.add(text.substr(start, finish - start));
+        start = finish;
+    }
+    return chunks;
+}
+
+/*
+ * Implementation notes: walkDirectory
+ * -----------------------------------
+ * Each thread keeps its own deque of directories still to be read.  A
+ * thread takes work from the back of its own deque, so on one thread the
+ * walk is depth-first, and when that is empty it steals from the front of
+ * another thread's deque, which holds the shallowest and therefore largest
+ * subtrees.  The pending count includes directories being read, and a
+ * directory's subdirectories are queued before it is counted as done, so
+ * the walk is over exactly when the count reaches zero.
+ */
+namespace {
+class DirectoryWalker {
+public:
+    DirectoryWalker(const std::function<bool (const DirectoryEntry& entry)>& visitor,
+                    const WalkOptions& options, int threadCount)
+            : visitor(visitor),
+              options(options),
+              queues(threadCount),
+              pending(0),
+              stopped(false),
+              separator(getDirectoryPathSeparator()[0]) {
+        // empty
+    }
+
+    void run(const std::string& root) {
+        pending = 1;
+        if (!readDirectory(0, {root, 0})) {
+            error("walkDirectory: Can't open \"" + root + "\"");
+        }
+        pending--;
+        std::vector<std::thread> workers;
+        for (int i = 1; i < (int) queues.size(); i++) {
+            workers.emplace_back([this, i]() { work(i); });
+        }
+        work(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+private:
+    struct PendingDirectory {
+        std::string path;
+        int depth;      // depth of the entries inside this directory
+    };
+
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<PendingDirectory> directories;
+    };
+
+    /* Reads one directory, visiting its entries and queueing its subdirectories. */
+    bool readDirectory(int worker, const PendingDirectory& dir) {
+        std::vector<PendingDirectory> found;
+        bool needsSeparator = !dir.path.empty() && dir.path.back() != '/' && dir.path.back() != separator;
+        bool ok = platform::filelib_readDirectory(dir.path, [&](DirectoryEntry& entry) {
+            entry.path = dir.path;
+            if (needsSeparator) {
+                entry.path += separator;
+            }
+            entry.path += entry.name;
+            entry.depth = dir.depth;
+            bool descend = entry.isDirectory && (options.maxDepth < 0 || dir.depth < options.maxDepth);
+            if ((!options.filesOnly || entry.isFile)
+                    && (options.pattern.empty() || matchFilenamePattern(entry.name, options.pattern))) {
+                std::lock_guard<std::mutex> guard(visitorLock);
+                if (stopped) {
+                    return false;
+                }
+                try {
+                    descend = visitor(entry) && descend;
+                } catch (...) {
+                    failure = std::current_exception();
+                    stopped = true;
+                    return false;
+                }
+            }
+            if (descend) {
+                found.push_back({entry.path, dir.depth + 1});
+            }
+            return true;
+        });
+        if (!found.empty()) {
+            pending += (int) found.size();
+            WorkQueue& queue = queues[worker];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            for (PendingDirectory& subdir : found) {
+                queue.directories.push_back(std::move(subdir));
+            }
+        }
+        return ok;
+    }
+
+    /* Takes a directory from this thread's queue, or steals one from another thread. */
+    bool take(int worker, PendingDirectory& dir) {
+        int count = (int) queues.size();
+        for (int i = 0; i < count; i++) {
+            WorkQueue& queue = queues[(worker + i) % count];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (!queue.directories.empty()) {
+                if (i == 0) {
+                    dir = std::move(queue.directories.back());
+                    queue.directories.pop_back();
+                } else {
+                    dir = std::move(queue.directories.front());
+                    queue.directories.pop_front();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(int worker) {
+        PendingDirectory dir;
+        while (!stopped) {
+            if (take(worker, dir)) {
+                readDirectory(worker, dir);
+                pending--;
+            } else if (pending == 0) {
+                break;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    const std::function<bool (const DirectoryEntry& entry)>& visitor;
+    const WalkOptions& options;
+    std::vector<WorkQueue> queues;
+    std::atomic<int> pending;
+    std::atomic<bool> stopped;
+    std::mutex visitorLock;
+    std::exception_ptr failure;
+    char separator;
+};
+}
+
+void walkDirectory(const std::string& path,
+                   const std::function<bool (const DirectoryEntry& entry)>& visitor,
+                   const WalkOptions& options) {
+    int threadCount = options.threadCount;
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    DirectoryWalker walker(visitor, options, threadCount);
+    walker.run(path.empty() ? "." : expandPathname(path));
+}
+
+Vector<DirectoryEntry> walkDirectory(const std::string& path, const WalkOptions& options) {
+    std::vector<DirectoryEntry> found;
+    walkDirectory(path, [&found](const DirectoryEntry& entry) {
+        found.push_back(entry);
+        return true;
+    }, options);
+    std::sort(found.begin(), found.end(), [](const DirectoryEntry& a, const DirectoryEntry& b) {
+        return a.path < b.path;
+    });
+    Vector<DirectoryEntry> entries;
+    for (const DirectoryEntry& entry : found) {
+        entries.add(entry);
+    }
+    return entries;
+}
+
 bool writeEntireFile(const std::string& filename,
                      const std::string& text,
                      bool append) {
@@ -284,6 +583,124 @@ bool writeEntireFile(const std::string& filename,
     return !output.fail();
 }
 
+LineRange::LineRange(std::string_view text)
+        : _text(text) {
+    // empty
+}
+
+LineRange::iterator LineRange::begin() const {
+    return iterator(_text.data(), _text.data() + _text.size());
+}
+
+LineRange::iterator LineRange::end() const {
+    const char* end = _text.data() + _text.size();
+    return iterator(end, end);
+}
+
+LineRange::iterator::iterator(const char* start, const char* end)
+        : _start(start),
+          _end(end) {
+    findLine();
+}
+
+LineRange::iterator& LineRange::iterator::operator ++() {
+    _start = _next;
+    findLine();
+    return *this;
+}
+
+LineRange::iterator LineRange::iterator::operator ++(int) {
+    iterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+/*
+ * Finds the end of the line that begins at _start, using memchr so that
+ * long lines are scanned a word at a time.
+ */
+void LineRange::iterator::findLine() {
+    if (_start == _end) {
+        _next = _end;
+        _line = std::string_view();
+        return;
+    }
+    const char* newline = static_cast<const char*>(memchr(_start, '\n', _end - _start));
+    const char* lineEnd = newline ? newline : _end;
+    _next = newline ? newline + 1 : _end;
+    if (newline && lineEnd > _start && lineEnd[-1] == '\r') {
+        lineEnd--;
+    }
+    _line = std::string_view(_start, lineEnd - _start);
+}
+
+MappedFile::MappedFile()
+        : _data(nullptr),
+          _size(0),
+          _handle(nullptr),
+          _open(false) {
+    // empty
+}
+
+MappedFile::MappedFile(const std::string& filename)
+        : MappedFile() {
+    if (!open(filename)) {
+        error("MappedFile: Can't map \"" + filename + "\"");
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+        : MappedFile() {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator =(MappedFile&& other) {
+    if (this != &other) {
+        close();
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_handle, other._handle);
+        std::swap(_open, other._open);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close() {
+    if (_open) {
+        platform::filelib_unmapFile(_data, _size, _handle);
+        _data = nullptr;
+        _size = 0;
+        _handle = nullptr;
+        _open = false;
+    }
+}
+
+bool MappedFile::isOpen() const {
+    return _open;
+}
+
+LineRange MappedFile::lines() const {
+    return LineRange(text());
+}
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+    _open = platform::filelib_mapFile(expandPathname(filename), _data, _size, _handle);
+    return _open;
+}
+
+int64_t MappedFile::size() const {
+    return static_cast<int64_t>(_size);
+}
+
+std::string_view MappedFile::text() const {
+    return std::string_view(_data, _size);
+}
+
 /* Private functions */
 
 static void splitPath(const std::string& path, Vector<std::string> list) {
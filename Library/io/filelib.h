@@ -7,15 +7,27 @@
  * Windows, and Linux.  Directory and search paths are allowed to
  * contain separators in any of the supported styles, which usually
  * makes it possible to use the same code on different platforms.
+ *
+ * @version 2026/10/19
+ * - added readEntireFile, MappedFile, LineRange, splitLineChunks,
+ *   and forEachLineChunk for reading large files quickly
+ * - fileSize returns a 64-bit size
+ * - readEntire reads the stream in blocks rather than one character at a time
+ * - added walkDirectory, DirectoryEntry, and WalkOptions for recursive,
+ *   optionally parallel directory traversal
  */
 
 
 #ifndef _filelib_h
 #define _filelib_h
 
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <iterator>
 #include <string>
+#include <string_view>
 
 #include "vector.h"
 
@@ -76,7 +88,7 @@ bool fileExists(const std::string& filename);
  * Returns the size of the given file in bytes.
  * Returns -1 if the file does not exist or cannot be read.
  */
-int fileSize(const std::string& filename);
+int64_t fileSize(const std::string& filename);
 
 /**
  * Returns the canonical name of a file found using a search path.
@@ -91,6 +103,31 @@ int fileSize(const std::string& filename);
  */
 std::string findOnPath(const std::string& path, const std::string& filename);
 
+/**
+ * Divides <code>text</code> into chunks of whole lines as with
+ * <code>splitLineChunks</code> and calls <code>fn(index, chunk)</code> on
+ * each chunk, running the calls in parallel on <code>threadCount</code>
+ * threads, or one thread per processor if <code>threadCount</code> is 0.
+ * The function returns when all of the calls have finished.  The calls must
+ * not modify shared data without synchronizing; a simple approach is for
+ * each call to write its result into the slot for its chunk index and to
+ * combine the results afterward.  If a call throws an exception, the first
+ * such exception is rethrown here once all threads have stopped.
+ *
+ *<pre>
+ *    MappedFile file("huge.log");
+ *    Vector<int> counts(4);
+ *    forEachLineChunk(file.text(), [&](int index, std::string_view chunk) {
+ *        for (std::string_view line : LineRange(chunk)) {
+ *            if (line.find("ERROR") != std::string_view::npos) counts[index]++;
+ *        }
+ *    }, 4);
+ *</pre>
+ */
+void forEachLineChunk(std::string_view text,
+                      const std::function<void (int index, std::string_view chunk)>& fn,
+                      int threadCount = 0);
+
 /**
  * Returns an absolute filename for the given file or directory.
  * This converts from, for example, "temp/foo.txt" to "/Users/jsmith12/Documents/temp/foo.txt".
@@ -169,6 +206,16 @@ bool isDirectory(const std::string& filename);
  */
 bool isFile(const std::string& filename);
 
+/**
+ * Divides <code>text</code> into at most <code>count</code> consecutive
+ * chunks of roughly equal size, each of which ends just after a newline
+ * character or at the end of the text, so that no line is split between
+ * two chunks.  The chunks are views into <code>text</code> and together
+ * cover all of it.  Fewer chunks are returned if the text has fewer lines.
+ * @throw ErrorException if count is not positive
+ */
+Vector<std::string_view> splitLineChunks(std::string_view text, int count);
+
 /**
  * Adds an alphabetized list of the files in the specified directory
  * to a vector that is returned.  This list excludes the
@@ -215,6 +262,24 @@ bool openFile(std::ofstream& stream, const std::string& filename);
  */
 std::string readEntire(std::istream& input);
 
+/**
+ * Reads the entire contents of the file with the given name and returns
+ * them as a string.  The file is read in binary mode with a single bulk
+ * read sized from the file's length, so this is much faster than
+ * <code>readEntire</code> for large files.
+ * @throw ErrorException if the file does not exist or cannot be read
+ */
+std::string readEntireFile(const std::string& filename);
+
+/**
+ * Reads the entire contents of the file with the given name into
+ * <code>text</code>, replacing its previous contents.  Returns
+ * <code>true</code> if the read succeeded and <code>false</code> if the
+ * file could not be opened or read, in which case <code>text</code>
+ * is left empty.
+ */
+bool readEntireFile(const std::string& filename, std::string& text);
+
 /**
  * Reads the entire contents of the specified input stream into the
  * string Vector <code>lines</code>.  The client is responsible for
@@ -241,6 +306,85 @@ void rewindStream(std::istream& input);
  */
 void setCurrentDirectory(const std::string& path);
 
+/**
+ * An entry found by <code>walkDirectory</code>.  The type of the entry
+ * comes from the directory listing itself wherever the platform provides
+ * it, so no extra system call is made per entry.  Symbolic links are
+ * reported as such and are neither directories nor files; call
+ * <code>isDirectory(entry.path)</code> to find out what a link refers to.
+ */
+struct DirectoryEntry {
+    std::string path;       // the directory being walked, joined with name
+    std::string name;       // the last component of the path
+    int depth;              // 0 for entries directly inside the directory walked
+    bool isDirectory;
+    bool isFile;            // a regular file
+    bool isSymbolicLink;
+};
+
+/**
+ * Options that control <code>walkDirectory</code>.
+ */
+struct WalkOptions {
+    /**
+     * If not empty, only entries whose names match this pattern, as with
+     * <code>matchFilenamePattern</code>, are passed to the visitor.  The
+     * walk still descends into directories whose names do not match.
+     */
+    std::string pattern;
+
+    /**
+     * The deepest level at which to report entries, or -1 for no limit.
+     * A value of 0 reports only the entries of the directory itself.
+     */
+    int maxDepth = -1;
+
+    /**
+     * The number of threads that read directories, or 0 for one per processor.
+     */
+    int threadCount = 1;
+
+    /**
+     * If true, only regular files are passed to the visitor.
+     */
+    bool filesOnly = false;
+};
+
+/**
+ * Visits every entry below the directory <code>path</code>, calling
+ * <code>visitor(entry)</code> as each one is found instead of collecting
+ * them first.  If the visitor returns <code>false</code> for a directory,
+ * that directory's contents are skipped.  Entries arrive in no particular
+ * order.  When <code>options.threadCount</code> is more than 1, the
+ * directories are read in parallel, but calls to the visitor never overlap,
+ * so it needs no locking of its own.  Subdirectories that cannot be read
+ * are skipped.  If the visitor throws an exception, the walk stops and
+ * the exception is rethrown.
+ *
+ *<pre>
+ *    WalkOptions options;
+ *    options.pattern = "*.txt";
+ *    options.threadCount = 0;
+ *    walkDirectory("data", [](const DirectoryEntry& entry) {
+ *        cout << entry.path << endl;
+ *        return true;
+ *    }, options);
+ *</pre>
+ *
+ * @throw ErrorException if <code>path</code> cannot be read as a directory
+ */
+void walkDirectory(const std::string& path,
+                   const std::function<bool (const DirectoryEntry& entry)>& visitor,
+                   const WalkOptions& options = WalkOptions());
+
+/**
+ * Returns all of the entries below the directory <code>path</code> that
+ * <code>walkDirectory</code> would visit, sorted by path.
+ * @throw ErrorException if <code>path</code> cannot be read as a directory
+ */
+Vector<DirectoryEntry> walkDirectory(const std::string& path,
+                                     const WalkOptions& options = WalkOptions());
+
 /**
  * Opens the given file and writes the given text into it.
  * Normally this function replaces any previous contents of the file, but
@@ -253,6 +397,167 @@ bool writeEntireFile(const std::string& filename,
                      const std::string& text,
                      bool append = false);
 
+/**
+ * A range over the lines of some text, for use in a range-based
+ * <code>for</code> loop.  Lines are found lazily as the loop advances and
+ * each one is a view into the text, so no strings are copied.  Lines end
+ * at each newline character, which is not included, and a carriage return
+ * just before the newline is removed as well.  As with <code>readLines</code>,
+ * a newline at the very end of the text does not begin another line.
+ *
+ *<pre>
+ *    for (std::string_view line : LineRange(text)) {
+ *        ...
+ *    }
+ *</pre>
+ */
+class LineRange {
+public:
+    /**
+     * An iterator over the lines of a <code>LineRange</code>.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        iterator() = default;
+        iterator(const char* start, const char* end);
+
+        const std::string_view& operator *() const {
+            return _line;
+        }
+
+        const std::string_view* operator ->() const {
+            return &_line;
+        }
+
+        iterator& operator ++();
+        iterator operator ++(int);
+
+        bool operator ==(const iterator& other) const {
+            return _start == other._start;
+        }
+
+        bool operator !=(const iterator& other) const {
+            return _start != other._start;
+        }
+
+    private:
+        void findLine();
+
+        const char* _start = nullptr;   // beginning of the current line
+        const char* _next = nullptr;    // beginning of the line after it
+        const char* _end = nullptr;     // end of the text
+        std::string_view _line;
+    };
+
+    /**
+     * Creates a range over the lines of the given text, which must remain
+     * unchanged for as long as the range or its lines are in use.
+     */
+    explicit LineRange(std::string_view text);
+
+    /**
+     * Returns an iterator positioned at the first line.
+     */
+    iterator begin() const;
+
+    /**
+     * Returns an iterator positioned just past the last line.
+     */
+    iterator end() const;
+
+private:
+    std::string_view _text;
+};
+
+/**
+ * A read-only view of the contents of a file that is mapped into memory
+ * rather than read.  The operating system loads pages of the file as they
+ * are touched, so opening even a very large file is immediate and its
+ * contents are never copied into a string.
+ *
+ *<pre>
+ *    MappedFile file("huge.log");
+ *    for (std::string_view line : file.lines()) {
+ *        ...
+ *    }
+ *</pre>
+ *
+ * The views returned by <code>text</code> and <code>lines</code> are valid
+ * until the file is closed.  A mapped file must not be modified or truncated
+ * by another program while it is open.
+ */
+class MappedFile {
+public:
+    /**
+     * Creates an object that is not associated with any file.
+     */
+    MappedFile();
+
+    /**
+     * Opens and maps the file with the given name.
+     * @throw ErrorException if the file does not exist or cannot be mapped
+     */
+    explicit MappedFile(const std::string& filename);
+
+    /**
+     * Takes over the mapping of another object, leaving it closed.
+     */
+    MappedFile(MappedFile&& other);
+    MappedFile& operator =(MappedFile&& other);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator =(const MappedFile&) = delete;
+
+    /**
+     * Unmaps the file, if one is open.
+     */
+    virtual ~MappedFile();
+
+    /**
+     * Unmaps the file, if one is open.  Any views of its text become invalid.
+     */
+    void close();
+
+    /**
+     * Returns <code>true</code> if a file is currently mapped.
+     */
+    bool isOpen() const;
+
+    /**
+     * Returns a range over the lines of the file.
+     */
+    LineRange lines() const;
+
+    /**
+     * Closes any file that is open and maps the file with the given name.
+     * Returns <code>true</code> if the file was mapped, and <code>false</code>
+     * if it does not exist or cannot be mapped.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * Returns the size of the file in bytes.
+     */
+    int64_t size() const;
+
+    /**
+     * Returns the contents of the file.
+     */
+    std::string_view text() const;
+
+private:
+    const char* _data;   // start of the mapping, or nullptr for an empty file
+    size_t _size;
+    void* _handle;       // platform mapping handle, if any
+    bool _open;
+};
+
 /**
  * Platform-dependent functions that differ by operating system.
  * @private
@@ -262,6 +567,7 @@ namespace platform {
     void filelib_deleteFile(const std::string& path);
     std::string filelib_expandPathname(const std::string& filename);
     bool filelib_fileExists(const std::string& filename);
+    int64_t filelib_fileSize(const std::string& filename);
     std::string filelib_getAbsolutePath(const std::string& path);
     std::string filelib_getCurrentDirectory();
     std::string filelib_getDirectoryPathSeparator();
@@ -270,7 +576,11 @@ namespace platform {
     bool filelib_isDirectory(const std::string& filename);
     bool filelib_isFile(const std::string& filename);
     void filelib_listDirectory(const std::string& path, Vector<std::string>& list);
+    bool filelib_mapFile(const std::string& filename, const char*& data, size_t& size, void*& handle);
+    bool filelib_readDirectory(const std::string& path,
+                               const std::function<bool (DirectoryEntry& entry)>& visit);
     void filelib_setCurrentDirectory(const std::string& path);
+    void filelib_unmapFile(const char* data, size_t size, void* handle);
 }
 
 #endif // _filelib_h
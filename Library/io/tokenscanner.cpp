@@ -3,6 +3,8 @@
  * ----------------------
  * Implementation for the TokenScanner class.
  * 
+ * @version 2026/10/19
+ * - string input is scanned in place; added buffer mode and compiled operators
  * @version 2016/11/26
  * - added getInput method
  * - replaced occurrences of string with const string& for efficiency
@@ -14,7 +16,9 @@
 
 #include "tokenscanner.h"
 #include <cctype>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include "error.h"
 #include "strlib.h"
 
@@ -34,36 +38,38 @@ TokenScanner::TokenScanner(const std::string& str) {
 }
 
 TokenScanner::~TokenScanner() {
-    if (stringInputFlag) {
-        delete isp;
-    }
+    // empty
 }
 
 void TokenScanner::addOperator(const std::string& op) {
-    StringCell* cp = new StringCell;
-    cp->str = op;
-    cp->link = operators;
-    operators = cp;
+    operators.push_back(op);
+    operatorsCompiled = false;
 }
 
 void TokenScanner::addWordCharacters(const std::string& str) {
     wordChars += str;
+    for (char ch : str) {
+        wordTable[(unsigned char) ch] = true;
+    }
 }
 
 int TokenScanner::getChar() {
-    return isp->get();
+    if (isp) {
+        return isp->get();
+    }
+    return pos < input.size() ? (unsigned char) input[pos++] : EOF;
 }
 
 std::string TokenScanner::getInput() const {
-    return buffer;
+    return std::string(input);
 }
 
 int TokenScanner::getPosition() const {
-    if (!savedTokens) {
-        return int(isp->tellg());
-    } else {
-        return int(isp->tellg()) - savedTokens->str.length();
+    int position = isp ? int(isp->tellg()) : int(pos);
+    if (!savedTokens.empty()) {
+        position -= savedTokens.back().length();
     }
+    return position;
 }
 
 std::string TokenScanner::getStringValue(const std::string& token) const {
@@ -123,12 +129,12 @@ std::string TokenScanner::getStringValue(const std::string& token) const {
     return str;
 }
 
-TokenScanner::TokenType TokenScanner::getTokenType(const std::string& token) const {
+TokenScanner::TokenType TokenScanner::getTokenType(std::string_view token) const {
     if (token.empty()) {
         return TokenType(EOF);
     }
 
-    char ch = token[0];
+    unsigned char ch = token[0];
     if (isspace(ch)) {
         return SEPARATOR;
     } else if (ch == '"' || (ch == '\'' && token.length() > 1)) {
@@ -157,18 +163,245 @@ void TokenScanner::ignoreWhitespace() {
 }
 
 bool TokenScanner::isWordCharacter(char ch) const {
-    return isalnum(ch) || wordChars.find(ch) != std::string::npos;
+    return wordTable[(unsigned char) ch];
 }
 
 std::string TokenScanner::nextToken() {
-    if (savedTokens) {
-        StringCell* cp = savedTokens;
-        std::string token = cp->str;
-        savedTokens = cp->link;
-        delete cp;
+    if (!savedTokens.empty()) {
+        std::string token = std::move(savedTokens.back());
+        savedTokens.pop_back();
         return token;
     }
+    if (isp) {
+        return nextStreamToken();
+    }
+    return std::string(scanBufferToken().text);
+}
+
+/*
+ * Implementation notes: saveToken
+ * -------------------------------
+ * In buffer mode, the usual pattern of reading a token and saving it
+ * again, as hasMoreTokens does, just moves the scanner back to the start
+ * of the token, so nothing needs to be stored.  Other tokens are kept on
+ * the savedTokens stack.
+ */
+void TokenScanner::saveToken(const std::string& token) {
+    if (!isp && savedTokens.empty() && pos == lastEnd
+            && input.substr(lastStart, lastEnd - lastStart) == token) {
+        pos = lastStart;
+        linePos = lastStart;
+        lineStart = lastLineStart;
+        lineNumber = lastLineNumber;
+        return;
+    }
+    savedTokens.push_back(token);
+}
+
+TokenScanner::Token TokenScanner::scanToken() {
+    if (savedTokens.empty() && !isp) {
+        return scanBufferToken();
+    }
+    if (!savedTokens.empty()) {
+        currentToken = std::move(savedTokens.back());
+        savedTokens.pop_back();
+    } else {
+        currentToken = nextStreamToken();
+    }
+    return Token {currentToken, getTokenType(currentToken), -1, 0, 0};
+}
+
+void TokenScanner::scanNumbers() {
+    scanNumbersFlag = true;
+}
+
+void TokenScanner::scanStrings() {
+    scanStringsFlag = true;
+}
+
+void TokenScanner::setInput(std::istream& infile) {
+    resetInput();
+    buffer.clear();
+    input = std::string_view();
+    isp = &infile;
+}
+
+void TokenScanner::setInput(const std::string& str) {
+    resetInput();
+    buffer = str;
+    input = buffer;
+    isp = nullptr;
+}
+
+void TokenScanner::setInputBuffer(std::string_view text) {
+    resetInput();
+    buffer.clear();
+    input = text;
+    isp = nullptr;
+}
+
+std::vector<TokenScanner::Token> TokenScanner::tokenize() {
+    if (isp) {
+        buffer.assign(std::istreambuf_iterator<char>(*isp), std::istreambuf_iterator<char>());
+        input = buffer;
+        isp = nullptr;
+        pos = 0;
+        linePos = lineStart = 0;
+        lineNumber = 1;
+    }
+    std::vector<Token> tokens;
+    heldTokens.clear();
+    while (!savedTokens.empty()) {
+        heldTokens.push_back(std::move(savedTokens.back()));
+        savedTokens.pop_back();
+        const std::string& token = heldTokens.back();
+        if (!token.empty()) {
+            tokens.push_back(Token {token, getTokenType(token), -1, 0, 0});
+        }
+    }
+    while (true) {
+        Token token = scanBufferToken();
+        if (token.text.empty()) {
+            break;
+        }
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+void TokenScanner::ungetChar(int) {
+    if (isp) {
+        isp->unget();
+    } else if (pos > 0) {
+        pos--;
+    }
+}
+
+void TokenScanner::verifyToken(const std::string& expected) {
+    std::string token = nextToken();
+    if (token != expected) {
+        std::string msg = "TokenScanner::verifyToken: Found \"" + token + "\""
+                + " when expecting \"" + expected + "\"";
+        if (!input.empty()) {
+            msg += "\ninput = \"" + std::string(input) + "\"";
+        }
+        error(msg);
+    }
+}
+
+/* Private methods */
+
+/*
+ * Implementation notes: compileOperators
+ * --------------------------------------
+ * The operators are compiled into a trie whose nodes are the states of
+ * an automaton, stored as a table with one row per state and one column
+ * per character that occurs in some operator.  Matching an operator then
+ * takes one table lookup per character instead of a comparison with
+ * every operator.  The table is rebuilt after addOperator is called.
+ */
+void TokenScanner::compileOperators() {
+    std::fill(operatorColumns, operatorColumns + 256, 0);
+    operatorColumnCount = 1;
+    for (const std::string& op : operators) {
+        for (char ch : op) {
+            int& column = operatorColumns[(unsigned char) ch];
+            if (column == 0) {
+                column = operatorColumnCount++;
+            }
+        }
+    }
+    operatorTable.assign(operatorColumnCount, -1);
+    operatorAccepts.assign(1, false);
+    for (const std::string& op : operators) {
+        int state = 0;
+        for (char ch : op) {
+            size_t index = state * operatorColumnCount + operatorColumns[(unsigned char) ch];
+            if (operatorTable[index] < 0) {
+                operatorTable[index] = (int) operatorAccepts.size();
+                operatorAccepts.push_back(false);
+                operatorTable.resize(operatorTable.size() + operatorColumnCount, -1);
+            }
+            state = operatorTable[index];
+        }
+        if (state > 0) {
+            operatorAccepts[state] = true;
+        }
+    }
+    operatorsCompiled = true;
+}
+
+void TokenScanner::initScanner() {
+    ignoreWhitespaceFlag = false;
+    ignoreCommentsFlag = false;
+    scanNumbersFlag = false;
+    scanStringsFlag = false;
+    isp = nullptr;
+    for (int ch = 0; ch < 256; ch++) {
+        wordTable[ch] = isalnum(ch) != 0;
+    }
+    operatorColumnCount = 0;
+    operatorsCompiled = false;
+    resetInput();
+}
+
+/*
+ * Advances the line count to the given offset in the buffer, counting
+ * the newlines from the last offset that was located.
+ */
+void TokenScanner::locate(size_t offset) {
+    if (offset < linePos) {
+        linePos = lineStart = 0;
+        lineNumber = 1;
+    }
+    const char* data = input.data();
+    size_t i = linePos;
+    while (i < offset) {
+        const void* newline = std::memchr(data + i, '\n', offset - i);
+        if (!newline) {
+            break;
+        }
+        i = (const char*) newline - data + 1;
+        lineNumber++;
+        lineStart = i;
+    }
+    linePos = offset;
+}
+
+/*
+ * Returns the end of the longest operator that starts at the given offset
+ * in the buffer.  A character that does not begin any operator is an
+ * operator token by itself.
+ */
+size_t TokenScanner::matchOperator(size_t start) {
+    if (!operatorsCompiled) {
+        compileOperators();
+    }
+    size_t best = start + 1;
+    int state = 0;
+    for (size_t i = start; i < input.size(); i++) {
+        int column = operatorColumns[(unsigned char) input[i]];
+        if (column == 0) {
+            break;
+        }
+        state = operatorTable[state * operatorColumnCount + column];
+        if (state < 0) {
+            break;
+        }
+        if (operatorAccepts[state]) {
+            best = i + 1;
+        }
+    }
+    return best;
+}
 
+/*
+ * Implementation notes: nextStreamToken
+ * -------------------------------------
+ * Reads a token from the input stream a character at a time, so that the
+ * stream is left just after the token for the client to keep reading.
+ */
+std::string TokenScanner::nextStreamToken() {
     while (true) {
         if (ignoreWhitespaceFlag) {
             skipSpaces();
@@ -215,15 +448,28 @@ std::string TokenScanner::nextToken() {
             isp->unget();
             return scanWord();
         }
+        if (!operatorsCompiled) {
+            compileOperators();
+        }
         std::string op = std::string(1, ch);
-        while (isOperatorPrefix(op)) {
+        size_t length = 1;
+        int state = 0;
+        while (true) {
+            int column = operatorColumns[(unsigned char) ch];
+            state = column == 0 ? -1 : operatorTable[state * operatorColumnCount + column];
+            if (state < 0) {
+                break;
+            }
+            if (operatorAccepts[state]) {
+                length = op.length();
+            }
             ch = isp->get();
             if (ch == EOF) {
                 break;
             }
             op += ch;
         }
-        while (op.length() > 1 && !isOperator(op)) {
+        while (op.length() > length) {
             isp->unget();
             op.erase(op.length() - 1, 1);
         }
@@ -231,84 +477,133 @@ std::string TokenScanner::nextToken() {
     }
 }
 
-void TokenScanner::saveToken(const std::string& token) {
-    StringCell* cp = new StringCell;
-    cp->str = token;
-    cp->link = savedTokens;
-    savedTokens = cp;
-}
-
-void TokenScanner::scanNumbers() {
-    scanNumbersFlag = true;
-}
-
-void TokenScanner::scanStrings() {
-    scanStringsFlag = true;
-}
-
-void TokenScanner::setInput(std::istream& infile) {
-    stringInputFlag = false;
-    isp = &infile;
-    savedTokens = nullptr;
-}
-
-void TokenScanner::setInput(const std::string& str) {
-    stringInputFlag = true;
-    buffer = str;
-    isp = new std::istringstream(buffer);
-    savedTokens = nullptr;
-}
-
-void TokenScanner::ungetChar(int) {
-    isp->unget();
+/*
+ * Resets the position, line tracking, and saved tokens for a new input.
+ */
+void TokenScanner::resetInput() {
+    pos = 0;
+    savedTokens.clear();
+    linePos = lineStart = 0;
+    lineNumber = 1;
+    lastStart = lastEnd = lastLineStart = 0;
+    lastLineNumber = 1;
+    currentToken.clear();
+    heldTokens.clear();
 }
 
-void TokenScanner::verifyToken(const std::string& expected) {
-    std::string token = nextToken();
-    if (token != expected) {
-        std::string msg = "TokenScanner::verifyToken: Found \"" + token + "\""
-                + " when expecting \"" + expected + "\"";
-        if (!buffer.empty()) {
-            msg += "\ninput = \"" + buffer + "\"";
+/*
+ * Implementation notes: scanBufferToken
+ * -------------------------------------
+ * This is nextToken for buffer mode.  It follows the same rules as
+ * nextStreamToken, but finds the end of each token by indexing into the
+ * buffer and returns a view of it, so nothing is copied.
+ */
+TokenScanner::Token TokenScanner::scanBufferToken() {
+    const char* data = input.data();
+    size_t end = input.size();
+    size_t i = pos;
+    while (true) {
+        if (ignoreWhitespaceFlag) {
+            while (i < end && isspace((unsigned char) data[i])) {
+                i++;
+            }
         }
-        error(msg);
+        if (ignoreCommentsFlag && i + 1 < end && data[i] == '/') {
+            if (data[i + 1] == '/') {
+                i += 2;
+                while (i < end && data[i] != '\n' && data[i] != '\r') {
+                    i++;
+                }
+                if (i < end) {
+                    i++;
+                }
+                continue;
+            } else if (data[i + 1] == '*') {
+                size_t close = input.find("*/", i + 2);
+                i = close == std::string_view::npos ? end : close + 2;
+                continue;
+            }
+        }
+        break;
     }
-}
 
-/* Private methods */
-
-void TokenScanner::initScanner() {
-    ignoreWhitespaceFlag = false;
-    ignoreCommentsFlag = false;
-    scanNumbersFlag = false;
-    scanStringsFlag = false;
-    operators = nullptr;
+    locate(i);
+    Token token {std::string_view(), TokenType(EOF), int(i), lineNumber, int(i - lineStart) + 1};
+    size_t stop = i;
+    if (i < end) {
+        unsigned char ch = data[i];
+        if ((ch == '"' || ch == '\'') && scanStringsFlag) {
+            stop = scanBufferString(i);
+        } else if (isdigit(ch) && scanNumbersFlag) {
+            stop = scanBufferNumber(i);
+        } else if (wordTable[ch]) {
+            stop = i + 1;
+            while (stop < end && wordTable[(unsigned char) data[stop]]) {
+                stop++;
+            }
+        } else {
+            stop = matchOperator(i);
+        }
+        token.text = input.substr(i, stop - i);
+        token.type = getTokenType(token.text);
+    }
+    lastStart = i;
+    lastEnd = stop;
+    lastLineStart = lineStart;
+    lastLineNumber = lineNumber;
+    pos = stop;
+    return token;
 }
 
 /*
- * Implementation notes: isOperator, isOperatorPrefix
- * --------------------------------------------------
- * These methods search the list of operators and return true if the
- * specified operator is either in the list or a prefix of an operator
- * in the list, respectively.  This code could be made considerably more
- * efficient by implementing operators as a trie.
+ * Returns the end of the number that starts at the given offset, by the
+ * same rules as scanNumber: digits, an optional fraction, and an exponent
+ * that is only included if it has at least one digit.
  */
-bool TokenScanner::isOperator(const std::string& op) {
-    for (StringCell *cp = operators; cp != nullptr; cp = cp->link) {
-        if (op == cp->str) {
-            return true;
+size_t TokenScanner::scanBufferNumber(size_t start) const {
+    const char* data = input.data();
+    size_t end = input.size();
+    size_t i = start + 1;
+    while (i < end && isdigit((unsigned char) data[i])) {
+        i++;
+    }
+    if (i < end && data[i] == '.') {
+        i++;
+        while (i < end && isdigit((unsigned char) data[i])) {
+            i++;
         }
     }
-    return false;
+    if (i < end && (data[i] == 'E' || data[i] == 'e')) {
+        size_t j = i + 1;
+        if (j < end && (data[j] == '+' || data[j] == '-')) {
+            j++;
+        }
+        if (j < end && isdigit((unsigned char) data[j])) {
+            while (j < end && isdigit((unsigned char) data[j])) {
+                j++;
+            }
+            i = j;
+        }
+    }
+    return i;
 }
 
-bool TokenScanner::isOperatorPrefix(const std::string& op) {
-    for (StringCell* cp = operators; cp != nullptr; cp = cp->link) {
-        if (startsWith(cp->str, op)) {
-            return true;
+/*
+ * Returns the end of the quoted string that starts at the given offset,
+ * just past its closing quotation mark.
+ */
+size_t TokenScanner::scanBufferString(size_t start) const {
+    char delim = input[start];
+    bool escape = false;
+    for (size_t i = start + 1; i < input.size(); i++) {
+        char ch = input[i];
+        if (ch == delim && !escape) {
+            return i + 1;
         }
+        escape = (ch == '\\') && !escape;
     }
-    return false;
+    error("TokenScanner::scanString: found unterminated string");
+    return input.size();
 }
 
 /*
@@ -360,10 +655,13 @@ std::string TokenScanner::scanNumber() {
             } else if (isdigit(ch)) {
                 state = SCANNING_EXPONENT;
             } else {
-                if (ch != EOF) {
+                if (ch == EOF) {
+                    isp->clear();   // otherwise the ungets below would fail
+                } else {
                     isp->unget();
                 }
                 isp->unget();
+                token.erase(token.length() - 1);
                 state = FINAL_STATE;
             }
             break;
@@ -371,11 +669,14 @@ std::string TokenScanner::scanNumber() {
             if (isdigit(ch)) {
                 state = SCANNING_EXPONENT;
             } else {
-                if (ch != EOF) {
+                if (ch == EOF) {
+                    isp->clear();   // otherwise the ungets below would fail
+                } else {
                     isp->unget();
                 }
                 isp->unget();
                 isp->unget();
+                token.erase(token.length() - 2);
                 state = FINAL_STATE;
             }
             break;
@@ -468,8 +769,8 @@ void TokenScanner::skipSpaces() {
 std::ostream& operator <<(std::ostream& out, const TokenScanner& scanner) {
     out << "TokenScanner{";
     bool first = true;
-    if (!scanner.buffer.empty()) {
-        out << "input=\"" << scanner.buffer << "\"";
+    if (!scanner.input.empty()) {
+        out << "input=\"" << scanner.input << "\"";
         first = false;
     }
     out << (first ? "" : ",") << "position=" << scanner.getPosition();
@@ -4,6 +4,11 @@
  * This file exports a <code>TokenScanner</code> class that divides
  * a string into individual logical units called <b><i>tokens</i></b>.
  *
+ * @version 2026/10/19
+ * - string input is scanned in place rather than through an istringstream
+ * - added buffer mode: setInputBuffer, scanToken, and tokenize return
+ *   string_view tokens with their positions
+ * - operators are matched with a compiled transition table
  * @version 2018/09/25
  * - added doc comments for new documentation generation
  * @version 2018/09/23
@@ -21,8 +26,11 @@
 #ifndef _tokenscanner_h
 #define _tokenscanner_h
 
+#include <deque>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**
  * This class divides a string into individual tokens.  The typical
@@ -41,6 +49,20 @@
  * The <code>TokenScanner</code> class exports several additional methods
  * that give clients more control over its behavior.  Those methods are
  * described individually in the documentation.
+ *
+ * A scanner whose input is a string works directly on the characters of
+ * the string.  Its <code>scanToken</code> and <code>tokenize</code> methods
+ * return each token as a <code>Token</code> whose text is a view into the
+ * input, which avoids copying each token into a new string:
+ *
+ *<pre>
+ *    TokenScanner scanner;
+ *    scanner.setInputBuffer(text);     // text must outlive the tokens
+ *    scanner.ignoreWhitespace();
+ *    for (const TokenScanner::Token& token : scanner.tokenize()) {
+ *       ... token.text, token.line, token.column ...
+ *    }
+ *</pre>
  */
 class TokenScanner {
 public:
@@ -50,6 +72,23 @@ public:
      */
     enum TokenType {SEPARATOR, WORD, NUMBER, STRING, OPERATOR};
 
+    /**
+     * A token returned by <code>scanToken</code> or <code>tokenize</code>.
+     * When the scanner reads from a string, <code>text</code> is a view into
+     * the input and the position fields say where the token starts; the
+     * offset and line and column numbers count from 0, 1, and 1.  Tokens
+     * read from a stream or pushed back with <code>saveToken</code> are held
+     * by the scanner instead and have a position of -1.
+     * At the end of the input the text is empty and the type is EOF.
+     */
+    struct Token {
+        std::string_view text;
+        TokenType type;
+        int position;
+        int line;
+        int column;
+    };
+
     /**
      * Initializes a scanner object with an empty token stream.
      */
@@ -121,7 +160,7 @@ public:
      * <code>SEPARATOR</code>, <code>WORD</code>, <code>NUMBER</code>,
      * <code>STRING</code>, or <code>OPERATOR</code>.
      */
-    TokenType getTokenType(const std::string& token) const;
+    TokenType getTokenType(std::string_view token) const;
 
     /**
      * Returns <code>true</code> if there are additional tokens for this
@@ -168,6 +207,14 @@ public:
      */
     std::string nextToken();
 
+    /**
+     * Reads the next token and returns it along with its type and position.
+     * For a scanner that reads from a string, the token's text is a view
+     * into that string; otherwise it remains valid until the next call to
+     * <code>scanToken</code>.  At the end of the input, the text is empty.
+     */
+    Token scanToken();
+
     /**
      * Pushes the specified token back into this scanner's input stream.
      * On the next call to <code>nextToken</code>, the scanner will return
@@ -219,6 +266,24 @@ public:
      */
     void setInput(const std::string& str);
 
+    /**
+     * Sets the token stream for this scanner to the characters in the given
+     * view, such as the contents of a file that was read or mapped into
+     * memory.  Unlike <code>setInput</code>, the characters are not copied,
+     * so they must remain unchanged for as long as the scanner or any of its
+     * tokens is in use.  Any previous token stream is discarded.
+     */
+    void setInputBuffer(std::string_view text);
+
+    /**
+     * Reads all of the remaining tokens and returns them in order.
+     * If the scanner reads from a stream, the rest of the stream is first
+     * read into the scanner, so that the tokens can refer to it; the text of
+     * the tokens remains valid until the input is changed or
+     * <code>tokenize</code> is called again.
+     */
+    std::vector<Token> tokenize();
+
     /**
      * Pushes the character <code>ch</code> back into the scanner stream.
      * The character must match the one that was read.
@@ -241,20 +306,6 @@ public:
     /**********************************************************************/
 
 private:
-    /*
-     * Private type: StringCell
-     * ------------------------
-     * This type is used to construct linked lists of cells, which are used
-     * to represent both the stack of saved tokens and the set of defined
-     * operators.  These types cannot use the Stack and Lexicon classes
-     * directly because tokenscanner.h is an extremely low-level interface,
-     * and doing so would create circular dependencies in the .h files.
-     */
-    struct StringCell {
-        std::string str;
-        StringCell *link;
-    };
-
     enum NumberScannerState {
         INITIAL_STATE,
         BEFORE_DECIMAL_POINT,
@@ -266,20 +317,56 @@ private:
     };
 
     std::string buffer;              /* The original argument string */
-    std::istream* isp;               /* The input stream for tokens  */
-    bool stringInputFlag;            /* Flag indicating string input */
+    std::string_view input;          /* The characters read in buffer mode */
+    size_t pos;                      /* Index of the next character   */
+    std::istream* isp;               /* The input stream, if not a string */
     bool ignoreWhitespaceFlag;       /* Scanner ignores whitespace   */
     bool ignoreCommentsFlag;         /* Scanner ignores comments     */
     bool scanNumbersFlag;            /* Scanner parses numbers       */
     bool scanStringsFlag;            /* Scanner parses strings       */
     std::string wordChars;           /* Additional word characters   */
-    StringCell* savedTokens;         /* Stack of saved tokens        */
-    StringCell* operators;           /* List of multichar operators  */
+    bool wordTable[256];             /* Which characters are in words */
+    std::vector<std::string> savedTokens;  /* Stack of saved tokens  */
+    std::vector<std::string> operators;    /* Multichar operators    */
+
+    /*
+     * The operators are compiled into a deterministic automaton: each
+     * character that appears in an operator has a column number in
+     * operatorColumns (0 for other characters), and operatorTable holds
+     * one row of next states per state, with -1 where no operator
+     * continues.  State 0 is the start state.
+     */
+    int operatorColumns[256];
+    int operatorColumnCount;
+    std::vector<int> operatorTable;
+    std::vector<bool> operatorAccepts;
+    bool operatorsCompiled;
+
+    /* Line tracking: the line number and start of the line holding linePos. */
+    size_t linePos;
+    size_t lineStart;
+    int lineNumber;
+
+    /* The bounds and line of the last token scanned from the buffer. */
+    size_t lastStart;
+    size_t lastEnd;
+    size_t lastLineStart;
+    int lastLineNumber;
+
+    /* Storage for tokens that are not part of the buffer. */
+    std::string currentToken;
+    std::deque<std::string> heldTokens;
 
     /* Private method prototypes */
+    void compileOperators();
     void initScanner();
-    bool isOperator(const std::string& op);
-    bool isOperatorPrefix(const std::string& op);
+    void locate(size_t offset);
+    size_t matchOperator(size_t start);
+    std::string nextStreamToken();
+    void resetInput();
+    Token scanBufferToken();
+    size_t scanBufferNumber(size_t start) const;
+    size_t scanBufferString(size_t start) const;
     std::string scanNumber();
     std::string scanString();
     std::string scanWord();
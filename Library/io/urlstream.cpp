@@ -5,6 +5,8 @@
  * Please see urlstream.h for information about how to use these classes.
  *
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added streaming mode backed by a streambuf over GDownloader::readStream
  * @version 2018/10/02
  * - added close() method for backward compatibility (does nothing)
  * @version 2018/09/18
@@ -24,6 +26,7 @@
 #include "urlstream.h"
 #include <sstream>
 #include <string>
+#include "error.h"
 #include "gdownloader.h"
 
 namespace {
@@ -36,20 +39,68 @@ namespace {
     }
 }
 
+/*
+ * A read-only stream buffer that takes each piece of a streaming download
+ * from the downloader as the previous one is used up.  The pieces are
+ * moved rather than copied, and only the current one is held here.
+ */
+class iurlstream::StreamBuffer : public std::streambuf {
+public:
+    StreamBuffer(GDownloader& downloader)
+            : _downloader(downloader) {
+        // empty
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        if (!_downloader.readStream(_chunk)) {
+            setg(nullptr, nullptr, nullptr);
+            return traits_type::eof();
+        }
+        char* data = &_chunk[0];
+        setg(data, data, data + _chunk.size());
+        return traits_type::to_int_type(*data);
+    }
+
+private:
+    GDownloader& _downloader;
+    std::string _chunk;
+};
+
 iurlstream::iurlstream()
         : _url(""),
-          _httpStatusCode(0) {
+          _httpStatusCode(0),
+          _streaming(false),
+          _bufferSize(GDownloader::DEFAULT_STREAM_BUFFER_SIZE) {
     // empty
 }
 
 iurlstream::iurlstream(const std::string& url)
         : _url(url),
-          _httpStatusCode(0) {
+          _httpStatusCode(0),
+          _streaming(false),
+          _bufferSize(GDownloader::DEFAULT_STREAM_BUFFER_SIZE) {
     open(url);
 }
 
+iurlstream::~iurlstream() {
+    close();
+}
+
 void iurlstream::close() {
-    // empty
+    if (_downloader) {
+        if (eof() && _downloader->hasError()) {
+            _errorMessage = _downloader->getErrorMessage();
+        }
+        // go back to reading from the stringstream's own buffer
+        std::ios::rdbuf(std::stringstream::rdbuf());
+        setstate(std::ios::eofbit);
+        _streamBuffer.reset();
+        _downloader.reset();
+    }
 }
 
 int iurlstream::getErrorCode() const {
@@ -57,6 +108,9 @@ int iurlstream::getErrorCode() const {
 }
 
 std::string iurlstream::getErrorMessage() const {
+    if (_downloader && eof() && _downloader->hasError()) {
+        return _downloader->getErrorMessage();
+    }
     return _errorMessage;
 }
 
@@ -81,31 +135,58 @@ std::string iurlstream::getUserAgent() const {
     }
 }
 
+bool iurlstream::isStreaming() const {
+    return _streaming;
+}
+
+/*
+ * Implementation notes: open
+ * --------------------------
+ * Both modes read the download as it arrives.  The default mode copies each
+ * piece into the stringstream and so holds the data only once; streaming
+ * mode swaps in a StreamBuffer that hands the pieces straight to the reader.
+ */
 void iurlstream::open(const std::string& url) {
+    close();
     if (!url.empty()) {
         _url = url;
     }
     _errorMessage = "";
+    str("");
     
     // GDownloader does the heavy lifting of downloading the file for us
-    GDownloader downloader;
+    std::unique_ptr<GDownloader> downloader(new GDownloader());
 
     // insert/send headers if needed
     if (!_headers.isEmpty()) {
         for (std::string headerName : _headers) {
-            downloader.setHeader(headerName, _headers[headerName]);
+            downloader->setHeader(headerName, _headers[headerName]);
         }
     }
-    std::string urlData = downloader.downloadAsString(_url);
-    _httpStatusCode = downloader.getHttpStatusCode();
+    downloader->openStream(_url, _bufferSize);
+    _httpStatusCode = downloader->getHttpStatusCode();
 
-    if (downloader.hasError()) {
+    if (downloader->hasError()) {
         setstate(std::ios::failbit);
-        _errorMessage = downloader.getErrorMessage();
+        _errorMessage = downloader->getErrorMessage();
+        return;
+    }
+    clear();
+    if (_streaming) {
+        _downloader = std::move(downloader);
+        _streamBuffer.reset(new StreamBuffer(*_downloader));
+        std::ios::rdbuf(_streamBuffer.get());
     } else {
-        clear();
-        this->write(urlData.c_str(), static_cast<std::streamsize>(urlData.length()));
-        this->seekg(0);
+        std::string chunk;
+        while (downloader->readStream(chunk)) {
+            this->write(chunk.data(), static_cast<std::streamsize>(chunk.length()));
+        }
+        if (downloader->hasError()) {
+            setstate(std::ios::failbit);
+            _errorMessage = downloader->getErrorMessage();
+        } else {
+            this->seekg(0);
+        }
     }
 }
 
@@ -113,6 +194,14 @@ void iurlstream::setHeader(const std::string& name, const std::string& value) {
     _headers[name] = value;
 }
 
+void iurlstream::setStreaming(bool streaming, int bufferSize) {
+    if (bufferSize <= 0) {
+        error("iurlstream::setStreaming: buffer size must be positive");
+    }
+    _streaming = streaming;
+    _bufferSize = bufferSize;
+}
+
 void iurlstream::setUserAgent(const std::string& userAgent) {
     setHeader("User-Agent", userAgent);
 }
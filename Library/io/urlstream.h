@@ -8,6 +8,11 @@
  * exposes that memory buffer for reading.
  * 
  * @author Marty Stepp
+ * @version 2026/10/19
+ * - added streaming mode (setStreaming), in which data can be read as it
+ *   arrives and only a bounded amount is held in memory
+ * - in the default mode, the data is copied into the stream as it arrives
+ *   rather than after the whole download has been buffered
  * @version 2018/10/02
  * - added close() method for backward compatibility (does nothing)
  * @version 2018/09/18
@@ -26,16 +31,33 @@
 #ifndef _urlstream_h
 #define _urlstream_h
 
+#include <memory>
 #include <sstream>
 #include <string>
 
 #include "map.h"
 
+class GDownloader;
+
 /**
  * An <code>iurlstream</code> is an input stream for reading data from URLs.
  * It is implemented as a thin wrapper around a standard C++ stringstream.
  * The data from the given URL is downloaded into a memory buffer, from which
  * you can read it as you would any other input stream.
+ *
+ * For large downloads, call <code>setStreaming(true)</code> before
+ * <code>open</code>.  The stream then reads the data as it arrives instead
+ * of waiting for all of it, and holds only a bounded amount in memory:
+ *
+ *<pre>
+ *    iurlstream stream;
+ *    stream.setStreaming(true);
+ *    stream.open(url);
+ *    string line;
+ *    while (getline(stream, line)) {
+ *        ...
+ *    }
+ *</pre>
  */
 class iurlstream : public std::stringstream {
 public:
@@ -52,9 +74,15 @@ public:
      */
     iurlstream(const std::string& url);
 
+    /**
+     * Stops any download that is still in progress.
+     */
+    virtual ~iurlstream();
+
     /**
      * Closes the stream.
-     * This function actually does nothing and is left in only for legacy
+     * In streaming mode, this stops the download if it has not finished.
+     * Otherwise this function does nothing and is left in only for legacy
      * compatibility purposes.  You do not need to call it.
      */
     void close();
@@ -68,6 +96,8 @@ public:
     /**
      * Returns a message about the most recent error, if any.
      * Returns "" if no errors have occurred.
+     * In streaming mode, an error partway through the download is reported
+     * once the stream has been read to its end.
      */
     std::string getErrorMessage() const;
 
@@ -96,9 +126,16 @@ public:
      */
     std::string getUserAgent() const;
 
+    /**
+     * Returns <code>true</code> if the stream is in streaming mode.
+     */
+    bool isStreaming() const;
+
     /**
      * Opens the given URL for reading.
      * If no URL is passed, uses the URL passed to the constructor.
+     * In streaming mode, this returns once the server has responded,
+     * without waiting for the data.
      */
     void open(const std::string& url = "");
 
@@ -111,6 +148,17 @@ public:
      */
     void setHeader(const std::string& name, const std::string& value);
 
+    /**
+     * Turns streaming mode on or off for the next call to open().
+     * In streaming mode, data can be read as soon as it arrives, and the
+     * memory used is a small multiple of <code>bufferSize</code> however
+     * large the download is; the download pauses while the buffer is full,
+     * so the reader sets the pace.
+     * A streaming stream can only be read forward: it cannot be rewound
+     * with <code>seekg</code>.
+     */
+    void setStreaming(bool streaming, int bufferSize = 1024 * 1024);
+
     /**
      * Sets the value of the HTTP "User-Agent" header for this URL request.
      * Must be called before open(), and the stream must have been created
@@ -122,10 +170,16 @@ public:
     void setUserAgent(const std::string& userAgent);
 
 private:
+    class StreamBuffer;                       // reads from a streaming download
+
     std::string _url;                         // URL to be opened
     int _httpStatusCode;                      // most recent HTTP error seen, if any (initially 0)
     Map<std::string, std::string> _headers;   // HTTP headers to send (name => value)
     std::string _errorMessage;                // error message of what went wrong, if anything
+    bool _streaming;                          // whether open() streams the data
+    int _bufferSize;                          // bytes held in memory when streaming
+    std::unique_ptr<GDownloader> _downloader;     // the open streaming download, if any
+    std::unique_ptr<std::streambuf> _streamBuffer;
 };
 
 /**
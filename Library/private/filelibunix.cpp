@@ -4,6 +4,8 @@
  * This file contains Unix implementations of filelib.h primitives.
  * This code used to live in platform.cpp before the Java back-end was retired.
  *
+ * @version 2026/10/19
+ * - added fileSize, mapFile, readDirectory, and unmapFile
  * @version 2018/10/23
  * - added getAbsolutePath
  */
@@ -14,10 +16,12 @@
 // (see filelibwindows.cpp for Windows versions)
 #ifndef _WIN32
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/resource.h>
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <pwd.h>
 #include <stdint.h>
 #include <unistd.h>
@@ -94,6 +98,14 @@ bool filelib_fileExists(const std::string& filename) {
     return stat(filename.c_str(), &fileInfo) == 0;
 }
 
+int64_t filelib_fileSize(const std::string& filename) {
+    struct stat fileInfo;
+    if (stat(filename.c_str(), &fileInfo) != 0) {
+        return -1;
+    }
+    return static_cast<int64_t>(fileInfo.st_size);
+}
+
 std::string filelib_getAbsolutePath(const std::string& path) {
     char realpathOut[4096];
     realpath(path.c_str(), realpathOut);
@@ -168,6 +180,76 @@ void filelib_listDirectory(const std::string& path, Vector<std::string>& list) {
     sort(list.begin(), list.end());
 }
 
+/*
+ * An empty file cannot be mapped, so it is reported as mapped with no data.
+ * The descriptor can be closed as soon as the mapping exists.
+ */
+bool filelib_mapFile(const std::string& filename, const char*& data, size_t& size, void*& handle) {
+    data = nullptr;
+    size = 0;
+    handle = nullptr;
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || !S_ISREG(fileInfo.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    if (fileInfo.st_size > 0) {
+        void* mapping = mmap(nullptr, static_cast<size_t>(fileInfo.st_size),
+                             PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        madvise(mapping, static_cast<size_t>(fileInfo.st_size), MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+        size = static_cast<size_t>(fileInfo.st_size);
+    }
+    ::close(fd);
+    return true;
+}
+
+/*
+ * The entry types come from d_type, which most file systems fill in, so
+ * lstat is only needed for file systems that report DT_UNKNOWN.
+ */
+bool filelib_readDirectory(const std::string& path,
+                           const std::function<bool (DirectoryEntry& entry)>& visit) {
+    DIR* dir = opendir(path.empty() ? "." : path.c_str());
+    if (!dir) {
+        return false;
+    }
+    DirectoryEntry entry;
+    while (struct dirent* ep = readdir(dir)) {
+        const char* name = ep->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        entry.name = name;
+        unsigned char type = ep->d_type;
+        if (type == DT_UNKNOWN) {
+            struct stat fileInfo;
+            std::string child = path + (endsWith(path, "/") ? "" : "/") + entry.name;
+            if (lstat(child.c_str(), &fileInfo) == 0) {
+                type = S_ISDIR(fileInfo.st_mode) ? DT_DIR
+                     : S_ISREG(fileInfo.st_mode) ? DT_REG
+                     : S_ISLNK(fileInfo.st_mode) ? DT_LNK : DT_UNKNOWN;
+            }
+        }
+        entry.isDirectory = type == DT_DIR;
+        entry.isFile = type == DT_REG;
+        entry.isSymbolicLink = type == DT_LNK;
+        if (!visit(entry)) {
+            break;
+        }
+    }
+    closedir(dir);
+    return true;
+}
+
 void filelib_setCurrentDirectory(const std::string& path) {
     if (chdir(path.c_str()) != 0) {
         std::string msg = "setCurrentDirectory: ";
@@ -176,6 +258,12 @@ void filelib_setCurrentDirectory(const std::string& path) {
     }
 }
 
+void filelib_unmapFile(const char* data, size_t size, void* /*handle*/) {
+    if (data) {
+        munmap(const_cast<char*>(data), size);
+    }
+}
+
 } // namespace platform
 
 #endif // _WIN32
@@ -4,6 +4,8 @@
  * This file contains Windows implementations of filelib.h primitives.
  * This code used to live in platform.cpp before the Java back-end was retired.
  *
+ * @version 2026/10/19
+ * - added fileSize, mapFile, readDirectory, and unmapFile
  * @version 2018/10/23
  * - added getAbsolutePath
  */
@@ -71,6 +73,14 @@ bool filelib_fileExists(const std::string& filename) {
     return GetFileAttributesA(filename.c_str()) != INVALID_FILE_ATTRIBUTES;
 }
 
+int64_t filelib_fileSize(const std::string& filename) {
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &info)) {
+        return -1;
+    }
+    return (static_cast<int64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+}
+
 std::string filelib_getAbsolutePath(const std::string& path) {
     char realpathOut[4096];
     if (_fullpath(realpathOut, path.c_str(), 4095)) {
@@ -137,12 +147,91 @@ void filelib_listDirectory(const std::string& path, Vector<std::string> & list)
     sort(list.begin(), list.end());
 }
 
+/*
+ * The mapping object is kept as the handle and closed by unmapFile; the
+ * file handle can be closed as soon as the mapping object exists.
+ * An empty file cannot be mapped, so it is reported as mapped with no data.
+ */
+bool filelib_mapFile(const std::string& filename, const char*& data, size_t& size, void*& handle) {
+    data = nullptr;
+    size = 0;
+    handle = nullptr;
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (length.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mapping) {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            return false;
+        }
+        data = static_cast<const char*>(view);
+        size = static_cast<size_t>(length.QuadPart);
+        handle = mapping;
+    }
+    CloseHandle(file);
+    return true;
+}
+
+/*
+ * FindExInfoBasic skips the short 8.3 names and FIND_FIRST_EX_LARGE_FETCH
+ * asks for larger batches of entries, both of which speed up big listings.
+ * Reparse points such as symbolic links and junctions are reported as links.
+ */
+bool filelib_readDirectory(const std::string& path,
+                           const std::function<bool (DirectoryEntry& entry)>& visit) {
+    std::string pathStr = path.empty() ? "." : path;
+    std::string pattern = pathStr + "\\*";
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileExA(pattern.c_str(), FindExInfoBasic, &fd,
+                                FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (h == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    DirectoryEntry entry;
+    do {
+        entry.name = fd.cFileName;
+        if (entry.name == "." || entry.name == "..") {
+            continue;
+        }
+        DWORD attr = fd.dwFileAttributes;
+        entry.isSymbolicLink = (attr & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+        entry.isDirectory = !entry.isSymbolicLink && (attr & FILE_ATTRIBUTE_DIRECTORY);
+        entry.isFile = !entry.isSymbolicLink && !(attr & FILE_ATTRIBUTE_DIRECTORY);
+        if (!visit(entry)) {
+            break;
+        }
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+    return true;
+}
+
 void filelib_setCurrentDirectory(const std::string& path) {
     if (!filelib_isDirectory(path) || !SetCurrentDirectoryA(path.c_str())) {
         error("setCurrentDirectory: Can't change to " + path);
     }
 }
 
+void filelib_unmapFile(const char* data, size_t /*size*/, void* handle) {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    if (handle) {
+        CloseHandle(static_cast<HANDLE>(handle));
+    }
+}
+
 } // namespace platform
 
 #endif // _WIN32
@@ -1,4 +1,7 @@
-# stanfordtypes.py   version 2025.5
+# stanfordtypes.py   version 2026.1
+#
+# v 2026.1 adds BitVector, BitQueue, and packed Queue<Bit>;
+#          Set is now stored as a std::set instead of a std::map
 #
 # v 2025.5 monkey patch thread select during step
 #
@@ -36,11 +39,11 @@ def add_map_elem(d, i, key, value):
     putPairItem(d, i, key, value, 'key', 'value', compact=True)
 
 
-def add_set_elem(d, i, key, value):
+def add_set_elem(d, i, key, value=None):
     """Adds an element of a set to the debugger display."""
 
-    # Our Sets stored as map of key,val pairs where val is always true
-    # ignore this value and don't display
+    # HashSets are stored as map of key,val pairs where val is always true
+    # ignore this value and don't display; Sets have no value at all
     d.putSubItem('-', key)
 
 
@@ -145,23 +148,23 @@ def putPairItem(d, i, val1, val2, name1, name2, compact):
 def qdump__Set(d, value):
     """Display Stanford Set on debugger."""
 
-    # Grab the internal data from Set > MapType > std::map
+    # Grab the internal data from Set > SortedKeySet > std::set
     value = value['_map']['_elements']
-    map_helper(d, value, elem_fn=add_set_elem)
+    set_helper(d, value, elem_fn=add_set_elem)
 
 
 def qdump__stanfordcpplib__collections__GenericSet(d, value):
     """Display Stanford Set or HashSet when dumped as GenericSet (Windows)."""
 
-    # Grab the internal data from the Set > MapType > std::map
-    # or std::unordered_map for HashSets
+    # Grab the internal data from the Set > SortedKeySet > std::set
+    # or HashSet > HashMap > std::unordered_map
 
     value = value['_map']['_elements']
     if "unordered" in value.type.name:
         unordered_map_helper(d, value, elem_fn=add_set_elem)
         cls = "HashSet"
     else:
-        map_helper(d, value, elem_fn=add_set_elem)
+        set_helper(d, value, elem_fn=add_set_elem)
         cls = "Set"
 
     inner_type = value.type[0].name
@@ -179,6 +182,11 @@ def qdump__Stack(d, value):
 def qdump__Queue(d, value):
     """Display Stanford Queue on debugger."""
 
+    # Queue<Bit> is packed into a BitQueue, see PackedBitQueue in bitqueue.h
+    if '_bits' in value:
+        bits_helper(d, value['_bits'])
+        return
+
     # Grab the internal data from Queue > Deque > std::deque
     value = value['_elements']['_elements']
     deque_helper(d, value, elem_fn=add_queue_elem)
@@ -264,6 +272,18 @@ def qdump__HashSet(d, value):
     unordered_map_helper(d, value, elem_fn=add_set_elem)
 
 
+def qdump__BitQueue(d, value):
+    """Display Stanford BitQueue on debugger."""
+    bits_helper(d, value)
+
+
+def qdump__BitVector(d, value):
+    """Display Stanford BitVector on debugger."""
+    words = vector_start(value['_words'])
+    size = value['_size'].integer()
+    bits_str_helper(d, words, 0, size)
+
+
 def qdump__Bit(d, value):
     """Display Huffman Bit on debugger."""
     bit = value['_value'].integer()
@@ -287,6 +307,41 @@ def vector_or_deque_helper(d, value, elem_fn):
         vector_helper(d, value, elem_fn)
 
 
+def vector_start(value):
+    """Returns the address of the first element of a std::vector."""
+    if is_lib_cpp(value):
+        return value["__begin_"].pointer()
+    return value["_M_start"].pointer()
+
+
+def bits_helper(d, value):
+    """Dumps a BitQueue, whose bits are _head to _tail of its words."""
+    words = vector_start(value['_words'])
+    head = value['_head'].integer()
+    tail = value['_tail'].integer()
+    bits_str_helper(d, words, head, tail - head)
+
+
+def bits_str_helper(d, words, first, size):
+    """Shows size packed bits, starting at bit first of the words, as a
+       string of 0s and 1s, the same way a Vector<Bit> of them would read."""
+
+    d.check(0 <= size and size <= 1000 * 1000 * 1000)
+    shown = min(size, 1000)
+    chars = []
+    word_index = -1
+    word = 0
+    for i in range(first, first + shown):
+        if i // 64 != word_index:
+            word_index = i // 64
+            word = d.extractUInt64(words + 8 * word_index)
+        chars.append('1' if (word >> (i % 64)) & 1 else '0')
+    if shown < size:
+        chars.append('...')
+    d.putValue(''.join(chars) + f"  ({size} bits)")
+    d.putNumChild(0)
+
+
 def vector_helper(d, value, elem_fn):
     """Dumps the internal vector for Vector, Stack, PriorityQueue, and Grid.
        Adapted from qdumpHelper__std__vector__libstdcxx,  qdumpHelper__std__vector__libcxx"""
@@ -615,6 +670,88 @@ def map_helper_libstd(d, value, elem_fn):
                         if node["_M_left"].pointer() == 0:
                             break
                         node = node["_M_left"]
+
+
+def set_helper(d, value, elem_fn):
+    """Wrapper for dumping sets."""
+
+    if is_lib_cpp(value):
+        set_helper_libcpp(d, value, elem_fn)
+    else:
+        set_helper_libstd(d, value, elem_fn)
+
+
+def set_helper_libcpp(d, value, elem_fn):
+    """Dumps the internal std::set for Set for libc++.
+       Same tree as map_helper_libcpp, but a node holds only a key."""
+
+    try:
+        (proxy, head, size) = value.split("ppp")
+        d.check(0 <= size and size <= 100 * 1000 * 1000)
+
+    # Sometimes there is extra data at the front. Don't know why at the moment.
+    except RuntimeError:
+        (junk, proxy, head, size) = value.split("pppp")
+        d.check(0 <= size and size <= 100 * 1000 * 1000)
+
+    d.putItemCount(size)
+
+    if d.isExpanded():
+        # type[1] is the comparator, not a value type as it is for std::map
+        keyType = value.type[0]
+        keyAlign = my_type_alignment(d, keyType.typeid)
+        node_fmt = "pppB%d@{%s}" % (keyAlign, keyType.name)
+        # [left][right][parent][bool_is_black][pad][key(aligned)]
+
+        def in_order_traversal(node):
+            (left,right,_,_,_,k) = d.split(node_fmt, node)
+            if left:
+                for res in in_order_traversal(left):
+                    yield res
+            yield k
+            if right:
+                for res in in_order_traversal(right):
+                    yield res
+        with Children(d, size, maxNumChild=1000):
+            for (i, key) in zip(d.childRange(), in_order_traversal(head)):
+                elem_fn(d, i, key)
+
+
+def set_helper_libstd(d, value, elem_fn):
+    """Dumps the internal std::set for Set for libstdc++.
+       Same tree walk as map_helper_libstd, but a node holds only a key."""
+
+    # the comparator is a std::function, so unlike map_helper_libstd we
+    # can't split the header off as pointers; go by member names instead
+    size = value["_M_t"]["_M_impl"]["_M_node_count"].integer()
+    d.check(0 <= size and size <= 100 * 1000 * 1000)
+    d.putItemCount(size)
+
+    if d.isExpanded():
+        keyType = value.type[0]
+        with Children(d, size, maxNumChild=1000):
+            node = value["_M_t"]["_M_impl"]["_M_header"]["_M_left"]
+            nodeSize = node.dereference().type.size()
+            typeCode = "@{%s}" % keyType.name
+            for i in d.childRange():
+                (pad, key) = d.split(typeCode, node.pointer() + nodeSize)
+                elem_fn(d, i, key)
+                if node["_M_right"].pointer() == 0:
+                    parent = node["_M_parent"]
+                    while True:
+                        if node.pointer() != parent["_M_right"].pointer():
+                            break
+                        node = parent
+                        parent = parent["_M_parent"]
+                    if node["_M_right"] != parent:
+                        node = parent
+                else:
+                    node = node["_M_right"]
+                    while True:
+                        if node["_M_left"].pointer() == 0:
+                            break
+                        node = node["_M_left"]
+
 def is_lib_cpp(value):
     """Returns whether the class is from libc++."""
     return value.type.name.startswith('std::__1')
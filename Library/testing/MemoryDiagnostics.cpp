@@ -4,33 +4,122 @@
  * @author Keith Schwarz
  * @version 2020/3/5
  *    Keith final revision from end of quarter 19-2
+ * @version 2026/10/19
+ *    per-type slots instead of type_index hash lookups, lock-free atomic and
+ *    per-thread counters, byte counts, peaks, and call site sampling
  */
 
 #include "MemoryDiagnostics.h"
 #include "error.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
 #include <sstream>
 #include <unordered_map>
 #include <typeindex>
+#include <utility>
+#include <vector>
 #include <cxxabi.h> // Nonstandard, but supported on g++ and clang.
 using namespace std;
 
 namespace {
-    /* Type --> Frequency */
-    unordered_map<type_index, int>& allocationTable() {
-        static unordered_map<type_index, int> instance;
-        return instance;
+    /* Counters for one tracked type. All threads update them with relaxed atomic
+     * operations; nothing orders one type's counters against another's. Each type
+     * has a cache line of its own, so threads allocating different types do not
+     * contend.
+     */
+    struct alignas(64) SlotCounters {
+        atomic<long long> allocations {0};
+        atomic<long long> deallocations {0};
+        atomic<long long> liveCount {0};
+        atomic<long long> liveBytes {0};
+        atomic<long long> peakCount {0};
+        atomic<long long> peakBytes {0};
+    };
+
+    /* Slot --> Counters. The counters are allocated a chunk at a time as types are
+     * registered and are never moved or freed, so recording an allocation can find
+     * its counters without taking a lock.
+     */
+    const int SLOTS_PER_CHUNK = 64;
+    const int MAX_CHUNKS = 256;
+    atomic<SlotCounters*> counterChunks[MAX_CHUNKS];
+
+    SlotCounters& countersFor(int slot) {
+        return counterChunks[slot / SLOTS_PER_CHUNK].load(memory_order_acquire)[slot % SLOTS_PER_CHUNK];
     }
 
-    /* Name --> Type */
-    unordered_map<string, type_index>& lookupTable() {
-        static unordered_map<string, type_index> instance;
+    /* Slot --> Name, Type --> Slot, and sampled (slot, site) --> frequency. Written
+     * when a type is first registered and for each sampled allocation, both rare,
+     * so a plain mutex is fine. Readers take the names and sites under the same
+     * lock, so they always see a name for every slot they find.
+     */
+    struct Registry {
+        mutex lock;
+        vector<string> names;
+        unordered_map<type_index, int> slots;
+        map<pair<int, void*>, int> sites;
+    };
+
+    Registry& registry() {
+        static Registry instance;
         return instance;
     }
+
+    atomic<int> siteSampling(0);
+
+    /* Slot --> live objects allocated minus freed by one thread. Only the owning
+     * thread touches it. Tracked objects may still be freed while the thread is
+     * being torn down, after the counts are gone, so the flag is checked first.
+     */
+    struct ThreadCounts {
+        vector<long long> live;
+        ~ThreadCounts();
+    };
+
+    thread_local bool threadCountsDestroyed = false;
+    thread_local ThreadCounts threadCounts;
+
+    ThreadCounts::~ThreadCounts() {
+        threadCountsDestroyed = true;
+    }
+
+    void addThreadLive(int slot, long long delta) {
+        if (threadCountsDestroyed) return;
+        vector<long long>& live = threadCounts.live;
+        if (slot >= int(live.size())) {
+            live.resize(slot + 1);
+        }
+        live[slot] += delta;
+    }
+
+    /* Raises peak to at least value. */
+    void raiseTo(atomic<long long>& peak, long long value) {
+        long long seen = peak.load(memory_order_relaxed);
+        while (seen < value && !peak.compare_exchange_weak(seen, value, memory_order_relaxed)) {
+            // seen now holds the current peak; try again
+        }
+    }
 }
 
 namespace MemoryDiagnostics {
     /* Injects the type into the appropriate table. */
-    int registerSentinel(const std::type_info& type) {
+    int registerSentinel(const std::type_info& type, std::size_t) {
+        lock_guard<mutex> guard(registry().lock);
+        auto found = registry().slots.find(type_index(type));
+        if (found != registry().slots.end()) {
+            return found->second;
+        }
+
+        int slot = int(registry().names.size());
+        if (slot >= SLOTS_PER_CHUNK * MAX_CHUNKS) {
+            error("Internal error: Too many types tracked by MemoryDiagnostics");
+        }
+        if (slot % SLOTS_PER_CHUNK == 0) {
+            counterChunks[slot / SLOTS_PER_CHUNK].store(new SlotCounters[SLOTS_PER_CHUNK], memory_order_release);
+        }
+
         /* std::type_info does not guarantee that .name() will be at all human-readable.
          * Use this g++/clang-specific logic to "demangle" the name back into a human-readable
          * format.
@@ -39,40 +128,122 @@ namespace MemoryDiagnostics {
         auto* realName = abi::__cxa_demangle(type.name(), nullptr, nullptr, &statusCode);
         if (statusCode != 0) error("Internal error: Couldn't demangle name?");
 
-        /* C++ type_info objects don't work well as keys in maps, but std::type_index
-         * allows us to fix that.
-         */
-        lookupTable().insert(make_pair(string(realName), type_index(type)));
+        registry().names.push_back(string(realName));
+        registry().slots.insert(make_pair(type_index(type), slot));
 
         free(realName);
-        return 137; // You know, cause, why not?
+        return slot;
     }
 
-    void recordNew(const type_info& type) {
-        allocationTable()[type_index(type)]++;
+    void recordNew(int slot, size_t bytes, void* site) {
+        SlotCounters& counters = countersFor(slot);
+        long long allocations = counters.allocations.fetch_add(1, memory_order_relaxed) + 1;
+        raiseTo(counters.peakCount, counters.liveCount.fetch_add(1, memory_order_relaxed) + 1);
+        raiseTo(counters.peakBytes, counters.liveBytes.fetch_add((long long) bytes, memory_order_relaxed)
+                                    + (long long) bytes);
+        addThreadLive(slot, 1);
+
+        int everyN = siteSampling.load(memory_order_relaxed);
+        if (everyN > 0 && allocations % everyN == 0) {
+            lock_guard<mutex> guard(registry().lock);
+            registry().sites[make_pair(slot, site)]++;
+        }
     }
 
-    void recordDelete(const type_info& type) {
-        allocationTable()[type_index(type)]--;
+    void recordDelete(int slot, size_t bytes) {
+        SlotCounters& counters = countersFor(slot);
+        counters.deallocations.fetch_add(1, memory_order_relaxed);
+        counters.liveCount.fetch_sub(1, memory_order_relaxed);
+        counters.liveBytes.fetch_sub((long long) bytes, memory_order_relaxed);
+        addThreadLive(slot, -1);
     }
 
     /* Clears the allocation table. */
     void clear() {
-        allocationTable().clear();
+        lock_guard<mutex> guard(registry().lock);
+        for (int slot = 0; slot < int(registry().names.size()); slot++) {
+            SlotCounters& counters = countersFor(slot);
+            counters.allocations = 0;
+            counters.deallocations = 0;
+            counters.liveCount = 0;
+            counters.liveBytes = 0;
+            counters.peakCount = 0;
+            counters.peakBytes = 0;
+        }
+        registry().sites.clear();
     }
 
     /* Returns a list of all imbalanced types. */
     map<string, int> typesWithErrors() {
         map<string, int> result;
+        lock_guard<mutex> guard(registry().lock);
+        const vector<string>& names = registry().names;
 
         /* Loop over types, looking for mismatches. */
-        for (const auto& entry: lookupTable()) {
-            int record = allocationTable()[entry.second];
-            if (record != 0) {
-                result[entry.first] = record;
+        for (int slot = 0; slot < int(names.size()); slot++) {
+            long long live = countersFor(slot).liveCount.load(memory_order_relaxed);
+            if (live != 0) {
+                result[names[slot]] = int(live);
             }
         }
 
         return result;
     }
+
+    void clearThreadCounts() {
+        if (!threadCountsDestroyed) {
+            threadCounts.live.clear();
+        }
+    }
+
+    map<string, int> threadTypesWithErrors() {
+        map<string, int> result;
+        if (threadCountsDestroyed) return result;
+        const vector<long long>& live = threadCounts.live;
+        lock_guard<mutex> guard(registry().lock);
+        const vector<string>& names = registry().names;
+        for (int slot = 0; slot < int(min(names.size(), live.size())); slot++) {
+            if (live[slot] != 0) {
+                result[names[slot]] = int(live[slot]);
+            }
+        }
+        return result;
+    }
+
+    map<string, AllocationStats> allocationStats() {
+        map<string, AllocationStats> result;
+        lock_guard<mutex> guard(registry().lock);
+        const vector<string>& names = registry().names;
+        for (int slot = 0; slot < int(names.size()); slot++) {
+            SlotCounters& counters = countersFor(slot);
+            AllocationStats stats;
+            stats.allocations = counters.allocations.load(memory_order_relaxed);
+            stats.deallocations = counters.deallocations.load(memory_order_relaxed);
+            stats.liveCount = counters.liveCount.load(memory_order_relaxed);
+            stats.liveBytes = counters.liveBytes.load(memory_order_relaxed);
+            stats.peakCount = counters.peakCount.load(memory_order_relaxed);
+            stats.peakBytes = counters.peakBytes.load(memory_order_relaxed);
+            if (stats.allocations != 0 || stats.deallocations != 0) {
+                result[names[slot]] = stats;
+            }
+        }
+        return result;
+    }
+
+    void setSiteSampling(int everyN) {
+        siteSampling = max(0, everyN);
+    }
+
+    map<string, int> sampledSites(const string& typeName) {
+        map<string, int> result;
+        lock_guard<mutex> guard(registry().lock);
+        for (const auto& entry: registry().sites) {
+            if (registry().names[entry.first.first] == typeName) {
+                ostringstream out;
+                out << entry.first.second;
+                result[out.str()] += entry.second;
+            }
+        }
+        return result;
+    }
 }
@@ -42,30 +42,47 @@
 
 
 
+#include <atomic>
 #include <typeinfo>
 #include <cstddef>
-#include <typeindex>
-#include <unordered_map>
 #include <string>
 #include <map>
-#include <vector>
 
 /* Helper functions for memory diagnostics. You are not expected to use any of these
  * functions in your code.
  */
 namespace MemoryDiagnostics {
-    void recordNew(const std::type_info& type);
-    void recordDelete(const std::type_info& type);
+    /* Each tracked type is assigned a small integer slot the first time one of its
+     * objects is allocated. The slot indexes directly into the counter table, so
+     * recording an allocation needs no type lookup. The counters are atomics shared
+     * by all threads, so recording takes no lock, and an object freed on a different
+     * thread than the one that allocated it is still balanced. Each thread also
+     * keeps its own count of live objects, for checking tests that run at once.
+     */
+    void recordNew(int slot, std::size_t bytes, void* site);
+    void recordDelete(int slot, std::size_t bytes);
+
+    /* Installs the specified type into the main type tables and returns its slot.
+     * Registering the same type again returns the same slot.
+     */
+    int registerSentinel(const std::type_info& type, std::size_t size);
 
     template <typename T> struct MemorySentinel {
-        static int initializer;
+        /* Slot number plus one, zero until registered. Constant-initialized so it
+         * is safe to use during static initialization.
+         */
+        static std::atomic<int> slotPlusOne;
+
+        static int slot() {
+            int s = slotPlusOne.load(std::memory_order_acquire);
+            if (s == 0) {
+                s = registerSentinel(typeid(T), sizeof(T)) + 1;
+                slotPlusOne.store(s, std::memory_order_release);
+            }
+            return s - 1;
+        }
     };
 
-    /* Installs the specified type into the main type tables. Returns an integer value
-     * that is completely of no consequence.
-     */
-    int registerSentinel(const std::type_info& type);
-
     /* Hook to allocate and deallocate memory. Use this to customize how the memory system
      * allocates and deallocates objects of your type.
      */
@@ -87,51 +104,81 @@ namespace MemoryDiagnostics {
         }
     };
 
-    /* Clears all allocation records, effectively resetting the leak counts. */
+    /* Allocation totals for one type. */
+    struct AllocationStats {
+        long long allocations = 0;      // number of new / new[] calls
+        long long deallocations = 0;    // number of delete / delete[] calls
+        long long liveCount = 0;        // allocations minus deallocations
+        long long liveBytes = 0;
+        long long peakCount = 0;        // largest liveCount seen since clear()
+        long long peakBytes = 0;
+    };
+
+    /* Clears all allocation records, effectively resetting the leak counts. Call this
+     * only while no other thread is allocating tracked objects.
+     */
     void clear();
 
     /* Returns a map of all types that have memory leaks / errors. Keys are type
      * names, values are allocation records.
      */
     std::map<std::string, int> typesWithErrors();
+
+    /* The same as clear() and typesWithErrors(), but for the objects allocated and
+     * freed by the calling thread only. Tests that run at the same time on different
+     * threads use these so that they do not see each other's allocations.
+     */
+    void clearThreadCounts();
+    std::map<std::string, int> threadTypesWithErrors();
+
+    /* Returns allocation totals for every tracked type that has been allocated
+     * since the last clear(). Keys are type names.
+     */
+    std::map<std::string, AllocationStats> allocationStats();
+
+    /* Records the call site of every nth allocation of each tracked type.
+     * Zero (the default) turns sampling off.
+     */
+    void setSiteSampling(int everyN);
+
+    /* Returns the sampled call sites for the named type and how many sampled
+     * allocations came from each. Sites are code addresses written in hex;
+     * a tool such as addr2line maps them back to source lines.
+     */
+    std::map<std::string, int> sampledSites(const std::string& typeName);
 }
 
 template <typename T>
-int MemoryDiagnostics::MemorySentinel<T>::initializer = registerSentinel(typeid(T));
+std::atomic<int> MemoryDiagnostics::MemorySentinel<T>::slotPlusOne(0);
 
 /* Implementation of TRACK_ALLOCATIONS introduces operator new/delete hooks that call
  * into the memory diagnostics system.
  *
+ * Only the sized forms of operator delete are declared so that the compiler passes
+ * the size of the block being freed, which keeps the byte counts exact.
+ *
  * If you were redirected here by hitting F2 or fn+F2, you've been sent to the
  * implementation of TRACK_ALLOCATIONS_OF rather than the definition. Scroll higher
  * up in this file for more information.
  */
 #undef TRACK_ALLOCATIONS_OF
-#define TRACK_ALLOCATIONS_OF(Type)                                           \
-    void* operator new(std::size_t bytes) {                                  \
-        (void) ::MemoryDiagnostics::MemorySentinel<Type>::initializer;       \
-        ::MemoryDiagnostics::recordNew(typeid(Type));                        \
-        return MemoryDiagnostics::Allocator<Type>::scalarAlloc(bytes);       \
-    }                                                                        \
-    void* operator new[](std::size_t bytes) {                                \
-        ::MemoryDiagnostics::recordNew(typeid(Type));                        \
-        return MemoryDiagnostics::Allocator<Type>::vectorAlloc(bytes);       \
-    }                                                                        \
-    void operator delete(void* ptr) {                                        \
-        ::MemoryDiagnostics::recordDelete(typeid(Type));                     \
-        return MemoryDiagnostics::Allocator<Type>::scalarFree(ptr);          \
-    }                                                                        \
-    void operator delete(void* ptr, std::size_t) {                           \
-        ::MemoryDiagnostics::recordDelete(typeid(Type));                     \
-        return MemoryDiagnostics::Allocator<Type>::scalarFree(ptr);          \
-    }                                                                        \
-    void operator delete[](void* ptr) {                                      \
-        ::MemoryDiagnostics::recordDelete(typeid(Type));                     \
-        return MemoryDiagnostics::Allocator<Type>::vectorFree(ptr);          \
-    }                                                                        \
-    void operator delete[](void* ptr, std::size_t) {                         \
-        ::MemoryDiagnostics::recordDelete(typeid(Type));                     \
-        return MemoryDiagnostics::Allocator<Type>::vectorFree(ptr);          \
-    }                                                                        \
+#define TRACK_ALLOCATIONS_OF(Type)                                                        \
+    void* operator new(std::size_t bytes) {                                               \
+        ::MemoryDiagnostics::recordNew(::MemoryDiagnostics::MemorySentinel<Type>::slot(), \
+                                       bytes, __builtin_return_address(0));               \
+        return MemoryDiagnostics::Allocator<Type>::scalarAlloc(bytes);                    \
+    }                                                                                     \
+    void* operator new[](std::size_t bytes) {                                             \
+        ::MemoryDiagnostics::recordNew(::MemoryDiagnostics::MemorySentinel<Type>::slot(), \
+                                       bytes, __builtin_return_address(0));               \
+        return MemoryDiagnostics::Allocator<Type>::vectorAlloc(bytes);                    \
+    }                                                                                     \
+    void operator delete(void* ptr, std::size_t bytes) {                                  \
+        ::MemoryDiagnostics::recordDelete(::MemoryDiagnostics::MemorySentinel<Type>::slot(), bytes); \
+        return MemoryDiagnostics::Allocator<Type>::scalarFree(ptr);                       \
+    }                                                                                     \
+    void operator delete[](void* ptr, std::size_t bytes) {                                \
+        ::MemoryDiagnostics::recordDelete(::MemoryDiagnostics::MemorySentinel<Type>::slot(), bytes); \
+        return MemoryDiagnostics::Allocator<Type>::vectorFree(ptr);                       \
+    }                                                                                     \
     static_assert(true, "Just so we need a semicolon.")
-
@@ -80,6 +80,17 @@
  */
 #define PROVIDED_TEST(name) /* For our use. */
 
+/* Marks all of the tests in this file as needing to run one at a time, never
+ * alongside tests from other files. Use this in a file whose tests change
+ * global state (files, static variables, the console), time operations with
+ * TIME_OPERATION, or free tracked objects on a different thread than the one
+ * that allocated them, when tests are being run in parallel. The syntax is to
+ * write this line once, outside any test case:
+ *
+ *    SERIAL_TEST_GROUP();
+ */
+#define SERIAL_TEST_GROUP() /* Run this file's tests serially. */
+
 
 /* Enumerated type for the different options when running tests. Your options are:
  *     ALL_TESTS (all tests from all files) or
@@ -99,5 +110,27 @@ enum Where { CONSOLE_ONLY, WINDOW_ONLY, CONSOLE_AND_WINDOW };
 bool runSimpleTests(Choice ch, Where where = CONSOLE_AND_WINDOW);
 bool runSimpleTests(std::string groupName, Where where = CONSOLE_AND_WINDOW);
 
+/* Optional settings for how tests are run. Call these before runSimpleTests.
+ *
+ * setTestWorkers(n) runs independent test groups on n threads at once. The default
+ * is 1 (run everything in order on one thread), and 0 means one thread per processor.
+ * Results are reported in the same order no matter how many threads are used.
+ * Tests in groups run in parallel are checked for memory leaks by counting only
+ * the objects that their own thread allocates and frees.
+ *
+ * setTestTimeout(seconds) fails any test that runs longer than the given number of
+ * seconds. The default is 0, meaning no limit. A test that times out cannot be
+ * stopped: it is reported as timed out and the other tests go on, but it keeps
+ * running in the background, so tests run after it may see changes it makes.
+ *
+ * setTestIsolation(true) runs each test in its own process so that a crash affects
+ * only that test. Isolated tests cannot use the graphics window or the console
+ * window, and always have a time limit: the one from setTestTimeout, or 30 seconds
+ * if none is set. Not available on Windows.
+ */
+void setTestWorkers(int n);
+void setTestTimeout(double seconds);
+void setTestIsolation(bool isolate);
+
 
 #include "TestDriver.h" // IWYU pragma: export
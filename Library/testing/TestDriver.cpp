@@ -10,6 +10,7 @@
 #include "TestDriver.h"
 #include "filelib.h"
 #include <map>
+#include <set>
 
 using namespace std;
 
@@ -24,6 +25,12 @@ map<TestKey, multimap<int, TestCase>>& gTestsMap() {
     return result;
 }
 
+/* Names of test groups whose tests must not run alongside other groups. */
+set<TestKey>& gSerialGroups() {
+    static set<TestKey> result;
+    return result;
+}
+
 void reportFailure(const string& message, size_t line) {
     string msg = message;
     if (line != 0) {
@@ -55,3 +62,8 @@ TestCaseAdder::TestCaseAdder(const TestKey& key, int line, const string& testnam
     gTestsMap()[basename].insert(make_pair(line, tcase));
 }
 
+
+/* SerialGroupAdder implementation. */
+SerialGroupAdder::SerialGroupAdder(const TestKey& key) {
+    gSerialGroups().insert(getTail(key));
+}
@@ -42,6 +42,12 @@ public:
     TestCaseAdder(const TestKey& key, int lineNumber, const std::string& name, const std::string &owner, std::function<void()>);
 };
 
+/* Object whose sole purpose is to mark a group of tests as needing to run serially. */
+class SerialGroupAdder {
+public:
+    SerialGroupAdder(const TestKey& key);
+};
+
 /**** Defines the macro that adds a new test case. ****/
 
 /* First, undefine STUDENT_TEST, since we defined it above as a way of "prototyping" it. */
@@ -67,6 +73,11 @@ public:
 
 #define JOIN(X, Y) X##Y
 
+/* As with DO_ADD_TEST, the extra level lets __LINE__ expand before it is pasted. */
+#undef SERIAL_TEST_GROUP
+#define SERIAL_TEST_GROUP() DO_SERIAL_TEST_GROUP(_serialGroup, __LINE__)
+#define DO_SERIAL_TEST_GROUP(adder, line) static SerialGroupAdder JOIN(adder, line)(__FILE__)
+
 /***** Macros used to implement testing primitives. *****/
 void reportFailure(const std::string& message, std::size_t line = 0);
 void addDetail(const std::string& message);
@@ -211,8 +222,9 @@ template <typename T> std::string evaluate(const std::string& orig, const T& ans
     Timer _timer;\
     _timer.start();\
     (void)(expr); \
-    double _elapsed_ms = _timer.stop();\
+    _timer.stop();\
+    double _elapsed_secs = _timer.elapsedNanos() / 1e9;\
     std::ostringstream _out; \
-    _out << "Line " << __LINE__ << " TIME_OPERATION " << #expr << " (size = " << std::setw(8) << n << ")" << " completed in " << std::setw(8) << std::fixed << std::setprecision(3) << (_elapsed_ms/1000) << " secs";\
+    _out << "Line " << __LINE__ << " TIME_OPERATION " << #expr << " (size = " << std::setw(8) << n << ")" << " completed in " << std::setw(8) << std::fixed << std::setprecision(3) << _elapsed_secs << " secs";\
     addDetail(_out.str());\
 } while(0)
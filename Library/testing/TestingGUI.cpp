@@ -6,6 +6,8 @@
  *    Keith final revision from end of quarter 19-2
  * @version 2021 Fall Quarter
  *    Julie edits
+ * @version 2026/10/19
+ *    run test groups on a worker pool, per-test timeouts, process isolation
  */
 #include "console.h"
 #include "error.h"
@@ -13,16 +15,44 @@
 #include "gbrowserpane.h"
 #include "gthread.h"
 #include "gwindow.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iomanip>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 #include "MemoryDiagnostics.h"
 #include <QCoreApplication> // for application name
 #include "simpio.h"
 #include "SimpleTest.h"
 #include "styles_css_h"
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif // _WIN32
 using namespace std;
 
-static Vector<string> gDetails;
+// details are per thread so that tests running concurrently keep separate lists
+static thread_local Vector<string> gDetails;
+
+static int gTestWorkers = 1;
+static double gTestTimeoutSecs = 0;
+static bool gIsolateTests = false;
+
+// time limit for isolated tests when no timeout has been set; see runTestInChildProcess
+static const double ISOLATED_TEST_TIMEOUT_SECS = 30;
+
+// number of timed-out tests still running in the background; see runTestWithTimeout
+static std::atomic<int> gRunawayTests(0);
 
 void addDetail(const string& msg)
 {
@@ -31,6 +61,7 @@ void addDetail(const string& msg)
 
 // hand prototype to avoid having map in exposed header (and leading students astray)
 std::map<TestKey, std::multimap<int, TestCase>>& gTestsMap();
+std::set<TestKey>& gSerialGroups();
 
 namespace SimpleTest {
     /* Type representing how a test turned out. */
@@ -40,13 +71,15 @@ namespace SimpleTest {
         PASS,
         FAIL,
         LEAK,
-        EXCEPTION
+        EXCEPTION,
+        TIMEOUT
     };
 
     /* Type representing a single test and its result. */
     struct Test {
         string testname;
         string id; // string identifying owner, module, line number
+        string filename;
         std::function<void()> callback;
         TestResult result;
         string detailMessage;
@@ -73,7 +106,8 @@ namespace SimpleTest {
         {TestResult::PASS,      {"Correct", "pass", GREEN + BOLD} },
         {TestResult::FAIL,      {"Incorrect", "fail",  RED + BOLD} },
         {TestResult::LEAK,      {"Leak", "leak", YELLOW + BOLD} },
-        {TestResult::EXCEPTION, {"Exception", "exception", RED + BOLD} }
+        {TestResult::EXCEPTION, {"Exception", "exception", RED + BOLD} },
+        {TestResult::TIMEOUT,   {"Timed out", "timeout", RED + BOLD} }
     };
 
     string affirmation()
@@ -98,11 +132,28 @@ namespace SimpleTest {
         return s;
     }
 
-    /* Runs a single test. */
-    void runSingleTest(Test& test) {
+    string indent(const string& message)
+    {
+        string indented;
+        for (auto& line : stringSplit(message, "\n")) {
+            indented += "    " + line + "\n";
+        }
+        return indented;
+    }
+
+    /* Runs a single test. The leak check uses the program-wide allocation counts
+     * when this is the only test running, and otherwise (threadCounts set) only
+     * the objects allocated and freed by this thread, so that tests running at
+     * the same time do not see each other's allocations.
+     */
+    void runSingleTest(Test& test, bool threadCounts) {
         try {
             /* Reset memory counters so we don't have carryover across tests. */
-            MemoryDiagnostics::clear();
+            if (threadCounts) {
+                MemoryDiagnostics::clearThreadCounts();
+            } else {
+                MemoryDiagnostics::clear();
+            }
             gDetails.clear();
 
             /* Run the test. */
@@ -112,7 +163,8 @@ namespace SimpleTest {
             test.detailMessage = stringJoin(gDetails, "\n"); // will be overwritten in case of actual failure
 
             /* See if there were any memory leaks. */
-            auto errors = MemoryDiagnostics::typesWithErrors();
+            auto errors = threadCounts ? MemoryDiagnostics::threadTypesWithErrors()
+                                       : MemoryDiagnostics::typesWithErrors();
             if (errors.empty()) {
                 test.result = TestResult::PASS;
             } else {
@@ -174,11 +226,186 @@ namespace SimpleTest {
             out << " " << endl;
             test.detailMessage = out.str();
         }
-        string indented;
-        for (auto& line : stringSplit(test.detailMessage, "\n")) {
-            indented += "    " + line + "\n";
+        test.detailMessage = indent(test.detailMessage);
+    }
+
+    string timeoutMessage(double limitSecs)
+    {
+        ostringstream out;
+        out << "Test was stopped because it ran longer than the time limit of "
+            << limitSecs << " seconds." << endl;
+        out << " " << endl;
+        out << "This usually means that the code under test is stuck in an" << endl;
+        out << "infinite loop or is waiting for input that never arrives." << endl;
+        return out.str();
+    }
+
+    /* Runs a single test on a helper thread and abandons it if it does not finish
+     * within the time limit. A thread cannot be forcibly stopped, so a runaway test
+     * keeps running in the background; everything it touches is kept alive by the
+     * shared Outcome. Only that test is marked as timed out and the run goes on.
+     * While it is still running it may allocate and free tracked objects, so the
+     * tests after it check for leaks with their own thread's counts.
+     */
+    void runTestWithTimeout(Test& test, bool threadCounts)
+    {
+        struct Outcome {
+            Test test;
+            bool done = false;
+            bool abandoned = false;
+            std::mutex lock;
+            std::condition_variable finished;
+        };
+        auto outcome = std::make_shared<Outcome>();
+        outcome->test = test;
+        std::thread runner([outcome, threadCounts] {
+            Test result = outcome->test;
+            runSingleTest(result, threadCounts);
+            std::lock_guard<std::mutex> guard(outcome->lock);
+            outcome->test = result;
+            outcome->done = true;
+            if (outcome->abandoned) gRunawayTests--;
+            outcome->finished.notify_all();
+        });
+
+        std::unique_lock<std::mutex> lock(outcome->lock);
+        bool done = outcome->finished.wait_for(lock, std::chrono::duration<double>(gTestTimeoutSecs),
+                                               [outcome] { return outcome->done; });
+        if (done) {
+            test = outcome->test;
+            lock.unlock();
+            runner.join();
+        } else {
+            outcome->abandoned = true;
+            gRunawayTests++;
+            lock.unlock();
+            runner.detach();
+            test.result = TestResult::TIMEOUT;
+            test.detailMessage = indent(timeoutMessage(gTestTimeoutSecs)
+                                        + " \nThe test is still running in the background, so tests that"
+                                        + "\nrun after it may see changes that it makes.\n");
+        }
+    }
+
+#ifndef _WIN32
+    /* Runs a single test in a forked child process. The child reports the result
+     * and details back through a pipe. If the child crashes, or is killed for
+     * running past the time limit, the failure is confined to this one test.
+     *
+     * Only the forking thread exists in the child, so anything that waits on the
+     * Qt GUI thread (graphics, the console window) blocks there forever. For that
+     * reason an isolated test always has a time limit, ISOLATED_TEST_TIMEOUT_SECS
+     * if none has been set. The child is the only test running in its process, so
+     * it uses the program-wide leak check; threadCounts applies only if the child
+     * cannot be started and the test runs here instead.
+     */
+    void runTestInChildProcess(Test& test, bool threadCounts)
+    {
+        double limitSecs = gTestTimeoutSecs > 0 ? gTestTimeoutSecs : ISOLATED_TEST_TIMEOUT_SECS;
+        int fds[2];
+        cout.flush();
+        cerr.flush();
+        pid_t pid = -1;
+        if (pipe(fds) == 0) {
+            pid = fork();
+            if (pid < 0) {
+                close(fds[0]);
+                close(fds[1]);
+            }
+        }
+        if (pid < 0) {      // could not start child, run in this process instead
+            runSingleTest(test, threadCounts);
+            return;
+        }
+        if (pid == 0) {     // child
+            close(fds[0]);
+            runSingleTest(test, false);
+            string payload = integerToString(int(test.result)) + "\n" + test.detailMessage;
+            const char* data = payload.c_str();
+            size_t remaining = payload.length();
+            while (remaining > 0) {
+                ssize_t n = write(fds[1], data, remaining);
+                if (n <= 0) break;
+                data += n;
+                remaining -= size_t(n);
+            }
+            close(fds[1]);
+            cout.flush();
+            cerr.flush();
+            _exit(0);
+        }
+
+        close(fds[1]);
+        string payload;
+        bool timedOut = false;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(limitSecs);
+        char buffer[4096];
+        while (true) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            int waitMs = std::max(0, int(remaining.count()));
+            pollfd pfd = { fds[0], POLLIN, 0 };
+            int ready = poll(&pfd, 1, waitMs);
+            if (ready == 0) {
+                kill(pid, SIGKILL);
+                timedOut = true;
+                break;
+            } else if (ready < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            ssize_t n = read(fds[0], buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            payload.append(buffer, size_t(n));
+        }
+        close(fds[0]);
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+
+        size_t newline = payload.find('\n');
+        if (timedOut) {
+            test.result = TestResult::TIMEOUT;
+            test.detailMessage = indent(timeoutMessage(limitSecs)
+                                        + " \nIsolated tests cannot use graphics or the console window,"
+                                        + "\nwhich wait forever in the test process.\n");
+        } else if (newline != string::npos) {
+            test.result = TestResult(stringToInteger(payload.substr(0, newline)));
+            test.detailMessage = payload.substr(newline + 1);
+        } else {
+            test.result = TestResult::EXCEPTION;
+            ostringstream out;
+            out << "Test failed because the test process crashed." << endl;
+            out << " " << endl;
+            if (WIFSIGNALED(status)) {
+                out << "The process was stopped by signal " << WTERMSIG(status)
+                    << " (" << strsignal(WTERMSIG(status)) << ")." << endl;
+            } else if (WIFEXITED(status)) {
+                out << "The process exited with status " << WEXITSTATUS(status)
+                    << " before the test finished." << endl;
+            }
+            test.detailMessage = indent(out.str());
+        }
+    }
+#endif // _WIN32
+
+    /* Runs a single test, applying the isolation and timeout settings. Tests
+     * that run alongside others (parallel set) check for leaks with their own
+     * thread's counts, as do all tests while a timed-out test is still running.
+     */
+    void runTest(Test& test, bool parallel)
+    {
+        bool threadCounts = parallel || gRunawayTests > 0;
+#ifndef _WIN32
+        if (gIsolateTests) {
+            runTestInChildProcess(test, threadCounts);
+            return;
+        }
+#endif // _WIN32
+        if (gTestTimeoutSecs > 0) {
+            runTestWithTimeout(test, threadCounts);
+        } else {
+            runSingleTest(test, threadCounts);
         }
-        test.detailMessage = indented;
     }
 
     /* Displays all the results from the given test group. */
@@ -229,6 +456,7 @@ namespace SimpleTest {
         Test t;
         t.testname = tcase.testname;
         t.callback = tcase.callback;
+        t.filename = tcase.filename;
         ostringstream os;
         if (isfilegroup) {
             os << " (" << tcase.owner << ", line " << setw(3) << tcase.line << ") ";
@@ -254,6 +482,117 @@ namespace SimpleTest {
         return grouped.values();
     }
 
+    bool isSerialGroup(const TestGroup& group)
+    {
+        for (const auto& test: group.tests) {
+            if (gSerialGroups().count(test.filename)) return true;
+        }
+        return false;
+    }
+
+    /* Runs the given groups on a pool of worker threads. Each worker takes the
+     * next unstarted group and runs its tests in order on a private copy, so the
+     * shared group list is only ever modified by the calling thread. The caller
+     * waits for the groups to finish in their original order and hands each one
+     * to the report function, so output order does not depend on timing.
+     */
+    void runGroupsInParallel(Vector<TestGroup>& groups, const Vector<int>& indexes, int workers,
+                             std::function<void(TestGroup&)> report)
+    {
+        int count = indexes.size();
+        std::vector<Vector<Test>> results(count);
+        std::vector<bool> finished(count, false);
+        std::atomic<int> next(0);
+        std::mutex lock;
+        std::condition_variable groupFinished;
+
+        for (int index : indexes) {
+            for (auto& test: groups[index].tests) {
+                test.result = TestResult::RUNNING;
+            }
+        }
+
+        std::vector<std::thread> pool;
+        for (int w = 0; w < std::min(workers, count); w++) {
+            pool.emplace_back([&] {
+                for (int k = next++; k < count; k = next++) {
+                    Vector<Test> tests;
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        tests = groups[indexes[k]].tests;
+                    }
+                    for (auto& test: tests) {
+                        runTest(test, true);
+                    }
+                    std::lock_guard<std::mutex> guard(lock);
+                    results[k] = tests;
+                    finished[k] = true;
+                    groupFinished.notify_all();
+                }
+            });
+        }
+
+        for (int k = 0; k < count; k++) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                groupFinished.wait(guard, [&] { return bool(finished[k]); });
+                groups[indexes[k]].tests = results[k];
+            }
+            report(groups[indexes[k]]);
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+
+    /* Runs the selected groups. Serial groups (and all groups, when there is only
+     * one worker) run here one test at a time; each maximal run of parallel
+     * groups is handed to the worker pool. Progress is reported in group order,
+     * whichever thread ran the tests: startGroup before each group, startTest and
+     * endTest around each test, and changed whenever results have changed.
+     */
+    void runGroups(Vector<TestGroup>& groups,
+                   std::function<void(const TestGroup&)> startGroup,
+                   std::function<void(const Test&)> startTest,
+                   std::function<void(const Test&)> endTest,
+                   std::function<void()> changed)
+    {
+        Vector<int> selected;
+        for (int i = 0; i < groups.size(); i++) {
+            if (groups[i].selected) selected.add(i);
+        }
+        int workers = gTestWorkers > 0 ? gTestWorkers : std::max(1, int(std::thread::hardware_concurrency()));
+        int pos = 0;
+        while (pos < selected.size()) {
+            if (workers == 1 || isSerialGroup(groups[selected[pos]])) {
+                TestGroup& group = groups[selected[pos]];
+                startGroup(group);
+                for (auto& test: group.tests) {
+                    /* Make clear that we're running the test. */
+                    test.result = TestResult::RUNNING;
+                    changed();
+                    startTest(test);
+                    runTest(test, false);
+                    endTest(test);
+                    changed();
+                }
+                pos++;
+            } else {
+                int end = pos;
+                while (end < selected.size() && !isSerialGroup(groups[selected[end]])) end++;
+                runGroupsInParallel(groups, selected.subList(pos, end - pos), workers, [&](TestGroup& group) {
+                    startGroup(group);
+                    for (const auto& test: group.tests) {
+                        startTest(test);
+                        endTest(test);
+                    }
+                    changed();
+                });
+                pos = end;
+            }
+        }
+    }
+
     void runSelectedGroups(Vector<TestGroup>& groups, Where where)
     {
         GBrowserPane *bp = nullptr;
@@ -286,24 +625,23 @@ namespace SimpleTest {
 
         int nrun=0, npassed=0;
         const int test_name_length = 30;
+        auto reportStart = [&console](const Test& test) {
+            console << "[SimpleTest] starting" << test.id << left << setfill('.') << setw(test_name_length) << test.testname.substr(0,test_name_length) << "... " << flush;
+        };
+        auto reportEnd = [&console, &nrun, &npassed](const Test& test) {
+            nrun++;
+            if (test.result == TestResult::PASS) npassed++;
+            string status = info[test.result].status;
+            if (!GThread::qtGuiThreadExists()) status = info[test.result].color + status + NORMAL;
+            console << " =  " << status << endl << test.detailMessage << flush;
+        };
+
         /* Now, go run the tests. */
-        for (auto& group: groups) {
-            if (!group.selected) continue;
+        runGroups(groups, [&](const TestGroup& group) {
             console << endl << "[SimpleTest] ---- Tests from " << group.name << " -----" << endl;
-            for (auto& test: group.tests) {
-                /* Make clear that we're running the test. */
-                test.result = TestResult::RUNNING;
-                displayResults(bp,stylesheet, groups);
-                console << "[SimpleTest] starting" << test.id << left << setfill('.') << setw(test_name_length) << test.testname.substr(0,test_name_length) << "... " << flush;
-                runSingleTest(test);
-                nrun++;
-                if (test.result == TestResult::PASS) npassed++;
-                string status = info[test.result].status;
-                if (!GThread::qtGuiThreadExists()) status = info[test.result].color + status + NORMAL;
-                console << " =  " << status << endl << test.detailMessage << flush;
-                displayResults(bp, stylesheet, groups);
-            }
-        }
+        }, reportStart, reportEnd, [&] {
+            displayResults(bp, stylesheet, groups);
+        });
         string conclusion = displayResults(bp, stylesheet, groups, npassed, nrun);
         console << "You passed " << npassed << " of " << nrun << " tests. " << conclusion << endl << endl;
         if (npassed < nrun) {
@@ -366,6 +704,23 @@ namespace SimpleTest {
         }
     }
 
+    /* Runs the given tests as runSimpleTests runs all tests, but with no menu,
+     * window or console output. Returns "file: test: result" for each test, in
+     * the order in which the results were reported.
+     */
+    vector<string> runTestsQuietly(const map<TestKey, multimap<int, TestCase>>& tests)
+    {
+        Vector<TestGroup> groups = prepareGroups(tests);
+        for (auto& group: groups) {
+            group.selected = group.isfilegroup;
+        }
+        vector<string> results;
+        runGroups(groups, [](const TestGroup&) {}, [](const Test&) {}, [&results](const Test& test) {
+            results.push_back(test.filename + ": " + test.testname + ": " + info[test.result].id);
+        }, [] {});
+        return results;
+    }
+
     bool runSimpleTests(Choice ch, Where where, std::string groupName = "")
     {
         if (!GThread::qtGuiThreadExists()) {
@@ -390,4 +745,21 @@ bool runSimpleTests(std::string groupName, Where where) {
     return SimpleTest::runSimpleTests(SELECTED_TESTS, where, groupName);
 }
 
+// for SimpleTest's own tests, which declare it by hand
+std::vector<std::string> runTestsQuietly(const std::map<TestKey, std::multimap<int, TestCase>>& tests) {
+    return SimpleTest::runTestsQuietly(tests);
+}
+
+void setTestWorkers(int n) {
+    gTestWorkers = std::max(0, n);
+}
+
+void setTestTimeout(double seconds) {
+    gTestTimeoutSecs = std::max(0.0, seconds);
+}
+
+void setTestIsolation(bool isolate) {
+    gIsolateTests = isolate;
+}
+
 
@@ -0,0 +1,1654 @@
+/*
+ * File: biginteger.cpp
+ * --------------------
+ * This file implements the biginteger.h interface.
+ *
+ * @version 2026/10/19
+ * - reimplemented on 64-bit limbs (see biginteger.h)
+ * @version 2017/10/28
+ * - initial version
+ */
+
+#include "biginteger.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <limits>
+#include <utility>
+#include "error.h"
+#include "hashcode.h"
+
+namespace {
+typedef uint64_t Limb;
+typedef std::vector<Limb> Mag;
+
+/*
+ * Sizes, in limbs, at which the faster algorithms take over.  Below these
+ * the simpler algorithms win because they have less overhead.
+ */
+const size_t KARATSUBA_THRESHOLD = 32;
+const size_t TOOM3_THRESHOLD = 160;
+const size_t BURNIKEL_ZIEGLER_THRESHOLD = 40;
+const size_t TO_STRING_THRESHOLD = 24;
+
+/*
+ * Implementation notes: double-width arithmetic
+ * ---------------------------------------------
+ * Multiplying two limbs needs a 128-bit result.  GCC and Clang provide a
+ * 128-bit integer type on 64-bit platforms; elsewhere the same results are
+ * computed from 32-bit halves.
+ */
+#if defined(__SIZEOF_INT128__)
+typedef unsigned __int128 DoubleLimb;
+#endif // __SIZEOF_INT128__
+
+/*
+ * Returns the low limb of a * b + c + d and stores the high limb into hi.
+ * The sum cannot overflow 128 bits.  hi may refer to the same variable as
+ * c or d.
+ */
+inline Limb mulAdd(Limb a, Limb b, Limb c, Limb d, Limb& hi) {
+#if defined(__SIZEOF_INT128__)
+    DoubleLimb t = (DoubleLimb) a * b + c + d;
+    hi = (Limb) (t >> 64);
+    return (Limb) t;
+#else
+    Limb aLo = a & 0xffffffffULL;
+    Limb aHi = a >> 32;
+    Limb bLo = b & 0xffffffffULL;
+    Limb bHi = b >> 32;
+    Limb p0 = aLo * bLo;
+    Limb p1 = aLo * bHi;
+    Limb p2 = aHi * bLo;
+    Limb p3 = aHi * bHi;
+    Limb mid = (p0 >> 32) + (p1 & 0xffffffffULL) + (p2 & 0xffffffffULL);
+    Limb lo = (p0 & 0xffffffffULL) | (mid << 32);
+    Limb high = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+    lo += c;
+    high += (lo < c);
+    lo += d;
+    high += (lo < d);
+    hi = high;
+    return lo;
+#endif // __SIZEOF_INT128__
+}
+
+/*
+ * Returns the number of leading 0 bits in the given nonzero limb.
+ */
+inline int countLeadingZeros(Limb x) {
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int count = 0;
+    while (!(x & (1ULL << 63))) {
+        x <<= 1;
+        count++;
+    }
+    return count;
+#endif // __GNUC__
+}
+
+/*
+ * Divides the two-limb number hi:lo by d and returns the quotient, storing
+ * the remainder into rem.  hi must be less than d so the quotient fits.
+ * The portable version is Knuth's algorithm D on 32-bit digits, as given in
+ * Warren, "Hacker's Delight", section 9-4.
+ */
+inline Limb divWide(Limb hi, Limb lo, Limb d, Limb& rem) {
+#if defined(__SIZEOF_INT128__)
+    DoubleLimb n = ((DoubleLimb) hi << 64) | lo;
+    rem = (Limb) (n % d);
+    return (Limb) (n / d);
+#else
+    const Limb b = 1ULL << 32;
+    int s = countLeadingZeros(d);
+    d <<= s;
+    if (s != 0) {
+        hi = (hi << s) | (lo >> (64 - s));
+        lo <<= s;
+    }
+    Limb dHi = d >> 32;
+    Limb dLo = d & 0xffffffffULL;
+    Limb lo1 = lo >> 32;
+    Limb lo0 = lo & 0xffffffffULL;
+
+    Limb q1 = hi / dHi;
+    Limb r = hi - q1 * dHi;
+    while (q1 >= b || q1 * dLo > ((r << 32) | lo1)) {
+        q1--;
+        r += dHi;
+        if (r >= b) {
+            break;
+        }
+    }
+    Limb mid = (hi << 32) + lo1 - q1 * d;
+
+    Limb q0 = mid / dHi;
+    r = mid - q0 * dHi;
+    while (q0 >= b || q0 * dLo > ((r << 32) | lo0)) {
+        q0--;
+        r += dHi;
+        if (r >= b) {
+            break;
+        }
+    }
+    rem = ((mid << 32) + lo0 - q0 * d) >> s;
+    return (q1 << 32) | q0;
+#endif // __SIZEOF_INT128__
+}
+
+/*
+ * Implementation notes: limb arrays
+ * ---------------------------------
+ * The functions below work on raw arrays of limbs so that the recursive
+ * algorithms can operate on pieces of a larger array without copying.
+ * A Mag is a vector of limbs with no leading zero limbs.
+ */
+
+/*
+ * Removes leading zero limbs.
+ */
+inline void trim(Mag& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+/*
+ * Returns the length of the given array without its leading zero limbs.
+ */
+inline size_t trimmedLength(const Limb* a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+    return n;
+}
+
+/*
+ * Compares two arrays of the same length as numbers.
+ */
+int compareN(const Limb* a, const Limb* b, size_t n) {
+    for (size_t i = n; i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+int compareMag(const Mag& a, const Mag& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    return compareN(a.data(), b.data(), a.size());
+}
+
+/*
+ * Adds b[0 .. bn) into a[0 .. an), where an >= bn, and returns the carry
+ * out of the top of a.
+ */
+Limb addInto(Limb* a, size_t an, const Limb* b, size_t bn) {
+    Limb carry = 0;
+    size_t i = 0;
+    for (; i < bn; i++) {
+        Limb sum = a[i] + carry;
+        carry = (sum < carry);
+        sum += b[i];
+        carry += (sum < b[i]);
+        a[i] = sum;
+    }
+    for (; carry != 0 && i < an; i++) {
+        carry = (++a[i] == 0);
+    }
+    return carry;
+}
+
+/*
+ * Subtracts b[0 .. bn) from a[0 .. an), where an >= bn, and returns the
+ * borrow out of the top of a.
+ */
+Limb subtractFrom(Limb* a, size_t an, const Limb* b, size_t bn) {
+    Limb borrow = 0;
+    size_t i = 0;
+    for (; i < bn; i++) {
+        Limb ai = a[i];
+        Limb diff = ai - b[i];
+        Limb borrow1 = (ai < b[i]);
+        a[i] = diff - borrow;
+        borrow = borrow1 + (diff < borrow);
+    }
+    for (; borrow != 0 && i < an; i++) {
+        borrow = (a[i]-- == 0);
+    }
+    return borrow;
+}
+
+/*
+ * Returns a + b.
+ */
+Mag addMag(const Mag& a, const Mag& b) {
+    const Mag& longer = a.size() >= b.size() ? a : b;
+    const Mag& shorter = a.size() >= b.size() ? b : a;
+    Mag result(longer.size() + 1);
+    std::copy(longer.begin(), longer.end(), result.begin());
+    addInto(result.data(), result.size(), shorter.data(), shorter.size());
+    trim(result);
+    return result;
+}
+
+/*
+ * Returns a - b; a must be at least b.
+ */
+Mag subtractMag(const Mag& a, const Mag& b) {
+    Mag result = a;
+    subtractFrom(result.data(), result.size(), b.data(), b.size());
+    trim(result);
+    return result;
+}
+
+/*
+ * Returns a shifted left by the given number of bits.
+ */
+Mag shiftLeftMag(const Mag& a, size_t shift) {
+    if (a.empty()) {
+        return Mag();
+    }
+    size_t limbs = shift / 64;
+    int bits = shift % 64;
+    Mag result(a.size() + limbs + 1, 0);
+    if (bits == 0) {
+        std::copy(a.begin(), a.end(), result.begin() + limbs);
+    } else {
+        Limb carry = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            result[i + limbs] = (a[i] << bits) | carry;
+            carry = a[i] >> (64 - bits);
+        }
+        result[a.size() + limbs] = carry;
+    }
+    trim(result);
+    return result;
+}
+
+/*
+ * Returns a shifted right by the given number of bits, discarding the
+ * bits shifted out.
+ */
+Mag shiftRightMag(const Mag& a, size_t shift) {
+    size_t limbs = shift / 64;
+    int bits = shift % 64;
+    if (limbs >= a.size()) {
+        return Mag();
+    }
+    Mag result(a.size() - limbs);
+    if (bits == 0) {
+        std::copy(a.begin() + limbs, a.end(), result.begin());
+    } else {
+        for (size_t i = 0; i < result.size(); i++) {
+            Limb high = (i + limbs + 1 < a.size()) ? a[i + limbs + 1] << (64 - bits) : 0;
+            result[i] = (a[i + limbs] >> bits) | high;
+        }
+    }
+    trim(result);
+    return result;
+}
+
+/*
+ * Returns true if any of the lowest shift bits of a are set.
+ */
+bool hasLowBits(const Mag& a, size_t shift) {
+    size_t limbs = shift / 64;
+    for (size_t i = 0; i < limbs && i < a.size(); i++) {
+        if (a[i] != 0) {
+            return true;
+        }
+    }
+    int bits = shift % 64;
+    return bits != 0 && limbs < a.size() && (a[limbs] & ((1ULL << bits) - 1)) != 0;
+}
+
+size_t bitLengthMag(const Mag& a) {
+    return a.empty() ? 0 : a.size() * 64 - countLeadingZeros(a.back());
+}
+
+/*
+ * Sets a to a * m + add.
+ */
+void multiplySmallAdd(Mag& a, Limb m, Limb add) {
+    Limb carry = add;
+    for (Limb& limb : a) {
+        limb = mulAdd(limb, m, carry, 0, carry);
+    }
+    if (carry != 0) {
+        a.push_back(carry);
+    }
+}
+
+/*
+ * Divides a by d in place and returns the remainder.
+ */
+Limb divideSmall(Mag& a, Limb d) {
+    Limb rem = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        a[i] = divWide(rem, a[i], d, rem);
+    }
+    trim(a);
+    return rem;
+}
+
+/*
+ * Returns the pieces a[from .. from + length) as a trimmed Mag;
+ * the part past the end of a counts as zero.
+ */
+Mag slice(const Mag& a, size_t from, size_t length) {
+    if (from >= a.size()) {
+        return Mag();
+    }
+    size_t to = std::min(a.size(), from + length);
+    Mag result(a.begin() + from, a.begin() + to);
+    trim(result);
+    return result;
+}
+
+/*
+ * Returns high * B^n + low, where B is 2^64 and low has at most n limbs.
+ */
+Mag concat(const Mag& high, const Mag& low, size_t n) {
+    if (high.empty()) {
+        return low;
+    }
+    Mag result(n + high.size(), 0);
+    std::copy(low.begin(), low.end(), result.begin());
+    std::copy(high.begin(), high.end(), result.begin() + n);
+    return result;
+}
+
+/*
+ * Implementation notes: multiplication
+ * ------------------------------------
+ * multiplyInto picks an algorithm by the size of the smaller operand:
+ * schoolbook below KARATSUBA_THRESHOLD limbs, Karatsuba (3 half-size
+ * products instead of 4) up to TOOM3_THRESHOLD, and Toom-3 (5 third-size
+ * products instead of 9) above that.  An operand much longer than the
+ * other is cut into pieces the size of the shorter one, since both
+ * recursive algorithms want operands of about the same size.
+ */
+void multiplyInto(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn);
+
+/*
+ * Stores a * b into r[0 .. an + bn) using the schoolbook algorithm.
+ */
+void multiplyBasic(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn) {
+    std::fill(r, r + an, 0);
+    for (size_t i = 0; i < bn; i++) {
+        Limb carry = 0;
+        Limb bi = b[i];
+        if (bi != 0) {
+            for (size_t j = 0; j < an; j++) {
+                r[i + j] = mulAdd(a[j], bi, r[i + j], carry, carry);
+            }
+        }
+        r[i + an] = carry;
+    }
+}
+
+/*
+ * Stores a * b into r[0 .. an + bn) using Karatsuba's algorithm.
+ * Requires bn <= an < 2 * bn.  With a = a1 * B^k + a0 and likewise for b,
+ * a * b = z2 * B^2k + z1 * B^k + z0, where z0 = a0 * b0, z2 = a1 * b1, and
+ * z1 = (a0 + a1)(b0 + b1) - z0 - z2.
+ */
+void karatsuba(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn) {
+    size_t k = an / 2;
+    const Limb* a1 = a + k;
+    const Limb* b1 = b + k;
+    size_t a1n = an - k;
+    size_t b1n = bn - k;
+    multiplyInto(r, a, k, b, k);
+    multiplyInto(r + 2 * k, a1, a1n, b1, b1n);
+
+    Mag sumA(a1n + 1, 0);
+    std::copy(a1, a1 + a1n, sumA.begin());
+    addInto(sumA.data(), sumA.size(), a, k);
+    Mag sumB(std::max(k, b1n) + 1, 0);
+    std::copy(b, b + k, sumB.begin());
+    addInto(sumB.data(), sumB.size(), b1, b1n);
+    trim(sumA);
+    trim(sumB);
+
+    Mag middle(sumA.size() + sumB.size());
+    multiplyInto(middle.data(), sumA.data(), sumA.size(), sumB.data(), sumB.size());
+    size_t middleLength = trimmedLength(middle.data(), middle.size());
+    subtractFrom(middle.data(), middleLength, r, trimmedLength(r, 2 * k));
+    subtractFrom(middle.data(), middleLength, r + 2 * k, trimmedLength(r + 2 * k, an + bn - 2 * k));
+    middleLength = trimmedLength(middle.data(), middleLength);
+    addInto(r + k, an + bn - k, middle.data(), middleLength);
+}
+
+/*
+ * A signed number used for the intermediate values of Toom-3, some of
+ * which can be negative.
+ */
+struct SignedMag {
+    Mag mag;
+    bool negative = false;
+};
+
+SignedMag toSigned(const Mag& mag) {
+    SignedMag result;
+    result.mag = mag;
+    return result;
+}
+
+SignedMag add(const SignedMag& x, const SignedMag& y, bool negateY = false) {
+    bool yNegative = y.negative != negateY;
+    SignedMag result;
+    if (x.negative == yNegative) {
+        result.mag = addMag(x.mag, y.mag);
+        result.negative = x.negative;
+    } else if (compareMag(x.mag, y.mag) >= 0) {
+        result.mag = subtractMag(x.mag, y.mag);
+        result.negative = x.negative;
+    } else {
+        result.mag = subtractMag(y.mag, x.mag);
+        result.negative = yNegative;
+    }
+    result.negative = result.negative && !result.mag.empty();
+    return result;
+}
+
+SignedMag subtract(const SignedMag& x, const SignedMag& y) {
+    return add(x, y, /* negateY */ true);
+}
+
+SignedMag multiply(const SignedMag& x, const SignedMag& y) {
+    SignedMag result;
+    if (!x.mag.empty() && !y.mag.empty()) {
+        result.mag.resize(x.mag.size() + y.mag.size());
+        multiplyInto(result.mag.data(), x.mag.data(), x.mag.size(), y.mag.data(), y.mag.size());
+        trim(result.mag);
+        result.negative = x.negative != y.negative;
+    }
+    return result;
+}
+
+SignedMag shiftLeft(const SignedMag& x, size_t shift) {
+    SignedMag result = x;
+    result.mag = shiftLeftMag(x.mag, shift);
+    return result;
+}
+
+/*
+ * Returns x / d for a d that is known to divide x exactly.
+ */
+SignedMag divideExact(const SignedMag& x, Limb d) {
+    SignedMag result = x;
+    divideSmall(result.mag, d);
+    return result;
+}
+
+/*
+ * Stores a * b into r[0 .. an + bn) using Toom-3.  Requires bn <= an < 2 * bn.
+ * Each operand is split into three pieces of k limbs, viewed as a
+ * quadratic polynomial in x = B^k, and the product polynomial is found
+ * from its values at 0, 1, -1, -2, and infinity.  The evaluation and
+ * interpolation sequences are Bodrato's, which need only exact division
+ * by 2 and 3.
+ */
+void toom3(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn) {
+    size_t k = (an + 2) / 3;
+    Mag aMag(a, a + an);
+    Mag bMag(b, b + bn);
+    SignedMag a0 = toSigned(slice(aMag, 0, k));
+    SignedMag a1 = toSigned(slice(aMag, k, k));
+    SignedMag a2 = toSigned(slice(aMag, 2 * k, k));
+    SignedMag b0 = toSigned(slice(bMag, 0, k));
+    SignedMag b1 = toSigned(slice(bMag, k, k));
+    SignedMag b2 = toSigned(slice(bMag, 2 * k, k));
+
+    // evaluation
+    SignedMag pSum = add(a0, a2);
+    SignedMag pAt1 = add(pSum, a1);
+    SignedMag pAtMinus1 = subtract(pSum, a1);
+    SignedMag pAtMinus2 = subtract(shiftLeft(add(pAtMinus1, a2), 1), a0);
+    SignedMag qSum = add(b0, b2);
+    SignedMag qAt1 = add(qSum, b1);
+    SignedMag qAtMinus1 = subtract(qSum, b1);
+    SignedMag qAtMinus2 = subtract(shiftLeft(add(qAtMinus1, b2), 1), b0);
+
+    // pointwise multiplication
+    SignedMag r0 = multiply(a0, b0);
+    SignedMag rAt1 = multiply(pAt1, qAt1);
+    SignedMag rAtMinus1 = multiply(pAtMinus1, qAtMinus1);
+    SignedMag rAtMinus2 = multiply(pAtMinus2, qAtMinus2);
+    SignedMag r4 = multiply(a2, b2);
+
+    // interpolation
+    SignedMag r3 = divideExact(subtract(rAtMinus2, rAt1), 3);
+    SignedMag r1 = divideExact(subtract(rAt1, rAtMinus1), 2);
+    SignedMag r2 = subtract(rAtMinus1, r0);
+    r3 = add(divideExact(subtract(r2, r3), 2), shiftLeft(r4, 1));
+    r2 = subtract(add(r2, r1), r4);
+    r1 = subtract(r1, r3);
+
+    // recomposition; every coefficient of the product is non-negative
+    std::fill(r, r + an + bn, 0);
+    const SignedMag* coefficients[] = {&r0, &r1, &r2, &r3, &r4};
+    for (size_t i = 0; i < 5; i++) {
+        const Mag& c = coefficients[i]->mag;
+        if (!c.empty()) {
+            addInto(r + i * k, an + bn - i * k, c.data(), c.size());
+        }
+    }
+}
+
+void multiplyInto(Limb* r, const Limb* a, size_t an, const Limb* b, size_t bn) {
+    if (an < bn) {
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+    if (bn < KARATSUBA_THRESHOLD) {
+        multiplyBasic(r, a, an, b, bn);
+    } else if (an >= 2 * bn) {
+        std::fill(r, r + an + bn, 0);
+        Mag piece(2 * bn);
+        for (size_t i = 0; i < an; i += bn) {
+            size_t length = std::min(bn, an - i);
+            multiplyInto(piece.data(), a + i, length, b, bn);
+            addInto(r + i, an + bn - i, piece.data(), length + bn);
+        }
+    } else if (bn < TOOM3_THRESHOLD) {
+        karatsuba(r, a, an, b, bn);
+    } else {
+        toom3(r, a, an, b, bn);
+    }
+}
+
+Mag multiplyMag(const Mag& a, const Mag& b) {
+    if (a.empty() || b.empty()) {
+        return Mag();
+    }
+    Mag result(a.size() + b.size());
+    multiplyInto(result.data(), a.data(), a.size(), b.data(), b.size());
+    trim(result);
+    return result;
+}
+
+/*
+ * Implementation notes: division
+ * ------------------------------
+ * divideKnuth is the classic long division of Knuth's "The Art of Computer
+ * Programming", vol. 2, section 4.3.1, algorithm D, which takes time
+ * proportional to the product of the lengths.  For long divisors,
+ * divideBurnikelZiegler splits the problem into halves recursively so that
+ * most of the work is done by the fast multiplication above, following
+ * Burnikel and Ziegler, "Fast Recursive Division" (1998).
+ */
+void divideMag(const Mag& u, const Mag& v, Mag& q, Mag& r);
+
+/*
+ * Divides u by v, where v has at least two limbs and u >= v.
+ */
+void divideKnuth(const Mag& u, const Mag& v, Mag& q, Mag& r) {
+    size_t n = v.size();
+    size_t m = u.size() - n;
+    int s = countLeadingZeros(v.back());
+
+    // normalize so that the top bit of the divisor is set
+    Mag vn(n);
+    Mag un(u.size() + 1);
+    for (size_t i = n - 1; i > 0; i--) {
+        vn[i] = (v[i] << s) | (s == 0 ? 0 : v[i - 1] >> (64 - s));
+    }
+    vn[0] = v[0] << s;
+    un[u.size()] = (s == 0) ? 0 : u.back() >> (64 - s);
+    for (size_t i = u.size() - 1; i > 0; i--) {
+        un[i] = (u[i] << s) | (s == 0 ? 0 : u[i - 1] >> (64 - s));
+    }
+    un[0] = u[0] << s;
+
+    q.assign(m + 1, 0);
+    Limb vTop = vn[n - 1];
+    Limb vNext = vn[n - 2];
+    for (size_t j = m + 1; j-- > 0;) {
+        // estimate the quotient digit from the top two limbs
+        Limb qhat;
+        Limb rhat;
+        bool rhatOverflow = false;
+        if (un[j + n] >= vTop) {
+            qhat = ~0ULL;
+            rhat = un[j + n - 1] + vTop;
+            rhatOverflow = rhat < vTop;
+        } else {
+            qhat = divWide(un[j + n], un[j + n - 1], vTop, rhat);
+        }
+        while (!rhatOverflow) {
+            Limb productHi;
+            Limb productLo = mulAdd(qhat, vNext, 0, 0, productHi);
+            if (productHi < rhat || (productHi == rhat && productLo <= un[j + n - 2])) {
+                break;
+            }
+            qhat--;
+            rhat += vTop;
+            rhatOverflow = rhat < vTop;
+        }
+
+        // multiply and subtract
+        Limb carry = 0;
+        Limb borrow = 0;
+        for (size_t i = 0; i < n; i++) {
+            Limb product = mulAdd(qhat, vn[i], carry, 0, carry);
+            Limb ui = un[i + j];
+            Limb diff = ui - product;
+            Limb borrow1 = (ui < product);
+            un[i + j] = diff - borrow;
+            borrow = borrow1 + (diff < borrow);
+        }
+        Limb top = un[j + n];
+        Limb diff = top - carry;
+        Limb borrow1 = (top < carry);
+        un[j + n] = diff - borrow;
+        borrow = borrow1 + (diff < borrow);
+
+        // the estimate was one too large; add the divisor back
+        if (borrow != 0) {
+            qhat--;
+            un[j + n] += addInto(un.data() + j, n, vn.data(), n);
+        }
+        q[j] = qhat;
+    }
+    trim(q);
+
+    un.resize(n);
+    trim(un);
+    r = shiftRightMag(un, s);
+}
+
+/*
+ * Divides by schoolbook methods, with no recursion into Burnikel-Ziegler.
+ */
+void divideBasic(const Mag& u, const Mag& v, Mag& q, Mag& r) {
+    if (compareMag(u, v) < 0) {
+        q.clear();
+        r = u;
+    } else if (v.size() == 1) {
+        q = u;
+        Limb rem = divideSmall(q, v[0]);
+        r.clear();
+        if (rem != 0) {
+            r.push_back(rem);
+        }
+    } else {
+        divideKnuth(u, v, q, r);
+    }
+}
+
+void divide3n2n(const Mag& a, const Mag& b, size_t h, Mag& q, Mag& r);
+
+/*
+ * Divides a by b, where b has exactly n limbs with its top bit set and
+ * a < b * B^n, so the quotient has at most n limbs.
+ */
+void divide2n1n(const Mag& a, const Mag& b, size_t n, Mag& q, Mag& r) {
+    if (n % 2 != 0 || n < BURNIKEL_ZIEGLER_THRESHOLD) {
+        divideBasic(a, b, q, r);
+        return;
+    }
+    size_t h = n / 2;
+    Mag q1;
+    Mag r1;
+    divide3n2n(slice(a, h, 3 * h), b, h, q1, r1);
+    Mag q2;
+    divide3n2n(concat(r1, slice(a, 0, h), h), b, h, q2, r);
+    q = concat(q1, q2, h);
+}
+
+/*
+ * Divides a by b, where b has exactly 2h limbs with its top bit set and
+ * a < b * B^h.  The top half of b gives an estimate of the quotient that
+ * is corrected with one multiplication by the bottom half.
+ */
+void divide3n2n(const Mag& a, const Mag& b, size_t h, Mag& q, Mag& r) {
+    Mag a12 = slice(a, h, 2 * h);
+    Mag b1 = slice(b, h, h);
+    Mag b2 = slice(b, 0, h);
+    Mag r1;
+    if (compareMag(slice(a, 2 * h, h), b1) < 0) {
+        divide2n1n(a12, b1, h, q, r1);
+    } else {
+        // quotient estimate is B^h - 1; r1 = a12 - b1 * (B^h - 1)
+        q.assign(h, ~0ULL);
+        r1 = subtractMag(addMag(a12, b1), concat(b1, Mag(), h));
+    }
+    Mag d = multiplyMag(q, b2);
+    Mag rhat = concat(r1, slice(a, 0, h), h);
+    const Mag one(1, 1);
+    while (compareMag(rhat, d) < 0) {
+        rhat = addMag(rhat, b);
+        q = subtractMag(q, one);
+    }
+    r = subtractMag(rhat, d);
+}
+
+/*
+ * Divides u by v with the Burnikel-Ziegler algorithm.  The divisor is
+ * shifted so that it fills a whole number of blocks of n limbs with its
+ * top bit set; the dividend is shifted the same amount and divided one
+ * block at a time, from the top, with divide2n1n.
+ */
+void divideBurnikelZiegler(const Mag& u, const Mag& v, Mag& q, Mag& r) {
+    size_t blocks = 1;
+    while (blocks * BURNIKEL_ZIEGLER_THRESHOLD < v.size()) {
+        blocks *= 2;
+    }
+    size_t n = ((v.size() + blocks - 1) / blocks) * blocks;
+    size_t shift = n * 64 - bitLengthMag(v);
+    Mag b = shiftLeftMag(v, shift);
+    Mag a = shiftLeftMag(u, shift);
+
+    // t blocks, with at least one leading 0 bit so the top block is less than b
+    size_t t = std::max<size_t>(2, (bitLengthMag(a) + 1 + n * 64 - 1) / (n * 64));
+    q.assign(t * n, 0);
+    Mag z = slice(a, (t - 2) * n, 2 * n);
+    for (size_t i = t - 2; ; i--) {
+        Mag qi;
+        Mag ri;
+        divide2n1n(z, b, n, qi, ri);
+        std::copy(qi.begin(), qi.end(), q.begin() + i * n);
+        if (i == 0) {
+            r = shiftRightMag(ri, shift);
+            break;
+        }
+        z = concat(ri, slice(a, (i - 1) * n, n), n);
+    }
+    trim(q);
+}
+
+/*
+ * Sets q and r to the quotient and remainder of u / v; v must not be zero.
+ */
+void divideMag(const Mag& u, const Mag& v, Mag& q, Mag& r) {
+    if (v.size() >= BURNIKEL_ZIEGLER_THRESHOLD
+            && u.size() >= v.size() + BURNIKEL_ZIEGLER_THRESHOLD) {
+        divideBurnikelZiegler(u, v, q, r);
+    } else {
+        divideBasic(u, v, q, r);
+    }
+}
+
+Mag remainderMag(const Mag& u, const Mag& v) {
+    Mag q;
+    Mag r;
+    divideMag(u, v, q, r);
+    return r;
+}
+
+/*
+ * Implementation notes: Montgomery
+ * --------------------------------
+ * Montgomery multiplication computes a * b / R mod m, with R = B^n for an
+ * n-limb odd modulus m, using only multiplications and shifts, with no
+ * division.  Numbers are kept in "Montgomery form" x * R mod m throughout
+ * modPow so that the factors of R cancel out; only the conversions into
+ * and out of that form need a real division.  The loop is the coarsely
+ * integrated operand scanning (CIOS) method of Koc, Acar, and Kaliski,
+ * "Analyzing and Comparing Montgomery Multiplication Algorithms" (1996).
+ */
+class Montgomery {
+public:
+    explicit Montgomery(const Mag& modulus)
+            : _modulus(modulus),
+              _n(modulus.size()),
+              _scratch(modulus.size() + 2) {
+        // Newton's iteration for m^-1 mod 2^64 doubles the number of correct
+        // bits each time, starting from 3 (any odd x satisfies x * x = 1 mod 8)
+        Limb m0 = modulus[0];
+        Limb inverse = m0;
+        for (int i = 0; i < 5; i++) {
+            inverse *= 2 - m0 * inverse;
+        }
+        _negativeInverse = 0 - inverse;
+    }
+
+    /*
+     * Returns x * R mod m for an x less than m.
+     */
+    Mag toMontgomery(const Mag& x) const {
+        Mag shifted(_n + x.size(), 0);
+        std::copy(x.begin(), x.end(), shifted.begin() + _n);
+        trim(shifted);
+        Mag result = remainderMag(shifted, _modulus);
+        result.resize(_n, 0);
+        return result;
+    }
+
+    /*
+     * Returns x / R mod m.
+     */
+    Mag fromMontgomery(const Mag& x) {
+        Mag one(_n, 0);
+        one[0] = 1;
+        Mag result(_n);
+        multiply(x.data(), one.data(), result.data());
+        trim(result);
+        return result;
+    }
+
+    /*
+     * Stores a * b / R mod m into out; all arrays have n limbs.
+     * out may be the same array as a or b.
+     */
+    void multiply(const Limb* a, const Limb* b, Limb* out) {
+        Limb* t = _scratch.data();
+        const Limb* m = _modulus.data();
+        std::fill(_scratch.begin(), _scratch.end(), 0);
+        for (size_t i = 0; i < _n; i++) {
+            Limb carry = 0;
+            Limb bi = b[i];
+            for (size_t j = 0; j < _n; j++) {
+                t[j] = mulAdd(a[j], bi, t[j], carry, carry);
+            }
+            Limb sum = t[_n] + carry;
+            t[_n + 1] = (sum < carry);
+            t[_n] = sum;
+
+            // add a multiple of m that clears the low limb, then drop it
+            Limb factor = t[0] * _negativeInverse;
+            mulAdd(factor, m[0], t[0], 0, carry);
+            for (size_t j = 1; j < _n; j++) {
+                t[j - 1] = mulAdd(factor, m[j], t[j], carry, carry);
+            }
+            sum = t[_n] + carry;
+            t[_n - 1] = sum;
+            t[_n] = t[_n + 1] + (sum < carry);
+        }
+        if (t[_n] != 0 || compareN(t, m, _n) >= 0) {
+            subtractFrom(t, _n + 1, m, _n);
+        }
+        std::copy(t, t + _n, out);
+    }
+
+private:
+    Mag _modulus;
+    size_t _n;
+    Limb _negativeInverse;   // -m^-1 mod 2^64
+    Mag _scratch;
+};
+
+/*
+ * Returns the given w bits of a starting at bit position pos.
+ */
+Limb getBits(const Mag& a, size_t pos, int w) {
+    size_t index = pos / 64;
+    int offset = pos % 64;
+    if (index >= a.size()) {
+        return 0;
+    }
+    Limb value = a[index] >> offset;
+    if (offset + w > 64 && index + 1 < a.size()) {
+        value |= a[index + 1] << (64 - offset);
+    }
+    return value & ((1ULL << w) - 1);
+}
+
+/*
+ * Returns base^exp mod m for an odd m, with base < m, using a fixed
+ * window of w exponent bits per multiplication.
+ */
+Mag modPowMontgomery(const Mag& base, const Mag& exp, const Mag& m) {
+    Montgomery mont(m);
+    size_t n = m.size();
+    size_t bits = bitLengthMag(exp);
+    int w = bits > 768 ? 5 : bits > 192 ? 4 : bits > 24 ? 3 : 1;
+
+    std::vector<Mag> table(1 << w);
+    table[0] = mont.toMontgomery(Mag(1, 1));
+    table[1] = mont.toMontgomery(base);
+    for (size_t i = 2; i < table.size(); i++) {
+        table[i].resize(n);
+        mont.multiply(table[i - 1].data(), table[1].data(), table[i].data());
+    }
+
+    Mag result = table[0];
+    bool first = true;
+    size_t pos = ((bits + w - 1) / w) * w;
+    while (pos > 0) {
+        pos -= w;
+        if (!first) {
+            for (int i = 0; i < w; i++) {
+                mont.multiply(result.data(), result.data(), result.data());
+            }
+        }
+        Limb digit = getBits(exp, pos, w);
+        if (digit != 0) {
+            if (first) {
+                result = table[digit];
+            } else {
+                mont.multiply(result.data(), table[digit].data(), result.data());
+            }
+            first = false;
+        }
+    }
+    return mont.fromMontgomery(result);
+}
+
+/*
+ * Implementation notes: radix conversion
+ * --------------------------------------
+ * A "chunk" is the largest number of digits in the given radix whose value
+ * always fits in a limb, such as 19 decimal digits.  Short numbers are
+ * converted one chunk at a time.  Long numbers are split in half by
+ * dividing (or multiplying) by radix^(chunk * 2^k), a table of which is
+ * made by repeated squaring, so that the cost is dominated by a few large
+ * divisions or multiplications rather than by many small ones.
+ */
+struct Radix {
+    int radix;
+    int chunkDigits;           // digits per chunk
+    Limb chunkPower;           // radix ^ chunkDigits
+    std::vector<Mag> powers;   // powers[k] is radix ^ (chunkDigits * 2^k)
+
+    explicit Radix(int r) : radix(r), chunkDigits(0), chunkPower(1) {
+        while (chunkPower <= std::numeric_limits<Limb>::max() / r) {
+            chunkPower *= r;
+            chunkDigits++;
+        }
+        powers.push_back(Mag(1, chunkPower));
+    }
+
+    const Mag& power(size_t k) {
+        while (powers.size() <= k) {
+            powers.push_back(multiplyMag(powers.back(), powers.back()));
+        }
+        return powers[k];
+    }
+};
+
+int digitValue(char ch) {
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    } else if (ch >= 'a' && ch <= 'z') {
+        return ch - 'a' + 10;
+    } else if (ch >= 'A' && ch <= 'Z') {
+        return ch - 'A' + 10;
+    } else {
+        return 99;
+    }
+}
+
+const char DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/*
+ * Returns the value of the given digits, which have already been checked.
+ */
+Mag parseDigits(const char* s, size_t length, Radix& radix) {
+    size_t chunk = radix.chunkDigits;
+    if (length <= chunk * TO_STRING_THRESHOLD) {
+        Mag result;
+        size_t first = length % chunk == 0 ? chunk : length % chunk;
+        for (size_t i = 0; i < length; ) {
+            size_t count = (i == 0) ? first : chunk;
+            Limb value = 0;
+            Limb scale = 1;
+            for (size_t j = 0; j < count; j++) {
+                value = value * radix.radix + digitValue(s[i + j]);
+                scale *= radix.radix;
+            }
+            multiplySmallAdd(result, scale, value);
+            i += count;
+        }
+        trim(result);
+        return result;
+    }
+    size_t k = 0;
+    while ((chunk << (k + 1)) < length) {
+        k++;
+    }
+    size_t lowLength = chunk << k;
+    Mag high = parseDigits(s, length - lowLength, radix);
+    Mag low = parseDigits(s + length - lowLength, lowLength, radix);
+    Mag result = multiplyMag(high, radix.power(k));
+    result.resize(std::max(result.size(), low.size()) + 1, 0);
+    addInto(result.data(), result.size(), low.data(), low.size());
+    trim(result);
+    return result;
+}
+
+/*
+ * Appends the digits of x to out, padded with leading zeros to at least
+ * the given number of digits.
+ */
+void writeDigits(std::string& out, const Mag& x, size_t pad, Radix& radix) {
+    if (x.size() < TO_STRING_THRESHOLD) {
+        std::string reversed;
+        Mag rest = x;
+        while (!rest.empty()) {
+            Limb chunk = divideSmall(rest, radix.chunkPower);
+            for (int i = 0; i < radix.chunkDigits && (chunk != 0 || !rest.empty()); i++) {
+                reversed += DIGITS[chunk % radix.radix];
+                chunk /= radix.radix;
+            }
+        }
+        if (reversed.length() < pad) {
+            reversed.append(pad - reversed.length(), '0');
+        }
+        out.append(reversed.rbegin(), reversed.rend());
+        return;
+    }
+
+    // split at the largest power whose square is about the size of x
+    size_t k = 0;
+    while (2 * radix.power(k + 1).size() <= x.size() + 1) {
+        k++;
+    }
+    size_t lowDigits = radix.chunkDigits << k;
+    Mag q;
+    Mag r;
+    divideMag(x, radix.power(k), q, r);
+    writeDigits(out, q, pad > lowDigits ? pad - lowDigits : 0, radix);
+    writeDigits(out, r, lowDigits, radix);
+}
+
+void checkRadix(int radix, const std::string& prefix) {
+    if (radix < 2 || radix > 36) {
+        error(prefix + ": Illegal radix: " + std::to_string(radix));
+    }
+}
+
+/*
+ * Returns the two's complement form of the given number in exactly the
+ * given number of limbs, which must be more than the magnitude has.
+ */
+Mag toTwosComplement(const Mag& mag, bool negative, size_t length) {
+    Mag result(mag);
+    result.resize(length, 0);
+    if (negative) {
+        const Limb one = 1;
+        subtractFrom(result.data(), length, &one, 1);
+        for (Limb& limb : result) {
+            limb = ~limb;
+        }
+    }
+    return result;
+}
+} // namespace
+
+/*static*/ const BigInteger BigInteger::NEGATIVE_ONE(-1L);
+/*static*/ const BigInteger BigInteger::ZERO(0L);
+/*static*/ const BigInteger BigInteger::ONE(1L);
+/*static*/ const BigInteger BigInteger::TWO(2L);
+/*static*/ const BigInteger BigInteger::TEN(10L);
+/*static*/ const BigInteger BigInteger::MAX_INT((long) INT_MAX);
+/*static*/ const BigInteger BigInteger::MIN_INT((long) INT_MIN);
+/*static*/ const BigInteger BigInteger::MAX_UINT(Mag(1, UINT_MAX), false);
+/*static*/ const BigInteger BigInteger::MAX_LONG(LONG_MAX);
+/*static*/ const BigInteger BigInteger::MIN_LONG(LONG_MIN);
+/*static*/ const BigInteger BigInteger::MAX_ULONG(Mag(1, ULONG_MAX), false);
+/*static*/ const BigInteger BigInteger::MAX_SHORT((long) SHRT_MAX);
+/*static*/ const BigInteger BigInteger::MIN_SHORT((long) SHRT_MIN);
+/*static*/ const BigInteger BigInteger::MAX_USHORT((long) USHRT_MAX);
+
+BigInteger::BigInteger()
+        : _negative(false) {
+    // empty
+}
+
+BigInteger::BigInteger(BigInteger&& other) noexcept
+        : _magnitude(std::move(other._magnitude)),
+          _negative(other._negative) {
+    other._magnitude.clear();
+    other._negative = false;
+}
+
+BigInteger::BigInteger(const std::string& s, int radix)
+        : _negative(false) {
+    checkRadix(radix, "BigInteger::constructor");
+    if (!parse(s, radix, *this)) {
+        error("BigInteger::constructor: not a base-" + std::to_string(radix)
+              + " integer: \"" + s + "\"");
+    }
+}
+
+BigInteger::BigInteger(long n)
+        : _negative(n < 0) {
+    if (n != 0) {
+        // negate as unsigned so that LONG_MIN works
+        unsigned long magnitude = n < 0 ? 0UL - (unsigned long) n : (unsigned long) n;
+        _magnitude.push_back(magnitude);
+    }
+}
+
+BigInteger::BigInteger(std::vector<uint64_t>&& magnitude, bool negative)
+        : _magnitude(std::move(magnitude)),
+          _negative(negative) {
+    trim(_magnitude);
+    _negative = _negative && !_magnitude.empty();
+}
+
+BigInteger BigInteger::abs() const {
+    BigInteger result(*this);
+    result._negative = false;
+    return result;
+}
+
+void BigInteger::addSigned(const std::vector<uint64_t>& magnitude, bool negative) {
+    if (&magnitude == &_magnitude) {
+        Mag copy(magnitude);
+        addSigned(copy, negative);
+        return;
+    }
+    if (_negative == negative) {
+        _magnitude.resize(std::max(_magnitude.size(), magnitude.size()) + 1, 0);
+        addInto(_magnitude.data(), _magnitude.size(), magnitude.data(), magnitude.size());
+    } else if (compareMag(_magnitude, magnitude) >= 0) {
+        subtractFrom(_magnitude.data(), _magnitude.size(), magnitude.data(), magnitude.size());
+    } else {
+        Mag difference(magnitude);
+        subtractFrom(difference.data(), difference.size(), _magnitude.data(), _magnitude.size());
+        _magnitude.swap(difference);
+        _negative = negative;
+    }
+    trim(_magnitude);
+    _negative = _negative && !_magnitude.empty();
+}
+
+int BigInteger::bitLength() const {
+    return (int) bitLengthMag(_magnitude);
+}
+
+/*
+ * Implementation notes: bitwise
+ * -----------------------------
+ * Both numbers are written in two's complement with one more limb than the
+ * longer one has, which is enough for a sign bit; the result's top bit is
+ * then its sign.
+ */
+void BigInteger::bitwise(const BigInteger& other, char op) {
+    size_t length = std::max(_magnitude.size(), other._magnitude.size()) + 1;
+    Mag a = toTwosComplement(_magnitude, _negative, length);
+    Mag b = toTwosComplement(other._magnitude, other._negative, length);
+    for (size_t i = 0; i < length; i++) {
+        if (op == '&') {
+            a[i] &= b[i];
+        } else if (op == '|') {
+            a[i] |= b[i];
+        } else {
+            a[i] ^= b[i];
+        }
+    }
+    bool negative = (a.back() >> 63) != 0;
+    if (negative) {
+        // two's complement back to a magnitude: invert and add 1
+        for (Limb& limb : a) {
+            limb = ~limb;
+        }
+        const Limb one = 1;
+        addInto(a.data(), a.size(), &one, 1);
+    }
+    *this = BigInteger(std::move(a), negative);
+}
+
+/*static*/ int BigInteger::compare(const BigInteger& b1, const BigInteger& b2) {
+    if (b1._negative != b2._negative) {
+        return b1._negative ? -1 : 1;
+    }
+    int cmp = compareMag(b1._magnitude, b2._magnitude);
+    return b1._negative ? -cmp : cmp;
+}
+
+void BigInteger::divide(const BigInteger& divisor, BigInteger* quotient, BigInteger* remainder,
+                        const std::string& caller) const {
+    if (divisor._magnitude.empty()) {
+        error(caller + ": cannot divide by zero");
+    }
+    Mag q;
+    Mag r;
+    divideMag(_magnitude, divisor._magnitude, q, r);
+    bool quotientNegative = _negative != divisor._negative;
+    bool remainderNegative = _negative;
+    if (quotient) {
+        *quotient = BigInteger(std::move(q), quotientNegative);
+    }
+    if (remainder) {
+        *remainder = BigInteger(std::move(r), remainderNegative);
+    }
+}
+
+BigInteger BigInteger::gcd(const BigInteger& other) const {
+    Mag a = _magnitude;
+    Mag b = other._magnitude;
+    while (!b.empty()) {
+        Mag r = remainderMag(a, b);
+        a.swap(b);
+        b.swap(r);
+    }
+    return BigInteger(std::move(a), false);
+}
+
+bool BigInteger::isInt() const {
+    return *this >= MIN_INT && *this <= MAX_INT;
+}
+
+bool BigInteger::isLong() const {
+    return *this >= MIN_LONG && *this <= MAX_LONG;
+}
+
+bool BigInteger::isNegative() const {
+    return _negative;
+}
+
+bool BigInteger::isNonNegative() const {
+    return !_negative;
+}
+
+bool BigInteger::isPositive() const {
+    return !_negative && !_magnitude.empty();
+}
+
+const BigInteger& BigInteger::max(const BigInteger& other) const {
+    return compare(*this, other) >= 0 ? *this : other;
+}
+
+const BigInteger& BigInteger::min(const BigInteger& other) const {
+    return compare(*this, other) <= 0 ? *this : other;
+}
+
+/*
+ * Implementation notes: modInverse
+ * --------------------------------
+ * The extended Euclidean algorithm keeps x such that this * x = r (mod m)
+ * for each remainder r; when r reaches gcd(this, m) = 1, x is the inverse.
+ */
+BigInteger BigInteger::modInverse(const BigInteger& m) const {
+    if (!m.isPositive()) {
+        error("BigInteger::modInverse: modulus must be positive");
+    }
+    BigInteger r0 = *this % m;
+    if (r0._negative) {
+        r0 += m;
+    }
+    BigInteger r1 = m;
+    BigInteger x0 = ONE;
+    BigInteger x1 = ZERO;
+    while (!r1._magnitude.empty()) {
+        BigInteger q;
+        BigInteger r;
+        r0.divide(r1, &q, &r, "BigInteger::modInverse");
+        BigInteger x = x0 - q * x1;
+        r0 = std::move(r1);
+        r1 = std::move(r);
+        x0 = std::move(x1);
+        x1 = std::move(x);
+    }
+    if (r0 != ONE) {
+        error("BigInteger::modInverse: " + toString() + " has no inverse modulo " + m.toString());
+    }
+    if (x0._negative) {
+        x0 += m;
+    }
+    return x0;
+}
+
+BigInteger BigInteger::modPow(const BigInteger& exp, const BigInteger& m) const {
+    if (exp._negative) {
+        error("BigInteger::modPow: exponent cannot be negative");
+    }
+    if (!m.isPositive()) {
+        error("BigInteger::modPow: modulus must be positive");
+    }
+    if (m == ONE) {
+        return ZERO;
+    }
+    BigInteger base = *this % m;
+    if (base._negative) {
+        base += m;
+    }
+    if (m._magnitude[0] & 1) {
+        return BigInteger(modPowMontgomery(base._magnitude, exp._magnitude, m._magnitude), false);
+    }
+
+    // even modulus; square and multiply, reducing as we go
+    BigInteger result = ONE;
+    for (size_t i = bitLengthMag(exp._magnitude); i-- > 0;) {
+        result = (result * result) % m;
+        if (getBits(exp._magnitude, i, 1)) {
+            result = (result * base) % m;
+        }
+    }
+    return result;
+}
+
+/*static*/ bool BigInteger::parse(std::string_view s, int radix, BigInteger& result) {
+    while (!s.empty() && isspace((unsigned char) s.front())) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && isspace((unsigned char) s.back())) {
+        s.remove_suffix(1);
+    }
+    bool negative = false;
+    if (!s.empty() && (s[0] == '+' || s[0] == '-')) {
+        negative = s[0] == '-';
+        s.remove_prefix(1);
+    }
+    if (radix == 16 && s.length() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        s.remove_prefix(2);
+    }
+    if (s.empty()) {
+        return false;
+    }
+    for (char ch : s) {
+        if (digitValue(ch) >= radix) {
+            return false;
+        }
+    }
+    while (s.length() > 1 && s[0] == '0') {
+        s.remove_prefix(1);
+    }
+    Radix r(radix);
+    result = BigInteger(parseDigits(s.data(), s.length(), r), negative);
+    return true;
+}
+
+BigInteger BigInteger::pow(long exp) const {
+    if (exp < 0) {
+        error("BigInteger::pow: exponent cannot be negative");
+    }
+    BigInteger result = ONE;
+    BigInteger square = *this;
+    while (exp > 0) {
+        if (exp & 1) {
+            result *= square;
+        }
+        exp >>= 1;
+        if (exp > 0) {
+            square *= square;
+        }
+    }
+    return result;
+}
+
+BigInteger BigInteger::pow(const BigInteger& exp) const {
+    if (exp._negative) {
+        error("BigInteger::pow: exponent cannot be negative");
+    }
+    if (exp.isLong()) {
+        return pow(exp.toLong());
+    } else if (_magnitude.empty() || _magnitude == ONE._magnitude) {
+        // 0, 1, or -1; -1 to an even power is 1
+        return (_negative && !(exp._magnitude[0] & 1)) ? ONE : *this;
+    }
+    error("BigInteger::pow: exponent is too large: " + exp.toString());
+    return ZERO;
+}
+
+int BigInteger::toInt() const {
+    if (!isInt()) {
+        error("BigInteger::toInt: value is out of range of type int: " + toString());
+    }
+    return (int) toLong();
+}
+
+long BigInteger::toLong() const {
+    if (!isLong()) {
+        error("BigInteger::toLong: value is out of range of type long: " + toString());
+    }
+    if (_magnitude.empty()) {
+        return 0;
+    }
+    unsigned long magnitude = (unsigned long) _magnitude[0];
+    return _negative ? -(long) (magnitude - 1) - 1 : (long) magnitude;
+}
+
+std::string BigInteger::toString(int radix) const {
+    checkRadix(radix, "BigInteger::toString");
+    if (_magnitude.empty()) {
+        return "0";
+    }
+    std::string result = _negative ? "-" : "";
+    if ((radix & (radix - 1)) == 0) {
+        // power of 2; each digit is a fixed group of bits
+        int bits = countLeadingZeros(1) - countLeadingZeros(radix);
+        size_t totalBits = bitLengthMag(_magnitude);
+        size_t digits = (totalBits + bits - 1) / bits;
+        result.reserve(result.length() + digits);
+        for (size_t i = digits; i-- > 0;) {
+            result += DIGITS[getBits(_magnitude, i * bits, bits)];
+        }
+    } else {
+        Radix r(radix);
+        writeDigits(result, _magnitude, 0, r);
+    }
+    return result;
+}
+
+BigInteger& BigInteger::operator ++() {
+    addSigned(ONE._magnitude, false);
+    return *this;
+}
+
+BigInteger BigInteger::operator ++(int) {
+    BigInteger copy(*this);
+    ++(*this);
+    return copy;
+}
+
+BigInteger& BigInteger::operator --() {
+    addSigned(ONE._magnitude, true);
+    return *this;
+}
+
+BigInteger BigInteger::operator --(int) {
+    BigInteger copy(*this);
+    --(*this);
+    return copy;
+}
+
+BigInteger& BigInteger::operator +=(const BigInteger& b) {
+    addSigned(b._magnitude, b._negative);
+    return *this;
+}
+
+BigInteger& BigInteger::operator -=(const BigInteger& b) {
+    addSigned(b._magnitude, !b._negative);
+    return *this;
+}
+
+BigInteger& BigInteger::operator *=(const BigInteger& b) {
+    *this = BigInteger(multiplyMag(_magnitude, b._magnitude), _negative != b._negative);
+    return *this;
+}
+
+BigInteger& BigInteger::operator /=(const BigInteger& b) {
+    divide(b, this, nullptr, "BigInteger::operator /");
+    return *this;
+}
+
+BigInteger& BigInteger::operator %=(const BigInteger& b) {
+    divide(b, nullptr, this, "BigInteger::operator %");
+    return *this;
+}
+
+BigInteger& BigInteger::operator &=(const BigInteger& b) {
+    bitwise(b, '&');
+    return *this;
+}
+
+BigInteger& BigInteger::operator |=(const BigInteger& b) {
+    bitwise(b, '|');
+    return *this;
+}
+
+BigInteger& BigInteger::operator ^=(const BigInteger& b) {
+    bitwise(b, '^');
+    return *this;
+}
+
+BigInteger BigInteger::operator ~() const {
+    BigInteger result = -*this;
+    --result;
+    return result;
+}
+
+BigInteger BigInteger::operator !() const {
+    return _magnitude.empty() ? ONE : ZERO;
+}
+
+BigInteger& BigInteger::operator =(BigInteger&& other) noexcept {
+    if (this != &other) {
+        _magnitude = std::move(other._magnitude);
+        _negative = other._negative;
+        other._magnitude.clear();
+        other._negative = false;
+    }
+    return *this;
+}
+
+BigInteger BigInteger::operator -() const {
+    BigInteger result(*this);
+    result._negative = !_negative && !_magnitude.empty();
+    return result;
+}
+
+BigInteger BigInteger::operator <<(unsigned int shift) const {
+    return BigInteger(shiftLeftMag(_magnitude, shift), _negative);
+}
+
+BigInteger& BigInteger::operator <<=(unsigned int shift) {
+    *this = *this << shift;
+    return *this;
+}
+
+BigInteger BigInteger::operator >>(unsigned int shift) const {
+    BigInteger result(shiftRightMag(_magnitude, shift), _negative);
+    if (_negative && hasLowBits(_magnitude, shift)) {
+        // round toward negative infinity, as for int
+        --result;
+    }
+    return result;
+}
+
+BigInteger& BigInteger::operator >>=(unsigned int shift) {
+    *this = *this >> shift;
+    return *this;
+}
+
+BigInteger::operator bool() const {
+    return !_magnitude.empty();
+}
+
+BigInteger::operator int() const {
+    return toInt();
+}
+
+BigInteger::operator long() const {
+    return toLong();
+}
+
+BigInteger::operator std::string() const {
+    return toString();
+}
+
+std::string bigIntegerToString(const BigInteger& bi, int radix) {
+    return bi.toString(radix);
+}
+
+int hashCode(const BigInteger& b) {
+    unsigned int hash = (unsigned int) hashSeed() + (b._negative ? 1 : 0);
+    for (uint64_t limb : b._magnitude) {
+        hash = hash * (unsigned int) hashMultiplier() + (unsigned int) limb;
+        hash = hash * (unsigned int) hashMultiplier() + (unsigned int) (limb >> 32);
+    }
+    return (int) (hash & (unsigned int) hashMask());
+}
+
+BigInteger operator +(const BigInteger& b1, const BigInteger& b2) {
+    BigInteger result(b1);
+    result += b2;
+    return result;
+}
+
+BigInteger operator -(const BigInteger& b1, const BigInteger& b2) {
+    BigInteger result(b1);
+    result -= b2;
+    return result;
+}
+
+BigInteger operator *(const BigInteger& b1, const BigInteger& b2) {
+    return BigInteger(multiplyMag(b1._magnitude, b2._magnitude), b1._negative != b2._negative);
+}
+
+BigInteger operator /(const BigInteger& b1, const BigInteger& b2) {
+    BigInteger quotient;
+    b1.divide(b2, &quotient, nullptr, "BigInteger::operator /");
+    return quotient;
+}
+
+BigInteger operator %(const BigInteger& b1, const BigInteger& b2) {
+    BigInteger remainder;
+    b1.divide(b2, nullptr, &remainder, "BigInteger::operator %");
+    return remainder;
+}
+
+BigInteger operator &(const BigInteger& b1, const BigInteger& b2) {
+    BigInteger result(b1);
+    result &= b2;
+    return result;
+}
+
+BigInteger operator |(const BigInteger& b1, const BigInteger& b2) {
+    BigInteger result(b1);
+    result |= b2;
+    return result;
+}
+
+BigInteger operator ^(const BigInteger& b1, const BigInteger& b2) {
+    BigInteger result(b1);
+    result ^= b2;
+    return result;
+}
+
+bool operator ==(const BigInteger& b1, const BigInteger& b2) {
+    return b1._negative == b2._negative && b1._magnitude == b2._magnitude;
+}
+
+bool operator !=(const BigInteger& b1, const BigInteger& b2) {
+    return !(b1 == b2);
+}
+
+bool operator >(const BigInteger& b1, const BigInteger& b2) {
+    return BigInteger::compare(b1, b2) > 0;
+}
+
+bool operator <(const BigInteger& b1, const BigInteger& b2) {
+    return BigInteger::compare(b1, b2) < 0;
+}
+
+bool operator >=(const BigInteger& b1, const BigInteger& b2) {
+    return BigInteger::compare(b1, b2) >= 0;
+}
+
+bool operator <=(const BigInteger& b1, const BigInteger& b2) {
+    return BigInteger::compare(b1, b2) <= 0;
+}
+
+std::istream& operator >>(std::istream& input, BigInteger& b) {
+    std::string token;
+    if (input >> token) {
+        std::ios_base::fmtflags base = input.flags() & std::ios_base::basefield;
+        int radix = base == std::ios_base::hex ? 16 : base == std::ios_base::oct ? 8 : 10;
+        BigInteger value;
+        if (BigInteger::parse(token, radix, value)) {
+            b = std::move(value);
+        } else {
+            input.setstate(std::ios_base::failbit);
+        }
+    }
+    return input;
+}
+
+std::ostream& operator <<(std::ostream& out, const BigInteger& b) {
+    std::ios_base::fmtflags base = out.flags() & std::ios_base::basefield;
+    int radix = base == std::ios_base::hex ? 16 : base == std::ios_base::oct ? 8 : 10;
+    return out << b.toString(radix);
+}
@@ -0,0 +1,560 @@
+/*
+ * File: biginteger.h
+ * ------------------
+ * This file exports a class for arbitrary-size integer arithmetic.
+ * It is meant to help get around the max/min value limit for types
+ * such as int and long.
+ *
+ * In general, a BigInteger supports the standard operators and operations
+ * that you would expect to be able to use on an int or long value.
+ *
+ * Example usage:
+ *
+ * BigInteger bi("1234567890123456789");
+ * for (int i = 0; i < 10; i++) {
+ *     bi *= 12345678;
+ * }
+ * cout << "really big number is: " << bi << endl;
+ *
+ * Implementation notes:
+ * The number is stored as a sign and a magnitude, and the magnitude is a
+ * vector of 64-bit "limbs", least significant first, so each limb is one
+ * digit in base 2^64.  Small numbers use the schoolbook algorithms; larger
+ * ones switch to Karatsuba and then Toom-3 multiplication, Burnikel-Ziegler
+ * division, and divide-and-conquer conversion to and from strings.
+ * modPow uses Montgomery multiplication when the modulus is odd, which is
+ * the common case in cryptography.
+ *
+ * @version 2026/10/19
+ * - reimplemented on 64-bit limbs instead of a string of decimal digits
+ * - Karatsuba/Toom-3 multiplication, Burnikel-Ziegler division
+ * - Montgomery modPow; divide-and-conquer toString and parsing
+ * - division and modulus no longer require the denominator to fit in a long
+ * - added bitLength, modInverse
+ * @version 2018/09/25
+ * - added doc comments for new documentation generation
+ * @version 2017/10/28
+ * - initial version
+ */
+
+
+#ifndef _biginteger_h
+#define _biginteger_h
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class BigInteger {
+public:
+    /**
+     * Constants to represent very commonly used big integer values
+     */
+    static const BigInteger NEGATIVE_ONE;
+    static const BigInteger ZERO;
+    static const BigInteger ONE;
+    static const BigInteger TWO;
+    static const BigInteger TEN;
+    static const BigInteger MAX_INT;
+    static const BigInteger MIN_INT;
+    static const BigInteger MAX_UINT;
+    static const BigInteger MAX_LONG;
+    static const BigInteger MIN_LONG;
+    static const BigInteger MAX_ULONG;
+    static const BigInteger MAX_SHORT;
+    static const BigInteger MIN_SHORT;
+    static const BigInteger MAX_USHORT;
+
+    /**
+     * Constructs a new big integer set to zero.
+     *
+     * @example BigInteger bi;
+     */
+    BigInteger();
+
+    /**
+     * Constructs a new big integer whose value is a copy of another big integer.
+     *
+     * @example BigInteger bi1(bi2);
+     */
+    BigInteger(const BigInteger& other) = default;
+
+    /**
+     * Constructs a new big integer that takes over the value of another
+     * big integer, leaving the other one set to zero.
+     */
+    BigInteger(BigInteger&& other) noexcept;
+
+    /**
+     * Constructs a new big integer set to the given value.
+     * The string may begin with a sign, and a base-16 number may begin
+     * with "0x".  The radix may be 2 through 36.
+     *
+     * @example BigInteger bi("1234567890123456789");
+     * @throw ErrorException if the string is not a number in the given radix
+     */
+    BigInteger(const std::string& s, int radix = 10);
+
+    /**
+     * Constructs a new big integer set to the given value.
+     *
+     * @example BigInteger bi(12345);
+     * @example BigInteger bi2(-42);
+     */
+    BigInteger(long n);
+
+    /**
+     * Returns a new BigInteger whose value is the absolute value of this one.
+     */
+    BigInteger abs() const;
+
+    /**
+     * Returns the number of bits needed to write the absolute value of
+     * this big integer in binary, not counting leading zeros.
+     * For example, 5 (binary 101) has a bit length of 3, and 0 has 0.
+     */
+    int bitLength() const;
+
+    /**
+     * Returns the greatest common divisor of this and the given other big integer.
+     * For example, gcd(24, 16) is 8.
+     */
+    BigInteger gcd(const BigInteger& other) const;
+
+    /**
+     * Returns true if this BigInteger's value is within the range of values
+     * that can be stored as an int.
+     */
+    bool isInt() const;
+
+    /**
+     * Returns true if this BigInteger's value is within the range of values
+     * that can be stored as a long.
+     */
+    bool isLong() const;
+
+    /**
+     * Returns true if this BigInteger represents a negative number < 0.
+     * You could just perform the check yourself by testing whether number > 0,
+     * but this member is faster because it doesn't need to create a temporary
+     * BigInteger instance for doing the comparison.
+     */
+    bool isNegative() const;
+
+    /**
+     * Returns true if this BigInteger represents a non-negative number >= 0.
+     * You could just perform the check yourself by testing whether number > 0,
+     * but this member is faster because it doesn't need to create a temporary
+     * BigInteger instance for doing the comparison.
+     */
+    bool isNonNegative() const;
+
+    /**
+     * Returns true if this BigInteger represents a positive number > 0.
+     * You could just perform the check yourself by testing whether number > 0,
+     * but this member is faster because it doesn't need to create a temporary
+     * BigInteger instance for doing the comparison.
+     */
+    bool isPositive() const;
+
+    /**
+     * Returns whichever is larger between this big integer and the given
+     * other big integer.
+     */
+    const BigInteger& max(const BigInteger& other) const;
+
+    /**
+     * Returns whichever is smaller between this big integer and the given
+     * other big integer.
+     */
+    const BigInteger& min(const BigInteger& other) const;
+
+    /**
+     * Returns a new BigInteger x in the range 0 .. m - 1 such that
+     * (this * x) % m is 1.
+     * @throw ErrorException if m is not positive, or if this big integer
+     *        and m have a common factor so that no such x exists.
+     */
+    BigInteger modInverse(const BigInteger& m) const;
+
+    /**
+     * Returns a new BigInteger whose value is (this ^^ exp) % m,
+     * in the range 0 .. m - 1.
+     * @throw ErrorException if exp is negative or if m is not positive.
+     */
+    BigInteger modPow(const BigInteger& exp, const BigInteger& m) const;
+
+    /**
+     * Returns a new BigInteger whose value is the value of this BigInteger
+     * raised to the given exponent.
+     * @throw ErrorException if the exponent is negative.
+     */
+    BigInteger pow(long exp) const;
+
+    /**
+     * Returns a new BigInteger whose value is the value of this BigInteger
+     * raised to the given exponent.
+     * @throw ErrorException if the exponent is negative, or if it is too
+     *        large to fit in a long and this big integer is not 0, 1, or -1.
+     */
+    BigInteger pow(const BigInteger& exp) const;
+
+    /**
+     * Returns an int representation of this BigInteger, such as
+     * -12345678.
+     * @throw ErrorException if this BigInteger is out of the range of int.
+     */
+    int toInt() const;
+
+    /**
+     * Returns a long representation of this BigInteger, such as
+     * -123456789.
+     * @throw ErrorException if this BigInteger is out of the range of long.
+     */
+    long toLong() const;
+
+    /**
+     * Returns a string representation of this BigInteger, such as
+     * "-1234567890123456789".
+     * Digits above 9 are written as lowercase letters.
+     * @throw ErrorException if the radix is not 2 through 36.
+     */
+    std::string toString(int radix = 10) const;
+
+    /**
+     * Increases the value of this BigInteger by 1 (prefix).
+     */
+    BigInteger& operator ++(); // prefix
+
+    /**
+     * Increases the value of this BigInteger by 1 (posfix).
+     */
+    BigInteger  operator ++(int); // postfix
+
+    /**
+     * Decreases the value of this BigInteger by 1 (prefix).
+     */
+    BigInteger& operator --(); // prefix
+
+    /**
+     * Decreases the value of this BigInteger by 1 (postfix).
+     */
+    BigInteger  operator --(int); // postfix
+
+    /**
+     * Assigns this BigInteger to store the sum of itself
+     * and the given other BigInteger.
+     */
+    BigInteger& operator +=(const BigInteger& b);
+
+    /**
+     * Assigns this BigInteger to store the result of subtracting
+     * the given other BigInteger from this BigInteger.
+     */
+    BigInteger& operator -=(const BigInteger& b);
+
+    /**
+     * Assigns this BigInteger to store the product of itself
+     * and the given other BigInteger.
+     */
+    BigInteger& operator *=(const BigInteger& b);
+
+    /**
+     * Assigns this BigInteger to store the quotient of dividing
+     * itself by the given other BigInteger.
+     * As with int, the quotient is rounded toward zero.
+     * @throw ErrorException if denominator is 0.
+     */
+    BigInteger& operator /=(const BigInteger& b);
+
+    /**
+     * Assigns this BigInteger to store the remainder of dividing
+     * itself by the given other BigInteger.
+     * As with int, the remainder has the same sign as this BigInteger.
+     * @throw ErrorException if denominator is 0.
+     */
+    BigInteger& operator %=(const BigInteger& b);
+
+    /**
+     * Sets this big integer to a bitwise AND between this integer and the given other integer,
+     * retaining only bits that are set in both.
+     * Negative numbers behave as if written in two's complement with
+     * infinitely many leading 1 bits.
+     */
+    BigInteger& operator &=(const BigInteger& b);
+
+    /**
+     * Sets this big integer to a bitwise OR between this integer and the given other integer,
+     * retaining bits that are set in this integer or the other integer or both.
+     * Negative numbers behave as if written in two's complement with
+     * infinitely many leading 1 bits.
+     */
+    BigInteger& operator |=(const BigInteger& b);
+
+    /**
+     * Sets this big integer to a bitwise XOR between this integer and the given other integer,
+     * retaining bits that are set in this integer or the other integer but not both.
+     * Negative numbers behave as if written in two's complement with
+     * infinitely many leading 1 bits.
+     */
+    BigInteger& operator ^=(const BigInteger& b);
+
+    /**
+     * Performs a bitwise NOT on this integer,
+     * inverting the values of all of its bits.
+     * As with int, ~x is equal to -x - 1.
+     */
+    BigInteger operator ~() const;
+
+    /**
+     * Performs a logical NOT on this integer,
+     * setting it to 0 if non-zero, or to 1 if zero.
+     */
+    BigInteger operator !() const;
+
+    /**
+     * Sets this BigInteger to store the same value as the given other big integer.
+     */
+    BigInteger& operator =(const BigInteger& other) = default;
+
+    /**
+     * Sets this BigInteger to take over the value of the given other big
+     * integer, leaving the other one set to zero.
+     */
+    BigInteger& operator =(BigInteger&& other) noexcept;
+
+    /**
+     * Unary negation; returns a new BigInteger that is
+     * the negative of this BigInteger.
+     */
+    BigInteger operator -() const;
+
+    /**
+     * Returns a new big integer whose value is equal to the value of
+     * this big integer bit-shifted left by the given number of bits.
+     * Equivalent to multiplying by 2 ^ shift.
+     */
+    BigInteger operator <<(unsigned int shift) const;
+
+    /**
+     * Modifies this big integer to be bit-shifted left by the given number of bits.
+     * Equivalent to multiplying by 2 ^ shift.
+     */
+    BigInteger& operator <<=(unsigned int shift);
+
+    /**
+     * Returns a new big integer whose value is equal to the value of
+     * this big integer bit-shifted right by the given number of bits.
+     * Equivalent to dividing by 2 ^ shift and rounding down, so that
+     * negative numbers stay negative.
+     */
+    BigInteger operator >>(unsigned int shift) const;
+
+    /**
+     * Modifies this big integer to be bit-shifted right by the given number of bits.
+     * Equivalent to dividing by 2 ^ shift and rounding down.
+     */
+    BigInteger& operator >>=(unsigned int shift);
+
+    /**
+     * Converts this BigInteger into a boolean value.
+     * The value will be false if this BigInteger stores 0, or true otherwise.
+     */
+    explicit operator bool() const;
+
+    /**
+     * Converts this BigInteger into an integer.
+     * @throw ErrorException if this big integer is not within the range of type int.
+     */
+    explicit operator int() const;
+
+    /**
+     * Converts this BigInteger into a long.
+     * @throw ErrorException if this big integer is not within the range of type long.
+     */
+    explicit operator long() const;
+
+    /**
+     * Converts this BigInteger into a string.
+     */
+    explicit operator std::string() const;
+
+private:
+    /*
+     * Constructs a new big integer with the given magnitude and sign.
+     * Leading zero limbs are removed, and zero is never negative.
+     */
+    BigInteger(std::vector<uint64_t>&& magnitude, bool negative);
+
+    /*
+     * Adds the value with the given magnitude and sign to this big integer.
+     * Used by operator += and -=.
+     */
+    void addSigned(const std::vector<uint64_t>& magnitude, bool negative);
+
+    /*
+     * Applies the given bitwise operation ('&', '|', or '^') to the two's
+     * complement forms of this big integer and the given other one.
+     */
+    void bitwise(const BigInteger& other, char op);
+
+    /*
+     * Returns a negative number, zero, or a positive number depending on
+     * whether b1 is less than, equal to, or greater than b2.
+     */
+    static int compare(const BigInteger& b1, const BigInteger& b2);
+
+    /*
+     * Divides this big integer by the given one, rounding toward zero, and
+     * stores the quotient and/or the remainder into the given pointers.
+     * The name is used in the error message if the divisor is zero.
+     */
+    void divide(const BigInteger& divisor, BigInteger* quotient, BigInteger* remainder,
+                const std::string& caller) const;
+
+    /*
+     * Sets result to the number in the given string and returns true,
+     * or returns false if the string is not a number in the given radix.
+     */
+    static bool parse(std::string_view s, int radix, BigInteger& result);
+
+    friend int hashCode(const BigInteger& b);
+    friend BigInteger operator +(const BigInteger& b1, const BigInteger& b2);
+    friend BigInteger operator -(const BigInteger& b1, const BigInteger& b2);
+    friend BigInteger operator *(const BigInteger& b1, const BigInteger& b2);
+    friend BigInteger operator /(const BigInteger& b1, const BigInteger& b2);
+    friend BigInteger operator %(const BigInteger& b1, const BigInteger& b2);
+    friend BigInteger operator &(const BigInteger& b1, const BigInteger& b2);
+    friend BigInteger operator |(const BigInteger& b1, const BigInteger& b2);
+    friend BigInteger operator ^(const BigInteger& b1, const BigInteger& b2);
+    friend bool operator ==(const BigInteger& b1, const BigInteger& b2);
+    friend bool operator !=(const BigInteger& b1, const BigInteger& b2);
+    friend bool operator >(const BigInteger& b1, const BigInteger& b2);
+    friend bool operator <(const BigInteger& b1, const BigInteger& b2);
+    friend bool operator >=(const BigInteger& b1, const BigInteger& b2);
+    friend bool operator <=(const BigInteger& b1, const BigInteger& b2);
+    friend std::istream& operator >>(std::istream& input, BigInteger& b);
+    friend std::ostream& operator <<(std::ostream& out, const BigInteger& b);
+
+    // member variables
+    std::vector<uint64_t> _magnitude;   // absolute value in base 2^64, least significant limb first,
+                                        // with no leading zero limbs (so zero is empty)
+    bool _negative;                     // true if number is negative; never true for zero
+};
+
+/**
+ * Returns a string representation of the given big integer.
+ * Equivalent to calling bi.toString().
+ * Provided for consistency with the other lib functions like integerToString.
+ */
+std::string bigIntegerToString(const BigInteger& bi, int radix = 10);
+
+/**
+ * Returns an integer hash code for the given BigInteger.
+ */
+int hashCode(const BigInteger& b);
+
+/**
+ * Returns a new BigInteger that is the sum of this BigInteger
+ * and the given other BigInteger.
+ */
+BigInteger operator +(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns a new BigInteger that is the result of subtracting
+ * the given other BigInteger from this BigInteger.
+ */
+BigInteger operator -(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns a new BigInteger that is the product of this BigInteger
+ * and the given other BigInteger.
+ */
+BigInteger operator *(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns a new BigInteger that is the quotient of dividing
+ * this BigInteger by the given other BigInteger, rounded toward zero.
+ * @throw ErrorException if denominator is 0.
+ */
+BigInteger operator /(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns a new BigInteger that is the remainder of dividing
+ * this BigInteger by the given other BigInteger.
+ * The remainder has the same sign as this BigInteger.
+ * @throw ErrorException if denominator is 0.
+ */
+BigInteger operator %(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Performs a bitwise AND between this integer and the given other integer,
+ * retaining only bits that are set in both.
+ */
+BigInteger operator &(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Performs a bitwise OR between this integer and the given other integer,
+ * retaining bits that are set in this integer or the other integer or both.
+ */
+BigInteger operator |(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Performs a bitwise XOR between this integer and the given other integer,
+ * retaining bits that are set in this integer or the other integer but not both.
+ */
+BigInteger operator ^(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns true if two BigIntegers store the same value.
+ */
+bool operator ==(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns true if two BigIntegers do not store the same value.
+ */
+bool operator !=(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns true if this BigInteger stores a larger value than the given other one.
+ */
+bool operator >(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns true if this BigInteger stores a smaller value than the given other one.
+ */
+bool operator <(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns true if this BigInteger stores a value that is
+ * greater than or equal to the given other one.
+ */
+bool operator >=(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Returns true if this BigInteger stores a value that is
+ * less than or equal to the given other one.
+ */
+bool operator <=(const BigInteger& b1, const BigInteger& b2);
+
+/**
+ * Reads a BigInteger from the given input stream.
+ * The number is read in base 16 or 8 if the stream is set to hex or oct.
+ * If the next word is not a number, sets the stream's fail bit
+ * and leaves the BigInteger unchanged.
+ */
+std::istream& operator >>(std::istream& input, BigInteger& b);
+
+/**
+ * Writes this BigInteger to the given output stream.
+ * The number is written in base 16 or 8 if the stream is set to hex or oct.
+ */
+std::ostream& operator <<(std::ostream& out, const BigInteger& b);
+
+// aliases for BigInteger for those who like abbreviations and lowercase
+typedef BigInteger BigInt;
+typedef BigInteger bigint;
+
+#endif // _biginteger_h
@@ -0,0 +1,857 @@
+/*
+ * File: diff.cpp
+ * --------------
+ * This file implements the diff.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "diff.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "strlib.h"
+
+namespace diff {
+namespace {
+/*
+ * The flags that change the text of a line, and the subset of those that
+ * require a rewritten copy rather than a trimmed view of the line.
+ */
+const int LINE_FLAGS = IGNORE_LEADING | IGNORE_TRAILING | IGNORE_WHITESPACE
+        | IGNORE_CASE | IGNORE_NUMBERS | IGNORE_NONNUMBERS | IGNORE_PUNCTUATION
+        | IGNORE_AFTERDECIMAL | IGNORE_CHARORDER;
+const int REWRITE_FLAGS = LINE_FLAGS & ~(IGNORE_LEADING | IGNORE_TRAILING);
+
+/*
+ * In histogram diff, lines that occur more often than this in a region are
+ * not used as anchors; a region with nothing rarer is passed to Myers.
+ */
+const int MAX_CHAIN_LENGTH = 64;
+
+/*
+ * The number of edits after which Myers' algorithm stops looking for the
+ * best split of a region and settles for a good one.
+ */
+const int MAX_MYERS_COST = 256;
+
+/* The characters removed by IGNORE_PUNCTUATION. */
+const char PUNCTUATION[] = ".,?!'\"()\\/#$%@^&*_[]{}|<>:;-";
+
+bool isDigit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+bool isSpace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\f' || ch == '\v';
+}
+
+bool isPunctuation(char ch) {
+    return ch != '\0' && std::strchr(PUNCTUATION, ch) != nullptr;
+}
+
+/*
+ * Implementation notes: hashLine
+ * ------------------------------
+ * Lines are hashed 8 bytes at a time, mixing each word in with a multiply
+ * and a shift.  The hash only has to spread lines over the intern table;
+ * lines with equal hashes are still compared byte by byte.
+ */
+uint64_t hashLine(std::string_view line) {
+    const uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+    uint64_t hash = line.size() * multiplier;
+    const char* data = line.data();
+    size_t length = line.size();
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+        data += 8;
+        length -= 8;
+    }
+    if (length > 0) {
+        uint64_t word = 0;
+        std::memcpy(&word, data, length);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+/*
+ * Reads a text one line at a time and normalizes each line according to
+ * the flags.  The normalized text is a view of the line itself when the
+ * flags only trim it, and otherwise a view of a buffer that is reused for
+ * the next line.
+ */
+class LineReader {
+public:
+    LineReader(std::string_view text, int flags)
+            : _text(text),
+              _flags(flags),
+              _pos(0),
+              _lineNumber(0),
+              _rewritten(false) {
+        // empty
+    }
+
+    /*
+     * Moves to the next line, skipping blank lines if IGNORE_BLANKLINES is
+     * set, and returns false at the end of the text.
+     */
+    bool next() {
+        while (_pos < _text.size()) {
+            const char* start = _text.data() + _pos;
+            const char* end = (const char*) std::memchr(start, '\n', _text.size() - _pos);
+            size_t length = end ? (size_t) (end - start) : _text.size() - _pos;
+            _pos += length + 1;
+            _lineNumber++;
+            if (length > 0 && start[length - 1] == '\r') {
+                length--;
+            }
+            _raw = std::string_view(start, length);
+            normalize();
+            if (!(_flags & IGNORE_BLANKLINES) || !_normalized.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* The line number, counting from 1, of the current line. */
+    int lineNumber() const {
+        return _lineNumber;
+    }
+
+    std::string_view normalized() const {
+        return _normalized;
+    }
+
+    std::string_view raw() const {
+        return _raw;
+    }
+
+    /* Whether normalized() refers to the buffer rather than to the text. */
+    bool rewritten() const {
+        return _rewritten;
+    }
+
+private:
+    void normalize();
+
+    std::string_view _text;
+    int _flags;
+    size_t _pos;
+    int _lineNumber;
+    std::string_view _raw;
+    std::string_view _normalized;
+    std::string _buffer;
+    bool _rewritten;
+};
+
+/*
+ * Implementation notes: normalize
+ * -------------------------------
+ * Trimming only narrows the view of the line.  The other flags are applied
+ * in a single pass into _buffer: runs of digits after a '.' become "#"
+ * for IGNORE_AFTERDECIMAL and other runs of digits become "#" for
+ * IGNORE_NUMBERS, and for IGNORE_NONNUMBERS each run of other characters
+ * becomes one space.  The remaining characters are dropped or lowercased
+ * as the flags say.
+ */
+void LineReader::normalize() {
+    std::string_view line = _raw;
+    _rewritten = false;
+    if (!(_flags & LINE_FLAGS)) {
+        _normalized = line;
+        return;
+    }
+    if (_flags & (IGNORE_LEADING | IGNORE_WHITESPACE)) {
+        while (!line.empty() && isSpace(line.front())) {
+            line.remove_prefix(1);
+        }
+    }
+    if (_flags & (IGNORE_TRAILING | IGNORE_WHITESPACE)) {
+        while (!line.empty() && isSpace(line.back())) {
+            line.remove_suffix(1);
+        }
+    }
+    if (!(_flags & REWRITE_FLAGS)) {
+        _normalized = line;
+        return;
+    }
+
+    _buffer.clear();
+    bool inNonNumber = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char ch = line[i];
+        if ((_flags & IGNORE_AFTERDECIMAL) && ch == '.'
+                && i + 1 < line.size() && isDigit(line[i + 1])) {
+            _buffer += ".#";
+            while (i + 1 < line.size() && isDigit(line[i + 1])) {
+                i++;
+            }
+            inNonNumber = false;
+            continue;
+        }
+        if (isDigit(ch)) {
+            if (_flags & IGNORE_NUMBERS) {
+                _buffer += '#';
+                while (i + 1 < line.size() && isDigit(line[i + 1])) {
+                    i++;
+                }
+            } else {
+                _buffer += ch;
+            }
+            inNonNumber = false;
+            continue;
+        }
+        if (_flags & IGNORE_NONNUMBERS) {
+            if (!inNonNumber) {
+                _buffer += ' ';
+                inNonNumber = true;
+            }
+            continue;
+        }
+        if ((_flags & IGNORE_WHITESPACE) && isSpace(ch)) {
+            continue;
+        }
+        if ((_flags & IGNORE_PUNCTUATION) && isPunctuation(ch)) {
+            continue;
+        }
+        if ((_flags & IGNORE_CASE) && ch >= 'A' && ch <= 'Z') {
+            ch = (char) (ch - 'A' + 'a');
+        }
+        _buffer += ch;
+    }
+    if (_flags & IGNORE_CHARORDER) {
+        std::sort(_buffer.begin(), _buffer.end());
+    }
+    _normalized = _buffer;
+    _rewritten = true;
+}
+
+/*
+ * Maps each distinct normalized line to a small integer, so that the diff
+ * algorithms compare lines with a single integer comparison.  Lines that
+ * are views of the input are stored as views; rewritten lines are copied.
+ */
+class Interner {
+public:
+    Interner()
+            : _table(1024, Entry {0, -1}) {
+        // empty
+    }
+
+    int intern(std::string_view text, bool copy) {
+        uint64_t hash = hashLine(text);
+        size_t mask = _table.size() - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            Entry& entry = _table[i];
+            if (entry.id < 0) {
+                if (copy) {
+                    _copies.emplace_back(text);
+                    text = _copies.back();
+                }
+                entry = Entry {hash, (int) _texts.size()};
+                _texts.push_back(text);
+                if (_texts.size() * 2 > _table.size()) {
+                    grow();
+                }
+                return (int) _texts.size() - 1;
+            }
+            if (entry.hash == hash && _texts[entry.id] == text) {
+                return entry.id;
+            }
+        }
+    }
+
+    int size() const {
+        return (int) _texts.size();
+    }
+
+    std::string_view text(int id) const {
+        return _texts[id];
+    }
+
+private:
+    struct Entry {
+        uint64_t hash;
+        int id;
+    };
+
+    void grow() {
+        std::vector<Entry> old(_table.size() * 2, Entry {0, -1});
+        old.swap(_table);
+        size_t mask = _table.size() - 1;
+        for (const Entry& entry : old) {
+            if (entry.id >= 0) {
+                size_t i = entry.hash & mask;
+                while (_table[i].id >= 0) {
+                    i = (i + 1) & mask;
+                }
+                _table[i] = entry;
+            }
+        }
+    }
+
+    std::vector<Entry> _table;
+    std::vector<std::string_view> _texts;
+    std::deque<std::string> _copies;
+};
+
+/*
+ * The lines of one text that take part in the comparison: the interned
+ * id of each, its original text and line number, and whether the diff
+ * marked it as changed.
+ */
+struct Side {
+    std::vector<int> ids;
+    std::vector<std::string_view> lines;
+    std::vector<int> numbers;
+    std::vector<char> changed;
+    int lineCount = 0;
+};
+
+void readSide(Side& side, std::string_view text, int flags, Interner& interner) {
+    LineReader reader(text, flags);
+    while (reader.next()) {
+        side.ids.push_back(interner.intern(reader.normalized(), reader.rewritten()));
+        side.lines.push_back(reader.raw());
+        side.numbers.push_back(reader.lineNumber());
+    }
+    side.lineCount = reader.lineNumber();
+    if (flags & IGNORE_TRAILING) {
+        while (!side.ids.empty() && interner.text(side.ids.back()).empty()) {
+            side.ids.pop_back();
+            side.lines.pop_back();
+            side.numbers.pop_back();
+        }
+    }
+    if (flags & IGNORE_LINEORDER) {
+        std::vector<int> order(side.ids.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = (int) i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int i, int j) {
+            return interner.text(side.ids[i]) < interner.text(side.ids[j]);
+        });
+        Side sorted;
+        for (size_t i = 0; i < order.size(); i++) {
+            sorted.ids.push_back(side.ids[order[i]]);
+            sorted.lines.push_back(side.lines[order[i]]);
+            sorted.numbers.push_back((int) i + 1);
+        }
+        sorted.lineCount = (int) order.size();
+        side = std::move(sorted);
+    }
+    side.changed.assign(side.ids.size(), 0);
+}
+
+/*
+ * Marks the lines of two sides that are not part of a common subsequence,
+ * using Myers' algorithm or histogram diff.
+ */
+class Differ {
+public:
+    Differ(Side& side1, Side& side2, int idCount)
+            : _a(side1.ids.data()),
+              _b(side2.ids.data()),
+              _changed1(side1.changed.data()),
+              _changed2(side2.changed.data()),
+              _n1((int) side1.ids.size()),
+              _n2((int) side2.ids.size()),
+              _idCount(idCount) {
+        // empty
+    }
+
+    void histogram(int a0, int a1, int b0, int b1);
+    void myers(int xoff, int xlim, int yoff, int ylim);
+
+private:
+    struct Region {
+        int a0, a1, b0, b1;
+    };
+
+    enum LcsResult {
+        FOUND, NO_COMMON_LINES, TOO_COMMON
+    };
+
+    LcsResult findLcs(const Region& region, Region& lcs);
+    void mark(int a0, int a1, int b0, int b1);
+    void split(int xoff, int xlim, int yoff, int ylim, int& xmid, int& ymid);
+
+    const int* _a;
+    const int* _b;
+    char* _changed1;
+    char* _changed2;
+    int _n1;
+    int _n2;
+    int _idCount;
+
+    /* Diagonal vectors for Myers, indexed from -(_n2 + 1) through _n1 + 1. */
+    std::vector<int> _forward;
+    std::vector<int> _backward;
+
+    /* Occurrence counts and chains for histogram diff. */
+    std::vector<int> _count;
+    std::vector<int> _head;
+    std::vector<int> _next;
+};
+
+void Differ::mark(int a0, int a1, int b0, int b1) {
+    std::fill(_changed1 + a0, _changed1 + a1, 1);
+    std::fill(_changed2 + b0, _changed2 + b1, 1);
+}
+
+/*
+ * Implementation notes: histogram
+ * -------------------------------
+ * Histogram diff, as in JGit and Git, finds a longest run of common lines
+ * built around the line with the fewest occurrences in the first text,
+ * keeps it, and compares the regions before and after it the same way.
+ * The regions are kept on an explicit stack so that long inputs cannot
+ * exhaust the call stack.
+ */
+void Differ::histogram(int a0, int a1, int b0, int b1) {
+    if (_count.empty()) {
+        _count.assign(_idCount, 0);
+        _head.assign(_idCount, -1);
+        _next.assign(_n1, -1);
+    }
+    std::vector<Region> stack {Region {a0, a1, b0, b1}};
+    while (!stack.empty()) {
+        Region region = stack.back();
+        stack.pop_back();
+        while (region.a0 < region.a1 && region.b0 < region.b1 && _a[region.a0] == _b[region.b0]) {
+            region.a0++;
+            region.b0++;
+        }
+        while (region.a0 < region.a1 && region.b0 < region.b1 && _a[region.a1 - 1] == _b[region.b1 - 1]) {
+            region.a1--;
+            region.b1--;
+        }
+        if (region.a0 == region.a1 || region.b0 == region.b1) {
+            mark(region.a0, region.a1, region.b0, region.b1);
+            continue;
+        }
+        Region lcs;
+        LcsResult result = findLcs(region, lcs);
+        if (result == TOO_COMMON) {
+            myers(region.a0, region.a1, region.b0, region.b1);
+        } else if (result == NO_COMMON_LINES) {
+            mark(region.a0, region.a1, region.b0, region.b1);
+        } else {
+            stack.push_back(Region {lcs.a1, region.a1, lcs.b1, region.b1});
+            stack.push_back(Region {region.a0, lcs.a0, region.b0, lcs.b0});
+        }
+    }
+}
+
+Differ::LcsResult Differ::findLcs(const Region& region, Region& lcs) {
+    for (int i = region.a1 - 1; i >= region.a0; i--) {
+        int id = _a[i];
+        _next[i] = _count[id] > 0 ? _head[id] : -1;
+        _head[id] = i;
+        _count[id]++;
+    }
+
+    bool found = false;
+    bool tooCommon = false;
+    int bestCount = MAX_CHAIN_LENGTH + 1;
+    int bestLength = 0;
+    for (int bi = region.b0; bi < region.b1; ) {
+        int id = _b[bi];
+        int count = _count[id];
+        if (count == 0 || count > bestCount) {
+            tooCommon |= count > MAX_CHAIN_LENGTH;
+            bi++;
+            continue;
+        }
+        int nextB = bi + 1;
+        for (int ai = _head[id]; ai >= 0; ai = _next[ai]) {
+            int rarest = count;
+            int as = ai;
+            int bs = bi;
+            while (as > region.a0 && bs > region.b0 && _a[as - 1] == _b[bs - 1]) {
+                as--;
+                bs--;
+                rarest = std::min(rarest, _count[_a[as]]);
+            }
+            int ae = ai + 1;
+            int be = bi + 1;
+            while (ae < region.a1 && be < region.b1 && _a[ae] == _b[be]) {
+                rarest = std::min(rarest, _count[_a[ae]]);
+                ae++;
+                be++;
+            }
+            nextB = std::max(nextB, be);
+            if (rarest < bestCount || (rarest == bestCount && ae - as > bestLength)) {
+                lcs = Region {as, ae, bs, be};
+                bestCount = rarest;
+                bestLength = ae - as;
+                found = true;
+            }
+        }
+        bi = nextB;
+    }
+
+    for (int i = region.a0; i < region.a1; i++) {
+        _count[_a[i]] = 0;
+    }
+    return found ? FOUND : tooCommon ? TOO_COMMON : NO_COMMON_LINES;
+}
+
+/*
+ * Implementation notes: myers
+ * ---------------------------
+ * This is the linear-space form of Myers' algorithm, as in GNU diff: split
+ * finds a point on a shortest edit path through the middle of the region,
+ * and the two halves are compared in turn.  Common lines at either end of
+ * a region are skipped before it is split.
+ */
+void Differ::myers(int xoff, int xlim, int yoff, int ylim) {
+    if (_forward.empty()) {
+        _forward.assign(_n1 + _n2 + 3, 0);
+        _backward.assign(_n1 + _n2 + 3, 0);
+    }
+    while (true) {
+        while (xoff < xlim && yoff < ylim && _a[xoff] == _b[yoff]) {
+            xoff++;
+            yoff++;
+        }
+        while (xoff < xlim && yoff < ylim && _a[xlim - 1] == _b[ylim - 1]) {
+            xlim--;
+            ylim--;
+        }
+        if (xoff == xlim || yoff == ylim) {
+            mark(xoff, xlim, yoff, ylim);
+            return;
+        }
+        int xmid;
+        int ymid;
+        split(xoff, xlim, yoff, ylim, xmid, ymid);
+        myers(xoff, xmid, yoff, ymid);
+        xoff = xmid;
+        yoff = ymid;
+    }
+}
+
+/*
+ * Implementation notes: split
+ * ---------------------------
+ * The search runs forward from (xoff, yoff) and backward from (xlim, ylim)
+ * one edit at a time, recording for each diagonal k = x - y the furthest
+ * x reached, until the two searches overlap.  When the number of edits
+ * passes MAX_MYERS_COST, the search stops and splits at whichever search has
+ * made the most progress, which bounds the time spent on very different
+ * inputs at the cost of a diff that may not be minimal.
+ */
+void Differ::split(int xoff, int xlim, int yoff, int ylim, int& xmid, int& ymid) {
+    int* fd = _forward.data() + _n2 + 1;
+    int* bd = _backward.data() + _n2 + 1;
+    const int dmin = xoff - ylim;
+    const int dmax = xlim - yoff;
+    const int fmid = xoff - yoff;
+    const int bmid = xlim - ylim;
+    int fmin = fmid, fmax = fmid;
+    int bmin = bmid, bmax = bmid;
+    const bool odd = ((fmid - bmid) & 1) != 0;
+    fd[fmid] = xoff;
+    bd[bmid] = xlim;
+
+    for (int cost = 1; ; cost++) {
+        if (fmin > dmin) {
+            fd[--fmin - 1] = -1;
+        } else {
+            ++fmin;
+        }
+        if (fmax < dmax) {
+            fd[++fmax + 1] = -1;
+        } else {
+            --fmax;
+        }
+        for (int d = fmax; d >= fmin; d -= 2) {
+            int x = fd[d - 1] >= fd[d + 1] ? fd[d - 1] + 1 : fd[d + 1];
+            int y = x - d;
+            while (x < xlim && y < ylim && _a[x] == _b[y]) {
+                x++;
+                y++;
+            }
+            fd[d] = x;
+            if (odd && bmin <= d && d <= bmax && bd[d] <= x) {
+                xmid = x;
+                ymid = y;
+                return;
+            }
+        }
+
+        if (bmin > dmin) {
+            bd[--bmin - 1] = INT_MAX;
+        } else {
+            ++bmin;
+        }
+        if (bmax < dmax) {
+            bd[++bmax + 1] = INT_MAX;
+        } else {
+            --bmax;
+        }
+        for (int d = bmax; d >= bmin; d -= 2) {
+            int x = bd[d - 1] < bd[d + 1] ? bd[d - 1] : bd[d + 1] - 1;
+            int y = x - d;
+            while (x > xoff && y > yoff && _a[x - 1] == _b[y - 1]) {
+                x--;
+                y--;
+            }
+            bd[d] = x;
+            if (!odd && fmin <= d && d <= fmax && x <= fd[d]) {
+                xmid = x;
+                ymid = y;
+                return;
+            }
+        }
+
+        if (cost >= MAX_MYERS_COST) {
+            int fxybest = -1;
+            int fxbest = xoff;
+            for (int d = fmax; d >= fmin; d -= 2) {
+                int x = std::min(fd[d], xlim);
+                int y = x - d;
+                if (y > ylim) {
+                    x = ylim + d;
+                    y = ylim;
+                }
+                if (x + y > fxybest) {
+                    fxybest = x + y;
+                    fxbest = x;
+                }
+            }
+            int bxybest = INT_MAX;
+            int bxbest = xlim;
+            for (int d = bmax; d >= bmin; d -= 2) {
+                int x = std::max(xoff, bd[d]);
+                int y = x - d;
+                if (y < yoff) {
+                    x = yoff + d;
+                    y = yoff;
+                }
+                if (x + y < bxybest) {
+                    bxybest = x + y;
+                    bxbest = x;
+                }
+            }
+            if ((xlim + ylim) - bxybest < fxybest - (xoff + yoff)) {
+                xmid = fxbest;
+                ymid = fxybest - fxbest;
+            } else {
+                xmid = bxbest;
+                ymid = bxybest - bxbest;
+            }
+            /* Only split at a point that makes progress on both halves. */
+            bool atStart = xmid == xoff && ymid == yoff;
+            bool atEnd = xmid == xlim && ymid == ylim;
+            if (!atStart && !atEnd) {
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Compares two texts and returns the differing regions as indexes into
+ * the lines of each side.
+ */
+std::vector<DiffHunk> compareSides(Side& side1, Side& side2, int idCount, DiffAlgorithm algorithm) {
+    Differ differ(side1, side2, idCount);
+    int n1 = (int) side1.ids.size();
+    int n2 = (int) side2.ids.size();
+    if (algorithm == DIFF_MYERS) {
+        differ.myers(0, n1, 0, n2);
+    } else {
+        differ.histogram(0, n1, 0, n2);
+    }
+
+    std::vector<DiffHunk> hunks;
+    int i = 0;
+    int j = 0;
+    while (i < n1 || j < n2) {
+        if (i < n1 && j < n2 && !side1.changed[i] && !side2.changed[j]) {
+            i++;
+            j++;
+            continue;
+        }
+        DiffHunk hunk {i, i, j, j};
+        while (i < n1 && side1.changed[i]) {
+            i++;
+        }
+        while (j < n2 && side2.changed[j]) {
+            j++;
+        }
+        hunk.end1 = i;
+        hunk.end2 = j;
+        hunks.push_back(hunk);
+    }
+    return hunks;
+}
+
+/*
+ * Converts a range of indexes into the lines of a side into a range of
+ * line numbers counting from 0.  An empty range sits just before the
+ * line at its index.
+ */
+void toLineRange(const Side& side, int start, int end, int& first, int& last) {
+    if (start < end) {
+        first = side.numbers[start] - 1;
+        last = side.numbers[end - 1];
+    } else {
+        first = last = start < (int) side.numbers.size() ? side.numbers[start] - 1
+                                                          : side.lineCount;
+    }
+}
+
+std::string describeLines(const Side& side, int start, int end) {
+    std::string str = std::to_string(side.numbers[start]);
+    if (end - start > 1) {
+        str += "-" + std::to_string(side.numbers[end - 1]);
+    }
+    return str;
+}
+
+void appendLines(std::string& out, const char* prefix, const Side& side, int start, int end) {
+    for (int i = start; i < end; i++) {
+        out += '\n';
+        out += prefix;
+        out.append(side.lines[i].data(), side.lines[i].size());
+    }
+}
+
+/*
+ * Implementation notes: formatReport
+ * ----------------------------------
+ * Each region is described by a header such as "Lines 3-4 changed to
+ * student lines 3-6", followed by the expected lines prefixed with
+ * "EXPECTED < " and the student's lines prefixed with "STUDENT  > ", the
+ * same layout as the old library's reports.
+ */
+std::string formatReport(const Side& side1, const Side& side2, const std::vector<DiffHunk>& hunks) {
+    std::string out;
+    for (const DiffHunk& hunk : hunks) {
+        if (!out.empty()) {
+            out += "\n\n";
+        }
+        int count1 = hunk.end1 - hunk.start1;
+        int count2 = hunk.end2 - hunk.start2;
+        if (count2 == 0) {
+            int near = hunk.start2 < (int) side2.numbers.size() ? side2.numbers[hunk.start2]
+                     : side2.numbers.empty() ? 1 : side2.numbers.back();
+            out += (count1 > 1 ? "Lines " : "Line ") + describeLines(side1, hunk.start1, hunk.end1)
+                    + " deleted near student line " + std::to_string(near);
+        } else if (count1 == 0) {
+            out += (count2 > 1 ? "Student lines " : "Student line ")
+                    + describeLines(side2, hunk.start2, hunk.end2)
+                    + (hunk.start1 == 0 ? std::string(" added before line 1")
+                                        : " added after line " + std::to_string(side1.numbers[hunk.start1 - 1]));
+        } else {
+            std::string lines1 = describeLines(side1, hunk.start1, hunk.end1);
+            std::string lines2 = describeLines(side2, hunk.start2, hunk.end2);
+            out += (count1 > 1 ? "Lines " : "Line ") + lines1;
+            if (lines1 == lines2) {
+                out += count1 > 1 ? " do not match" : " does not match";
+            } else {
+                out += (count2 > 1 ? " changed to student lines " : " changed to student line ") + lines2;
+            }
+        }
+        appendLines(out, "EXPECTED < ", side1, hunk.start1, hunk.end1);
+        appendLines(out, "STUDENT  > ", side2, hunk.start2, hunk.end2);
+    }
+    return out;
+}
+
+/*
+ * Returns true if the rest of the reader's lines are blank after
+ * normalization.
+ */
+bool restIsBlank(LineReader& reader) {
+    do {
+        if (!reader.normalized().empty()) {
+            return false;
+        }
+    } while (reader.next());
+    return true;
+}
+} // namespace
+
+std::string diff(std::string_view s1, std::string_view s2, int flags, DiffAlgorithm algorithm) {
+    if ((flags & IGNORE_EVERYTHING) || s1 == s2) {
+        return NO_DIFFS_MESSAGE;
+    }
+    Interner interner;
+    Side side1;
+    Side side2;
+    readSide(side1, s1, flags, interner);
+    readSide(side2, s2, flags, interner);
+    std::vector<DiffHunk> hunks = compareSides(side1, side2, interner.size(), algorithm);
+    return hunks.empty() ? NO_DIFFS_MESSAGE : formatReport(side1, side2, hunks);
+}
+
+Vector<DiffHunk> diffHunks(std::string_view s1, std::string_view s2, int flags, DiffAlgorithm algorithm) {
+    Vector<DiffHunk> result;
+    if ((flags & IGNORE_EVERYTHING) || s1 == s2) {
+        return result;
+    }
+    Interner interner;
+    Side side1;
+    Side side2;
+    readSide(side1, s1, flags, interner);
+    readSide(side2, s2, flags, interner);
+    for (const DiffHunk& hunk : compareSides(side1, side2, interner.size(), algorithm)) {
+        DiffHunk lines;
+        toLineRange(side1, hunk.start1, hunk.end1, lines.start1, lines.end1);
+        toLineRange(side2, hunk.start2, hunk.end2, lines.start2, lines.end2);
+        result.add(lines);
+    }
+    return result;
+}
+
+/*
+ * Implementation notes: diffPass
+ * ------------------------------
+ * The texts match exactly when their normalized lines are equal one for
+ * one, so diffPass compares them as it reads them and stops at the first
+ * mismatch, without interning or aligning anything.  Only
+ * IGNORE_LINEORDER needs to see every line first, so it goes through the
+ * full comparison.
+ */
+bool diffPass(std::string_view s1, std::string_view s2, int flags) {
+    if ((flags & IGNORE_EVERYTHING) || s1 == s2) {
+        return true;
+    }
+    if (flags & IGNORE_LINEORDER) {
+        return diffHunks(s1, s2, flags).isEmpty();
+    }
+    LineReader reader1(s1, flags);
+    LineReader reader2(s2, flags);
+    while (true) {
+        bool more1 = reader1.next();
+        bool more2 = reader2.next();
+        if (!more1 || !more2) {
+            if (more1 == more2) {
+                return true;
+            }
+            return (flags & IGNORE_TRAILING) && restIsBlank(more1 ? reader1 : reader2);
+        }
+        if (reader1.normalized() != reader2.normalized()) {
+            return false;
+        }
+    }
+}
+
+bool isDiffMatch(const std::string& diffs) {
+    return trim(diffs) == NO_DIFFS_MESSAGE;
+}
+} // namespace diff
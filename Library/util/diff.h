@@ -0,0 +1,126 @@
+/*
+ * File: diff.h
+ * ------------
+ * This file contains declarations of functions that perform a text 'diff'
+ * operation to compare two strings line by line and report the differences,
+ * as used to compare a program's output against the expected output.
+ *
+ * Each line is normalized according to the flags, hashed, and interned to
+ * an integer, so the diff algorithms only ever compare integers.  Two
+ * algorithms are available: Myers' O(ND) algorithm in linear space, which
+ * finds a smallest set of changed lines, and histogram diff, which anchors
+ * the comparison on lines that occur rarely and tends to produce more
+ * readable reports for program output.
+ *
+ * @version 2026/10/19
+ * - initial version, replacing the quadratic diff in the old library with
+ *   Myers and histogram diff over interned lines
+ */
+
+#ifndef _diff_h
+#define _diff_h
+
+#include <string>
+#include <string_view>
+
+#include "vector.h"
+
+namespace diff {
+/**
+ * The report returned by diff when the two texts match.
+ */
+const std::string NO_DIFFS_MESSAGE = "No differences found";
+
+/**
+ * Flags that make the comparison ignore some kinds of differences.
+ * They can be combined with the | operator.
+ *
+ * IGNORE_LEADING and IGNORE_TRAILING ignore whitespace at the start or end
+ * of each line; IGNORE_TRAILING also ignores blank lines at the end of
+ * either text.  IGNORE_WHITESPACE ignores all whitespace in a line.
+ * IGNORE_BLANKLINES skips lines that are empty after the other flags are
+ * applied.  IGNORE_NUMBERS treats every run of digits as the same number,
+ * and IGNORE_NONNUMBERS compares only the runs of digits.
+ * IGNORE_AFTERDECIMAL ignores the digits after a decimal point.
+ * IGNORE_CHARORDER ignores the order of the characters in a line, and
+ * IGNORE_LINEORDER the order of the lines; with IGNORE_LINEORDER, the line
+ * numbers in a report refer to the lines in sorted order.
+ * IGNORE_EVERYTHING makes any two texts match.
+ */
+enum DiffFlags {
+    IGNORE_NONE         = 0x0,
+    IGNORE_LEADING      = 0x1,
+    IGNORE_TRAILING     = 0x2,
+    IGNORE_WHITESPACE   = 0x4,
+    IGNORE_BLANKLINES   = 0x8,
+    IGNORE_CASE         = 0x10,
+    IGNORE_NUMBERS      = 0x20,
+    IGNORE_NONNUMBERS   = 0x40,
+    IGNORE_PUNCTUATION  = 0x80,
+    IGNORE_AFTERDECIMAL = 0x100,
+    IGNORE_CHARORDER    = 0x200,
+    IGNORE_LINEORDER    = 0x400,
+    IGNORE_EVERYTHING   = 0x100000
+};
+
+const int DIFF_STRICT_FLAGS = IGNORE_TRAILING;
+const int DIFF_DEFAULT_FLAGS = IGNORE_CASE | IGNORE_TRAILING | IGNORE_WHITESPACE | IGNORE_PUNCTUATION;
+
+/**
+ * The algorithm used to line up the two texts.
+ *
+ * DIFF_HISTOGRAM matches the rarest common lines first and falls back on
+ * DIFF_MYERS for regions where every line is very common.  DIFF_MYERS
+ * finds a smallest set of changed lines, except that on very different
+ * inputs it settles for a slightly larger one to bound its running time.
+ */
+enum DiffAlgorithm {
+    DIFF_HISTOGRAM,
+    DIFF_MYERS
+};
+
+/**
+ * One region of difference between two texts.  Lines start1 through
+ * end1 - 1 of the first text were replaced by lines start2 through
+ * end2 - 1 of the second, counting lines from 0.  A pure insertion has
+ * start1 == end1, and a pure deletion has start2 == end2.
+ */
+struct DiffHunk {
+    int start1;
+    int end1;
+    int start2;
+    int end2;
+};
+
+/**
+ * Compares the expected output s1 with the student output s2 and returns
+ * a printable report of the lines that differ, or NO_DIFFS_MESSAGE if
+ * there are none.  A line ends at '\n', and a '\r' just before the '\n'
+ * is ignored.
+ */
+std::string diff(std::string_view s1, std::string_view s2,
+                 int flags = DIFF_DEFAULT_FLAGS,
+                 DiffAlgorithm algorithm = DIFF_HISTOGRAM);
+
+/**
+ * Compares two texts as diff does and returns the regions that differ,
+ * in order.  The list is empty if the texts match.
+ */
+Vector<DiffHunk> diffHunks(std::string_view s1, std::string_view s2,
+                           int flags = DIFF_DEFAULT_FLAGS,
+                           DiffAlgorithm algorithm = DIFF_HISTOGRAM);
+
+/**
+ * Returns true if the two texts match under the given flags.
+ * This compares the texts a line at a time and stops at the first line
+ * that differs, without building a report.
+ */
+bool diffPass(std::string_view s1, std::string_view s2, int flags = DIFF_DEFAULT_FLAGS);
+
+/**
+ * Returns true if the given report from diff says there are no differences.
+ */
+bool isDiffMatch(const std::string& diffs);
+} // namespace diff
+
+#endif // _diff_h
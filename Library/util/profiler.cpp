@@ -0,0 +1,250 @@
+/*
+ * File: profiler.cpp
+ * ------------------
+ * This file implements the profiler.h interface.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#include "profiler.h"
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "private/static.h"
+
+namespace {
+struct ZoneStats {
+    long long count = 0;
+    long long totalNanos = 0;
+    long long minNanos = LLONG_MAX;
+    long long maxNanos = 0;
+};
+
+struct TraceEvent {
+    int zone;
+    long long startNanos;
+    long long durationNanos;
+};
+
+/*
+ * Each thread that enters a zone gets its own ThreadProfile, so recording
+ * never contends with other threads.  The per-thread lock is only contended
+ * while a report is being generated.  Profiles are owned by the global
+ * registry rather than the thread so that data survives the thread's exit.
+ */
+struct ThreadProfile {
+    int index = 0;
+    std::mutex lock;
+    std::vector<ZoneStats> zones;
+    std::vector<TraceEvent> events;
+    long long droppedEvents = 0;
+};
+}
+
+STATIC_VARIABLE_DECLARE_BLANK(std::mutex, registryLock)
+STATIC_VARIABLE_DECLARE_BLANK(std::vector<std::string>, zoneNames)
+STATIC_VARIABLE_DECLARE_BLANK(std::vector<std::shared_ptr<ThreadProfile>>, threadProfiles)
+
+std::atomic<bool> Profiler::_enabled(false);
+static std::atomic<bool> s_recordTrace(false);
+static std::atomic<int> s_maxTraceEvents(0);
+static std::atomic<long long> s_epochNanos(0);
+static thread_local ThreadProfile* s_currentProfile = nullptr;
+
+static ThreadProfile* currentThreadProfile() {
+    if (!s_currentProfile) {
+        std::shared_ptr<ThreadProfile> profile = std::make_shared<ThreadProfile>();
+        std::lock_guard<std::mutex> guard(STATIC_VARIABLE(registryLock));
+        profile->index = int(STATIC_VARIABLE(threadProfiles).size());
+        STATIC_VARIABLE(threadProfiles).push_back(profile);
+        s_currentProfile = profile.get();
+    }
+    return s_currentProfile;
+}
+
+/*
+ * Takes a consistent snapshot of every thread's stats, indexed [thread][zone].
+ * Caller must hold the registry lock.
+ */
+static std::vector<std::vector<ZoneStats>> snapshotZones() {
+    std::vector<std::vector<ZoneStats>> result;
+    for (const std::shared_ptr<ThreadProfile>& profile : STATIC_VARIABLE(threadProfiles)) {
+        std::lock_guard<std::mutex> guard(profile->lock);
+        result.push_back(profile->zones);
+    }
+    return result;
+}
+
+static std::string jsonEscape(const std::string& s) {
+    std::string result;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            result += '\\';
+            result += ch;
+        } else if ((unsigned char) ch < 0x20) {
+            result += ' ';
+        } else {
+            result += ch;
+        }
+    }
+    return result;
+}
+
+void Profiler::enable(bool recordTrace, int maxTraceEvents) {
+    long long unset = 0;
+    s_epochNanos.compare_exchange_strong(unset, Timer::currentTimeNanos());
+    s_maxTraceEvents = std::max(0, maxTraceEvents);
+    s_recordTrace = recordTrace;
+    _enabled = true;
+}
+
+void Profiler::disable() {
+    _enabled = false;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> guard(STATIC_VARIABLE(registryLock));
+    for (const std::shared_ptr<ThreadProfile>& profile : STATIC_VARIABLE(threadProfiles)) {
+        std::lock_guard<std::mutex> profileGuard(profile->lock);
+        profile->zones.clear();
+        profile->events.clear();
+        profile->droppedEvents = 0;
+    }
+    s_epochNanos = Timer::currentTimeNanos();
+}
+
+int Profiler::registerZone(const char* name) {
+    std::lock_guard<std::mutex> guard(STATIC_VARIABLE(registryLock));
+    std::vector<std::string>& names = STATIC_VARIABLE(zoneNames);
+    for (int i = 0; i < int(names.size()); i++) {
+        if (names[i] == name) {
+            return i;
+        }
+    }
+    names.push_back(name);
+    return int(names.size()) - 1;
+}
+
+void Profiler::recordZone(int zone, long long startNanos, long long endNanos) {
+    ThreadProfile* profile = currentThreadProfile();
+    long long nanos = endNanos - startNanos;
+    std::lock_guard<std::mutex> guard(profile->lock);
+    if (zone >= int(profile->zones.size())) {
+        profile->zones.resize(zone + 1);
+    }
+    ZoneStats& stats = profile->zones[zone];
+    stats.count++;
+    stats.totalNanos += nanos;
+    stats.minNanos = std::min(stats.minNanos, nanos);
+    stats.maxNanos = std::max(stats.maxNanos, nanos);
+    if (s_recordTrace.load(std::memory_order_relaxed)) {
+        if (int(profile->events.size()) < s_maxTraceEvents.load(std::memory_order_relaxed)) {
+            profile->events.push_back({zone, startNanos, nanos});
+        } else {
+            profile->droppedEvents++;
+        }
+    }
+}
+
+void Profiler::report(std::ostream& out) {
+    std::lock_guard<std::mutex> guard(STATIC_VARIABLE(registryLock));
+    const std::vector<std::string>& names = STATIC_VARIABLE(zoneNames);
+    std::vector<std::vector<ZoneStats>> threads = snapshotZones();
+
+    // list zones in order of decreasing total time over all threads
+    std::vector<long long> zoneTotals(names.size(), 0);
+    std::vector<int> order;
+    for (int zone = 0; zone < int(names.size()); zone++) {
+        for (const std::vector<ZoneStats>& zones : threads) {
+            if (zone < int(zones.size())) {
+                zoneTotals[zone] += zones[zone].totalNanos;
+            }
+        }
+        order.push_back(zone);
+    }
+    std::stable_sort(order.begin(), order.end(), [&zoneTotals](int a, int b) {
+        return zoneTotals[a] > zoneTotals[b];
+    });
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::left << std::setw(32) << "zone" << std::right
+        << std::setw(8) << "thread"
+        << std::setw(12) << "calls"
+        << std::setw(14) << "total ms"
+        << std::setw(12) << "mean us"
+        << std::setw(12) << "min us"
+        << std::setw(12) << "max us" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for (int zone : order) {
+        for (int t = 0; t < int(threads.size()); t++) {
+            if (zone >= int(threads[t].size()) || threads[t][zone].count == 0) {
+                continue;
+            }
+            const ZoneStats& stats = threads[t][zone];
+            out << std::left << std::setw(32) << names[zone] << std::right
+                << std::setw(8) << t
+                << std::setw(12) << stats.count
+                << std::setw(14) << stats.totalNanos / 1e6
+                << std::setw(12) << stats.totalNanos / 1e3 / stats.count
+                << std::setw(12) << stats.minNanos / 1e3
+                << std::setw(12) << stats.maxNanos / 1e3 << std::endl;
+        }
+    }
+    out.flags(flags);
+}
+
+void Profiler::writeChromeTrace(std::ostream& out) {
+    std::lock_guard<std::mutex> guard(STATIC_VARIABLE(registryLock));
+    const std::vector<std::string>& names = STATIC_VARIABLE(zoneNames);
+    long long epoch = s_epochNanos;
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const std::shared_ptr<ThreadProfile>& profile : STATIC_VARIABLE(threadProfiles)) {
+        std::lock_guard<std::mutex> profileGuard(profile->lock);
+        for (const TraceEvent& event : profile->events) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"" << jsonEscape(names[event.zone]) << "\""
+                << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << profile->index
+                << ",\"ts\":" << (event.startNanos - epoch) / 1e3
+                << ",\"dur\":" << event.durationNanos / 1e3 << "}";
+        }
+    }
+    out << "\n]}" << std::endl;
+    out.flags(flags);
+}
+
+long long Profiler::zoneCount(const std::string& name) {
+    std::lock_guard<std::mutex> guard(STATIC_VARIABLE(registryLock));
+    const std::vector<std::string>& names = STATIC_VARIABLE(zoneNames);
+    long long total = 0;
+    for (const std::vector<ZoneStats>& zones : snapshotZones()) {
+        for (int zone = 0; zone < int(zones.size()); zone++) {
+            if (names[zone] == name) {
+                total += zones[zone].count;
+            }
+        }
+    }
+    return total;
+}
+
+long long Profiler::zoneNanos(const std::string& name) {
+    std::lock_guard<std::mutex> guard(STATIC_VARIABLE(registryLock));
+    const std::vector<std::string>& names = STATIC_VARIABLE(zoneNames);
+    long long total = 0;
+    for (const std::vector<ZoneStats>& zones : snapshotZones()) {
+        for (int zone = 0; zone < int(zones.size()); zone++) {
+            if (names[zone] == name) {
+                total += zones[zone].totalNanos;
+            }
+        }
+    }
+    return total;
+}
@@ -0,0 +1,154 @@
+/*
+ * File: profiler.h
+ * ----------------
+ * This file exports a lightweight scoped-zone profiler.  Wrapping a block of
+ * code in a named zone records how many times the block ran and how long it
+ * took, aggregated per zone and per thread.
+ *
+ * Usage example:
+ *
+ *<pre>
+ * void drawScene() {
+ *     SPL_PROFILE_SCOPE("drawScene");
+ *     ... code to be measured ...
+ * }
+ *
+ * Profiler::enable();
+ * drawScene();
+ * Profiler::report(cout);
+ *</pre>
+ *
+ * Profiling is off until Profiler::enable() is called.  While disabled, a
+ * zone costs a single relaxed atomic load on entry and exit.  Defining
+ * SPL_PROFILE_DISABLE before including this file compiles zones away entirely.
+ *
+ * @version 2026/10/19
+ * - initial version
+ */
+
+#ifndef _profiler_h
+#define _profiler_h
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include "timer.h"
+
+/**
+ * The Profiler class contains static functions that control collection of
+ * zone timings and report the results.
+ */
+class Profiler {
+public:
+    /**
+     * Turns on profiling.  If recordTrace is true, each individual zone
+     * activation is also recorded so that a timeline can be written with
+     * writeChromeTrace.  Trace recording keeps at most maxTraceEvents
+     * events per thread; later events are counted but not recorded.
+     */
+    static void enable(bool recordTrace = false, int maxTraceEvents = 1000000);
+
+    /**
+     * Turns off profiling.  Data collected so far is retained until reset().
+     */
+    static void disable();
+
+    /**
+     * Returns true if profiling is turned on.
+     */
+    static bool isEnabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Discards all timings and trace events collected so far.
+     */
+    static void reset();
+
+    /**
+     * Writes a table of call counts and times for each zone, per thread,
+     * to the given output stream.
+     */
+    static void report(std::ostream& out = std::cout);
+
+    /**
+     * Writes recorded trace events to the given output stream in the JSON
+     * "Trace Event Format" understood by chrome://tracing and Perfetto.
+     */
+    static void writeChromeTrace(std::ostream& out);
+
+    /**
+     * Returns the number of times the named zone was entered, summed over
+     * all threads.  Returns 0 if there is no zone by that name.
+     */
+    static long long zoneCount(const std::string& name);
+
+    /**
+     * Returns the total nanoseconds spent in the named zone, summed over
+     * all threads.  Returns 0 if there is no zone by that name.
+     */
+    static long long zoneNanos(const std::string& name);
+
+    /*
+     * Internal functions used by ProfileScope; not meant to be called by clients.
+     */
+    static int registerZone(const char* name);
+    static void recordZone(int zone, long long startNanos, long long endNanos);
+
+private:
+    Profiler() = delete;
+
+    static std::atomic<bool> _enabled;
+};
+
+/**
+ * A ProfileScope times the block in which it is declared and records the
+ * result under the given zone when it goes out of scope.
+ * Clients normally use the SPL_PROFILE_SCOPE macro rather than declaring
+ * ProfileScope objects directly.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(int zone);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator =(const ProfileScope&) = delete;
+
+private:
+    int _zone;
+    long long _startNanos;
+};
+
+#define SPL_PROFILE_CONCAT_IMPL(a, b) a ## b
+#define SPL_PROFILE_CONCAT(a, b) SPL_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * Times the rest of the enclosing block as a zone with the given name.
+ * The name should be a string literal; it is registered once, the first time
+ * the enclosing block runs.
+ */
+#ifdef SPL_PROFILE_DISABLE
+#define SPL_PROFILE_SCOPE(name) do {} while (0)
+#else
+#define SPL_PROFILE_SCOPE(name) \
+    static const int SPL_PROFILE_CONCAT(_splProfileZone, __LINE__) = Profiler::registerZone(name); \
+    ProfileScope SPL_PROFILE_CONCAT(_splProfileScope, __LINE__)(SPL_PROFILE_CONCAT(_splProfileZone, __LINE__))
+#endif // SPL_PROFILE_DISABLE
+
+inline ProfileScope::ProfileScope(int zone)
+        : _zone(-1),
+          _startNanos(0) {
+    if (Profiler::isEnabled()) {
+        _zone = zone;
+        _startNanos = Timer::currentTimeNanos();
+    }
+}
+
+inline ProfileScope::~ProfileScope() {
+    if (_zone >= 0 && Profiler::isEnabled()) {
+        Profiler::recordZone(_zone, _startNanos, Timer::currentTimeNanos());
+    }
+}
+
+#endif // _profiler_h
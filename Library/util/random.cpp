@@ -3,6 +3,9 @@
  * ----------------
  * This file implements the random.h interface.
  *
+ * @version 2026/10/19
+ * - replaced C rand() with a per-thread xoshiro256** generator
+ * - added RandomGenerator class, randomIntegers, randomReals
  * @version 2019/05/16
  * - added randomColor that takes min/max RGB
  * @version 2017/10/05
@@ -21,37 +24,102 @@
  */
 
 #include "random.h"
-#include <cstdlib>
-#include <cmath>
-#include <ctime>
-#include <iostream>
+#include <atomic>
+#include <chrono>
 #include <iomanip>
-#include <queue>
 #include <sstream>
+#include <utility>
 #include "error.h"
+#include "vector.h"
 
-/* Private function prototype */
+/* Private function prototypes */
 
-static void initRandomSeed();
+static uint64_t splitMix64(uint64_t& x);
+static std::string rgbToHexString(int rgb);
 
-bool randomBool() {
-    return randomChance(0.5);
+/*
+ * Implementation notes: RandomGenerator seeding
+ * ---------------------------------------------
+ * xoshiro256** must not be started from an all-zero state, and nearby seeds
+ * should give unrelated sequences, so the four words of state are produced by
+ * running the seed through the SplitMix64 generator as its authors recommend.
+ * Unseeded generators mix the clock with a process-wide counter so that
+ * threads started in the same instant still get distinct streams.
+ */
+RandomGenerator::RandomGenerator() {
+    static std::atomic<uint64_t> s_instanceCount(0);
+    uint64_t now = uint64_t(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    uint64_t count = ++s_instanceCount;
+    seed(now ^ (count * 0x9E3779B97F4A7C15ULL));
+}
+
+RandomGenerator::RandomGenerator(uint64_t seed) {
+    this->seed(seed);
+}
+
+bool RandomGenerator::nextChance(double p) {
+    return nextReal(0, 1) < p;
 }
 
 /*
- * Implementation notes: randomChance
- * ----------------------------------
- * The code for randomChance calls randomReal(0, 1) and then checks
- * whether the result is less than the requested probability.
+ * Implementation notes: nextInteger
+ * ---------------------------------
+ * Uses Lemire's multiply-and-reject method: the top 32 random bits are
+ * multiplied by the size of the range, and the high half of the 64-bit product
+ * is the result.  The rare products whose low half falls in the biased zone
+ * are rejected, so every value is equally likely and no floating point or
+ * division is needed in the common case.  The range size is computed in 64 bits
+ * because high - low + 1 can overflow an int.
  */
+int RandomGenerator::nextInteger(int low, int high) {
+    if (low > high) {
+        std::swap(low, high);
+    }
+    uint64_t range = uint64_t(int64_t(high) - int64_t(low)) + 1;   // 1 .. 2^32
+    uint64_t product = (next() >> 32) * range;
+    uint32_t leftover = uint32_t(product);
+    if (leftover < range) {
+        uint32_t threshold = uint32_t((0x100000000ULL - range) % range);
+        while (leftover < threshold) {
+            product = (next() >> 32) * range;
+            leftover = uint32_t(product);
+        }
+    }
+    return int(int64_t(low) + int64_t(product >> 32));
+}
+
+/*
+ * Implementation notes: nextReal
+ * ------------------------------
+ * The top 53 random bits fill the mantissa of a double in [0 .. 1),
+ * which is then scaled and translated into the requested interval.
+ */
+double RandomGenerator::nextReal(double low, double high) {
+    double d = (next() >> 11) * (1.0 / 9007199254740992.0);   // 2^-53
+    return low + d * (high - low);
+}
+
+void RandomGenerator::seed(uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        _state[i] = splitMix64(seed);
+    }
+}
+
+RandomGenerator& RandomGenerator::forThisThread() {
+    static thread_local RandomGenerator s_generator;
+    return s_generator;
+}
+
+bool randomBool() {
+    return randomChance(0.5);
+}
+
 bool randomChance(double p) {
-    initRandomSeed();
-    return randomReal(0, 1) < p;
+    return RandomGenerator::forThisThread().nextChance(p);
 }
 
 int randomColor() {
-    initRandomSeed();
-    return rand() & 0x00ffffff;
+    return int(RandomGenerator::forThisThread().next() & 0x00ffffff);
 }
 
 int randomColor(int minRGB, int maxRGB) {
@@ -65,91 +133,81 @@ int randomColor(int minRGB, int maxRGB) {
     return r << 16 | g << 8 | b;
 }
 
-// see convertRGBToColor in gcolor.h (repeated here to avoid Qt dependency)
 std::string randomColorString() {
-    int rgb = randomColor();
-    std::ostringstream os;
-    os << std::hex << std::uppercase << "#";
-    os << std::setw(2) << std::setfill('0') << (rgb >> 16 & 0xFF);
-    os << std::setw(2) << std::setfill('0') << (rgb >> 8 & 0xFF);
-    os << std::setw(2) << std::setfill('0') << (rgb & 0xFF);
-    return os.str();
+    return rgbToHexString(randomColor());
 }
 
 std::string randomColorString(int minRGB, int maxRGB) {
-    int rgb = randomColor(minRGB, maxRGB);
-    std::ostringstream os;
-    os << std::hex << std::uppercase << "#";
-    os << std::setw(2) << std::setfill('0') << (rgb >> 16 & 0xFF);
-    os << std::setw(2) << std::setfill('0') << (rgb >> 8 & 0xFF);
-    os << std::setw(2) << std::setfill('0') << (rgb & 0xFF);
-    return os.str();
+    return rgbToHexString(randomColor(minRGB, maxRGB));
 }
 
-/*
- * Implementation notes: randomInteger
- * -----------------------------------
- * The code for randomInteger produces the number in four steps:
- *
- * 1. Generate a random real number d in the range [0 .. 1).
- * 2. Scale the number to the range [0 .. N) where N is the number of values.
- * 3. Translate the number so that the range starts at the appropriate value.
- * 4. Convert the result to the next lower integer.
- *
- * The implementation is complicated by the fact that both the expression
- *
- *     RAND_MAX + 1
- *
- * and the expression for the number of values
- *
- *     high - low + 1
- *
- * can overflow the integer range.  These calculations must therefore be
- * performed using doubles instead of ints.
- */
 int randomInteger(int low, int high) {
-    initRandomSeed();
-    double d = rand() / (double(RAND_MAX) + 1);
-    double s = d * (double(high) - low + 1);
-    return int(floor(low + s));
+    return RandomGenerator::forThisThread().nextInteger(low, high);
+}
+
+Vector<int> randomIntegers(int n, int low, int high) {
+    if (n < 0) {
+        error("randomIntegers: n cannot be negative");
+    }
+    Vector<int> result(n);
+    if (n > 0) {
+        randomIntegers(&result[0], n, low, high);
+    }
+    return result;
+}
+
+void randomIntegers(int* buffer, int n, int low, int high) {
+    RandomGenerator& generator = RandomGenerator::forThisThread();
+    for (int i = 0; i < n; i++) {
+        buffer[i] = generator.nextInteger(low, high);
+    }
 }
 
-/*
- * Implementation notes: randomReal
- * --------------------------------
- * The code for randomReal is similar to that for randomInteger,
- * without the final conversion step.
- */
 double randomReal(double low, double high) {
-    initRandomSeed();
-    double d = rand() / (double(RAND_MAX) + 1);
-    double s = d * (high - low);
-    return low + s;
+    return RandomGenerator::forThisThread().nextReal(low, high);
+}
+
+Vector<double> randomReals(int n, double low, double high) {
+    if (n < 0) {
+        error("randomReals: n cannot be negative");
+    }
+    Vector<double> result(n);
+    if (n > 0) {
+        randomReals(&result[0], n, low, high);
+    }
+    return result;
+}
+
+void randomReals(double* buffer, int n, double low, double high) {
+    RandomGenerator& generator = RandomGenerator::forThisThread();
+    for (int i = 0; i < n; i++) {
+        buffer[i] = generator.nextReal(low, high);
+    }
 }
 
 /*
  * Implementation notes: setRandomSeed
  * -----------------------------------
- * The setRandomSeed function simply forwards its argument to srand.
- * The call to initRandomSeed is required to set the initialized flag.
+ * Reseeds the calling thread's generator only; other threads' sequences
+ * are unaffected.
  */
 void setRandomSeed(int seed) {
-    initRandomSeed();
-    srand(seed);
+    RandomGenerator::forThisThread().seed(uint64_t(int64_t(seed)));
 }
 
-/*
- * Implementation notes: initRandomSeed
- * ------------------------------------
- * The initRandomSeed function declares a static variable that keeps track
- * of whether the seed has been initialized.  The first time initRandomSeed
- * is called, initialized is false, so the seed is set to the current time.
- */
-static void initRandomSeed() {
-    static bool _initialized = false;
-    if (!_initialized) {
-        srand(int(time(nullptr)));
-        rand();   // BUGFIX: throwaway call to get randomness going
-        _initialized = true;
-    }
+// see convertRGBToColor in gcolor.h (repeated here to avoid Qt dependency)
+static std::string rgbToHexString(int rgb) {
+    std::ostringstream os;
+    os << std::hex << std::uppercase << "#";
+    os << std::setw(2) << std::setfill('0') << (rgb >> 16 & 0xFF);
+    os << std::setw(2) << std::setfill('0') << (rgb >> 8 & 0xFF);
+    os << std::setw(2) << std::setfill('0') << (rgb & 0xFF);
+    return os.str();
+}
+
+static uint64_t splitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
@@ -3,6 +3,9 @@
  * --------------
  * This file exports functions for generating pseudorandom numbers.
  *
+ * @version 2026/10/19
+ * - replaced C rand() with a per-thread xoshiro256** generator
+ * - added RandomGenerator class, randomIntegers, randomReals
  * @version 2019/05/16
  * - added randomColor that takes min/max RGB
  * @version 2018/09/25
@@ -21,8 +24,88 @@
 #ifndef _random_h
 #define _random_h
 
+#include <cstdint>
 #include <string>
 
+template <typename ValueType> class Vector;
+
+/**
+ * A RandomGenerator produces a stream of pseudorandom numbers using the
+ * xoshiro256** algorithm, which is fast and has excellent statistical
+ * quality.  The free functions in this file each use a private generator
+ * belonging to the calling thread, so they are safe to call from several
+ * threads at once.  Client code that wants an independent, reproducible
+ * stream of its own (for example, one per worker in a simulation) can
+ * declare its own RandomGenerator.
+ *
+ * A RandomGenerator object must not be shared between threads without
+ * external synchronization.
+ */
+class RandomGenerator {
+public:
+    /**
+     * Constructs a generator seeded from the clock and a per-process counter,
+     * so that generators constructed at the same moment still differ.
+     */
+    RandomGenerator();
+
+    /**
+     * Constructs a generator with the given seed.  Two generators given the
+     * same seed produce the same sequence of values.
+     */
+    explicit RandomGenerator(uint64_t seed);
+
+    /**
+     * Returns <code>true</code> with the probability indicated by <code>p</code>.
+     */
+    bool nextChance(double p);
+
+    /**
+     * Returns a random integer in the range <code>low</code> to
+     * <code>high</code>, inclusive.  Every value in the range is equally likely.
+     */
+    int nextInteger(int low, int high);
+
+    /**
+     * Returns a random real number in the half-open interval
+     * [<code>low</code>&nbsp;..&nbsp;<code>high</code>).
+     */
+    double nextReal(double low, double high);
+
+    /**
+     * Returns 64 random bits.
+     */
+    uint64_t next() {
+        uint64_t result = rotl(_state[1] * 5, 7) * 9;
+        uint64_t t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotl(_state[3], 45);
+        return result;
+    }
+
+    /**
+     * Restarts the generator's sequence from the given seed.
+     */
+    void seed(uint64_t seed);
+
+    /**
+     * Returns the generator used by the free functions in this file
+     * on the calling thread.
+     */
+    static RandomGenerator& forThisThread();
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t _state[4];
+};
+
 /**
  * Returns <code>true</code> with 50% probability.
  */
@@ -71,6 +154,19 @@ std::string randomColorString(int minRGB, int maxRGB);
  */
 int randomInteger(int low, int high);
 
+/**
+ * Returns a vector of <code>n</code> random integers, each in the range
+ * <code>low</code> to <code>high</code>, inclusive.
+ * This is considerably faster than calling randomInteger <code>n</code> times.
+ */
+Vector<int> randomIntegers(int n, int low, int high);
+
+/**
+ * Fills the first <code>n</code> entries of the given array with random
+ * integers in the range <code>low</code> to <code>high</code>, inclusive.
+ */
+void randomIntegers(int* buffer, int n, int low, int high);
+
 /**
  * Returns a random real number in the half-open interval
  * [<code>low</code>&nbsp;..&nbsp;<code>high</code>).  A half-open
@@ -80,11 +176,28 @@ int randomInteger(int low, int high);
  */
 double randomReal(double low, double high);
 
+/**
+ * Returns a vector of <code>n</code> random real numbers, each in the
+ * half-open interval [<code>low</code>&nbsp;..&nbsp;<code>high</code>).
+ */
+Vector<double> randomReals(int n, double low, double high);
+
+/**
+ * Fills the first <code>n</code> entries of the given array with random
+ * real numbers in the half-open interval
+ * [<code>low</code>&nbsp;..&nbsp;<code>high</code>).
+ */
+void randomReals(double* buffer, int n, double low, double high);
+
 /**
  * Sets the internal random number seed to the specified value.  You
  * can use this function to set a specific starting point for the
  * pseudorandom sequence or to ensure that program behavior is
  * repeatable during the debugging phase.
+ *
+ * Each thread has its own random number generator, and this function seeds
+ * only the generator of the calling thread.  A thread that sets a given seed
+ * always sees the same sequence of values, no matter what other threads do.
  */
 void setRandomSeed(int seed);
 
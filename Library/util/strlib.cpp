@@ -3,6 +3,10 @@
  * ----------------
  * This file implements the strlib.h interface.
  * 
+ * @version 2026/10/19
+ * - numeric parsing/formatting rewritten on std::from_chars/to_chars
+ *   instead of constructing a string stream per call
+ * - stringJoin reserves its result, urlEncode builds its result directly
  * @version 2018/11/14
  * - added std::to_string for bool, char, pointer, and generic template type T
  * - bug fix for pointerToString (was putting two "0x" prefixes)
@@ -41,9 +45,13 @@
 
 #include "strlib.h"
 #include <cctype>
+#include <charconv>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <system_error>
+#include <type_traits>
 
 #include "error.h"
 #include "vector.h"
@@ -51,6 +59,14 @@
 
 /* Function prototypes */
 
+static std::string_view trimView(std::string_view str);
+template <typename T>
+static bool parseInteger(std::string_view str, int radix, T& value);
+static bool parseReal(std::string_view str, double& value);
+template <typename T>
+static std::string formatInteger(T n, int radix);
+static void checkRadix(int radix, const char* prefix);
+
 std::string boolToString(bool b) {
     return (b ? "true" : "false");
 }
@@ -139,30 +155,20 @@ char integerToChar(int n) {
 /*
  * Implementation notes: numeric conversion
  * ----------------------------------------
- * These functions use the <sstream> library to perform the conversion.
+ * These functions use std::to_chars/std::from_chars, which convert directly
+ * to and from a character buffer without the locale and stream machinery
+ * that an ostringstream/istringstream pays on every call.  The helpers below
+ * reproduce the rules of the << and >> operators the functions used before,
+ * so the accepted formats and the error cases are unchanged.
  */
 std::string integerToString(int n, int radix) {
-    if (radix <= 0) {
-        error("integerToString: Illegal radix: " + std::to_string(radix));
-    }
-    std::ostringstream stream;
-    if (radix != 10) {
-        stream << std::setbase(radix);
-    }
-    stream << n;
-    return stream.str();
+    checkRadix(radix, "integerToString");
+    return formatInteger(n, radix);
 }
 
 std::string longToString(long n, int radix) {
-    if (radix <= 0) {
-        error("longToString: Illegal radix: " + std::to_string(radix));
-    }
-    std::ostringstream stream;
-    if (radix != 10) {
-        stream << std::setbase(radix);
-    }
-    stream << n;
-    return stream.str();
+    checkRadix(radix, "longToString");
+    return formatInteger(n, radix);
 }
 
 std::string padLeft(const std::string& s, int length, char fill) {
@@ -202,10 +208,28 @@ std::string pointerToString(void* p) {
     }
 }
 
+/*
+ * Implementation notes: realToString
+ * ----------------------------------
+ * The << operator formats a double like printf("%G"), which is exactly what
+ * to_chars produces in general format with precision 6, apart from case.
+ * Floating-point to_chars is missing from some older standard libraries,
+ * which fall back to the stream.
+ */
 std::string realToString(double d) {
+#if defined(__cpp_lib_to_chars)
+    char buffer[32];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), d,
+                                                std::chars_format::general, 6);
+    for (char* p = buffer; p < result.ptr; p++) {
+        *p = (char) toupper(*p);
+    }
+    return std::string(buffer, result.ptr);
+#else
     std::ostringstream stream;
     stream << std::uppercase << d;
     return stream.str();
+#endif // __cpp_lib_to_chars
 }
 
 bool startsWith(const std::string& str, char prefix) {
@@ -225,37 +249,25 @@ bool stringIsBool(const std::string& str) {
     return str == "true" || str == "false";
 }
 
-bool stringIsDouble(const std::string& str) {
+bool stringIsDouble(std::string_view str) {
     return stringIsReal(str);
 }
 
-bool stringIsInteger(const std::string& str, int radix) {
-    if (radix <= 0) {
-        error("stringIsInteger: Illegal radix: " + std::to_string(radix));
-    }
-    std::istringstream stream(trim(str));
-    stream >> std::setbase(radix);
+bool stringIsInteger(std::string_view str, int radix) {
+    checkRadix(radix, "stringIsInteger");
     int value;
-    stream >> value;
-    return !(stream.fail() || !stream.eof());
+    return parseInteger(trimView(str), radix, value);
 }
 
-bool stringIsLong(const std::string& str, int radix) {
-    if (radix <= 0) {
-        error("stringIsLong: Illegal radix: " + std::to_string(radix));
-    }
-    std::istringstream stream(trim(str));
-    stream >> std::setbase(radix);
+bool stringIsLong(std::string_view str, int radix) {
+    checkRadix(radix, "stringIsLong");
     long value;
-    stream >> value;
-    return !(stream.fail() || !stream.eof());
+    return parseInteger(trimView(str), radix, value);
 }
 
-bool stringIsReal(const std::string& str) {
-    std::istringstream stream(trim(str));
+bool stringIsReal(std::string_view str) {
     double value;
-    stream >> value;
-    return !(stream.fail() || !stream.eof());
+    return parseReal(trimView(str), value);
 }
 
 bool stringContains(const std::string& s, char ch) {
@@ -293,13 +305,18 @@ std::string stringJoin(const Vector<std::string>& v, const std::string& delimite
     if (v.isEmpty()) {
         return "";
     } else {
-        std::ostringstream out;
-        out << v[0];
+        size_t length = delimiter.length() * (v.size() - 1);
+        for (const std::string& s : v) {
+            length += s.length();
+        }
+        std::string out;
+        out.reserve(length);
+        out += v[0];
         for (int i = 1; i < (int) v.size(); i++) {
-            out << delimiter;
-            out << v[i];
+            out += delimiter;
+            out += v[i];
         }
-        return out.str();
+        return out;
     }
 }
 
@@ -415,44 +432,32 @@ char stringToChar(const std::string& str) {
     return str[0];
 }
 
-double stringToDouble(const std::string& str) {
+double stringToDouble(std::string_view str) {
     return stringToReal(str);
 }
 
-int stringToInteger(const std::string& str, int radix) {
-    if (radix <= 0) {
-        error("stringToInteger: Illegal radix: " + std::to_string(radix));
-    }
-    std::istringstream stream(trim(str));
-    stream >> std::setbase(radix);
+int stringToInteger(std::string_view str, int radix) {
+    checkRadix(radix, "stringToInteger");
     int value;
-    stream >> value;
-    if (stream.fail() || !stream.eof()) {
-        error("stringToInteger: Illegal integer format: \"" + str + "\"");
+    if (!parseInteger(trimView(str), radix, value)) {
+        error("stringToInteger: Illegal integer format: \"" + std::string(str) + "\"");
     }
     return value;
 }
 
-long stringToLong(const std::string& str, int radix) {
-    if (radix <= 0) {
-        error("stringToLong: Illegal radix: " + std::to_string(radix));
-    }
-    std::istringstream stream(trim(str));
-    stream >> std::setbase(radix);
+long stringToLong(std::string_view str, int radix) {
+    checkRadix(radix, "stringToLong");
     long value;
-    stream >> value;
-    if (stream.fail() || !stream.eof()) {
-        error("stringToLong: Illegal long format \"" + str + "\"");
+    if (!parseInteger(trimView(str), radix, value)) {
+        error("stringToLong: Illegal long format \"" + std::string(str) + "\"");
     }
     return value;
 }
 
-double stringToReal(const std::string& str) {
-    std::istringstream stream(trim(str));
+double stringToReal(std::string_view str) {
     double value;
-    stream >> value;
-    if (stream.fail() || !stream.eof()) {
-        error("stringToReal: Illegal floating-point format (" + str + ")");
+    if (!parseReal(trimView(str), value)) {
+        error("stringToReal: Illegal floating-point format (" + std::string(str) + ")");
     }
     return value;
 }
@@ -575,28 +580,154 @@ void urlDecodeInPlace(std::string& str) {
 }
 
 std::string urlEncode(const std::string& str) {
-    std::ostringstream escaped;
-    escaped.fill('0');
-    escaped << std::hex << std::uppercase;
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    std::string escaped;
+    escaped.reserve(str.length());
 
-    for (std::string::const_iterator i = str.begin(), n = str.end(); i != n; ++i) {
-        std::string::value_type c = (*i);
+    for (char ch : str) {
+        unsigned char c = (unsigned char) ch;
         if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '*') {
-            escaped << c;
+            escaped += ch;
         } else if (c == ' ')  {
-            escaped << '+';
+            escaped += '+';
         } else {
-            escaped << '%' << std::setw(2) << ((int) c) << std::setw(0);
+            escaped += '%';
+            escaped += HEX_DIGITS[c >> 4];
+            escaped += HEX_DIGITS[c & 0xF];
         }
     }
 
-    return escaped.str();
+    return escaped;
 }
 
 void urlEncodeInPlace(std::string& str) {
     str = urlEncode(str);   // no real efficiency gain here
 }
 
+/*
+ * Returns a view of str without leading and trailing whitespace.
+ */
+static std::string_view trimView(std::string_view str) {
+    size_t start = 0;
+    size_t finish = str.length();
+    while (start < finish && isspace((unsigned char) str[start])) {
+        start++;
+    }
+    while (finish > start && isspace((unsigned char) str[finish - 1])) {
+        finish--;
+    }
+    return str.substr(start, finish - start);
+}
+
+static void checkRadix(int radix, const char* prefix) {
+    if (radix < 2 || radix > 36) {
+        error(std::string(prefix) + ": Illegal radix: " + std::to_string(radix));
+    }
+}
+
+/*
+ * Implementation notes: parseInteger
+ * ----------------------------------
+ * Follows the rules of the >> operator: a single optional '+' or '-' sign,
+ * then digits in the given radix (base-16 may start with "0x"), and nothing
+ * else.  The magnitude is parsed unsigned so that the most negative value
+ * of the type is accepted and anything beyond the type's range is rejected.
+ */
+template <typename T>
+static bool parseInteger(std::string_view str, int radix, T& value) {
+    using Unsigned = typename std::make_unsigned<T>::type;
+    bool negative = false;
+    if (!str.empty() && (str[0] == '+' || str[0] == '-')) {
+        negative = str[0] == '-';
+        str.remove_prefix(1);
+    }
+    if (radix == 16 && str.length() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        str.remove_prefix(2);
+    }
+    if (str.empty() || str[0] == '+' || str[0] == '-') {
+        return false;
+    }
+    Unsigned magnitude;
+    const char* end = str.data() + str.length();
+    std::from_chars_result result = std::from_chars(str.data(), end, magnitude, radix);
+    if (result.ec != std::errc() || result.ptr != end) {
+        return false;
+    }
+    Unsigned limit = (Unsigned) std::numeric_limits<T>::max();
+    if (negative) {
+        if (magnitude > limit + 1) {
+            return false;
+        }
+        value = magnitude == 0 ? 0 : (T) -(T) (magnitude - 1) - 1;
+    } else {
+        if (magnitude > limit) {
+            return false;
+        }
+        value = (T) magnitude;
+    }
+    return true;
+}
+
+/*
+ * Implementation notes: parseReal
+ * -------------------------------
+ * from_chars accepts the same decimal and exponent syntax as the >> operator
+ * except that it does not allow a leading '+', and it also accepts "inf" and
+ * "nan", which >> rejects; both differences are handled here.  For values too
+ * large or too small to represent, the two disagree on whether tiny values
+ * are an error, so those rare cases (and libraries without floating-point
+ * from_chars) go through a string stream exactly as before.
+ */
+static bool parseRealWithStream(std::string_view str, double& value) {
+    std::istringstream stream{std::string(str)};
+    stream >> value;
+    return !(stream.fail() || !stream.eof());
+}
+
+static bool parseReal(std::string_view str, double& value) {
+#if defined(__cpp_lib_to_chars)
+    std::string_view digits = str;
+    if (!digits.empty() && digits[0] == '+') {
+        digits.remove_prefix(1);
+        if (!digits.empty() && digits[0] == '-') {
+            return false;
+        }
+    }
+    size_t first = (!digits.empty() && digits[0] == '-') ? 1 : 0;
+    if (first >= digits.length() || !(isdigit((unsigned char) digits[first]) || digits[first] == '.')) {
+        return false;
+    }
+    const char* end = digits.data() + digits.length();
+    std::from_chars_result result = std::from_chars(digits.data(), end, value, std::chars_format::general);
+    if (result.ec == std::errc::result_out_of_range) {
+        return parseRealWithStream(str, value);
+    }
+    return result.ec == std::errc() && result.ptr == end;
+#else
+    return parseRealWithStream(str, value);
+#endif // __cpp_lib_to_chars
+}
+
+/*
+ * Implementation notes: formatInteger
+ * -----------------------------------
+ * As with the << operator, negative numbers in base 8 and 16 are written as
+ * the unsigned two's complement bit pattern (-1 in hex is "ffffffff").
+ * Other radixes write a minus sign followed by the magnitude.
+ */
+template <typename T>
+static std::string formatInteger(T n, int radix) {
+    char buffer[std::numeric_limits<T>::digits + 2];
+    std::to_chars_result result;
+    if (radix == 8 || radix == 16) {
+        using Unsigned = typename std::make_unsigned<T>::type;
+        result = std::to_chars(buffer, buffer + sizeof(buffer), (Unsigned) n, radix);
+    } else {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), n, radix);
+    }
+    return std::string(buffer, result.ptr);
+}
+
 namespace std {
 bool stob(const std::string& str) {
     return ::stringToBool(str);
@@ -4,6 +4,9 @@
  * This file exports several useful string functions that are not
  * included in the C++ string library.
  *
+ * @version 2026/10/19
+ * - numeric parsing/formatting rewritten on std::from_chars/to_chars
+ * - string-to-number functions take std::string_view (no copy or allocation)
  * @version 2018/11/14
  * - added std::to_string for bool, char, pointer, and generic template type T
  * @version 2018/09/25
@@ -42,6 +45,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "vector.h"
 
@@ -195,7 +199,7 @@ bool stringIsBool(const std::string& str);
  * the string has the format of a real number such as "3.14" or "-46".
  * Equivalent to stringIsReal.
  */
-bool stringIsDouble(const std::string& str);   // alias
+bool stringIsDouble(std::string_view str);   // alias
 
 /**
  * Returns true if the given string could be converted to an integer
@@ -203,7 +207,7 @@ bool stringIsDouble(const std::string& str);   // alias
  * the string has the format of an integer such as "1234" or "-8".
  * Optionally accepts a radix (base) parameter if base-10 is not desired.
  */
-bool stringIsInteger(const std::string& str, int radix = 10);
+bool stringIsInteger(std::string_view str, int radix = 10);
 
 /**
  * Returns true if the given string could be converted to a long
@@ -211,14 +215,14 @@ bool stringIsInteger(const std::string& str, int radix = 10);
  * the string has the format of an integer such as "1234" or "-8".
  * Optionally accepts a radix (base) parameter if base-10 is not desired.
  */
-bool stringIsLong(const std::string& str, int radix = 10);
+bool stringIsLong(std::string_view str, int radix = 10);
 
 /**
  * Returns true if the given string could be converted to an real number
  * successfully by the stringToReal function, which will be true if
  * the string has the format of a real number such as "3.14" or "-46".
  */
-bool stringIsReal(const std::string& str);
+bool stringIsReal(std::string_view str);
 
 /**
  * Combines the elements of the given Vector into a single string,
@@ -323,27 +327,31 @@ char stringToChar(const std::string& str);
  * @throw ErrorException if the string is not a legal floating-point number
  *        or contains extraneous characters other than whitespace
  */
-double stringToDouble(const std::string& str);   // alias
+double stringToDouble(std::string_view str);   // alias
 
 /**
  * Converts a string of digits into an integer.
  * The function accepts an optional radix (base); for example,
  * stringToInteger("234", 16) assumes that the string is in base-16 and
- * returns 2*16*16 + 3*16 + 4 = 564.
+ * returns 2*16*16 + 3*16 + 4 = 564.  The radix may be 2 through 36;
+ * base-16 strings may start with "0x".
  * @throw ErrorException if the string is not a legal integer or contains
- *        extraneous characters other than whitespace
+ *        extraneous characters other than whitespace, or if the radix is
+ *        not in the range 2 through 36
  */
-int stringToInteger(const std::string& str, int radix = 10);
+int stringToInteger(std::string_view str, int radix = 10);
 
 /**
  * Converts a string of digits into a long.
  * The function accepts an optional radix (base); for example,
  * stringToLong("234", 16) assumes that the string is in base-16 and
- * returns 2*16*16 + 3*16 + 4 = 564.
+ * returns 2*16*16 + 3*16 + 4 = 564.  The radix may be 2 through 36;
+ * base-16 strings may start with "0x".
  * @throw ErrorException if the string is not a legal long or contains
- *        extraneous characters other than whitespace
+ *        extraneous characters other than whitespace, or if the radix is
+ *        not in the range 2 through 36
  */
-long stringToLong(const std::string& str, int radix = 10);
+long stringToLong(std::string_view str, int radix = 10);
 
 /**
  * Converts a string representing a real number into its corresponding
@@ -352,7 +360,7 @@ long stringToLong(const std::string& str, int radix = 10);
  * @throw ErrorException if the string is not a legal floating-point number or
  * contains extraneous characters other than whitespace
  */
-double stringToReal(const std::string& str);
+double stringToReal(std::string_view str);
 
 /**
  * Returns a new character in which the given uppercase character has been
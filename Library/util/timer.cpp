@@ -2,45 +2,104 @@
  * File: timer.cpp
  * ---------------
  * Implementation of the Timer class as declared in timer.h.
+ *
+ * @version 2026/10/19
+ * - use std::chrono::steady_clock rather than gettimeofday
  */
 
 #include "timer.h"
+#include <chrono>
 #include <sys/time.h>
 
 Timer::Timer(bool autostart) {
-    _startMS = 0;
-    _stopMS = 0;
+    _startNanos = 0;
+    _accumNanos = 0;
+    _lapNanos = 0;
     _isStarted = false;
+    _isPaused = false;
     if (autostart) {
         start();
     }
 }
 
 long Timer::elapsed() const {
-    return _stopMS - _startMS;
+    return long(runningNanos() / 1000000);
+}
+
+long long Timer::elapsedMicros() const {
+    return runningNanos() / 1000;
+}
+
+long long Timer::elapsedNanos() const {
+    return runningNanos();
 }
 
 bool Timer::isStarted() const {
     return _isStarted;
 }
 
+bool Timer::isPaused() const {
+    return _isPaused;
+}
+
+long long Timer::lap() {
+    long long now = runningNanos();
+    long long split = now - _lapNanos;
+    _lapNanos = now;
+    return split;
+}
+
+void Timer::pause() {
+    if (_isStarted && !_isPaused) {
+        _accumNanos += currentTimeNanos() - _startNanos;
+        _isPaused = true;
+    }
+}
+
+void Timer::resume() {
+    if (_isStarted && _isPaused) {
+        _startNanos = currentTimeNanos();
+        _isPaused = false;
+    }
+}
+
 void Timer::start() {
-    _startMS = currentTimeMS();
+    _accumNanos = 0;
+    _lapNanos = 0;
+    _isPaused = false;
     _isStarted = true;
+    _startNanos = currentTimeNanos();
 }
 
 long Timer::stop() {
-    _stopMS = currentTimeMS();
-    if (!_isStarted) {
-        // error("Timer is not started");
-        _startMS = _stopMS;
+    if (_isStarted) {
+        pause();
+        _isStarted = false;
+        _isPaused = false;
     }
-    _isStarted = false;
     return elapsed();
 }
 
+/*
+ * Implementation notes: runningNanos
+ * ----------------------------------
+ * Running time is the time accumulated over previous start/resume intervals
+ * plus, if the timer is currently running, the length of the current interval.
+ */
+long long Timer::runningNanos() const {
+    if (_isStarted && !_isPaused) {
+        return _accumNanos + (currentTimeNanos() - _startNanos);
+    }
+    return _accumNanos;
+}
+
 long Timer::currentTimeMS() {
     timeval time;
     gettimeofday(&time, nullptr);
     return (time.tv_sec * 1000000 + time.tv_usec) / 1000;
 }
+
+long long Timer::currentTimeNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -2,8 +2,11 @@
  * File: timer.h
  * -------------
  * This file exports a Timer class that is useful for measuring the elapsed
- * time of a program in milliseconds over a given interval.
+ * time of a program over a given interval.
  *
+ * @version 2026/10/19
+ * - switched to monotonic clock with nanosecond resolution
+ * - added elapsedNanos, lap, pause/resume
  * @version 2018/09/25
  * - added doc comments for new documentation generation
  */
@@ -13,7 +16,10 @@
 
 /**
  * A Timer object is useful for measuring the elapsed
- * time of a program in milliseconds over a given interval.
+ * time of a program over a given interval.
+ * Timers use a monotonic clock, so they are not affected by adjustments
+ * to the system's wall-clock time, and can resolve intervals well below
+ * one millisecond using <code>elapsedNanos</code>.
  * Usage example:
  *
  *<pre>
@@ -33,17 +39,55 @@ public:
     Timer(bool autostart = false);
 
     /**
-     * Returns the number of milliseconds that have elapsed since this timer
-     * was started.
+     * Returns the number of milliseconds that have elapsed while this timer
+     * was running.  If the timer is still running, this is the time elapsed
+     * so far; time spent paused is not counted.
      * Returns 0 if the timer was never started.
      */
     long elapsed() const;
 
     /**
-     * Returns true if the timer has been started.
+     * Returns the number of microseconds that have elapsed while this timer
+     * was running.  See elapsed() for details.
+     */
+    long long elapsedMicros() const;
+
+    /**
+     * Returns the number of nanoseconds that have elapsed while this timer
+     * was running.  See elapsed() for details.
+     */
+    long long elapsedNanos() const;
+
+    /**
+     * Returns true if the timer has been started and not yet stopped.
+     * A paused timer is still considered to be started.
      */
     bool isStarted() const;
 
+    /**
+     * Returns true if the timer has been paused by a call to pause().
+     */
+    bool isPaused() const;
+
+    /**
+     * Returns the number of nanoseconds of running time since the previous
+     * call to lap(), or since the timer was started if lap() has not yet been
+     * called.  Does not stop or reset the timer.
+     */
+    long long lap();
+
+    /**
+     * Temporarily suspends the timer; time does not accumulate until resume()
+     * is called.  Has no effect if the timer is not running or already paused.
+     */
+    void pause();
+
+    /**
+     * Resumes a timer that was suspended by pause().
+     * Has no effect if the timer is not paused.
+     */
+    void resume();
+
     /**
      * Starts the timer.
      * If the timer was already started, restarts it such that its 'elapsed'
@@ -60,14 +104,26 @@ public:
     /**
      * A static utility function for getting the current time as a Unix
      * timestamp of milliseconds since the epoch.
+     * This is wall-clock time; use currentTimeNanos to measure intervals.
      */
     static long currentTimeMS();
 
+    /**
+     * A static utility function for getting the current reading of the
+     * monotonic clock in nanoseconds.  The reading has no relation to the
+     * calendar; it is only meaningful when compared to another reading.
+     */
+    static long long currentTimeNanos();
+
 private:
+    long long runningNanos() const;
+
     // instance variables
-    long _startMS;
-    long _stopMS;
+    long long _startNanos;   // clock reading when last started/resumed
+    long long _accumNanos;   // running time accumulated before last pause/stop
+    long long _lapNanos;     // running time at previous lap
     bool _isStarted;
+    bool _isPaused;
 };
 
 #endif // _timer_h
@@ -83,9 +83,9 @@ OTHER_FILES     *=  $$files(*.txt, true)
 
 CONFIG          +=  sdk_no_version_check   # removes spurious warnings on Mac OS X
 
-# MinGW compiler lags, be conservative and use C++11 on all platforms
+# Library headers use C++17 (string_view, from_chars), so use it on all platforms
 # rather than special case
-CONFIG          +=  c++11
+CONFIG          +=  c++17
 
 # WARN_ON has -Wall -Wextra, add/remove a few specific warnings
 QMAKE_CXXFLAGS_WARN_ON      +=  -Werror=return-type
@@ -0,0 +1,251 @@
+/*
+ * Test file for verifying the Stanford C++ lib BigInteger class.
+ */
+
+#include "biginteger.h"
+#include "hashcode.h"
+#include "SimpleTest.h"
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
+/*
+ * Multiplies two non-negative decimal strings one digit at a time, the way
+ * the old string-based BigInteger did; used to check and time the new one.
+ */
+static std::string stringMultiply(const std::string& n1, const std::string& n2) {
+    std::vector<int> digits(n1.length() + n2.length(), 0);
+    for (int i = (int) n1.length() - 1; i >= 0; i--) {
+        int carry = 0;
+        for (int j = (int) n2.length() - 1; j >= 0; j--) {
+            int sum = digits[i + j + 1] + (n1[i] - '0') * (n2[j] - '0') + carry;
+            digits[i + j + 1] = sum % 10;
+            carry = sum / 10;
+        }
+        digits[i] += carry;
+    }
+    std::string result;
+    for (int digit : digits) {
+        if (!result.empty() || digit != 0) {
+            result += (char) ('0' + digit);
+        }
+    }
+    return result.empty() ? "0" : result;
+}
+
+/*
+ * Returns a pseudorandom number with the given number of 64-bit limbs,
+ * built from a simple generator so that the tests are repeatable.
+ */
+static BigInteger makeNumber(int limbs, unsigned long long seed) {
+    std::ostringstream hex;
+    hex << std::hex << std::setfill('0');
+    for (int i = 0; i < limbs; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        hex << std::setw(16) << seed;
+    }
+    return BigInteger(hex.str(), 16);
+}
+
+PROVIDED_TEST("BigInteger, constructing from and converting to strings") {
+    EXPECT_EQUAL(BigInteger().toString(), "0");
+    EXPECT_EQUAL(BigInteger("1234567890123456789012345678901234567890").toString(),
+                 "1234567890123456789012345678901234567890");
+    EXPECT_EQUAL(BigInteger("-000123").toString(), "-123");
+    EXPECT_EQUAL(BigInteger("+42").toString(), "42");
+    EXPECT_EQUAL(BigInteger("-0").toString(), "0");
+    EXPECT_EQUAL(BigInteger("  77  ").toString(), "77");
+    EXPECT_EQUAL(BigInteger("0xFF", 16).toString(), "255");
+    EXPECT_EQUAL(BigInteger("-zz", 36).toString(), "-1295");
+    EXPECT_EQUAL(BigInteger(255).toString(16), "ff");
+    EXPECT_EQUAL(BigInteger(-255).toString(2), "-11111111");
+    EXPECT_EQUAL(BigInteger(-255).toString(7), "-513");
+    EXPECT_EQUAL(BigInteger(LONG_MIN).toLong(), LONG_MIN);
+    EXPECT_EQUAL(bigIntegerToString(BigInteger::MAX_UINT), std::to_string(UINT_MAX));
+
+    BigInteger big = BigInteger(3).pow(50000);
+    std::string decimal = big.toString();
+    EXPECT_EQUAL(decimal.length(), 23857);
+    EXPECT_EQUAL(decimal.substr(0, 30), "115540963049058989114459602920");
+    EXPECT_EQUAL(decimal.substr(decimal.length() - 30), "859260618632083774432761000001");
+    EXPECT_EQUAL(BigInteger(decimal), big);
+    EXPECT_EQUAL(BigInteger(big.toString(16), 16), big);
+    EXPECT_EQUAL(BigInteger(big.toString(36), 36), big);
+    EXPECT_EQUAL(BigInteger(10).pow(20000).toString(), "1" + std::string(20000, '0'));
+
+    EXPECT_ERROR(BigInteger(""));
+    EXPECT_ERROR(BigInteger("-"));
+    EXPECT_ERROR(BigInteger("12a"));
+    EXPECT_ERROR(BigInteger("1 2"));
+    EXPECT_ERROR(BigInteger("102", 2));
+    EXPECT_ERROR(BigInteger("1", 37));
+    EXPECT_ERROR(BigInteger(1).toString(1));
+}
+
+PROVIDED_TEST("BigInteger, arithmetic agrees with long long") {
+    long long values[] = {0, 1, -1, 2, -3, 7, 10, -64, 1000003, -987654321, 2147483647LL,
+                          -2147483648LL, 3000000000LL, -2999999999LL};
+    for (long long a : values) {
+        for (long long b : values) {
+            BigInteger ba = BigInteger(std::to_string(a));
+            BigInteger bb = BigInteger(std::to_string(b));
+            EXPECT_EQUAL((ba + bb).toString(), std::to_string(a + b));
+            EXPECT_EQUAL((ba - bb).toString(), std::to_string(a - b));
+            EXPECT_EQUAL((ba * bb).toString(), std::to_string(a * b));
+            if (b != 0) {
+                EXPECT_EQUAL((ba / bb).toString(), std::to_string(a / b));
+                EXPECT_EQUAL((ba % bb).toString(), std::to_string(a % b));
+            }
+            EXPECT_EQUAL((ba & bb).toString(), std::to_string(a & b));
+            EXPECT_EQUAL((ba | bb).toString(), std::to_string(a | b));
+            EXPECT_EQUAL((ba ^ bb).toString(), std::to_string(a ^ b));
+            EXPECT_EQUAL(ba < bb, a < b);
+            EXPECT_EQUAL(ba == bb, a == b);
+            EXPECT_EQUAL(ba >= bb, a >= b);
+        }
+        BigInteger ba = BigInteger(std::to_string(a));
+        EXPECT_EQUAL((~ba).toString(), std::to_string(~a));
+        EXPECT_EQUAL((ba >> 3).toString(), std::to_string(a >> 3));
+        EXPECT_EQUAL((ba << 5).toString(), std::to_string(a * 32));
+        EXPECT_EQUAL((-ba).toString(), std::to_string(-a));
+    }
+    BigInteger n = 5;
+    EXPECT_EQUAL((n++).toString(), "5");
+    EXPECT_EQUAL((--n).toString(), "5");
+    n -= n;
+    EXPECT_EQUAL(n, BigInteger::ZERO);
+    EXPECT(!n);
+    EXPECT_ERROR(BigInteger(1) / BigInteger::ZERO);
+    EXPECT_ERROR(BigInteger(1) % BigInteger::ZERO);
+}
+
+PROVIDED_TEST("BigInteger, large multiplication and division are consistent") {
+    // sizes on both sides of the Karatsuba and Toom-3 thresholds, and lopsided ones
+    int sizes[] = {3, 31, 33, 100, 159, 161, 400, 1000};
+    for (int i = 0; i < 8; i++) {
+        BigInteger a = makeNumber(sizes[i], i + 1);
+        BigInteger b = makeNumber(sizes[(i + 3) % 8], i + 100);
+        BigInteger product = a * b;
+        EXPECT_EQUAL((a + b) * (a + b), a * a + BigInteger(2) * product + b * b);
+        EXPECT_EQUAL(product / b, a);
+        EXPECT_EQUAL(product % b, BigInteger::ZERO);
+
+        BigInteger c = product + a - BigInteger::ONE;
+        BigInteger q = c / b;
+        BigInteger r = c % b;
+        EXPECT_EQUAL(q * b + r, c);
+        EXPECT(r.isNonNegative() && r < b);
+        EXPECT_EQUAL((-c) / b, -q);
+        EXPECT_EQUAL((-c) % b, -r);
+    }
+    std::string x = makeNumber(20, 7).toString();
+    std::string y = makeNumber(25, 8).toString();
+    EXPECT_EQUAL((BigInteger(x) * BigInteger(y)).toString(), stringMultiply(x, y));
+}
+
+PROVIDED_TEST("BigInteger, gcd, pow, modPow, and modInverse") {
+    EXPECT_EQUAL(BigInteger(24).gcd(BigInteger(-16)), BigInteger(8));
+    EXPECT_EQUAL(BigInteger::ZERO.gcd(BigInteger(5)), BigInteger(5));
+    EXPECT_EQUAL(BigInteger(2).pow(100).toString(), "1267650600228229401496703205376");
+    EXPECT_EQUAL(BigInteger(-1).pow(BigInteger::MAX_ULONG * BigInteger::TWO), BigInteger::ONE);
+    EXPECT_ERROR(BigInteger(2).pow(-1));
+    EXPECT_ERROR(BigInteger(2).pow(BigInteger::MAX_ULONG * BigInteger::TWO));
+
+    BigInteger factorial = 1;
+    for (int i = 2; i <= 100; i++) {
+        factorial *= i;
+    }
+    EXPECT_EQUAL(factorial.toString(),
+                 "93326215443944152681699238856266700490715968264381621468592963895217599993229915608941463976156518286253697920827223758251185210916864000000000000000000000000");
+
+    EXPECT_EQUAL(BigInteger::TWO.modPow(10, 100), BigInteger(24));
+    EXPECT_EQUAL(BigInteger(-7).modPow(3, 10), BigInteger(7));
+    EXPECT_EQUAL(BigInteger(5).modPow(0, 7), BigInteger::ONE);
+    EXPECT_EQUAL(BigInteger(5).modPow(3, 1), BigInteger::ZERO);
+    EXPECT_ERROR(BigInteger(5).modPow(-1, 7));
+    EXPECT_ERROR(BigInteger(5).modPow(3, 0));
+
+    // 2^521 - 1 is prime, so a^(p - 1) mod p is 1 (Fermat)
+    BigInteger p = BigInteger::TWO.pow(521) - BigInteger::ONE;
+    BigInteger a = makeNumber(8, 42) % p;
+    EXPECT_EQUAL(a.modPow(p - BigInteger::ONE, p), BigInteger::ONE);
+    BigInteger even = p + BigInteger::ONE;
+    EXPECT_EQUAL(a.modPow(BigInteger(1000), even), a.pow(1000) % even);
+
+    // textbook RSA round trip
+    BigInteger q = BigInteger::TWO.pow(607) - BigInteger::ONE;
+    BigInteger n = p * q;
+    BigInteger phi = (p - BigInteger::ONE) * (q - BigInteger::ONE);
+    BigInteger e = 65537;
+    BigInteger d = e.modInverse(phi);
+    EXPECT_EQUAL((e * d) % phi, BigInteger::ONE);
+    BigInteger message("31415926535897932384626433832795028841971693993751");
+    EXPECT_EQUAL(message.modPow(e, n).modPow(d, n), message);
+    EXPECT_ERROR(BigInteger(6).modInverse(9));
+}
+
+PROVIDED_TEST("BigInteger, conversions, streams, and hashing") {
+    EXPECT(BigInteger::MAX_INT.isInt());
+    EXPECT(!(BigInteger::MAX_INT + BigInteger::ONE).isInt());
+    EXPECT(BigInteger::MIN_LONG.isLong());
+    EXPECT(!(BigInteger::MIN_LONG - BigInteger::ONE).isLong());
+    EXPECT_EQUAL(BigInteger::MIN_INT.toInt(), INT_MIN);
+    EXPECT_EQUAL((int) BigInteger(-42), -42);
+    EXPECT_ERROR(BigInteger::MAX_ULONG.toLong());
+    EXPECT_EQUAL(BigInteger(5).bitLength(), 3);
+    EXPECT_EQUAL(BigInteger::ZERO.bitLength(), 0);
+    EXPECT_EQUAL(BigInteger(3).max(BigInteger(-4)), BigInteger(3));
+    EXPECT_EQUAL(BigInteger(3).min(BigInteger(-4)), BigInteger(-4));
+    EXPECT(BigInteger(-4).isNegative() && !BigInteger::ZERO.isPositive() && BigInteger::ZERO.isNonNegative());
+
+    std::istringstream input("123456789012345678901234567890 -ff oops");
+    BigInteger b1;
+    BigInteger b2;
+    BigInteger b3 = 7;
+    input >> b1 >> std::hex >> b2;
+    EXPECT_EQUAL(b1.toString(), "123456789012345678901234567890");
+    EXPECT_EQUAL(b2, BigInteger(-255));
+    EXPECT(!(input >> b3));
+    EXPECT_EQUAL(b3, BigInteger(7));
+    std::ostringstream output;
+    output << b1 << " " << std::hex << b2;
+    EXPECT_EQUAL(output.str(), "123456789012345678901234567890 -ff");
+
+    BigInteger sum = BigInteger("98765432100000000000") + BigInteger("9876543210");
+    EXPECT_EQUAL(hashCode(sum), hashCode(BigInteger("98765432109876543210")));
+}
+
+PROVIDED_TEST("BigInteger, time operations against old string implementation") {
+    std::string x = makeNumber(300, 1).toString();   // about 5800 digits each
+    std::string y = makeNumber(300, 2).toString();
+    std::string expected;
+    TIME_OPERATION(x.length(), expected = stringMultiply(x, y));
+
+    BigInteger bx(x);
+    BigInteger by(y);
+    BigInteger product;
+    TIME_OPERATION(x.length(), product = bx * by);
+    EXPECT_EQUAL(product.toString(), expected);
+
+    BigInteger big = makeNumber(20000, 3);   // about 385000 digits
+    BigInteger bigger;
+    std::string decimal;
+    TIME_OPERATION(20000, bigger = big * big);
+    TIME_OPERATION(20000, decimal = big.toString());
+    BigInteger parsed;
+    TIME_OPERATION(20000, parsed = BigInteger(decimal));
+    EXPECT_EQUAL(parsed, big);
+    BigInteger quotient;
+    TIME_OPERATION(20000, quotient = bigger / big);
+    EXPECT_EQUAL(quotient, big);
+
+    BigInteger modulus = BigInteger::TWO.pow(2203) - BigInteger::ONE;   // prime
+    BigInteger result;
+    TIME_OPERATION(2203, result = BigInteger(3).modPow(modulus - BigInteger::ONE, modulus));
+    EXPECT_EQUAL(result, BigInteger::ONE);
+}
@@ -0,0 +1,274 @@
+/*
+ * Test file for verifying the Stanford C++ lib BitVector, BitQueue, and
+ * bit stream classes.
+ */
+
+#include "bitqueue.h"
+#include "bitstream.h"
+#include "bitvector.h"
+#include "hashset.h"
+#include "queue.h"
+#include "common.h"
+#include "SimpleTest.h"
+#include <sstream>
+#include <string>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
+/*
+ * A one-bit type like the Bit class in the Huffman assignment, with a Queue
+ * specialization like the one in that assignment's bits.h.
+ */
+class TestBit {
+public:
+    TestBit() = default;
+    TestBit(int value) : _value(value != 0) {}
+    bool operator ==(const TestBit& other) const { return _value == other._value; }
+
+private:
+    bool _value = false;
+};
+
+template <>
+class Queue<TestBit> : public stanfordcpplib::collections::PackedBitQueue<TestBit> {
+public:
+    using PackedBitQueue::PackedBitQueue;
+};
+
+template class stanfordcpplib::collections::PackedBitQueue<TestBit>;
+
+/*
+ * Returns test data in which most bytes are below 16, as in a skewed
+ * text, built from a simple generator so that the tests are repeatable.
+ */
+static std::string makeData(int length) {
+    std::string data(length, '\0');
+    uint32_t state = 12345;
+    for (int i = 0; i < length; i++) {
+        state = state * 1103515245 + 12345;
+        int value = (state >> 16) & 0xff;
+        data[i] = (char) ((state >> 8) % 3 == 0 ? value : value & 15);
+    }
+    return data;
+}
+
+/*
+ * Encodes the data with a small prefix code: a byte below 16 is a 0 bit
+ * followed by its 4 bits, and any other byte is a 1 bit followed by its 8.
+ * The first version queues one bit at a time in a Queue<bool> and writes
+ * one byte at a time, as the Huffman starter code used to; the second uses
+ * BitQueue and BitWriter.
+ */
+static std::string encodeBitByBit(const std::string& data) {
+    Queue<bool> bits;
+    for (char ch : data) {
+        unsigned char byte = (unsigned char) ch;
+        int width = byte < 16 ? 4 : 8;
+        bits.enqueue(byte >= 16);
+        for (int i = 0; i < width; i++) {
+            bits.enqueue((byte >> i) & 1);
+        }
+    }
+    std::ostringstream out;
+    int buffer = 0;
+    int count = 0;
+    while (!bits.isEmpty()) {
+        buffer |= bits.dequeue() << count;
+        if (++count == 8) {
+            out.put((char) buffer);
+            buffer = 0;
+            count = 0;
+        }
+    }
+    if (count > 0) {
+        out.put((char) buffer);
+    }
+    return out.str();
+}
+
+static std::string encodePacked(const std::string& data) {
+    BitQueue bits;
+    for (char ch : data) {
+        unsigned char byte = (unsigned char) ch;
+        if (byte < 16) {
+            bits.enqueueBits(byte << 1, 5);
+        } else {
+            bits.enqueueBits((byte << 1) | 1, 9);
+        }
+    }
+    std::ostringstream out;
+    BitWriter writer(out);
+    while (!bits.isEmpty()) {
+        int count = std::min(bits.size(), 64);
+        writer.writeBits(bits.dequeueBits(count), count);
+    }
+    writer.flush();
+    return out.str();
+}
+
+static std::string decode(const std::string& encoded, int length) {
+    std::istringstream in(encoded);
+    BitReader reader(in);
+    std::string data;
+    for (int i = 0; i < length; i++) {
+        data += (char) reader.readBits(reader.readBit() == 1 ? 8 : 4);
+    }
+    return data;
+}
+
+PROVIDED_TEST("BitVector, basic") {
+    BitVector bits;
+    EXPECT(bits.isEmpty());
+    bits.add(true);
+    bits.add(false);
+    bits.addBits(0b110, 3);
+    EXPECT_EQUAL(bits.size(), 5);
+    EXPECT_EQUAL(bits.toString(), "{1, 0, 0, 1, 1}");
+    EXPECT_EQUAL(bits.count(), 3);
+    EXPECT_EQUAL(bits.getBits(1, 4), 0b1100ULL);
+
+    bits.set(1, true);
+    EXPECT(bits[1]);
+    EXPECT_EQUAL(bits, BitVector({1, 1, 0, 1, 1}));
+    EXPECT_ERROR(bits.get(5));
+    EXPECT_ERROR(bits.getBits(3, 3));
+
+    std::string str;
+    for (bool bit : bits) {
+        str += bit ? '1' : '0';
+    }
+    EXPECT_EQUAL(str, "11011");
+
+    BitVector ones(70, true);
+    EXPECT_EQUAL(ones.count(), 70);
+    EXPECT_EQUAL(ones.getBits(60, 10), 0x3ffULL);
+    BitVector zeros(70);
+    zeros.addBits(~0ULL, 64);
+    EXPECT_EQUAL(zeros.getBits(60, 64), ~0ULL << 10);
+    EXPECT_EQUAL(zeros.getBits(64, 64), ~0ULL << 6);
+}
+
+PROVIDED_TEST("BitVector, hashCode") {
+    BitVector bits {1, 0, 1, 1};
+    BitVector copy = bits;
+    EXPECT_EQUAL(hashCode(bits), hashCode(copy));
+    HashSet<BitVector> set {bits, copy, BitVector(), BitVector {1, 0, 1}};
+    EXPECT_EQUAL(set.size(), 3);
+}
+
+PROVIDED_TEST("BitQueue, basic") {
+    BitQueue queue {1, 0, 1};
+    EXPECT_EQUAL(queue.toString(), "{1, 0, 1}");
+    queue.enqueueBits(0xabcdULL, 16);
+    EXPECT_EQUAL(queue.size(), 19);
+    EXPECT_EQUAL(queue.dequeue(), true);
+    EXPECT_EQUAL(queue.peek(), false);
+    EXPECT_EQUAL(queue.peekBits(2), 0b10ULL);
+    EXPECT_EQUAL(queue.dequeueBits(2), 0b10ULL);
+    EXPECT_EQUAL(queue.dequeueBits(16), 0xabcdULL);
+    EXPECT(queue.isEmpty());
+    EXPECT_ERROR(queue.dequeue());
+    EXPECT_ERROR(queue.peek());
+
+    queue.enqueueBits(7, 3);
+    EXPECT_ERROR(queue.dequeueBits(4));
+}
+
+PROVIDED_TEST("BitQueue, compare") {
+    BitQueue q1 {0, 1, 1, 0};
+    BitQueue q2 {0, 1, 0, 1, 1};
+    testCompareOperators(q1, q2, GreaterThan);
+    testCompareOperators(q2, q1, LessThan);
+    testCompareOperators(q1, q1, EqualTo);
+    testCompareOperators(BitQueue {0, 1}, q1, LessThan);
+
+    /* Equal contents compare equal even when stored at different offsets. */
+    BitQueue shifted;
+    shifted.enqueueBits(0, 37);
+    shifted.dequeueBits(37);
+    shifted.enqueueBits(0b0110, 4);
+    EXPECT_EQUAL(shifted, q1);
+    EXPECT_EQUAL(hashCode(shifted), hashCode(q1));
+}
+
+PROVIDED_TEST("BitQueue, interleaved") {
+    /* Feed and drain at once, so the queue has to release its front words. */
+    BitQueue queue;
+    uint64_t nextIn = 0;
+    uint64_t nextOut = 0;
+    for (int round = 0; round < 20000; round++) {
+        for (int i = 0; i < 3; i++) {
+            queue.enqueueBits(nextIn++, 20);
+        }
+        for (int i = 0; i < 2; i++) {
+            EXPECT_EQUAL(queue.dequeueBits(20), nextOut++);
+        }
+    }
+    EXPECT_EQUAL(queue.size(), 20000 * 20);
+    while (!queue.isEmpty()) {
+        EXPECT_EQUAL(queue.dequeueBits(20), nextOut++);
+    }
+    EXPECT_EQUAL(nextOut, nextIn);
+}
+
+PROVIDED_TEST("BitWriter and BitReader, round trip") {
+    std::ostringstream out;
+    {
+        BitWriter writer(out);
+        writer.writeBit(true);
+        writer.writeBits(0x5a, 8);
+        writer.writeBits(0x123456789abcdef0ULL, 64);
+        for (int i = 0; i < 1000; i++) {
+            writer.writeBits(i, 1 + i % 64);
+        }
+    }
+    std::string bytes = out.str();
+    EXPECT_EQUAL((unsigned char) bytes[0], 0xb5);
+    EXPECT_EQUAL((unsigned char) bytes[1], 0xe0);
+
+    std::istringstream in(bytes);
+    BitReader reader(in);
+    EXPECT_EQUAL(reader.readBit(), 1);
+    EXPECT_EQUAL(reader.readBits(8), 0x5aULL);
+    EXPECT_EQUAL(reader.readBits(64), 0x123456789abcdef0ULL);
+    for (int i = 0; i < 1000; i++) {
+        int count = 1 + i % 64;
+        uint64_t mask = count == 64 ? ~0ULL : (1ULL << count) - 1;
+        EXPECT_EQUAL(reader.readBits(count), i & mask);
+    }
+    while (reader.hasMoreBits()) {
+        EXPECT_EQUAL(reader.readBit(), 0);
+    }
+    EXPECT_EQUAL(reader.readBit(), -1);
+    EXPECT_ERROR(reader.readBits(1));
+}
+
+PROVIDED_TEST("Queue, packed Bit specialization") {
+    Queue<TestBit> queue {1, 0, 1, 1};
+    EXPECT_EQUAL(queue.size(), 4);
+    EXPECT_EQUAL(queue.toString(), "{1, 0, 1, 1}");
+    EXPECT(queue.peek() == 1);
+    EXPECT(queue.dequeue() == 1);
+    queue.enqueue(0);
+    EXPECT_EQUAL(queue.dequeueBits(4), 0b0110ULL);
+    EXPECT_ERROR(queue.dequeue());
+
+    Queue<TestBit> other {0, 1};
+    queue.enqueueBits(0b10, 2);
+    EXPECT(queue == other);
+}
+
+PROVIDED_TEST("BitQueue, time encoding") {
+    const int length = 16 * 1000 * 1000;
+    std::string data = makeData(length);
+    std::string bitByBit;
+    std::string packed;
+    TIME_OPERATION(length / 8, bitByBit = encodeBitByBit(data.substr(0, length / 8)));
+    TIME_OPERATION(length, packed = encodePacked(data));
+    EXPECT_EQUAL(packed.substr(0, bitByBit.size() - 1), bitByBit.substr(0, bitByBit.size() - 1));
+
+    std::string decoded;
+    TIME_OPERATION(length, decoded = decode(packed, length));
+    EXPECT(decoded == data);
+}
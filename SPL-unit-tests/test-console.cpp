@@ -9,6 +9,9 @@
 #include "gconsolewindow.h"
 #include "SimpleTest.h"
 
+// redirects console input/output, which is shared by all tests
+SERIAL_TEST_GROUP();
+
 using namespace std;
 
 MANUAL_TEST("console animation") {
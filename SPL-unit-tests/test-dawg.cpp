@@ -7,6 +7,9 @@
 #include "splversion.h"
 #include "SimpleTest.h"
 
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
 static TrieLexicon *gTrie;
 
 static DawgLexicon loadDawg(std::string name) {
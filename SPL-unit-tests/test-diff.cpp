@@ -0,0 +1,161 @@
+/*
+ * Test file for verifying the Stanford C++ lib diff functions.
+ */
+
+#include "diff.h"
+#include "common.h"
+#include "SimpleTest.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
+using namespace diff;
+
+/* Splits text into lines the way diff does. */
+static std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream input(text);
+    std::string line;
+    while (std::getline(input, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/*
+ * Applies the hunks to the lines of s1 and checks that the result is s2,
+ * and that lines outside the hunks are equal.  Returns the number of
+ * changed lines.
+ */
+static int checkHunks(const std::string& s1, const std::string& s2, DiffAlgorithm algorithm) {
+    std::vector<std::string> lines1 = splitLines(s1);
+    std::vector<std::string> lines2 = splitLines(s2);
+    std::vector<std::string> patched;
+    int pos = 0;
+    int changes = 0;
+    for (const DiffHunk& hunk : diffHunks(s1, s2, IGNORE_NONE, algorithm)) {
+        patched.insert(patched.end(), lines1.begin() + pos, lines1.begin() + hunk.start1);
+        patched.insert(patched.end(), lines2.begin() + hunk.start2, lines2.begin() + hunk.end2);
+        changes += (hunk.end1 - hunk.start1) + (hunk.end2 - hunk.start2);
+        pos = hunk.end1;
+    }
+    patched.insert(patched.end(), lines1.begin() + pos, lines1.end());
+    EXPECT(patched == lines2);
+    return changes;
+}
+
+/* Returns the number of lines changed in a shortest edit script, by dynamic programming. */
+static int editDistance(const std::string& s1, const std::string& s2) {
+    std::vector<std::string> a = splitLines(s1);
+    std::vector<std::string> b = splitLines(s2);
+    std::vector<std::vector<int>> lcs(a.size() + 1, std::vector<int>(b.size() + 1, 0));
+    for (size_t i = 1; i <= a.size(); i++) {
+        for (size_t j = 1; j <= b.size(); j++) {
+            lcs[i][j] = a[i - 1] == b[j - 1] ? lcs[i - 1][j - 1] + 1
+                                             : std::max(lcs[i - 1][j], lcs[i][j - 1]);
+        }
+    }
+    return (int) (a.size() + b.size()) - 2 * lcs[a.size()][b.size()];
+}
+
+/* Returns a text of the given number of lines drawn from a small alphabet. */
+static std::string randomText(int lines, int alphabet, uint32_t& state) {
+    std::string text;
+    for (int i = 0; i < lines; i++) {
+        state = state * 1103515245 + 12345;
+        text += (char) ('a' + (state >> 16) % alphabet);
+        text += '\n';
+    }
+    return text;
+}
+
+PROVIDED_TEST("diff, flags") {
+    EXPECT(diffPass("Hello, World!\n", "hello world"));
+    EXPECT(!diffPass("Hello, World!\n", "hello world", DIFF_STRICT_FLAGS));
+    EXPECT(diffPass("a  \nb\n\n\n", "a\nb", DIFF_STRICT_FLAGS));
+    EXPECT(!diffPass("a\n\nb", "a\nb", DIFF_STRICT_FLAGS));
+    EXPECT(diffPass("a\n\nb", "a\nb", IGNORE_BLANKLINES));
+    EXPECT(diffPass("x = 3.14159\r\n", "x = 3.1", IGNORE_AFTERDECIMAL));
+    EXPECT(diffPass("count: 42", "count: 17", IGNORE_NUMBERS));
+    EXPECT(diffPass("count: 42", "total  42", IGNORE_NONNUMBERS));
+    EXPECT(diffPass("abc\nxyz", "zyx\nbca", IGNORE_CHARORDER | IGNORE_LINEORDER));
+    EXPECT(!diffPass("abc\nxyz", "zyx\nbca", IGNORE_LINEORDER));
+    EXPECT(diffPass("anything", "else", IGNORE_EVERYTHING));
+    EXPECT(isDiffMatch(diff::diff("A\nB\n", "a\nb\n")));
+}
+
+PROVIDED_TEST("diff, report") {
+    std::string expected = "one\ntwo\nthree\nfour\nfive\n";
+    std::string student  = "zero\none\nthree\nFOUR!\nfive\nsix\n";
+    EXPECT_EQUAL(diff::diff(expected, student, DIFF_STRICT_FLAGS),
+                 "Student line 1 added before line 1\n"
+                 "STUDENT  > zero\n"
+                 "\n"
+                 "Line 2 deleted near student line 3\n"
+                 "EXPECTED < two\n"
+                 "\n"
+                 "Line 4 does not match\n"
+                 "EXPECTED < four\n"
+                 "STUDENT  > FOUR!\n"
+                 "\n"
+                 "Student line 6 added after line 5\n"
+                 "STUDENT  > six");
+    EXPECT(diff::diff(expected, student).find("FOUR") == std::string::npos);
+
+    Vector<DiffHunk> hunks = diffHunks("a\n\nb\nc\n", "a\nc\n", IGNORE_BLANKLINES);
+    EXPECT_EQUAL(hunks.size(), 1);
+    EXPECT_EQUAL(hunks[0].start1, 2);
+    EXPECT_EQUAL(hunks[0].end1, 3);
+    EXPECT_EQUAL(hunks[0].start2, 1);
+    EXPECT_EQUAL(hunks[0].end2, 1);
+}
+
+PROVIDED_TEST("diff, algorithms") {
+    uint32_t state = 1;
+    for (int trial = 0; trial < 200; trial++) {
+        std::string s1 = randomText(trial % 40, 2 + trial % 5, state);
+        std::string s2 = randomText((trial * 7) % 40, 2 + trial % 5, state);
+        int shortest = editDistance(s1, s2);
+        EXPECT_EQUAL(checkHunks(s1, s2, DIFF_MYERS), shortest);
+        EXPECT(checkHunks(s1, s2, DIFF_HISTOGRAM) >= shortest);
+        EXPECT_EQUAL(diffPass(s1, s2, IGNORE_NONE), shortest == 0);
+    }
+}
+
+PROVIDED_TEST("diff, time on a million lines") {
+    const int lines = 1000 * 1000;
+    std::string expected;
+    std::string student;
+    uint32_t state = 7;
+    for (int i = 0; i < lines; i++) {
+        std::string line = "Line " + std::to_string(i) + ": value " + std::to_string(i * 31 % 977);
+        expected += line + "\n";
+        state = state * 1103515245 + 12345;
+        int roll = (state >> 16) % 1000;
+        if (roll == 0) {
+            continue;
+        } else if (roll == 1) {
+            student += "extra output\n";
+        } else if (roll == 2) {
+            student += "line " + std::to_string(i) + " VALUE wrong\n";
+            continue;
+        }
+        student += line + "\n";
+    }
+
+    bool pass = true;
+    TIME_OPERATION(lines, pass = diffPass(expected, expected + " \n"));
+    EXPECT(pass);
+    TIME_OPERATION(lines, pass = diffPass(expected, student));
+    EXPECT(!pass);
+
+    std::string report;
+    TIME_OPERATION(lines, report = diff::diff(expected, student, DIFF_STRICT_FLAGS, DIFF_HISTOGRAM));
+    std::string myersReport;
+    TIME_OPERATION(lines, myersReport = diff::diff(expected, student, DIFF_STRICT_FLAGS, DIFF_MYERS));
+    EXPECT(!isDiffMatch(report));
+    EXPECT_EQUAL(checkHunks(expected, student, DIFF_HISTOGRAM), checkHunks(expected, student, DIFF_MYERS));
+}
@@ -5,6 +5,11 @@
 #include "SimpleTest.h"
 #include "filelib.h"
 #include "strlib.h"
+#include <atomic>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
 using namespace std;
 
 PROVIDED_TEST("Test filelib path utility functions") {
@@ -94,3 +99,253 @@ PROVIDED_TEST("Test filelib read/write line endings") {
     EXPECT(!fileExists("output"));
 }
 
+
+static string tempFilename(const string& name) {
+    return getTempDirectory() + getDirectoryPathSeparator() + name + "-" + integerToString(time(0));
+}
+
+static Vector<string> mappedLines(const MappedFile& file) {
+    Vector<string> lines;
+    for (string_view line : file.lines()) {
+        lines.add(string(line));
+    }
+    return lines;
+}
+
+PROVIDED_TEST("Test filelib readEntireFile and MappedFile") {
+    string filename = tempFilename("mapped");
+    string text = "a\r\nb\n\nc";
+    EXPECT(writeEntireFile(filename, text));
+    EXPECT_EQUAL(readEntireFile(filename), text);
+    EXPECT_EQUAL(fileSize(filename), text.length());
+
+    MappedFile file(filename);
+    EXPECT(file.isOpen());
+    EXPECT_EQUAL(file.size(), text.length());
+    EXPECT(file.text() == text);
+    EXPECT_EQUAL(mappedLines(file), {"a", "b", "", "c"});
+    ifstream input(filename, ios::binary);
+    EXPECT_EQUAL(readLines(input), {"a\r", "b", "", "c"});
+
+    MappedFile moved = std::move(file);
+    EXPECT(!file.isOpen());
+    EXPECT_EQUAL(mappedLines(moved), {"a", "b", "", "c"});
+    moved.close();
+    EXPECT(!moved.isOpen());
+
+    EXPECT(writeEntireFile(filename, "only\n"));
+    EXPECT(moved.open(filename));
+    EXPECT_EQUAL(mappedLines(moved), {"only"});
+    EXPECT(writeEntireFile(filename, ""));
+    EXPECT(moved.open(filename));
+    EXPECT(moved.text().empty());
+    EXPECT(moved.lines().begin() == moved.lines().end());
+    moved.close();
+    deleteFile(filename);
+
+    string contents;
+    EXPECT(!readEntireFile(filename, contents));
+    EXPECT_EQUAL(fileSize(filename), -1);
+    EXPECT(!moved.open(filename));
+    EXPECT_ERROR(readEntireFile(filename));
+    EXPECT_ERROR(MappedFile(filename).size());
+}
+
+PROVIDED_TEST("Test filelib splitLineChunks and forEachLineChunk") {
+    string text;
+    for (int i = 0; i < 1000; i++) {
+        text += "line " + integerToString(i) + (i % 7 == 0 ? string(200, 'x') : "") + "\n";
+    }
+    text += "no newline";
+    for (int count : {1, 2, 3, 8, 5000}) {
+        Vector<string_view> chunks = splitLineChunks(text, count);
+        EXPECT(chunks.size() <= count);
+        string joined;
+        for (int i = 0; i < chunks.size(); i++) {
+            EXPECT(!chunks[i].empty());
+            EXPECT(i == chunks.size() - 1 || chunks[i].back() == '\n');
+            joined += string(chunks[i]);
+        }
+        EXPECT_EQUAL(joined, text);
+    }
+    EXPECT_EQUAL(splitLineChunks("one long line", 4).size(), 1);
+    EXPECT_EQUAL(splitLineChunks("", 4).size(), 0);
+    EXPECT_ERROR(splitLineChunks(text, 0));
+
+    Vector<int> counts(4);
+    forEachLineChunk(text, [&](int index, string_view chunk) {
+        for (string_view line : LineRange(chunk)) {
+            if (line.find('x') != string_view::npos) counts[index]++;
+        }
+    }, 4);
+    EXPECT_EQUAL(counts[0] + counts[1] + counts[2] + counts[3], 143);
+    EXPECT_ERROR(forEachLineChunk(text, [](int index, string_view) {
+        if (index == 2) error("chunk failed");
+    }, 4));
+}
+
+static int countLines(const Vector<string>& lines) {
+    return lines.size();
+}
+
+static int countLines(LineRange range) {
+    int count = 0;
+    for (string_view line : range) {
+        count += !line.empty();
+    }
+    return count;
+}
+
+PROVIDED_TEST("Time filelib reading a large file") {
+    string filename = tempFilename("large");
+    string line = "2026-10-19 12:00:00 INFO request served in 12 ms from cache\n";
+    string text;
+    for (int i = 0; i < 1000000; i++) {
+        text += line;
+    }
+    EXPECT(writeEntireFile(filename, text));
+    int64_t size = fileSize(filename);
+    EXPECT_EQUAL(size, text.length());
+
+    string contents;
+    ifstream input(filename, ios::binary);
+    TIME_OPERATION(size, contents = readEntire(input));
+    EXPECT(contents == text);
+    TIME_OPERATION(size, contents = readEntireFile(filename));
+    EXPECT(contents == text);
+    int lines = 0;
+    input.close();
+    input.open(filename, ios::binary);
+    TIME_OPERATION(size, lines = countLines(readLines(input)));
+    EXPECT_EQUAL(lines, 1000000);
+
+    MappedFile file;
+    TIME_OPERATION(size, file.open(filename));
+    TIME_OPERATION(size, lines = countLines(file.lines()));
+    EXPECT_EQUAL(lines, 1000000);
+    Vector<int> counts(8);
+    TIME_OPERATION(size, forEachLineChunk(file.text(), [&](int index, string_view chunk) {
+        counts[index] = countLines(LineRange(chunk));
+    }, 8));
+    lines = 0;
+    for (int count : counts) {
+        lines += count;
+    }
+    EXPECT_EQUAL(lines, 1000000);
+    file.close();
+    deleteFile(filename);
+}
+
+/* Deletes a directory and everything in it; children sort after their parents. */
+static void deleteTree(const string& root) {
+    Vector<DirectoryEntry> entries = walkDirectory(root);
+    for (int i = entries.size() - 1; i >= 0; i--) {
+        deleteFile(entries[i].path);
+    }
+    deleteFile(root);
+}
+
+static Vector<string> walkedNames(const string& root, const WalkOptions& options) {
+    Vector<string> names;
+    for (const DirectoryEntry& entry : walkDirectory(root, options)) {
+        names.add(entry.path.substr(root.length() + 1) + (entry.isDirectory ? "/" : ""));
+    }
+    return names;
+}
+
+PROVIDED_TEST("Test filelib walkDirectory") {
+    string root = tempFilename("walk");
+    string sep = getDirectoryPathSeparator();
+    createDirectoryPath(root + sep + "sub" + sep + "deeper");
+    for (string name : {"a.txt", "b.cpp", "sub/c.txt", "sub/deeper/d.txt", "sub/deeper/e.cpp"}) {
+        EXPECT(writeEntireFile(root + sep + stringReplace(name, "/", sep), name));
+    }
+
+    WalkOptions options;
+    Vector<string> all = {"a.txt", "b.cpp", "sub/", "sub/c.txt", "sub/deeper/",
+                          "sub/deeper/d.txt", "sub/deeper/e.cpp"};
+    EXPECT_EQUAL(stringReplace(stringJoin(walkedNames(root, options), ","), sep, "/"),
+                 stringJoin(all, ","));
+    options.threadCount = 4;
+    EXPECT_EQUAL(walkedNames(root, options).size(), all.size());
+    options.pattern = "*.txt";
+    EXPECT_EQUAL(walkedNames(root, options).size(), 3);
+    options.pattern = "";
+    options.maxDepth = 0;
+    EXPECT_EQUAL(walkedNames(root, options), {"a.txt", "b.cpp", "sub/"});
+    options.maxDepth = -1;
+    options.filesOnly = true;
+    EXPECT_EQUAL(walkedNames(root, options).size(), 5);
+
+    int depthTwo = 0;
+    Vector<DirectoryEntry> entries = walkDirectory(root);
+    for (const DirectoryEntry& entry : entries) {
+        depthTwo += entry.depth == 2;
+        EXPECT_EQUAL(getTail(entry.path), entry.name);
+    }
+    EXPECT_EQUAL(depthTwo, 2);
+
+    int visited = 0;
+    walkDirectory(root, [&](const DirectoryEntry& entry) {
+        visited++;
+        return entry.name != "deeper";
+    });
+    EXPECT_EQUAL(visited, 5);
+    EXPECT_ERROR(walkDirectory(root, [](const DirectoryEntry&) -> bool {
+        error("stop");
+    }, options));
+    EXPECT_ERROR(walkDirectory(root + sep + "missing"));
+
+    deleteTree(root);
+    EXPECT(!fileExists(root));
+}
+
+/* Walks a tree the way clients did before walkDirectory existed. */
+static int countRecursively(const string& dir) {
+    int count = 0;
+    for (const string& name : listDirectory(dir)) {
+        string path = dir + "/" + name;
+        count++;
+        if (isDirectory(path)) {
+            count += countRecursively(path);
+        } else {
+            isFile(path);
+        }
+    }
+    return count;
+}
+
+static int countWalked(const string& dir, int threadCount) {
+    std::atomic<int> count(0);
+    WalkOptions options;
+    options.threadCount = threadCount;
+    walkDirectory(dir, [&count](const DirectoryEntry&) {
+        count++;
+        return true;
+    }, options);
+    return count;
+}
+
+PROVIDED_TEST("Time filelib walkDirectory") {
+    string root = tempFilename("walktime");
+    int expected = 0;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 10; j++) {
+            string dir = root + "/d" + integerToString(i) + "/e" + integerToString(j);
+            createDirectoryPath(dir);
+            for (int k = 0; k < 25; k++) {
+                writeEntireFile(dir + "/f" + integerToString(k) + ".txt", "");
+            }
+            expected += 26;
+        }
+        expected++;
+    }
+    int count = 0;
+    TIME_OPERATION(expected, count = countRecursively(root));
+    EXPECT_EQUAL(count, expected);
+    TIME_OPERATION(expected, count = countWalked(root, 1));
+    EXPECT_EQUAL(count, expected);
+    TIME_OPERATION(expected, count = countWalked(root, 4));
+    EXPECT_EQUAL(count, expected);
+    deleteTree(root);
+}
@@ -6,19 +6,39 @@
 #include "gbutton.h"
 #include "gcanvas.h"
 #include "gchooser.h"
+#include "gcolor.h"
+#include "gdatatable.h"
 #include "gevent.h"
+#include "gimagecache.h"
+#include "gimagediff.h"
 #include "glabel.h"
+#include "gobjects.h"
+#include "goffscreencanvas.h"
 #include "goptionpane.h"
+#include "gpixelview.h"
 #include "gradiobutton.h"
 #include "gslider.h"
+#include "gspatialindex.h"
 #include "gtable.h"
 #include "gtextfield.h"
+#include "gthread.h"
 #include "gwindow.h"
+#include "random.h"
+#include "strlib.h"
 
+#include <chrono>
+#include <cmath>
 #include <csignal>
+#include <future>
 #include <iostream>
 #include <string>
+#include <thread>
 #include "SimpleTest.h"
+
+// times operations with TIME_OPERATION and changes the global interactor
+// update mode (see AsyncUpdatesGuard), so must not share the processor
+SERIAL_TEST_GROUP();
+
 using namespace std;
 
 MANUAL_TEST("Interactors enable/disable") {
@@ -288,3 +308,1004 @@ MANUAL_TEST("GTable with editing controls") {
     gw->setVisible(true);
     while (gw->isVisible()) {}
 }
+
+PROVIDED_TEST("GRectangle unionWith") {
+    GRectangle a(10, 20, 30, 40);
+    GRectangle b(0, 50, 5, 100);
+    EXPECT_EQUAL(a.unionWith(b), GRectangle(0, 20, 40, 130));
+    EXPECT_EQUAL(b.unionWith(a), GRectangle(0, 20, 40, 130));
+    EXPECT_EQUAL(a.unionWith(GRectangle()), a);
+    EXPECT_EQUAL(GRectangle().unionWith(a), a);
+}
+
+static void drawTestPattern(GCanvas* canvas, int count) {
+    for (int i = 0; i < count; i++) {
+        int x = (i * 37) % 380;
+        int y = (i * 53) % 280;
+        canvas->setColor(i % 2 == 0 ? 0x3366cc : 0xcc6633);
+        if (i % 3 == 0) {
+            canvas->fillRect(x, y, 15, 10);
+        } else if (i % 3 == 1) {
+            canvas->drawOval(x, y, 12, 12);
+        } else {
+            canvas->drawLine(x, y, x + 20, y + 5);
+        }
+        canvas->setPixel(i % 400, i % 300, 0x00ff00);
+    }
+}
+
+PROVIDED_TEST("GCanvas batched drawing matches immediate drawing") {
+    GCanvas immediate(400, 300, 0xffffff);
+    GCanvas batched(400, 300, 0xffffff);
+    drawTestPattern(&immediate, 500);
+
+    batched.beginBatch();
+    EXPECT(batched.isBatching());
+    batched.beginBatch();   // nested batches flush only at the outermost end
+    drawTestPattern(&batched, 500);
+    batched.endBatch();
+    EXPECT(batched.isBatching());
+    batched.endBatch();
+    EXPECT(!batched.isBatching());
+
+    EXPECT_EQUAL(immediate.countDiffPixels(batched), 0);
+    EXPECT_ERROR(batched.endBatch());
+}
+
+static void drawMovingSprite(GCanvas* canvas) {
+    GRect sprite(0, 0, 20, 20);
+    sprite.setFilled(true);
+    for (int i = 0; i < 10; i++) {
+        canvas->setColor(0xcc6633);
+        canvas->fillRect(i * 30, 100, 25, 25);
+        sprite.setLocation(i * 30 + 10, 110);
+        sprite.setFillColor(i % 2 == 0 ? "blue" : "green");
+        canvas->draw(&sprite);   // same object each time, changed in between
+    }
+}
+
+PROVIDED_TEST("GCanvas batched drawing keeps order of reused objects") {
+    GCanvas immediate(400, 300, 0xffffff);
+    GCanvas batched(400, 300, 0xffffff);
+    drawMovingSprite(&immediate);
+
+    batched.beginBatch();
+    drawMovingSprite(&batched);
+    batched.endBatch();
+
+    EXPECT_EQUAL(immediate.countDiffPixels(batched), 0);
+}
+
+PROVIDED_TEST("Time GCanvas drawing with and without batching") {
+    const int n = 5000;
+    GCanvas immediate(400, 300, 0xffffff);
+    GCanvas batched(400, 300, 0xffffff);
+    TIME_OPERATION(n, drawTestPattern(&immediate, n));
+    TIME_OPERATION(n, [&] {
+        batched.beginBatch();
+        drawTestPattern(&batched, n);
+        batched.endBatch();
+    }());
+    EXPECT_EQUAL(immediate.countDiffPixels(batched), 0);
+}
+
+PROVIDED_TEST("PixelView over a Grid") {
+    Grid<int> grid(3, 4, 0);
+    PixelView pixels(grid);
+    EXPECT_EQUAL(pixels.getWidth(), 4);
+    EXPECT_EQUAL(pixels.getHeight(), 3);
+    pixels.setPixel(2, 1, 0xff123456);
+    EXPECT_EQUAL(grid[1][2], (int) 0xff123456);
+    pixels.subview(1, 1, 2, 2).fill(0xff00ff00);
+    EXPECT_EQUAL(grid[1][1], (int) 0xff00ff00);
+    EXPECT_EQUAL(grid[2][2], (int) 0xff00ff00);
+    EXPECT_EQUAL(grid[0][1], 0);
+    EXPECT_EQUAL(grid[1][3], 0);
+    EXPECT_ERROR(pixels.getPixel(4, 0));
+    EXPECT_ERROR(pixels.subview(3, 0, 2, 1));
+
+    Grid<int> copy;
+    pixels.toGrid(copy, 0x00ffffff);
+    EXPECT_EQUAL(copy[1][1], 0x00ff00);
+    EXPECT_EQUAL(copy.numRows(), 3);
+    EXPECT_EQUAL(copy.numCols(), 4);
+}
+
+PROVIDED_TEST("PixelView fromGrid alpha modes") {
+    Grid<int> src = {{0x123456, (int) 0x80abcdef}};
+    Grid<int> dst(1, 2);
+    PixelView pixels(dst);
+    pixels.fromGrid(src, PixelView::ALPHA_KEEP);
+    EXPECT_EQUAL(dst[0][0], 0x123456);
+    EXPECT_EQUAL(dst[0][1], (int) 0x80abcdef);
+    pixels.fromGrid(src, PixelView::ALPHA_OPAQUE);
+    EXPECT_EQUAL(dst[0][0], (int) 0xff123456);
+    EXPECT_EQUAL(dst[0][1], (int) 0xffabcdef);
+    pixels.fromGrid(src, PixelView::ALPHA_FIX);
+    EXPECT_EQUAL(dst[0][0], (int) 0xff123456);
+    EXPECT_EQUAL(dst[0][1], (int) 0x80abcdef);
+}
+
+PROVIDED_TEST("PixelView countDiff and blend") {
+    Grid<int> a(10, 10, (int) 0xff000000);
+    Grid<int> b(10, 10, (int) 0xff000000);
+    PixelView pa(a), pb(b);
+    EXPECT_EQUAL(PixelView::countDiff(pa, pb), 0);
+    b[3][4] = (int) 0xff000001;
+    b[9][9] = (int) 0x7f000000;   // differs only in alpha
+    EXPECT_EQUAL(PixelView::countDiff(pa, pb), 1);
+    EXPECT_EQUAL(PixelView::countDiff(pa, pb, 0xffffffff), 2);
+
+    Grid<int> src(1, 3);
+    src[0][0] = (int) 0xffffffff;   // opaque white
+    src[0][1] = 0x00ffffff;         // transparent white
+    src[0][2] = (int) 0x80ffffff;   // half-transparent white
+    Grid<int> dst(1, 3, (int) 0xff000000);
+    PixelView(dst).blend(PixelView(src));
+    EXPECT_EQUAL(dst[0][0], (int) 0xffffffff);
+    EXPECT_EQUAL(dst[0][1], (int) 0xff000000);
+    EXPECT_EQUAL(dst[0][2], (int) 0xff808080);
+}
+
+PROVIDED_TEST("Time full-canvas pixel effect: per-pixel vs. PixelView") {
+    const int frames = 30;
+    const int width = 1280;
+    const int height = 720;
+    GCanvas canvas(width, height, 0x336699);
+    // one GUI-thread round trip per pixel; a couple of frames is plenty
+    TIME_OPERATION(2, [&] {
+        for (int frame = 0; frame < 2; frame++) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    canvas.setPixel(x, y, canvas.getPixel(x, y) ^ 0xffffff);
+                }
+            }
+        }
+    }());
+    TIME_OPERATION(frames, [&] {
+        for (int frame = 0; frame < frames; frame++) {
+            Grid<int> grid = canvas.getPixels();
+            for (int& pixel : grid) {
+                pixel ^= 0xffffff;
+            }
+            canvas.setPixels(grid);
+        }
+    }());
+    TIME_OPERATION(frames, [&] {
+        for (int frame = 0; frame < frames; frame++) {
+            canvas.editPixels([](PixelView& pixels) {
+                for (int y = 0; y < pixels.getHeight(); y++) {
+                    unsigned int* row = pixels.row(y);
+                    for (int x = 0; x < pixels.getWidth(); x++) {
+                        row[x] ^= 0x00ffffff;
+                    }
+                }
+            });
+        }
+    }());
+    // an even number of inversions in each pass leaves the original color
+    EXPECT_EQUAL(canvas.getPixel(width / 2, height / 2), 0x336699);
+}
+
+PROVIDED_TEST("diffImages tolerance, histogram, and bounds") {
+    Grid<int> a(20, 30, (int) 0xff102030);
+    Grid<int> b(20, 30, (int) 0xff102030);
+    b[5][7] = (int) 0xff102033;    // off by 3 in blue
+    b[12][25] = (int) 0xff902030;  // off by 128 in red
+    b[8][2] = (int) 0x10102030;    // differs only in alpha
+    PixelView pa(a), pb(b);
+
+    ImageDiffResult result = diffImages(pa, pb);
+    EXPECT_EQUAL(result.diffCount, 2);
+    EXPECT_EQUAL(result.comparedCount, 600);
+    EXPECT_EQUAL(result.bounds, GRectangle(7, 5, 19, 8));
+    EXPECT(result.histogram.isEmpty());
+
+    ImageDiffOptions options;
+    options.tolerance = 3;
+    options.compareAlpha = true;
+    options.histogram = true;
+    result = diffImages(pa, pb, options);
+    EXPECT_EQUAL(result.diffCount, 2);
+    EXPECT_EQUAL(result.bounds, GRectangle(2, 8, 24, 5));
+    EXPECT_EQUAL(result.histogram.size(), 256);
+    EXPECT_EQUAL(result.histogram[0], 597);
+    EXPECT_EQUAL(result.histogram[3], 1);
+    EXPECT_EQUAL(result.histogram[128], 1);
+    EXPECT_EQUAL(result.histogram[0xef], 1);
+
+    options.tolerance = 256;
+    EXPECT_ERROR(diffImages(pa, pb, options));
+}
+
+PROVIDED_TEST("diffImages region of interest, size mismatch, and highlight") {
+    Grid<int> a(10, 10, (int) 0xff000000);
+    Grid<int> b(12, 8, (int) 0xff000000);   // 4 rows taller, 2 columns narrower
+    b[1][1] = (int) 0xffffffff;
+    PixelView pa(a), pb(b);
+
+    // overlap is 8x10; a has 2x10 extra, b has 10x2 extra
+    ImageDiffResult result = diffImages(pa, pb);
+    EXPECT_EQUAL(result.comparedCount, 80);
+    EXPECT_EQUAL(result.diffCount, 1 + 20 + 16);
+    EXPECT_EQUAL(result.bounds, GRectangle(0, 0, 10, 12));
+
+    ImageDiffOptions options;
+    options.regionX = 2;
+    options.regionY = 2;
+    options.regionWidth = 100;
+    options.regionHeight = 6;
+    result = diffImages(pa, pb, options);
+    EXPECT_EQUAL(result.diffCount, 12);   // columns 8-9 of rows 2-7
+    EXPECT_EQUAL(result.bounds, GRectangle(8, 2, 2, 6));
+
+    Grid<int> out(12, 10, 0);
+    PixelView highlight(out);
+    diffImages(pa, pb, ImageDiffOptions(), &highlight, 0xff00ff00);
+    EXPECT_EQUAL(out[1][1], (int) 0xff00ff00);
+    EXPECT_EQUAL(out[0][0], 0);
+    EXPECT_EQUAL(out[0][9], (int) 0xff00ff00);
+    EXPECT_EQUAL(out[11][0], (int) 0xff00ff00);
+    EXPECT_EQUAL(out[11][9], 0);   // in neither image
+}
+
+PROVIDED_TEST("diffImages gives the same answer on any number of threads") {
+    Grid<int> a(700, 900);
+    Grid<int> b(700, 900);
+    for (int r = 0; r < a.numRows(); r++) {
+        for (int c = 0; c < a.numCols(); c++) {
+            a[r][c] = (int) (0xff000000 | ((r * 31 + c * 17) & 0xffffff));
+            b[r][c] = (r * c) % 97 == 0 ? a[r][c] ^ 0x80 : a[r][c];
+        }
+    }
+    PixelView pa(a), pb(b);
+    ImageDiffOptions options;
+    options.histogram = true;
+    options.threads = 1;
+    ImageDiffResult serial = diffImages(pa, pb, options);
+    options.threads = 8;
+    ImageDiffResult parallel = diffImages(pa, pb, options);
+    EXPECT_EQUAL(serial.diffCount, parallel.diffCount);
+    EXPECT_EQUAL(serial.bounds, parallel.bounds);
+    EXPECT_EQUAL(serial.histogram, parallel.histogram);
+    EXPECT_EQUAL(serial.histogram[128], serial.diffCount);
+}
+
+PROVIDED_TEST("Time image diff: per-pixel vs. diffImages") {
+    const int runs = 20;
+    Grid<int> a(1080, 1920, (int) 0xff336699);
+    Grid<int> b(1080, 1920, (int) 0xff336699);
+    for (int r = 0; r < b.numRows(); r += 7) {
+        b[r][r] = (int) 0xff000000;
+    }
+    int expected = (b.numRows() + 6) / 7;
+    int count = 0;
+    TIME_OPERATION(runs, [&] {
+        for (int run = 0; run < runs; run++) {
+            count = 0;
+            for (int r = 0; r < a.numRows(); r++) {
+                for (int c = 0; c < a.numCols(); c++) {
+                    if ((a[r][c] & 0xffffff) != (b[r][c] & 0xffffff)) {
+                        count++;
+                    }
+                }
+            }
+        }
+    }());
+    EXPECT_EQUAL(count, expected);
+
+    PixelView pa(a), pb(b);
+    ImageDiffOptions options;
+    options.threads = 1;
+    TIME_OPERATION(runs, [&] {
+        for (int run = 0; run < runs; run++) {
+            count = diffImages(pa, pb, options).diffCount;
+        }
+    }());
+    EXPECT_EQUAL(count, expected);
+
+    options.threads = 0;
+    TIME_OPERATION(runs, [&] {
+        for (int run = 0; run < runs; run++) {
+            count = diffImages(pa, pb, options).diffCount;
+        }
+    }());
+    EXPECT_EQUAL(count, expected);
+}
+
+PROVIDED_TEST("GSpatialIndex query and stacking order") {
+    GRect a(0, 0, 10, 10), b(5, 5, 10, 10), c(500, 500, 10, 10), huge(0, 0, 100000, 100000);
+    GSpatialIndex index(32);
+    index.put(&a, a.getBounds());
+    index.put(&b, b.getBounds());
+    index.put(&c, c.getBounds());
+    index.put(&huge, huge.getBounds());   // too many cells; kept in its own list
+    std::vector<GObject*> found;
+    index.query(8, 8, found);
+    EXPECT_EQUAL(found.size(), 3u);
+    EXPECT(found[0] == &a && found[1] == &b && found[2] == &huge);
+
+    index.moveToBack(&huge);
+    index.swapOrder(&a, &b);
+    index.query(GRectangle(0, 0, 20, 20), found);
+    EXPECT(found[0] == &huge && found[1] == &b && found[2] == &a);
+
+    index.put(&c, GRectangle(0, 0, 10, 10));   // moved
+    index.remove(&a);
+    index.query(8, 8, found);
+    EXPECT_EQUAL(found.size(), 3u);
+    EXPECT(found[2] == &c);
+    index.query(505, 505, found);
+    EXPECT_EQUAL(found.size(), 1u);   // only the huge rectangle
+    EXPECT_EQUAL(index.size(), 3);
+}
+
+PROVIDED_TEST("GSpatialIndex negative coordinates, update, and concurrent queries") {
+    GRect a(-100, -40, 10, 10), b(-5, -5, 10, 10), c(40, 40, 10, 10);
+    GSpatialIndex index(32);
+    index.put(&a, a.getBounds());
+    index.put(&b, b.getBounds());
+    index.update(&c, c.getBounds());   // not in the index, so not added
+    EXPECT(!index.contains(&c));
+    std::vector<GObject*> found;
+    index.query(-95, -35, found);
+    EXPECT(found.size() == 1u && found[0] == &a);
+    index.query(GRectangle(-10, -10, 20, 20), found);
+    EXPECT(found.size() == 1u && found[0] == &b);
+
+    // one thread moves b back and forth while another queries
+    std::thread mover([&index, &b] {
+        for (int i = 0; i < 20000; i++) {
+            index.update(&b, GRectangle(i % 200 - 100, -5, 10, 10));
+        }
+    });
+    bool consistent = true;
+    for (int i = 0; i < 20000; i++) {
+        index.query(GRectangle(-200, -200, 400, 400), found);
+        consistent = consistent && found.size() == 2u && found[0] == &a && found[1] == &b;
+    }
+    mover.join();
+    EXPECT(consistent);
+}
+
+PROVIDED_TEST("GCompound hit-testing is the same with and without a spatial index") {
+    const int count = 2000;
+    GCompound plain, indexed;
+    indexed.setSpatialIndexEnabled(true);
+    Vector<GRect*> rects1, rects2;
+    for (int i = 0; i < count; i++) {
+        double x = randomInteger(0, 1000), y = randomInteger(0, 1000);
+        double w = randomInteger(1, 40), h = randomInteger(1, 40);
+        rects1.add(new GRect(x, y, w, h));
+        rects2.add(new GRect(x, y, w, h));
+        plain.add(rects1[i]);
+        indexed.add(rects2[i]);
+    }
+    EXPECT(indexed.isSpatialIndexEnabled());
+
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 500; i++) {
+            double x = randomInteger(-10, 1050), y = randomInteger(-10, 1050);
+            // corresponding rectangles in the two compounds have the same bounds
+            GObject* hit1 = plain.getElementAt(x, y);
+            GObject* hit2 = indexed.getElementAt(x, y);
+            EXPECT_EQUAL(hit1 == nullptr, hit2 == nullptr);
+            if (hit1 && hit2) {
+                EXPECT_EQUAL(hit1->getBounds(), hit2->getBounds());
+            }
+            EXPECT_EQUAL(plain.contains(x, y), indexed.contains(x, y));
+        }
+        // move, resize, restack, and remove some objects
+        for (int i = round; i < count; i += 7) {
+            double dx = randomInteger(-100, 100), dy = randomInteger(-100, 100);
+            rects1[i]->move(dx, dy);
+            rects2[i]->move(dx, dy);
+            rects1[i]->setSize(rects1[i]->getHeight(), rects1[i]->getWidth());
+            rects2[i]->setSize(rects2[i]->getHeight(), rects2[i]->getWidth());
+        }
+        for (int i = round; i < count; i += 31) {
+            rects1[i]->sendToBack();
+            rects2[i]->sendToBack();
+            rects1[i + 1]->sendForward();
+            rects2[i + 1]->sendForward();
+        }
+        for (int i = round + 3; i < count; i += 101) {
+            plain.remove(rects1[i]);
+            indexed.remove(rects2[i]);
+        }
+    }
+
+    indexed.setSpatialIndexEnabled(false);
+    EXPECT(!indexed.isSpatialIndexEnabled());
+    EXPECT_EQUAL(plain.getElementCount(), indexed.getElementCount());
+    plain.removeAll();
+    indexed.removeAll();
+    for (int i = 0; i < count; i++) {
+        delete rects1[i];
+        delete rects2[i];
+    }
+}
+
+PROVIDED_TEST("Time GCompound animation frame vs. object count") {
+    // each frame moves some sprites and repaints the area around each one,
+    // the way a widget repaints the dirty region after a move
+    const int frames = 20;
+    const int moved = 100;
+    QImage image(1000, 1000, QImage::Format_ARGB32);
+    for (int count : {1000, 10000, 50000}) {
+        for (bool useIndex : {false, true}) {
+            GCompound scene;
+            scene.setSpatialIndexEnabled(useIndex);
+            Vector<GObject*> sprites;
+            for (int i = 0; i < count; i++) {
+                GRect* sprite = new GRect(randomInteger(0, 990), randomInteger(0, 990), 10, 10);
+                sprite->setFilled(true);
+                sprites.add(sprite);
+                scene.add(sprite);
+            }
+            cout << "  " << count << " objects, spatial index " << (useIndex ? "on" : "off") << endl;
+            TIME_OPERATION(frames * moved, [&] {
+                for (int frame = 0; frame < frames; frame++) {
+                    for (int i = 0; i < moved; i++) {
+                        GObject* sprite = sprites[(frame * moved + i) % count];
+                        GRectangle dirty = sprite->getBounds();
+                        sprite->move(randomInteger(-5, 5), randomInteger(-5, 5));
+                        dirty = dirty.unionWith(sprite->getBounds()).enlargedBy(1);
+                        QPainter painter(&image);
+                        painter.setClipRect(QRectF(dirty.x, dirty.y, dirty.width, dirty.height));
+                        scene.draw(&painter);
+                    }
+                    scene.getElementAt(randomInteger(0, 999), randomInteger(0, 999));
+                }
+            }());
+            scene.removeAll();
+            for (GObject* sprite : sprites) {
+                delete sprite;
+            }
+        }
+    }
+}
+
+PROVIDED_TEST("GImageCache shares decoded images between GImages") {
+    GImageCache* cache = GImageCache::instance();
+    cache->clear();
+    int hits = cache->getHitCount();
+    int misses = cache->getMissCount();
+
+    GImage image1("res/stanford.png");
+    GImage image2("res/stanford.png");
+    EXPECT_EQUAL(cache->getMissCount(), misses + 1);
+    EXPECT_EQUAL(cache->getHitCount(), hits + 1);
+    EXPECT_EQUAL(cache->size(), 1);
+    EXPECT(cache->getBytes() > 0);
+    EXPECT_EQUAL(image1.getWidth(), image2.getWidth());
+
+    // changing one image must not affect the other or the cached copy
+    int original = image1.getPixel(0, 0);
+    image2.setPixel(0, 0, original ^ 0xffffff);
+    EXPECT_EQUAL(image1.getPixel(0, 0), original);
+    EXPECT_EQUAL(GImage("res/stanford.png").getPixel(0, 0), original);
+
+    long long maxBytes = cache->getMaxBytes();
+    cache->setMaxBytes(0);
+    EXPECT_EQUAL(cache->size(), 0);
+    GImage image3("res/stanford.png");
+    EXPECT_EQUAL(cache->size(), 0);
+    EXPECT_ERROR(cache->setMaxBytes(-1));
+    cache->setMaxBytes(maxBytes);
+}
+
+PROVIDED_TEST("Time loading and drawing images with and without caching") {
+    const int loads = 200;
+    const int frames = 200;
+    GImageCache* cache = GImageCache::instance();
+    long long maxBytes = cache->getMaxBytes();
+
+    cache->setMaxBytes(0);   // every load decodes the file
+    TIME_OPERATION(loads, [&] {
+        for (int i = 0; i < loads; i++) {
+            GImage image("res/stanford.png");
+        }
+    }());
+    cache->setMaxBytes(maxBytes);
+    TIME_OPERATION(loads, [&] {
+        for (int i = 0; i < loads; i++) {
+            GImage image("res/stanford.png");
+        }
+    }());
+
+    // drawing at twice the native size scales only on the first frame
+    GImage sprite("res/stanford.png");
+    sprite.setSize(sprite.getWidth() * 2, sprite.getHeight() * 2);
+    QImage target(static_cast<int>(sprite.getWidth()), static_cast<int>(sprite.getHeight()),
+                  QImage::Format_ARGB32);
+    TIME_OPERATION(frames, [&] {
+        for (int i = 0; i < frames; i++) {
+            QPainter painter(&target);
+            sprite.draw(&painter);
+        }
+    }());
+}
+
+PROVIDED_TEST("GDataTable batch updates and data sources") {
+    GDataTable table(4, 3);
+    EXPECT_EQUAL(table.numRows(), 4);
+    EXPECT_EQUAL(table.numCols(), 3);
+    EXPECT_EQUAL(table.get(3, 2), "");
+
+    table.setRow(1, {"a", "b", "c", "ignored"});
+    Grid<std::string> block = {{"x", "y"}, {"z", "w"}};
+    table.setRange(2, 1, block);
+    EXPECT_EQUAL(table.get(1, 0), "a");
+    EXPECT_EQUAL(table.get(1, 2), "c");
+    EXPECT_EQUAL(table.get(2, 1), "x");
+    EXPECT_EQUAL(table.get(3, 2), "w");
+    EXPECT_EQUAL(table.get(0, 0), "");
+
+    table.resize(5, 3);
+    EXPECT_EQUAL(table.get(1, 2), "c");
+    EXPECT_EQUAL(table.get(4, 0), "");
+    EXPECT_ERROR(table.get(5, 0));
+    EXPECT_ERROR(table.set(0, 3, "out of bounds"));
+    EXPECT_ERROR(table.setRow(-1, {"x"}));
+    EXPECT_ERROR(table.setRangeBackground(3, 0, 3, 1, 0xff0000));
+    EXPECT(table.inTableBounds(4, 2));
+    EXPECT(!table.inTableBounds(5, 0));
+
+    table.setDataSource(1000000, 4, [](int row, int column) {
+        return integerToString(row * 10 + column);
+    });
+    EXPECT(table.hasDataSource());
+    EXPECT_EQUAL(table.numRows(), 1000000);
+    EXPECT_EQUAL(table.get(999999, 3), "9999993");
+    // a range style is kept as one rectangle, however many rows it spans
+    TIME_OPERATION(1000000, table.setRangeForeground(0, 1, 1000000, 2, 0x0000cc));
+    EXPECT_ERROR(table.set(0, 0, "read-only"));
+    table.setEditable(true);
+    EXPECT(!table.isEditable());
+
+    table.clear();
+    EXPECT(!table.hasDataSource());
+    EXPECT_EQUAL(table.numRows(), 1000000);
+    EXPECT_EQUAL(table.get(999999, 3), "");
+}
+
+static void styleCellsOneAtATime(GDataTable& table, int rows) {
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < table.numCols(); c++) {
+            table.setCellBackground(r, c, (r + c) % 2 == 0 ? 0xeeeeee : 0xffffff);
+        }
+        table.setRangeForeground(r, 0, 1, 2, 0x0000cc);
+    }
+}
+
+PROVIDED_TEST("Time styling GDataTable cells one at a time") {
+    // each style is filed by cell or row, so the cost per call stays flat
+    GDataTable table(4000, 5);
+    TIME_OPERATION(500, styleCellsOneAtATime(table, 500));
+    TIME_OPERATION(4000, styleCellsOneAtATime(table, 4000));
+    table.setRowBackground(0, 0xff0000);
+    table.clearFormatting();
+    EXPECT_EQUAL(table.numRows(), 4000);
+}
+
+PROVIDED_TEST("Time filling GTable vs. GDataTable") {
+    const int rows = 1000;
+    const int cols = 10;
+    Grid<std::string> data(rows, cols);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            data[r][c] = integerToString(r * cols + c);
+        }
+    }
+
+    // one trip to the GUI thread per cell
+    GTable table(rows, cols);
+    TIME_OPERATION(rows * cols, [&] {
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                table.set(r, c, data[r][c]);
+            }
+        }
+    }());
+
+    // one trip to the GUI thread per row, then for the whole grid
+    GDataTable dataTable(rows, cols);
+    TIME_OPERATION(rows * cols, [&] {
+        for (int r = 0; r < rows; r++) {
+            Vector<std::string> values;
+            for (int c = 0; c < cols; c++) {
+                values.add(data[r][c]);
+            }
+            dataTable.setRow(r, values);
+        }
+    }());
+    TIME_OPERATION(rows * cols, dataTable.setData(data));
+    TIME_OPERATION(rows, [&] {
+        for (int r = 0; r < rows; r += 2) {
+            dataTable.setRowBackground(r, 0xeeeeee);
+        }
+    }());
+    EXPECT_EQUAL(dataTable.get(rows - 1, cols - 1), data[rows - 1][cols - 1]);
+}
+
+static void drawThumbnail(GOffscreenCanvas& canvas, int seed) {
+    canvas.clear();
+    canvas.setColor(0x0000ff);
+    canvas.fillRect(10, 10, 60, 40);
+    canvas.setColor(0xff0000);
+    canvas.drawOval(seed % 50, 20, 50, 50);
+    canvas.drawLine(0, 0, canvas.getWidth() - 1, canvas.getHeight() - 1);
+    canvas.drawString("#" + integerToString(seed), 5, 90);
+}
+
+PROVIDED_TEST("GOffscreenCanvas draws and saves without a window") {
+    GOffscreenCanvas canvas(100, 100, "white");
+    EXPECT_EQUAL(canvas.getPixel(50, 50), 0xffffff);
+    canvas.setColor(0x0000ff);
+    canvas.fillRect(10, 10, 20, 20);
+    EXPECT_EQUAL(canvas.getPixel(15, 15), 0x0000ff);
+    EXPECT_EQUAL(canvas.getPixel(50, 50), 0xffffff);
+
+    // added objects sit on top of the background layer but do not change it
+    GRect* rect = new GRect(40, 40, 10, 10);
+    rect->setFilled(true);
+    rect->setFillColor("red");
+    rect->setColor("red");
+    canvas.add(rect);
+    EXPECT_EQUAL(canvas.getPixel(45, 45), 0xffffff);
+    EXPECT_EQUAL(canvas.toQImage().pixel(45, 45) & 0xffffff, 0xff0000u);
+
+    std::string filename = "offscreen-test.png";
+    canvas.save(filename);
+    ImageDiffResult result = diffImageFiles(filename, filename);
+    EXPECT_EQUAL(result.diffCount, 0);
+    EXPECT_EQUAL(result.comparedCount, 100 * 100);
+    deleteFile(filename);
+    canvas.clear();
+    EXPECT_EQUAL(canvas.getElementCount(), 0);
+    EXPECT_EQUAL(canvas.getPixel(15, 15), 0xffffff);
+    delete rect;
+}
+
+PROVIDED_TEST("GOffscreenCanvas renders the same on several threads at once") {
+    const int threads = 4;
+    GOffscreenCanvas expected(120, 100);
+    drawThumbnail(expected, 7);
+
+    std::vector<GOffscreenCanvas*> canvases;
+    for (int i = 0; i < threads; i++) {
+        canvases.push_back(new GOffscreenCanvas(120, 100));
+    }
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back([&canvases, i]() {
+            for (int j = 0; j < 20; j++) {
+                drawThumbnail(*canvases[i], 7);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (GOffscreenCanvas* canvas : canvases) {
+        EXPECT_EQUAL(canvas->getPixelsARGB(), expected.getPixelsARGB());
+        delete canvas;
+    }
+}
+
+PROVIDED_TEST("Time offscreen thumbnail rendering in images per second") {
+    const int images = 2000;
+    int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([t, threads]() {
+                GOffscreenCanvas canvas(120, 100);
+                for (int i = t; i < images; i += threads) {
+                    drawThumbnail(canvas, i);
+                    QImage image = canvas.toQImage();
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        cout << "    " << threads << " thread(s): "
+             << static_cast<int>(images / seconds) << " images/sec" << endl;
+    }
+}
+
+PROVIDED_TEST("GCompound dirty tracking records old and new areas") {
+    GCompound scene;
+    scene.setAutoRepaint(false);
+    GRect rect(10, 10, 20, 20);
+    GOval oval(100, 100, 10, 10);
+    scene.add(rect);
+    scene.add(oval);
+
+    scene.setDirtyTracking(true);
+    rect.setLocation(50, 10);
+    std::vector<GRectangle> dirty;
+    EXPECT(!scene.takeDirtyRegions(dirty));
+    EXPECT_EQUAL(static_cast<int>(dirty.size()), 2);
+    GRectangle area;
+    for (const GRectangle& region : dirty) {
+        area = area.unionWith(region);
+    }
+    EXPECT(area.contains(10, 10));     // where the rect was
+    EXPECT(area.contains(69, 29));     // where it is now
+    EXPECT(!area.intersects(oval.getBounds()));
+
+    // nothing changed since the last take
+    EXPECT(!scene.takeDirtyRegions(dirty));
+    EXPECT(dirty.empty());
+
+    // changes inside a nested compound make the whole scene dirty
+    GCompound group;
+    GRect inner(0, 0, 5, 5);
+    group.add(inner);
+    scene.add(group);
+    scene.takeDirtyRegions(dirty);
+    inner.move(1, 1);
+    EXPECT(scene.takeDirtyRegions(dirty));
+    EXPECT(dirty.empty());
+
+    scene.setDirtyTracking(false);
+    rect.move(5, 5);
+    EXPECT(!scene.takeDirtyRegions(dirty));
+    EXPECT(dirty.empty());
+    scene.removeAll();
+    group.removeAll();
+}
+
+PROVIDED_TEST("GWindow runAnimation paces frames and reports statistics") {
+    GWindow* gw = new GWindow(300, 200);
+    GOval* ball = new GOval(0, 80, 20, 20);
+    ball->setFilled(true);
+    gw->add(ball);
+
+    int calls = 0;
+    double lastElapsed = -1;
+    GFrameStats stats = gw->runAnimation(30, [&](double elapsedMs) {
+        EXPECT(elapsedMs >= lastElapsed);
+        lastElapsed = elapsedMs;
+        ball->setX(elapsedMs / 10);
+        calls++;
+        return calls < 15;
+    });
+    EXPECT_EQUAL(stats.frames, 15);
+    EXPECT_EQUAL(stats.frames, gw->getFrameStats().frames);
+    EXPECT(std::fabs(stats.targetFrameMs - 1000.0 / 30) < 0.01);
+    EXPECT(stats.meanFrameMs > 20 && stats.meanFrameMs < 100);
+    EXPECT(stats.p99FrameMs >= stats.meanFrameMs - 5);
+    EXPECT(stats.maxFrameMs >= stats.p99FrameMs);
+    EXPECT(!gw->getCanvas()->isInFrame());
+    EXPECT(gw->getCanvas()->isAutoRepaint());
+    cout << "    mean " << stats.meanFrameMs << " ms, p99 " << stats.p99FrameMs
+         << " ms, dropped " << stats.droppedFrames
+         << ", work " << stats.meanWorkMs << " ms/frame" << endl;
+
+    EXPECT_ERROR(gw->runAnimation(0, [](double) { return false; }));
+    gw->beginFrame();
+    EXPECT_ERROR(gw->beginFrame());
+    gw->endFrame();
+    EXPECT_ERROR(gw->endFrame());
+
+    gw->remove(ball);
+    delete ball;
+    gw->setVisible(false);
+    gw->close();
+}
+
+PROVIDED_TEST("GWindow runAnimation ends when the window closes") {
+    GWindow* gw = new GWindow(300, 200);
+    int calls = 0;
+    GFrameStats stats = gw->runAnimation(60, [&](double) {
+        if (++calls == 3) {
+            gw->close();
+        }
+        return true;   // never stops on its own
+    });
+    EXPECT_EQUAL(stats.frames, 3);
+    EXPECT(!gw->isVisible());
+}
+
+PROVIDED_TEST("GColor converts names and hex strings both ways") {
+    EXPECT_EQUAL(GColor::convertColorToRGB("red"), 0xFF0000);
+    EXPECT_EQUAL(GColor::convertColorToRGB("Dark Gray"), 0x595959);
+    EXPECT_EQUAL(GColor::convertColorToRGB("LIGHT_GRAY"), 0xBFBFBF);
+    EXPECT_EQUAL(GColor::convertColorToRGB("#7700ff"), 0x7700FF);
+    EXPECT_EQUAL(GColor::convertColorToRGB("#7700FF"), 0x7700FF);
+    EXPECT_EQUAL(GColor::convertColorToARGB("#807700ff"), static_cast<int>(0x807700FF));
+    EXPECT_EQUAL(GColor::convertColorToRGB(""), -1);
+    EXPECT_ERROR(GColor::convertColorToRGB("reddish"));
+    EXPECT_ERROR(GColor::convertColorToRGB("#"));
+    EXPECT_ERROR(GColor::convertColorToRGB("#12345g"));
+    EXPECT_ERROR(GColor::convertColorToRGB("#123456789"));
+
+    EXPECT_EQUAL(GColor::convertRGBToColor(0xFF0000), "red");
+    EXPECT_EQUAL(GColor::convertRGBToColor(0xFF00FF), "purple");
+    EXPECT_EQUAL(GColor::convertRGBToColor(0x7700FF), "#7700FF");
+    EXPECT_EQUAL(GColor::convertRGBToColor(1, 2, 3), "#010203");
+    EXPECT_EQUAL(GColor::convertARGBToColor(static_cast<int>(0x807700FF)), "#807700FF");
+    EXPECT_EQUAL(GColor::convertARGBToColor(255, 255, 0, 0), "#FFFF0000");
+}
+
+PROVIDED_TEST("GColor::intern gives equal handles for equal colors") {
+    GColor::Handle red = GColor::intern("red");
+    EXPECT(red == GColor::intern("#ff0000"));
+    EXPECT(red == GColor::intern(0xFF0000));
+    EXPECT(red != GColor::intern("#80ff0000"));
+    EXPECT_EQUAL(red.toString(), "red");
+    EXPECT_EQUAL(red.getRGB(), 0xFF0000);
+    EXPECT(!red.hasAlpha());
+
+    GColor::Handle clear = GColor::internARGB(0);
+    EXPECT(clear.hasAlpha());
+    EXPECT_EQUAL(clear.toString(), "#00000000");
+    EXPECT(GColor::intern("").isNull());
+
+    GRect rect(0, 0, 10, 10);
+    rect.setColor(GColor::intern("#123456"));
+    EXPECT_EQUAL(rect.getColor(), "#123456");
+    rect.setFillColor(red);
+    EXPECT(rect.isFilled());
+    EXPECT_EQUAL(rect.getFillColor(), "red");
+    rect.setFillColor(GColor::Handle());
+    EXPECT(!rect.isFilled());
+}
+
+PROVIDED_TEST("Time setting GObject colors from strings vs. interned handles") {
+    const int n = 1000000;
+    const std::string names[] = {"red", "#7700ff", "Light Gray", "#123456"};
+    GColor::Handle handles[4];
+    for (int i = 0; i < 4; i++) {
+        handles[i] = GColor::intern(names[i]);
+    }
+    GRect rect(0, 0, 10, 10);
+    cout << "    strings" << endl;
+    TIME_OPERATION(n, [&] {
+        for (int i = 0; i < n; i++) {
+            rect.setFillColor(names[i & 3]);
+        }
+    }());
+    cout << "    handles" << endl;
+    TIME_OPERATION(n, [&] {
+        for (int i = 0; i < n; i++) {
+            rect.setFillColor(handles[i & 3]);
+        }
+    }());
+    EXPECT_EQUAL(rect.getFillColor(), "#123456");
+}
+
+/*
+ * Sets whether interactor setters are asynchronous until the end of the
+ * enclosing scope, restoring the old setting even if a test fails.
+ */
+class AsyncUpdatesGuard {
+public:
+    explicit AsyncUpdatesGuard(bool async)
+            : _old(GInteractor::isAsyncUpdates()) {
+        GInteractor::setAsyncUpdates(async);
+    }
+
+    ~AsyncUpdatesGuard() {
+        GInteractor::setAsyncUpdates(_old);
+    }
+
+private:
+    bool _old;
+};
+
+PROVIDED_TEST("GThread::runOnQtGuiThread rethrows errors in the caller") {
+    EXPECT_ERROR(GThread::runOnQtGuiThread([]() {
+        error("GUI thread function failed");
+    }));
+    int value = 0;
+    GThread::runOnQtGuiThread([&value]() {
+        value = 42;   // the queue still works afterward
+    });
+    EXPECT_EQUAL(value, 42);
+}
+
+PROVIDED_TEST("GThread::post returns results and postCoalesced keeps the last write") {
+    std::future<int> answer = GThread::post([]() {
+        return GThread::iAmRunningOnTheQtGuiThread() ? 42 : -1;
+    });
+    EXPECT_EQUAL(answer.get(), 42);
+
+    std::future<void> failure = GThread::post([]() {
+        error("posted function failed");
+    });
+    EXPECT_ERROR(failure.get());
+
+    int runs = 0;
+    int value = 0;
+    for (int i = 1; i <= 1000; i++) {
+        GThread::postCoalesced(&value, "value", [&runs, &value, i]() {
+            runs++;
+            value = i;
+        });
+    }
+    GThread::waitForPendingUpdates(&value);
+    EXPECT_EQUAL(value, 1000);
+    EXPECT(runs >= 1 && runs <= 1000);
+
+    AsyncUpdatesGuard async(true);
+    GLabel label("start");
+    GTable table(2, 2);
+    for (int i = 0; i < 100; i++) {
+        label.setText(integerToString(i));
+        table.set(1, 1, integerToString(i));
+    }
+    EXPECT_EQUAL(label.getText(), "99");
+    EXPECT_EQUAL(table.get(1, 1), "99");
+}
+
+PROVIDED_TEST("GThread::cancelPendingUpdates drops updates that have not run") {
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    GThread::runOnQtGuiThreadAsync([released]() {
+        released.wait();   // hold the Qt GUI thread so the updates stay queued
+    });
+    int runs = 0;
+    for (int i = 0; i < 10; i++) {
+        GThread::postCoalesced(&runs, "property" + integerToString(i % 2), [&runs]() {
+            runs++;
+        });
+    }
+    GThread::cancelPendingUpdates(&runs);
+    release.set_value();
+    GThread::runOnQtGuiThread([]() {
+        // empty; everything queued before it has run
+    });
+    EXPECT_EQUAL(runs, 0);
+
+    // the target can be updated again afterward
+    GThread::postCoalesced(&runs, "property0", [&runs]() {
+        runs++;
+    });
+    GThread::waitForPendingUpdates(&runs);
+    EXPECT_EQUAL(runs, 1);
+
+    // a widget deleted with updates queued does not get them
+    AsyncUpdatesGuard async(true);
+    GLabel* label = new GLabel("start");
+    for (int i = 0; i < 100; i++) {
+        label->setText(integerToString(i));
+    }
+    delete label;
+    GThread::runOnQtGuiThread([]() {
+        // empty
+    });
+}
+
+PROVIDED_TEST("Time updating 10k labels with synchronous vs. asynchronous setters") {
+    const int count = 10000;
+    const int updates = 5;
+    Vector<GLabel*> labels;
+    for (int i = 0; i < count; i++) {
+        labels.add(new GLabel());
+    }
+
+    for (bool async : {false, true}) {
+        AsyncUpdatesGuard guard(async);
+        cout << "    " << (async ? "asynchronous" : "synchronous") << endl;
+        TIME_OPERATION(count * updates, [&] {
+            for (int u = 0; u < updates; u++) {
+                for (int i = 0; i < count; i++) {
+                    labels[i]->setText(integerToString(u * count + i));
+                }
+            }
+            GThread::post([]() {}).wait();   // until every label is updated
+        }());
+        EXPECT_EQUAL(labels[count - 1]->getText(), integerToString(updates * count - 1));
+    }
+
+    for (GLabel* label : labels) {
+        delete label;
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ * Test file for verifying the Stanford C++ lib LinkedHashMap class.
+ */
+
+#include "linkedhashmap.h"
+#include "hashmap.h"
+#include "common.h"
+#include "SimpleTest.h"
+#include <initializer_list>
+#include <sstream>
+#include <string>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
+/*
+ * Force instantiation of LinkedHashMap on a few types to make sure we didn't miss anything.
+ */
+template class LinkedHashMap<int, int>;
+template class LinkedHashMap<std::string, int>;
+
+/* Returns the keys of the map in iteration order, as a string like "a b c". */
+template <typename MapType>
+static std::string keyOrder(const MapType& map) {
+    std::ostringstream out;
+    for (const auto& key : map) {
+        out << (out.tellp() > 0 ? " " : "") << key;
+    }
+    return out.str();
+}
+
+PROVIDED_TEST("LinkedHashMap, insertion order") {
+    LinkedHashMap<std::string, int> map {{"c", 3}, {"a", 1}, {"b", 2}};
+    EXPECT_EQUAL(keyOrder(map), "c a b");
+    map.put("a", 10);
+    map["d"] = 4;
+    EXPECT_EQUAL(keyOrder(map), "c a b d");
+    EXPECT_EQUAL(map.toString(), "{\"c\":3, \"a\":10, \"b\":2, \"d\":4}");
+    EXPECT_EQUAL(map.keys(), Vector<std::string>({"c", "a", "b", "d"}));
+    EXPECT_EQUAL(map.values(), Vector<int>({3, 10, 2, 4}));
+    EXPECT_EQUAL(map.firstKey(), "c");
+    EXPECT_EQUAL(map.lastKey(), "d");
+
+    map.remove("a");
+    map.remove("zzz");
+    EXPECT_EQUAL(keyOrder(map), "c b d");
+    EXPECT(!map.containsKey("a"));
+    EXPECT_EQUAL(map.get("a"), 0);
+    map.put("a", 5);
+    EXPECT_EQUAL(keyOrder(map), "c b d a");
+
+    std::string pairs;
+    map.mapAll([&](const std::string& key, int value) {
+        pairs += key + std::to_string(value);
+    });
+    EXPECT_EQUAL(pairs, "c3b2d4a5");
+}
+
+PROVIDED_TEST("LinkedHashMap, reorder and evict") {
+    LinkedHashMap<int, int> map;
+    for (int i = 0; i < 6; i++) {
+        map.put(i, i * i);
+    }
+    EXPECT(map.moveToBack(2));
+    EXPECT(map.moveToFront(4));
+    EXPECT(!map.moveToBack(10));
+    EXPECT_EQUAL(keyOrder(map), "4 0 1 3 5 2");
+
+    map.trimToSize(3);
+    EXPECT_EQUAL(keyOrder(map), "3 5 2");
+    EXPECT_EQUAL(map.removeFirst(), 3);
+    EXPECT_EQUAL(map.removeLast(), 2);
+    EXPECT_EQUAL(map.size(), 1);
+    EXPECT_EQUAL(map[5], 25);
+    map.clear();
+    EXPECT(map.isEmpty());
+    EXPECT_ERROR(map.removeFirst());
+    EXPECT_ERROR(map.firstKey());
+    EXPECT_ERROR(map.trimToSize(-1));
+}
+
+PROVIDED_TEST("LinkedHashMap, least recently used cache") {
+    const int capacity = 100;
+    LinkedHashMap<int, int> cache;
+    HashMap<int, int> lastUse;
+    int misses = 0;
+    for (int time = 0; time < 20000; time++) {
+        int key = (time * 7919) % 257 % (time % 3 == 0 ? 257 : 90);
+        if (cache.moveToBack(key)) {
+            EXPECT_EQUAL(cache[key], key * 2);
+        } else {
+            misses++;
+            cache.put(key, key * 2);
+            cache.trimToSize(capacity);
+        }
+        lastUse[key] = time;
+        EXPECT(cache.size() <= capacity);
+    }
+    /* Every cached key was used more recently than every evicted one. */
+    int oldestCached = lastUse[cache.firstKey()];
+    for (int key : lastUse) {
+        if (!cache.containsKey(key)) {
+            EXPECT(lastUse[key] < oldestCached);
+        }
+    }
+    EXPECT(misses < 20000);
+}
+
+PROVIDED_TEST("LinkedHashMap, compare") {
+    LinkedHashMap<std::string, int> map1 {{"a", 1}, {"b", 2}};
+    LinkedHashMap<std::string, int> map2 {{"b", 2}, {"a", 1}};
+    LinkedHashMap<std::string, int> map3 {{"a", 1}, {"c", 3}};
+    testCompareOperators(map1, map2, EqualTo);
+    testCompareOperators(map1, map3, LessThan);
+    testCompareOperators(map3, map1, GreaterThan);
+    EXPECT_EQUAL(hashCode(map1), hashCode(map2));
+}
+
+PROVIDED_TEST("LinkedHashMap, set operations") {
+    LinkedHashMap<std::string, int> map {{"a", 1}, {"b", 2}, {"c", 3}};
+    LinkedHashMap<std::string, int> result = map + LinkedHashMap<std::string, int> {{"d", 4}, {"a", 10}};
+    EXPECT_EQUAL(result.toString(), "{\"a\":10, \"b\":2, \"c\":3, \"d\":4}");
+    result = map - LinkedHashMap<std::string, int> {{"b", 2}, {"c", 30}};
+    EXPECT_EQUAL(result.toString(), "{\"a\":1, \"c\":3}");
+    result = map * LinkedHashMap<std::string, int> {{"c", 3}, {"a", 1}, {"b", 20}};
+    EXPECT_EQUAL(result.toString(), "{\"a\":1, \"c\":3}");
+    map -= map;
+    EXPECT(map.isEmpty());
+}
+
+void moveDuring(LinkedHashMap<int, int>& m) { for (int k : m) m.moveToBack(k); }
+
+PROVIDED_TEST("LinkedHashMap, iterator") {
+    LinkedHashMap<int, int> map {{3, 0}, {1, 0}, {2, 0}};
+    auto itr = map.end();
+    --itr;
+    EXPECT_EQUAL(*itr, 2);
+    --itr;
+    EXPECT_EQUAL(*itr, 1);
+    EXPECT_ERROR(moveDuring(map));
+}
+
+PROVIDED_TEST("LinkedHashMap, streamExtract") {
+    LinkedHashMap<std::string, int> map;
+    std::istringstream input("{\"z\":1, \"y\":2, \"x\":3}");
+    input >> map;
+    EXPECT_EQUAL(keyOrder(map), "z y x");
+}
+
+PROVIDED_TEST("LinkedHashMap, time remove") {
+    /* Removing every key from the front takes linear time in all. */
+    for (int n = 50000; n <= 200000; n *= 2) {
+        LinkedHashMap<int, int> map;
+        for (int i = 0; i < n; i++) {
+            map.put(i, i);
+        }
+        TIME_OPERATION(n, map.trimToSize(0));
+        EXPECT(map.isEmpty());
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * Test file for verifying the Stanford C++ lib LinkedHashSet class.
+ */
+
+#include "linkedhashset.h"
+#include "common.h"
+#include "SimpleTest.h"
+#include <string>
+
+PROVIDED_TEST("LinkedHashSet, insertion order") {
+    LinkedHashSet<std::string> set {"d", "a", "c"};
+    set.add("a");
+    set.add("b");
+    EXPECT_EQUAL(set.toString(), "{\"d\", \"a\", \"c\", \"b\"}");
+    EXPECT_EQUAL(set.first(), "d");
+    EXPECT_EQUAL(set.last(), "b");
+
+    /* Removing and re-adding an element moves it to the end. */
+    set.remove("a");
+    set.add("a");
+    EXPECT_EQUAL(set.toString(), "{\"d\", \"c\", \"b\", \"a\"}");
+}
+
+PROVIDED_TEST("LinkedHashSet, operations") {
+    LinkedHashSet<int> set1 {1, 2, 3, 4};
+    LinkedHashSet<int> set2 {4, 3, 5};
+    EXPECT_EQUAL((set1 + set2).toString(), "{1, 2, 3, 4, 5}");
+    EXPECT_EQUAL((set1 - set2).toString(), "{1, 2}");
+    EXPECT_EQUAL((set1 * set2).toString(), "{3, 4}");
+    EXPECT(LinkedHashSet<int>({3, 4}).isSubsetOf(set1));
+    EXPECT_EQUAL(LinkedHashSet<int>({2, 1}), LinkedHashSet<int>({1, 2}));
+    EXPECT_EQUAL(hashCode(LinkedHashSet<int>({2, 1})), hashCode(LinkedHashSet<int>({1, 2})));
+}
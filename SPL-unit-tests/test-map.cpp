@@ -206,3 +206,35 @@ PROVIDED_TEST("Map, operator[]") {
     EXPECT_EQUAL(m5["A"], ptr);
     EXPECT_EQUAL(m5["B"], nullptr);
 }
+
+PROVIDED_TEST("Map, merge-based putAll, removeAll, retainAll") {
+    Map<std::string, int> map1 = { {"a", 1}, {"b", 2}, {"c", 3} };
+    Map<std::string, int> map2 = { {"b", 2}, {"c", 4}, {"d", 5} };
+    EXPECT_EQUAL(map1 + map2, Map<std::string, int>({ {"a", 1}, {"b", 2}, {"c", 4}, {"d", 5} }));
+    EXPECT_EQUAL(map1 - map2, Map<std::string, int>({ {"a", 1}, {"c", 3} }));
+    EXPECT_EQUAL(map1 * map2, Map<std::string, int>({ {"b", 2} }));
+    EXPECT(map1 != map2);
+
+    Map<std::string, int> copy = map1;
+    copy.putAll(copy);
+    copy.retainAll(copy);
+    EXPECT_EQUAL(copy, map1);
+    copy.removeAll(copy);
+    EXPECT(copy.isEmpty());
+}
+
+PROVIDED_TEST("Map, floorKey, ceilingKey, range, and rank") {
+    Map<int, std::string> map = { {10, "ten"}, {20, "twenty"}, {30, "thirty"} };
+    EXPECT_EQUAL(map.floorKey(25), 20);
+    EXPECT_EQUAL(map.ceilingKey(25), 30);
+    EXPECT_EQUAL(map.ceilingKey(10), 10);
+    EXPECT_ERROR(map.floorKey(9));
+    EXPECT_ERROR(map.ceilingKey(31));
+    EXPECT_EQUAL(map.rank(20), 1);
+
+    std::string values;
+    for (int key : map.range(10, 30)) {
+        values += map[key] + " ";
+    }
+    EXPECT_EQUAL(values, "ten twenty ");
+}
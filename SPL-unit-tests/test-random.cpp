@@ -0,0 +1,106 @@
+/*
+ * Test file for verifying the Stanford C++ lib random number functions.
+ */
+
+#include "random.h"
+#include "vector.h"
+#include "SimpleTest.h"
+#include <climits>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
+PROVIDED_TEST("random, integers stay within range") {
+    for (int i = 0; i < 10000; i++) {
+        int n = randomInteger(-3, 7);
+        EXPECT(n >= -3 && n <= 7);
+    }
+    EXPECT_EQUAL(randomInteger(5, 5), 5);
+    for (int i = 0; i < 1000; i++) {
+        int n = randomInteger(INT_MIN, INT_MAX);
+        (void) n;
+        double d = randomReal(2.5, 3.5);
+        EXPECT(d >= 2.5 && d < 3.5);
+    }
+}
+
+PROVIDED_TEST("random, every integer in range is produced about equally often") {
+    Vector<int> counts(10);
+    for (int n : randomIntegers(100000, 0, 9)) {
+        counts[n]++;
+    }
+    for (int count : counts) {
+        EXPECT(count > 9000 && count < 11000);
+    }
+}
+
+PROVIDED_TEST("random, setRandomSeed makes sequence repeatable") {
+    setRandomSeed(106);
+    Vector<int> first = randomIntegers(100, 0, 1000);
+    double real1 = randomReal(0, 1);
+    std::string color1 = randomColorString();
+    setRandomSeed(106);
+    Vector<int> second = randomIntegers(100, 0, 1000);
+    double real2 = randomReal(0, 1);
+    std::string color2 = randomColorString();
+    EXPECT_EQUAL(first, second);
+    EXPECT_EQUAL(real1, real2);
+    EXPECT_EQUAL(color1, color2);
+
+    setRandomSeed(107);
+    EXPECT(randomIntegers(100, 0, 1000) != first);
+}
+
+PROVIDED_TEST("random, seed is per thread") {
+    setRandomSeed(42);
+    Vector<int> expected = randomIntegers(50, 0, 1000000);
+    Vector<int> fromThread;
+    std::thread worker([&fromThread] {
+        setRandomSeed(42);
+        fromThread = randomIntegers(50, 0, 1000000);
+    });
+    setRandomSeed(42);
+    Vector<int> fromMain = randomIntegers(50, 0, 1000000);
+    worker.join();
+    EXPECT_EQUAL(fromThread, expected);
+    EXPECT_EQUAL(fromMain, expected);
+}
+
+PROVIDED_TEST("random, RandomGenerator instances are independent") {
+    RandomGenerator g1(12345);
+    RandomGenerator g2(12345);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQUAL(g1.next(), g2.next());
+    }
+    RandomGenerator g3;
+    RandomGenerator g4;
+    EXPECT(g3.next() != g4.next());
+}
+
+PROVIDED_TEST("random, shuffle is a permutation") {
+    Vector<int> v;
+    for (int i = 0; i < 1000; i++) {
+        v.add(i);
+    }
+    Vector<int> original = v;
+    shuffle(v);
+    EXPECT(v != original);
+    v.sort();
+    EXPECT_EQUAL(v, original);
+
+    Vector<std::string> empty;
+    shuffle(empty);
+    EXPECT(empty.isEmpty());
+}
+
+PROVIDED_TEST("random, time bulk generation against C rand") {
+    const int n = 10000000;
+    int* buffer = new int[n];
+    TIME_OPERATION(n, [buffer] { for (int i = 0; i < n; i++) buffer[i] = std::rand() % 100; }());
+    TIME_OPERATION(n, [buffer] { for (int i = 0; i < n; i++) buffer[i] = randomInteger(0, 99); }());
+    TIME_OPERATION(n, randomIntegers(buffer, n, 0, 99));
+    delete[] buffer;
+}
@@ -13,6 +13,9 @@
 #include <string>
 #include <numeric>
 
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
 /*
  * Force instantiation of Set on a few types to make sure we didn't miss anything.
  * The types must be comparable.
@@ -233,3 +236,73 @@ PROVIDED_TEST("Set, removeAndRetain") {
     all.intersect(primes);
      EXPECT_EQUAL(all, expected);
 }
+
+PROVIDED_TEST("Set, merge-based set algebra") {
+    Set<int> a = { 1, 3, 5, 7, 9 };
+    Set<int> b = { 3, 4, 5, 6 };
+    EXPECT_EQUAL(a + b, Set<int>({ 1, 3, 4, 5, 6, 7, 9 }));
+    EXPECT_EQUAL(a * b, Set<int>({ 3, 5 }));
+    EXPECT_EQUAL(a - b, Set<int>({ 1, 7, 9 }));
+    EXPECT(Set<int>({ 3, 5 }).isSubsetOf(a));
+    EXPECT(!b.isSubsetOf(a));
+    EXPECT(a.isSupersetOf({ 1, 9 }));
+
+    // a set combined with itself
+    Set<int> copy = a;
+    copy.unionWith(copy);
+    copy.intersect(copy);
+    EXPECT_EQUAL(copy, a);
+    copy.difference(copy);
+    EXPECT(copy.isEmpty());
+
+    // sets with a custom order fall back to looking up each element
+    auto greater = [](int x, int y) { return x > y; };
+    Set<int> c(greater);
+    Set<int> d(greater);
+    c += 1, 2, 3;
+    d += 2, 3, 4;
+    EXPECT_EQUAL((c + d).toString(), "{4, 3, 2, 1}");
+    EXPECT_EQUAL((c * d).toString(), "{3, 2}");
+    EXPECT_EQUAL((c - d).toString(), "{1}");
+}
+
+PROVIDED_TEST("Set, floor, ceiling, range, and rank") {
+    Set<int> set = { 10, 20, 30, 40 };
+    EXPECT_EQUAL(set.floor(25), 20);
+    EXPECT_EQUAL(set.floor(20), 20);
+    EXPECT_EQUAL(set.ceiling(25), 30);
+    EXPECT_EQUAL(set.ceiling(40), 40);
+    EXPECT_ERROR(set.floor(5));
+    EXPECT_ERROR(set.ceiling(45));
+    EXPECT_EQUAL(set.rank(5), 0);
+    EXPECT_EQUAL(set.rank(30), 2);
+    EXPECT_EQUAL(set.rank(99), 4);
+
+    Vector<int> inRange;
+    for (int value : set.range(15, 40)) {
+        inRange.add(value);
+    }
+    EXPECT_EQUAL(inRange, Vector<int>({ 20, 30 }));
+    EXPECT_EQUAL(std::distance(set.range(50, 60).begin(), set.range(50, 60).end()), 0);
+    EXPECT_ERROR(set.range(30, 20));
+}
+
+PROVIDED_TEST("Time Set union, intersection, difference, and subset on a million elements") {
+    const int n = 1000000;
+    Set<int> twos;
+    Set<int> threes;
+    for (int i = 0; i < n; i++) {
+        twos.add(2 * i);
+        threes.add(3 * i);
+    }
+    Set<int> result;
+    TIME_OPERATION(2 * n, result = twos + threes);
+    EXPECT_EQUAL(result.size(), n + n - (n + 2) / 3);
+    TIME_OPERATION(2 * n, result = twos * threes);
+    EXPECT_EQUAL(result.size(), (n + 2) / 3);
+    TIME_OPERATION(2 * n, result = twos - threes);
+    EXPECT_EQUAL(result.size(), n - (n + 2) / 3);
+    bool subset = false;
+    TIME_OPERATION(2 * n, subset = (twos * threes).isSubsetOf(twos));
+    EXPECT(subset);
+}
@@ -7,6 +7,10 @@
 #include "ioutils.h"
 #include "strlib.h"
 #include "filelib.h"
+
+// redirects console input/output, which is shared by all tests
+SERIAL_TEST_GROUP();
+
 using namespace std;
 
 PROVIDED_TEST("getChar rejects empty input, reprompt") {
@@ -4,9 +4,22 @@
 
 #include "SimpleTest.h"
 #include "ioutils.h"
+#include "MemoryDiagnostics.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <unistd.h>
+#endif // _WIN32
+
+// redirects console input/output, which is shared by all tests
+SERIAL_TEST_GROUP();
 
 PROVIDED_TEST("expect equal, integer compare") {
     EXPECT_EQUAL(42, 42);
@@ -73,3 +86,195 @@ PROVIDED_TEST("capture output, compare equal") {
     std::string output = ioutils::captureStdoutEnd();
     EXPECT_EQUAL(output, "12.35\n");
 }
+
+struct TrackedNode {
+    int value;
+    TrackedNode* next;
+    TRACK_ALLOCATIONS_OF(TrackedNode);
+};
+
+struct TrackedBlob {
+    char data[100];
+    ~TrackedBlob() {}
+    TRACK_ALLOCATIONS_OF(TrackedBlob);
+};
+
+PROVIDED_TEST("memory diagnostics, counts live objects and bytes per type") {
+    TrackedNode* first = new TrackedNode;
+    TrackedNode* second = new TrackedNode;
+    TrackedBlob* blobs = new TrackedBlob[3];
+    delete first;
+
+    auto errors = MemoryDiagnostics::typesWithErrors();
+    EXPECT_EQUAL(errors["TrackedNode"], 1);
+    EXPECT_EQUAL(errors["TrackedBlob"], 1);
+
+    delete second;
+    delete[] blobs;
+    EXPECT(MemoryDiagnostics::typesWithErrors().empty());
+
+    auto stats = MemoryDiagnostics::allocationStats();
+    EXPECT_EQUAL(stats["TrackedNode"].allocations, 2);
+    EXPECT_EQUAL(stats["TrackedNode"].peakCount, 2);
+    EXPECT_EQUAL(stats["TrackedNode"].liveBytes, 0);
+    EXPECT(stats["TrackedBlob"].peakBytes >= 3 * (long long) sizeof(TrackedBlob));
+    EXPECT_EQUAL(stats["TrackedBlob"].liveBytes, 0);
+}
+
+PROVIDED_TEST("memory diagnostics, object freed on another thread balances") {
+    TrackedNode* node = new TrackedNode;
+    std::thread([node] { delete node; }).join();
+    EXPECT(MemoryDiagnostics::typesWithErrors().empty());
+    EXPECT_EQUAL(MemoryDiagnostics::allocationStats()["TrackedNode"].deallocations, 1);
+}
+
+PROVIDED_TEST("memory diagnostics, samples allocation sites") {
+    MemoryDiagnostics::setSiteSampling(2);
+    for (int i = 0; i < 10; i++) {
+        delete new TrackedNode;
+    }
+    MemoryDiagnostics::setSiteSampling(0);
+    int sampled = 0;
+    for (const auto& entry : MemoryDiagnostics::sampledSites("TrackedNode")) {
+        sampled += entry.second;
+    }
+    EXPECT_EQUAL(sampled, 5);
+}
+
+/* Allocates and frees n nodes, holding up to batch of them at a time. */
+static void churnNodes(int n, int batch) {
+    std::vector<TrackedNode*> live(batch);
+    for (int i = 0; i < n; i += batch) {
+        for (auto& node : live) node = new TrackedNode;
+        for (auto& node : live) delete node;
+    }
+}
+
+/* Runs churnNodes on the given number of threads at once. */
+static void churnNodesOnThreads(int threads, int n, int batch) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back(churnNodes, n, batch);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+PROVIDED_TEST("memory diagnostics, many threads allocating at once stay balanced") {
+    const int threads = 8;
+    const int n = 1000000;
+    const int batch = 100;
+    TIME_OPERATION(threads * n, churnNodesOnThreads(threads, n, batch));
+    EXPECT(MemoryDiagnostics::typesWithErrors().empty());
+    auto stats = MemoryDiagnostics::allocationStats()["TrackedNode"];
+    EXPECT_EQUAL(stats.allocations, (long long) threads * n);
+    EXPECT_EQUAL(stats.deallocations, (long long) threads * n);
+    EXPECT_EQUAL(stats.liveBytes, 0);
+    EXPECT(stats.peakCount >= batch && stats.peakCount <= threads * batch);
+}
+
+PROVIDED_TEST("memory diagnostics, thread counts see only the calling thread") {
+    MemoryDiagnostics::clearThreadCounts();
+    TrackedNode* mine = new TrackedNode;
+    std::thread(churnNodes, 1000, 10).join();
+    TrackedNode* theirs = nullptr;
+    std::thread([&theirs] { theirs = new TrackedNode; }).join();
+    EXPECT_EQUAL(MemoryDiagnostics::threadTypesWithErrors()["TrackedNode"], 1);
+    delete mine;
+    delete theirs;
+    EXPECT_EQUAL(MemoryDiagnostics::threadTypesWithErrors()["TrackedNode"], -1);
+    EXPECT(MemoryDiagnostics::typesWithErrors().empty());
+}
+
+PROVIDED_TEST("memory diagnostics, time tracked allocations") {
+    const int n = 10000000;
+    TIME_OPERATION(n, [] { for (int i = 0; i < n; i++) delete new TrackedNode; }());
+    TIME_OPERATION(n, [] { for (int i = 0; i < n; i++) delete new TrackedBlob; }());
+    EXPECT(MemoryDiagnostics::typesWithErrors().empty());
+}
+
+// defined in TestingGUI.cpp; hand prototype to keep map out of the exposed header
+std::vector<std::string> runTestsQuietly(const std::map<TestKey, std::multimap<int, TestCase>>& tests);
+
+static void addTestCase(std::map<TestKey, std::multimap<int, TestCase>>& tests, const std::string& filename,
+                        int line, const std::string& name, std::function<void()> callback) {
+    TestCase tcase;
+    tcase.testname = name;
+    tcase.line = line;
+    tcase.filename = filename;
+    tcase.owner = "PROVIDED_TEST";
+    tcase.callback = callback;
+    tests[filename].insert(std::make_pair(line, tcase));
+}
+
+static TrackedNode* leakedNode = nullptr;
+
+PROVIDED_TEST("SimpleTest, worker pool reports results in order and checks leaks") {
+    std::map<TestKey, std::multimap<int, TestCase>> tests;
+    std::vector<std::string> expected;
+    for (int g = 0; g < 6; g++) {
+        std::string filename = "group" + std::to_string(g) + ".cpp";
+        // earlier groups take longer, so they finish after later ones
+        addTestCase(tests, filename, 1, "passes", [g] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(40 * (6 - g)));
+        });
+        addTestCase(tests, filename, 2, "fails", [] { EXPECT(false); });
+        expected.push_back(filename + ": passes: pass");
+        expected.push_back(filename + ": fails: fail");
+    }
+    addTestCase(tests, "leaks.cpp", 1, "leaks", [] { leakedNode = new TrackedNode; });
+    addTestCase(tests, "leaks.cpp", 2, "churns", [] { churnNodes(1000, 10); });
+    expected.push_back("leaks.cpp: leaks: leak");
+    expected.push_back("leaks.cpp: churns: pass");
+
+    setTestWorkers(4);
+    std::vector<std::string> results = runTestsQuietly(tests);
+    setTestWorkers(1);
+    delete leakedNode;
+    EXPECT(results == expected);
+}
+
+static std::atomic<bool> releaseHungTest(false);
+
+PROVIDED_TEST("SimpleTest, a hung test times out and the rest of the run goes on") {
+    std::map<TestKey, std::multimap<int, TestCase>> tests;
+    addTestCase(tests, "a.cpp", 1, "hangs", [] {
+        while (!releaseHungTest) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+    addTestCase(tests, "a.cpp", 2, "passes after", [] {});
+    addTestCase(tests, "b.cpp", 1, "passes", [] {});
+    addTestCase(tests, "c.cpp", 1, "fails", [] { EXPECT(false); });
+
+    setTestWorkers(4);
+    setTestTimeout(0.5);
+    std::vector<std::string> results = runTestsQuietly(tests);
+    setTestTimeout(0);
+    setTestWorkers(1);
+    releaseHungTest = true;
+    std::vector<std::string> expected {
+        "a.cpp: hangs: timeout", "a.cpp: passes after: pass", "b.cpp: passes: pass", "c.cpp: fails: fail"
+    };
+    EXPECT(results == expected);
+}
+
+#ifndef _WIN32
+PROVIDED_TEST("SimpleTest, isolated tests confine a crash to one test") {
+    std::map<TestKey, std::multimap<int, TestCase>> tests;
+    addTestCase(tests, "a.cpp", 1, "exits", [] { _exit(3); });
+    addTestCase(tests, "a.cpp", 2, "leaks", [] { new TrackedNode; });
+    addTestCase(tests, "a.cpp", 3, "passes", [] {});
+
+    setTestIsolation(true);
+    setTestTimeout(10);
+    std::vector<std::string> results = runTestsQuietly(tests);
+    setTestTimeout(0);
+    setTestIsolation(false);
+    std::vector<std::string> expected {
+        "a.cpp: exits: exception", "a.cpp: leaks: leak", "a.cpp: passes: pass"
+    };
+    EXPECT(results == expected);
+}
+#endif // _WIN32
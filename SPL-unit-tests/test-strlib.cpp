@@ -7,8 +7,14 @@
  */
 
 #include "SimpleTest.h"
+#include <sstream>
 #include <string>
+#include <string_view>
 #include "strlib.h"
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
 using namespace std;
 
 
@@ -360,3 +366,77 @@ PROVIDED_TEST("Encoding and decoding URLs") {
     EXPECT_ERROR(urlDecode("%GG"));
     EXPECT_ERROR(urlDecode("\n"));
 }
+
+PROVIDED_TEST("Numeric conversions with radix, limits, and string_view") {
+    EXPECT_EQUAL(stringToInteger("101", 2), 5);
+    EXPECT_EQUAL(stringToInteger("zz", 36), 1295);
+    EXPECT_EQUAL(stringToInteger("0x1F", 16), 31);
+    EXPECT_EQUAL(stringToInteger("-ff", 16), -255);
+    EXPECT_ERROR(stringToInteger("102", 2));
+    EXPECT_ERROR(stringToInteger("1", 37));
+
+    EXPECT_EQUAL(stringToInteger("2147483647"), 2147483647);
+    EXPECT_EQUAL(stringToInteger("-2147483648"), -2147483647 - 1);
+    EXPECT_ERROR(stringToInteger("2147483648"));
+    EXPECT_ERROR(stringToInteger("-2147483649"));
+    EXPECT_ERROR(stringToInteger("+-5"));
+    EXPECT_ERROR(stringToReal("+-5"));
+    EXPECT_ERROR(stringToReal("inf"));
+    EXPECT_ERROR(stringToReal("1e400"));
+    EXPECT_EQUAL(stringToReal(".5"), 0.5);
+    EXPECT_EQUAL(stringToReal("1.5E3"), 1500.0);
+
+    EXPECT_EQUAL(integerToString(255, 16), "ff");
+    EXPECT_EQUAL(integerToString(-1, 16), "ffffffff");
+    EXPECT_EQUAL(integerToString(5, 2), "101");
+    EXPECT_EQUAL(realToString(1e6), "1E+06");
+    EXPECT_EQUAL(realToString(3.14159265), "3.14159");
+
+    std::string_view line = "12,  -7.25 ,x";
+    EXPECT_EQUAL(stringToInteger(line.substr(0, 2)), 12);
+    EXPECT_EQUAL(stringToReal(line.substr(3, 8)), -7.25);
+    EXPECT(!stringIsReal(line.substr(12)));
+}
+
+PROVIDED_TEST("Encoding non-ASCII characters in URLs") {
+    EXPECT_EQUAL(urlEncode("caf\xC3\xA9"), "caf%C3%A9");
+    EXPECT_EQUAL(urlDecode(urlEncode("caf\xC3\xA9 ok?")), "caf\xC3\xA9 ok?");
+}
+
+static int streamToInteger(const string& str) {
+    istringstream stream(trim(str));
+    int value;
+    stream >> value;
+    return value;
+}
+
+static double streamToReal(const string& str) {
+    istringstream stream(trim(str));
+    double value;
+    stream >> value;
+    return value;
+}
+
+static string streamIntegerToString(int n) {
+    ostringstream stream;
+    stream << n;
+    return stream.str();
+}
+
+PROVIDED_TEST("Time numeric conversions against string streams") {
+    const int n = 1000000;
+    Vector<string> ints, reals;
+    for (int i = 0; i < n; i++) {
+        ints.add(integerToString((i % 100000) * 7919 - 400000000));
+        reals.add(realToString(i / 7.0));
+    }
+    long long sum = 0;
+    double total = 0;
+    TIME_OPERATION(n, [&] { for (const string& s : ints) sum += streamToInteger(s); }());
+    TIME_OPERATION(n, [&] { for (const string& s : ints) sum += stringToInteger(s); }());
+    TIME_OPERATION(n, [&] { for (const string& s : reals) total += streamToReal(s); }());
+    TIME_OPERATION(n, [&] { for (const string& s : reals) total += stringToReal(s); }());
+    TIME_OPERATION(n, [&] { for (int i = 0; i < n; i++) sum += streamIntegerToString(i).length(); }());
+    TIME_OPERATION(n, [&] { for (int i = 0; i < n; i++) sum += integerToString(i).length(); }());
+    EXPECT(sum != 0 && total != 0);
+}
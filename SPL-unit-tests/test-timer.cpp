@@ -0,0 +1,126 @@
+/*
+ * Test file for verifying the Stanford C++ lib Timer class and profiler.
+ */
+
+#include "timer.h"
+#include "profiler.h"
+#include "SimpleTest.h"
+#include <sstream>
+#include <string>
+#include <thread>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
+static void spin(long long nanos) {
+    long long until = Timer::currentTimeNanos() + nanos;
+    while (Timer::currentTimeNanos() < until) {
+        // busy wait
+    }
+}
+
+PROVIDED_TEST("Timer, monotonic clock") {
+    long long prev = Timer::currentTimeNanos();
+    for (int i = 0; i < 10000; i++) {
+        long long now = Timer::currentTimeNanos();
+        EXPECT(now >= prev);
+        prev = now;
+    }
+}
+
+PROVIDED_TEST("Timer, elapsed while running and after stop") {
+    Timer timer;
+    EXPECT(!timer.isStarted());
+    EXPECT_EQUAL(timer.elapsedNanos(), 0);
+    timer.start();
+    spin(2000000);
+    EXPECT(timer.isStarted());
+    EXPECT(timer.elapsedNanos() >= 2000000);
+    long ms = timer.stop();
+    EXPECT(!timer.isStarted());
+    EXPECT(ms >= 2);
+    EXPECT_EQUAL(timer.elapsed(), ms);
+    EXPECT_EQUAL(timer.elapsedMicros() / 1000, ms);
+}
+
+PROVIDED_TEST("Timer, stop without start") {
+    Timer timer;
+    EXPECT_EQUAL(timer.stop(), 0);
+}
+
+PROVIDED_TEST("Timer, pause and resume") {
+    Timer timer(true);
+    spin(1000000);
+    timer.pause();
+    EXPECT(timer.isPaused());
+    long long paused = timer.elapsedNanos();
+    spin(5000000);
+    EXPECT_EQUAL(timer.elapsedNanos(), paused);
+    timer.resume();
+    EXPECT(!timer.isPaused());
+    spin(1000000);
+    timer.stop();
+    EXPECT(timer.elapsedNanos() >= 2000000);
+    EXPECT(timer.elapsedNanos() < 5000000 + paused);
+}
+
+PROVIDED_TEST("Timer, lap") {
+    Timer timer(true);
+    spin(1000000);
+    long long lap1 = timer.lap();
+    spin(1000000);
+    long long lap2 = timer.lap();
+    EXPECT(lap1 >= 1000000);
+    EXPECT(lap2 >= 1000000);
+    EXPECT(lap1 + lap2 <= timer.elapsedNanos());
+}
+
+static void profiledWork() {
+    SPL_PROFILE_SCOPE("test-timer profiledWork");
+    spin(100000);
+}
+
+PROVIDED_TEST("Profiler, counts zones only while enabled") {
+    Profiler::reset();
+    Profiler::disable();
+    profiledWork();
+    EXPECT_EQUAL(Profiler::zoneCount("test-timer profiledWork"), 0);
+    Profiler::enable();
+    for (int i = 0; i < 5; i++) {
+        profiledWork();
+    }
+    Profiler::disable();
+    EXPECT_EQUAL(Profiler::zoneCount("test-timer profiledWork"), 5);
+    EXPECT(Profiler::zoneNanos("test-timer profiledWork") >= 500000);
+    EXPECT_EQUAL(Profiler::zoneCount("no such zone"), 0);
+}
+
+PROVIDED_TEST("Profiler, aggregates across threads and writes trace") {
+    Profiler::reset();
+    Profiler::enable(true);
+    std::thread t1([] { for (int i = 0; i < 10; i++) profiledWork(); });
+    std::thread t2([] { for (int i = 0; i < 10; i++) profiledWork(); });
+    t1.join();
+    t2.join();
+    Profiler::disable();
+    EXPECT_EQUAL(Profiler::zoneCount("test-timer profiledWork"), 20);
+
+    std::ostringstream report;
+    Profiler::report(report);
+    EXPECT(report.str().find("test-timer profiledWork") != std::string::npos);
+
+    std::ostringstream trace;
+    Profiler::writeChromeTrace(trace);
+    EXPECT(trace.str().find("\"traceEvents\"") != std::string::npos);
+    EXPECT(trace.str().find("\"ph\":\"X\"") != std::string::npos);
+}
+
+PROVIDED_TEST("Profiler, overhead of disabled and enabled zones") {
+    Profiler::reset();
+    Profiler::disable();
+    TIME_OPERATION(1000000, [] { for (int i = 0; i < 1000000; i++) { SPL_PROFILE_SCOPE("test-timer empty"); } }());
+    Profiler::enable();
+    TIME_OPERATION(1000000, [] { for (int i = 0; i < 1000000; i++) { SPL_PROFILE_SCOPE("test-timer empty"); } }());
+    Profiler::disable();
+    EXPECT_EQUAL(Profiler::zoneCount("test-timer empty"), 1000000);
+}
@@ -0,0 +1,150 @@
+/*
+ * Test file for verifying the Stanford C++ lib TokenScanner class.
+ */
+
+#include "tokenscanner.h"
+#include "common.h"
+#include "SimpleTest.h"
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
+static const std::string SOURCE =
+        "int main() { // entry point\n"
+        "    x += 3.5e+2 * y_1 >>= 0x1F; /* block\n"
+        "    comment */ s = \"a \\\"quoted\\\" string\";\n"
+        "    if (a<=b && c != 'd') return 1e; 7.e-x\n"
+        "}";
+
+static void configure(TokenScanner& scanner) {
+    scanner.ignoreWhitespace();
+    scanner.ignoreComments();
+    scanner.scanNumbers();
+    scanner.scanStrings();
+    scanner.addWordCharacters("_");
+    for (std::string op : {"+=", "<=", "&&", "!=", ">>", ">>=", "->"}) {
+        scanner.addOperator(op);
+    }
+}
+
+static std::vector<std::string> readTokens(TokenScanner& scanner) {
+    std::vector<std::string> tokens;
+    while (scanner.hasMoreTokens()) {
+        tokens.push_back(scanner.nextToken());
+    }
+    return tokens;
+}
+
+PROVIDED_TEST("TokenScanner, string and stream input agree") {
+    TokenScanner fromString(SOURCE);
+    configure(fromString);
+    std::istringstream input(SOURCE);
+    TokenScanner fromStream(input);
+    configure(fromStream);
+    std::vector<std::string> tokens = readTokens(fromString);
+    EXPECT(tokens == readTokens(fromStream));
+
+    std::vector<std::string> expected {
+        "int", "main", "(", ")", "{", "x", "+=", "3.5e+2", "*", "y_1", ">>=",
+        "0", "x1F", ";", "s", "=", "\"a \\\"quoted\\\" string\"", ";",
+        "if", "(", "a", "<=", "b", "&&", "c", "!=", "'d'", ")", "return",
+        "1", "e", ";", "7.", "e", "-", "x", "}"
+    };
+    EXPECT(tokens == expected);
+}
+
+PROVIDED_TEST("TokenScanner, incomplete exponent at end of input") {
+    std::vector<std::pair<std::string, std::vector<std::string>>> cases {
+        {"1e", {"1", "e"}},
+        {"1e-", {"1", "e", "-"}}
+    };
+    for (const auto& c : cases) {
+        TokenScanner fromString(c.first);
+        configure(fromString);
+        EXPECT(readTokens(fromString) == c.second);
+        std::istringstream input(c.first);
+        TokenScanner fromStream(input);
+        configure(fromStream);
+        EXPECT(readTokens(fromStream) == c.second);
+    }
+}
+
+PROVIDED_TEST("TokenScanner, scanToken positions") {
+    std::string text = "alpha = beta\n  gamma\"s\"";
+    TokenScanner scanner;
+    scanner.setInputBuffer(text);
+    scanner.ignoreWhitespace();
+    scanner.scanStrings();
+
+    TokenScanner::Token token = scanner.scanToken();
+    EXPECT_EQUAL(std::string(token.text), "alpha");
+    EXPECT_EQUAL(token.type, TokenScanner::WORD);
+    EXPECT(token.text.data() == text.data());
+    scanner.scanToken();
+    token = scanner.scanToken();
+    EXPECT_EQUAL(token.position, 8);
+    EXPECT(scanner.hasMoreTokens());
+    token = scanner.scanToken();
+    EXPECT_EQUAL(std::string(token.text), "gamma");
+    EXPECT_EQUAL(token.line, 2);
+    EXPECT_EQUAL(token.column, 3);
+    token = scanner.scanToken();
+    EXPECT_EQUAL(token.type, TokenScanner::STRING);
+    EXPECT_EQUAL(token.column, 8);
+    token = scanner.scanToken();
+    EXPECT(token.text.empty());
+    EXPECT_EQUAL(token.type, TokenScanner::TokenType(EOF));
+
+    scanner.setInput("3 \"open");
+    scanner.scanStrings();
+    EXPECT_EQUAL(scanner.nextToken(), "3");
+    scanner.saveToken("x");
+    EXPECT_EQUAL(scanner.getPosition(), 0);
+    EXPECT_EQUAL(scanner.nextToken(), "x");
+    EXPECT_ERROR(scanner.nextToken());
+}
+
+PROVIDED_TEST("TokenScanner, tokenize") {
+    std::istringstream input("a->b - > c");
+    TokenScanner scanner(input);
+    scanner.ignoreWhitespace();
+    scanner.addOperator("->");
+    EXPECT_EQUAL(scanner.nextToken(), "a");
+    scanner.saveToken("first");
+    std::vector<TokenScanner::Token> tokens = scanner.tokenize();
+    std::string joined;
+    for (const TokenScanner::Token& token : tokens) {
+        joined += std::string(token.text) + "|";
+    }
+    EXPECT_EQUAL(joined, "first|->|b|-|>|c|");
+    EXPECT_EQUAL(tokens[1].type, TokenScanner::OPERATOR);
+    EXPECT(!scanner.hasMoreTokens());
+}
+
+PROVIDED_TEST("TokenScanner, time tokenizing") {
+    std::string text;
+    for (int i = 0; i < 20000; i++) {
+        text += SOURCE + "\n";
+    }
+    int count = 0;
+    std::istringstream input(text);
+    TokenScanner fromStream(input);
+    configure(fromStream);
+    TIME_OPERATION(text.size(), count = (int) readTokens(fromStream).size());
+    int expected = count;
+
+    TokenScanner fromString(text);
+    configure(fromString);
+    TIME_OPERATION(text.size(), count = (int) readTokens(fromString).size());
+    EXPECT_EQUAL(count, expected);
+
+    TokenScanner batch;
+    batch.setInputBuffer(text);
+    configure(batch);
+    TIME_OPERATION(text.size(), count = (int) batch.tokenize().size());
+    EXPECT_EQUAL(count, expected);
+}
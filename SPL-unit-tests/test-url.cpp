@@ -3,10 +3,22 @@
  */
 
 #include "urlstream.h"
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include "filelib.h"
+#include "gdownloader.h"
+#include "gthread.h"
 #include "SimpleTest.h"
 
+// times operations with TIME_OPERATION, so must not share the processor
+SERIAL_TEST_GROUP();
+
 PROVIDED_TEST("download url using iurlstream") {
     std::cout << "Downloading ..." << std::endl;
     iurlstream testurl;
@@ -20,3 +32,326 @@ PROVIDED_TEST("download url using iurlstream") {
     testurl.close();
     std::cout << "====================" << std::endl;
 }
+
+/*
+ * A minimal HTTP server on the Qt GUI thread for testing downloads.
+ * Requests for "/" (with any query string) get a body of numbered lines,
+ * "line 0" through "line <count - 1>", and an ETag; a request whose
+ * If-None-Match matches that ETag gets a 304 instead.  Anything else gets
+ * a 404.  If holdBack is set, only the first line is sent until release()
+ * is called.  The body is written a block at a time as the socket drains,
+ * as a real server would.  The server counts 304s and the most requests
+ * it was ever answering at once.
+ */
+class LocalHttpServer {
+public:
+    LocalHttpServer(int lineCount, bool holdBack)
+            : _lineCount(lineCount),
+              _holdBack(holdBack),
+              _bodyLength(0),
+              _active(0),
+              _peakActive(0),
+              _notModifiedCount(0) {
+        for (int i = 0; i < lineCount; i++) {
+            _bodyLength += lineText(i).length();
+        }
+        GThread::runOnQtGuiThread([this]() {
+            _server = new QTcpServer();
+            _server->listen(QHostAddress::LocalHost, 0);
+            _port = _server->serverPort();
+            QObject::connect(_server, &QTcpServer::newConnection, _server, [this]() {
+                accept(_server->nextPendingConnection());
+            });
+        });
+    }
+
+    ~LocalHttpServer() {
+        GThread::runOnQtGuiThread([this]() {
+            delete _server;
+        });
+    }
+
+    static std::string lineText(int i) {
+        return "line " + std::to_string(i) + "\n";
+    }
+
+    std::string body() const {
+        std::string text;
+        for (int i = 0; i < _lineCount; i++) {
+            text += lineText(i);
+        }
+        return text;
+    }
+
+    int notModifiedCount() const {
+        int count = 0;
+        GThread::runOnQtGuiThread([this, &count]() {
+            count = _notModifiedCount;
+        });
+        return count;
+    }
+
+    int peakActive() const {
+        int peak = 0;
+        GThread::runOnQtGuiThread([this, &peak]() {
+            peak = _peakActive;
+        });
+        return peak;
+    }
+
+    void release() {
+        GThread::runOnQtGuiThreadAsync([this]() {
+            _holdBack = false;
+            if (_held) {
+                sendMore(_held);
+            }
+        });
+    }
+
+    std::string url(const std::string& path = "/") const {
+        return "http://127.0.0.1:" + std::to_string(_port) + path;
+    }
+
+private:
+    struct Connection {
+        QTcpSocket* socket;
+        QByteArray request;
+        int nextLine;
+        bool done;
+    };
+
+    void accept(QTcpSocket* socket) {
+        std::shared_ptr<Connection> connection(new Connection {socket, QByteArray(), 0, false});
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, connection]() {
+            connection->request += connection->socket->readAll();
+            if (connection->request.contains("\r\n\r\n")) {
+                respond(connection);
+            }
+        });
+        QObject::connect(socket, &QTcpSocket::bytesWritten, socket, [this, connection]() {
+            sendMore(connection);
+        });
+    }
+
+    void respond(std::shared_ptr<Connection> connection) {
+        _active++;
+        _peakActive = std::max(_peakActive, _active);
+        std::string etag = "\"lines-" + std::to_string(_lineCount) + "\"";
+        if (!connection->request.startsWith("GET / ") && !connection->request.startsWith("GET /?")) {
+            connection->socket->write("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+            finish(connection);
+            return;
+        }
+        if (connection->request.contains(("If-None-Match: " + etag + "\r\n").c_str())) {
+            _notModifiedCount++;
+            connection->socket->write(("HTTP/1.1 304 Not Modified\r\nETag: " + etag
+                                       + "\r\nConnection: close\r\n\r\n").c_str());
+            finish(connection);
+            return;
+        }
+        std::string header = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: "
+                + std::to_string(_bodyLength) + "\r\nETag: " + etag
+                + "\r\nConnection: close\r\n\r\n";
+        connection->socket->write(header.c_str());
+        if (_holdBack) {
+            connection->socket->write(lineText(connection->nextLine++).c_str());
+            _held = connection;
+        } else {
+            sendMore(connection);
+        }
+    }
+
+    void finish(std::shared_ptr<Connection> connection) {
+        connection->done = true;
+        _active--;
+        connection->socket->disconnectFromHost();
+    }
+
+    void sendMore(std::shared_ptr<Connection> connection) {
+        if (connection->done || (_holdBack && connection == _held)) {
+            return;
+        }
+        while (connection->socket->bytesToWrite() < 256 * 1024 && connection->nextLine < _lineCount) {
+            std::string block;
+            for (int i = 0; i < 1000 && connection->nextLine < _lineCount; i++) {
+                block += lineText(connection->nextLine++);
+            }
+            connection->socket->write(block.data(), static_cast<qint64>(block.length()));
+        }
+        if (connection->nextLine == _lineCount && connection->socket->bytesToWrite() == 0) {
+            finish(connection);
+        }
+    }
+
+    QTcpServer* _server;
+    int _port;
+    int _lineCount;
+    bool _holdBack;
+    size_t _bodyLength;
+    int _active;             // requests received and not yet fully answered
+    int _peakActive;
+    int _notModifiedCount;
+    std::shared_ptr<Connection> _held;
+};
+
+/*
+ * Reads the numbered lines from the stream, starting from line number
+ * first, and returns the number of the first line that was missing.
+ */
+static int readNumberedLines(iurlstream& stream, int first) {
+    int count = first;
+    std::string line;
+    while (getline(stream, line) && line + "\n" == LocalHttpServer::lineText(count)) {
+        count++;
+    }
+    return count;
+}
+
+PROVIDED_TEST("iurlstream streams from a local server") {
+    const int lines = 1000 * 1000;
+    LocalHttpServer server(lines, true);
+    iurlstream stream;
+    stream.setStreaming(true, 64 * 1024);
+    EXPECT(stream.isStreaming());
+    stream.open(server.url());
+    EXPECT_EQUAL(stream.getHttpStatusCode(), 200);
+
+    // the first line arrives before the server has sent the rest
+    std::string line;
+    EXPECT(getline(stream, line));
+    EXPECT_EQUAL(line, "line 0");
+    server.release();
+
+    int count = 0;
+    TIME_OPERATION(lines, count = readNumberedLines(stream, 1));
+    EXPECT_EQUAL(count, lines);
+    EXPECT(stream.eof());
+    EXPECT_EQUAL(stream.getErrorMessage(), "");
+}
+
+PROVIDED_TEST("iurlstream buffered mode and errors with a local server") {
+    const int lines = 100 * 1000;
+    LocalHttpServer server(lines, false);
+    iurlstream stream;
+    stream.open(server.url());
+    EXPECT_EQUAL(stream.getErrorCode(), 0);
+    EXPECT_EQUAL(readNumberedLines(stream, 0), lines);
+
+    stream.open(server.url("/missing"));
+    EXPECT(stream.fail());
+    EXPECT_EQUAL(stream.getHttpStatusCode(), 404);
+    EXPECT_EQUAL(stream.getErrorCode(), 404);
+
+    // closing a streaming download before the end stops it
+    stream.setStreaming(true, 4 * 1024);
+    stream.open(server.url());
+    std::string line;
+    EXPECT(getline(stream, line));
+    stream.close();
+    EXPECT(!getline(stream, line));
+
+    GDownloader downloader;
+    std::string text = downloader.downloadAsString(server.url());
+    EXPECT(!downloader.hasError());
+    EXPECT(text == server.body());
+}
+
+static Vector<std::string> copyUrls(const LocalHttpServer& server, int count) {
+    Vector<std::string> urls;
+    for (int i = 0; i < count; i++) {
+        urls.add(server.url("/?copy=" + std::to_string(i)));
+    }
+    return urls;
+}
+
+static size_t downloadOneByOne(GDownloader& downloader, const Vector<std::string>& urls) {
+    size_t total = 0;
+    for (const std::string& url : urls) {
+        total += downloader.downloadAsString(url).length();
+    }
+    return total;
+}
+
+static size_t downloadTogether(GDownloader& downloader, const Vector<std::string>& urls) {
+    size_t total = 0;
+    downloader.downloadAll(urls, [&total](const GDownloader::Response& response) {
+        total += response.body.length();
+    });
+    return total;
+}
+
+PROVIDED_TEST("GDownloader downloadAll from a local server") {
+    LocalHttpServer server(10 * 1000, false);
+    Vector<std::string> urls = copyUrls(server, 40);
+    urls.add(server.url("/missing"));
+    GDownloader downloader;
+    downloader.setMaxConnectionsPerHost(3);
+    EXPECT_ERROR(downloader.setMaxConnectionsPerHost(0));
+
+    std::vector<std::future<GDownloader::Response>> futures = downloader.downloadAll(urls, 8);
+    EXPECT_EQUAL((int) futures.size(), urls.size());
+    int correct = 0;
+    for (int i = 0; i < 40; i++) {
+        GDownloader::Response response = futures[i].get();
+        if (response.url == urls[i] && !response.hasError() && response.body == server.body()) {
+            correct++;
+        }
+    }
+    EXPECT_EQUAL(correct, 40);
+    GDownloader::Response missing = futures.back().get();
+    EXPECT(missing.hasError());
+    EXPECT_EQUAL(missing.httpStatusCode, 404);
+    EXPECT(server.peakActive() <= 3);
+
+    // the callback form hands back every response, in whatever order they finish
+    urls.remove(urls.size() - 1);
+    size_t expected = urls.size() * server.body().length();
+    size_t total = 0;
+    downloader.setMaxConnectionsPerHost(GDownloader::DEFAULT_MAX_PER_HOST);
+    TIME_OPERATION(urls.size(), total = downloadOneByOne(downloader, urls));
+    EXPECT_EQUAL(total, expected);
+    TIME_OPERATION(urls.size(), total = downloadTogether(downloader, urls));
+    EXPECT_EQUAL(total, expected);
+}
+
+PROVIDED_TEST("GDownloader downloadAll revalidates its cache with ETags") {
+    std::string cacheDirectory = getTempDirectory() + "/spl-test-download-cache";
+    GDownloader downloader;
+    downloader.setCacheDirectory(cacheDirectory);
+    EXPECT_EQUAL(downloader.getCacheDirectory(), cacheDirectory);
+    for (const std::string& file : listDirectory(cacheDirectory)) {
+        deleteFile(cacheDirectory + "/" + file);
+    }
+
+    LocalHttpServer server(1000, false);
+    Vector<std::string> urls = copyUrls(server, 10);
+    int fresh = 0;
+    downloader.downloadAll(urls, [&](const GDownloader::Response& response) {
+        if (!response.fromCache && response.httpStatusCode == 200 && response.body == server.body()) {
+            fresh++;
+        }
+    });
+    EXPECT_EQUAL(fresh, 10);
+    EXPECT_EQUAL(server.notModifiedCount(), 0);
+
+    int cached = 0;
+    downloader.downloadAll(urls, [&](const GDownloader::Response& response) {
+        if (response.fromCache && response.httpStatusCode == 304
+                && !response.hasError() && response.body == server.body()) {
+            cached++;
+        }
+    });
+    EXPECT_EQUAL(cached, 10);
+    EXPECT_EQUAL(server.notModifiedCount(), 10);
+
+    // with the cache turned off, the ETag is not sent
+    downloader.setCacheDirectory("");
+    int uncached = 0;
+    for (std::future<GDownloader::Response>& future : downloader.downloadAll(urls)) {
+        if (!future.get().fromCache) {
+            uncached++;
+        }
+    }
+    EXPECT_EQUAL(uncached, 10);
+    EXPECT_EQUAL(server.notModifiedCount(), 10);
+}